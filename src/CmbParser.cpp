@@ -19,14 +19,20 @@
  */
 
 #include "CmbParser.h"
-#include <wx/stdpaths.h>
-#include <wx/filename.h>
 #include <wx/wfstream.h>
 #include <wx/zstream.h>
+#include <cstring>
+#include <string>
+
+#define CMB_MAX_PIPES 192
+#define CMB_MAX_SECTIONS 999
 
 CmbParser::CmbParser(wxString filePath, CMB_ORGAN *cmbOrgan) {
 	m_isOk = false;
 	m_errorText = wxT("Cmb file not parsed yet!");
+	m_hasOrganSection = false;
+	m_organ.exists = false;
+	setDefaults(m_organ.attributes);
 
 	m_isOk = readCmbFile(filePath, cmbOrgan);
 	if (m_isOk)
@@ -51,45 +57,24 @@ bool CmbParser::readCmbFile(wxString fileName, CMB_ORGAN *cmbOrgan) {
 
 	if (cmbFile.IsOk()) {
 		wxZlibInputStream cmbIn(cmbFile, wxZLIB_GZIP);
-		if (cmbIn.IsOk()) {
-			wxFileConfig iniFile(cmbIn);
-			if (iniFile.HasGroup(wxT("Organ"))) {
-				// An [Organ] section is found
-
-				parseSection(&iniFile, wxT("Organ"), cmbOrgan);
-
-				bool lookForWindchest = true;
-				int windchestNbr = 1;
-				while (lookForWindchest) {
-					wxString windchestName = wxString::Format(wxT("WindchestGroup%0.3d"), windchestNbr);
-					if (parseSection(&iniFile, windchestName, cmbOrgan)) {
-						windchestNbr++;
-					} else {
-						lookForWindchest = false;
-					}
-				}
+		std::vector<char> buffer;
+		if (cmbIn.IsOk() && readDecompressed(cmbIn, buffer)) {
+			size_t start = 0;
+			// skip a possible utf-8 byte order mark
+			if (buffer.size() > 2 && (unsigned char) buffer[0] == 0xEF && (unsigned char) buffer[1] == 0xBB && (unsigned char) buffer[2] == 0xBF)
+				start = 3;
 
-				bool lookForRank = true;
-				int rankNbr = 1;
-				while (lookForRank) {
-					wxString rankName = wxString::Format(wxT("Rank%0.3d"), rankNbr);
-					if (parseSection(&iniFile, rankName, cmbOrgan)) {
-						rankNbr++;
-					} else {
-						lookForRank = false;
-					}
-				}
+			if (buffer.size() > start)
+				tokenize(&buffer[start], buffer.size() - start, cmbOrgan);
 
-				bool lookForStop = true;
-				int stopNbr = 1;
-				while (lookForStop) {
-					wxString stopName = wxString::Format(wxT("Stop%0.3d"), stopNbr);
-					if (parseSection(&iniFile, stopName, cmbOrgan)) {
-						stopNbr++;
-					} else {
-						lookForStop = false;
-					}
-				}
+			if (m_hasOrganSection) {
+				cmbOrgan->attributes = m_organ.attributes;
+
+				// like before, numbered sections are only used as long as they follow each other
+				for (unsigned i = 0; i < m_windchests.size() && m_windchests[i].exists; i++)
+					cmbOrgan->cmbWindchests.push_back(m_windchests[i].attributes);
+				collectSections(m_ranks, cmbOrgan->cmbRanks);
+				collectSections(m_stops, cmbOrgan->cmbStops);
 
 				return true;
 			} else {
@@ -106,124 +91,246 @@ bool CmbParser::readCmbFile(wxString fileName, CMB_ORGAN *cmbOrgan) {
 	}
 }
 
-bool CmbParser::parseString(wxFileConfig *ini, wxString key, wxString *value, wxString defaultValue) {
-	return ini->Read(key, value, defaultValue);
-}
+bool CmbParser::readDecompressed(wxInputStream &in, std::vector<char> &buffer) {
+	char chunk[65536];
+	while (!in.Eof()) {
+		in.Read(chunk, sizeof(chunk));
+		size_t bytesRead = in.LastRead();
+		if (bytesRead == 0)
+			break;
+		buffer.insert(buffer.end(), chunk, chunk + bytesRead);
+	}
 
-bool CmbParser::parseInt(wxFileConfig *ini, wxString key, int *value, int defaultValue) {
-	long parsedValue = defaultValue;
-	bool returnValue = ini->Read(key, &parsedValue, defaultValue);
-	*value = static_cast<long>(parsedValue);
-	return returnValue;
+	wxStreamError error = in.GetLastError();
+	return error == wxSTREAM_NO_ERROR || error == wxSTREAM_EOF;
 }
 
-bool CmbParser::parseFloat(wxFileConfig *ini, wxString key, float *value, float defaultValue) {
-	return ini->Read(key, value, defaultValue);
-}
+void CmbParser::tokenize(const char *data, size_t length, CMB_ORGAN *cmbOrgan) {
+	const char *end = data + length;
+	const char *lineStart = data;
+	CMB_PARSED_SECTION *currentSection = NULL;
+
+	while (lineStart < end) {
+		const char *lineEnd = (const char*) memchr(lineStart, '\n', end - lineStart);
+		if (!lineEnd)
+			lineEnd = end;
+
+		// trim whitespace at both ends of the line
+		const char *first = lineStart;
+		const char *last = lineEnd;
+		while (first < last && (*first == ' ' || *first == '\t'))
+			first++;
+		while (last > first && (*(last - 1) == ' ' || *(last - 1) == '\t' || *(last - 1) == '\r'))
+			last--;
+
+		if (first < last && *first != ';' && *first != '#') {
+			if (*first == '[') {
+				const char *closing = (const char*) memchr(first, ']', last - first);
+				if (closing)
+					currentSection = getSection(first + 1, closing - first - 1);
+				else
+					currentSection = NULL;
+			} else if (currentSection) {
+				const char *equals = (const char*) memchr(first, '=', last - first);
+				if (equals) {
+					const char *keyEnd = equals;
+					while (keyEnd > first && (*(keyEnd - 1) == ' ' || *(keyEnd - 1) == '\t'))
+						keyEnd--;
+					const char *value = equals + 1;
+					while (value < last && (*value == ' ' || *value == '\t'))
+						value++;
+
+					parseEntry(currentSection, first, keyEnd - first, value, last - value, cmbOrgan);
+				}
+			}
+		}
 
-bool CmbParser::parseSection(wxFileConfig *ini, wxString section, CMB_ORGAN *cmbOrgan) {
-	if (ini->HasGroup(section))
-		ini->SetPath(wxT("/") + section);
-	else
-		return false;
+		lineStart = lineEnd + 1;
+	}
+}
 
-	float amplitude;
-	parseFloat(ini, wxT("Amplitude"), &amplitude, 100.0f);
+CMB_PARSED_SECTION* CmbParser::getSection(const char *name, size_t length) {
+	if (keyEquals(name, length, "Organ")) {
+		m_hasOrganSection = true;
+		m_organ.exists = true;
+		return &m_organ;
+	}
 
-	float gain;
-	parseFloat(ini, wxT("UserGain"), &gain, 0.0f);
+	std::vector<CMB_PARSED_SECTION> *sections = NULL;
+	size_t prefixLength = 0;
+	if (length > 14 && strncmp(name, "WindchestGroup", 14) == 0) {
+		sections = &m_windchests;
+		prefixLength = 14;
+	} else if (length > 4 && strncmp(name, "Rank", 4) == 0) {
+		sections = &m_ranks;
+		prefixLength = 4;
+	} else if (length > 4 && strncmp(name, "Stop", 4) == 0) {
+		sections = &m_stops;
+		prefixLength = 4;
+	} else {
+		return NULL;
+	}
 
-	float pitchTuning;
-	parseFloat(ini, wxT("ManualTuning"), &pitchTuning, 0.0f);
+	// the sections are written with (at least) three digit numbers like Rank001
+	if (length - prefixLength < 3)
+		return NULL;
+
+	int number = 0;
+	for (size_t i = prefixLength; i < length; i++) {
+		if (name[i] < '0' || name[i] > '9')
+			return NULL;
+		number = number * 10 + (name[i] - '0');
+		if (number > CMB_MAX_SECTIONS)
+			return NULL;
+	}
+	if (number < 1)
+		return NULL;
+
+	if (sections->size() < (unsigned) number) {
+		CMB_PARSED_SECTION empty;
+		empty.exists = false;
+		setDefaults(empty.attributes);
+		sections->resize(number, empty);
+	}
 
-	float pitchCorrection;
-	parseFloat(ini, wxT("AutoTuningCorrection"), &pitchCorrection, 0.0f);
+	CMB_PARSED_SECTION *section = &(*sections)[number - 1];
+	section->exists = true;
+	return section;
+}
 
-	int trackerDelay;
-	parseInt(ini, wxT("Delay"), &trackerDelay, 0);
+void CmbParser::parseEntry(CMB_PARSED_SECTION *section, const char *key, size_t keyLength, const char *value, size_t valueLength, CMB_ORGAN *cmbOrgan) {
+	if (parseAttribute(section->attributes, key, keyLength, value, valueLength))
+		return;
 
-	if (!section.IsSameAs(wxT("Organ")) && !section.StartsWith(wxT("WindchestGroup"))) {
-		CMB_ELEMENT_WITH_PIPES elementWithPipes;
-		elementWithPipes.attributes.amplitude = amplitude;
-		elementWithPipes.attributes.gain = gain;
-		elementWithPipes.attributes.pitchTuning = pitchTuning;
-		elementWithPipes.attributes.pitchCorrection = pitchCorrection;
-		elementWithPipes.attributes.trackerDelay = trackerDelay;
-
-		int pipeId = 1;
-		while (pipeId < 193) {
-			if (hasPipeKey(ini, pipeId))
-				elementWithPipes.pipes.push_back(parsePipe(ini, pipeId));
-
-			pipeId++;
-		}
+	if (section == &m_organ) {
+		if (keyEquals(key, keyLength, "ChurchName"))
+			cmbOrgan->churchName = toString(value, valueLength);
+		else if (keyEquals(key, keyLength, "ODFPath"))
+			cmbOrgan->odfPath = toString(value, valueLength);
+		return;
+	}
 
-		if (section.StartsWith(wxT("Rank"))) {
-			cmbOrgan->cmbRanks.push_back(elementWithPipes);
-		} else if (section.StartsWith(wxT("Stop"))) {
-			cmbOrgan->cmbStops.push_back(elementWithPipes);
-		}
-	} else if (section.StartsWith(wxT("WindchestGroup"))) {
-		CMB_ELEMENT windchest;
-		windchest.amplitude = amplitude;
-		windchest.gain = gain;
-		windchest.pitchTuning = pitchTuning;
-		windchest.pitchCorrection = pitchCorrection;
-		windchest.trackerDelay = trackerDelay;
-		cmbOrgan->cmbWindchests.push_back(windchest);
-	} else {
-		wxString churchName;
-		parseString(ini, wxT("ChurchName"), &churchName, wxEmptyString);
-		cmbOrgan->churchName = churchName;
-
-		wxString odfPath;
-		parseString(ini, wxT("ODFPath"), &odfPath, wxEmptyString);
-		cmbOrgan->odfPath = odfPath;
-
-		cmbOrgan->attributes.amplitude = amplitude;
-		cmbOrgan->attributes.gain = gain;
-		cmbOrgan->attributes.pitchTuning = pitchTuning;
-		cmbOrgan->attributes.pitchCorrection = pitchCorrection;
-		cmbOrgan->attributes.trackerDelay = trackerDelay;
+	// pipe values are written as PipeNNNAttribute
+	if (keyLength < 8 || strncmp(key, "Pipe", 4) != 0)
+		return;
+	if (key[4] < '0' || key[4] > '9' || key[5] < '0' || key[5] > '9' || key[6] < '0' || key[6] > '9')
+		return;
+
+	int pipeNbr = (key[4] - '0') * 100 + (key[5] - '0') * 10 + (key[6] - '0');
+	if (pipeNbr < 1 || pipeNbr > CMB_MAX_PIPES)
+		return;
+
+	if (section->pipes.empty()) {
+		CMB_ELEMENT defaultPipe;
+		setDefaults(defaultPipe);
+		section->pipes.resize(CMB_MAX_PIPES, defaultPipe);
+		section->hasPipe.resize(CMB_MAX_PIPES, false);
 	}
 
-	ini->SetPath("/");
-	return true;
+	if (parseAttribute(section->pipes[pipeNbr - 1], key + 7, keyLength - 7, value, valueLength)) {
+		// a pipe is only considered present if it has an amplitude value
+		if (keyEquals(key + 7, keyLength - 7, "Amplitude"))
+			section->hasPipe[pipeNbr - 1] = true;
+	}
 }
 
-bool CmbParser::hasPipeKey(wxFileConfig *ini, int pipeIndex) {
-	wxString pipeStr = wxString::Format(wxT("Pipe%0.3d"), pipeIndex);
-	if (ini->HasEntry(pipeStr + wxT("Amplitude")))
-		return true;
+bool CmbParser::parseAttribute(CMB_ELEMENT &element, const char *key, size_t keyLength, const char *value, size_t valueLength) {
+	if (keyEquals(key, keyLength, "Amplitude"))
+		element.amplitude = toFloat(value, valueLength, 100.0f);
+	else if (keyEquals(key, keyLength, "UserGain"))
+		element.gain = toFloat(value, valueLength, 0.0f);
+	else if (keyEquals(key, keyLength, "ManualTuning"))
+		element.pitchTuning = toFloat(value, valueLength, 0.0f);
+	else if (keyEquals(key, keyLength, "AutoTuningCorrection"))
+		element.pitchCorrection = toFloat(value, valueLength, 0.0f);
+	else if (keyEquals(key, keyLength, "Delay"))
+		element.trackerDelay = toInt(value, valueLength, 0);
 	else
 		return false;
+
+	return true;
 }
 
-CMB_PIPE CmbParser::parsePipe(wxFileConfig *ini, int pipeIndex) {
-	wxString pipeStr = wxString::Format(wxT("Pipe%0.3d"), pipeIndex);
+void CmbParser::collectSections(std::vector<CMB_PARSED_SECTION> &sections, std::vector<CMB_ELEMENT_WITH_PIPES> &elements) {
+	for (unsigned i = 0; i < sections.size() && sections[i].exists; i++) {
+		CMB_ELEMENT_WITH_PIPES elementWithPipes;
+		elementWithPipes.attributes = sections[i].attributes;
+
+		for (unsigned j = 0; j < sections[i].pipes.size(); j++) {
+			if (sections[i].hasPipe[j]) {
+				CMB_PIPE thePipe;
+				thePipe.pipeNbr = j + 1;
+				thePipe.attributes = sections[i].pipes[j];
+				elementWithPipes.pipes.push_back(thePipe);
+			}
+		}
+
+		elements.push_back(elementWithPipes);
+	}
+}
 
-	float amplitude;
-	parseFloat(ini, pipeStr + wxT("Amplitude"), &amplitude, 100.0f);
+void CmbParser::setDefaults(CMB_ELEMENT &element) {
+	element.amplitude = 100.0f;
+	element.gain = 0.0f;
+	element.pitchTuning = 0.0f;
+	element.pitchCorrection = 0.0f;
+	element.trackerDelay = 0;
+}
 
-	float gain;
-	parseFloat(ini, pipeStr + wxT("UserGain"), &gain, 0.0f);
+bool CmbParser::keyEquals(const char *key, size_t keyLength, const char *name) {
+	return keyLength == strlen(name) && strncmp(key, name, keyLength) == 0;
+}
 
-	float pitchTuning;
-	parseFloat(ini, pipeStr + wxT("ManualTuning"), &pitchTuning, 0.0f);
+wxString CmbParser::toString(const char *value, size_t length) {
+	// remove quotes and escapes the same way as wxFileConfig does
+	if (length > 1 && value[0] == '"' && value[length - 1] == '"') {
+		value++;
+		length -= 2;
+	}
 
-	float pitchCorrection;
-	parseFloat(ini, pipeStr + wxT("AutoTuningCorrection"), &pitchCorrection, 0.0f);
+	std::string unescaped;
+	unescaped.reserve(length);
+	for (size_t i = 0; i < length; i++) {
+		if (value[i] == '\\' && i + 1 < length) {
+			char next = value[i + 1];
+			if (next == 'n') {
+				unescaped += '\n';
+				i++;
+				continue;
+			} else if (next == 't') {
+				unescaped += '\t';
+				i++;
+				continue;
+			} else if (next == 'r') {
+				unescaped += '\r';
+				i++;
+				continue;
+			} else if (next == '\\' || next == '"') {
+				unescaped += next;
+				i++;
+				continue;
+			}
+		}
+		unescaped += value[i];
+	}
 
-	int trackerDelay;
-	parseInt(ini, pipeStr + wxT("Delay"), &trackerDelay, 0);
+	wxString result = wxString::FromUTF8(unescaped.c_str(), unescaped.length());
+	if (result.IsEmpty() && !unescaped.empty())
+		result = wxString(unescaped.c_str(), wxConvISO8859_1, unescaped.length());
+	return result;
+}
 
-	CMB_PIPE thePipe;
-	thePipe.pipeNbr = pipeIndex;
-	thePipe.attributes.amplitude = amplitude;
-	thePipe.attributes.gain = gain;
-	thePipe.attributes.pitchTuning = pitchTuning;
-	thePipe.attributes.pitchCorrection = pitchCorrection;
-	thePipe.attributes.trackerDelay = trackerDelay;
+float CmbParser::toFloat(const char *value, size_t length, float defaultValue) {
+	double parsedValue;
+	wxString valueStr = wxString::FromAscii(value, length);
+	if (valueStr.ToCDouble(&parsedValue) || valueStr.ToDouble(&parsedValue))
+		return (float) parsedValue;
+	return defaultValue;
+}
 
-	return thePipe;
+int CmbParser::toInt(const char *value, size_t length, int defaultValue) {
+	long parsedValue;
+	if (wxString::FromAscii(value, length).ToLong(&parsedValue))
+		return (int) parsedValue;
+	return defaultValue;
 }
@@ -22,9 +22,20 @@
 #define CMBPARSER_H
 
 #include <wx/wx.h>
-#include <wx/fileconf.h>
+#include <wx/stream.h>
+#include <vector>
 #include "CmbOrgan.h"
 
+struct CMB_PARSED_SECTION {
+	bool exists;
+	CMB_ELEMENT attributes;
+	std::vector<CMB_ELEMENT> pipes; // indexed by pipe number - 1
+	std::vector<bool> hasPipe;
+};
+
+// The decompressed cmb is tokenized in a single pass where every section and
+// pipe value is stored directly at its index, instead of probing for numbered
+// sections and pipe keys one by one.
 class CmbParser {
 public:
 	CmbParser(wxString filePath, CMB_ORGAN *cmbOrgan);
@@ -36,14 +47,24 @@ public:
 private:
 	bool m_isOk;
 	wxString m_errorText;
+	bool m_hasOrganSection;
+	CMB_PARSED_SECTION m_organ;
+	std::vector<CMB_PARSED_SECTION> m_windchests;
+	std::vector<CMB_PARSED_SECTION> m_ranks;
+	std::vector<CMB_PARSED_SECTION> m_stops;
 
 	bool readCmbFile(wxString fileName, CMB_ORGAN *cmbOrgan);
-	bool parseString(wxFileConfig *ini, wxString key, wxString *value, wxString defaultValue = wxEmptyString);
-	bool parseInt(wxFileConfig *ini, wxString key, int *value, int defaultValue = -1);
-	bool parseFloat(wxFileConfig *ini, wxString key, float *value, float defaultValue = 0.0f);
-	bool parseSection(wxFileConfig *ini, wxString section, CMB_ORGAN *cmbOrgan);
-	bool hasPipeKey(wxFileConfig *ini, int pipeIndex);
-	CMB_PIPE parsePipe(wxFileConfig *ini, int pipeIndex);
+	bool readDecompressed(wxInputStream &in, std::vector<char> &buffer);
+	void tokenize(const char *data, size_t length, CMB_ORGAN *cmbOrgan);
+	CMB_PARSED_SECTION* getSection(const char *name, size_t length);
+	void parseEntry(CMB_PARSED_SECTION *section, const char *key, size_t keyLength, const char *value, size_t valueLength, CMB_ORGAN *cmbOrgan);
+	bool parseAttribute(CMB_ELEMENT &element, const char *key, size_t keyLength, const char *value, size_t valueLength);
+	void collectSections(std::vector<CMB_PARSED_SECTION> &sections, std::vector<CMB_ELEMENT_WITH_PIPES> &elements);
+	void setDefaults(CMB_ELEMENT &element);
+	bool keyEquals(const char *key, size_t keyLength, const char *name);
+	wxString toString(const char *value, size_t length);
+	float toFloat(const char *value, size_t length, float defaultValue);
+	int toInt(const char *value, size_t length, int defaultValue);
 };
 
 #endif
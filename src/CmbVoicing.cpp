@@ -0,0 +1,138 @@
+/*
+ * CmbParser.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "CmbVoicing.h"
+#include <iterator>
+
+bool CmbVoicing::countsMatch(const CMB_ORGAN *imported, Organ *organ) {
+	return organ->getNumberOfRanks() == imported->cmbRanks.size() &&
+		organ->getNumberOfStops() == imported->cmbStops.size() &&
+		organ->getNumberOfWindchestgroups() == imported->cmbWindchests.size();
+}
+
+void CmbVoicing::apply(
+	const CMB_ORGAN *imported,
+	Organ *organ,
+	const CMB_IMPORT_OPTIONS &options,
+	std::function<bool(const wxString&)> clampOutOfBounds
+) {
+	applyAttributes(organ, imported->attributes, options, clampOutOfBounds);
+
+	// the organ elements are walked in parallel with the imported ones
+	std::list<Windchestgroup>::iterator windchestIt = organ->getOrganWindchestgroups()->begin();
+	for (const CMB_ELEMENT &w : imported->cmbWindchests) {
+		if (windchestIt == organ->getOrganWindchestgroups()->end())
+			break;
+		applyAttributes(&(*windchestIt), w, options, clampOutOfBounds);
+		++windchestIt;
+	}
+
+	std::list<Stop>::iterator stopIt = organ->getOrganStops()->begin();
+	for (const CMB_ELEMENT_WITH_PIPES &s : imported->cmbStops) {
+		if (stopIt == organ->getOrganStops()->end())
+			break;
+		Stop *stop = &(*stopIt);
+		++stopIt;
+		if (!stop->isUsingInternalRank())
+			continue;
+		applyAttributes(stop->getInternalRank(), s.attributes, options, clampOutOfBounds);
+		applyPipes(stop->getInternalRank(), s.pipes, options);
+	}
+
+	std::list<Rank>::iterator rankIt = organ->getOrganRanks()->begin();
+	for (const CMB_ELEMENT_WITH_PIPES &r : imported->cmbRanks) {
+		if (rankIt == organ->getOrganRanks()->end())
+			break;
+		Rank *rank = &(*rankIt);
+		++rankIt;
+		applyAttributes(rank, r.attributes, options, clampOutOfBounds);
+		applyPipes(rank, r.pipes, options);
+	}
+}
+
+template<class T>
+void CmbVoicing::applyAttributes(
+	T *target,
+	const CMB_ELEMENT &attributes,
+	const CMB_IMPORT_OPTIONS &options,
+	std::function<bool(const wxString&)> &clampOutOfBounds
+) {
+	if (options.amplitude)
+		target->setAmplitudeLevel(attributes.amplitude);
+	if (options.gain)
+		target->setGain(attributes.gain);
+	if (options.pitchTuning) {
+		float pitchT = target->getPitchTuning() + attributes.pitchTuning;
+		if (clampPitch(pitchT, wxT("PitchTuning"), clampOutOfBounds))
+			target->setPitchTuning(pitchT);
+	}
+	if (options.pitchCorrection) {
+		float pitchC = target->getPitchCorrection() + attributes.pitchCorrection;
+		if (clampPitch(pitchC, wxT("PitchCorrection"), clampOutOfBounds))
+			target->setPitchCorrection(pitchC);
+	}
+	if (options.trackerDelay)
+		target->setTrackerDelay(attributes.trackerDelay);
+}
+
+void CmbVoicing::applyPipes(Rank *rank, const std::vector<CMB_PIPE> &pipes, const CMB_IMPORT_OPTIONS &options) {
+	// the imported pipes are in ascending order
+	std::list<Pipe>::iterator pipeIt = rank->m_pipes.begin();
+	unsigned pipeItIdx = 0;
+	for (const CMB_PIPE &p : pipes) {
+		unsigned pipeIdx = p.pipeNbr - 1;
+		if (pipeIdx >= rank->m_pipes.size() || pipeIdx < pipeItIdx)
+			continue;
+		std::advance(pipeIt, pipeIdx - pipeItIdx);
+		pipeItIdx = pipeIdx;
+		Pipe *pipe = &(*pipeIt);
+
+		if (options.amplitude)
+			pipe->amplitudeLevel = p.attributes.amplitude;
+		if (options.gain)
+			pipe->gain = p.attributes.gain;
+		// out of bounds pipe values are silently left unchanged
+		if (options.pitchTuning) {
+			float pitchT = pipe->pitchTuning + p.attributes.pitchTuning;
+			if (pitchT >= -1800 && pitchT <= 1800)
+				pipe->pitchTuning = pitchT;
+		}
+		if (options.pitchCorrection) {
+			float pitchC = pipe->pitchCorrection + p.attributes.pitchCorrection;
+			if (pitchC >= -1800 && pitchC <= 1800)
+				pipe->pitchCorrection = pitchC;
+		}
+		if (options.trackerDelay)
+			pipe->trackerDelay = p.attributes.trackerDelay;
+	}
+	rank->markChanged();
+}
+
+bool CmbVoicing::clampPitch(float &value, const wxString &attribute, std::function<bool(const wxString&)> &clampOutOfBounds) {
+	if (value >= -1800 && value <= 1800)
+		return true;
+	if (!clampOutOfBounds || !clampOutOfBounds(attribute))
+		return false;
+	if (value > 1800)
+		value = 1800;
+	else
+		value = -1800;
+	return true;
+}
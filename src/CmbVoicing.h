@@ -0,0 +1,63 @@
+/*
+ * CmbVoicing.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef CMBVOICING_H
+#define CMBVOICING_H
+
+#include <wx/wx.h>
+#include <functional>
+#include "CmbOrgan.h"
+#include "Organ.h"
+
+struct CMB_IMPORT_OPTIONS {
+	bool amplitude;
+	bool gain;
+	bool pitchTuning;
+	bool pitchCorrection;
+	bool trackerDelay;
+};
+
+// Applies the voicing of a parsed .cmb file to an organ. Windchests, stops and
+// ranks are matched by order. When a summed PitchTuning/PitchCorrection on the
+// organ, a windchest or a rank would be out of bounds clampOutOfBounds is asked
+// with the attribute name whether to set it to the allowed limit instead.
+class CmbVoicing {
+public:
+	static bool countsMatch(const CMB_ORGAN *imported, Organ *organ);
+	static void apply(
+		const CMB_ORGAN *imported,
+		Organ *organ,
+		const CMB_IMPORT_OPTIONS &options,
+		std::function<bool(const wxString&)> clampOutOfBounds
+	);
+
+private:
+	template<class T>
+	static void applyAttributes(
+		T *target,
+		const CMB_ELEMENT &attributes,
+		const CMB_IMPORT_OPTIONS &options,
+		std::function<bool(const wxString&)> &clampOutOfBounds
+	);
+	static void applyPipes(Rank *rank, const std::vector<CMB_PIPE> &pipes, const CMB_IMPORT_OPTIONS &options);
+	static bool clampPitch(float &value, const wxString &attribute, std::function<bool(const wxString&)> &clampOutOfBounds);
+};
+
+#endif
@@ -22,12 +22,14 @@
 #include "GOODFDef.h"
 #include "GOODF.h"
 #include <wx/statline.h>
+#include "PanelThumbnailCache.h"
 
 IMPLEMENT_CLASS(CopyElementAttributesDialog, wxDialog)
 
 BEGIN_EVENT_TABLE(CopyElementAttributesDialog, wxDialog)
-	EVT_CHOICE(ID_ELEMENT_COPY_DIALOG_PANELCHOICE, CopyElementAttributesDialog::OnPanelChoice)
+	EVT_COMBOBOX(ID_ELEMENT_COPY_DIALOG_PANELCHOICE, CopyElementAttributesDialog::OnPanelChoice)
 	EVT_LISTBOX(ID_ELEMENT_COPY_DIALOG_BOX, CopyElementAttributesDialog::OnElementChoice)
+	EVT_THREAD(ID_PANEL_THUMBNAILS_UPDATED, CopyElementAttributesDialog::OnPanelThumbnailsUpdated)
 END_EVENT_TABLE()
 
 CopyElementAttributesDialog::CopyElementAttributesDialog(GoPanel *sourcePanel, int sourceElementIndex) {
@@ -48,7 +50,9 @@ CopyElementAttributesDialog::CopyElementAttributesDialog(
 }
 
 CopyElementAttributesDialog::~CopyElementAttributesDialog() {
-
+	// thumbnails not done yet are not needed anymore
+	::wxGetApp().m_frame->GetPanelThumbnails()->removeListener(this);
+	::wxGetApp().m_frame->GetPanelThumbnails()->cancel();
 }
 
 void CopyElementAttributesDialog::Init(GoPanel *sourcePanel, int sourceElementIndex) {
@@ -73,6 +77,8 @@ bool CopyElementAttributesDialog::Create(
 
 	m_panelChoice->Select(m_panelList.Index(m_sourcePanel->getName()));
 	updateAvailableGuiElements();
+	::wxGetApp().m_frame->GetPanelThumbnails()->addListener(this);
+	updatePanelThumbnails();
 
 	GetSizer()->Fit(this);
 	GetSizer()->SetSizeHints(this);
@@ -91,12 +97,14 @@ void CopyElementAttributesDialog::CreateControls() {
 		wxT("Target panel: ")
 	);
 	firstRow->Add(panelText, 0, wxALIGN_CENTER|wxALL, 5);
-	m_panelChoice = new wxChoice(
+	m_panelChoice = new wxBitmapComboBox(
 		this,
 		ID_ELEMENT_COPY_DIALOG_PANELCHOICE,
+		wxEmptyString,
 		wxDefaultPosition,
 		wxDefaultSize,
-		m_panelList
+		m_panelList,
+		wxCB_READONLY
 	);
 	firstRow->Add(m_panelChoice, 1, wxGROW|wxALL, 5);
 	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
@@ -182,6 +190,21 @@ void CopyElementAttributesDialog::OnElementChoice(wxCommandEvent& WXUNUSED(event
 	}
 }
 
+void CopyElementAttributesDialog::OnPanelThumbnailsUpdated(wxThreadEvent& WXUNUSED(event)) {
+	updatePanelThumbnails();
+}
+
+void CopyElementAttributesDialog::updatePanelThumbnails() {
+	// panels without a thumbnail yet get an empty image of the same size so
+	// that the combo box doesn't change size when the thumbnails arrive
+	wxSize thumbnailSize(64, 48);
+	for (unsigned i = 0; i < m_panelChoice->GetCount(); i++) {
+		wxBitmap thumbnail;
+		::wxGetApp().m_frame->GetPanelThumbnails()->getThumbnail(::wxGetApp().m_frame->m_organ->getOrganPanelAt(i), thumbnail);
+		m_panelChoice->SetItemBitmap(i, PanelThumbnailCache::fitToSize(thumbnail, thumbnailSize));
+	}
+}
+
 void CopyElementAttributesDialog::updateAvailableGuiElements() {
 	// This method will populate the list of available elements for this panel
 	if (!m_matchingElementsList.IsEmpty()) {
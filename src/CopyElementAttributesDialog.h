@@ -22,6 +22,7 @@
 #define COPYELEMENTATTRIBUTESDIALOG_H
 
 #include <wx/wx.h>
+#include <wx/bmpcbox.h>
 #include "GoPanel.h"
 #include <vector>
 
@@ -68,7 +69,7 @@ public:
 private:
 	int m_sourceElementIndex;
 	GoPanel *m_sourcePanel;
-	wxChoice *m_panelChoice;
+	wxBitmapComboBox *m_panelChoice;
 	wxListBox *m_availableElements;
 
 	// m_panelList contain all available panels in the organ to choose as target container
@@ -82,8 +83,10 @@ private:
 	// Event methods
 	void OnPanelChoice(wxCommandEvent& event);
 	void OnElementChoice(wxCommandEvent& event);
+	void OnPanelThumbnailsUpdated(wxThreadEvent& event);
 
 	void updateAvailableGuiElements();
+	void updatePanelThumbnails();
 };
 
 #endif
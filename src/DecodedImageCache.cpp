@@ -0,0 +1,132 @@
+/*
+ * DecodedImageCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DecodedImageCache.h"
+#include "TraceRecorder.h"
+#include <wx/filename.h>
+
+// the decoded panel images kept before the least recently used are dropped
+static const size_t MAX_DECODED_BYTES = 512 * 1024 * 1024;
+
+std::mutex DecodedImageCache::s_mutex;
+std::map<DecodedImageCache::IMAGE_KEY, DECODED_IMAGE> DecodedImageCache::s_images;
+size_t DecodedImageCache::s_totalBytes = 0;
+unsigned long DecodedImageCache::s_lastUse = 0;
+
+wxImage DecodedImageCache::getImage(const wxString &imagePath, const wxString &maskPath) {
+	if (imagePath == wxEmptyString)
+		return wxImage();
+	IMAGE_KEY key(imagePath, maskPath);
+	time_t imageModified = getFileTime(imagePath);
+	time_t maskModified = getFileTime(maskPath);
+	wxImage copy;
+	if (findImage(key, imageModified, maskModified, &copy))
+		return copy;
+
+	// decoded without holding the lock so that other threads can use the cache meanwhile
+	wxImage image = decode(imagePath, maskPath);
+	if (image.IsOk())
+		copy = image.Copy();
+	storeImage(key, image, imageModified, maskModified);
+	return copy;
+}
+
+void DecodedImageCache::prefetch(const wxString &imagePath, const wxString &maskPath) {
+	if (imagePath == wxEmptyString)
+		return;
+	IMAGE_KEY key(imagePath, maskPath);
+	time_t imageModified = getFileTime(imagePath);
+	time_t maskModified = getFileTime(maskPath);
+	if (findImage(key, imageModified, maskModified, NULL))
+		return;
+
+	wxImage image = decode(imagePath, maskPath);
+	storeImage(key, image, imageModified, maskModified);
+}
+
+void DecodedImageCache::clear() {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_images.clear();
+	s_totalBytes = 0;
+}
+
+bool DecodedImageCache::findImage(const IMAGE_KEY &key, time_t imageModified, time_t maskModified, wxImage *copy) {
+	// wxImage data isn't shared between threads, so only copies are made while locked
+	std::lock_guard<std::mutex> lock(s_mutex);
+	std::map<IMAGE_KEY, DECODED_IMAGE>::iterator found = s_images.find(key);
+	if (found == s_images.end() || found->second.imageModified != imageModified || found->second.maskModified != maskModified)
+		return false;
+	found->second.lastUse = ++s_lastUse;
+	if (copy && found->second.image.IsOk())
+		*copy = found->second.image.Copy();
+	return true;
+}
+
+wxImage DecodedImageCache::decode(const wxString &imagePath, const wxString &maskPath) {
+	TraceScope trace("DecodedImageCache::decode", imagePath);
+	wxImage image(imagePath);
+	if (image.IsOk() && maskPath != wxEmptyString) {
+		// a mask that can't be read is ignored
+		wxImage mask(maskPath);
+		if (mask.IsOk())
+			image.SetMaskFromImage(mask, 0xFF, 0xFF, 0xFF);
+	}
+	return image;
+}
+
+void DecodedImageCache::storeImage(const IMAGE_KEY &key, wxImage &image, time_t imageModified, time_t maskModified) {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	DECODED_IMAGE &entry = s_images[key];
+	s_totalBytes -= getBytes(entry.image);
+	entry.image = image;
+	entry.imageModified = imageModified;
+	entry.maskModified = maskModified;
+	entry.lastUse = ++s_lastUse;
+	// the caller's reference is released while still locked
+	image = wxImage();
+	s_totalBytes += getBytes(entry.image);
+	dropLeastRecentlyUsed();
+}
+
+void DecodedImageCache::dropLeastRecentlyUsed() {
+	// the most recently used image is always kept
+	while (s_totalBytes > MAX_DECODED_BYTES && s_images.size() > 1) {
+		std::map<IMAGE_KEY, DECODED_IMAGE>::iterator oldest = s_images.begin();
+		for (std::map<IMAGE_KEY, DECODED_IMAGE>::iterator it = s_images.begin(); it != s_images.end(); ++it) {
+			if (it->second.lastUse < oldest->second.lastUse)
+				oldest = it;
+		}
+		s_totalBytes -= getBytes(oldest->second.image);
+		s_images.erase(oldest);
+	}
+}
+
+size_t DecodedImageCache::getBytes(const wxImage &image) {
+	if (!image.IsOk())
+		return 0;
+	size_t pixels = (size_t) image.GetWidth() * image.GetHeight();
+	return pixels * (image.HasAlpha() ? 4 : 3);
+}
+
+time_t DecodedImageCache::getFileTime(const wxString &path) {
+	if (path == wxEmptyString || !wxFileName::FileExists(path))
+		return 0;
+	return wxFileModificationTime(path);
+}
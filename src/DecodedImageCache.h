@@ -0,0 +1,66 @@
+/*
+ * DecodedImageCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DECODEDIMAGECACHE_H
+#define DECODEDIMAGECACHE_H
+
+#include <wx/wx.h>
+#include <mutex>
+#include <map>
+#include <utility>
+
+struct DECODED_IMAGE {
+	wxImage image; // never handed out, only deep copies of it
+	time_t imageModified;
+	time_t maskModified;
+	unsigned long lastUse;
+};
+
+// Keeps the decoded image files (with their mask applied) of the panels so
+// that drawing a panel again doesn't read and decode them again. A file is
+// decoded again if it has been modified since. It can be used from any thread,
+// so the files of a panel can be decoded on a worker thread and the gui thread
+// then only has to make bitmaps of them. The least recently used images are
+// dropped when the decoded images grow above a fixed size.
+class DecodedImageCache {
+public:
+	// returns a copy of the decoded image, an invalid image if it can't be read
+	static wxImage getImage(const wxString &imagePath, const wxString &maskPath = wxEmptyString);
+	// decodes the image if it isn't already
+	static void prefetch(const wxString &imagePath, const wxString &maskPath = wxEmptyString);
+	static void clear();
+
+private:
+	typedef std::pair<wxString, wxString> IMAGE_KEY; // image, mask
+
+	static std::mutex s_mutex;
+	static std::map<IMAGE_KEY, DECODED_IMAGE> s_images;
+	static size_t s_totalBytes;
+	static unsigned long s_lastUse;
+
+	static bool findImage(const IMAGE_KEY &key, time_t imageModified, time_t maskModified, wxImage *copy);
+	static wxImage decode(const wxString &imagePath, const wxString &maskPath);
+	static void storeImage(const IMAGE_KEY &key, wxImage &image, time_t imageModified, time_t maskModified);
+	static void dropLeastRecentlyUsed();
+	static size_t getBytes(const wxImage &image);
+	static time_t getFileTime(const wxString &path);
+};
+
+#endif
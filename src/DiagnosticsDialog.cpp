@@ -0,0 +1,167 @@
+/*
+ * DiagnosticsDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DiagnosticsDialog.h"
+#include "GOODFDef.h"
+#include "GOODF.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(DiagnosticsDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(DiagnosticsDialog, wxDialog)
+	EVT_LIST_ITEM_ACTIVATED(ID_DIAGNOSTICS_LIST, DiagnosticsDialog::OnDiagnosticActivated)
+	EVT_BUTTON(ID_DIAGNOSTICS_REVALIDATE_BTN, DiagnosticsDialog::OnRevalidate)
+	EVT_BUTTON(wxID_CLOSE, DiagnosticsDialog::OnCloseButton)
+END_EVENT_TABLE()
+
+DiagnosticsDialog::DiagnosticsDialog() {
+	Init();
+}
+
+DiagnosticsDialog::DiagnosticsDialog(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init();
+	Create(parent, id, caption, pos, size, style);
+}
+
+DiagnosticsDialog::~DiagnosticsDialog() {
+
+}
+
+void DiagnosticsDialog::Init() {
+	m_summaryText = NULL;
+	m_diagnosticsList = NULL;
+}
+
+bool DiagnosticsDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void DiagnosticsDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	m_summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("The organ has not been validated yet.")
+	);
+	firstRow->Add(m_summaryText, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxVERTICAL);
+	m_diagnosticsList = new wxListCtrl(
+		this,
+		ID_DIAGNOSTICS_LIST,
+		wxDefaultPosition,
+		wxSize(860, 360),
+		wxLC_REPORT|wxLC_SINGLE_SEL|wxLC_HRULES|wxLC_VRULES
+	);
+	m_diagnosticsList->AppendColumn(wxT("Severity"), wxLIST_FORMAT_LEFT, 80);
+	m_diagnosticsList->AppendColumn(wxT("Element"), wxLIST_FORMAT_LEFT, 220);
+	m_diagnosticsList->AppendColumn(wxT("Problem"), wxLIST_FORMAT_LEFT, 460);
+	m_diagnosticsList->AppendColumn(wxT("Rule"), wxLIST_FORMAT_LEFT, 100);
+	secondRow->Add(m_diagnosticsList, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(secondRow, 1, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *revalidateButton = new wxButton(
+		this,
+		ID_DIAGNOSTICS_REVALIDATE_BTN,
+		wxT("Check all again")
+	);
+	revalidateButton->SetToolTip(wxT("Check every element and read all sample files again, e.g. after they have been changed outside GoOdf"));
+	bottomRow->Add(revalidateButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *closeButton = new wxButton(
+		this,
+		wxID_CLOSE,
+		wxT("Close")
+	);
+	bottomRow->Add(closeButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void DiagnosticsDialog::UpdateDiagnostics(Organ *organ, OrganValidator *validator) {
+	m_diagnostics = validator->getDiagnostics();
+	// errors are listed before warnings, otherwise in organ order
+	std::stable_sort(m_diagnostics.begin(), m_diagnostics.end(), [](const VALIDATION_DIAGNOSTIC &a, const VALIDATION_DIAGNOSTIC &b) {
+		return a.severity > b.severity;
+	});
+
+	if (m_diagnostics.empty())
+		m_summaryText->SetLabel(wxT("No problems found."));
+	else
+		m_summaryText->SetLabel(wxString::Format(wxT("%u errors and %u warnings found. Double click a row to select the element."), validator->getNumberOfErrors(), validator->getNumberOfWarnings()));
+
+	m_diagnosticsList->Freeze();
+	m_diagnosticsList->DeleteAllItems();
+	for (unsigned i = 0; i < m_diagnostics.size(); i++) {
+		const VALIDATION_DIAGNOSTIC &d = m_diagnostics[i];
+		long idx = m_diagnosticsList->InsertItem(i, d.severity == VALIDATION_ERROR ? wxT("Error") : wxT("Warning"));
+		m_diagnosticsList->SetItem(idx, 1, OrganValidator::getSubjectName(organ, d.kind, d.subjectIndex));
+		m_diagnosticsList->SetItem(idx, 2, d.message);
+		m_diagnosticsList->SetItem(idx, 3, d.ruleId);
+	}
+	m_diagnosticsList->Thaw();
+}
+
+void DiagnosticsDialog::OnDiagnosticActivated(wxListEvent& event) {
+	long row = event.GetIndex();
+	if (row < 0 || row >= (long) m_diagnostics.size())
+		return;
+	::wxGetApp().m_frame->SelectValidationSubject(m_diagnostics[row]);
+}
+
+void DiagnosticsDialog::OnRevalidate(wxCommandEvent& WXUNUSED(event)) {
+	::wxGetApp().m_frame->ValidateOrgan(true);
+}
+
+void DiagnosticsDialog::OnCloseButton(wxCommandEvent& WXUNUSED(event)) {
+	Hide();
+}
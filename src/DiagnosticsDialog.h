@@ -0,0 +1,81 @@
+/*
+ * DiagnosticsDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <vector>
+#include "Organ.h"
+#include "OrganValidator.h"
+
+// Modeless list of the problems found by the organ validator. It is kept
+// updated by the frame while shown and activating a row selects the element.
+class DiagnosticsDialog : public wxDialog {
+	DECLARE_CLASS(DiagnosticsDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	DiagnosticsDialog();
+	DiagnosticsDialog(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Organ diagnostics"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~DiagnosticsDialog();
+
+	// Initialize our variables
+	void Init();
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Organ diagnostics"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	void UpdateDiagnostics(Organ *organ, OrganValidator *validator);
+
+private:
+	std::vector<VALIDATION_DIAGNOSTIC> m_diagnostics;
+
+	wxStaticText *m_summaryText;
+	wxListCtrl *m_diagnosticsList;
+
+	// Event methods
+	void OnDiagnosticActivated(wxListEvent& event);
+	void OnRevalidate(wxCommandEvent& event);
+	void OnCloseButton(wxCommandEvent& event);
+
+};
+
+#endif
@@ -19,6 +19,7 @@
  */
 
 #include "DisplayMetricsPanel.h"
+#include "GoPanel.h"
 #include "GOODF.h"
 #include "GOODFDef.h"
 #include <wx/msgdlg.h>
@@ -85,6 +86,7 @@ DisplayMetricsPanel::DisplayMetricsPanel(wxWindow *parent) : wxPanel(parent) {
 	GoColor col;
 	m_colors = col.getColorNames();
 	m_displayMetrics = NULL;
+	m_owningPanel = NULL;
 
 	wxBoxSizer *panelSizer = new wxBoxSizer(wxVERTICAL);
 	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
@@ -879,9 +881,10 @@ DisplayMetricsPanel::~DisplayMetricsPanel() {
 
 }
 
-void DisplayMetricsPanel::setDisplayMetrics(DisplayMetrics *displayMetrics) {
+void DisplayMetricsPanel::setDisplayMetrics(DisplayMetrics *displayMetrics, GoPanel *owningPanel) {
 	SetupWoodBitmapBoxes();
 	m_displayMetrics = displayMetrics;
+	m_owningPanel = owningPanel;
 	m_screenSizeHorizChoice->SetSelection(m_displayMetrics->m_dispScreenSizeHoriz.getSelectedNameIndex());
 	m_screenSizeHorizSpin->SetValue(m_displayMetrics->m_dispScreenSizeHoriz.getNumericalValue());
 	if (m_displayMetrics->m_dispScreenSizeHoriz.getSelectedNameIndex() != 4)
@@ -1141,6 +1144,7 @@ void DisplayMetricsPanel::OnHorizontalSizeChoice(wxCommandEvent& event) {
 		} else {
 			m_screenSizeHorizSpin->SetValue(m_displayMetrics->m_dispScreenSizeHoriz.getNumericalValue());
 			m_screenSizeHorizSpin->Disable();
+			m_owningPanel->markChanged();
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -1149,6 +1153,7 @@ void DisplayMetricsPanel::OnHorizontalSizeChoice(wxCommandEvent& event) {
 void DisplayMetricsPanel::OnHorizontalSizeChange(wxSpinEvent& event) {
 	if (event.GetId() == ID_HORIZONTAL_SIZE_SPIN) {
 		m_displayMetrics->m_dispScreenSizeHoriz.setNumericalValue(m_screenSizeHorizSpin->GetValue());
+		m_owningPanel->markChanged();
 		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 	}
 }
@@ -1161,6 +1166,7 @@ void DisplayMetricsPanel::OnVerticalSizeChoice(wxCommandEvent& event) {
 		} else {
 			m_screenSizeVertSpin->SetValue(m_displayMetrics->m_dispScreenSizeVert.getNumericalValue());
 			m_screenSizeVertSpin->Disable();
+			m_owningPanel->markChanged();
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -1169,32 +1175,38 @@ void DisplayMetricsPanel::OnVerticalSizeChoice(wxCommandEvent& event) {
 void DisplayMetricsPanel::OnVerticalSizeChange(wxSpinEvent& event) {
 	if (event.GetId() == ID_VERTICAL_SIZE_SPIN) {
 		m_displayMetrics->m_dispScreenSizeVert.setNumericalValue(m_screenSizeVertSpin->GetValue());
+		m_owningPanel->markChanged();
 		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 	}
 }
 
 void DisplayMetricsPanel::OnDrawstopBackgroundChange(wxCommandEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispDrawstopBackgroundImageNum = m_drawstopBackground->GetSelection() + 1;
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnConsoleBackgroundChange(wxCommandEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispConsoleBackgroundImageNum = m_consoleBackground->GetSelection() + 1;
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnKeyHorizontalChange(wxCommandEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispKeyHorizBackgroundImageNum = m_keyHorizBackground->GetSelection() + 1;
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnKeyVerticalChange(wxCommandEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispKeyVertBackgroundImageNum = m_keyVertBackground->GetSelection() + 1;
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnDrawstopInsetBgChange(wxCommandEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispDrawstopInsetBackgroundImageNum = m_drawstopInsetBackground->GetSelection() + 1;
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1213,11 +1225,13 @@ void DisplayMetricsPanel::OnControlLabelFontChange(wxFontPickerEvent& WXUNUSED(e
 			}
 		}
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void DisplayMetricsPanel::OnShortcutKeyLabelFontChange(wxFontPickerEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispShortcutKeyLabelFont = m_shortcutKeyLabelFont->GetSelectedFont();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1231,12 +1245,14 @@ void DisplayMetricsPanel::OnShortcutKeyLabelColourChoice(wxCommandEvent& event)
 			m_shortcutKeyColourPick->Disable();
 		}
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void DisplayMetricsPanel::OnShortcutKeyLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_SHORTCUT_COLOUR_PICKER) {
 		m_displayMetrics->m_dispShortcutKeyLabelColour.setColorValue(m_shortcutKeyColourPick->GetColour());
+		m_owningPanel->markChanged();
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1256,6 +1272,7 @@ void DisplayMetricsPanel::OnGroupLabelFontChange(wxFontPickerEvent& WXUNUSED(eve
 			}
 		}
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1288,12 +1305,14 @@ void DisplayMetricsPanel::OnDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 		}
 	}
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnDrawstopRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispDrawstopRows = m_drawstopRows->GetValue();
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1307,6 +1326,7 @@ void DisplayMetricsPanel::OnDrawstopColsOffsetRadio(wxCommandEvent& event) {
 		m_drawstopOuterColOffsetUpYes->Disable();
 		m_drawstopOuterColOffsetUpNo->Disable();
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1316,6 +1336,7 @@ void DisplayMetricsPanel::OnDrawstopOuterColOffsetUpRadio(wxCommandEvent& event)
 	} else {
 		m_displayMetrics->m_dispDrawstopOuterColOffsetUp = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1332,30 +1353,35 @@ void DisplayMetricsPanel::OnPairDrawstopColsRadio(wxCommandEvent& event) {
 	} else {
 		m_displayMetrics->m_dispPairDrawstopCols = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnExtraDrawstopRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispExtraDrawstopRows = m_extraDrawstopRows->GetValue();
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnExtraDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispExtraDrawstopCols = m_extraDrawstopCols->GetValue();
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnButtonColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispButtonCols = m_buttonCols->GetValue();
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnExtraButtonRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispExtraButtonRows = m_extraButtonRows->GetValue();
 	::wxGetApp().m_frame->m_organ->panelDisplayMetricsUpdate(m_displayMetrics);
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1373,6 +1399,7 @@ void DisplayMetricsPanel::OnExtraPedalButtonRowRadio(wxCommandEvent& event) {
 		m_extraPedalButtonRowOffsetRightYes->Disable();
 		m_extraPedalButtonRowOffsetRightNo->Disable();
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1382,6 +1409,7 @@ void DisplayMetricsPanel::OnExtraPedalButtonRowOffsetRadio(wxCommandEvent& event
 	} else {
 		m_displayMetrics->m_dispExtraPedalButtonRowOffset = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1391,6 +1419,7 @@ void DisplayMetricsPanel::OnExtraPedalButtonRowOffsetRightRadio(wxCommandEvent&
 	} else {
 		m_displayMetrics->m_dispExtraPedalButtonRowOffsetRight = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1400,6 +1429,7 @@ void DisplayMetricsPanel::OnButtonsAboveManualsRadio(wxCommandEvent& event) {
 	} else {
 		m_displayMetrics->m_dispButtonsAboveManuals = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1409,6 +1439,7 @@ void DisplayMetricsPanel::OnTrimAboveManualsRadio(wxCommandEvent& event) {
 	} else {
 		m_displayMetrics->m_dispTrimAboveManuals = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1418,6 +1449,7 @@ void DisplayMetricsPanel::OnTrimBelowManualsRadio(wxCommandEvent& event) {
 	} else {
 		m_displayMetrics->m_dispTrimBelowManuals = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1427,6 +1459,7 @@ void DisplayMetricsPanel::OnTrimAboveExtraRowsRadio(wxCommandEvent& event) {
 	} else {
 		m_displayMetrics->m_dispTrimAboveExtraRows = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1436,56 +1469,67 @@ void DisplayMetricsPanel::OnExtraDrawstopRowsAboveExtraButtonRowsRadio(wxCommand
 	} else {
 		m_displayMetrics->m_dispExtraDrawstopRowsAboveExtraButtonRows = false;
 	}
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnDrawstopWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispDrawstopWidth = m_drawstopWidth->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnDrawstopHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispDrawstopHeight = m_drawstopHeight->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnPistonWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispPistonWidth = m_pistonWidth->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnPistonHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispPistonHeight = m_pistonHeight->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnEnclosureWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispEnclosureWidth = m_enclosureWidth->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnEnclosureHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispEnclosureHeight = m_enclosureHeight->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnPedalHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispPedalHeight = m_pedalHeight->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnPedalKeyWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispPedalKeyWidth = m_pedalKeyWidth->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnManualHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispManualHeight = m_manualHeight->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void DisplayMetricsPanel::OnManualKeyWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_displayMetrics->m_dispManualKeyWidth = m_manualKeyWidth->GetValue();
+	m_owningPanel->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -28,12 +28,14 @@
 #include <wx/clrpicker.h>
 #include <wx/fontpicker.h>
 
+class GoPanel;
+
 class DisplayMetricsPanel : public wxPanel {
 public:
 	DisplayMetricsPanel(wxWindow *parent);
 	~DisplayMetricsPanel();
 
-	void setDisplayMetrics(DisplayMetrics *displayMetrics);
+	void setDisplayMetrics(DisplayMetrics *displayMetrics, GoPanel *owningPanel);
 	void setTooltipsEnabled(bool isEnabled);
 
 private:
@@ -93,6 +95,7 @@ private:
 	wxSpinCtrl *m_manualKeyWidth; // (integer 1-500, default: 12)
 
 	DisplayMetrics *m_displayMetrics;
+	GoPanel *m_owningPanel;
 	wxArrayString m_panelSizes;
 	wxArrayString m_colors;
 
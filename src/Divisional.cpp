@@ -21,6 +21,7 @@
 #include "Divisional.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "ReferenceIndex.h"
 
 Divisional::Divisional() : Button() {
 	m_owningManual = NULL;
@@ -257,12 +258,14 @@ unsigned Divisional::getNumberOfTremulants() {
 
 void Divisional::addTremulant(Tremulant *trem, bool isOn) {
 	m_tremulants.push_back(std::make_pair(trem, isOn));
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Divisional::removeTremulantAt(unsigned index) {
 	std::list<std::pair<Tremulant*, bool>>::iterator it = m_tremulants.begin();
 	std::advance(it, index);
 	m_tremulants.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Divisional::removeTremulant(Tremulant *trem) {
@@ -274,10 +277,12 @@ void Divisional::removeTremulant(Tremulant *trem) {
 	        ++it;  // go to next
 	    }
 	}
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Divisional::removeAllTremulants() {
 	m_tremulants.clear();
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 std::pair<Tremulant*, bool>* Divisional::getTremulantPairAt(unsigned index) {
@@ -291,12 +296,14 @@ unsigned Divisional::getNumberOfSwitches() {
 
 void Divisional::addSwitch(GoSwitch *sw, bool isOn) {
 	m_switches.push_back(std::make_pair(sw, isOn));
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Divisional::removeSwitchAt(unsigned index) {
 	std::list<std::pair<GoSwitch*, bool>>::iterator it = m_switches.begin();
 	std::advance(it, index);
 	m_switches.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Divisional::removeSwitch(GoSwitch *sw) {
@@ -312,6 +319,7 @@ void Divisional::removeSwitch(GoSwitch *sw) {
 
 void Divisional::removeAllSwitches() {
 	m_switches.clear();
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 std::pair<GoSwitch*, bool>* Divisional::getSwitchPairAt(unsigned index) {
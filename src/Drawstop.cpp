@@ -22,6 +22,7 @@
 #include "GOODFFunctions.h"
 #include "GOODF.h"
 #include "GoSwitch.h"
+#include "ReferenceIndex.h"
 
 Drawstop::Drawstop() : Button() {
 	function = wxT("Input");
@@ -149,6 +150,7 @@ GoSwitch* Drawstop::getSwitchAtIndex(unsigned index) {
 
 void Drawstop::addSwitchReference(GoSwitch *switchToAdd) {
 	m_switches.push_back(switchToAdd);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 unsigned Drawstop::getIndexOfSwitch(GoSwitch *switchToFind) {
@@ -169,16 +171,19 @@ unsigned Drawstop::getIndexOfSwitch(GoSwitch *switchToFind) {
 
 void Drawstop::removeSwitchReference(GoSwitch *sw) {
 	m_switches.remove(sw);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Drawstop::removeSwitchReferenceAt(unsigned index) {
 	std::list<GoSwitch *>::iterator it = m_switches.begin();
 	std::advance(it, index);
 	m_switches.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Drawstop::removeAllSwitchReferences() {
 	m_switches.clear();
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 bool Drawstop::hasSwitchReference(GoSwitch *sw) {
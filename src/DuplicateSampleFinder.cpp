@@ -0,0 +1,423 @@
+/*
+ * DuplicateSampleFinder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DuplicateSampleFinder.h"
+#include "ParallelTaskRunner.h"
+#include "WAVfileParser.h"
+#include "GOODFFunctions.h"
+#include <wx/ffile.h>
+#include <map>
+#include <set>
+#include <cstring>
+#include <algorithm>
+
+DuplicateSampleFinder::DuplicateSampleFinder(Organ *organ) {
+	m_organ = organ;
+
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++)
+		collectUsages(m_organ->getOrganRankAt(i), NULL);
+
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank())
+			collectUsages(stop->getInternalRank(), stop);
+	}
+
+	m_canonicalFile.resize(m_files.size());
+	for (unsigned i = 0; i < m_files.size(); i++)
+		m_canonicalFile[i] = i;
+}
+
+DuplicateSampleFinder::~DuplicateSampleFinder() {
+
+}
+
+bool DuplicateSampleFinder::scan(wxProgressDialog *progress) {
+	ParallelTaskRunner runner;
+
+	if (!runner.run(m_files.size(), [this](unsigned i) { probeFile(m_files[i]); }, progress, wxT("Reading sample headers...")))
+		return false;
+
+	// only files that share format, data size and embedded loops/cues with another file need to be hashed
+	std::map<wxString, std::vector<unsigned>> formatBuckets;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		if (m_files[i].isReadable)
+			formatBuckets[m_files[i].formatKey].push_back(i);
+	}
+	std::vector<unsigned> candidates;
+	for (auto &bucket : formatBuckets) {
+		if (bucket.second.size() > 1)
+			candidates.insert(candidates.end(), bucket.second.begin(), bucket.second.end());
+	}
+
+	if (!runner.run(candidates.size(), [this, &candidates](unsigned i) { hashFile(m_files[candidates[i]]); }, progress, wxT("Hashing audio data...")))
+		return false;
+
+	// equal hashes are confirmed by comparing the data against the first file with that hash
+	std::map<std::pair<wxString, uint64_t>, std::vector<unsigned>> hashBuckets;
+	for (unsigned idx : candidates)
+		hashBuckets[std::make_pair(m_files[idx].formatKey, m_files[idx].hash)].push_back(idx);
+	std::vector<std::pair<unsigned, unsigned>> comparisons;
+	for (auto &bucket : hashBuckets) {
+		for (unsigned i = 1; i < bucket.second.size(); i++)
+			comparisons.push_back(std::make_pair(bucket.second.front(), bucket.second[i]));
+	}
+	std::vector<char> isSame(comparisons.size(), 0);
+	if (!runner.run(comparisons.size(), [this, &comparisons, &isSame](unsigned i) {
+		isSame[i] = hasSameAudioData(m_files[comparisons[i].first], m_files[comparisons[i].second]) ? 1 : 0;
+	}, progress, wxT("Comparing duplicate candidates...")))
+		return false;
+
+	std::map<unsigned, std::vector<unsigned>> groupsByFirst;
+	for (unsigned i = 0; i < comparisons.size(); i++) {
+		if (!isSame[i])
+			continue;
+		std::vector<unsigned> &group = groupsByFirst[comparisons[i].first];
+		if (group.empty())
+			group.push_back(comparisons[i].first);
+		group.push_back(comparisons[i].second);
+		m_canonicalFile[comparisons[i].second] = comparisons[i].first;
+	}
+	for (auto &group : groupsByFirst)
+		m_groups.push_back(group.second);
+
+	findBorrowablePipes();
+	return true;
+}
+
+unsigned DuplicateSampleFinder::getNumberOfFiles() {
+	return m_files.size();
+}
+
+SAMPLE_FILE* DuplicateSampleFinder::getFileAt(unsigned index) {
+	return &m_files[index];
+}
+
+SAMPLE_USAGE* DuplicateSampleFinder::getUsageAt(unsigned index) {
+	return &m_usages[index];
+}
+
+wxString DuplicateSampleFinder::getUsageDescription(unsigned usageIndex) {
+	PIPE_LOCATION &pipe = m_usages[usageIndex].pipe;
+	if (pipe.stop)
+		return wxString::Format(wxT("Stop '%s' Pipe%0.3d"), pipe.stop->getName(), pipe.pipeIndex + 1);
+	else
+		return wxString::Format(wxT("Rank '%s' Pipe%0.3d"), pipe.rank->getName(), pipe.pipeIndex + 1);
+}
+
+unsigned DuplicateSampleFinder::getNumberOfGroups() {
+	return m_groups.size();
+}
+
+const std::vector<unsigned>& DuplicateSampleFinder::getGroupAt(unsigned index) {
+	return m_groups[index];
+}
+
+unsigned DuplicateSampleFinder::getNumberOfDuplicateFiles() {
+	unsigned nbr = 0;
+	for (std::vector<unsigned> &group : m_groups)
+		nbr += group.size() - 1;
+	return nbr;
+}
+
+wxULongLong DuplicateSampleFinder::getRedundantBytes() {
+	wxULongLong bytes = 0;
+	for (std::vector<unsigned> &group : m_groups)
+		bytes += wxULongLong(m_files[group.front()].dataSize) * (group.size() - 1);
+	return bytes;
+}
+
+unsigned DuplicateSampleFinder::getNumberOfBorrowablePipes() {
+	unsigned nbr = 0;
+	for (std::vector<unsigned> &pipes : m_borrowablePipes)
+		nbr += pipes.size() - 1;
+	return nbr;
+}
+
+unsigned DuplicateSampleFinder::makePathsShared() {
+	unsigned nbrChanged = 0;
+	for (std::vector<unsigned> &group : m_groups) {
+		SAMPLE_FILE &kept = m_files[group.front()];
+		for (unsigned i = 1; i < group.size(); i++) {
+			for (unsigned usageIdx : m_files[group[i]].usages) {
+				SAMPLE_USAGE &usage = m_usages[usageIdx];
+				if (usage.attack) {
+					usage.attack->fileName = kept.fileName;
+					usage.attack->fullPath = kept.fullPath;
+				} else {
+					usage.release->fileName = kept.fileName;
+					usage.release->fullPath = kept.fullPath;
+				}
+				usage.pipe.rank->markChanged();
+				nbrChanged++;
+			}
+		}
+	}
+	return nbrChanged;
+}
+
+unsigned DuplicateSampleFinder::borrowIdenticalPipes() {
+	unsigned nbrChanged = 0;
+	for (std::vector<unsigned> &pipes : m_borrowablePipes) {
+		wxString refString = getRefString(m_pipes[pipes.front()].pipe);
+		for (unsigned i = 1; i < pipes.size(); i++) {
+			PIPE_LOCATION &borrower = m_pipes[pipes[i]].pipe;
+			borrower.rank->clearPipeAt(borrower.pipeIndex);
+			borrower.rank->getPipeAt(borrower.pipeIndex)->m_attacks.front().fileName = refString;
+			borrower.rank->getPipeAt(borrower.pipeIndex)->m_attacks.front().fullPath = refString;
+			nbrChanged++;
+		}
+	}
+	return nbrChanged;
+}
+
+void DuplicateSampleFinder::collectUsages(Rank *rank, Stop *stop) {
+	unsigned pipeIndex = 0;
+	for (Pipe &p : rank->m_pipes) {
+		PIPE_SAMPLES pipeSamples;
+		pipeSamples.pipe.rank = rank;
+		pipeSamples.pipe.stop = stop;
+		pipeSamples.pipe.pipeIndex = pipeIndex++;
+		if (p.isFirstAttackRefPath() || p.m_attacks.empty() || p.m_attacks.front().fullPath.IsSameAs(wxT("DUMMY")))
+			continue;
+
+		pipeSamples.settings = wxString::Format(wxT("P%d,%d"), (int) p.isPercussive, (int) p.hasIndependentRelease);
+		for (Attack &atk : p.m_attacks) {
+			SAMPLE_USAGE usage;
+			usage.pipe = pipeSamples.pipe;
+			usage.attack = &atk;
+			usage.release = NULL;
+			pipeSamples.usages.push_back(addUsage(usage, atk.fullPath, atk.fileName));
+			pipeSamples.settings += wxString::Format(
+				wxT("A%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"),
+				(int) atk.loadRelease,
+				atk.attackVelocity,
+				atk.maxTimeSinceLastRelease,
+				atk.isTremulant,
+				atk.maxKeyPressTime,
+				atk.attackStart,
+				atk.cuePoint,
+				atk.releaseEnd,
+				atk.loopCrossfadeLength,
+				atk.releaseCrossfadeLength
+			);
+			for (Loop &l : atk.m_loops)
+				pipeSamples.settings += wxString::Format(wxT("L%d-%d"), l.start, l.end);
+		}
+		for (Release &rel : p.m_releases) {
+			SAMPLE_USAGE usage;
+			usage.pipe = pipeSamples.pipe;
+			usage.attack = NULL;
+			usage.release = &rel;
+			pipeSamples.usages.push_back(addUsage(usage, rel.fullPath, rel.fileName));
+			pipeSamples.settings += wxString::Format(
+				wxT("R%d,%d,%d,%d,%d"),
+				rel.isTremulant,
+				rel.maxKeyPressTime,
+				rel.cuePoint,
+				rel.releaseEnd,
+				rel.releaseCrossfadeLength
+			);
+		}
+		m_pipes.push_back(pipeSamples);
+	}
+}
+
+unsigned DuplicateSampleFinder::addUsage(SAMPLE_USAGE usage, wxString fullPath, wxString fileName) {
+	unsigned fileIndex;
+	std::map<wxString, unsigned>::iterator existing = m_fileIndexByPath.find(fullPath);
+	if (existing != m_fileIndexByPath.end()) {
+		fileIndex = existing->second;
+	} else {
+		fileIndex = m_files.size();
+		m_fileIndexByPath[fullPath] = fileIndex;
+		SAMPLE_FILE file;
+		file.fullPath = fullPath;
+		file.fileName = fileName;
+		file.isReadable = false;
+		file.dataOffset = 0;
+		file.dataSize = 0;
+		file.hash = 0;
+		m_files.push_back(file);
+	}
+	usage.fileIndex = fileIndex;
+	m_files[fileIndex].usages.push_back(m_usages.size());
+	m_usages.push_back(usage);
+	return m_usages.size() - 1;
+}
+
+void DuplicateSampleFinder::probeFile(SAMPLE_FILE &file) {
+	// missing files are simply not candidates, don't flood the log from the worker threads
+	wxLogNull logNo;
+	WAVfileParser parser(file.fullPath);
+	if (parser.isWavPacked()) {
+		// no access to decoded audio so only byte identical WavPack files can be found
+		wxFFile wvFile(file.fullPath, wxT("rb"));
+		if (!wvFile.IsOpened())
+			return;
+		file.dataOffset = 0;
+		file.dataSize = (unsigned) wvFile.Length();
+		file.formatKey = wxString::Format(wxT("wvpk:%u"), file.dataSize);
+		file.isReadable = true;
+		return;
+	}
+	if (!parser.isWavOk() || parser.getDataChunkOffset() == wxInvalidOffset)
+		return;
+
+	file.dataOffset = parser.getDataChunkOffset();
+	file.dataSize = parser.getDataChunkSize();
+	file.formatKey = wxString::Format(
+		wxT("%u:%u:%u:%u:%u"),
+		parser.getSubFormat(),
+		parser.getNumberOfChannels(),
+		parser.getSampleRate(),
+		parser.getBitsPerSample(),
+		file.dataSize
+	);
+	for (unsigned i = 0; i < parser.getNumberOfLoops(); i++) {
+		LOOP l = parser.getLoopAtIndex(i);
+		file.formatKey += wxString::Format(wxT("L%u-%u"), l.dwStart, l.dwEnd);
+	}
+	for (unsigned i = 0; i < parser.getNumberOfCues(); i++)
+		file.formatKey += wxString::Format(wxT("C%u"), parser.getCuepointAtIndex(i).dwSampleOffset);
+	file.formatKey += wxString::Format(wxT("M%u,%u"), parser.getMidiNote(), parser.getPitchFraction());
+	file.isReadable = true;
+}
+
+void DuplicateSampleFinder::hashFile(SAMPLE_FILE &file) {
+	wxLogNull logNo;
+	wxFFile sampleFile(file.fullPath, wxT("rb"));
+	if (!sampleFile.IsOpened() || !sampleFile.Seek(file.dataOffset)) {
+		file.isReadable = false;
+		return;
+	}
+
+	// 64 bit FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	std::vector<unsigned char> buffer(1 << 20);
+	unsigned bytesLeft = file.dataSize;
+	while (bytesLeft > 0) {
+		size_t toRead = std::min((size_t) bytesLeft, buffer.size());
+		size_t bytesRead = sampleFile.Read(buffer.data(), toRead);
+		if (bytesRead == 0)
+			break;
+		for (size_t i = 0; i < bytesRead; i++) {
+			hash ^= buffer[i];
+			hash *= 1099511628211ULL;
+		}
+		bytesLeft -= bytesRead;
+	}
+	file.hash = hash;
+}
+
+bool DuplicateSampleFinder::hasSameAudioData(SAMPLE_FILE &a, SAMPLE_FILE &b) {
+	if (!a.isReadable || !b.isReadable || a.dataSize != b.dataSize)
+		return false;
+
+	wxLogNull logNo;
+
+	wxFFile fileA(a.fullPath, wxT("rb"));
+	wxFFile fileB(b.fullPath, wxT("rb"));
+	if (!fileA.IsOpened() || !fileB.IsOpened() || !fileA.Seek(a.dataOffset) || !fileB.Seek(b.dataOffset))
+		return false;
+
+	std::vector<unsigned char> bufferA(1 << 18);
+	std::vector<unsigned char> bufferB(1 << 18);
+	unsigned bytesLeft = a.dataSize;
+	while (bytesLeft > 0) {
+		size_t toRead = std::min((size_t) bytesLeft, bufferA.size());
+		if (fileA.Read(bufferA.data(), toRead) != toRead || fileB.Read(bufferB.data(), toRead) != toRead)
+			return false;
+		if (std::memcmp(bufferA.data(), bufferB.data(), toRead) != 0)
+			return false;
+		bytesLeft -= toRead;
+	}
+	return true;
+}
+
+void DuplicateSampleFinder::findBorrowablePipes() {
+	// pipes already borrowed from must keep their samples, a reference can't point to another reference
+	std::set<std::pair<Stop*, unsigned>> referencedPipes;
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++) {
+		for (Pipe &p : m_organ->getOrganRankAt(i)->m_pipes) {
+			wxString ref = p.m_attacks.empty() ? wxString(wxEmptyString) : p.m_attacks.front().fileName;
+			long pipeNbr;
+			Stop *referencedStop = m_organ->getStopFromRefString(ref);
+			if (referencedStop && ref.Mid(12, 3).ToLong(&pipeNbr))
+				referencedPipes.insert(std::make_pair(referencedStop, (unsigned) pipeNbr - 1));
+		}
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (!stop->isUsingInternalRank())
+			continue;
+		for (Pipe &p : stop->getInternalRank()->m_pipes) {
+			wxString ref = p.m_attacks.empty() ? wxString(wxEmptyString) : p.m_attacks.front().fileName;
+			long pipeNbr;
+			Stop *referencedStop = m_organ->getStopFromRefString(ref);
+			if (referencedStop && ref.Mid(12, 3).ToLong(&pipeNbr))
+				referencedPipes.insert(std::make_pair(referencedStop, (unsigned) pipeNbr - 1));
+		}
+	}
+
+	std::map<wxString, std::vector<unsigned>> identicalPipes;
+	for (unsigned i = 0; i < m_pipes.size(); i++) {
+		wxString signature = m_pipes[i].settings;
+		for (unsigned usageIdx : m_pipes[i].usages)
+			signature += wxString::Format(wxT("F%u"), m_canonicalFile[m_usages[usageIdx].fileIndex]);
+		identicalPipes[signature].push_back(i);
+	}
+
+	for (auto &identical : identicalPipes) {
+		if (identical.second.size() < 2)
+			continue;
+
+		// only a pipe in the internal rank of a stop can be borrowed from
+		int target = -1;
+		for (unsigned idx : identical.second) {
+			if (m_pipes[idx].pipe.stop && m_pipes[idx].pipe.stop->getOwningManual()) {
+				target = idx;
+				break;
+			}
+		}
+		if (target < 0)
+			continue;
+
+		std::vector<unsigned> pipes;
+		pipes.push_back(target);
+		for (unsigned idx : identical.second) {
+			PIPE_LOCATION &loc = m_pipes[idx].pipe;
+			if ((int) idx == target || loc.rank == m_pipes[target].pipe.rank)
+				continue;
+			if (loc.stop && referencedPipes.count(std::make_pair(loc.stop, loc.pipeIndex)))
+				continue;
+			pipes.push_back(idx);
+		}
+		if (pipes.size() > 1)
+			m_borrowablePipes.push_back(pipes);
+	}
+}
+
+wxString DuplicateSampleFinder::getRefString(PIPE_LOCATION &pipe) {
+	Manual *manual = pipe.stop->getOwningManual();
+	int manId = m_organ->getIndexOfOrganManual(manual);
+	int stopId = manual->getIndexOfStop(pipe.stop) + 1;
+	return wxT("REF:") + GOODF_functions::number_format(manId) + wxT(":") + GOODF_functions::number_format(stopId) + wxT(":") + GOODF_functions::number_format(pipe.pipeIndex + 1);
+}
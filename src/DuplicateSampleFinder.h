@@ -0,0 +1,108 @@
+/*
+ * DuplicateSampleFinder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DUPLICATESAMPLEFINDER_H
+#define DUPLICATESAMPLEFINDER_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "Organ.h"
+
+struct PIPE_LOCATION {
+	Rank *rank;
+	Stop *stop; // only set if rank is the internal rank of this stop
+	unsigned pipeIndex;
+};
+
+struct SAMPLE_USAGE {
+	PIPE_LOCATION pipe;
+	Attack *attack; // either attack or release is set
+	Release *release;
+	unsigned fileIndex;
+};
+
+struct PIPE_SAMPLES {
+	PIPE_LOCATION pipe;
+	std::vector<unsigned> usages;
+	wxString settings; // odf attack/release values that must match for a pipe to be borrowed
+};
+
+struct SAMPLE_FILE {
+	wxString fullPath;
+	wxString fileName; // as written in the odf
+	std::vector<unsigned> usages;
+	bool isReadable;
+	wxString formatKey; // fmt, data size and embedded loops/cues must match for files to be duplicates
+	wxFileOffset dataOffset;
+	unsigned dataSize;
+	uint64_t hash;
+};
+
+// Finds sample files used by ranks and stops of an organ that have identical
+// audio data (and identical embedded loops/cues) even though they are stored
+// under different names. Files are first grouped by format and data size, only
+// candidates in such groups are hashed and finally compared byte by byte.
+class DuplicateSampleFinder {
+
+public:
+	DuplicateSampleFinder(Organ *organ);
+	~DuplicateSampleFinder();
+
+	// returns false if aborted from the progress dialog
+	bool scan(wxProgressDialog *progress = NULL);
+
+	unsigned getNumberOfFiles();
+	SAMPLE_FILE* getFileAt(unsigned index);
+	SAMPLE_USAGE* getUsageAt(unsigned index);
+	wxString getUsageDescription(unsigned usageIndex);
+	unsigned getNumberOfGroups();
+	// file indices where the first one is the file to keep
+	const std::vector<unsigned>& getGroupAt(unsigned index);
+	unsigned getNumberOfDuplicateFiles();
+	wxULongLong getRedundantBytes();
+	unsigned getNumberOfBorrowablePipes();
+
+	// the finder cannot be used any more after one of these rewrites
+	unsigned makePathsShared();
+	unsigned borrowIdenticalPipes();
+
+private:
+	Organ *m_organ;
+	std::vector<SAMPLE_USAGE> m_usages;
+	std::vector<SAMPLE_FILE> m_files;
+	std::map<wxString, unsigned> m_fileIndexByPath;
+	std::vector<std::vector<unsigned>> m_groups;
+	std::vector<unsigned> m_canonicalFile; // file index -> index of the file to keep
+	std::vector<PIPE_SAMPLES> m_pipes;
+	std::vector<std::vector<unsigned>> m_borrowablePipes; // indices into m_pipes, first is the pipe to borrow from
+
+	void collectUsages(Rank *rank, Stop *stop);
+	unsigned addUsage(SAMPLE_USAGE usage, wxString fullPath, wxString fileName);
+	void probeFile(SAMPLE_FILE &file);
+	void hashFile(SAMPLE_FILE &file);
+	bool hasSameAudioData(SAMPLE_FILE &a, SAMPLE_FILE &b);
+	void findBorrowablePipes();
+	wxString getRefString(PIPE_LOCATION &pipe);
+};
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * DuplicateSamplesDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "DuplicateSamplesDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <wx/progdlg.h>
+#include <wx/filename.h>
+
+IMPLEMENT_CLASS(DuplicateSamplesDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(DuplicateSamplesDialog, wxDialog)
+	EVT_RADIOBUTTON(ID_DUPLICATE_SHARE_PATHS_RADIO, DuplicateSamplesDialog::OnRewriteSelection)
+	EVT_RADIOBUTTON(ID_DUPLICATE_BORROW_PIPES_RADIO, DuplicateSamplesDialog::OnRewriteSelection)
+END_EVENT_TABLE()
+
+DuplicateSamplesDialog::DuplicateSamplesDialog(Organ *organ) {
+	Init(organ);
+}
+
+DuplicateSamplesDialog::DuplicateSamplesDialog(
+	Organ *organ,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(organ);
+	Create(parent, id, caption, pos, size, style);
+}
+
+DuplicateSamplesDialog::~DuplicateSamplesDialog() {
+	if (m_finder)
+		delete m_finder;
+}
+
+void DuplicateSamplesDialog::Init(Organ *organ) {
+	m_organ = organ;
+	m_finder = NULL;
+	m_scanComplete = false;
+	m_borrowPipes = false;
+	m_duplicatesList = NULL;
+	m_sharePathsRadio = NULL;
+	m_borrowPipesRadio = NULL;
+}
+
+bool DuplicateSamplesDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	m_finder = new DuplicateSampleFinder(m_organ);
+	wxProgressDialog progress(
+		wxT("Searching for duplicate samples"),
+		wxEmptyString,
+		100,
+		parent,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	m_scanComplete = m_finder->scan(&progress);
+	progress.Hide();
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void DuplicateSamplesDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxString summary;
+	if (!m_scanComplete) {
+		summary = wxT("The search was cancelled.");
+	} else if (m_finder->getNumberOfGroups() == 0 && m_finder->getNumberOfBorrowablePipes() == 0) {
+		summary = wxString::Format(wxT("No duplicates found among the %u sample files used by ranks and stops."), m_finder->getNumberOfFiles());
+	} else {
+		summary = wxString::Format(
+			wxT("%u of the %u sample files used have identical audio data and loops/cues as another file (%s of redundant audio data).\n%u pipes are identical to a pipe of a stop and could borrow it with REF: instead."),
+			m_finder->getNumberOfDuplicateFiles(),
+			m_finder->getNumberOfFiles(),
+			wxFileName::GetHumanReadableSize(m_finder->getRedundantBytes()),
+			m_finder->getNumberOfBorrowablePipes()
+		);
+	}
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		summary
+	);
+	firstRow->Add(summaryText, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxVERTICAL);
+	m_duplicatesList = new wxListCtrl(
+		this,
+		ID_DUPLICATE_SAMPLES_LIST,
+		wxDefaultPosition,
+		wxSize(800, 360),
+		wxLC_REPORT|wxLC_SINGLE_SEL|wxLC_HRULES|wxLC_VRULES
+	);
+	m_duplicatesList->AppendColumn(wxT("Duplicate file"), wxLIST_FORMAT_LEFT, 280);
+	m_duplicatesList->AppendColumn(wxT("Identical to"), wxLIST_FORMAT_LEFT, 280);
+	m_duplicatesList->AppendColumn(wxT("Used by"), wxLIST_FORMAT_LEFT, 240);
+	if (m_scanComplete) {
+		long row = 0;
+		for (unsigned i = 0; i < m_finder->getNumberOfGroups(); i++) {
+			const std::vector<unsigned> &group = m_finder->getGroupAt(i);
+			SAMPLE_FILE *kept = m_finder->getFileAt(group.front());
+			for (unsigned j = 1; j < group.size(); j++) {
+				SAMPLE_FILE *duplicate = m_finder->getFileAt(group[j]);
+				wxString usedBy = m_finder->getUsageDescription(duplicate->usages.front());
+				if (duplicate->usages.size() > 1)
+					usedBy += wxString::Format(wxT(" (+%u more)"), (unsigned) duplicate->usages.size() - 1);
+				long idx = m_duplicatesList->InsertItem(row++, duplicate->fileName);
+				m_duplicatesList->SetItem(idx, 1, kept->fileName);
+				m_duplicatesList->SetItem(idx, 2, usedBy);
+			}
+		}
+	}
+	secondRow->Add(m_duplicatesList, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(secondRow, 1, wxGROW|wxALL, 5);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxVERTICAL);
+	m_sharePathsRadio = new wxRadioButton(
+		this,
+		ID_DUPLICATE_SHARE_PATHS_RADIO,
+		wxT("Point all users of a duplicate to the one file kept"),
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxRB_GROUP
+	);
+	m_sharePathsRadio->SetValue(true);
+	thirdRow->Add(m_sharePathsRadio, 0, wxALL, 5);
+	m_borrowPipesRadio = new wxRadioButton(
+		this,
+		ID_DUPLICATE_BORROW_PIPES_RADIO,
+		wxT("Let identical pipes borrow (REF:) the pipe of a stop instead (pipe settings of the borrowed pipe are used)"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	thirdRow->Add(m_borrowPipesRadio, 0, wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Rewrite")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+
+	if (m_scanComplete && m_finder->getNumberOfGroups() == 0 && m_finder->getNumberOfBorrowablePipes() > 0) {
+		m_borrowPipesRadio->SetValue(true);
+		m_borrowPipes = true;
+	}
+	UpdateOkButton();
+}
+
+bool DuplicateSamplesDialog::IsScanComplete() {
+	return m_scanComplete;
+}
+
+unsigned DuplicateSamplesDialog::ApplyRewrite() {
+	if (!m_scanComplete)
+		return 0;
+
+	unsigned nbrChanged;
+	if (m_borrowPipes)
+		nbrChanged = m_finder->borrowIdenticalPipes();
+	else
+		nbrChanged = m_finder->makePathsShared();
+
+	// the pipes have changed so the scan result isn't valid any longer
+	m_scanComplete = false;
+	return nbrChanged;
+}
+
+void DuplicateSamplesDialog::UpdateOkButton() {
+	bool canRewrite = false;
+	if (m_scanComplete) {
+		if (m_borrowPipes)
+			canRewrite = m_finder->getNumberOfBorrowablePipes() > 0;
+		else
+			canRewrite = m_finder->getNumberOfGroups() > 0;
+	}
+	m_sharePathsRadio->Enable(m_scanComplete && m_finder->getNumberOfGroups() > 0);
+	m_borrowPipesRadio->Enable(m_scanComplete && m_finder->getNumberOfBorrowablePipes() > 0);
+
+	wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
+	if (okBtn)
+		okBtn->Enable(canRewrite);
+}
+
+void DuplicateSamplesDialog::OnRewriteSelection(wxCommandEvent& WXUNUSED(event)) {
+	m_borrowPipes = m_borrowPipesRadio->GetValue();
+	UpdateOkButton();
+}
@@ -0,0 +1,85 @@
+/*
+ * DuplicateSamplesDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef DUPLICATESAMPLESDIALOG_H
+#define DUPLICATESAMPLESDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "Organ.h"
+#include "DuplicateSampleFinder.h"
+
+class DuplicateSamplesDialog : public wxDialog {
+	DECLARE_CLASS(DuplicateSamplesDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	DuplicateSamplesDialog(Organ *organ);
+	DuplicateSamplesDialog(
+		Organ *organ,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Duplicate samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~DuplicateSamplesDialog();
+
+	// Initialize our variables
+	void Init(Organ *organ);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Duplicate samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	bool IsScanComplete();
+	// Performs the selected rewrite, returns number of changed samples/pipes
+	unsigned ApplyRewrite();
+
+private:
+	Organ *m_organ;
+	DuplicateSampleFinder *m_finder;
+	bool m_scanComplete;
+	bool m_borrowPipes;
+
+	wxListCtrl *m_duplicatesList;
+	wxRadioButton *m_sharePathsRadio;
+	wxRadioButton *m_borrowPipesRadio;
+
+	void UpdateOkButton();
+
+	// Event methods
+	void OnRewriteSelection(wxCommandEvent& event);
+
+};
+
+#endif
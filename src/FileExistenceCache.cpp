@@ -0,0 +1,196 @@
+/*
+ * FileExistenceCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "FileExistenceCache.h"
+#include "ParallelTaskRunner.h"
+#include "GOODF.h"
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <vector>
+
+thread_local FileExistenceCache *FileExistenceCache::m_activeCache = NULL;
+
+FileExistenceCache::FileExistenceCache() {
+
+}
+
+FileExistenceCache::~FileExistenceCache() {
+	if (m_activeCache == this)
+		m_activeCache = NULL;
+}
+
+FileExistenceCache* FileExistenceCache::getActive() {
+	return m_activeCache;
+}
+
+void FileExistenceCache::setActive(FileExistenceCache *cache) {
+	m_activeCache = cache;
+}
+
+ActiveFileExistenceCache::ActiveFileExistenceCache(FileExistenceCache *cache) {
+	m_previousCache = FileExistenceCache::getActive();
+	FileExistenceCache::setActive(cache);
+}
+
+ActiveFileExistenceCache::~ActiveFileExistenceCache() {
+	FileExistenceCache::setActive(m_previousCache);
+}
+
+void FileExistenceCache::clear() {
+	m_listings.clear();
+	m_missingDirectories.clear();
+	m_missingFiles.Empty();
+}
+
+void FileExistenceCache::prefetchDirectories(const wxArrayString &directories) {
+	wxArrayString toList;
+	std::set<wxString> queued;
+	for (unsigned i = 0; i < directories.GetCount(); i++) {
+		wxString dirPath = removeTrailingSeparator(directories[i]);
+		if (dirPath == wxEmptyString || m_listings.count(dirPath) || queued.count(dirPath))
+			continue;
+		queued.insert(dirPath);
+		toList.Add(dirPath);
+	}
+	if (toList.IsEmpty())
+		return;
+
+	// only existing directories are stored here, the others are resolved lazily through their parents
+	std::vector<DIRECTORY_LISTING> results(toList.GetCount());
+	std::vector<char> listed(toList.GetCount(), 0);
+	ParallelTaskRunner runner;
+	runner.run(toList.GetCount(), [&](unsigned index) {
+		if (wxDirExists(toList[index]))
+			listed[index] = listDirectory(toList[index], results[index]) ? 1 : 0;
+	});
+
+	for (unsigned i = 0; i < toList.GetCount(); i++) {
+		if (listed[i])
+			m_listings[toList[i]] = results[i];
+	}
+}
+
+wxString FileExistenceCache::resolveFile(const wxString &fullPath) {
+	wxFileName fName(fullPath);
+	const DIRECTORY_LISTING *listing = getListing(fName.GetPath());
+	if (!listing)
+		return wxEmptyString;
+	wxString name = fName.GetFullName();
+	if (listing->files.count(name))
+		return joinPath(listing->path, name);
+	auto found = listing->lowerCaseFiles.find(name.Lower());
+	if (found != listing->lowerCaseFiles.end())
+		return joinPath(listing->path, found->second);
+	return wxEmptyString;
+}
+
+bool FileExistenceCache::fileExists(const wxString &fullPath) {
+	return resolveFile(fullPath) != wxEmptyString;
+}
+
+void FileExistenceCache::addMissingFile(const wxString &relativePath) {
+	m_missingFiles.Add(relativePath);
+}
+
+unsigned FileExistenceCache::getNumberOfMissingFiles() {
+	return m_missingFiles.GetCount();
+}
+
+void FileExistenceCache::reportMissingFiles(const wxString &context) {
+	if (m_missingFiles.IsEmpty())
+		return;
+	wxString report = wxString::Format(wxT("%u referenced files in %s do not exist and were removed from the .organ file:"), (unsigned) m_missingFiles.GetCount(), context);
+	for (unsigned i = 0; i < m_missingFiles.GetCount(); i++)
+		report += wxT("\n") + m_missingFiles[i];
+	wxLogWarning("%s", report);
+	::wxGetApp().m_frame->GetLogWindow()->Show(true);
+	m_missingFiles.Empty();
+}
+
+const DIRECTORY_LISTING* FileExistenceCache::getListing(wxString dirPath) {
+	dirPath = removeTrailingSeparator(dirPath);
+	if (dirPath == wxEmptyString)
+		return NULL;
+	auto existing = m_listings.find(dirPath);
+	if (existing != m_listings.end())
+		return &existing->second;
+	if (m_missingDirectories.count(dirPath))
+		return NULL;
+
+	DIRECTORY_LISTING listing;
+	if (wxDirExists(dirPath) && listDirectory(dirPath, listing)) {
+		m_listings[dirPath] = listing;
+		return &m_listings[dirPath];
+	}
+
+	// the directory might exist with another case, which the parent listing can tell
+	wxFileName dirName = wxFileName::DirName(dirPath);
+	if (dirName.GetDirCount() > 0) {
+		wxString lastDir = dirName.GetDirs().Last();
+		dirName.RemoveLastDir();
+		const DIRECTORY_LISTING *parent = getListing(dirName.GetPath());
+		if (parent) {
+			auto found = parent->lowerCaseDirs.find(lastDir.Lower());
+			if (found != parent->lowerCaseDirs.end()) {
+				const DIRECTORY_LISTING *actual = getListing(joinPath(parent->path, found->second));
+				if (actual) {
+					m_listings[dirPath] = *actual;
+					return &m_listings[dirPath];
+				}
+			}
+		}
+	}
+	m_missingDirectories.insert(dirPath);
+	return NULL;
+}
+
+bool FileExistenceCache::listDirectory(const wxString &dirPath, DIRECTORY_LISTING &listing) {
+	wxLogNull noLogging;
+	wxDir dir(dirPath);
+	if (!dir.IsOpened())
+		return false;
+	listing.path = dirPath;
+	wxString name;
+	bool cont = dir.GetFirst(&name, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+	while (cont) {
+		listing.files.insert(name);
+		listing.lowerCaseFiles.insert(std::make_pair(name.Lower(), name));
+		cont = dir.GetNext(&name);
+	}
+	cont = dir.GetFirst(&name, wxEmptyString, wxDIR_DIRS | wxDIR_HIDDEN);
+	while (cont) {
+		listing.lowerCaseDirs.insert(std::make_pair(name.Lower(), name));
+		cont = dir.GetNext(&name);
+	}
+	return true;
+}
+
+wxString FileExistenceCache::joinPath(const wxString &dirPath, const wxString &name) {
+	if (wxFileName::IsPathSeparator(dirPath.Last()))
+		return dirPath + name;
+	return dirPath + wxFILE_SEP_PATH + name;
+}
+
+wxString FileExistenceCache::removeTrailingSeparator(wxString dirPath) {
+	while (dirPath.Length() > 1 && wxFileName::IsPathSeparator(dirPath.Last()))
+		dirPath.RemoveLast();
+	return dirPath;
+}
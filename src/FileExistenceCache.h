@@ -0,0 +1,89 @@
+/*
+ * FileExistenceCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef FILEEXISTENCECACHE_H
+#define FILEEXISTENCECACHE_H
+
+#include <wx/wx.h>
+#include <map>
+#include <set>
+
+struct DIRECTORY_LISTING {
+	wxString path; // the directory as it is named on disk
+	std::set<wxString> files;
+	std::map<wxString, wxString> lowerCaseFiles; // lower case name -> name on disk
+	std::map<wxString, wxString> lowerCaseDirs;
+};
+
+// Answers file existence questions from directory listings instead of a stat
+// per file. Each directory is listed once, names are matched case insensitively
+// (like wxPATH_DOS suggests the .organ file was written) and a directory that
+// doesn't exist with the exact case is looked up in its parent listing.
+// While a cache is active GOODF_functions::checkIfFileExist and
+// removeBaseOdfPath use it, and missing files are collected for one report.
+class FileExistenceCache {
+
+public:
+	FileExistenceCache();
+	~FileExistenceCache();
+
+	static FileExistenceCache* getActive();
+	static void setActive(FileExistenceCache *cache);
+
+	void clear();
+
+	// lists the directories not already known on worker threads
+	void prefetchDirectories(const wxArrayString &directories);
+
+	// returns the full path of the file as named on disk, or an empty string
+	wxString resolveFile(const wxString &fullPath);
+	bool fileExists(const wxString &fullPath);
+
+	void addMissingFile(const wxString &relativePath);
+	unsigned getNumberOfMissingFiles();
+	// logs all collected missing files in one warning and then forgets them
+	void reportMissingFiles(const wxString &context);
+
+private:
+	std::map<wxString, DIRECTORY_LISTING> m_listings; // keyed by the requested path
+	std::set<wxString> m_missingDirectories;
+	wxArrayString m_missingFiles;
+
+	static thread_local FileExistenceCache *m_activeCache;
+
+	const DIRECTORY_LISTING* getListing(wxString dirPath);
+	static bool listDirectory(const wxString &dirPath, DIRECTORY_LISTING &listing);
+	static wxString joinPath(const wxString &dirPath, const wxString &name);
+	static wxString removeTrailingSeparator(wxString dirPath);
+};
+
+// Makes a cache the active one of the thread for the current scope and
+// restores the cache that was active before when it goes out of scope.
+class ActiveFileExistenceCache {
+
+public:
+	ActiveFileExistenceCache(FileExistenceCache *cache);
+	~ActiveFileExistenceCache();
+
+private:
+	FileExistenceCache *m_previousCache;
+};
+
+#endif
@@ -21,47 +21,23 @@
 #ifndef GOODF_H
 #define GOODF_H
 
+#ifdef GOODF_CLI
+// the command line tool links the organ model against a windowless app
+#include "GOODFCli.h"
+#else
+
 #include <wx/wx.h>
 #include "GOODFFrame.h"
+#include "GOODFBitmaps.h"
 #include <vector>
 #include <wx/html/helpctrl.h>
 
-class GOODF : public wxApp {
+class GOODF : public wxApp, public GOODFBitmaps {
 public:
 	virtual bool OnInit();
 	int OnExit();
-	wxBitmap GetJpegBitmap(const unsigned char *data, int length, bool doScale = false);
-	wxBitmap GetJpeg90Bitmap(const unsigned char *data, int length, bool doScale = false);
 	GOODFFrame *m_frame;
 	wxIconBundle m_icons;
-	std::vector<wxBitmap> m_buttonBitmaps;
-	std::vector<wxBitmap> m_drawstopBitmaps;
-	std::vector<wxBitmap> m_scaledDrawstopBitmaps;
-	std::vector<wxBitmap> m_enclosureStyleBitmaps;
-	std::vector<wxBitmap> m_labelBitmaps;
-	std::vector<wxBitmap> m_fullSizeLabelBmps;
-	std::vector<wxBitmap> m_defaultManualBitmaps;
-	std::vector<wxBitmap> m_invertedManualBitmaps;
-	std::vector<wxBitmap> m_woodenManualBitmaps;
-	std::vector<wxBitmap> m_invertedWoodenManualBitmaps;
-	std::vector<wxBitmap> m_defaultPedalBitmaps;
-	std::vector<wxBitmap> m_invertedPedalBitmaps;
-
-	std::vector<wxBitmap> m_manualKeyBmps01;
-	std::vector<wxBitmap> m_invertedManualKeysBmps01;
-	std::vector<wxBitmap> m_woodenManualKeysBmps01;
-	std::vector<wxBitmap> m_invertedManualWoodenKeysBmps01;
-	std::vector<wxBitmap> m_pedalKeysBmps01;
-	std::vector<wxBitmap> m_invertedPedalKeysBmps01;
-	std::vector<wxBitmap> m_manualKeyBmps02;
-	std::vector<wxBitmap> m_invertedManualKeysBmps02;
-	std::vector<wxBitmap> m_woodenManualKeysBmps02;
-	std::vector<wxBitmap> m_invertedManualWoodenKeysBmps02;
-	std::vector<wxBitmap> m_pedalKeysBmps02;
-	std::vector<wxBitmap> m_invertedPedalKeysBmps02;
-
-	std::vector<wxBitmap> m_woodBitmaps;
-	std::vector<wxBitmap> m_scaledWoodBitmaps;
 	wxHtmlHelpController *m_helpController;
 	wxString m_fullAppName;
 };
@@ -69,3 +45,5 @@ public:
 DECLARE_APP(GOODF)
 
 #endif
+
+#endif
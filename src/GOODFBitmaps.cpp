@@ -0,0 +1,565 @@
+/* 
+ * GOODFBitmaps.cpp is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#include "GOODFBitmaps.h"
+#include "GoImages.h"
+#include <wx/image.h>
+#include <wx/mstream.h>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "TraceRecorder.h"
+
+#define PNG_DATA(name) name##_png, sizeof(name##_png)
+
+static std::mutex s_decodeMutex;
+static std::map<EMBEDDED_IMAGE, wxBitmap> s_decodedImages;
+
+static wxBitmap DecodeEmbeddedImage(const EMBEDDED_IMAGE &image);
+
+static EMBEDDED_IMAGE PngImage(const unsigned char *data, size_t length, int scaleWidth = 0, int scaleHeight = 0) {
+	EMBEDDED_IMAGE image = {data, length, EMBEDDED_PNG, scaleWidth, scaleHeight, false};
+	return image;
+}
+
+static EMBEDDED_IMAGE JpegImage(const unsigned char *data, size_t length, bool rotate90 = false, int scaleWidth = 0, int scaleHeight = 0) {
+	EMBEDDED_IMAGE image = {data, length, EMBEDDED_JPEG, scaleWidth, scaleHeight, rotate90};
+	return image;
+}
+
+// Only registers the images, each is decoded the first time it's used
+void GOODFBitmaps::LoadEmbeddedBitmaps() {
+	EMBEDDED_IMAGE drawstop1 = PngImage(PNG_DATA(drawstop01off));
+	EMBEDDED_IMAGE drawstop2 = PngImage(PNG_DATA(drawstop02off));
+	EMBEDDED_IMAGE drawstop3 = PngImage(PNG_DATA(drawstop03off));
+	EMBEDDED_IMAGE drawstop4 = PngImage(PNG_DATA(drawstop04off));
+	EMBEDDED_IMAGE drawstop5 = PngImage(PNG_DATA(drawstop05off));
+	EMBEDDED_IMAGE drawstop6 = PngImage(PNG_DATA(drawstop06off));
+	EMBEDDED_IMAGE drawstop7 = PngImage(PNG_DATA(drawstop07off));
+	m_drawstopBitmaps.add(drawstop1);
+	m_drawstopBitmaps.add(drawstop2);
+	m_drawstopBitmaps.add(drawstop3);
+	m_drawstopBitmaps.add(drawstop4);
+	m_drawstopBitmaps.add(drawstop5);
+	m_drawstopBitmaps.add(drawstop6);
+	m_drawstopBitmaps.add(drawstop7);
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop01off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop02off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop03off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop04off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop05off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop06off), 32, 32));
+	m_scaledDrawstopBitmaps.add(PngImage(PNG_DATA(drawstop07off), 32, 32));
+
+	EMBEDDED_IMAGE piston1 = PngImage(PNG_DATA(piston01off));
+	EMBEDDED_IMAGE piston2 = PngImage(PNG_DATA(piston02off));
+	EMBEDDED_IMAGE piston3 = PngImage(PNG_DATA(piston03off));
+	EMBEDDED_IMAGE piston4 = PngImage(PNG_DATA(piston04off));
+	EMBEDDED_IMAGE piston5 = PngImage(PNG_DATA(piston05off));
+	m_buttonBitmaps.add(piston1);
+	m_buttonBitmaps.add(piston2);
+	m_buttonBitmaps.add(piston3);
+	m_buttonBitmaps.add(piston4);
+	m_buttonBitmaps.add(piston5);
+
+	EMBEDDED_IMAGE enclosure1 = PngImage(PNG_DATA(EnclosureA00));
+	EMBEDDED_IMAGE enclosure2 = PngImage(PNG_DATA(EnclosureB00));
+	EMBEDDED_IMAGE enclosure3 = PngImage(PNG_DATA(EnclosureC00));
+	EMBEDDED_IMAGE enclosure4 = PngImage(PNG_DATA(EnclosureD00));
+	m_enclosureStyleBitmaps.add(enclosure1);
+	m_enclosureStyleBitmaps.add(enclosure2);
+	m_enclosureStyleBitmaps.add(enclosure3);
+	m_enclosureStyleBitmaps.add(enclosure4);
+
+	EMBEDDED_IMAGE label1 = PngImage(PNG_DATA(label01));
+	// EMBEDDED_IMAGE label2 = PngImage(PNG_DATA(label02)); Same style as 03 but 80x50
+	EMBEDDED_IMAGE label3 = PngImage(PNG_DATA(label03));
+	// EMBEDDED_IMAGE label4 = PngImage(PNG_DATA(label04)); Same style as 03 but 160x25
+	// EMBEDDED_IMAGE label5 = PngImage(PNG_DATA(label05)); Same style as 03 but 200x50
+	// EMBEDDED_IMAGE label6 = PngImage(PNG_DATA(label06)); Same style as 07 but 80x50
+	EMBEDDED_IMAGE label7 = PngImage(PNG_DATA(label07));
+	// EMBEDDED_IMAGE label8 = PngImage(PNG_DATA(label08)); Same style as 07 but 160x25
+	// EMBEDDED_IMAGE label9 = PngImage(PNG_DATA(label09)); Same style as 10 but 80x50
+	EMBEDDED_IMAGE label10 = PngImage(PNG_DATA(label10));
+	// EMBEDDED_IMAGE label11 = PngImage(PNG_DATA(label11)); Same style as 10 but 160x25
+	// EMBEDDED_IMAGE label12 = PngImage(PNG_DATA(label12)); Same style as 10 but 200x50
+	EMBEDDED_IMAGE label13 = PngImage(PNG_DATA(label13), 80, 25);
+	EMBEDDED_IMAGE label14 = PngImage(PNG_DATA(label14), 80, 25);
+	EMBEDDED_IMAGE label15 = PngImage(PNG_DATA(label15), 80, 25);
+	m_labelBitmaps.addEmpty();
+	m_labelBitmaps.add(label1);
+	m_labelBitmaps.add(label3);
+	m_labelBitmaps.add(label3);
+	m_labelBitmaps.add(label3);
+	m_labelBitmaps.add(label3);
+	m_labelBitmaps.add(label7);
+	m_labelBitmaps.add(label7);
+	m_labelBitmaps.add(label7);
+	m_labelBitmaps.add(label10);
+	m_labelBitmaps.add(label10);
+	m_labelBitmaps.add(label10);
+	m_labelBitmaps.add(label10);
+	m_labelBitmaps.add(label13);
+	m_labelBitmaps.add(label14);
+	m_labelBitmaps.add(label15);
+
+	EMBEDDED_IMAGE label2 = PngImage(PNG_DATA(label02));
+	EMBEDDED_IMAGE label4 = PngImage(PNG_DATA(label04));
+	EMBEDDED_IMAGE label5 = PngImage(PNG_DATA(label05));
+	EMBEDDED_IMAGE label6 = PngImage(PNG_DATA(label06));
+	EMBEDDED_IMAGE label8 = PngImage(PNG_DATA(label08));
+	EMBEDDED_IMAGE label9 = PngImage(PNG_DATA(label09));
+	EMBEDDED_IMAGE label11 = PngImage(PNG_DATA(label11));
+	EMBEDDED_IMAGE label12 = PngImage(PNG_DATA(label12));
+	EMBEDDED_IMAGE fullLabel13 = PngImage(PNG_DATA(label13));
+	EMBEDDED_IMAGE fullLabel14 = PngImage(PNG_DATA(label14));
+	EMBEDDED_IMAGE fullLabel15 = PngImage(PNG_DATA(label15));
+	m_fullSizeLabelBmps.addEmpty();
+	m_fullSizeLabelBmps.add(label1);
+	m_fullSizeLabelBmps.add(label2);
+	m_fullSizeLabelBmps.add(label3);
+	m_fullSizeLabelBmps.add(label4);
+	m_fullSizeLabelBmps.add(label5);
+	m_fullSizeLabelBmps.add(label6);
+	m_fullSizeLabelBmps.add(label7);
+	m_fullSizeLabelBmps.add(label8);
+	m_fullSizeLabelBmps.add(label9);
+	m_fullSizeLabelBmps.add(label10);
+	m_fullSizeLabelBmps.add(label11);
+	m_fullSizeLabelBmps.add(label12);
+	m_fullSizeLabelBmps.add(fullLabel13);
+	m_fullSizeLabelBmps.add(fullLabel14);
+	m_fullSizeLabelBmps.add(fullLabel15);
+
+	EMBEDDED_IMAGE defaultManual1 = PngImage(PNG_DATA(ManualDefaultComposite01));
+	EMBEDDED_IMAGE defaultManual2 = PngImage(PNG_DATA(ManualDefaultComposite02));
+	m_defaultManualBitmaps.add(defaultManual1);
+	m_defaultManualBitmaps.add(defaultManual2);
+
+	EMBEDDED_IMAGE invertedManual1 = PngImage(PNG_DATA(ManualInvertedComposite01));
+	EMBEDDED_IMAGE invertedManual2 = PngImage(PNG_DATA(ManualInvertedComposite02));
+	m_invertedManualBitmaps.add(invertedManual1);
+	m_invertedManualBitmaps.add(invertedManual2);
+
+	EMBEDDED_IMAGE woodenManual1 = PngImage(PNG_DATA(ManualWoodenComposite01));
+	EMBEDDED_IMAGE woodenManual2 = PngImage(PNG_DATA(ManualWoodenComposite02));
+	m_woodenManualBitmaps.add(woodenManual1);
+	m_woodenManualBitmaps.add(woodenManual2);
+
+	EMBEDDED_IMAGE invertedWoodenManual1 = PngImage(PNG_DATA(ManualInvertedWoodenComposite01));
+	EMBEDDED_IMAGE invertedWoodenManual2 = PngImage(PNG_DATA(ManualInvertedWoodenComposite02));
+	m_invertedWoodenManualBitmaps.add(invertedWoodenManual1);
+	m_invertedWoodenManualBitmaps.add(invertedWoodenManual2);
+
+	EMBEDDED_IMAGE defaultPedal1 = PngImage(PNG_DATA(PedalDefaultComposite01));
+	EMBEDDED_IMAGE defaultPedal2 = PngImage(PNG_DATA(PedalDefaultComposite02));
+	m_defaultPedalBitmaps.add(defaultPedal1);
+	m_defaultPedalBitmaps.add(defaultPedal2);
+
+	EMBEDDED_IMAGE invertedPedal1 = PngImage(PNG_DATA(PedalInvertedComposite01));
+	EMBEDDED_IMAGE invertedPedal2 = PngImage(PNG_DATA(PedalInvertedComposite02));
+	m_invertedPedalBitmaps.add(invertedPedal1);
+	m_invertedPedalBitmaps.add(invertedPedal2);
+
+	EMBEDDED_IMAGE whiteCF = PngImage(PNG_DATA(ManualCWhiteUp01));
+	EMBEDDED_IMAGE whiteDGA = PngImage(PNG_DATA(ManualDWhiteUp01));
+	EMBEDDED_IMAGE whiteEB = PngImage(PNG_DATA(ManualEWhiteUp01));
+	EMBEDDED_IMAGE blackSharp = PngImage(PNG_DATA(ManualSharpBlackUp01));
+	EMBEDDED_IMAGE whiteWhole = PngImage(PNG_DATA(ManualNaturalWhiteUp01));
+	m_manualKeyBmps01.add(whiteCF);
+	m_manualKeyBmps01.add(blackSharp);
+	m_manualKeyBmps01.add(whiteDGA);
+	m_manualKeyBmps01.add(blackSharp);
+	m_manualKeyBmps01.add(whiteEB);
+	m_manualKeyBmps01.add(whiteCF);
+	m_manualKeyBmps01.add(blackSharp);
+	m_manualKeyBmps01.add(whiteDGA);
+	m_manualKeyBmps01.add(blackSharp);
+	m_manualKeyBmps01.add(whiteDGA);
+	m_manualKeyBmps01.add(blackSharp);
+	m_manualKeyBmps01.add(whiteEB);
+	m_manualKeyBmps01.add(whiteWhole);
+
+	EMBEDDED_IMAGE blackCF = PngImage(PNG_DATA(ManualCBlackUp01));
+	EMBEDDED_IMAGE blackDGA = PngImage(PNG_DATA(ManualDBlackUp01));
+	EMBEDDED_IMAGE blackEB = PngImage(PNG_DATA(ManualEBlackUp01));
+	EMBEDDED_IMAGE whiteSharp = PngImage(PNG_DATA(ManualSharpWhiteUp01));
+	EMBEDDED_IMAGE blackWhole = PngImage(PNG_DATA(ManualNaturalBlackUp01));
+	m_invertedManualKeysBmps01.add(blackCF);
+	m_invertedManualKeysBmps01.add(whiteSharp);
+	m_invertedManualKeysBmps01.add(blackDGA);
+	m_invertedManualKeysBmps01.add(whiteSharp);
+	m_invertedManualKeysBmps01.add(blackEB);
+	m_invertedManualKeysBmps01.add(blackCF);
+	m_invertedManualKeysBmps01.add(whiteSharp);
+	m_invertedManualKeysBmps01.add(blackDGA);
+	m_invertedManualKeysBmps01.add(whiteSharp);
+	m_invertedManualKeysBmps01.add(blackDGA);
+	m_invertedManualKeysBmps01.add(whiteSharp);
+	m_invertedManualKeysBmps01.add(blackEB);
+	m_invertedManualKeysBmps01.add(blackWhole);
+
+	EMBEDDED_IMAGE woodCF = PngImage(PNG_DATA(ManualCWoodUp01));
+	EMBEDDED_IMAGE woodDGA = PngImage(PNG_DATA(ManualDWoodUp01));
+	EMBEDDED_IMAGE woodEB = PngImage(PNG_DATA(ManualEWoodUp01));
+	EMBEDDED_IMAGE woodWhole = PngImage(PNG_DATA(ManualNaturalWoodUp01));
+	m_woodenManualKeysBmps01.add(woodCF);
+	m_woodenManualKeysBmps01.add(blackSharp);
+	m_woodenManualKeysBmps01.add(woodDGA);
+	m_woodenManualKeysBmps01.add(blackSharp);
+	m_woodenManualKeysBmps01.add(woodEB);
+	m_woodenManualKeysBmps01.add(woodCF);
+	m_woodenManualKeysBmps01.add(blackSharp);
+	m_woodenManualKeysBmps01.add(woodDGA);
+	m_woodenManualKeysBmps01.add(blackSharp);
+	m_woodenManualKeysBmps01.add(woodDGA);
+	m_woodenManualKeysBmps01.add(blackSharp);
+	m_woodenManualKeysBmps01.add(woodEB);
+	m_woodenManualKeysBmps01.add(woodWhole);
+
+	EMBEDDED_IMAGE woodSharp = PngImage(PNG_DATA(ManualSharpWoodUp01));
+	m_invertedManualWoodenKeysBmps01.add(blackCF);
+	m_invertedManualWoodenKeysBmps01.add(woodSharp);
+	m_invertedManualWoodenKeysBmps01.add(blackDGA);
+	m_invertedManualWoodenKeysBmps01.add(woodSharp);
+	m_invertedManualWoodenKeysBmps01.add(blackEB);
+	m_invertedManualWoodenKeysBmps01.add(blackCF);
+	m_invertedManualWoodenKeysBmps01.add(woodSharp);
+	m_invertedManualWoodenKeysBmps01.add(blackDGA);
+	m_invertedManualWoodenKeysBmps01.add(woodSharp);
+	m_invertedManualWoodenKeysBmps01.add(blackDGA);
+	m_invertedManualWoodenKeysBmps01.add(woodSharp);
+	m_invertedManualWoodenKeysBmps01.add(blackEB);
+	m_invertedManualWoodenKeysBmps01.add(blackWhole);
+
+	EMBEDDED_IMAGE naturalPedalUp = PngImage(PNG_DATA(PedalNaturalWoodUp01));
+	EMBEDDED_IMAGE sharpPedalUp = PngImage(PNG_DATA(PedalSharpBlackUp01));
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(sharpPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(sharpPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(sharpPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(sharpPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(sharpPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+	m_pedalKeysBmps01.add(naturalPedalUp);
+
+	EMBEDDED_IMAGE invertedPedalUp = PngImage(PNG_DATA(PedalNaturalBlackUp01));
+	EMBEDDED_IMAGE woodPedalSharpUp = PngImage(PNG_DATA(PedalSharpWoodUp01));
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(woodPedalSharpUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(woodPedalSharpUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(woodPedalSharpUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(woodPedalSharpUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(woodPedalSharpUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+	m_invertedPedalKeysBmps01.add(invertedPedalUp);
+
+	EMBEDDED_IMAGE whiteCF2 = PngImage(PNG_DATA(ManualCWhiteUp02));
+	EMBEDDED_IMAGE whiteDGA2 = PngImage(PNG_DATA(ManualDWhiteUp02));
+	EMBEDDED_IMAGE whiteEB2 = PngImage(PNG_DATA(ManualEWhiteUp02));
+	EMBEDDED_IMAGE blackSharp2 = PngImage(PNG_DATA(ManualSharpBlackUp02));
+	EMBEDDED_IMAGE whiteWhole2 = PngImage(PNG_DATA(ManualNaturalWhiteUp02));
+	m_manualKeyBmps02.add(whiteCF2);
+	m_manualKeyBmps02.add(blackSharp2);
+	m_manualKeyBmps02.add(whiteDGA2);
+	m_manualKeyBmps02.add(blackSharp2);
+	m_manualKeyBmps02.add(whiteEB2);
+	m_manualKeyBmps02.add(whiteCF2);
+	m_manualKeyBmps02.add(blackSharp2);
+	m_manualKeyBmps02.add(whiteDGA2);
+	m_manualKeyBmps02.add(blackSharp2);
+	m_manualKeyBmps02.add(whiteDGA2);
+	m_manualKeyBmps02.add(blackSharp2);
+	m_manualKeyBmps02.add(whiteEB2);
+	m_manualKeyBmps02.add(whiteWhole2);
+
+	EMBEDDED_IMAGE blackCF2 = PngImage(PNG_DATA(ManualCBlackUp02));
+	EMBEDDED_IMAGE blackDGA2 = PngImage(PNG_DATA(ManualDBlackUp02));
+	EMBEDDED_IMAGE blackEB2 = PngImage(PNG_DATA(ManualEBlackUp02));
+	EMBEDDED_IMAGE whiteSharp2 = PngImage(PNG_DATA(ManualSharpWhiteUp02));
+	EMBEDDED_IMAGE blackWhole2 = PngImage(PNG_DATA(ManualNaturalBlackUp02));
+	m_invertedManualKeysBmps02.add(blackCF2);
+	m_invertedManualKeysBmps02.add(whiteSharp2);
+	m_invertedManualKeysBmps02.add(blackDGA2);
+	m_invertedManualKeysBmps02.add(whiteSharp2);
+	m_invertedManualKeysBmps02.add(blackEB2);
+	m_invertedManualKeysBmps02.add(blackCF2);
+	m_invertedManualKeysBmps02.add(whiteSharp2);
+	m_invertedManualKeysBmps02.add(blackDGA2);
+	m_invertedManualKeysBmps02.add(whiteSharp2);
+	m_invertedManualKeysBmps02.add(blackDGA2);
+	m_invertedManualKeysBmps02.add(whiteSharp2);
+	m_invertedManualKeysBmps02.add(blackEB2);
+	m_invertedManualKeysBmps02.add(blackWhole2);
+
+	EMBEDDED_IMAGE woodCF2 = PngImage(PNG_DATA(ManualCWoodUp02));
+	EMBEDDED_IMAGE woodDGA2 = PngImage(PNG_DATA(ManualDWoodUp02));
+	EMBEDDED_IMAGE woodEB2 = PngImage(PNG_DATA(ManualEWoodUp02));
+	EMBEDDED_IMAGE woodWhole2 = PngImage(PNG_DATA(ManualNaturalWoodUp02));
+	m_woodenManualKeysBmps02.add(woodCF2);
+	m_woodenManualKeysBmps02.add(blackSharp2);
+	m_woodenManualKeysBmps02.add(woodDGA2);
+	m_woodenManualKeysBmps02.add(blackSharp2);
+	m_woodenManualKeysBmps02.add(woodEB2);
+	m_woodenManualKeysBmps02.add(woodCF2);
+	m_woodenManualKeysBmps02.add(blackSharp2);
+	m_woodenManualKeysBmps02.add(woodDGA2);
+	m_woodenManualKeysBmps02.add(blackSharp2);
+	m_woodenManualKeysBmps02.add(woodDGA2);
+	m_woodenManualKeysBmps02.add(blackSharp2);
+	m_woodenManualKeysBmps02.add(woodEB2);
+	m_woodenManualKeysBmps02.add(woodWhole2);
+
+	EMBEDDED_IMAGE woodSharp2 = PngImage(PNG_DATA(ManualSharpWoodUp02));
+	m_invertedManualWoodenKeysBmps02.add(blackCF2);
+	m_invertedManualWoodenKeysBmps02.add(woodSharp2);
+	m_invertedManualWoodenKeysBmps02.add(blackDGA2);
+	m_invertedManualWoodenKeysBmps02.add(woodSharp2);
+	m_invertedManualWoodenKeysBmps02.add(blackEB2);
+	m_invertedManualWoodenKeysBmps02.add(blackCF2);
+	m_invertedManualWoodenKeysBmps02.add(woodSharp2);
+	m_invertedManualWoodenKeysBmps02.add(blackDGA2);
+	m_invertedManualWoodenKeysBmps02.add(woodSharp2);
+	m_invertedManualWoodenKeysBmps02.add(blackDGA2);
+	m_invertedManualWoodenKeysBmps02.add(woodSharp2);
+	m_invertedManualWoodenKeysBmps02.add(blackEB2);
+	m_invertedManualWoodenKeysBmps02.add(blackWhole2);
+
+	EMBEDDED_IMAGE naturalPedalUp2 = PngImage(PNG_DATA(PedalNaturalWoodUp02));
+	EMBEDDED_IMAGE sharpPedalUp2 = PngImage(PNG_DATA(PedalSharpBlackUp02));
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(sharpPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(sharpPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(sharpPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(sharpPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(sharpPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+	m_pedalKeysBmps02.add(naturalPedalUp2);
+
+	EMBEDDED_IMAGE invertedPedal2Up = PngImage(PNG_DATA(PedalNaturalBlackUp02));
+	EMBEDDED_IMAGE woodPedalSharp2Up = PngImage(PNG_DATA(PedalSharpWoodUp02));
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(woodPedalSharp2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(woodPedalSharp2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(woodPedalSharp2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(woodPedalSharp2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(woodPedalSharp2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+	m_invertedPedalKeysBmps02.add(invertedPedal2Up);
+
+	// the embedded wood jpg images, also rotated 90 degrees
+	m_woodBitmaps.add(JpegImage(Wood01_jpg, sizeof(Wood01_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood01_jpg, sizeof(Wood01_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood03_jpg, sizeof(Wood03_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood03_jpg, sizeof(Wood03_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood05_jpg, sizeof(Wood05_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood05_jpg, sizeof(Wood05_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood07_jpg, sizeof(Wood07_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood07_jpg, sizeof(Wood07_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood09_jpg, sizeof(Wood09_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood09_jpg, sizeof(Wood09_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood11_jpg, sizeof(Wood11_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood11_jpg, sizeof(Wood11_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood13_jpg, sizeof(Wood13_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood13_jpg, sizeof(Wood13_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood15_jpg, sizeof(Wood15_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood15_jpg, sizeof(Wood15_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood17_jpg, sizeof(Wood17_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood17_jpg, sizeof(Wood17_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood19_jpg, sizeof(Wood19_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood19_jpg, sizeof(Wood19_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood21_jpg, sizeof(Wood21_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood21_jpg, sizeof(Wood21_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood23_jpg, sizeof(Wood23_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood23_jpg, sizeof(Wood23_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood25_jpg, sizeof(Wood25_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood25_jpg, sizeof(Wood25_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood27_jpg, sizeof(Wood27_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood27_jpg, sizeof(Wood27_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood29_jpg, sizeof(Wood29_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood29_jpg, sizeof(Wood29_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood31_jpg, sizeof(Wood31_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood31_jpg, sizeof(Wood31_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood33_jpg, sizeof(Wood33_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood33_jpg, sizeof(Wood33_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood35_jpg, sizeof(Wood35_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood35_jpg, sizeof(Wood35_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood37_jpg, sizeof(Wood37_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood37_jpg, sizeof(Wood37_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood39_jpg, sizeof(Wood39_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood39_jpg, sizeof(Wood39_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood41_jpg, sizeof(Wood41_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood41_jpg, sizeof(Wood41_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood43_jpg, sizeof(Wood43_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood43_jpg, sizeof(Wood43_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood45_jpg, sizeof(Wood45_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood45_jpg, sizeof(Wood45_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood47_jpg, sizeof(Wood47_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood47_jpg, sizeof(Wood47_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood49_jpg, sizeof(Wood49_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood49_jpg, sizeof(Wood49_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood51_jpg, sizeof(Wood51_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood51_jpg, sizeof(Wood51_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood53_jpg, sizeof(Wood53_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood53_jpg, sizeof(Wood53_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood55_jpg, sizeof(Wood55_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood55_jpg, sizeof(Wood55_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood57_jpg, sizeof(Wood57_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood57_jpg, sizeof(Wood57_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood59_jpg, sizeof(Wood59_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood59_jpg, sizeof(Wood59_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood61_jpg, sizeof(Wood61_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood61_jpg, sizeof(Wood61_jpg), true));
+	m_woodBitmaps.add(JpegImage(Wood63_jpg, sizeof(Wood63_jpg)));
+	m_woodBitmaps.add(JpegImage(Wood63_jpg, sizeof(Wood63_jpg), true));
+
+	m_scaledWoodBitmaps.add(JpegImage(Wood01_jpg, sizeof(Wood01_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood01_jpg, sizeof(Wood01_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood03_jpg, sizeof(Wood03_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood03_jpg, sizeof(Wood03_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood05_jpg, sizeof(Wood05_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood05_jpg, sizeof(Wood05_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood07_jpg, sizeof(Wood07_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood07_jpg, sizeof(Wood07_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood09_jpg, sizeof(Wood09_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood09_jpg, sizeof(Wood09_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood11_jpg, sizeof(Wood11_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood11_jpg, sizeof(Wood11_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood13_jpg, sizeof(Wood13_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood13_jpg, sizeof(Wood13_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood15_jpg, sizeof(Wood15_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood15_jpg, sizeof(Wood15_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood17_jpg, sizeof(Wood17_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood17_jpg, sizeof(Wood17_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood19_jpg, sizeof(Wood19_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood19_jpg, sizeof(Wood19_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood21_jpg, sizeof(Wood21_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood21_jpg, sizeof(Wood21_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood23_jpg, sizeof(Wood23_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood23_jpg, sizeof(Wood23_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood25_jpg, sizeof(Wood25_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood25_jpg, sizeof(Wood25_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood27_jpg, sizeof(Wood27_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood27_jpg, sizeof(Wood27_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood29_jpg, sizeof(Wood29_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood29_jpg, sizeof(Wood29_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood31_jpg, sizeof(Wood31_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood31_jpg, sizeof(Wood31_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood33_jpg, sizeof(Wood33_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood33_jpg, sizeof(Wood33_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood35_jpg, sizeof(Wood35_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood35_jpg, sizeof(Wood35_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood37_jpg, sizeof(Wood37_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood37_jpg, sizeof(Wood37_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood39_jpg, sizeof(Wood39_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood39_jpg, sizeof(Wood39_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood41_jpg, sizeof(Wood41_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood41_jpg, sizeof(Wood41_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood43_jpg, sizeof(Wood43_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood43_jpg, sizeof(Wood43_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood45_jpg, sizeof(Wood45_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood45_jpg, sizeof(Wood45_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood47_jpg, sizeof(Wood47_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood47_jpg, sizeof(Wood47_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood49_jpg, sizeof(Wood49_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood49_jpg, sizeof(Wood49_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood51_jpg, sizeof(Wood51_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood51_jpg, sizeof(Wood51_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood53_jpg, sizeof(Wood53_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood53_jpg, sizeof(Wood53_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood55_jpg, sizeof(Wood55_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood55_jpg, sizeof(Wood55_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood57_jpg, sizeof(Wood57_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood57_jpg, sizeof(Wood57_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood59_jpg, sizeof(Wood59_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood59_jpg, sizeof(Wood59_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood61_jpg, sizeof(Wood61_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood61_jpg, sizeof(Wood61_jpg), true, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood63_jpg, sizeof(Wood63_jpg), false, 32, 32));
+	m_scaledWoodBitmaps.add(JpegImage(Wood63_jpg, sizeof(Wood63_jpg), true, 32, 32));
+}
+
+bool EMBEDDED_IMAGE::operator<(const EMBEDDED_IMAGE &other) const {
+	return std::tie(data, scaleWidth, scaleHeight, rotate90) < std::tie(other.data, other.scaleWidth, other.scaleHeight, other.rotate90);
+}
+
+void EmbeddedBitmapList::add(const EMBEDDED_IMAGE &image) {
+	m_images.push_back(image);
+	m_bitmaps.push_back(wxNullBitmap);
+	m_isDecoded.push_back(false);
+}
+
+void EmbeddedBitmapList::addEmpty() {
+	EMBEDDED_IMAGE empty = {NULL, 0, EMBEDDED_PNG, 0, 0, false};
+	m_images.push_back(empty);
+	m_bitmaps.push_back(wxNullBitmap);
+	m_isDecoded.push_back(true);
+}
+
+size_t EmbeddedBitmapList::size() const {
+	return m_images.size();
+}
+
+const wxBitmap& EmbeddedBitmapList::operator[](size_t index) const {
+	std::lock_guard<std::mutex> lock(s_decodeMutex);
+	if (!m_isDecoded[index]) {
+		m_bitmaps[index] = DecodeEmbeddedImage(m_images[index]);
+		m_isDecoded[index] = true;
+	}
+	return m_bitmaps[index];
+}
+
+static wxBitmap DecodeEmbeddedImage(const EMBEDDED_IMAGE &image) {
+	// the same image is often used in several lists or several times in one list
+	auto found = s_decodedImages.find(image);
+	if (found != s_decodedImages.end())
+		return found->second;
+
+	TraceScope trace("decode embedded image");
+	wxMemoryInputStream is(image.data, image.length);
+	wxImage img(is, image.format == EMBEDDED_JPEG ? wxBITMAP_TYPE_JPEG : wxBITMAP_TYPE_PNG);
+	if (image.scaleWidth > 0 && image.scaleHeight > 0)
+		img.Rescale(image.scaleWidth, image.scaleHeight);
+	if (image.rotate90)
+		img = img.Rotate90();
+	wxBitmap bmp(img);
+	s_decodedImages[image] = bmp;
+	return bmp;
+}
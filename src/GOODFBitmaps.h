@@ -0,0 +1,95 @@
+/* 
+ * GOODFBitmaps.h is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#ifndef GOODFBITMAPS_H
+#define GOODFBITMAPS_H
+
+#include <wx/wx.h>
+#include <vector>
+
+typedef enum {
+	EMBEDDED_PNG,
+	EMBEDDED_JPEG
+} EMBEDDED_IMAGE_FORMAT;
+
+// an image embedded in the executable and how it's transformed before use
+struct EMBEDDED_IMAGE {
+	const unsigned char *data;
+	size_t length;
+	EMBEDDED_IMAGE_FORMAT format;
+	int scaleWidth; // 0 keeps the original size
+	int scaleHeight;
+	bool rotate90;
+
+	bool operator<(const EMBEDDED_IMAGE &other) const;
+};
+
+// A list of embedded images that are decoded the first time they are used.
+// An image that is used in several lists is only decoded once.
+class EmbeddedBitmapList {
+public:
+	void add(const EMBEDDED_IMAGE &image);
+	void addEmpty();
+	size_t size() const;
+	const wxBitmap& operator[](size_t index) const;
+
+private:
+	std::vector<EMBEDDED_IMAGE> m_images;
+	mutable std::vector<wxBitmap> m_bitmaps;
+	mutable std::vector<bool> m_isDecoded;
+};
+
+// the images embedded in the executable that the organ model draws with,
+// shared by the editor and the command line tool
+class GOODFBitmaps {
+public:
+	void LoadEmbeddedBitmaps();
+
+	EmbeddedBitmapList m_buttonBitmaps;
+	EmbeddedBitmapList m_drawstopBitmaps;
+	EmbeddedBitmapList m_scaledDrawstopBitmaps;
+	EmbeddedBitmapList m_enclosureStyleBitmaps;
+	EmbeddedBitmapList m_labelBitmaps;
+	EmbeddedBitmapList m_fullSizeLabelBmps;
+	EmbeddedBitmapList m_defaultManualBitmaps;
+	EmbeddedBitmapList m_invertedManualBitmaps;
+	EmbeddedBitmapList m_woodenManualBitmaps;
+	EmbeddedBitmapList m_invertedWoodenManualBitmaps;
+	EmbeddedBitmapList m_defaultPedalBitmaps;
+	EmbeddedBitmapList m_invertedPedalBitmaps;
+
+	EmbeddedBitmapList m_manualKeyBmps01;
+	EmbeddedBitmapList m_invertedManualKeysBmps01;
+	EmbeddedBitmapList m_woodenManualKeysBmps01;
+	EmbeddedBitmapList m_invertedManualWoodenKeysBmps01;
+	EmbeddedBitmapList m_pedalKeysBmps01;
+	EmbeddedBitmapList m_invertedPedalKeysBmps01;
+	EmbeddedBitmapList m_manualKeyBmps02;
+	EmbeddedBitmapList m_invertedManualKeysBmps02;
+	EmbeddedBitmapList m_woodenManualKeysBmps02;
+	EmbeddedBitmapList m_invertedManualWoodenKeysBmps02;
+	EmbeddedBitmapList m_pedalKeysBmps02;
+	EmbeddedBitmapList m_invertedPedalKeysBmps02;
+
+	EmbeddedBitmapList m_woodBitmaps;
+	EmbeddedBitmapList m_scaledWoodBitmaps;
+};
+
+#endif
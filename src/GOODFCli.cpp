@@ -0,0 +1,77 @@
+/* 
+ * GOODFCli.cpp is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#include "GOODF.h"
+#include "GOODFDef.h"
+#include "TraceRecorder.h"
+#include <wx/image.h>
+
+IMPLEMENT_APP_CONSOLE(GOODF)
+
+thread_local Organ *GOODFCliCurrentOrgan::s_organ = NULL;
+
+GOODF::GOODF() {
+	m_frame = NULL;
+	m_hasGui = false;
+}
+
+bool GOODF::Initialize(int& argc, wxChar **argv) {
+#ifdef __WXGTK__
+	// gtk can't be initialized without a display, so only the console part
+	// of the app is set up then
+	if (!wxGetEnv(wxT("DISPLAY"), NULL) && !wxGetEnv(wxT("WAYLAND_DISPLAY"), NULL))
+		return wxAppConsole::Initialize(argc, argv);
+#endif
+	m_hasGui = wxApp::Initialize(argc, argv);
+	return m_hasGui;
+}
+
+void GOODF::CleanUp() {
+	if (m_hasGui)
+		wxApp::CleanUp();
+	else
+		wxAppConsole::CleanUp();
+}
+
+bool GOODF::OnInit() {
+	// the command line is handled by OnRun of each program
+	m_fullAppName = wxT("GoOdf ");
+	m_fullAppName.Append(wxT(GOODF_VERSION));
+	m_frame = new GOODFCliFrame();
+	TraceRecorder::enableFromEnvironment();
+
+	// messages must never end up in a message box
+	delete wxLog::SetActiveTarget(new wxLogStderr());
+
+	// the model draws with the embedded images when gui elements are read
+	wxInitAllImageHandlers();
+	LoadEmbeddedBitmaps();
+	return true;
+}
+
+bool GOODF::HasDisplay() {
+	return m_hasGui;
+}
+
+int GOODF::OnExit() {
+	TraceRecorder::finishFromEnvironment();
+	delete m_frame;
+	return wxApp::OnExit();
+}
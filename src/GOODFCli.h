@@ -0,0 +1,85 @@
+/* 
+ * GOODFCli.h is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#ifndef GOODFCLI_H
+#define GOODFCLI_H
+
+#include <wx/wx.h>
+#include <wx/fileconf.h>
+#include <wx/filename.h>
+#include <vector>
+#include "Organ.h"
+#include "GOODFBitmaps.h"
+
+// messages are collected per file and printed instead of shown in a window
+class GOODFCliLogWindow {
+public:
+	void Show(bool WXUNUSED(show)) {}
+};
+
+// The organ the model code reaches as ::wxGetApp().m_frame->m_organ. Every
+// worker thread processes an organ of its own so the pointer is per thread.
+class GOODFCliCurrentOrgan {
+public:
+	Organ* operator->() const { return s_organ; }
+	operator Organ*() const { return s_organ; }
+	GOODFCliCurrentOrgan& operator=(Organ *organ) { s_organ = organ; return *this; }
+
+private:
+	static thread_local Organ *s_organ;
+};
+
+// the parts of GOODFFrame that the organ model calls, without any windows
+class GOODFCliFrame {
+public:
+	GOODFCliCurrentOrgan m_organ;
+
+	GOODFCliLogWindow* GetLogWindow() { return &m_logWindow; }
+	void UpdateFrameTitle() {}
+	void RebuildPanelGuiElementsInTree(int WXUNUSED(panelIndex)) {}
+
+private:
+	GOODFCliLogWindow m_logWindow;
+};
+
+// The app shared by the command line programs, it never opens any window.
+// The gui toolkit is only initialized where there is a display, it's needed
+// to draw the panels but everything else works without it. Each program
+// implements OnRun itself.
+class GOODF : public wxApp, public GOODFBitmaps {
+public:
+	GOODF();
+	virtual bool Initialize(int& argc, wxChar **argv);
+	virtual void CleanUp();
+	virtual bool OnInit();
+	virtual int OnRun();
+	virtual int OnExit();
+	// the panels can only be drawn when the gui toolkit has been initialized
+	bool HasDisplay();
+	GOODFCliFrame *m_frame;
+	wxString m_fullAppName;
+
+private:
+	bool m_hasGui;
+};
+
+DECLARE_APP(GOODF)
+
+#endif
@@ -26,13 +26,23 @@
 #include <wx/stdpaths.h>
 #include <wx/msgdlg.h>
 #include <wx/button.h>
+#include <wx/dir.h>
 #include "Enclosure.h"
 #include "Windchestgroup.h"
 #include "OrganFileParser.h"
 #include "CopyElementAttributesDialog.h"
 #include "CmbDialog.h"
+#include "CmbVoicing.h"
 #include "DefaultPathsDialog.h"
 #include "StopRankImportDialog.h"
+#include "DuplicateSamplesDialog.h"
+#include "ImageAssetsDialog.h"
+#include "MemoryFootprintDialog.h"
+#include "SampleTranscodeDialog.h"
+#include "OrganPackager.h"
+#include "TraceRecorder.h"
+#include "DiagnosticsDialog.h"
+#include "PanelThumbnailPopup.h"
 #include <vector>
 #include <algorithm>
 
@@ -42,14 +52,31 @@ BEGIN_EVENT_TABLE(GOODFFrame, wxFrame)
 	EVT_MENU(wxID_HELP, GOODFFrame::OnHelp)
 	EVT_MENU(wxID_EXIT, GOODFFrame::OnQuit)
 	EVT_MENU(ID_WRITE_ODF, GOODFFrame::OnWriteODF)
+	EVT_MENU(ID_EXPORT_ORGAN_PACKAGE, GOODFFrame::OnExportOrganPackage)
 	EVT_MENU(ID_NEW_ORGAN, GOODFFrame::OnNewOrgan)
 	EVT_MENU(ID_READ_ORGAN, GOODFFrame::OnReadOrganFile)
 	EVT_MENU(ID_IMPORT_VOICING_DATA, GOODFFrame::OnImportCMB)
 	EVT_MENU(ID_IMPORT_STOP_RANK, GOODFFrame::OnImportStopRank)
 	EVT_MENU(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, GOODFFrame::OnEnableTooltipsMenu)
 	EVT_MENU(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, GOODFFrame::OnImportLegacyXfadesMenu)
+	EVT_MENU(ID_FIND_DUPLICATE_SAMPLES, GOODFFrame::OnFindDuplicateSamples)
+	EVT_MENU(ID_OPTIMIZE_PANEL_IMAGES, GOODFFrame::OnOptimizePanelImages)
+	EVT_MENU(ID_ESTIMATE_MEMORY_FOOTPRINT, GOODFFrame::OnEstimateMemoryFootprint)
+	EVT_MENU(ID_TRANSCODE_SAMPLES, GOODFFrame::OnTranscodeSamples)
+	EVT_MENU(ID_RECORD_TRACE, GOODFFrame::OnRecordTraceMenu)
 	EVT_MENU(ID_CLEAR_HISTORY, GOODFFrame::OnClearHistory)
 	EVT_MENU(ID_DEFAULT_PATHS_MENU, GOODFFrame::OnDefaultPathMenuChoice)
+	EVT_MENU(wxID_UNDO, GOODFFrame::OnUndo)
+	EVT_MENU(wxID_REDO, GOODFFrame::OnRedo)
+	EVT_UPDATE_UI(wxID_UNDO, GOODFFrame::OnUpdateUndo)
+	EVT_UPDATE_UI(wxID_REDO, GOODFFrame::OnUpdateRedo)
+	EVT_THREAD(ID_ODF_SAVE_WRITTEN, GOODFFrame::OnOdfWritten)
+	EVT_THREAD(ID_ODF_AUTOSAVE_WRITTEN, GOODFFrame::OnAutosaveWritten)
+	EVT_TIMER(ID_AUTOSAVE_TIMER, GOODFFrame::OnAutosaveTimer)
+	EVT_TIMER(ID_VALIDATION_TIMER, GOODFFrame::OnValidationTimer)
+	EVT_THREAD(ID_PANEL_THUMBNAIL_READY, GOODFFrame::OnPanelThumbnailReady)
+	EVT_TIMER(ID_PANEL_THUMBNAIL_TIMER, GOODFFrame::OnPanelThumbnailTimer)
+	EVT_MENU(ID_VALIDATE_ORGAN, GOODFFrame::OnValidateOrganMenu)
 	EVT_MENU_RANGE(wxID_FILE1, wxID_FILE9, GOODFFrame::OnRecentFileMenuChoice)
 	EVT_TREE_SEL_CHANGED(ID_ORGAN_TREE, GOODFFrame::OnOrganTreeSelectionChanged)
 	EVT_TREE_ITEM_RIGHT_CLICK(ID_ORGAN_TREE, GOODFFrame::OnOrganTreeRightClicked)
@@ -73,7 +100,21 @@ END_EVENT_TABLE()
 GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	// Start with an empty organ
 	m_organ = new Organ();
+	m_undoHistory = new UndoHistory();
+	m_validator = new OrganValidator();
+	m_memoryEstimator = new MemoryFootprintEstimator();
+	m_diagnosticsDialog = NULL;
+	m_lastValidatedModification = 0;
+	m_panelThumbnails = new PanelThumbnailCache(this, ID_PANEL_THUMBNAIL_READY, ID_PANEL_THUMBNAIL_TIMER, ID_PANEL_THUMBNAILS_UPDATED);
+	m_hoveredPanel = NULL;
+	m_odfWriter = new OdfWriter(this);
 	m_organHasBeenSaved = false;
+	m_notifyWhenWritten = false;
+	m_autosaveMinutes = 5;
+	m_lastAutosaveTime = wxGetLocalTimeMillis();
+	m_lastAutosavedModification = 0;
+	m_recoveryDiscardedAt = 0;
+	m_recoveryFile = wxEmptyString;
 	m_enableTooltips = false;
 	m_config = new wxFileConfig(wxT("GoOdf"));
 	m_defaultOrganDirectory = wxEmptyString;
@@ -91,8 +132,16 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	m_fileMenu->AppendSubMenu(m_recentMenu, wxT("Recent Files"));
 	m_fileMenu->AppendSeparator();
 	m_fileMenu->Append(ID_WRITE_ODF, wxT("Write ODF\tCtrl+S"), wxT("Write/Save the .organ file"));
+	m_fileMenu->Append(ID_EXPORT_ORGAN_PACKAGE, wxT("Export Organ Package..."), wxT("Copy the .organ file and only the files it uses to a new folder with a checksum manifest"));
 	m_fileMenu->Append(wxID_EXIT, wxT("&Exit\tCtrl+Q"), wxT("Quit this program"));
 
+	// Create an edit menu
+	m_editMenu = new wxMenu();
+
+	// Add edit menu items
+	m_editMenu->Append(wxID_UNDO, wxT("&Undo\tCtrl+Z"), wxT("Undo the last change"));
+	m_editMenu->Append(wxID_REDO, wxT("&Redo\tCtrl+Y"), wxT("Redo the last undone change"));
+
 	// Create a tools menu
 	m_toolsMenu = new wxMenu();
 
@@ -102,10 +151,18 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	m_toolsMenu->AppendCheckItem(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, wxT("Enable Tooltips"), wxT("Enable tooltips for certain controls"));
 	m_toolsMenu->Check(ID_GLOBAL_SHOW_TOOLTIPS_OPTION, false);
 	m_toolsMenu->Append(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, wxT("Import Legacy X-fades"), wxT("Make extra attacks/releases inherit LoopCrossfadeLength & ReleaseCrossfadeLength values like pre GO v3.14.0"));
+	m_toolsMenu->Append(ID_VALIDATE_ORGAN, wxT("Validate Organ"), wxT("Check the organ for problems like missing samples, loops beyond the sample end, broken references and elements outside panels"));
+	m_toolsMenu->Append(ID_FIND_DUPLICATE_SAMPLES, wxT("Find Duplicate Samples"), wxT("Find sample files with identical audio data used by ranks/stops and share or borrow them instead"));
+	m_toolsMenu->Append(ID_OPTIMIZE_PANEL_IMAGES, wxT("Optimize Panel Images"), wxT("Find image files with identical pixels used on the panels and share them, and write BMP images as PNG"));
+	m_toolsMenu->Append(ID_ESTIMATE_MEMORY_FOOTPRINT, wxT("Estimate Memory Footprint"), wxT("Estimate the sample memory GrandOrgue needs per stop, rank and windchest with different loading settings"));
+	m_toolsMenu->Append(ID_TRANSCODE_SAMPLES, wxT("Transcode Samples"), wxT("Write new sample files for chosen ranks with a lower bit depth, folded to mono or trimmed and use them instead"));
+	m_toolsMenu->AppendCheckItem(ID_RECORD_TRACE, wxT("Record Performance Trace"), wxT("Record timings of opening, saving and drawing. Unchecking saves the trace and shows a summary in the log"));
+	m_toolsMenu->Check(ID_RECORD_TRACE, TraceRecorder::isEnabled());
 	m_toolsMenu->Append(ID_CLEAR_HISTORY, wxT("Clear File History"), wxT("Remove all the entries in the recent file history"));
 	m_toolsMenu->Append(ID_DEFAULT_PATHS_MENU, wxT("Default paths\tCtrl+P"), wxT("Set the default paths used by the application here"));
 
 	m_toolsMenu->Enable(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, false);
+	m_toolsMenu->Enable(ID_FIND_DUPLICATE_SAMPLES, false);
 
 	// Create a help menu
 	m_helpMenu = new wxMenu();
@@ -117,6 +174,7 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	// Create a menu bar and append the menus to it
 	m_menuBar = new wxMenuBar();
 	m_menuBar->Append(m_fileMenu, wxT("&File"));
+	m_menuBar->Append(m_editMenu, wxT("&Edit"));
 	m_menuBar->Append(m_toolsMenu, wxT("&Tools"));
 	m_menuBar->Append(m_helpMenu, wxT("&Help"));
 
@@ -498,6 +556,8 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	m_Splitter->Connect(wxEVT_MOTION, wxMouseEventHandler(GOODFFrame::OnOrganTreeMouseMotion), NULL, this);
 	leftSplitPanel->Connect(wxEVT_MOTION, wxMouseEventHandler(GOODFFrame::OnOrganTreeMouseMotion), NULL, this);
 	m_organTreeCtrl->Connect(wxEVT_MOTION, wxMouseEventHandler(GOODFFrame::OnOrganTreeMouseMotion), NULL, this);
+	m_organTreeCtrl->Connect(wxEVT_LEAVE_WINDOW, wxMouseEventHandler(GOODFFrame::OnOrganTreeMouseLeave), NULL, this);
+	m_thumbnailPopup = new PanelThumbnailPopup(this);
 
 	// Read settings file and apply if found
 	bool b;
@@ -559,6 +619,15 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	bool loadPipesTremOff = false;
 	m_config->Read(wxT("Rank/LoadPipesAsTremulantOff"), &loadPipesTremOff);
 
+	// autosave interval in minutes, 0 disables autosave
+	if (m_config->Read(wxT("General/AutosaveInterval"), &readInt) && readInt >= 0)
+		m_autosaveMinutes = readInt;
+	m_autosaveTimer = new wxTimer(this, ID_AUTOSAVE_TIMER);
+	m_autosaveTimer->Start(30000);
+	// keeps the diagnostics up to date while they are shown
+	m_validationTimer = new wxTimer(this, ID_VALIDATION_TIMER);
+	m_validationTimer->Start(1000);
+
 	m_rankPanel->SetPipeReadingOptions(
 		atkFolder,
 		oneAttack,
@@ -608,13 +677,16 @@ void GOODFFrame::OnQuit(wxCommandEvent& WXUNUSED(event)) {
 }
 
 void GOODFFrame::OnClose(wxCloseEvent& event) {
+	bool keepRecoveryFile = false;
 	if (event.CanVeto() && m_organ->isModified()) {
 		// Ask if user wants to save/write the organ file
 		wxMessageDialog dlg(this, wxT("ODF file is modified. Do you want to save/write it?"), wxT("ODF file is modified"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 		if (dlg.ShowModal() == wxID_YES) {
-			// Try triggering save/write by posting an event
+			// Try triggering save/write, the file is written on another thread so wait for the result
 			wxCommandEvent evt(wxEVT_MENU, ID_WRITE_ODF);
-			wxPostEvent(this, evt);
+			ProcessWindowEvent(evt);
+			m_odfWriter->waitUntilDone();
+			ProcessPendingEvents();
 
 			if (m_organ->isModified()) {
 				// This means that the save failed, ask if the user wants to abort the quitting to fix the issue
@@ -623,10 +695,22 @@ void GOODFFrame::OnClose(wxCloseEvent& event) {
 					event.Veto();
 					return;
 				}
+				keepRecoveryFile = true;
 			}
 		}
 	}
 
+	// any write in progress must be finished before quitting
+	m_autosaveTimer->Stop();
+	delete m_autosaveTimer;
+	m_validationTimer->Stop();
+	delete m_validationTimer;
+	delete m_odfWriter;
+	m_odfWriter = NULL;
+	ProcessPendingEvents();
+	if (!keepRecoveryFile)
+		DiscardRecoveryFile(m_organ->getModificationCount());
+
 	// Write config file (settings)
 	m_config->Write(wxT("General/EnableTooltips"), m_enableTooltips);
 	UpdateFrameSizeAndPos();
@@ -649,6 +733,11 @@ void GOODFFrame::OnClose(wxCloseEvent& event) {
 	m_config->Flush();
 	delete m_config;
 	delete m_recentlyUsed;
+	delete m_undoHistory;
+	delete m_validator;
+	delete m_memoryEstimator;
+	delete m_panelThumbnails;
+	m_panelThumbnails = NULL;
 
 	// Destroy the frame
 	Destroy();
@@ -662,32 +751,204 @@ void GOODFFrame::OnWriteODF(wxCommandEvent& WXUNUSED(event)) {
 		return;
 	}
 	wxString fullFileName = m_organPanel->getOdfPath() + wxFILE_SEP_PATH + m_organPanel->getOdfName() + wxT(".organ");
-	wxTextFile *odfFile = new wxTextFile(fullFileName);
-	if (odfFile->Exists() && !m_organHasBeenSaved) {
+	if (wxFileExists(fullFileName) && !m_organHasBeenSaved) {
 		wxMessageDialog dlg(this, wxT("ODF file already exist. Do you want to overwrite it?"), wxT("Existing ODF file"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-		if (dlg.ShowModal() == wxID_YES) {
-			odfFile->Open(fullFileName);
-			odfFile->Clear();
-		} else {
-			delete odfFile;
+		if (dlg.ShowModal() != wxID_YES)
 			return;
-		}
-	} else {
-		odfFile->Create(fullFileName);
 	}
-	m_organ->writeOrgan(odfFile);
-
-	odfFile->Write(wxTextFileType_Dos, wxCSConv("ISO-8859-1"));
-	if (!m_organHasBeenSaved) {
-		wxMessageDialog msg(this, wxT("ODF file ") + m_organPanel->getOdfName() + wxT(".organ has been written!"), wxT("ODF file written"), wxOK|wxCENTRE);
-		msg.ShowModal();
-	}
-	odfFile->Close();
-	delete odfFile;
+	// only the lines without the pipes are created here, the pipes, the file and
+	// the snapshot are written by the writer thread
+	m_odfWriter->write(OdfWriter::createJob(m_organ, fullFileName, ID_ODF_SAVE_WRITTEN, true));
+	m_notifyWhenWritten = !m_organHasBeenSaved;
 	m_organHasBeenSaved = true;
 	m_organ->setModified(false);
 	UpdateFrameTitle();
+}
+
+void GOODFFrame::OnExportOrganPackage(wxCommandEvent& WXUNUSED(event)) {
+	FixAnyIllegalEntries();
+	if (m_organPanel->getOdfName().IsEmpty()) {
+		wxMessageDialog incomplete(this, wxT("The ODF must have a name before it can be packaged!"), wxT("Cannot export package"), wxOK|wxCENTRE);
+		incomplete.ShowModal();
+		return;
+	}
+	wxDirDialog dirDialog(
+		this,
+		wxT("Pick the folder for the organ package"),
+		m_organPanel->getOdfPath()
+	);
+	if (dirDialog.ShowModal() != wxID_OK)
+		return;
+	wxString targetRoot = dirDialog.GetPath();
+	if (wxFileName::DirName(targetRoot).SameAs(wxFileName::DirName(m_organ->getOdfRoot()))) {
+		wxMessageDialog sameFolder(this, wxT("The package must be written to another folder than the one of the organ!"), wxT("Cannot export package"), wxOK|wxCENTRE);
+		sameFolder.ShowModal();
+		return;
+	}
+	wxDir targetDir(targetRoot);
+	if (targetDir.IsOpened() && (targetDir.HasFiles() || targetDir.HasSubDirs())) {
+		wxMessageDialog notEmpty(this, wxT("The folder isn't empty, existing files with the same names will be replaced. Continue?"), wxT("Folder not empty"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
+		if (notEmpty.ShowModal() != wxID_YES)
+			return;
+	}
+	wxMessageDialog linkQuestion(
+		this,
+		wxT("Files on the same drive can be hard linked instead of copied, which is much faster and takes no extra space, but the package then shares the files with the original so changing one changes both.\n\nHard link files when possible?"),
+		wxT("Hard links"),
+		wxYES_NO|wxNO_DEFAULT|wxCENTRE
+	);
+	bool allowHardLinks = linkQuestion.ShowModal() == wxID_YES;
+
+	OrganPackager packager(m_organ);
+	wxProgressDialog progress(
+		wxT("Exporting organ package"),
+		wxEmptyString,
+		100,
+		this,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	bool completed = packager.copyFiles(targetRoot, allowHardLinks, &progress);
+	progress.Hide();
+	if (!completed) {
+		wxLogWarning(wxT("The export of the organ package was cancelled after %u of %u files."), packager.getNumberOfCopiedFiles(), packager.getNumberOfFiles());
+		m_logWindow->Show(true);
+		return;
+	}
+
+	for (unsigned i = 0; i < packager.getNumberOfFiles(); i++) {
+		PACKAGE_FILE *file = packager.getFileAt(i);
+		if (!file->exists)
+			wxLogWarning(wxT("%s is used by the organ but doesn't exist"), file->sourcePath);
+		else if (!file->isCopied)
+			wxLogWarning(wxT("%s %s"), file->sourcePath, file->error);
+	}
+	if (!packager.writeManifest(targetRoot, m_organPanel->getOdfName() + wxT(".sha256")))
+		wxLogWarning(wxT("The checksum manifest couldn't be written to %s"), targetRoot);
+	if (!packager.writeOrgan(targetRoot, m_organPanel->getOdfName()))
+		wxLogWarning(wxT("The ODF couldn't be written to %s"), targetRoot);
+	wxLogMessage(
+		wxT("Organ package written to %s with %u files (%s), %u of them linked instead of copied."),
+		targetRoot,
+		packager.getNumberOfCopiedFiles(),
+		wxFileName::GetHumanReadableSize(packager.getTotalBytes()),
+		packager.getNumberOfLinkedFiles()
+	);
+	m_logWindow->Show(true);
+}
+
+void GOODFFrame::OnOdfWritten(wxThreadEvent& event) {
+	wxString fullFileName = event.GetString();
+	if (!event.GetInt()) {
+		wxLogWarning(wxT("The ODF file %s couldn't be written!"), fullFileName);
+		m_logWindow->Show(true);
+		m_organ->setModified(true);
+		return;
+	}
 	m_recentlyUsed->AddFileToHistory(fullFileName);
+	// problems are reported but don't prevent saving, the organ is only checked
+	// here once it has been validated so that just the changed elements are
+	// checked again and no sample files are scanned while saving
+	if (m_validator->hasResultsFor(m_organ)) {
+		ValidateOrgan();
+		if (m_validator->getNumberOfErrors() > 0) {
+			wxLogWarning(wxT("%u problems that GrandOrgue might not accept were found in the organ, see Tools->Validate Organ."), m_validator->getNumberOfErrors());
+			m_logWindow->Show(true);
+		}
+	}
+	if (m_notifyWhenWritten) {
+		m_notifyWhenWritten = false;
+		wxMessageDialog msg(this, wxT("ODF file ") + wxFileName(fullFileName).GetFullName() + wxT(" has been written!"), wxT("ODF file written"), wxOK|wxCENTRE);
+		msg.ShowModal();
+	}
+	DiscardRecoveryFile(event.GetExtraLong());
+}
+
+void GOODFFrame::OnAutosaveTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (m_autosaveMinutes == 0 || !m_organ->isModified())
+		return;
+	if (m_organ->getModificationCount() == m_lastAutosavedModification)
+		return;
+	if (wxGetLocalTimeMillis() - m_lastAutosaveTime < (wxLongLong) m_autosaveMinutes * 60000)
+		return;
+	if (m_odfWriter->isBusy())
+		return;
+	wxString recoveryFile = GetRecoveryFilePath();
+	if (recoveryFile == wxEmptyString)
+		return;
+
+	m_lastAutosaveTime = wxGetLocalTimeMillis();
+	m_lastAutosavedModification = m_organ->getModificationCount();
+	m_odfWriter->write(OdfWriter::createJob(m_organ, recoveryFile, ID_ODF_AUTOSAVE_WRITTEN));
+}
+
+void GOODFFrame::OnAutosaveWritten(wxThreadEvent& event) {
+	wxString recoveryFile = event.GetString();
+	if (!event.GetInt()) {
+		wxLogWarning(wxT("Autosave to %s failed!"), recoveryFile);
+		return;
+	}
+	if (event.GetExtraLong() <= m_recoveryDiscardedAt) {
+		// the organ has been saved or replaced since this copy was made
+		if (wxFileExists(recoveryFile))
+			wxRemoveFile(recoveryFile);
+		return;
+	}
+	if (m_recoveryFile != wxEmptyString && !m_recoveryFile.IsSameAs(recoveryFile) && wxFileExists(m_recoveryFile))
+		wxRemoveFile(m_recoveryFile);
+	m_recoveryFile = recoveryFile;
+	m_config->Write(wxT("General/RecoveryFile"), m_recoveryFile);
+	m_config->Flush();
+}
+
+wxString GOODFFrame::GetRecoveryFilePath() {
+	// relative sample paths require the copy to be in the same folder as the .organ file
+	if (m_organPanel->getOdfPath().IsEmpty() || m_organPanel->getOdfName().IsEmpty())
+		return wxEmptyString;
+	return m_organPanel->getOdfPath() + wxFILE_SEP_PATH + m_organPanel->getOdfName() + wxT(".organ.autosave");
+}
+
+void GOODFFrame::DiscardRecoveryFile(long upToModification) {
+	if (upToModification > m_recoveryDiscardedAt)
+		m_recoveryDiscardedAt = upToModification;
+	if (m_recoveryFile == wxEmptyString)
+		return;
+	if (wxFileExists(m_recoveryFile))
+		wxRemoveFile(m_recoveryFile);
+	m_recoveryFile = wxEmptyString;
+	m_config->DeleteEntry(wxT("General/RecoveryFile"));
+	m_config->Flush();
+}
+
+void GOODFFrame::CheckForRecoveryFile() {
+	wxString recoveryFile = wxEmptyString;
+	if (!m_config->Read(wxT("General/RecoveryFile"), &recoveryFile))
+		return;
+	if (!wxFileExists(recoveryFile)) {
+		m_config->DeleteEntry(wxT("General/RecoveryFile"));
+		m_config->Flush();
+		return;
+	}
+
+	// the autosaved copy is named <name>.organ.autosave
+	wxFileName recoveryName(recoveryFile);
+	wxString organName = wxFileName(recoveryName.GetName()).GetName();
+	wxString message = wxT("GoOdf wasn't closed normally last time. An autosaved copy of ") + organName + wxT(".organ from ") + recoveryName.GetModificationTime().Format() + wxT(" exists. Do you want to recover it?");
+	wxMessageDialog dlg(this, message, wxT("Recover autosaved organ?"), wxYES_NO|wxCENTRE|wxICON_QUESTION);
+	if (dlg.ShowModal() != wxID_YES) {
+		wxRemoveFile(recoveryFile);
+		m_config->DeleteEntry(wxT("General/RecoveryFile"));
+		m_config->Flush();
+		return;
+	}
+
+	DoOpenOrgan(recoveryFile);
+	if (m_recentlyUsed->GetCount() && m_recentlyUsed->GetHistoryFile(0).IsSameAs(recoveryFile))
+		m_recentlyUsed->RemoveFileFromHistory(0);
+	// saving the recovered organ should write the original file
+	m_organPanel->setOdfName(organName);
+	m_recoveryFile = recoveryFile;
+	m_organ->setModified(true);
+	UpdateFrameTitle();
 }
 
 void GOODFFrame::OnReadOrganFile(wxCommandEvent& WXUNUSED(event)) {
@@ -721,12 +982,14 @@ void GOODFFrame::OnReadOrganFile(wxCommandEvent& WXUNUSED(event)) {
 }
 
 void GOODFFrame::DoOpenOrgan(wxString filePath) {
+	TraceScope trace("GOODFFrame::DoOpenOrgan", filePath);
 	m_organTreeCtrl->SetFocusedItem(tree_organ);
 	if (m_organ) {
 		delete m_organ;
 		m_organ = NULL;
 	}
 	m_organ = new Organ();
+	DiscardRecoveryFile(m_organ->getModificationCount());
 	removeAllItemsFromTree();
 	m_organHasBeenSaved = false;
 	RecreateLogWindow();
@@ -738,6 +1001,7 @@ void GOODFFrame::DoOpenOrgan(wxString filePath) {
 		m_organPanel->setCurrentOrgan(m_organ);
 		m_organPanel->setOdfPath(f_name.GetPath());
 		m_organPanel->setOdfName(f_name.GetName());
+		TraceScope treeTrace("build organ tree");
 		for (unsigned i = 0; i < m_organ->getNumberOfEnclosures(); i++) {
 			m_organTreeCtrl->AppendItem(tree_enclosures, m_organ->getOrganEnclosureAt(i)->getName());
 		}
@@ -1199,14 +1463,14 @@ void GOODFFrame::OnOrganTreeSelectionChanged(wxTreeEvent& event) {
 				// the Displaymetrics of a panel is selected
 				if (m_Splitter->GetWindow2() != m_dispMetricsPanel) {
 					int sashPos = m_Splitter->GetSashPosition();
-					m_dispMetricsPanel->setDisplayMetrics(m_organ->getOrganPanelAt(thePanelIndex)->getDisplayMetrics());
+					m_dispMetricsPanel->setDisplayMetrics(m_organ->getOrganPanelAt(thePanelIndex)->getDisplayMetrics(), m_organ->getOrganPanelAt(thePanelIndex));
 					m_Splitter->GetWindow2()->Hide();
 					m_Splitter->ReplaceWindow(m_Splitter->GetWindow2(), m_dispMetricsPanel);
 					m_Splitter->SetSashPosition(sashPos);
 					m_dispMetricsPanel->Show();
 				} else {
 					// another panels displaymetrics might be chosen, update panel
-					m_dispMetricsPanel->setDisplayMetrics(m_organ->getOrganPanelAt(thePanelIndex)->getDisplayMetrics());
+					m_dispMetricsPanel->setDisplayMetrics(m_organ->getOrganPanelAt(thePanelIndex)->getDisplayMetrics(), m_organ->getOrganPanelAt(thePanelIndex));
 				}
 			} else {
 				// the Images category or GUI Element category of a panel is selected
@@ -1487,6 +1751,12 @@ void GOODFFrame::OnOrganTreeRightClicked(wxTreeEvent& event) {
 				GoPanel *targetPanel = copyElementDlg.GetSelectedTargetPanel();
 				wxArrayInt selectedTargetElements;
 				if (copyElementDlg.GetSelectedElementIndices(selectedTargetElements)) {
+					// the state of all targets is kept so that the copy can be undone as one step
+					UndoStep *undoStep = m_undoHistory->beginStep(m_organ, wxT("Copy GUI element attributes"));
+					for (unsigned i = 0; i < selectedTargetElements.size(); i++)
+						undoStep->recordGuiElement(targetPanel->getGuiElementAt(selectedTargetElements[i]));
+					targetPanel->markChanged();
+
 					// we have some targets to copy to but we also need to get the actual source element
 
 					// Test if the source a button type
@@ -1522,6 +1792,7 @@ void GOODFFrame::OnOrganTreeRightClicked(wxTreeEvent& event) {
 								targetBtn->setDispKeyLabelOnLeft(btnElement->isDispKeyLabelOnLeft());
 							}
 						}
+						m_undoHistory->commitStep(undoStep);
 						return;
 					}
 
@@ -1564,6 +1835,7 @@ void GOODFFrame::OnOrganTreeRightClicked(wxTreeEvent& event) {
 								targetEnclosure->setBitmapHeight(encElement->getBitmapHeight());
 							}
 						}
+						m_undoHistory->commitStep(undoStep);
 						return;
 					}
 
@@ -1592,6 +1864,7 @@ void GOODFFrame::OnOrganTreeRightClicked(wxTreeEvent& event) {
 								targetLabel->setBitmapHeight(labelElement->getBitmapHeight());
 							}
 						}
+						m_undoHistory->commitStep(undoStep);
 						return;
 					}
 
@@ -1641,8 +1914,10 @@ void GOODFFrame::OnOrganTreeRightClicked(wxTreeEvent& event) {
 								}
 							}
 						}
+						m_undoHistory->commitStep(undoStep);
 						return;
 					}
+					delete undoStep;
 				}
 			}
 		}
@@ -1818,6 +2093,7 @@ void GOODFFrame::OnOrganTreeDragCompleted(wxTreeEvent& event) {
 		m_organTreeCtrl->DeleteChildren(srcItem);
 		m_organTreeCtrl->Delete(srcItem);
 		m_organ->moveManual(sourceIndex, targetIndex);
+		m_undoHistory->removeStopDependentActions();
 		m_organTreeCtrl->SelectItem(newPos);
 	} else if (dstItem == tree_manuals && srcParent == tree_manuals) {
 		// we make it first child
@@ -1881,6 +2157,7 @@ void GOODFFrame::OnOrganTreeDragCompleted(wxTreeEvent& event) {
 		m_organTreeCtrl->DeleteChildren(srcItem);
 		m_organTreeCtrl->Delete(srcItem);
 		m_organ->moveManual(sourceIndex, 0);
+		m_undoHistory->removeStopDependentActions();
 		m_organTreeCtrl->SelectItem(newPos);
 		m_organ->setModified(true);
 	} else if (dstParent == tree_windchestgrps && srcParent == tree_windchestgrps) {
@@ -2059,6 +2336,7 @@ void GOODFFrame::OnOrganTreeDragCompleted(wxTreeEvent& event) {
 
 			// Now we should know the source and destination index of respective manual and stop
 			if (m_organ->moveStop(srcManualIdx, srcStopIdx, dstManualIdx, dstStopIdx)) {
+				m_undoHistory->removeStopDependentActions();
 				// The move succeeded in the organ so now it's just to take care of it in tree
 				wxTreeItemId newPos = m_organTreeCtrl->InsertItem(dstParent, dstItem, m_organTreeCtrl->GetItemText(srcItem));
 				m_organTreeCtrl->Delete(srcItem);
@@ -2090,6 +2368,7 @@ void GOODFFrame::OnOrganTreeDragCompleted(wxTreeEvent& event) {
 			int dstStopIdx = 0;
 			// Now we should know the source and destination index of respective manual and stop
 			if (m_organ->moveStop(srcManualIdx, srcStopIdx, dstManualIdx, dstStopIdx)) {
+				m_undoHistory->removeStopDependentActions();
 				// The move succeeded in the organ so now it's just to take care of it in tree
 				wxTreeItemId newPos;
 				if (m_organTreeCtrl->GetItemText(dstItem) == wxT("Stops")) {
@@ -2241,6 +2520,7 @@ void GOODFFrame::OnOrganTreeDragCompleted(wxTreeEvent& event) {
 }
 
 void GOODFFrame::OnOrganTreeMouseMotion(wxMouseEvent& event) {
+	UpdateHoveredPanel(event);
 	if (m_enableTooltips && !event.Dragging()) {
 		int flagsToUse = wxTREE_HITTEST_ONITEMINDENT|wxTREE_HITTEST_ONITEMLABEL;
 		wxPoint cursor = event.GetPosition();
@@ -2370,6 +2650,9 @@ void GOODFFrame::RemoveCurrentItemFromOrgan() {
 	wxTreeItemId selected;
 	selected = m_organTreeCtrl->GetSelection();
 	if (selected.IsOk() && m_organTreeCtrl->GetItemParent(selected) != m_organTreeCtrl->GetRootItem()) {
+		// pipes referencing other pipes keep REF: paths of manual and stop numbers
+		// that change when stops or manuals are removed
+		bool stopsRenumbered = false;
 		// this is indeed a removable item, get what index it has
 		int selectedIndex = 0;
 		wxTreeItemId parentId = m_organTreeCtrl->GetItemParent(selected);
@@ -2539,6 +2822,7 @@ void GOODFFrame::RemoveCurrentItemFromOrgan() {
 			Stop *s = m_organ->getOrganManualAt(theManualIndex)->getStopAt(selectedIndex);
 			m_organ->removeStop(s);
 			m_organ->getOrganManualAt(theManualIndex)->removeStop(s);
+			stopsRenumbered = true;
 			wxTreeItemId nextToSelect;
 			if (numChildrens > 1) {
 				// there's more than one child to the parent so we select the other lower (or higher if it was the first)
@@ -2632,6 +2916,7 @@ void GOODFFrame::RemoveCurrentItemFromOrgan() {
 				nextToSelect = parentId;
 			}
 			m_organ->removeManualAt(selectedIndex);
+			stopsRenumbered = true;
 			m_organTreeCtrl->Delete(selected);
 			m_organTreeCtrl->SelectItem(nextToSelect);
 		}
@@ -2712,6 +2997,9 @@ void GOODFFrame::RemoveCurrentItemFromOrgan() {
 			m_organTreeCtrl->Delete(selected);
 			m_organTreeCtrl->SelectItem(nextToSelect);
 		}
+		m_undoHistory->removeInvalidActions();
+		if (stopsRenumbered)
+			m_undoHistory->removeStopDependentActions();
 		m_organ->setModified(true);
 	}
 }
@@ -2871,6 +3159,7 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 				m_organ = NULL;
 			}
 			m_organ = new Organ();
+			DiscardRecoveryFile(m_organ->getModificationCount());
 			m_organHasBeenSaved = false;
 
 			removeAllItemsFromTree();
@@ -2889,6 +3178,7 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 			m_organ = NULL;
 		}
 		m_organ = new Organ();
+		DiscardRecoveryFile(m_organ->getModificationCount());
 		m_organHasBeenSaved = false;
 
 		removeAllItemsFromTree();
@@ -2989,241 +3279,23 @@ void GOODFFrame::OnImportCMB(wxCommandEvent& WXUNUSED(event)) {
 	if (importCmb.ShowModal() == wxID_OK) {
 		CMB_ORGAN *imported = importCmb.GetCmbOrgan();
 
-		if (m_organ->getNumberOfRanks() != imported->cmbRanks.size() ||
-			m_organ->getNumberOfStops() != imported->cmbStops.size() ||
-			m_organ->getNumberOfWindchestgroups() != imported->cmbWindchests.size()
-		) {
+		if (!CmbVoicing::countsMatch(imported, m_organ)) {
 			wxMessageDialog dlg(this, wxT("The number of windchests/ranks/stops in the imported cmb doesn't match current organ! Do you want to import selected data to what is possible anyway?"), wxT("Are you really sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 			if (dlg.ShowModal() != wxID_YES) {
 				return;
 			}
 		}
 
-		if (importCmb.GetImportAmplitude())
-			m_organ->setAmplitudeLevel(imported->attributes.amplitude);
-		if (importCmb.GetImportGain())
-			m_organ->setGain(imported->attributes.gain);
-		if (importCmb.GetImportPitchTuning()) {
-			float pitchT = m_organ->getPitchTuning() + imported->attributes.pitchTuning;
-			if (pitchT >= -1800 && pitchT <= 1800) {
-				m_organ->setPitchTuning(pitchT);
-			} else {
-				wxMessageDialog pTerr(this, wxT("The PitchTuning value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-				if (pTerr.ShowModal() == wxID_YES) {
-					if (pitchT > 1800)
-						m_organ->setPitchTuning(1800);
-					else if (pitchT < -1800)
-						m_organ->setPitchTuning(-1800);
-				}
-			}
-		}
-		if (importCmb.GetImportPitchCorrection()) {
-			float pitchC = m_organ->getPitchCorrection() + imported->attributes.pitchCorrection;
-			if (pitchC >= -1800 && pitchC <= 1800) {
-				m_organ->setPitchCorrection(pitchC);
-			} else {
-				wxMessageDialog pCerr(this, wxT("The PitchCorrection value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-				if (pCerr.ShowModal() == wxID_YES) {
-					if (pitchC > 1800)
-						m_organ->setPitchCorrection(1800);
-					else if (pitchC < -1800)
-						m_organ->setPitchCorrection(-1800);
-				}
-			}
-		}
-		if (importCmb.GetImportTrackerDelay()) {
-			m_organ->setTrackerDelay(imported->attributes.trackerDelay);
-		}
-
-		unsigned windchestIdx = 0;
-		for (CMB_ELEMENT &w : imported->cmbWindchests) {
-			if (m_organ->getNumberOfWindchestgroups() > windchestIdx) {
-				Windchestgroup *windchest = m_organ->getOrganWindchestgroupAt(windchestIdx);
-
-				if (importCmb.GetImportAmplitude())
-					windchest->setAmplitudeLevel(w.amplitude);
-				if (importCmb.GetImportGain())
-					windchest->setGain(w.gain);
-				if (importCmb.GetImportPitchTuning()) {
-					float pitchT = windchest->getPitchTuning() + w.pitchTuning;
-					if (pitchT >= -1800 && pitchT <= 1800) {
-						windchest->setPitchTuning(pitchT);
-					} else {
-						wxMessageDialog pTerr(this, wxT("The PitchTuning value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pTerr.ShowModal() == wxID_YES) {
-							if (pitchT > 1800)
-								windchest->setPitchTuning(1800);
-							else if (pitchT < -1800)
-								windchest->setPitchTuning(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportPitchCorrection()) {
-					float pitchC = windchest->getPitchCorrection() + w.pitchCorrection;
-					if (pitchC >= -1800 && pitchC <= 1800) {
-						windchest->setPitchCorrection(pitchC);
-					} else {
-						wxMessageDialog pCerr(this, wxT("The PitchCorrection value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pCerr.ShowModal() == wxID_YES) {
-							if (pitchC > 1800)
-								windchest->setPitchCorrection(1800);
-							else if (pitchC < -1800)
-								windchest->setPitchCorrection(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportTrackerDelay()) {
-					windchest->setTrackerDelay(w.trackerDelay);
-				}
-			}
-			windchestIdx++;
-		}
-
-		unsigned stopIdx = 0;
-		for (CMB_ELEMENT_WITH_PIPES &s : imported->cmbStops) {
-			if (m_organ->getNumberOfStops() > stopIdx) {
-				Stop *stop = m_organ->getOrganStopAt(stopIdx);
-				if (!stop->isUsingInternalRank())
-					continue;
-
-				if (importCmb.GetImportAmplitude())
-					stop->getInternalRank()->setAmplitudeLevel(s.attributes.amplitude);
-				if (importCmb.GetImportGain())
-					stop->getInternalRank()->setGain(s.attributes.gain);
-				if (importCmb.GetImportPitchTuning()) {
-					float pitchT = stop->getInternalRank()->getPitchTuning() + s.attributes.pitchTuning;
-					if (pitchT >= -1800 && pitchT <= 1800) {
-						stop->getInternalRank()->setPitchTuning(pitchT);
-					} else {
-						wxMessageDialog pTerr(this, wxT("The PitchTuning value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pTerr.ShowModal() == wxID_YES) {
-							if (pitchT > 1800)
-								stop->getInternalRank()->setPitchTuning(1800);
-							else if (pitchT < -1800)
-								stop->getInternalRank()->setPitchTuning(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportPitchCorrection()) {
-					float pitchC = stop->getInternalRank()->getPitchCorrection() + s.attributes.pitchCorrection;
-					if (pitchC >= -1800 && pitchC <= 1800) {
-						stop->getInternalRank()->setPitchCorrection(pitchC);
-					} else {
-						wxMessageDialog pCerr(this, wxT("The PitchCorrection value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pCerr.ShowModal() == wxID_YES) {
-							if (pitchC > 1800)
-								stop->getInternalRank()->setPitchCorrection(1800);
-							else if (pitchC < -1800)
-								stop->getInternalRank()->setPitchCorrection(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportTrackerDelay()) {
-					stop->getInternalRank()->setTrackerDelay(s.attributes.trackerDelay);
-				}
-
-				// next deal with the pipes in the internal rank of the stop
-				for (CMB_PIPE &p : s.pipes) {
-					unsigned pipeIdx = p.pipeNbr - 1;
-					if (pipeIdx < stop->getInternalRank()->m_pipes.size()) {
-						Pipe *pipe = stop->getInternalRank()->getPipeAt(pipeIdx);
-
-						if (importCmb.GetImportAmplitude())
-							pipe->amplitudeLevel = p.attributes.amplitude;
-						if (importCmb.GetImportGain())
-							pipe->gain = p.attributes.gain;
-						if (importCmb.GetImportPitchTuning()) {
-							float pitchT = pipe->pitchTuning + p.attributes.pitchTuning;
-							if (pitchT >= -1800 && pitchT <= 1800) {
-								pipe->pitchTuning = pitchT;
-							}
-						}
-						if (importCmb.GetImportPitchCorrection()) {
-							float pitchC = pipe->pitchCorrection + p.attributes.pitchCorrection;
-							if (pitchC >= -1800 && pitchC <= 1800) {
-								pipe->pitchCorrection = pitchC;
-							}
-						}
-						if (importCmb.GetImportTrackerDelay()) {
-							pipe->trackerDelay = p.attributes.trackerDelay;
-						}
-					}
-				}
-			}
-			stopIdx++;
-		}
-
-		unsigned rankIdx = 0;
-		for (CMB_ELEMENT_WITH_PIPES &r : imported->cmbRanks) {
-			if (m_organ->getNumberOfRanks() > rankIdx) {
-				Rank *rank = m_organ->getOrganRankAt(rankIdx);
-
-				if (importCmb.GetImportAmplitude())
-					rank->setAmplitudeLevel(r.attributes.amplitude);
-				if (importCmb.GetImportGain())
-					rank->setGain(r.attributes.gain);
-				if (importCmb.GetImportPitchTuning()) {
-					float pitchT = rank->getPitchTuning() + r.attributes.pitchTuning;
-					if (pitchT >= -1800 && pitchT <= 1800) {
-						rank->setPitchTuning(pitchT);
-					} else {
-						wxMessageDialog pTerr(this, wxT("The PitchTuning value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pTerr.ShowModal() == wxID_YES) {
-							if (pitchT > 1800)
-								rank->setPitchTuning(1800);
-							else if (pitchT < -1800)
-								rank->setPitchTuning(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportPitchCorrection()) {
-					float pitchC = rank->getPitchCorrection() + r.attributes.pitchCorrection;
-					if (pitchC >= -1800 && pitchC <= 1800) {
-						rank->setPitchCorrection(pitchC);
-					} else {
-						wxMessageDialog pCerr(this, wxT("The PitchCorrection value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
-						if (pCerr.ShowModal() == wxID_YES) {
-							if (pitchC > 1800)
-								rank->setPitchCorrection(1800);
-							else if (pitchC < -1800)
-								rank->setPitchCorrection(-1800);
-						}
-					}
-				}
-				if (importCmb.GetImportTrackerDelay()) {
-					rank->setTrackerDelay(r.attributes.trackerDelay);
-				}
-
-				// next deal with the pipes in the rank
-				for (CMB_PIPE &p : r.pipes) {
-					unsigned pipeIdx = p.pipeNbr - 1;
-					if (pipeIdx < rank->m_pipes.size()) {
-						Pipe *pipe = rank->getPipeAt(pipeIdx);
-
-						if (importCmb.GetImportAmplitude())
-							pipe->amplitudeLevel = p.attributes.amplitude;
-						if (importCmb.GetImportGain())
-							pipe->gain = p.attributes.gain;
-						if (importCmb.GetImportPitchTuning()) {
-							float pitchT = pipe->pitchTuning + p.attributes.pitchTuning;
-							if (pitchT >= -1800 && pitchT <= 1800) {
-								pipe->pitchTuning = pitchT;
-							}
-						}
-						if (importCmb.GetImportPitchCorrection()) {
-							float pitchC = pipe->pitchCorrection + p.attributes.pitchCorrection;
-							if (pitchC >= -1800 && pitchC <= 1800) {
-								pipe->pitchCorrection = pitchC;
-							}
-						}
-						if (importCmb.GetImportTrackerDelay()) {
-							pipe->trackerDelay = p.attributes.trackerDelay;
-						}
-					}
-				}
-			}
-			rankIdx++;
-		}
+		CMB_IMPORT_OPTIONS options;
+		options.amplitude = importCmb.GetImportAmplitude();
+		options.gain = importCmb.GetImportGain();
+		options.pitchTuning = importCmb.GetImportPitchTuning();
+		options.pitchCorrection = importCmb.GetImportPitchCorrection();
+		options.trackerDelay = importCmb.GetImportTrackerDelay();
+		CmbVoicing::apply(imported, m_organ, options, [this](const wxString &attribute) {
+			wxMessageDialog err(this, wxT("The ") + attribute + wxT(" value would be out of bounds! Do you want to set it to max allowed value?"), wxT("Value is out of bounds!"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
+			return err.ShowModal() == wxID_YES;
+		});
 
 		// Update display in panels
 		m_organ->setModified(true);
@@ -3323,9 +3395,9 @@ void GOODFFrame::OnImportStopRank(wxCommandEvent& WXUNUSED(event)) {
 
 	Organ *sourceOrgan = new Organ();
 
-	OrganFileParser parser(organFilePath, sourceOrgan);
+	OrganFileParser parser(organFilePath, sourceOrgan, true);
 	if (parser.isOrganReady()) {
-		StopRankImportDialog importDialog(sourceOrgan, m_organ, this);
+		StopRankImportDialog importDialog(sourceOrgan, m_organ, &parser, this);
 		importDialog.ShowModal();
 
 	} else {
@@ -3341,7 +3413,321 @@ void GOODFFrame::OnImportLegacyXfadesMenu(wxCommandEvent& WXUNUSED(event)) {
 	if (dlg.ShowModal() != wxID_YES)
 		return;
 
-	m_organ->doInheritLegacyXfades();
+	UndoStep *undoStep = m_undoHistory->beginStep(m_organ, wxT("Import legacy x-fades"));
+	m_organ->doInheritLegacyXfades(undoStep);
+	m_undoHistory->commitStep(undoStep);
+}
+
+void GOODFFrame::OnUndo(wxCommandEvent& WXUNUSED(event)) {
+	// a text field with focus handles its own undo
+	wxTextCtrl *textCtrl = dynamic_cast<wxTextCtrl*>(wxWindow::FindFocus());
+	if (textCtrl && textCtrl->CanUndo()) {
+		textCtrl->Undo();
+		return;
+	}
+
+	if (m_undoHistory->undo())
+		RefreshAfterUndo();
+}
+
+void GOODFFrame::OnRedo(wxCommandEvent& WXUNUSED(event)) {
+	wxTextCtrl *textCtrl = dynamic_cast<wxTextCtrl*>(wxWindow::FindFocus());
+	if (textCtrl && textCtrl->CanRedo()) {
+		textCtrl->Redo();
+		return;
+	}
+
+	if (m_undoHistory->redo())
+		RefreshAfterUndo();
+}
+
+void GOODFFrame::OnUpdateUndo(wxUpdateUIEvent& event) {
+	wxTextCtrl *textCtrl = dynamic_cast<wxTextCtrl*>(wxWindow::FindFocus());
+	if (textCtrl && textCtrl->CanUndo()) {
+		event.Enable(true);
+		event.SetText(wxT("&Undo\tCtrl+Z"));
+	} else if (m_undoHistory->canUndo()) {
+		event.Enable(true);
+		event.SetText(wxT("&Undo ") + m_undoHistory->getUndoDescription() + wxT("\tCtrl+Z"));
+	} else {
+		event.Enable(false);
+		event.SetText(wxT("&Undo\tCtrl+Z"));
+	}
+}
+
+void GOODFFrame::OnUpdateRedo(wxUpdateUIEvent& event) {
+	wxTextCtrl *textCtrl = dynamic_cast<wxTextCtrl*>(wxWindow::FindFocus());
+	if (textCtrl && textCtrl->CanRedo()) {
+		event.Enable(true);
+		event.SetText(wxT("&Redo\tCtrl+Y"));
+	} else if (m_undoHistory->canRedo()) {
+		event.Enable(true);
+		event.SetText(wxT("&Redo ") + m_undoHistory->getRedoDescription() + wxT("\tCtrl+Y"));
+	} else {
+		event.Enable(false);
+		event.SetText(wxT("&Redo\tCtrl+Y"));
+	}
+}
+
+void GOODFFrame::RefreshAfterUndo() {
+	m_organ->setModified(true);
+	// the panel for the selected item is set up again to show the restored values
+	wxTreeItemId selected = m_organTreeCtrl->GetSelection();
+	if (selected.IsOk()) {
+		wxTreeEvent evt(wxEVT_TREE_SEL_CHANGED, m_organTreeCtrl, selected);
+		OnOrganTreeSelectionChanged(evt);
+		// a restored name of the shown stop or rank must show in the tree too
+		if (m_stopPanel->IsShown())
+			OrganTreeChildItemLabelChanged(m_stopPanel->getCurrentStop()->getName());
+		else if (m_rankPanel->IsShown())
+			OrganTreeChildItemLabelChanged(m_rankPanel->getCurrentRank()->getName());
+	}
+	m_panelPanel->updateRepresentationLayout();
+}
+
+void GOODFFrame::OnFindDuplicateSamples(wxCommandEvent& WXUNUSED(event)) {
+	DuplicateSamplesDialog dlg(m_organ, this);
+	if (dlg.ShowModal() == wxID_OK) {
+		if (dlg.ApplyRewrite() > 0) {
+			// Update display in panels
+			m_organ->setModified(true);
+			if (m_rankPanel->IsShown()) {
+				Rank *currentRank = m_rankPanel->getCurrentRank();
+				m_rankPanel->setRank(currentRank);
+			}
+			if (m_stopPanel->IsShown()) {
+				Stop *currentStop = m_stopPanel->getCurrentStop();
+				m_stopPanel->setStop(currentStop);
+			}
+		}
+	}
+}
+
+void GOODFFrame::OnOptimizePanelImages(wxCommandEvent& WXUNUSED(event)) {
+	ImageAssetsDialog dlg(m_organ, this);
+	if (dlg.ShowModal() == wxID_OK) {
+		// the panel of the selected element is set up again to show the new paths
+		if (dlg.ApplyRewrite() > 0)
+			RefreshAfterUndo();
+	}
+}
+
+void GOODFFrame::OnEstimateMemoryFootprint(wxCommandEvent& WXUNUSED(event)) {
+	MemoryFootprintDialog dlg(m_organ, m_memoryEstimator, this);
+	dlg.ShowModal();
+}
+
+void GOODFFrame::OnTranscodeSamples(wxCommandEvent& WXUNUSED(event)) {
+	SampleTranscodeDialog dlg(m_organ, this);
+	if (dlg.ShowModal() != wxID_OK)
+		return;
+
+	SampleTranscoder transcoder(m_organ, dlg.GetSelectedRanks(), dlg.GetOptions());
+	wxProgressDialog progress(
+		wxT("Transcoding samples"),
+		wxEmptyString,
+		100,
+		this,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	if (!transcoder.prepare(&progress))
+		return;
+	bool completed = transcoder.transcode(&progress);
+	progress.Hide();
+
+	// the files that were written before an abort are used too
+	unsigned nbrChanged = transcoder.applyToOrgan();
+	for (unsigned i = 0; i < transcoder.getNumberOfJobs(); i++) {
+		TRANSCODE_JOB *job = transcoder.getJobAt(i);
+		if (!job->isWritten && !job->error.IsEmpty())
+			wxLogWarning(wxT("%s %s"), job->sourcePath, job->error);
+	}
+	for (const wxString &skipped : transcoder.getSkippedFiles())
+		wxLogWarning(wxT("%s isn't an uncompressed pcm wav file and was left as it is"), skipped);
+	wxLogMessage(
+		wxT("%u sample files transcoded (%s instead of %s), %u attacks/releases changed%s."),
+		transcoder.getNumberOfWrittenFiles(),
+		wxFileName::GetHumanReadableSize(transcoder.getTargetBytes()),
+		wxFileName::GetHumanReadableSize(transcoder.getSourceBytes()),
+		nbrChanged,
+		completed ? wxT("") : wxT(" before the transcoding was cancelled")
+	);
+	m_logWindow->Show(true);
+	if (nbrChanged > 0) {
+		m_organ->setModified(true);
+		RefreshAfterUndo();
+	}
+}
+
+void GOODFFrame::OnRecordTraceMenu(wxCommandEvent& event) {
+	if (event.IsChecked()) {
+		TraceRecorder::setEnabled(true);
+		wxLogMessage(wxT("Recording of a performance trace started."));
+		return;
+	}
+
+	TraceRecorder::setEnabled(false);
+	wxLogMessage(wxT("Performance trace with %u events:\n%s"), TraceRecorder::getNumberOfEvents(), TraceRecorder::createSummary());
+	m_logWindow->Show(true);
+
+	wxFileDialog fileDialog(
+		this,
+		wxT("Save the trace (open it in chrome://tracing or Perfetto)"),
+		wxStandardPaths::Get().GetDocumentsDir(),
+		wxT("goodf-trace.json"),
+		wxT("Chrome trace files (*.json)|*.json"),
+		wxFD_SAVE|wxFD_OVERWRITE_PROMPT
+	);
+	if (fileDialog.ShowModal() != wxID_OK)
+		return;
+	if (!TraceRecorder::writeChromeTrace(fileDialog.GetPath())) {
+		wxLogError(wxT("The trace could not be written to %s"), fileDialog.GetPath());
+		m_logWindow->Show(true);
+	}
+}
+
+void GOODFFrame::OnValidateOrganMenu(wxCommandEvent& WXUNUSED(event)) {
+	if (!m_diagnosticsDialog)
+		m_diagnosticsDialog = new DiagnosticsDialog(this);
+	ValidateOrgan();
+	m_diagnosticsDialog->Show();
+	m_diagnosticsDialog->Raise();
+}
+
+void GOODFFrame::OnValidationTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (!m_diagnosticsDialog || !m_diagnosticsDialog->IsShown())
+		return;
+	if (m_organ->getModificationCount() == m_lastValidatedModification)
+		return;
+	ValidateOrgan();
+}
+
+void GOODFFrame::ValidateOrgan(bool checkAll) {
+	if (checkAll)
+		m_validator->markAllDirty();
+	if (checkAll || !m_validator->hasResultsFor(m_organ)) {
+		// everything is checked and sample files are read, after that only changes
+		wxProgressDialog progress(
+			wxT("Validating the organ"),
+			wxEmptyString,
+			100,
+			this,
+			wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+		);
+		m_validator->validate(m_organ, &progress);
+	} else {
+		m_validator->validate(m_organ);
+	}
+	m_lastValidatedModification = m_organ->getModificationCount();
+	if (m_diagnosticsDialog)
+		m_diagnosticsDialog->UpdateDiagnostics(m_organ, m_validator);
+}
+
+void GOODFFrame::SelectValidationSubject(const VALIDATION_DIAGNOSTIC &diagnostic) {
+	wxTreeItemId item;
+	switch (diagnostic.kind) {
+		case VALIDATE_RANK:
+			item = GetNthTreeChild(tree_ranks, diagnostic.subjectIndex);
+			break;
+		case VALIDATE_STOP:
+			if (diagnostic.subjectIndex < m_organ->getNumberOfStops()) {
+				// stops are found under Stops of their manual in the tree
+				Stop *stop = m_organ->getOrganStopAt(diagnostic.subjectIndex);
+				Manual *manual = stop->getOwningManual();
+				for (unsigned i = 0; i < m_organ->getNumberOfManuals(); i++) {
+					if (m_organ->getOrganManualAt(i) == manual) {
+						wxTreeItemId manualStops = GetNthTreeChild(GetNthTreeChild(tree_manuals, i), 0);
+						item = GetNthTreeChild(manualStops, manual->getIndexOfStop(stop));
+						break;
+					}
+				}
+			}
+			break;
+		case VALIDATE_SWITCH:
+			item = GetNthTreeChild(tree_switches, diagnostic.subjectIndex);
+			break;
+		case VALIDATE_PANEL:
+			item = GetNthTreeChild(tree_panels, diagnostic.subjectIndex);
+			if (item.IsOk() && diagnostic.detailIndex >= 0)
+				item = GetNthTreeChild(m_organTreeCtrl->GetLastChild(item), diagnostic.detailIndex);
+			break;
+		default:
+			break;
+	}
+	if (item.IsOk()) {
+		m_organTreeCtrl->EnsureVisible(item);
+		m_organTreeCtrl->SelectItem(item);
+		Raise();
+	}
+}
+
+wxTreeItemId GOODFFrame::GetNthTreeChild(wxTreeItemId parent, int n) {
+	if (!parent.IsOk() || n < 0)
+		return wxTreeItemId();
+	wxTreeItemIdValue cookie;
+	wxTreeItemId child = m_organTreeCtrl->GetFirstChild(parent, cookie);
+	for (int i = 0; i < n && child.IsOk(); i++)
+		child = m_organTreeCtrl->GetNextChild(parent, cookie);
+	return child;
+}
+
+PanelThumbnailCache* GOODFFrame::GetPanelThumbnails() {
+	return m_panelThumbnails;
+}
+
+void GOODFFrame::OnPanelThumbnailReady(wxThreadEvent& WXUNUSED(event)) {
+	if (!m_panelThumbnails)
+		return;
+	m_panelThumbnails->collectFinished();
+	if (m_hoveredPanel)
+		ShowHoveredPanelThumbnail();
+}
+
+void GOODFFrame::OnPanelThumbnailTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (m_panelThumbnails)
+		m_panelThumbnails->renderNext();
+}
+
+void GOODFFrame::OnOrganTreeMouseLeave(wxMouseEvent& event) {
+	m_hoveredPanel = NULL;
+	m_thumbnailPopup->Hide();
+	event.Skip();
+}
+
+void GOODFFrame::UpdateHoveredPanel(wxMouseEvent& event) {
+	// motion over the splitter and the panel around the tree is also sent here
+	GoPanel *hovered = NULL;
+	if (!event.Dragging() && event.GetEventObject() == m_organTreeCtrl) {
+		wxTreeItemId item = m_organTreeCtrl->HitTest(event.GetPosition());
+		if (item.IsOk() && m_organTreeCtrl->GetItemParent(item) == tree_panels) {
+			wxTreeItemIdValue cookie;
+			wxTreeItemId child = m_organTreeCtrl->GetFirstChild(tree_panels, cookie);
+			for (unsigned i = 0; child.IsOk() && i < m_organ->getNumberOfPanels(); i++) {
+				if (child == item) {
+					hovered = m_organ->getOrganPanelAt(i);
+					break;
+				}
+				child = m_organTreeCtrl->GetNextChild(tree_panels, cookie);
+			}
+		}
+	}
+
+	m_hoveredPanel = hovered;
+	if (m_hoveredPanel) {
+		m_hoverScreenPos = m_organTreeCtrl->ClientToScreen(event.GetPosition());
+		ShowHoveredPanelThumbnail();
+	} else {
+		m_thumbnailPopup->Hide();
+	}
+}
+
+void GOODFFrame::ShowHoveredPanelThumbnail() {
+	// nothing is shown until the first thumbnail of the panel is done
+	wxBitmap thumbnail;
+	if (m_panelThumbnails->getThumbnail(m_hoveredPanel, thumbnail))
+		m_thumbnailPopup->ShowThumbnail(thumbnail, m_hoveredPanel->getName(), m_hoverScreenPos);
+	else
+		m_thumbnailPopup->Hide();
 }
 
 void GOODFFrame::SetupOrganMainPanel() {
@@ -3444,6 +3830,14 @@ wxLogWindow* GOODFFrame::GetLogWindow() {
 }
 
 void GOODFFrame::removeAllItemsFromTree() {
+	m_undoHistory->clear();
+	m_validator->clear();
+	m_memoryEstimator->clear();
+	m_panelThumbnails->clear();
+	m_hoveredPanel = NULL;
+	m_thumbnailPopup->Hide();
+	if (m_diagnosticsDialog)
+		m_diagnosticsDialog->UpdateDiagnostics(m_organ, m_validator);
 	m_organTreeCtrl->DeleteChildren(tree_manuals);
 	m_organTreeCtrl->DeleteChildren(tree_windchestgrps);
 	m_organTreeCtrl->DeleteChildren(tree_enclosures);
@@ -3474,10 +3868,13 @@ void GOODFFrame::RecreateLogWindow() {
 }
 
 void GOODFFrame::SetImportXfadeMenuItemState() {
-	if (!m_organ->getNumberOfRanks() && !m_organ->getNumberOfStops())
+	if (!m_organ->getNumberOfRanks() && !m_organ->getNumberOfStops()) {
 		m_toolsMenu->Enable(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, false);
-	else
+		m_toolsMenu->Enable(ID_FIND_DUPLICATE_SAMPLES, false);
+	} else {
 		m_toolsMenu->Enable(ID_GLOBAL_PARSE_LEGACY_XFADES_OPTION, true);
+		m_toolsMenu->Enable(ID_FIND_DUPLICATE_SAMPLES, true);
+	}
 }
 
 void GOODFFrame::FixAnyIllegalEntries() {
@@ -29,6 +29,7 @@
 #include <wx/spinctrl.h>
 #include <wx/filehistory.h>
 #include <wx/fileconf.h>
+#include <wx/timer.h>
 #include "EnclosurePanel.h"
 #include "TremulantPanel.h"
 #include "WindchestgroupPanel.h"
@@ -48,6 +49,14 @@
 #include "GUIEnclosurePanel.h"
 #include "GUILabelPanel.h"
 #include "GUIManualPanel.h"
+#include "UndoHistory.h"
+#include "OdfWriter.h"
+#include "OrganValidator.h"
+#include "MemoryFootprintEstimator.h"
+#include "PanelThumbnailCache.h"
+
+class DiagnosticsDialog;
+class PanelThumbnailPopup;
 
 class GOODFFrame : public wxFrame {
 public:
@@ -59,8 +68,10 @@ public:
 	void OnAbout(wxCommandEvent& event);
 	void OnHelp(wxCommandEvent& event);
 	void OnWriteODF(wxCommandEvent& event);
+	void OnExportOrganPackage(wxCommandEvent& event);
 	void OnReadOrganFile(wxCommandEvent& event);
 	void DoOpenOrgan(wxString filePath);
+	void CheckForRecoveryFile();
 
 	void OrganTreeChildItemLabelChanged(wxString label);
 	void RemoveCurrentItemFromOrgan();
@@ -81,13 +92,19 @@ public:
 	wxString GetDefaultOrganDirectory();
 	wxString GetDefaultCmbDirectory();
 	wxLogWindow* GetLogWindow();
+	// checks the elements changed since the last validation, or all of them
+	void ValidateOrgan(bool checkAll = false);
+	void SelectValidationSubject(const VALIDATION_DIAGNOSTIC &diagnostic);
+	PanelThumbnailCache* GetPanelThumbnails();
 
 	Organ *m_organ;
+	UndoHistory *m_undoHistory;
 
 private:
 	DECLARE_EVENT_TABLE()
 
 	wxMenu *m_fileMenu;
+	wxMenu *m_editMenu;
 	wxMenu *m_recentMenu;
 	wxMenu *m_toolsMenu;
 	wxMenu *m_helpMenu;
@@ -152,6 +169,23 @@ private:
 	bool m_organHasBeenSaved;
 	bool m_enableTooltips;
 	wxFileHistory *m_recentlyUsed;
+	OdfWriter *m_odfWriter;
+	wxTimer *m_autosaveTimer;
+	int m_autosaveMinutes;
+	wxLongLong m_lastAutosaveTime;
+	long m_lastAutosavedModification;
+	long m_recoveryDiscardedAt;
+	OrganValidator *m_validator;
+	MemoryFootprintEstimator *m_memoryEstimator;
+	DiagnosticsDialog *m_diagnosticsDialog;
+	wxTimer *m_validationTimer;
+	long m_lastValidatedModification;
+	PanelThumbnailCache *m_panelThumbnails;
+	PanelThumbnailPopup *m_thumbnailPopup;
+	GoPanel *m_hoveredPanel;
+	wxPoint m_hoverScreenPos;
+	wxString m_recoveryFile;
+	bool m_notifyWhenWritten;
 	wxFileConfig *m_config;
 	int m_xPosition;
 	int m_yPosition;
@@ -166,6 +200,7 @@ private:
 	void OnOrganTreeLeftDrag(wxTreeEvent& event);
 	void OnOrganTreeDragCompleted(wxTreeEvent& event);
 	void OnOrganTreeMouseMotion(wxMouseEvent& event);
+	void OnOrganTreeMouseLeave(wxMouseEvent& event);
 	void OnAddNewEnclosure(wxCommandEvent& event);
 	void OnAddNewTremulant(wxCommandEvent& event);
 	void OnAddNewWindchestgroup(wxCommandEvent& event);
@@ -185,6 +220,28 @@ private:
 	void OnDefaultPathMenuChoice(wxCommandEvent& event);
 	void OnImportStopRank(wxCommandEvent& event);
 	void OnImportLegacyXfadesMenu(wxCommandEvent& event);
+	void OnFindDuplicateSamples(wxCommandEvent& event);
+	void OnOptimizePanelImages(wxCommandEvent& event);
+	void OnEstimateMemoryFootprint(wxCommandEvent& event);
+	void OnTranscodeSamples(wxCommandEvent& event);
+	void OnRecordTraceMenu(wxCommandEvent& event);
+	void OnUndo(wxCommandEvent& event);
+	void OnRedo(wxCommandEvent& event);
+	void OnUpdateUndo(wxUpdateUIEvent& event);
+	void OnUpdateRedo(wxUpdateUIEvent& event);
+	void RefreshAfterUndo();
+	void OnOdfWritten(wxThreadEvent& event);
+	void OnAutosaveWritten(wxThreadEvent& event);
+	void OnAutosaveTimer(wxTimerEvent& event);
+	void OnValidateOrganMenu(wxCommandEvent& event);
+	void OnValidationTimer(wxTimerEvent& event);
+	void OnPanelThumbnailReady(wxThreadEvent& event);
+	void OnPanelThumbnailTimer(wxTimerEvent& event);
+	void UpdateHoveredPanel(wxMouseEvent& event);
+	void ShowHoveredPanelThumbnail();
+	wxTreeItemId GetNthTreeChild(wxTreeItemId parent, int n);
+	wxString GetRecoveryFilePath();
+	void DiscardRecoveryFile(long upToModification);
 
 	void SetupOrganMainPanel();
 	void removeAllItemsFromTree();
@@ -26,6 +26,9 @@
 #include <wx/filename.h>
 #include <vector>
 #include "GOODF.h"
+#include "FileExistenceCache.h"
+#include "PathRebaser.h"
+#include "TraceRecorder.h"
 
 class Organ;
 
@@ -67,9 +70,17 @@ namespace GOODF_functions {
 	}
 
 	inline wxString removeBaseOdfPath(wxString path) {
+		FileExistenceCache *cache = FileExistenceCache::getActive();
+		PathRebaser *rebaser = PathRebaser::getActive();
+		if (rebaser) {
+			// without a cache an active rebaser doesn't check for existence at all
+			if (cache && !cache->fileExists(path))
+				return path;
+			return rebaser->makeRelative(path);
+		}
 		wxString stringToReturn = path;
 		wxFileName fName = wxFileName(path);
-		if (fName.FileExists()) {
+		if (cache ? cache->fileExists(path) : fName.FileExists()) {
 			fName.MakeRelativeTo(::wxGetApp().m_frame->m_organ->getOdfRoot());
 			stringToReturn = fName.GetFullPath();
 			if (stringToReturn.StartsWith(wxFILE_SEP_PATH))
@@ -82,10 +93,19 @@ namespace GOODF_functions {
 
 	inline wxString checkIfFileExist(wxString relativePath, Organ *currentOrgan) {
 		if (relativePath != wxEmptyString && !relativePath.IsSameAs("DUMMY") && !relativePath.StartsWith("REF:")) {  // don't need to check special "DUMMY" or "REF:" filenames
+			TraceScope trace("checkIfFileExist");
 			if (relativePath.StartsWith(wxT("./")) || relativePath.StartsWith(wxT(".\\")))
 				relativePath.erase(0, 2);
 			wxString fullFilePath = currentOrgan->getOdfRoot() + wxFILE_SEP_PATH + relativePath;
 			wxFileName theFile = wxFileName(fullFilePath, wxPATH_DOS);
+			FileExistenceCache *cache = FileExistenceCache::getActive();
+			if (cache) {
+				// the missing files are reported together when the cache owner is done
+				wxString existingPath = cache->resolveFile(theFile.GetFullPath());
+				if (existingPath == wxEmptyString)
+					cache->addMissingFile(relativePath);
+				return existingPath;
+			}
 			if (theFile.FileExists()) {
 				return theFile.GetFullPath();
 			}
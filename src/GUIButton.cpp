@@ -21,6 +21,7 @@
 #include "GUIButton.h"
 #include "GOODFFunctions.h"
 #include "GOODF.h"
+#include "DecodedImageCache.h"
 #include <algorithm>
 
 GUIButton::GUIButton() : GUIElement() {
@@ -328,9 +329,9 @@ wxBitmap GUIButton::getBitmap() {
 			return ::wxGetApp().m_drawstopBitmaps[m_dispImageNum - 1];
 		}
 	} else {
-		wxImage img(m_imageOff);
+		wxImage img = DecodedImageCache::getImage(m_imageOff);
 		if (img.IsOk()) {
-			wxBitmap bmp(m_imageOff, img.GetType());
+			wxBitmap bmp(img);
 			return bmp;
 		} else {
 			return wxNullBitmap;
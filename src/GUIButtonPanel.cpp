@@ -715,6 +715,7 @@ GUIButtonPanel::~GUIButtonPanel() {
 
 void GUIButtonPanel::setButton(GUIButton *button) {
 	m_button = button;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_button);
 	m_labelTextField->ChangeValue(m_button->getDispLabelText());
 	m_labelFont->SetFont(m_button->getDispLabelFont());
 	m_labelFont->SetLabel(m_button->getDispLabelFont().GetFaceName() + wxString::Format(wxT(" %i"), m_button->getDispLabelFontSize()->getSizeValue()));
@@ -882,6 +883,8 @@ void GUIButtonPanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	wxString content = m_labelTextField->GetValue();
 	GOODF_functions::CheckForStartingWhitespace(&content, m_labelTextField);
 	m_button->setDispLabelText(m_labelTextField->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -918,6 +921,9 @@ void GUIButtonPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
 		}
 	}
 
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
+
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -929,6 +935,8 @@ void GUIButtonPanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_button->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_button->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
+			m_button->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -937,6 +945,8 @@ void GUIButtonPanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUIButtonPanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUIBUTTONPANEL_COLOR_PICKER) {
 		m_button->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
+		m_button->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 	}
 }
@@ -968,6 +978,8 @@ void GUIButtonPanel::OnDisplayAsPistonRadio(wxCommandEvent& event) {
 		UpdateSpinRanges();
 		UpdateDefaultSpinValues();
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -979,22 +991,30 @@ void GUIButtonPanel::OnDisplayKeyLabelLeftRadio(wxCommandEvent& event) {
 		m_displayKeyLabelLeftNo->SetValue(true);
 		m_button->setDispKeyLabelOnLeft(false);
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_button->setDispImageNum(m_dispImageNbrBox->GetSelection() + 1);
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnButtonRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	int rowValue = m_buttonRowSpin->GetValue();
 	m_button->setDispButtonRow(rowValue);
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnButtonColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setDispButtonCol(m_buttonColSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1007,11 +1027,15 @@ void GUIButtonPanel::OnDrawstopRowSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_drawstopColSpin->SetRange(1, m_button->getOwningPanel()->getDisplayMetrics()->m_dispExtraDrawstopCols);
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setDispDrawstopCol(m_drawstopColSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1072,6 +1096,8 @@ void GUIButtonPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1087,6 +1113,8 @@ void GUIButtonPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 				wxString relativePath = GOODF_functions::removeBaseOdfPath(m_button->getImageOff());
 				m_imageOffPathField->SetValue(relativePath);
 				m_addMaskOffBtn->Enable();
+				m_button->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 			} else {
 				wxMessageDialog msg(this, wxT("Image off bitmap size must match on bitmap!"), wxT("Wrong bitmap size"), wxOK|wxCENTRE|wxICON_ERROR);
@@ -1104,6 +1132,8 @@ void GUIButtonPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 				m_imageOffPathField->SetValue(wxEmptyString);
 				m_maskOffPathField->SetValue(wxEmptyString);
 				m_addMaskOffBtn->Disable();
+				m_button->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 			}
 		}
@@ -1134,6 +1164,8 @@ void GUIButtonPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1161,6 +1193,8 @@ void GUIButtonPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1168,6 +1202,8 @@ void GUIButtonPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setWidth(m_widthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1175,16 +1211,22 @@ void GUIButtonPanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setHeight(m_heightSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTileOffsetX(m_tileOffsetXSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTileOffsetY(m_tileOffsetYSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1192,6 +1234,8 @@ void GUIButtonPanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectLeft(m_mouseRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1199,21 +1243,29 @@ void GUIButtonPanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectTop(m_mouseRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIButtonPanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectWidth(m_mouseRectWidthSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIButtonPanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRectHeight(m_mouseRectHeightSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIButtonPanel::OnMouseRadiusSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setMouseRadius(m_mouseRadiusSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1221,6 +1273,8 @@ void GUIButtonPanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1228,6 +1282,8 @@ void GUIButtonPanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1235,16 +1291,22 @@ void GUIButtonPanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextRectHeight(m_textRectHeightSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIButtonPanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_button->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1279,6 +1341,8 @@ void GUIButtonPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_drawstopColSpin->Enable();
 		}
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1313,6 +1377,8 @@ void GUIButtonPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_drawstopColSpin->Enable();
 		}
 	}
+	m_button->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_button);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1327,6 +1393,7 @@ void GUIButtonPanel::OnRemoveButtonBtn(wxCommandEvent& WXUNUSED(event)) {
 	} else {
 		::wxGetApp().m_frame->RemoveCurrentItemFromOrgan();
 	}
+	m_button->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -19,6 +19,7 @@
  */
 
 #include "GUIElements.h"
+#include "GoPanel.h"
 
 GUIElement::GUIElement() {
 	m_owningPanel = NULL;
@@ -74,6 +75,7 @@ int GUIElement::getPosX() {
 
 void GUIElement::setPosX(int x) {
 	m_positionX = x;
+	markChanged();
 }
 
 int GUIElement::getPosY() {
@@ -82,6 +84,7 @@ int GUIElement::getPosY() {
 
 void GUIElement::setPosY(int y) {
 	m_positionY = y;
+	markChanged();
 }
 
 void GUIElement::setOwningPanel(GoPanel *panel) {
@@ -92,8 +95,14 @@ GoPanel* GUIElement::getOwningPanel() {
 	return m_owningPanel;
 }
 
+void GUIElement::markChanged() {
+	if (m_owningPanel)
+		m_owningPanel->markChanged();
+}
+
 void GUIElement::setDisplayName(wxString name) {
 	m_displayName = name;
+	markChanged();
 }
 
 wxString GUIElement::getDisplayName() {
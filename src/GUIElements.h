@@ -52,6 +52,8 @@ public:
 	void setPosY(int y);
 	void setOwningPanel(GoPanel *panel);
 	GoPanel* getOwningPanel();
+	// the owning panel keeps track of changes of its elements
+	void markChanged();
 	void setDisplayName(wxString name);
 	wxString getDisplayName();
 
@@ -593,6 +593,7 @@ GUIEnclosurePanel::~GUIEnclosurePanel() {
 
 void GUIEnclosurePanel::GUIEnclosurePanel::setEnclosure(GUIEnclosure *enclosure) {
 	m_enclosure = enclosure;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_enclosure);
 	m_labelTextField->ChangeValue(m_enclosure->getDispLabelText());
 	m_labelFont->SetSelectedFont(m_enclosure->getDispLabelFont());
 	if (m_enclosure->getDispLabelColour()->getSelectedColorIndex() == 0) {
@@ -721,12 +722,16 @@ void GUIEnclosurePanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	wxString content = m_labelTextField->GetValue();
 	GOODF_functions::CheckForStartingWhitespace(&content, m_labelTextField);
 	m_enclosure->setDispLabelText(m_labelTextField->GetValue());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIEnclosurePanel::OnLabelFontChange(wxFontPickerEvent& WXUNUSED(event)) {
 	m_enclosure->setDispLabelFont(m_labelFont->GetSelectedFont());
 	m_enclosure->setDispLabelFontSize(m_labelFont->GetSelectedFont().GetPointSize());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -738,6 +743,8 @@ void GUIEnclosurePanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_enclosure->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_enclosure->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
+			m_enclosure->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -746,6 +753,8 @@ void GUIEnclosurePanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUIEnclosurePanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUIENCLOSUREPANEL_COLOR_PICKER) {
 		m_enclosure->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
+		m_enclosure->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 	}
 }
@@ -754,6 +763,8 @@ void GUIEnclosurePanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	// a value of -1 indicate that default display metric positioning is used
 	int value = m_elementPosXSpin->GetValue();
 	m_enclosure->setPosX(value);
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -761,11 +772,15 @@ void GUIEnclosurePanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	// a value of -1 indicate that default display metric positioning is used
 	int value = m_elementPosYSpin->GetValue();
 	m_enclosure->setPosY(value);
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIEnclosurePanel::OnEnclosureStyleChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_enclosure->setEnclosureStyle(m_enclosureStyleBox->GetSelection() + 1);
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -795,6 +810,8 @@ void GUIEnclosurePanel::OnAddBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 	// we need to notify the bitmapBox that selection has changed
 	wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 	wxPostEvent(this, evt);
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -821,6 +838,8 @@ void GUIEnclosurePanel::OnAddImagePathBtn(wxCommandEvent& WXUNUSED(event)) {
 				UpdateSpinRanges();
 				UpdateDefaultSpinValues();
 				m_imagePathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getRelativeImagePath());
+				m_enclosure->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 			} else {
 				if (width == m_enclosure->getBitmapWidth() && height == m_enclosure->getBitmapHeight()) {
@@ -853,6 +872,8 @@ void GUIEnclosurePanel::OnAddMaskPathBtn(wxCommandEvent& WXUNUSED(event)) {
 			if (width == m_enclosure->getBitmapWidth() && height == m_enclosure->getBitmapHeight()) {
 				m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->setMask(path);
 				m_maskPathField->SetValue(m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->getMaskNameOnly());
+				m_enclosure->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 				::wxGetApp().m_frame->m_organ->setModified(true);
 			}
 		}
@@ -864,6 +885,8 @@ void GUIEnclosurePanel::OnAddMaskPathBtn(wxCommandEvent& WXUNUSED(event)) {
 				// then we empty the value in button and panel
 				m_enclosure->getBitmapAtIndex(m_bitmapBox->GetSelection())->setMask(wxEmptyString);
 				m_maskPathField->SetValue(wxEmptyString);
+				m_enclosure->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 				::wxGetApp().m_frame->m_organ->setModified(true);
 			}
 		}
@@ -888,6 +911,8 @@ void GUIEnclosurePanel::OnRemoveBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 			// then we notify the box that selection has changed
 			wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 			wxPostEvent(this, evt);
+			m_enclosure->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		} else {
 			m_removeBitmapBtn->Disable();
@@ -896,6 +921,8 @@ void GUIEnclosurePanel::OnRemoveBitmapBtn(wxCommandEvent& WXUNUSED(event)) {
 			UpdateBuiltinBitmapValues();
 			UpdateSpinRanges();
 			UpdateDefaultSpinValues();
+			m_enclosure->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -950,6 +977,8 @@ void GUIEnclosurePanel::OnAddImageBitmapsBtn(wxCommandEvent& WXUNUSED(event)) {
 			// we need to notify the bitmapBox that selection has changed
 			wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIENCLOSUREPANEL_BITMAP_BOX);
 			wxPostEvent(this, evt);
+			m_enclosure->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -958,86 +987,116 @@ void GUIEnclosurePanel::OnAddImageBitmapsBtn(wxCommandEvent& WXUNUSED(event)) {
 void GUIEnclosurePanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setWidth(m_widthSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setHeight(m_heightSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTileOffsetX(m_tileOffsetXSpin->GetValue());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTileOffsetY(m_tileOffsetYSpin->GetValue());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectLeft(m_mouseRectLeftSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectTop(m_mouseRectTopSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectWidth(m_mouseRectWidthSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseRectHeight(m_mouseRectHeightSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseAxisStartSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseAxisStart(m_mouseAxisStartSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnMouseAxisEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setMouseAxisEnd(m_mouseAxisEndSpin->GetValue());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextRectHeight(m_textRectHeightSpin->GetValue());
 	UpdateSpinRanges();
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIEnclosurePanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_enclosure->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
+	m_enclosure->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_enclosure);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1052,6 +1111,7 @@ void GUIEnclosurePanel::OnRemoveEnclosureBtn(wxCommandEvent& WXUNUSED(event)) {
 	} else {
 		::wxGetApp().m_frame->RemoveCurrentItemFromOrgan();
 	}
+	m_enclosure->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
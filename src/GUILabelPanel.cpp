@@ -601,6 +601,7 @@ GUILabelPanel::~GUILabelPanel() {
 
 void GUILabelPanel::setLabel(GUILabel *label) {
 	m_label = label;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_label);
 	m_labelTextField->ChangeValue(m_label->getName());
 	if (m_label->getType().IsSameAs(wxT("Label")))
 		m_labelTextField->Enable();
@@ -770,6 +771,8 @@ void GUILabelPanel::OnLabelTextChange(wxCommandEvent& WXUNUSED(event)) {
 	m_label->setName(m_labelTextField->GetValue());
 	m_label->updateDisplayName();
 	::wxGetApp().m_frame->OrganTreeChildItemLabelChanged(m_label->getDisplayName());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -806,6 +809,9 @@ void GUILabelPanel::OnLabelFontChange(wxCommandEvent& WXUNUSED(event)) {
 		}
 	}
 
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
+
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -817,6 +823,8 @@ void GUILabelPanel::OnLabelColourChoice(wxCommandEvent& event) {
 			m_label->getDispLabelColour()->setSelectedColorIndex(m_labelColourChoice->GetSelection());
 			m_labelColourPick->SetColour(m_label->getDispLabelColour()->getColor());
 			m_labelColourPick->Disable();
+			m_label->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 			::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 		}
 	}
@@ -825,6 +833,8 @@ void GUILabelPanel::OnLabelColourChoice(wxCommandEvent& event) {
 void GUILabelPanel::OnLabelColourPick(wxColourPickerEvent& event) {
 	if (event.GetId() == ID_GUILABELPANEL_COLOR_PICKER) {
 		m_label->getDispLabelColour()->setColorValue(m_labelColourPick->GetColour());
+		m_label->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 		::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 	}
 }
@@ -847,6 +857,8 @@ void GUILabelPanel::OnFreeXposRadio(wxCommandEvent& event) {
 		m_spanDrawstopColToRightNo->Enable();
 		m_drawstopColSpin->Enable();
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -866,6 +878,8 @@ void GUILabelPanel::OnFreeYposRadio(wxCommandEvent& event) {
 		m_atTopOfDrawstopColYes->Enable();
 		m_atTopOfDrawstopColNo->Enable();
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -875,11 +889,15 @@ void GUILabelPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	UpdateDefaultImageValues();
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnDrawstopColSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispDrawstopCol(m_drawstopColSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -889,6 +907,8 @@ void GUILabelPanel::OnAtTopOfDrawstopColRadio(wxCommandEvent& event) {
 	} else {
 		m_label->setDispAtTopOfDrawstopCol(false);
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -898,6 +918,8 @@ void GUILabelPanel::OnSpanDrawstopColRightRadio(wxCommandEvent& event) {
 	} else {
 		m_label->setDispSpanDrawstopColToRight(false);
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -943,6 +965,8 @@ void GUILabelPanel::OnAddImageBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -969,6 +993,8 @@ void GUILabelPanel::OnAddMaskBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -977,6 +1003,8 @@ void GUILabelPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setWidth(value);
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -985,16 +1013,22 @@ void GUILabelPanel::OnHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setHeight(value);
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnTileOffsetXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTileOffsetX(m_tileOffsetXSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnTileOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTileOffsetY(m_tileOffsetYSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1002,6 +1036,8 @@ void GUILabelPanel::OnTextRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectLeft(m_textRectLeftSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1009,6 +1045,8 @@ void GUILabelPanel::OnTextRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectTop(m_textRectTopSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1016,16 +1054,22 @@ void GUILabelPanel::OnTextRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectWidth(m_textRectWidthSpin->GetValue());
 	UpdateSpinRanges();
 	UpdateDefaultSpinValues();
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnTextRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextRectHeight(m_textRectHeightSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnTextBreakWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setTextBreakWidth(m_textBreakWidthSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1039,6 +1083,8 @@ void GUILabelPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_dispXposSpin->Enable();
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1052,16 +1098,22 @@ void GUILabelPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	} else {
 		m_dispYposSpin->Enable();
 	}
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnDispXposSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispXpos(m_dispXposSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUILabelPanel::OnDispYposSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_label->setDispYpos(m_dispYposSpin->GetValue());
+	m_label->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_label);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1076,6 +1128,7 @@ void GUILabelPanel::OnRemoveLabelBtn(wxCommandEvent& WXUNUSED(event)) {
 	} else {
 		::wxGetApp().m_frame->RemoveCurrentItemFromOrgan();
 	}
+	m_label->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -21,6 +21,7 @@
 #include "GUIManual.h"
 #include "GOODFFunctions.h"
 #include "GOODF.h"
+#include "TraceRecorder.h"
 
 GUIManual::GUIManual(Manual *manual) : GUIElement(), m_manual(manual) {
 	m_type = wxT("Manual");
@@ -34,7 +35,7 @@ GUIManual::GUIManual(Manual *manual) : GUIElement(), m_manual(manual) {
 	populateKeyTypes();
 	populateKeyNumbers();
 	setupDefaultDisplayKeys();
-	updateKeyInfo();
+	m_keyInfoIsDirty = true;
 }
 
 GUIManual::~GUIManual() {
@@ -368,7 +369,7 @@ void GUIManual::read(wxFileConfig *cfg, Organ *readOrgan) {
 		setDispImageNum(dispImageNum);
 	}
 
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 GUIManual* GUIManual::clone() {
@@ -456,7 +457,7 @@ void GUIManual::addKeytype(wxString identifier, bool isReading) {
 	m_keytypes.push_back(type);
 
 	if (!isReading)
-		updateKeyInfo();
+		invalidateKeyInfo();
 }
 
 unsigned GUIManual::getNumberOfKeytypes() {
@@ -473,7 +474,7 @@ void GUIManual::removeKeytypeAt(unsigned index) {
 	std::advance(it, index);
 	m_keytypes.erase(it);
 
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 const wxArrayString& GUIManual::getAvailableKeytypes() {
@@ -490,7 +491,7 @@ bool GUIManual::getDispKeyColourInverted() {
 
 void GUIManual::setDispKeyColourInverted(bool inverted) {
 	m_dispKeyColourInverted = inverted;
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 bool GUIManual::getDispKeyColourWooden() {
@@ -499,7 +500,7 @@ bool GUIManual::getDispKeyColourWooden() {
 
 void GUIManual::setDispKeyColurWooden(bool wooden) {
 	m_dispKeyColourWooden = wooden;
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 int GUIManual::getDisplayFirstNote() {
@@ -511,7 +512,7 @@ void GUIManual::setDisplayFirstNote(int first) {
 	populateKeyNumbers();
 	setupDefaultDisplayKeys();
 	validateKeyTypes();
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 int GUIManual::getNumberOfDisplayKeys() {
@@ -526,7 +527,7 @@ void GUIManual::setNumberOfDisplayKeys(int nbr) {
 	populateKeyNumbers();
 	setupDefaultDisplayKeys();
 	validateKeyTypes();
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 std::pair<int, int>* GUIManual::getDisplayKeyAt(unsigned index) {
@@ -704,10 +705,43 @@ int GUIManual::getDispImageNum() {
 
 void GUIManual::setDispImageNum(int nbr) {
 	m_dispImageNum = nbr;
-	updateKeyInfo();
+	invalidateKeyInfo();
+}
+
+void GUIManual::invalidateKeyInfo() {
+	// the layout is recomputed once when the key info is next requested
+	m_keyInfoIsDirty = true;
+}
+
+wxBitmap GUIManual::getKeytypeBitmap(KEYTYPE *key, std::map<wxString, wxBitmap> &resolved) {
+	wxString cacheKey = key->ImageOff.getImage() + wxT("|") + key->ImageOff.getMask();
+	auto found = resolved.find(cacheKey);
+	if (found != resolved.end())
+		return found->second;
+
+	// bitmaps already decoded by an earlier layout pass are reused
+	wxBitmap bmp;
+	auto cached = m_keyImageCache.find(cacheKey);
+	if (cached != m_keyImageCache.end())
+		bmp = cached->second;
+	else
+		bmp = key->ImageOff.getBitmap();
+	resolved[cacheKey] = bmp;
+	return bmp;
 }
 
 void GUIManual::updateKeyInfo() {
+	TraceScope trace("GUIManual::updateKeyInfo");
+	m_keyInfoIsDirty = false;
+
+	// key types are looked up by identifier and their images resolved only once per pass
+	std::map<wxString, KEYTYPE*> keytypesById;
+	for (KEYTYPE& key : m_keytypes) {
+		if (keytypesById.find(key.KeytypeIdentifier) == keytypesById.end())
+			keytypesById[key.KeytypeIdentifier] = &key;
+	}
+	std::map<wxString, wxBitmap> resolvedImages;
+
 	int keyXpos = 0;
 	m_keys.resize(m_displayKeys);
 	for (int i = 0; i < (int) m_keys.size(); i++) {
@@ -962,52 +996,50 @@ void GUIManual::updateKeyInfo() {
 		else if (i + 1 == m_displayKeys)
 			typeName = wxT("Last") + typeName;
 
-		for (KEYTYPE& key : m_keytypes) {
-			if (key.KeytypeIdentifier.IsSameAs(typeName)) {
-				// a base type match is found!
-				width = key.Width;
-				overridingXOffset = key.Offset;
-				overridingYOffset = key.YOffset;
-				if (key.ImageOff.getImage() != wxEmptyString) {
-					m_keys[i].KeyImage = key.ImageOff.getBitmap();
-				}
-				if (m_displayedAsPedal && !key.ForceWritingWidth && width == key.BitmapWidth) {
-					// a pedal key of "e" or "b" should by default add another key width for the next key
-					if ((key_nb % 12) == 4 || (key_nb % 12) == 11)
-						width *= 2;
-				}
-				/*
-				if (key.ForceWritingOffset) {
-					forceOffset = true;
-				}
-				*/
-				break;
+		auto baseType = keytypesById.find(typeName);
+		if (baseType != keytypesById.end()) {
+			KEYTYPE& key = *baseType->second;
+			// a base type match is found!
+			width = key.Width;
+			overridingXOffset = key.Offset;
+			overridingYOffset = key.YOffset;
+			if (key.ImageOff.getImage() != wxEmptyString) {
+				m_keys[i].KeyImage = getKeytypeBitmap(&key, resolvedImages);
+			}
+			if (m_displayedAsPedal && !key.ForceWritingWidth && width == key.BitmapWidth) {
+				// a pedal key of "e" or "b" should by default add another key width for the next key
+				if ((key_nb % 12) == 4 || (key_nb % 12) == 11)
+					width *= 2;
+			}
+			/*
+			if (key.ForceWritingOffset) {
+				forceOffset = true;
 			}
+			*/
 		}
 
 		// and possibly finally by a specific matching Key999 entry
 		wxString keyId = wxT("Key") + GOODF_functions::number_format(i + 1);
-		for (KEYTYPE& key : m_keytypes) {
-			if (key.KeytypeIdentifier.IsSameAs(keyId)) {
-				// Key999 overrides any base type
-				width = key.Width;
-				overridingXOffset = key.Offset;
-				overridingYOffset = key.YOffset;
-				if (key.ImageOff.getImage() != wxEmptyString) {
-					m_keys[i].KeyImage = key.ImageOff.getBitmap();
-				}
-				if (m_displayedAsPedal && !key.ForceWritingWidth && width == key.BitmapWidth) {
-					// a pedal key of "e" or "b" should by default add another key width for the next key
-					if ((key_nb % 12) == 4 || (key_nb % 12) == 11)
-						width *= 2;
-				}
-				if (key.ForceWritingOffset) {
-					forceOffset = true;
-				}
-				if (key.ForceWritingWidth) {
-					forceWidth = true;
-				}
-				break;
+		auto keyType = keytypesById.find(keyId);
+		if (keyType != keytypesById.end()) {
+			KEYTYPE& key = *keyType->second;
+			// Key999 overrides any base type
+			width = key.Width;
+			overridingXOffset = key.Offset;
+			overridingYOffset = key.YOffset;
+			if (key.ImageOff.getImage() != wxEmptyString) {
+				m_keys[i].KeyImage = getKeytypeBitmap(&key, resolvedImages);
+			}
+			if (m_displayedAsPedal && !key.ForceWritingWidth && width == key.BitmapWidth) {
+				// a pedal key of "e" or "b" should by default add another key width for the next key
+				if ((key_nb % 12) == 4 || (key_nb % 12) == 11)
+					width *= 2;
+			}
+			if (key.ForceWritingOffset) {
+				forceOffset = true;
+			}
+			if (key.ForceWritingWidth) {
+				forceWidth = true;
 			}
 		}
 		m_keys[i].Xpos += overridingXOffset;
@@ -1020,15 +1052,18 @@ void GUIManual::updateKeyInfo() {
 		if (!m_keys[i].IsSharp || m_displayedAsPedal || forceWidth)
 			keyXpos += width;
 	}
+	m_keyImageCache.swap(resolvedImages);
 }
 
 KEY_INFO* GUIManual::getKeyInfoAt(unsigned index) {
+	if (m_keyInfoIsDirty)
+		updateKeyInfo();
 	return &(m_keys[index]);
 }
 
 void GUIManual::setDisplayAsPedal(bool isPedal) {
 	m_displayedAsPedal = isPedal;
-	updateKeyInfo();
+	invalidateKeyInfo();
 }
 
 bool GUIManual::isDisplayedAsPedal() {
@@ -27,6 +27,7 @@
 #include "GUIElements.h"
 #include "Manual.h"
 #include <list>
+#include <map>
 #include <vector>
 #include "GoImage.h"
 
@@ -102,7 +103,7 @@ public:
 
 	MANUAL_RENDER_INFO m_renderInfo;
 
-	void updateKeyInfo();
+	void invalidateKeyInfo();
 	KEY_INFO* getKeyInfoAt(unsigned index);
 	void setDisplayAsPedal(bool isPedal);
 	bool isDisplayedAsPedal();
@@ -113,6 +114,8 @@ private:
 	wxArrayString m_availableKeytypes;
 	wxArrayString m_availableKeynumbers;
 	std::vector<KEY_INFO> m_keys;
+	bool m_keyInfoIsDirty;
+	std::map<wxString, wxBitmap> m_keyImageCache;
 
 	bool m_dispKeyColourInverted; // (boolean, default: false)
 	bool m_dispKeyColourWooden; // (boolean, default: false)
@@ -133,6 +136,8 @@ private:
 	void populateKeyNumbers();
 	int baseKeyTypeExistAtIndex(wxString keyNbrType);
 	bool keyNbrOverrideBaseKeyWidth(KEYTYPE *key);
+	void updateKeyInfo();
+	wxBitmap getKeytypeBitmap(KEYTYPE *key, std::map<wxString, wxBitmap> &resolved);
 };
 
 #endif
@@ -652,6 +652,7 @@ GUIManualPanel::~GUIManualPanel() {
 
 void GUIManualPanel::setManual(GUIManual *manual) {
 	m_manual = manual;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_manual);
 	if (m_manual->getDispKeyColourInverted())
 		m_keyColorInvertedYes->SetValue(true);
 	else
@@ -788,6 +789,8 @@ void GUIManualPanel::OnKeyColorInvertedRadio(wxCommandEvent& event) {
 		m_manual->setDispKeyColourInverted(false);
 	}
 	SetupImageNbrBoxContent();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -798,6 +801,8 @@ void GUIManualPanel::OnKeyColorWoodRadio(wxCommandEvent& event) {
 		m_manual->setDispKeyColurWooden(false);
 	}
 	SetupImageNbrBoxContent();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -812,21 +817,29 @@ void GUIManualPanel::OnForceWriteWidthRadio(wxCommandEvent& event) {
 			currentKey->ForceWritingWidth = false;
 		}
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIManualPanel::OnImageNumberChoice(wxCommandEvent& WXUNUSED(event)) {
 	m_manual->setDispImageNum(m_dispImageNbrBox->GetSelection() + 1);
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIManualPanel::OnPositionXSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_manual->setPosX(m_elementPosXSpin->GetValue());
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIManualPanel::OnPositionYSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_manual->setPosY(m_elementPosYSpin->GetValue());
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -882,6 +895,8 @@ void GUIManualPanel::OnAddKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 		wxCommandEvent evt(wxEVT_LISTBOX, ID_GUIMANUALPANEL_ADDED_KEYS_BOX);
 		wxPostEvent(this, evt);
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -908,6 +923,8 @@ void GUIManualPanel::OnRemoveKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 		m_removeKey->Disable();
 		UpdateExistingSelectedKeyData();
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -933,8 +950,10 @@ void GUIManualPanel::OnCopyKeyBtn(wxCommandEvent& WXUNUSED(event)) {
 				targetKey->YOffset = sourceKey->YOffset;
 			}
 		}
-		m_manual->updateKeyInfo();
+		m_manual->invalidateKeyInfo();
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -991,6 +1010,8 @@ void GUIManualPanel::OnAddImageOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1004,8 +1025,10 @@ void GUIManualPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 			if (key->BitmapWidth == width && key->BitmapHeight == height) {
 				key->ImageOff.setImage(path);
-				m_manual->updateKeyInfo();
+				m_manual->invalidateKeyInfo();
 				UpdateExistingSelectedKeyData();
+				m_manual->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 			}
 		}
@@ -1021,6 +1044,8 @@ void GUIManualPanel::OnAddImageOffBtn(wxCommandEvent& WXUNUSED(event)) {
 					key->ImageOff.setMask(wxEmptyString);
 
 				UpdateExistingSelectedKeyData();
+				m_manual->markChanged();
+				::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 				::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 			}
 		}
@@ -1052,6 +1077,8 @@ void GUIManualPanel::OnAddMaskOffBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1080,51 +1107,67 @@ void GUIManualPanel::OnAddMaskOnBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIManualPanel::OnWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->Width = m_widthSpin->GetValue();
-	m_manual->updateKeyInfo();
+	m_manual->invalidateKeyInfo();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIManualPanel::OnOffsetSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->Offset = m_offsetSpin->GetValue();
-	m_manual->updateKeyInfo();
+	m_manual->invalidateKeyInfo();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIManualPanel::OnOffsetYSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->YOffset = m_offsetYSpin->GetValue();
-	m_manual->updateKeyInfo();
+	m_manual->invalidateKeyInfo();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
 void GUIManualPanel::OnMouseRectLeftSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectLeft = m_mouseRectLeftSpin->GetValue();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIManualPanel::OnMouseRectTopSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectTop = m_mouseRectTopSpin->GetValue();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIManualPanel::OnMouseRectWidthSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectWidth = m_mouseRectWidthSpin->GetValue();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void GUIManualPanel::OnMouseRectHeightSpin(wxSpinEvent& WXUNUSED(event)) {
 	KEYTYPE *key = m_manual->getKeytypeAt(m_addedKeyTypes->GetSelection());
 	key->MouseRectHeight = m_mouseRectHeightSpin->GetValue();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1134,6 +1177,8 @@ void GUIManualPanel::OnDisplayKeysSpin(wxSpinEvent& WXUNUSED(event)) {
 	SetupKeyChoiceAndMapping();
 	UpdateAddedKeyTypes();
 	UpdateExistingSelectedKeyData();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1143,6 +1188,8 @@ void GUIManualPanel::OnFirstNoteSpin(wxSpinEvent& WXUNUSED(event)) {
 	SetupKeyChoiceAndMapping();
 	UpdateAddedKeyTypes();
 	UpdateExistingSelectedKeyData();
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1159,6 +1206,8 @@ void GUIManualPanel::OnBackendMIDIkeySpin(wxSpinEvent& WXUNUSED(event)) {
 	int selectedIndex = m_displayKeyChoice->GetSelection();
 	if (selectedIndex != wxNOT_FOUND) {
 		m_manual->getDisplayKeyAt(selectedIndex)->first = m_backendMIDIkey->GetValue();
+		m_manual->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1167,8 +1216,10 @@ void GUIManualPanel::OnFrontendMIDIkeySpin(wxSpinEvent& WXUNUSED(event)) {
 	int selectedIndex = m_displayKeyChoice->GetSelection();
 	if (selectedIndex != wxNOT_FOUND) {
 		m_manual->getDisplayKeyAt(selectedIndex)->second = m_frontendMIDIkey->GetValue();
-		m_manual->updateKeyInfo();
+		m_manual->invalidateKeyInfo();
 	}
+	m_manual->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_manual);
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
@@ -1183,6 +1234,7 @@ void GUIManualPanel::OnRemoveManualBtn(wxCommandEvent& WXUNUSED(event)) {
 	} else {
 		::wxGetApp().m_frame->RemoveCurrentItemFromOrgan();
 	}
+	m_manual->markChanged();
 	::wxGetApp().m_frame->PanelGUIPropertyIsChanged();
 }
 
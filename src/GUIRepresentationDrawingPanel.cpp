@@ -19,9 +19,17 @@
  */
 
 #include "GUIRepresentationDrawingPanel.h"
-#include "GUIButton.h"
 #include "GUILabel.h"
 #include "GOODF.h"
+#include "TraceRecorder.h"
+#include <wx/display.h>
+#include <cmath>
+#include <algorithm>
+
+// the zoom levels (in percent) that the panel can be shown at
+static const int ZOOM_LEVELS[] = {25, 33, 50, 67, 75, 100, 125, 150, 200};
+static const int NUMBER_OF_ZOOM_LEVELS = sizeof(ZOOM_LEVELS) / sizeof(ZOOM_LEVELS[0]);
+static const int DEFAULT_ZOOM_INDEX = 5;
 
 // Event table
 BEGIN_EVENT_TABLE(GUIRepresentationDrawingPanel, wxPanel)
@@ -34,6 +42,10 @@ BEGIN_EVENT_TABLE(GUIRepresentationDrawingPanel, wxPanel)
 	EVT_CHAR(GUIRepresentationDrawingPanel::OnKeyboardInput)
 	EVT_KEY_UP(GUIRepresentationDrawingPanel::OnKeyRelease)
 	EVT_SIZE(GUIRepresentationDrawingPanel::OnPanelSize)
+	EVT_MOUSEWHEEL(GUIRepresentationDrawingPanel::OnMouseWheel)
+	EVT_MIDDLE_DOWN(GUIRepresentationDrawingPanel::OnMiddleDown)
+	EVT_MIDDLE_UP(GUIRepresentationDrawingPanel::OnMiddleUp)
+	EVT_THREAD(ID_SCALED_TILE_READY, GUIRepresentationDrawingPanel::OnScaledTileReady)
 END_EVENT_TABLE()
 
 GUIRepresentationDrawingPanel::GUIRepresentationDrawingPanel(wxWindow *parent) : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxWANTS_CHARS) {
@@ -50,41 +62,54 @@ GUIRepresentationDrawingPanel::GUIRepresentationDrawingPanel(wxWindow *parent) :
 	m_startDragY = -1;
 	m_selectionChangingWidth = 0;
 	m_selectionChangingHeight = 0;
-	m_HackY = 0;
-	m_EnclosureY = 0;
-	m_CenterY = 0;
-	m_CenterWidth = 0;
-	m_FontScale = 1.0;
-	InitFont();
+	m_renderer = NULL;
+	m_panelBitmapIsDirty = true;
+	m_scaledSourceIsStale = true;
+	m_scaledCache = new ScaledBitmapCache(this, ID_SCALED_TILE_READY);
+	m_zoomIndex = DEFAULT_ZOOM_INDEX;
+	m_zoomPercent = ZOOM_LEVELS[DEFAULT_ZOOM_INDEX];
+	m_panOffset = wxPoint(0, 0);
+	m_isPanning = false;
 	SetFocus();
 }
 
 GUIRepresentationDrawingPanel::~GUIRepresentationDrawingPanel() {
-
+	delete m_scaledCache;
+	if (m_renderer)
+		delete m_renderer;
 }
 
 void GUIRepresentationDrawingPanel::SetCurrentPanel(GoPanel *thePanel) {
 	m_currentPanel = thePanel;
+	if (m_renderer)
+		delete m_renderer;
+	m_renderer = new PanelRenderer(thePanel);
 	m_selectedObjectIndex = -1;
 	m_isFirstRender = true;
 	if (!m_guiObjects.empty()) {
 		m_guiObjects.clear();
 	}
-	SetClientSize(m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue(), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-
-	UpdateLayout();
+	m_panOffset = wxPoint(0, 0);
+	InvalidatePanelBitmap();
+	UpdateViewSize();
 	PostSizeEvent();
 }
 
 void GUIRepresentationDrawingPanel::OnPaintEvent(wxPaintEvent& WXUNUSED(event)) {
 	wxPaintDC dc(this);
-	RenderPanel(dc);
+	if (!m_currentPanel)
+		return;
+	UpdatePanelBitmap();
+	m_overlay.Reset();
+	DrawPanelView(dc);
+	DrawSelection(dc);
 }
 
 void GUIRepresentationDrawingPanel::OnLeftClick(wxMouseEvent& event) {
 	if (!m_guiObjects.empty()) {
-		wxCoord xPos = event.GetX();
-		wxCoord yPos = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		wxCoord xPos = mousePos.x;
+		wxCoord yPos = mousePos.y;
 		m_startDragX = xPos;
 		m_startDragY = yPos;
 		m_selectedObjectIndex = -1;
@@ -139,10 +164,21 @@ void GUIRepresentationDrawingPanel::OnLeftClick(wxMouseEvent& event) {
 }
 
 void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
+	if (m_isPanning) {
+		if (event.MiddleIsDown()) {
+			wxPoint moved = event.GetPosition() - m_panStart;
+			SetPanOffset(m_panStartOffset.x - moved.x, m_panStartOffset.y - moved.y);
+			Refresh();
+			event.Skip();
+			return;
+		}
+		m_isPanning = false;
+	}
 	if (m_selectedObjectIndex >= 0 && event.Dragging()) {
 		m_isDraggingObject = true;
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 		wxClientDC dc(this);
 		wxDCOverlay overlaydc(m_overlay, &dc);
 		overlaydc.Clear();
@@ -161,10 +197,10 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 					m_guiObjects[i].boundingRect.width,
 					m_guiObjects[i].boundingRect.height
 				);
-				dc.DrawRectangle(tempOutline);
+				dc.DrawRectangle(ToViewRect(tempOutline));
 				dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
 				dc.SetTextForeground(*wxYELLOW);
-				dc.DrawText(wxString::Format(wxT("(%i, %i)"), xPos, yPos), xPos + 1, yPos + 1);
+				dc.DrawText(wxString::Format(wxT("(%i, %i)"), xPos, yPos), ToViewCoordinates(wxPoint(xPos + 1, yPos + 1)));
 			}
 		}
 	} else if (m_selectedObjectIndex < 0 && event.Dragging() && !IsSelectionChanging()) {
@@ -174,8 +210,9 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 			m_selectionRect.SetPosition(wxPoint(m_startDragX, m_startDragY));
 		}
 		m_isSelecting = true;
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 
 		if (m_currentDragX < 0)
 			m_currentDragX = 0;
@@ -194,10 +231,11 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 		int xOffset = m_currentDragX - m_startDragX;
 		int yOffset = m_currentDragY - m_startDragY;
 		m_selectionRect.SetSize(wxSize(xOffset, yOffset));
-		dc.DrawRectangle(m_selectionRect);
+		dc.DrawRectangle(ToViewRect(m_selectionRect));
 	} else if (m_hasSelection && !event.Dragging()) {
-		wxCoord currentX = event.GetX();
-		wxCoord currentY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		wxCoord currentX = mousePos.x;
+		wxCoord currentY = mousePos.y;
 		if (m_selectionRect.Contains(currentX, currentY)) {
 			wxClientDC dc(this);
 			wxDCOverlay overlaydc(m_overlay, &dc);
@@ -205,33 +243,33 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 			dc.SetBrush(*wxTRANSPARENT_BRUSH);
 			if (m_selectionRectLeftUpCorner.Contains(currentX, currentY)) {
 				dc.SetPen(wxPen(wxColour(*wxYELLOW), 1, wxPENSTYLE_SOLID));
-				dc.DrawRectangle(m_selectionRectLeftUpCorner);
+				dc.DrawRectangle(ToViewRect(m_selectionRectLeftUpCorner));
 			} else if (m_selectionRectLeftDownCorner.Contains(currentX, currentY)) {
 				dc.SetPen(wxPen(wxColour(*wxYELLOW), 1, wxPENSTYLE_SOLID));
-				dc.DrawRectangle(m_selectionRectLeftDownCorner);
+				dc.DrawRectangle(ToViewRect(m_selectionRectLeftDownCorner));
 			} else if (m_selectionRectRightUpCorner.Contains(currentX, currentY)) {
 				dc.SetPen(wxPen(wxColour(*wxYELLOW), 1, wxPENSTYLE_SOLID));
-				dc.DrawRectangle(m_selectionRectRightUpCorner);
+				dc.DrawRectangle(ToViewRect(m_selectionRectRightUpCorner));
 			} else if (m_selectionRectRightDownCorner.Contains(currentX, currentY)) {
 				dc.SetPen(wxPen(wxColour(*wxYELLOW), 1, wxPENSTYLE_SOLID));
-				dc.DrawRectangle(m_selectionRectRightDownCorner);
+				dc.DrawRectangle(ToViewRect(m_selectionRectRightDownCorner));
 			} else {
 				// all corners for adjusting selection rectangle
 				dc.SetPen(wxPen(wxColour(*wxGREEN), 1, wxPENSTYLE_SOLID));
-				dc.DrawLine(m_selectionRectLeftUpCorner.GetBottomLeft(), m_selectionRectLeftUpCorner.GetBottomRight());
-				dc.DrawLine(m_selectionRectLeftUpCorner.GetBottomRight(), m_selectionRectLeftUpCorner.GetTopRight());
+				dc.DrawLine(ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomRight()));
+				dc.DrawLine(ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomRight()), ToViewCoordinates(m_selectionRectLeftUpCorner.GetTopRight()));
 
-				dc.DrawLine(m_selectionRectRightUpCorner.GetTopLeft(), m_selectionRectRightUpCorner.GetBottomLeft());
-				dc.DrawLine(m_selectionRectRightUpCorner.GetBottomLeft(), m_selectionRectRightUpCorner.GetBottomRight());
+				dc.DrawLine(ToViewCoordinates(m_selectionRectRightUpCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomLeft()));
+				dc.DrawLine(ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomRight()));
 
-				dc.DrawLine(m_selectionRectRightDownCorner.GetBottomLeft(), m_selectionRectRightDownCorner.GetTopLeft());
-				dc.DrawLine(m_selectionRectRightDownCorner.GetTopLeft(), m_selectionRectRightDownCorner.GetTopRight());
+				dc.DrawLine(ToViewCoordinates(m_selectionRectRightDownCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectRightDownCorner.GetTopLeft()));
+				dc.DrawLine(ToViewCoordinates(m_selectionRectRightDownCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectRightDownCorner.GetTopRight()));
 
-				dc.DrawLine(m_selectionRectLeftDownCorner.GetTopLeft(), m_selectionRectLeftDownCorner.GetTopRight());
-				dc.DrawLine(m_selectionRectLeftDownCorner.GetTopRight(), m_selectionRectLeftDownCorner.GetBottomRight());
+				dc.DrawLine(ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopRight()));
+				dc.DrawLine(ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopRight()), ToViewCoordinates(m_selectionRectLeftDownCorner.GetBottomRight()));
 			}
 			dc.SetPen(wxPen(wxColour(*wxGREEN), 1, wxPENSTYLE_DOT));
-			dc.DrawRectangle(m_selectionRect);
+			dc.DrawRectangle(ToViewRect(m_selectionRect));
 		} else {
 			Refresh();
 		}
@@ -259,8 +297,9 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 			}
 		}
 		m_isSelecting = true;
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 
 		if (m_selectionRect.GetPosition().x + m_selectionChangingWidth + m_currentDragX - m_startDragX < 0)
 			m_currentDragX = m_startDragX - m_selectionRect.GetPosition().x - m_selectionChangingWidth;
@@ -279,17 +318,21 @@ void GUIRepresentationDrawingPanel::OnMouseMotion(wxMouseEvent& event) {
 		int xOffset = m_selectionChangingWidth + m_currentDragX - m_startDragX;
 		int yOffset = m_selectionChangingHeight + m_currentDragY - m_startDragY;
 		m_selectionRect.SetSize(wxSize(xOffset, yOffset));
-		dc.DrawRectangle(m_selectionRect);
+		dc.DrawRectangle(ToViewRect(m_selectionRect));
 	}
 	event.Skip();
 }
 
 void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 	if (m_selectedObjectIndex >= 0 && m_isDraggingObject) {
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 		int finalXoffset = m_currentDragX - m_startDragX;
 		int finalYoffset = m_currentDragY - m_startDragY;
+		UndoStep *undoStep = NULL;
+		if (finalXoffset != 0 || finalYoffset != 0)
+			undoStep = ::wxGetApp().m_frame->m_undoHistory->beginStep(::wxGetApp().m_frame->m_organ, wxT("Move GUI elements"));
 
 		for (unsigned i = 0; i < m_guiObjects.size(); i++) {
 			if (m_guiObjects[i].isSelected) {
@@ -297,6 +340,8 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 				int finalYpos = m_guiObjects[i].boundingRect.y + finalYoffset;
 
 				if (m_guiObjects[i].element) {
+					if (undoStep)
+						undoStep->recordGuiElementPosition(m_guiObjects[i].element);
 					m_guiObjects[i].element->setPosX(finalXpos);
 					m_guiObjects[i].element->setPosY(finalYpos);
 					if (m_guiObjects[i].element->getType().IsSameAs(wxT("Label"))) {
@@ -309,6 +354,8 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 						}
 					}
 				} else if (m_guiObjects[m_selectedObjectIndex].img) {
+					if (undoStep)
+						undoStep->recordImagePosition(m_currentPanel, m_guiObjects[i].img);
 					m_guiObjects[i].img->setPositionX(finalXpos);
 					m_guiObjects[i].img->setPositionY(finalYpos);
 				}
@@ -316,6 +363,9 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 				m_guiObjects[i].boundingRect.y = finalYpos;
 			}
 		}
+		if (undoStep)
+			::wxGetApp().m_frame->m_undoHistory->commitStep(undoStep);
+		InvalidatePanelBitmap();
 
 		m_isDraggingObject = false;
 		// reset all drag coordinates
@@ -329,8 +379,9 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 	} else if (m_selectedObjectIndex < 0 && m_isSelecting && !IsSelectionChanging()) {
 		m_isSelecting = false;
 		m_hasSelection = true;
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 
 		// limit selection position within the panel
 		if (m_currentDragX < 0)
@@ -391,8 +442,9 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 	} else if (m_hasSelection && m_isSelecting && IsSelectionChanging()) {
 		m_isSelecting = false;
 		m_hasSelection = true;
-		m_currentDragX = event.GetX();
-		m_currentDragY = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		m_currentDragX = mousePos.x;
+		m_currentDragY = mousePos.y;
 
 
 		if (m_selectionRect.GetPosition().x + m_selectionChangingWidth + m_currentDragX - m_startDragX < 0)
@@ -465,8 +517,9 @@ void GUIRepresentationDrawingPanel::OnLeftRelease(wxMouseEvent& event) {
 
 void GUIRepresentationDrawingPanel::OnRightDown(wxMouseEvent& event) {
 	if (m_hasSelection) {
-		wxCoord xPos = event.GetX();
-		wxCoord yPos = event.GetY();
+		wxPoint mousePos = ToPanelCoordinates(event.GetPosition());
+		wxCoord xPos = mousePos.x;
+		wxCoord yPos = mousePos.y;
 		if (m_selectionRect.Contains(xPos, yPos)) {
 			wxMenu selectionMenu;
 			selectionMenu.Append(ID_CONVERT_SELECTION_CONTAINING, "Select contained elements");
@@ -519,6 +572,21 @@ void GUIRepresentationDrawingPanel::SelectIntersectingElements() {
 }
 
 void GUIRepresentationDrawingPanel::OnKeyboardInput(wxKeyEvent& event) {
+	if (event.GetEventType() == wxEVT_KEY_DOWN && event.ControlDown()) {
+		// zooming is done around the center of the view
+		wxPoint center(GetClientSize().GetWidth() / 2, GetClientSize().GetHeight() / 2);
+		int keyCode = event.GetKeyCode();
+		if (keyCode == '+' || keyCode == '=' || keyCode == WXK_NUMPAD_ADD) {
+			SetZoom(m_zoomIndex + 1, center);
+			return;
+		} else if (keyCode == '-' || keyCode == WXK_NUMPAD_SUBTRACT) {
+			SetZoom(m_zoomIndex - 1, center);
+			return;
+		} else if (keyCode == '0' || keyCode == WXK_NUMPAD0) {
+			SetZoom(DEFAULT_ZOOM_INDEX, center);
+			return;
+		}
+	}
 	if (m_selectedObjectIndex > -1) {
 		int xOffset = 0;
 		int yOffset = 0;
@@ -565,6 +633,7 @@ void GUIRepresentationDrawingPanel::OnKeyboardInput(wxKeyEvent& event) {
 					m_guiObjects[i].boundingRect.y = yPos;
 				}
 			}
+			InvalidatePanelBitmap();
 			::wxGetApp().m_frame->GUIElementPositionIsChanged();
 
 			wxClientDC dc(this);
@@ -582,10 +651,10 @@ void GUIRepresentationDrawingPanel::OnKeyboardInput(wxKeyEvent& event) {
 						m_guiObjects[m_selectedObjectIndex].boundingRect.width,
 						m_guiObjects[m_selectedObjectIndex].boundingRect.height
 					);
-					dc.DrawRectangle(tempOutline);
+					dc.DrawRectangle(ToViewRect(tempOutline));
 					dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
 					dc.SetTextForeground(*wxYELLOW);
-					dc.DrawText(wxString::Format(wxT("(%i, %i)"), xPos, yPos), xPos + 1, yPos + 1);
+					dc.DrawText(wxString::Format(wxT("(%i, %i)"), xPos, yPos), ToViewCoordinates(wxPoint(xPos + 1, yPos + 1)));
 				}
 			}
 
@@ -616,415 +685,8 @@ void GUIRepresentationDrawingPanel::DoPaintNow() {
 	}
 }
 
-void GUIRepresentationDrawingPanel::RenderPanel(wxDC& dc) {
-	m_overlay.Reset();
-	// First draw the basic background of left jamb
-	wxRect rect = wxRect(0, 0, GetCenterX(), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-	wxBitmap stopBg = m_currentPanel->getDisplayMetrics()->getDrawstopBg();
-	TileBitmap(rect, dc, stopBg, 0, 0);
-
-	// Right jamb
-	rect = wxRect((GetCenterX() + GetCenterWidth()), 0, m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - (GetCenterX() + GetCenterWidth()), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-	TileBitmap(rect, dc, stopBg, 0, 0);
-
-	// Console, middle part
-	rect = wxRect(GetCenterX(), 0, GetCenterWidth(), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-	wxBitmap consoleBg = m_currentPanel->getDisplayMetrics()->getConsoleBg();
-	TileBitmap(rect, dc, consoleBg, 0, 0);
-
-	// Inset for paired drawstops
-	if (m_currentPanel->getDisplayMetrics()->m_dispPairDrawstopCols) {
-		for (int i = 0; i < (m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols >> 2); i++) {
-			rect = wxRect(i * (2 * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 18) + GetJambLeftX() - 5, GetJambLeftRightY(), 2 * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 10, GetJambLeftRightHeight());
-			wxBitmap insetBg = m_currentPanel->getDisplayMetrics()->getInsetBg();
-			TileBitmap(rect, dc, insetBg, 0, 0);
-
-			rect = wxRect(i * (2 * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 18) + GetJambRightX() - 5, GetJambLeftRightY(), 2 * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 10, GetJambLeftRightHeight());
-			TileBitmap(rect, dc, insetBg, 0, 0);
-		}
-	}
-
-	// Trim above extra rows
-	if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveExtraRows) {
-		rect = wxRect(GetCenterX(), GetCenterY(), GetCenterWidth(), 8);
-		wxBitmap keyVert = m_currentPanel->getDisplayMetrics()->getKeyVertBg();
-		TileBitmap(rect, dc, keyVert, 0, 0);
-	}
-
-	if (GetJambTopHeight() + GetPistonTopHeight()) {
-		rect = wxRect(GetCenterX(), GetJambTopY(), GetCenterWidth(), GetJambTopHeight() + GetPistonTopHeight());
-		wxBitmap keyHoriz = m_currentPanel->getDisplayMetrics()->getKeyHorizBg();
-		TileBitmap(rect, dc, keyHoriz, 0, 0);
-	}
-
-	// Manual backgrounds
-	for (unsigned i = 0; i < m_currentPanel->getNumberOfManuals(); i++) {
-		GUIManual *currentMan = m_currentPanel->getGuiManualAt(i);
-		wxRect vRect = wxRect(GetCenterX(), currentMan->m_renderInfo.y, GetCenterWidth(), currentMan->m_renderInfo.height);
-		wxBitmap keyVert = m_currentPanel->getDisplayMetrics()->getKeyVertBg();
-		TileBitmap(vRect, dc, keyVert, 0, 0);
-
-		wxRect hRect = wxRect(GetCenterX(), currentMan->m_renderInfo.piston_y, GetCenterWidth(), (!i && m_currentPanel->getDisplayMetrics()->m_dispExtraPedalButtonRow) ? 2 * m_currentPanel->getDisplayMetrics()->m_dispPistonHeight : m_currentPanel->getDisplayMetrics()->m_dispPistonHeight);
-		wxBitmap keyHoriz = m_currentPanel->getDisplayMetrics()->getKeyHorizBg();
-		TileBitmap(hRect, dc, keyHoriz, 0, 0);
-	}
-
-	if (m_currentPanel->getNumberOfImages() > 0) {
-		for (unsigned i = 0; i < m_currentPanel->getNumberOfImages(); i++) {
-			// if the image is empty it should just be skipped
-			if (!m_currentPanel->getImageAt(i)->getBitmap().IsOk())
-				continue;
-			int imgX = m_currentPanel->getImageAt(i)->getPositionX();
-			int imgY = m_currentPanel->getImageAt(i)->getPositionY();
-			int imgWidth = m_currentPanel->getImageAt(i)->getWidth();
-			int imgHeight = m_currentPanel->getImageAt(i)->getHeight();
-			if (m_currentPanel->getImageAt(i)->getWidth() > m_currentPanel->getImageAt(i)->getOriginalWidth() || m_currentPanel->getImageAt(i)->getHeight() > m_currentPanel->getImageAt(i)->getOriginalHeight()) {
-				wxRect imgRect(
-					imgX,
-					imgY,
-					imgWidth,
-					imgHeight
-				);
-				wxBitmap theBmp = m_currentPanel->getImageAt(i)->getBitmap();
-				TileBitmap(imgRect, dc, theBmp, m_currentPanel->getImageAt(i)->getTileOffsetX(), m_currentPanel->getImageAt(i)->getTileOffsetY());
-			} else {
-				dc.DrawBitmap(m_currentPanel->getImageAt(i)->getBitmap(), imgX, imgY, true);
-			}
-			if (m_isFirstRender && imgWidth < m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() / 2 && imgHeight < m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() / 2) {
-				GUI_OBJECT theImage;
-				theImage.element = NULL;
-				theImage.img = m_currentPanel->getImageAt(i);
-				theImage.boundingRect = wxRect(imgX, imgY, imgWidth, imgHeight);
-				theImage.isSelected = false;
-				m_guiObjects.push_back(theImage);
-			}
-		}
-	}
-
-	// Manual keys drawn after images!
-	for (unsigned i = 0; i < m_currentPanel->getNumberOfManuals(); i++) {
-		GUIManual *currentMan = m_currentPanel->getGuiManualAt(i);
-		int manXpos = currentMan->m_renderInfo.x;
-		int manYpos = currentMan->m_renderInfo.keys_y;
-		if (currentMan->getPosX() >= 0)
-			manXpos = currentMan->getPosX();
-		if (currentMan->getPosY() >= 0) {
-			manYpos = currentMan->getPosY();
-		}
-		for (int j = 0; j < currentMan->getNumberOfDisplayKeys(); j++) {
-			KEY_INFO *currentKey = currentMan->getKeyInfoAt(j);
-			wxBitmap theKey = currentKey->KeyImage;
-			dc.DrawBitmap(theKey, manXpos + currentKey->Xpos, manYpos + currentKey->Ypos, true);
-		}
-		if (m_isFirstRender) {
-			GUI_OBJECT theManual;
-			theManual.element = currentMan;
-			theManual.img = NULL;
-			theManual.boundingRect = wxRect(manXpos, manYpos, currentMan->m_renderInfo.width, currentMan->m_renderInfo.height);
-			theManual.isSelected = false;
-			m_guiObjects.push_back(theManual);
-		}
-	}
-
-	if (m_currentPanel->getNumberOfGuiElements() > 0) {
-		for (unsigned i = 0; i < (unsigned) m_currentPanel->getNumberOfGuiElements(); i++) {
-			GUIElement *guiElement = m_currentPanel->getGuiElementAt(i);
-			wxBitmap theBmp = guiElement->getBitmap();
-			// Test if it's a button type
-			GUIButton *btnElement = dynamic_cast<GUIButton*>(guiElement);
-			if (btnElement) {
-				wxPoint thePos;
-				if (btnElement->isDisplayAsPiston()) {
-					thePos = GetPushbuttonPosition(btnElement->getDispButtonRow(), btnElement->getDispButtonCol());
-				} else {
-					thePos = GetDrawstopPosition(btnElement->getDispDrawstopRow(), btnElement->getDispDrawstopCol());
-				}
-				if (btnElement->getPosX() != -1) {
-					thePos.x = btnElement->getPosX();
-				}
-				if (btnElement->getPosY() != -1) {
-					thePos.y = btnElement->getPosY();
-				}
-
-				if (theBmp.IsOk()) {
-					wxRect imgRect(thePos.x, thePos.y, btnElement->getWidth(), btnElement->getHeight());
-					TileBitmap(imgRect, dc, theBmp, btnElement->getTileOffsetX(), btnElement->getTileOffsetY());
-				}
-
-				if (btnElement->getTextBreakWidth()) {
-					dc.SetFont(btnElement->getDispLabelFont());
-					dc.SetBackgroundMode(wxTRANSPARENT);
-					dc.SetTextForeground(btnElement->getDispLabelColour()->getColor());
-					wxRect textRect(
-						thePos.x + btnElement->getTextRectLeft(),
-						thePos.y + btnElement->getTextRectTop(),
-						btnElement->getTextRectWidth(),
-						btnElement->getTextRectHeight()
-					);
-					wxString textToDisplay;
-					if (btnElement->getDispLabelText() != wxEmptyString)
-						textToDisplay = btnElement->getDispLabelText();
-					else
-						textToDisplay = btnElement->getElementName();
-					if (btnElement->getDispLabelText() == wxEmptyString) {
-						if (textToDisplay.Contains(wxT("Setter")) && textToDisplay.Contains(wxT("Divisional")) && textToDisplay.Len() == 22) {
-							wxString combinationNbr = textToDisplay.Mid(19);
-							long theNbr;
-							if (combinationNbr.ToLong(&theNbr)) {
-								theNbr += 1;
-								textToDisplay = wxString::Format(wxT("%ld"), theNbr);
-							}
-						} else if (textToDisplay.Contains(wxT("General")) && textToDisplay.Len() == 9) {
-							wxString combinationNbr = textToDisplay.Mid(7);
-							long theNbr;
-							if (combinationNbr.ToLong(&theNbr)) {
-								textToDisplay = wxString::Format(wxT("%ld"), theNbr);
-							}
-						} else if (textToDisplay.IsSameAs(wxT("SetterXXXDivisionalPrevBank"))) {
-							textToDisplay = wxT("-");
-						} else if (textToDisplay.IsSameAs(wxT("SetterXXXDivisionalNextBank"))) {
-							textToDisplay = wxT("+");
-						} else if (textToDisplay.IsSameAs(wxT("GeneralPrev"))) {
-							textToDisplay = wxT("Prev");
-						} else if (textToDisplay.IsSameAs(wxT("GeneralNext"))) {
-							textToDisplay = wxT("Next");
-						} else if (textToDisplay.IsSameAs(wxT("Home"))) {
-							textToDisplay = wxT("000");
-						} else if (textToDisplay.IsSameAs(wxT("LoadFile"))) {
-							textToDisplay = wxT("Load File");
-						} else if (textToDisplay.IsSameAs(wxT("PrevFile"))) {
-							textToDisplay = wxT("Prev File");
-						} else if (textToDisplay.IsSameAs(wxT("NextFile"))) {
-							textToDisplay = wxT("Next File");
-						} else if (textToDisplay.IsSameAs(wxT("SaveFile"))) {
-							textToDisplay = wxT("Save File");
-						} else if (textToDisplay.IsSameAs(wxT("RefreshFiles"))) {
-							textToDisplay = wxT("Refresh Files");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoA"))) {
-							textToDisplay = wxT("A");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoB"))) {
-							textToDisplay = wxT("B");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoC"))) {
-							textToDisplay = wxT("C");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoD"))) {
-							textToDisplay = wxT("D");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoPrev"))) {
-							textToDisplay = wxT("<");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoNext"))) {
-							textToDisplay = wxT(">");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoCurrent"))) {
-							textToDisplay = wxT("Current");
-						} else if (textToDisplay.IsSameAs(wxT("CrescendoOverride"))) {
-							textToDisplay = wxT("Override");
-						} else if (textToDisplay.IsSameAs(wxT("GC"))) {
-							textToDisplay = wxT("G.C.");
-						} else if (textToDisplay.IsSameAs(wxT("P1"))) {
-							textToDisplay = wxT("+1");
-						} else if (textToDisplay.IsSameAs(wxT("M1"))) {
-							textToDisplay = wxT("-1");
-						} else if (textToDisplay.IsSameAs(wxT("P10"))) {
-							textToDisplay = wxT("+10");
-						} else if (textToDisplay.IsSameAs(wxT("M10"))) {
-							textToDisplay = wxT("-10");
-						} else if (textToDisplay.IsSameAs(wxT("P100"))) {
-							textToDisplay = wxT("+100");
-						} else if (textToDisplay.IsSameAs(wxT("M100"))) {
-							textToDisplay = wxT("-100");
-						} else if (textToDisplay.IsSameAs(wxT("PitchP1"))) {
-							textToDisplay = wxT("+1");
-						} else if (textToDisplay.IsSameAs(wxT("PitchP10"))) {
-							textToDisplay = wxT("+10");
-						} else if (textToDisplay.IsSameAs(wxT("PitchP100"))) {
-							textToDisplay = wxT("+100");
-						} else if (textToDisplay.IsSameAs(wxT("PitchM1"))) {
-							textToDisplay = wxT("-1");
-						} else if (textToDisplay.IsSameAs(wxT("PitchM10"))) {
-							textToDisplay = wxT("-10");
-						} else if (textToDisplay.IsSameAs(wxT("PitchM100"))) {
-							textToDisplay = wxT("-100");
-						} else if (textToDisplay.IsSameAs(wxT("TemperamentPrev"))) {
-							textToDisplay = wxT("<");
-						} else if (textToDisplay.IsSameAs(wxT("TemperamentNext"))) {
-							textToDisplay = wxT(">");
-						} else if (textToDisplay.IsSameAs(wxT("TransposeUp"))) {
-							textToDisplay = wxT("+");
-						} else if (textToDisplay.IsSameAs(wxT("TransposeDown"))) {
-							textToDisplay = wxT("-");
-						} else if (textToDisplay.IsSameAs(wxT("L0"))) {
-							textToDisplay = wxT("__0");
-						} else if (textToDisplay.IsSameAs(wxT("L1"))) {
-							textToDisplay = wxT("__1");
-						} else if (textToDisplay.IsSameAs(wxT("L2"))) {
-							textToDisplay = wxT("__2");
-						} else if (textToDisplay.IsSameAs(wxT("L3"))) {
-							textToDisplay = wxT("__3");
-						} else if (textToDisplay.IsSameAs(wxT("L4"))) {
-							textToDisplay = wxT("__4");
-						} else if (textToDisplay.IsSameAs(wxT("L5"))) {
-							textToDisplay = wxT("__5");
-						} else if (textToDisplay.IsSameAs(wxT("L6"))) {
-							textToDisplay = wxT("__6");
-						} else if (textToDisplay.IsSameAs(wxT("L7"))) {
-							textToDisplay = wxT("__7");
-						} else if (textToDisplay.IsSameAs(wxT("L8"))) {
-							textToDisplay = wxT("__8");
-						} else if (textToDisplay.IsSameAs(wxT("L9"))) {
-							textToDisplay = wxT("__9");
-						}
-					}
-					dc.DrawLabel(BreakTextLine(textToDisplay, btnElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_VERTICAL | wxALIGN_CENTER_HORIZONTAL);
-				}
-				if (m_isFirstRender) {
-					GUI_OBJECT theButton;
-					theButton.element = btnElement;
-					theButton.img = NULL;
-					theButton.boundingRect = wxRect(thePos.x, thePos.y, btnElement->getWidth(), btnElement->getHeight());
-					theButton.isSelected = false;
-					m_guiObjects.push_back(theButton);
-				}
-				continue;
-			}
-			GUIEnclosure *encElement = dynamic_cast<GUIEnclosure*>(guiElement);
-			if (encElement) {
-				wxPoint thePos(0, 0);
-
-				int enclosureNumberOnPanel = -1;
-				for (unsigned j = 0; j < m_currentPanel->getNumberOfEnclosures(); j++) {
-					if (encElement == m_currentPanel->getGuiEnclosureAt(j)) {
-						enclosureNumberOnPanel = j;
-						break;
-					}
-				}
-				if (enclosureNumberOnPanel != -1) {
-					enclosureNumberOnPanel += 1;
-					thePos.x = GetEnclosureX(enclosureNumberOnPanel);
-				}
-				thePos.y = GetEnclosureY();
-
-				if (encElement->getPosX() != -1) {
-					thePos.x = encElement->getPosX();
-				}
-				if (encElement->getPosY() != -1) {
-					thePos.y = encElement->getPosY();
-				}
-
-				wxRect imgRect(thePos.x, thePos.y, encElement->getWidth(), encElement->getHeight());
-				TileBitmap(imgRect, dc, theBmp, encElement->getTileOffsetX(), encElement->getTileOffsetY());
-
-				if (encElement->getTextBreakWidth()) {
-					wxFont theFont = encElement->getDispLabelFont();
-					int pointSize = theFont.GetPointSize();
-					pointSize *= m_FontScale;
-					theFont.SetPointSize(pointSize);
-					dc.SetFont(theFont);
-					dc.SetBackgroundMode(wxTRANSPARENT);
-					dc.SetTextForeground(encElement->getDispLabelColour()->getColor());
-					wxRect textRect(
-						thePos.x + encElement->getTextRectLeft(),
-						thePos.y + encElement->getTextRectTop(),
-						encElement->getTextRectWidth(),
-						encElement->getTextRectHeight()
-					);
-					wxString textToDisplay;
-					if (encElement->getDispLabelText() != wxEmptyString)
-						textToDisplay = encElement->getDispLabelText();
-					else
-						textToDisplay = encElement->getElementName();
-					if (encElement->getDispLabelText() == wxEmptyString) {
-						if (textToDisplay.IsSameAs(wxT("Swell")))
-							textToDisplay = wxT("Crescendo");
-					}
-					dc.DrawLabel(BreakTextLine(textToDisplay, encElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_HORIZONTAL);
-				}
-				if (m_isFirstRender) {
-					GUI_OBJECT theEnclosure;
-					theEnclosure.element = encElement;
-					theEnclosure.img = NULL;
-					theEnclosure.boundingRect = wxRect(thePos.x, thePos.y, encElement->getWidth(), encElement->getHeight());
-					theEnclosure.isSelected = false;
-					m_guiObjects.push_back(theEnclosure);
-				}
-
-				continue;
-			}
-			GUILabel *labelElement = dynamic_cast<GUILabel*>(guiElement);
-			if (labelElement) {
-				int xPosToUse = 0;
-				if (labelElement->isFreeXPlacement()) {
-					// the label uses absolute x positioning either via m_dispXpos or m_positionX
-					if (labelElement->getPosX() >= 0)
-						xPosToUse = labelElement->getPosX();
-					else
-						xPosToUse = labelElement->getDispXpos();
-				} else {
-					// the label uses the default layout model for x positioning
-					int drawstopsPerJamb = m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols / 2;
-					if (labelElement->isDispSpanDrawstopColToRight())
-						xPosToUse = 39;
-					if (labelElement->getDispDrawstopCol() <= drawstopsPerJamb)
-						xPosToUse = xPosToUse + (labelElement->getDispDrawstopCol() - 1) * 78 + 1;
-					else
-						xPosToUse = -(xPosToUse + (labelElement->getDispDrawstopCol() - 1 - drawstopsPerJamb) * 78 + 1);
-
-					if (xPosToUse >= 0)
-						xPosToUse = GetJambLeftX() + xPosToUse;
-					else
-						xPosToUse = GetJambRightX() - xPosToUse;
-				}
-
-				int yPosToUse = 0;
-				if (labelElement->isFreeYPlacement()) {
-					// the label uses absolute y positioning either via m_dispYpos or m_positionY
-					if (labelElement->getPosY() >= 0)
-						yPosToUse = labelElement->getPosY();
-					else
-						yPosToUse = labelElement->getDispYpos();
-				} else {
-					// the label uses default layout model for y positioning
-					yPosToUse = 1;
-					if (!labelElement->isDispAtTopOfDrawstopCol())
-						yPosToUse += -32;
-
-					if (yPosToUse >= 0)
-						yPosToUse = GetJambLeftRightY() + 1;
-					else
-						yPosToUse = GetJambLeftRightY() + 1 + GetJambLeftRightHeight() - 32;
-				}
-
-				if (theBmp.IsOk()) { // @suppress("Method cannot be resolved")
-					wxRect imgRect(xPosToUse, yPosToUse, labelElement->getWidth(), labelElement->getHeight());
-					TileBitmap(imgRect, dc, theBmp, labelElement->getTileOffsetX(), labelElement->getTileOffsetY());
-				}
-
-				if (labelElement->getTextBreakWidth() && labelElement->getName() != wxEmptyString) {
-					wxFont theFont = labelElement->getDispLabelFont();
-					int pointSize = theFont.GetPointSize();
-					pointSize *= m_FontScale;
-					theFont.SetPointSize(pointSize);
-					dc.SetFont(theFont);
-					dc.SetBackgroundMode(wxTRANSPARENT);
-					dc.SetTextForeground(labelElement->getDispLabelColour()->getColor());
-					wxRect textRect(
-						xPosToUse + labelElement->getTextRectLeft(),
-						yPosToUse + labelElement->getTextRectTop(),
-						labelElement->getTextRectWidth(),
-						labelElement->getTextRectHeight()
-					);
-					dc.DrawLabel(BreakTextLine(labelElement->getName(), labelElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_VERTICAL | wxALIGN_CENTER_HORIZONTAL);
-				}
-				if (m_isFirstRender) {
-					GUI_OBJECT theLabel;
-					theLabel.element = labelElement;
-					theLabel.img = NULL;
-					theLabel.boundingRect = wxRect(xPosToUse, yPosToUse, labelElement->getWidth(), labelElement->getHeight());
-					theLabel.isSelected = false;
-					m_guiObjects.push_back(theLabel);
-				}
-			}
-		}
-	}
-
-	// Draw any selection that exist
+void GUIRepresentationDrawingPanel::DrawSelection(wxDC& dc) {
+	// the selection is drawn on top of the panel view in zoomed coordinates
 	if (m_selectedObjectIndex >= 0) {
 		wxDCOverlay overlaydc(m_overlay, &dc);
 		overlaydc.Clear();
@@ -1032,398 +694,235 @@ void GUIRepresentationDrawingPanel::RenderPanel(wxDC& dc) {
 		dc.SetPen(wxPen(wxColour(*wxYELLOW), 1, wxPENSTYLE_DOT));
 		for (unsigned i = 0; i < m_guiObjects.size(); i++) {
 			if (m_guiObjects[i].isSelected)
-				dc.DrawRectangle(m_guiObjects[i].boundingRect);
+				dc.DrawRectangle(ToViewRect(m_guiObjects[i].boundingRect));
 		}
 	} else if (m_hasSelection) {
 		wxDCOverlay overlaydc(m_overlay, &dc);
 		overlaydc.Clear();
 		dc.SetBrush(*wxTRANSPARENT_BRUSH);
 		dc.SetPen(wxPen(wxColour(*wxGREEN), 1, wxPENSTYLE_DOT_DASH));
-		dc.DrawRectangle(m_selectionRect);
+		dc.DrawRectangle(ToViewRect(m_selectionRect));
 
 		// corners for adjusting selection rectangle
 		dc.SetPen(wxPen(wxColour(*wxGREEN), 1, wxPENSTYLE_SOLID));
-		dc.DrawLine(m_selectionRectLeftUpCorner.GetBottomLeft(), m_selectionRectLeftUpCorner.GetBottomRight());
-		dc.DrawLine(m_selectionRectLeftUpCorner.GetBottomRight(), m_selectionRectLeftUpCorner.GetTopRight());
-
-		dc.DrawLine(m_selectionRectRightUpCorner.GetTopLeft(), m_selectionRectRightUpCorner.GetBottomLeft());
-		dc.DrawLine(m_selectionRectRightUpCorner.GetBottomLeft(), m_selectionRectRightUpCorner.GetBottomRight());
+		dc.DrawLine(ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomRight()));
+		dc.DrawLine(ToViewCoordinates(m_selectionRectLeftUpCorner.GetBottomRight()), ToViewCoordinates(m_selectionRectLeftUpCorner.GetTopRight()));
 
-		dc.DrawLine(m_selectionRectRightDownCorner.GetBottomLeft(), m_selectionRectRightDownCorner.GetTopLeft());
-		dc.DrawLine(m_selectionRectRightDownCorner.GetTopLeft(), m_selectionRectRightDownCorner.GetTopRight());
+		dc.DrawLine(ToViewCoordinates(m_selectionRectRightUpCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomLeft()));
+		dc.DrawLine(ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectRightUpCorner.GetBottomRight()));
 
-		dc.DrawLine(m_selectionRectLeftDownCorner.GetTopLeft(), m_selectionRectLeftDownCorner.GetTopRight());
-		dc.DrawLine(m_selectionRectLeftDownCorner.GetTopRight(), m_selectionRectLeftDownCorner.GetBottomRight());
+		dc.DrawLine(ToViewCoordinates(m_selectionRectRightDownCorner.GetBottomLeft()), ToViewCoordinates(m_selectionRectRightDownCorner.GetTopLeft()));
+		dc.DrawLine(ToViewCoordinates(m_selectionRectRightDownCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectRightDownCorner.GetTopRight()));
 
+		dc.DrawLine(ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopLeft()), ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopRight()));
+		dc.DrawLine(ToViewCoordinates(m_selectionRectLeftDownCorner.GetTopRight()), ToViewCoordinates(m_selectionRectLeftDownCorner.GetBottomRight()));
 	}
-	m_isFirstRender = false;
 }
 
-void GUIRepresentationDrawingPanel::TileBitmap(wxRect rect, wxDC& dc, wxBitmap& bitmap, int tileOffsetX, int tileOffsetY) {
-	int w = bitmap.GetWidth();
-	int h = bitmap.GetHeight();
-
-	wxImage wholeImg(rect.width, rect.height);
-	wxImage bmp = bitmap.ConvertToImage();
-	for (int i = -tileOffsetX; i < rect.width; i += w) {
-		for (int j = -tileOffsetY; j < rect.height; j += h) {
-			wholeImg.Paste(bmp, i, j);
-		}
-	}
-	if (!wholeImg.IsOk())
-		return;
-
-	wxBitmap fullBmp = wxBitmap(wholeImg);
-
-	dc.DrawBitmap(fullBmp, rect.x, rect.y, true);
+void GUIRepresentationDrawingPanel::NotChangingTheSelection() {
+	m_changingLeftUpCorner = false;
+	m_changingLeftDownCorner = false;
+	m_changingRightUpCorner = false;
+	m_changingRightDownCorner = false;
+	m_selectionChangingWidth = 0;
+	m_selectionChangingHeight = 0;
 }
 
-wxPoint GUIRepresentationDrawingPanel::GetDrawstopPosition(int row, int col) {
-	wxPoint position;
-	int i;
-	if (row > 99) {
-		position.x = GetJambTopX() + (col - 1) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
-		if (m_currentPanel->getDisplayMetrics()->m_dispExtraDrawstopRowsAboveExtraButtonRows) {
-			position.y = GetJambTopDrawstop() + (row - 100) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight + 2;
-		} else {
-			position.y = GetJambTopDrawstop() + (row - 100) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight + (m_currentPanel->getDisplayMetrics()->m_dispExtraButtonRows * m_currentPanel->getDisplayMetrics()->m_dispPistonHeight) + 2;
-		}
-	} else {
-		i = m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols >> 1;
-		if (col <= i) {
-			position.x = GetJambLeftX() + (col - 1) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
-			position.y = GetJambLeftRightY() + (row - 1) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight + 32;
-		} else {
-			position.x = GetJambRightX() + (col - 1 - i) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
-			position.y = GetJambLeftRightY() + (row - 1) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight + 32;
-		}
-		if (m_currentPanel->getDisplayMetrics()->m_dispPairDrawstopCols)
-			position.x += (((col - 1) % i) >> 1) * (m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth / 4);
-
-		if (col <= i)
-			i = col;
-		else
-			i = m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols - col + 1;
-		if (m_currentPanel->getDisplayMetrics()->m_dispDrawstopColsOffset && ((i & 1) ^ m_currentPanel->getDisplayMetrics()->m_dispDrawstopOuterColOffsetUp))
-			position.y += m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight / 2;
-	}
-	return position;
+bool GUIRepresentationDrawingPanel::IsSelectionChanging() {
+	if (m_changingLeftUpCorner || m_changingLeftDownCorner || m_changingRightUpCorner || m_changingRightDownCorner)
+		return true;
+	else
+		return false;
 }
 
-wxPoint GUIRepresentationDrawingPanel::GetPushbuttonPosition(int row, int col) {
-	wxPoint position;
-	position.x = GetPistonX() + (col - 1) * m_currentPanel->getDisplayMetrics()->m_dispPistonWidth + 6;
-	if (row > 99) {
-		if (m_currentPanel->getDisplayMetrics()->m_dispExtraDrawstopRowsAboveExtraButtonRows) {
-			position.y = GetJambTopPiston() + (row - 100) * m_currentPanel->getDisplayMetrics()->m_dispPistonHeight + (m_currentPanel->getDisplayMetrics()->m_dispExtraDrawstopRows * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight) + 5;
-		} else {
-			position.y = GetJambTopPiston() + (row - 100) * m_currentPanel->getDisplayMetrics()->m_dispPistonHeight + 5;
-		}
-	} else {
-		int i = row;
-		if (i == 99)
-			i = 0;
-
-		if (i > (int) m_currentPanel->getNumberOfManuals())
-			position.y = GetHackY() - (i + 1 - (int) m_currentPanel->getNumberOfManuals()) * (m_currentPanel->getDisplayMetrics()->m_dispManualHeight + m_currentPanel->getDisplayMetrics()->m_dispPistonHeight) + m_currentPanel->getDisplayMetrics()->m_dispManualHeight + 5;
-		else {
-			if (!m_currentPanel->getHasPedals() && i > 0)
-				position.y = m_currentPanel->getGuiManualAt(i - 1)->m_renderInfo.piston_y + 5;
-			else
-				position.y = m_currentPanel->getGuiManualAt(i)->m_renderInfo.piston_y + 5;
-		}
-
-		if (m_currentPanel->getDisplayMetrics()->m_dispExtraPedalButtonRow && !row)
-			position.y += m_currentPanel->getDisplayMetrics()->m_dispPistonHeight;
-		if (m_currentPanel->getDisplayMetrics()->m_dispExtraPedalButtonRowOffset && row == 99)
-			position.x -= m_currentPanel->getDisplayMetrics()->m_dispPistonWidth / 2 + 2;
+void GUIRepresentationDrawingPanel::DoUpdateLayout() {
+	m_selectedObjectIndex = -1;
+	m_isFirstRender = true;
+	if (!m_guiObjects.empty()) {
+		m_guiObjects.clear();
 	}
-	return position;
-}
-
-unsigned GUIRepresentationDrawingPanel::GetEnclosuresWidth() {
-	return m_currentPanel->getDisplayMetrics()->m_dispEnclosureWidth * m_currentPanel->getNumberOfEnclosures();
-}
-
-int GUIRepresentationDrawingPanel::GetEnclosureY() {
-	return m_EnclosureY;
-}
-
-int GUIRepresentationDrawingPanel::GetEnclosureX(int enclosureNbr) {
-	int enclosure_x = (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetEnclosuresWidth() + 6) >> 1;
-	enclosure_x += m_currentPanel->getDisplayMetrics()->m_dispEnclosureWidth * (enclosureNbr - 1);
-
-	return enclosure_x;
-}
-
-int GUIRepresentationDrawingPanel::GetJambLeftRightWidth() {
-	int jamblrw = m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth / 2;
-	if (m_currentPanel->getDisplayMetrics()->m_dispPairDrawstopCols)
-		jamblrw += ((m_currentPanel->getDisplayMetrics()->m_dispDrawstopCols >> 2) * (m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth / 4)) - 8;
-	return jamblrw;
-}
-
-unsigned GUIRepresentationDrawingPanel::GetJambLeftRightHeight() {
-	return (m_currentPanel->getDisplayMetrics()->m_dispDrawstopRows + 1) * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight;
-}
-
-int GUIRepresentationDrawingPanel::GetJambLeftRightY() {
-	return ((int)(m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() - GetJambLeftRightHeight() - (m_currentPanel->getDisplayMetrics()->m_dispDrawstopColsOffset ? (m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight / 2) : 0))) / 2;
-}
-
-int GUIRepresentationDrawingPanel::GetJambLeftX() {
-	int jamblx = (GetCenterX() - GetJambLeftRightWidth()) >> 1;
-	if (m_currentPanel->getDisplayMetrics()->m_dispPairDrawstopCols)
-		jamblx += 5;
-	return jamblx;
-}
-
-int GUIRepresentationDrawingPanel::GetJambRightX() {
-	int jambrx = GetJambLeftX() + GetCenterX() + GetCenterWidth();
-	if (m_currentPanel->getDisplayMetrics()->m_dispPairDrawstopCols)
-		jambrx += 5;
-	return jambrx;
-}
-
-int GUIRepresentationDrawingPanel::GetJambTopDrawstop() {
-	if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
-		return GetCenterY() + 8;
-	return GetCenterY();
-}
-
-int GUIRepresentationDrawingPanel::GetJambTopPiston() {
-	if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
-		return GetCenterY() + 8;
-	return GetCenterY();
-}
-
-unsigned GUIRepresentationDrawingPanel::GetJambTopHeight() {
-	return m_currentPanel->getDisplayMetrics()->m_dispExtraDrawstopRows * m_currentPanel->getDisplayMetrics()->m_dispDrawstopHeight;
-}
-
-unsigned GUIRepresentationDrawingPanel::GetJambTopWidth() {
-	return m_currentPanel->getDisplayMetrics()->m_dispExtraDrawstopCols * m_currentPanel->getDisplayMetrics()->m_dispDrawstopWidth;
-}
-
-int GUIRepresentationDrawingPanel::GetJambTopX() {
-	return (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetJambTopWidth()) >> 1;
+	InvalidatePanelBitmap();
+	UpdateViewSize();
+	m_renderer->UpdateLayout();
+	DoPaintNow();
+	PostSizeEvent();
 }
 
-int GUIRepresentationDrawingPanel::GetJambTopY() {
-	if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
-		return GetCenterY() + 8;
-	return GetCenterY();
+void GUIRepresentationDrawingPanel::OnPanelSize(wxSizeEvent& WXUNUSED(event)) {
+	// the maximum is set first as the view can grow when zooming in
+	GetParent()->SetMaxClientSize(GetClientSize());
+	GetParent()->SetClientSize(GetClientSize());
 }
 
-unsigned GUIRepresentationDrawingPanel::GetPistonTopHeight() {
-	return m_currentPanel->getDisplayMetrics()->m_dispExtraButtonRows * m_currentPanel->getDisplayMetrics()->m_dispPistonHeight;
+void GUIRepresentationDrawingPanel::OnMouseWheel(wxMouseEvent& event) {
+	if (!m_currentPanel) {
+		event.Skip();
+		return;
+	}
+	if (event.ControlDown()) {
+		if (event.GetWheelRotation() > 0)
+			SetZoom(m_zoomIndex + 1, event.GetPosition());
+		else if (event.GetWheelRotation() < 0)
+			SetZoom(m_zoomIndex - 1, event.GetPosition());
+		return;
+	}
+	int step = event.GetWheelRotation() * event.GetLinesPerAction() * 10 / event.GetWheelDelta();
+	if (event.GetWheelAxis() == wxMOUSE_WHEEL_HORIZONTAL)
+		SetPanOffset(m_panOffset.x + step, m_panOffset.y);
+	else if (event.ShiftDown())
+		SetPanOffset(m_panOffset.x - step, m_panOffset.y);
+	else
+		SetPanOffset(m_panOffset.x, m_panOffset.y - step);
+	Refresh();
 }
 
-unsigned GUIRepresentationDrawingPanel::GetPistonWidth() {
-	return m_currentPanel->getDisplayMetrics()->m_dispButtonCols * m_currentPanel->getDisplayMetrics()->m_dispPistonWidth;
+void GUIRepresentationDrawingPanel::OnMiddleDown(wxMouseEvent& event) {
+	m_isPanning = true;
+	m_panStart = event.GetPosition();
+	m_panStartOffset = m_panOffset;
+	SetCursor(wxCursor(wxCURSOR_HAND));
 }
 
-int GUIRepresentationDrawingPanel::GetPistonX() {
-	return (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetPistonWidth()) >> 1;
+void GUIRepresentationDrawingPanel::OnMiddleUp(wxMouseEvent& WXUNUSED(event)) {
+	m_isPanning = false;
+	SetCursor(wxNullCursor);
 }
 
-int GUIRepresentationDrawingPanel::GetCenterWidth() {
-	return m_CenterWidth;
+void GUIRepresentationDrawingPanel::OnScaledTileReady(wxThreadEvent& WXUNUSED(event)) {
+	m_scaledCache->collectFinished();
+	Refresh();
 }
 
-int GUIRepresentationDrawingPanel::GetCenterY() {
-	return m_CenterY;
+int GUIRepresentationDrawingPanel::GetPanelWidth() {
+	return m_renderer->GetPanelWidth();
 }
 
-int GUIRepresentationDrawingPanel::GetCenterX() {
-	return (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetCenterWidth()) >> 1;
+int GUIRepresentationDrawingPanel::GetPanelHeight() {
+	return m_renderer->GetPanelHeight();
 }
 
-int GUIRepresentationDrawingPanel::GetHackY() {
-	return m_HackY;
+void GUIRepresentationDrawingPanel::InvalidatePanelBitmap() {
+	m_panelBitmapIsDirty = true;
 }
 
-void GUIRepresentationDrawingPanel::UpdateLayout() {
-	m_CenterY = m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() - m_currentPanel->getDisplayMetrics()->m_dispPedalHeight;
-	m_CenterWidth = std::max(GetJambTopWidth(), GetPistonWidth());
-
-	unsigned nbrManuals = m_currentPanel->getNumberOfManuals();
-	if (!nbrManuals)
-		nbrManuals = 1;
-	for (unsigned i = 0; i < nbrManuals; i++) {
-		GUIManual *theManual = m_currentPanel->getGuiManualAt(i);
-		if (!i && theManual && m_currentPanel->getHasPedals()) {
-			// this is the first manual (and a real one) on the panel and it should be a pedal
-			theManual->m_renderInfo.height = m_currentPanel->getDisplayMetrics()->m_dispPedalHeight;
-			theManual->m_renderInfo.keys_y = theManual->m_renderInfo.y = m_CenterY;
-			m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispPedalHeight;
-			if (m_currentPanel->getDisplayMetrics()->m_dispExtraPedalButtonRow)
-				m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispPistonHeight;
-			theManual->m_renderInfo.piston_y = m_CenterY;
-			m_CenterWidth = std::max(m_CenterWidth, (int)GetEnclosuresWidth());
-			m_CenterY -= 12;
-			m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispEnclosureHeight;
-			m_EnclosureY = m_CenterY;
-			m_CenterY -= 12;
-		}
-		if (!i && !m_currentPanel->getHasPedals() && m_currentPanel->getNumberOfEnclosures()) {
-			// this is if there's no pedal on the panel but there are enclosures
-			m_CenterY -= 12;
-			m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispEnclosureHeight;
-			m_EnclosureY = m_CenterY;
-			m_CenterY -= 12;
-		}
+void GUIRepresentationDrawingPanel::UpdatePanelBitmap() {
+	if (!m_panelBitmapIsDirty && m_panelBitmap.IsOk())
+		return;
+	TraceScope trace("GUIRepresentationDrawingPanel::UpdatePanelBitmap");
+	if (!m_panelBitmap.IsOk() || m_panelBitmap.GetWidth() != GetPanelWidth() || m_panelBitmap.GetHeight() != GetPanelHeight())
+		m_panelBitmap.Create(GetPanelWidth(), GetPanelHeight());
+	wxMemoryDC memDC(m_panelBitmap);
+	memDC.SetBackground(wxBrush(GetBackgroundColour()));
+	memDC.Clear();
+	m_renderer->Render(memDC, m_isFirstRender ? &m_guiObjects : NULL);
+	m_isFirstRender = false;
+	memDC.SelectObject(wxNullBitmap);
+	m_panelBitmapIsDirty = false;
+	// the scaled tiles are compared with the new rendering only when they're needed
+	m_scaledSourceIsStale = true;
+}
+
+void GUIRepresentationDrawingPanel::DrawPanelView(wxDC& dc) {
+	int scaledWidth = ScaledBitmapCache::scaleCoordinate(GetPanelWidth(), m_zoomPercent);
+	int scaledHeight = ScaledBitmapCache::scaleCoordinate(GetPanelHeight(), m_zoomPercent);
+	wxSize viewSize = GetClientSize();
+	if (scaledWidth - m_panOffset.x < viewSize.GetWidth() || scaledHeight - m_panOffset.y < viewSize.GetHeight()) {
+		dc.SetBackground(wxBrush(GetBackgroundColour()));
+		dc.Clear();
+	}
 
-		if (!theManual)
-			continue;
+	if (m_zoomPercent == 100) {
+		dc.DrawBitmap(m_panelBitmap, -m_panOffset.x, -m_panOffset.y, false);
+		return;
+	}
 
-		if (i || (i == 0 && !m_currentPanel->getHasPedals())) {
-			if (!m_currentPanel->getDisplayMetrics()->m_dispButtonsAboveManuals) {
-				m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispPistonHeight;
-				theManual->m_renderInfo.piston_y = m_CenterY;
-			}
-			theManual->m_renderInfo.height = m_currentPanel->getDisplayMetrics()->m_dispManualHeight;
-			if (m_currentPanel->getDisplayMetrics()->m_dispTrimBelowManuals && (i == 1 || (i == 0 && !m_currentPanel->getHasPedals()))) {
-				theManual->m_renderInfo.height += 8;
-				m_CenterY -= 8;
-			}
-			m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispManualHeight;
-			theManual->m_renderInfo.keys_y = m_CenterY;
-			if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveManuals && i + 1 == m_currentPanel->getNumberOfManuals()) {
-				m_CenterY -= 8;
-				theManual->m_renderInfo.height += 8;
-			}
-			if (m_currentPanel->getDisplayMetrics()->m_dispButtonsAboveManuals) {
-				m_CenterY -= m_currentPanel->getDisplayMetrics()->m_dispPistonHeight;
-				theManual->m_renderInfo.piston_y = m_CenterY;
-			}
-			theManual->m_renderInfo.y = m_CenterY;
-		}
+	if (m_scaledSourceIsStale) {
+		m_scaledCache->setSource(m_panelBitmap.ConvertToImage());
+		m_scaledSourceIsStale = false;
+	}
 
-		theManual->m_renderInfo.width = 1;
-		if (i || (i == 0 && !m_currentPanel->getHasPedals())) {
-			// this calculates the total width of a manual keyboard by adding the natural widths
-			int startingMidiNbr = theManual->getDisplayFirstNote();
-			for (int j = 0; j < theManual->getNumberOfDisplayKeys(); j++) {
-				int key_nbr = startingMidiNbr + j;
-				if (((key_nbr % 12) < 5 && !(key_nbr & 1)) || ((key_nbr % 12) >= 5 && (key_nbr & 1))) {
-					theManual->m_renderInfo.width += m_currentPanel->getDisplayMetrics()->m_dispManualKeyWidth;
+	TraceScope trace("GUIRepresentationDrawingPanel::DrawPanelView");
+	wxPoint firstVisible = ToPanelCoordinates(wxPoint(0, 0));
+	wxPoint lastVisible = ToPanelCoordinates(wxPoint(viewSize.GetWidth(), viewSize.GetHeight()));
+	int firstCol = std::max(0, firstVisible.x / ScaledBitmapCache::TILE_SIZE);
+	int lastCol = std::min(m_scaledCache->getNumberOfColumns() - 1, lastVisible.x / ScaledBitmapCache::TILE_SIZE);
+	int firstRow = std::max(0, firstVisible.y / ScaledBitmapCache::TILE_SIZE);
+	int lastRow = std::min(m_scaledCache->getNumberOfRows() - 1, lastVisible.y / ScaledBitmapCache::TILE_SIZE);
+	wxMemoryDC sourceDC;
+	bool sourceIsSelected = false;
+	for (int row = firstRow; row <= lastRow; row++) {
+		for (int col = firstCol; col <= lastCol; col++) {
+			wxRect viewRect = ToViewRect(m_scaledCache->getTileRect(col, row));
+			wxBitmap scaledTile;
+			if (m_scaledCache->getTile(col, row, m_zoomPercent, scaledTile)) {
+				dc.DrawBitmap(scaledTile, viewRect.x, viewRect.y, false);
+			} else {
+				// until the worker has scaled the tile it's stretched directly from the full size panel
+				if (!sourceIsSelected) {
+					sourceDC.SelectObjectAsSource(m_panelBitmap);
+					sourceIsSelected = true;
 				}
-			}
-		} else {
-			// this calculates the total width of a pedal
-			int startingMidiNbr = theManual->getDisplayFirstNote();
-			for (int j = 0; j < theManual->getNumberOfDisplayKeys(); j++) {
-				int key_nbr = startingMidiNbr + j;
-				theManual->m_renderInfo.width += m_currentPanel->getDisplayMetrics()->m_dispPedalKeyWidth;
-				if (j && (key_nbr % 12 == 4 || key_nbr % 12 == 11))
-					theManual->m_renderInfo.width += m_currentPanel->getDisplayMetrics()->m_dispPedalKeyWidth;
+				wxRect tileRect = m_scaledCache->getTileRect(col, row);
+				dc.StretchBlit(viewRect.x, viewRect.y, viewRect.width, viewRect.height, &sourceDC, tileRect.x, tileRect.y, tileRect.width, tileRect.height);
 			}
 		}
-		theManual->m_renderInfo.x = (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - theManual->m_renderInfo.width) >> 1;
-		theManual->m_renderInfo.width += 16;
-		if ((int)theManual->m_renderInfo.width > m_CenterWidth)
-			m_CenterWidth = theManual->m_renderInfo.width;
 	}
-
-	m_HackY = m_CenterY;
-
-	if (m_CenterWidth + GetJambLeftRightWidth() * 2 < m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue())
-		m_CenterWidth += (m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - m_CenterWidth - GetJambLeftRightWidth() * 2) / 3;
-
-	m_CenterY -= GetPistonTopHeight();
-	m_CenterY -= GetJambTopHeight();
-	if (m_currentPanel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
-		m_CenterY -= 8;
 }
 
-void GUIRepresentationDrawingPanel::NotChangingTheSelection() {
-	m_changingLeftUpCorner = false;
-	m_changingLeftDownCorner = false;
-	m_changingRightUpCorner = false;
-	m_changingRightDownCorner = false;
-	m_selectionChangingWidth = 0;
-	m_selectionChangingHeight = 0;
+void GUIRepresentationDrawingPanel::UpdateViewSize() {
+	int scaledWidth = ScaledBitmapCache::scaleCoordinate(GetPanelWidth(), m_zoomPercent);
+	int scaledHeight = ScaledBitmapCache::scaleCoordinate(GetPanelHeight(), m_zoomPercent);
+	// a panel larger than the screen is shown partly and can be panned
+	int displayNbr = wxDisplay::GetFromWindow(GetParent());
+	wxDisplay display(displayNbr != wxNOT_FOUND ? displayNbr : 0);
+	wxRect available = display.GetClientArea();
+	int viewWidth = std::min(scaledWidth, available.GetWidth() * 9 / 10);
+	int viewHeight = std::min(scaledHeight, available.GetHeight() * 9 / 10);
+	SetClientSize(viewWidth, viewHeight);
+	SetPanOffset(m_panOffset.x, m_panOffset.y);
 }
 
-bool GUIRepresentationDrawingPanel::IsSelectionChanging() {
-	if (m_changingLeftUpCorner || m_changingLeftDownCorner || m_changingRightUpCorner || m_changingRightDownCorner)
-		return true;
-	else
-		return false;
+void GUIRepresentationDrawingPanel::SetZoom(int zoomIndex, wxPoint anchor) {
+	if (!m_currentPanel || zoomIndex < 0 || zoomIndex >= NUMBER_OF_ZOOM_LEVELS || zoomIndex == m_zoomIndex)
+		return;
+	// the point of the panel under the anchor stays where it is if possible
+	wxPoint panelPoint = ToPanelCoordinates(anchor);
+	m_zoomIndex = zoomIndex;
+	m_zoomPercent = ZOOM_LEVELS[zoomIndex];
+	m_scaledCache->useZoom(m_zoomPercent);
+	m_panOffset = wxPoint(
+		ScaledBitmapCache::scaleCoordinate(panelPoint.x, m_zoomPercent) - anchor.x,
+		ScaledBitmapCache::scaleCoordinate(panelPoint.y, m_zoomPercent) - anchor.y
+	);
+	UpdateViewSize();
+	PostSizeEvent();
+	Refresh();
 }
 
-wxString GUIRepresentationDrawingPanel::BreakTextLine(wxString text, int textBreakWidth, wxDC& dc) {
-	wxString string = text;
-	wxString str, line, work;
-	wxCoord cx, cy;
-
-	/* text.Length() + 1 iterations */
-	for (unsigned i = 0; i <= string.Length(); i++) {
-		bool maybreak = false;
-		if (string[i] == wxT(' ') || string[i] == wxT('\n')) {
-			if (work.length() < 2)
-				maybreak = false;
-			else
-				maybreak = true;
-		}
-		if (maybreak || i == string.Length()) {
-			if (!work.Length())
-				continue;
-			dc.GetTextExtent(line + wxT(' ') + work, &cx, &cy);
-			if (cx > textBreakWidth) {
-				if (!str.Length())
-					str = line;
-				else
-					str = str + wxT('\n') + line;
-				line = wxT("");
-			}
-
-			if (!line.Length())
-				line = work;
-			else
-				line = line + wxT(' ') + work;
-
-			work = wxT("");
-		} else {
-			if (string[i] == wxT(' ') || string[i] == wxT('\n')) {
-				if (work.Length() && work[work.Length() - 1] != wxT(' '))
-					work += wxT(' ');
-			} else
-				work += string[i];
-		}
-	}
-
-	if (!str.Length())
-		str = line;
-	else
-		str = str + wxT('\n') + line;
-	return str;
+void GUIRepresentationDrawingPanel::SetPanOffset(int x, int y) {
+	wxSize viewSize = GetClientSize();
+	int maxX = ScaledBitmapCache::scaleCoordinate(GetPanelWidth(), m_zoomPercent) - viewSize.GetWidth();
+	int maxY = ScaledBitmapCache::scaleCoordinate(GetPanelHeight(), m_zoomPercent) - viewSize.GetHeight();
+	m_panOffset.x = std::max(0, std::min(x, maxX));
+	m_panOffset.y = std::max(0, std::min(y, maxY));
 }
 
-void GUIRepresentationDrawingPanel::DoUpdateLayout() {
-	m_selectedObjectIndex = -1;
-	m_isFirstRender = true;
-	if (!m_guiObjects.empty()) {
-		m_guiObjects.clear();
-	}
-	SetClientSize(m_currentPanel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue(), m_currentPanel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-	UpdateLayout();
-	DoPaintNow();
-	PostSizeEvent();
+wxPoint GUIRepresentationDrawingPanel::ToPanelCoordinates(wxPoint viewPoint) {
+	return wxPoint(
+		(int) std::floor((viewPoint.x + m_panOffset.x) * 100.0 / m_zoomPercent),
+		(int) std::floor((viewPoint.y + m_panOffset.y) * 100.0 / m_zoomPercent)
+	);
 }
 
-void GUIRepresentationDrawingPanel::InitFont() {
-	wxMemoryDC dc;
-	wxFont font = *wxNORMAL_FONT;
-	wxCoord cx, cy;
-	font.SetPointSize(39);
-	dc.SetFont(font);
-	dc.GetTextExtent(wxT("M"), &cx, &cy);
-	m_FontScale = 62.0 / cy;
+wxPoint GUIRepresentationDrawingPanel::ToViewCoordinates(wxPoint panelPoint) {
+	return wxPoint(
+		ScaledBitmapCache::scaleCoordinate(panelPoint.x, m_zoomPercent) - m_panOffset.x,
+		ScaledBitmapCache::scaleCoordinate(panelPoint.y, m_zoomPercent) - m_panOffset.y
+	);
 }
 
-void GUIRepresentationDrawingPanel::OnPanelSize(wxSizeEvent& WXUNUSED(event)) {
-	GetParent()->SetClientSize(GetClientSize());
-	GetParent()->SetMaxClientSize(GetClientSize());
+wxRect GUIRepresentationDrawingPanel::ToViewRect(wxRect panelRect) {
+	wxPoint topLeft = ToViewCoordinates(panelRect.GetPosition());
+	wxPoint bottomRight = ToViewCoordinates(wxPoint(panelRect.x + panelRect.width, panelRect.y + panelRect.height));
+	return wxRect(topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y);
 }
@@ -25,13 +25,8 @@
 #include "GoPanel.h"
 #include <vector>
 #include "wx/overlay.h"
-
-struct GUI_OBJECT {
-	GUIElement *element;
-	GoImage *img;
-	wxRect boundingRect;
-	bool isSelected;
-};
+#include "ScaledBitmapCache.h"
+#include "PanelRenderer.h"
 
 class GUIRepresentationDrawingPanel : public wxPanel {
 public:
@@ -45,6 +40,7 @@ private:
 	DECLARE_EVENT_TABLE()
 
 	GoPanel *m_currentPanel;
+	PanelRenderer *m_renderer;
 	std::vector<GUI_OBJECT> m_guiObjects;
 	bool m_isFirstRender;
 	wxOverlay m_overlay;
@@ -68,45 +64,36 @@ private:
 	int m_selectionChangingWidth;
 	int m_selectionChangingHeight;
 
-	int m_HackY;
-	int m_EnclosureY;
-	int m_CenterY;
-	int m_CenterWidth;
-	double m_FontScale;
+	// the panel is rendered at full size only when something has changed and
+	// zooming or panning just draw (scaled tiles of) that bitmap
+	wxBitmap m_panelBitmap;
+	bool m_panelBitmapIsDirty;
+	bool m_scaledSourceIsStale;
+	ScaledBitmapCache *m_scaledCache;
+	int m_zoomIndex;
+	int m_zoomPercent;
+	wxPoint m_panOffset; // in zoomed pixels
+	bool m_isPanning;
+	wxPoint m_panStart;
+	wxPoint m_panStartOffset;
 
-	wxPoint GetDrawstopPosition(int row, int col);
-	wxPoint GetPushbuttonPosition(int row, int col);
-	unsigned GetEnclosuresWidth();
-	int GetEnclosureY();
-	int GetEnclosureX(int enclosureNbr);
-	int GetJambLeftRightWidth();
-	unsigned GetJambLeftRightHeight();
-	int GetJambLeftRightY();
-	int GetJambLeftX();
-	int GetJambRightX();
-	int GetJambTopDrawstop();
-	int GetJambTopPiston();
-	unsigned GetJambTopHeight();
-	unsigned GetJambTopWidth();
-	int GetJambTopX();
-	int GetJambTopY();
-	unsigned GetPistonTopHeight();
-	unsigned GetPistonWidth();
-	int GetPistonX();
-	int GetCenterWidth();
-	int GetCenterY();
-	int GetCenterX();
-	int GetHackY();
-	void UpdateLayout();
 	void NotChangingTheSelection();
 	bool IsSelectionChanging();
+	int GetPanelWidth();
+	int GetPanelHeight();
+	void InvalidatePanelBitmap();
+	void UpdatePanelBitmap();
+	void UpdateViewSize();
+	void SetZoom(int zoomIndex, wxPoint anchor);
+	void SetPanOffset(int x, int y);
+	wxPoint ToPanelCoordinates(wxPoint viewPoint);
+	wxPoint ToViewCoordinates(wxPoint panelPoint);
+	wxRect ToViewRect(wxRect panelRect);
 
 	void OnPaintEvent(wxPaintEvent& event);
 	void DoPaintNow();
-	void RenderPanel(wxDC& dc);
-	void TileBitmap(wxRect rect, wxDC& dc, wxBitmap& bitmap, int tileOffsetX, int tileOffsetY);
-	wxString BreakTextLine(wxString text, int textBreakWidth, wxDC& dc);
-	void InitFont();
+	void DrawPanelView(wxDC& dc);
+	void DrawSelection(wxDC& dc);
 	void OnLeftClick(wxMouseEvent& event);
 	void OnMouseMotion(wxMouseEvent& event);
 	void OnLeftRelease(wxMouseEvent& event);
@@ -117,6 +104,10 @@ private:
 	void OnKeyboardInput(wxKeyEvent& event);
 	void OnKeyRelease(wxKeyEvent& event);
 	void OnPanelSize(wxSizeEvent& event);
+	void OnMouseWheel(wxMouseEvent& event);
+	void OnMiddleDown(wxMouseEvent& event);
+	void OnMiddleUp(wxMouseEvent& event);
+	void OnScaledTileReady(wxThreadEvent& event);
 
 };
 
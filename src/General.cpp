@@ -21,6 +21,7 @@
 #include "General.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "ReferenceIndex.h"
 
 General::General() : Button() {
 	name = wxT("New General");
@@ -318,12 +319,14 @@ unsigned General::getNumberOfTremulants() {
 
 void General::addTremulant(Tremulant *trem, bool isOn) {
 	m_tremulants.push_back(std::make_pair(trem, isOn));
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeTremulantAt(unsigned index) {
 	std::list<std::pair<Tremulant*, bool>>::iterator it = m_tremulants.begin();
 	std::advance(it, index);
 	m_tremulants.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeTremulant(Tremulant *trem) {
@@ -335,10 +338,12 @@ void General::removeTremulant(Tremulant *trem) {
 			++it;  // go to next
 		}
 	}
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeAllTremulants() {
 	m_tremulants.clear();
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 std::pair<Tremulant*, bool>* General::getTremulantPairAt(unsigned index) {
@@ -352,12 +357,14 @@ unsigned General::getNumberOfSwitches() {
 
 void General::addSwitch(GoSwitch *sw, bool isOn) {
 	m_switches.push_back(std::make_pair(sw, isOn));
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeSwitchAt(unsigned index) {
 	std::list<std::pair<GoSwitch*, bool>>::iterator it = m_switches.begin();
 	std::advance(it, index);
 	m_switches.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeSwitch(GoSwitch *sw) {
@@ -369,10 +376,12 @@ void General::removeSwitch(GoSwitch *sw) {
 			++it;  // go to next
 		}
 	}
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void General::removeAllSwitches() {
 	m_switches.clear();
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 std::pair<GoSwitch*, bool>* General::getSwitchPairAt(unsigned index) {
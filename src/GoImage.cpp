@@ -19,7 +19,10 @@
  */
 
 #include "GoImage.h"
+#include "GoPanel.h"
 #include "GOODFFunctions.h"
+#include "TraceRecorder.h"
+#include "DecodedImageCache.h"
 #include <wx/filename.h>
 
 GoImage::GoImage() {
@@ -35,6 +38,7 @@ GoImage::GoImage() {
 	m_height = 1;
 	m_tileOffsetX = 0;
 	m_tileOffsetY = 0;
+	m_owningPanel = NULL;
 }
 
 GoImage::~GoImage() {
@@ -71,6 +75,7 @@ bool GoImage::read(wxFileConfig *cfg, Organ *readOrgan) {
 	wxString relImgPath = cfg->Read("Image", wxEmptyString);
 	wxString imgPath = GOODF_functions::checkIfFileExist(relImgPath, readOrgan);
 	if (imgPath != wxEmptyString) {
+		TraceScope trace("decode image", imgPath);
 		wxImage img = wxImage(imgPath);
 		if (img.IsOk()) {
 			imageIsValid = true;
@@ -132,6 +137,7 @@ int GoImage::getHeight() const {
 
 void GoImage::setHeight(int height) {
 	m_height = height;
+	markChanged();
 }
 
 const wxString& GoImage::getImage() const {
@@ -140,6 +146,7 @@ const wxString& GoImage::getImage() const {
 
 void GoImage::setImage(wxString mImage) {
 	m_imagePath = mImage;
+	markChanged();
 }
 
 const wxString& GoImage::getMask() const {
@@ -148,6 +155,7 @@ const wxString& GoImage::getMask() const {
 
 void GoImage::setMask(wxString mask) {
 	m_maskPath = mask;
+	markChanged();
 }
 
 int GoImage::getPositionX() const {
@@ -156,6 +164,7 @@ int GoImage::getPositionX() const {
 
 void GoImage::setPositionX(int posX) {
 	m_positionX = posX;
+	markChanged();
 }
 
 int GoImage::getPositionY() const {
@@ -164,6 +173,7 @@ int GoImage::getPositionY() const {
 
 void GoImage::setPositionY(int posY) {
 	m_positionY = posY;
+	markChanged();
 }
 
 int GoImage::getTileOffsetX() const {
@@ -172,6 +182,7 @@ int GoImage::getTileOffsetX() const {
 
 void GoImage::setTileOffsetX(int tileOffsetX) {
 	m_tileOffsetX = tileOffsetX;
+	markChanged();
 }
 
 int GoImage::getTileOffsetY() const {
@@ -180,6 +191,7 @@ int GoImage::getTileOffsetY() const {
 
 void GoImage::setTileOffsetY(int tileOffsetY) {
 	m_tileOffsetY = tileOffsetY;
+	markChanged();
 }
 
 int GoImage::getWidth() const {
@@ -188,6 +200,7 @@ int GoImage::getWidth() const {
 
 void GoImage::setWidth(int width) {
 	m_width = width;
+	markChanged();
 }
 
 void GoImage::updateOwningPanelSize(int width, int height) {
@@ -260,22 +273,19 @@ wxString GoImage::getMaskNameOnly() {
 }
 
 wxBitmap GoImage::getBitmap() {
-	wxImage img(m_imagePath);
-	if (img.IsOk()) {
-		wxBitmap bmp;
-		if (m_maskPath == wxEmptyString) {
-			bmp = wxBitmap(m_imagePath, img.GetType());
-		} else {
-			wxImage maskImg(m_maskPath);
-			if (maskImg.IsOk()) {
-				img.SetMaskFromImage(maskImg, 0xFF, 0xFF, 0xFF);
-				bmp = wxBitmap(img);
-			} else {
-				bmp = wxBitmap(m_imagePath, img.GetType());
-			}
-		}
-		return bmp;
-	} else {
+	TraceScope trace("GoImage::getBitmap", m_imagePath);
+	// the decoded files are kept, drawing the image again only makes a new bitmap
+	wxImage img = DecodedImageCache::getImage(m_imagePath, m_maskPath);
+	if (!img.IsOk())
 		return wxNullBitmap;
-	}
+	return wxBitmap(img);
+}
+
+void GoImage::setOwningPanel(GoPanel *panel) {
+	m_owningPanel = panel;
+}
+
+void GoImage::markChanged() {
+	if (m_owningPanel)
+		m_owningPanel->markChanged();
 }
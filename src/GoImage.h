@@ -26,6 +26,7 @@
 #include <wx/fileconf.h>
 
 class Organ;
+class GoPanel;
 
 class GoImage {
 public:
@@ -65,6 +66,8 @@ public:
 	wxString getImageNameOnly();
 	wxString getMaskNameOnly();
 	wxBitmap getBitmap();
+	// only set for the images of a panel, not for those of gui elements
+	void setOwningPanel(GoPanel *panel);
 
 private:
 	wxString m_imagePath; // full path to file
@@ -79,6 +82,9 @@ private:
 	int m_height; // ( 0 - panel height, default: bitmap height)
 	int m_tileOffsetX; //(0 - bitmap width, default: 0)
 	int m_tileOffsetY; // 0 - bitmap height?, default: 0
+	GoPanel *m_owningPanel;
+
+	void markChanged();
 };
 
 #endif
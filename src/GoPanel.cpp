@@ -29,7 +29,10 @@
 #include "GUIReversiblePiston.h"
 #include "GUIGeneral.h"
 
+std::atomic<long> GoPanel::s_lastRevision(0);
+
 GoPanel::GoPanel() {
+	markChanged();
 	m_name = wxT("New Panel");
 	m_group = wxEmptyString;
 	m_hasPedals = false;
@@ -37,6 +40,7 @@ GoPanel::GoPanel() {
 }
 
 GoPanel::GoPanel(const GoPanel& p) {
+	markChanged();
 	m_name = p.m_name;
 	m_group = p.m_group;
 	m_hasPedals = p.m_hasPedals;
@@ -105,6 +109,7 @@ void GoPanel::write(wxTextFile *outFile, unsigned panelNbr) {
 }
 
 void GoPanel::read(wxFileConfig *cfg, wxString panelId, Organ *readOrgan) {
+	markChanged();
 	if (panelId != wxT("Panel000"))
 		m_name = cfg->Read("Name", wxEmptyString);
 	m_group = cfg->Read("Group", wxEmptyString);
@@ -135,6 +140,7 @@ wxString GoPanel::getName() {
 }
 
 void GoPanel::setName(wxString name) {
+	markChanged();
 	m_name = name;
 }
 
@@ -143,6 +149,7 @@ wxString GoPanel::getGroup() {
 }
 
 void GoPanel::setGroup(wxString group) {
+	markChanged();
 	m_group = group;
 }
 
@@ -151,6 +158,7 @@ bool GoPanel::getHasPedals() {
 }
 
 void GoPanel::setHasPedals(bool hasPedals) {
+	markChanged();
 	m_hasPedals = hasPedals;
 	updateGuiManuals();
 }
@@ -181,10 +189,13 @@ GoImage* GoPanel::getImageAt(unsigned index) {
 }
 
 void GoPanel::addImage(GoImage image) {
+	markChanged();
 	m_images.push_back(image);
+	m_images.back().setOwningPanel(this);
 }
 
 void GoPanel::removeImageAt(unsigned index) {
+	markChanged();
 	std::list<GoImage>::iterator it = m_images.begin();
 	std::advance(it, index);
 	m_images.erase(it);
@@ -201,17 +212,27 @@ void GoPanel::removeImage(GoImage *image) {
 	}
 }
 
+long GoPanel::getRevision() const {
+	return m_revision;
+}
+
+void GoPanel::markChanged() {
+	m_revision = ++s_lastRevision;
+}
+
 DisplayMetrics* GoPanel::getDisplayMetrics() {
 	return &m_displayMetrics;
 }
 
 void GoPanel::addGuiElement(GUIElement *element) {
+	markChanged();
 	m_guiElements.push_back(element);
 	updateGuiManuals();
 	updateGuiEnclosures();
 }
 
 void GoPanel::removeGuiElementAt(unsigned index) {
+	markChanged();
 	std::list<GUIElement*>::iterator it = m_guiElements.begin();
 	std::advance(it, index);
 	delete *it;
@@ -229,6 +250,22 @@ GUIElement* GoPanel::getGuiElementAt(unsigned index) {
 	return *iterator;
 }
 
+unsigned GoPanel::getIndexOfGuiElement(GUIElement *element) {
+	unsigned i = 0;
+	bool found = false;
+	for (GUIElement *e : m_guiElements) {
+		i++;
+		if (e == element) {
+			found = true;
+			break;
+		}
+	}
+	if (found)
+		return i;
+	else
+		return 0;
+}
+
 bool GoPanel::hasItemAsGuiElement(Tremulant* trem) {
 	for (GUIElement* e : m_guiElements) {
 		if (e->getType() == wxT("Tremulant")) {
@@ -243,6 +280,7 @@ bool GoPanel::hasItemAsGuiElement(Tremulant* trem) {
 }
 
 void GoPanel::removeItemFromPanel(Tremulant* trem) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Tremulant")) {
@@ -280,6 +318,7 @@ bool GoPanel::hasItemAsGuiElement(Enclosure* enclosure) {
 }
 
 void GoPanel::removeItemFromPanel(Enclosure* enclosure) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Enclosure")) {
@@ -319,6 +358,7 @@ bool GoPanel::hasItemAsGuiElement(Manual *manual) {
 }
 
 void GoPanel::removeItemFromPanel(Manual *manual) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Manual")) {
@@ -358,6 +398,7 @@ bool GoPanel::hasItemAsGuiElement(Stop *stop) {
 }
 
 void GoPanel::removeItemFromPanel(Stop *stop) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Stop")) {
@@ -395,6 +436,7 @@ bool GoPanel::hasItemAsGuiElement(Coupler *coupler) {
 }
 
 void GoPanel::removeItemFromPanel(Coupler *coupler) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Coupler")) {
@@ -432,6 +474,7 @@ bool GoPanel::hasItemAsGuiElement(Divisional *divisional) {
 }
 
 void GoPanel::removeItemFromPanel(Divisional *divisional) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Divisional")) {
@@ -469,6 +512,7 @@ bool GoPanel::hasItemAsGuiElement(GoSwitch *sw) {
 }
 
 void GoPanel::removeItemFromPanel(GoSwitch *sw) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("Switch")) {
@@ -506,6 +550,7 @@ bool GoPanel::hasItemAsGuiElement(DivisionalCoupler *divCplr) {
 }
 
 void GoPanel::removeItemFromPanel(DivisionalCoupler *divCplr) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("DivisionalCoupler")) {
@@ -543,6 +588,7 @@ bool GoPanel::hasItemAsGuiElement(ReversiblePiston *revPist) {
 }
 
 void GoPanel::removeItemFromPanel(ReversiblePiston *revPist) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("ReversiblePiston")) {
@@ -580,6 +626,7 @@ bool GoPanel::hasItemAsGuiElement(General *general) {
 }
 
 void GoPanel::removeItemFromPanel(General *general) {
+	markChanged();
 	auto it = m_guiElements.begin();
 	while (it != m_guiElements.end()) {
 		if((*it)->getType() == wxT("General")) {
@@ -610,6 +657,7 @@ void GoPanel::updateGuiElementsDisplayNames() {
 }
 
 void GoPanel::moveGuiElement(int sourceIndex, int toBeforeIndex) {
+	markChanged();
 	auto theOneToMove = std::next(m_guiElements.begin(), sourceIndex);
 	std::list<GUIElement*>::iterator it = m_guiElements.begin();
 
@@ -623,6 +671,7 @@ void GoPanel::moveGuiElement(int sourceIndex, int toBeforeIndex) {
 }
 
 void GoPanel::updateButtonRowsAndCols() {
+	markChanged();
 	for (GUIElement* e : m_guiElements) {
 		GUIButton *btnElement = dynamic_cast<GUIButton*>(e);
 		if (btnElement) {
@@ -645,6 +694,7 @@ void GoPanel::updateButtonRowsAndCols() {
 }
 
 void GoPanel::applyButtonFontName() {
+	markChanged();
 	for (GUIElement* e : m_guiElements) {
 		GUIButton *btnElement = dynamic_cast<GUIButton*>(e);
 		if (btnElement) {
@@ -656,6 +706,7 @@ void GoPanel::applyButtonFontName() {
 }
 
 void GoPanel::applyButtonFontSize() {
+	markChanged();
 	for (GUIElement* e : m_guiElements) {
 		GUIButton *btnElement = dynamic_cast<GUIButton*>(e);
 		if (btnElement) {
@@ -666,6 +717,7 @@ void GoPanel::applyButtonFontSize() {
 }
 
 void GoPanel::applyLabelFontName() {
+	markChanged();
 	for (GUIElement* e : m_guiElements) {
 		GUILabel *lblElement = dynamic_cast<GUILabel*>(e);
 		if (lblElement) {
@@ -676,6 +728,7 @@ void GoPanel::applyLabelFontName() {
 	}
 }
 void GoPanel::applyLabelFontSize() {
+	markChanged();
 	for (GUIElement* e : m_guiElements) {
 		GUILabel *lblElement = dynamic_cast<GUILabel*>(e);
 		if (lblElement) {
@@ -25,6 +25,7 @@
 #include <wx/textfile.h>
 #include <wx/fileconf.h>
 #include <list>
+#include <atomic>
 #include "GoImage.h"
 #include "DisplayMetrics.h"
 #include "GUIElements.h"
@@ -58,11 +59,16 @@ public:
 	void addImage(GoImage image);
 	void removeImageAt(unsigned index);
 	void removeImage(GoImage *image);
+	// a new value whenever the panel, its display metrics, images or gui
+	// elements are changed
+	long getRevision() const;
+	void markChanged();
 	DisplayMetrics* getDisplayMetrics();
 	void addGuiElement(GUIElement *element);
 	void removeGuiElementAt(unsigned index);
 	int getNumberOfGuiElements();
 	GUIElement* getGuiElementAt(unsigned index);
+	unsigned getIndexOfGuiElement(GUIElement *element);
 	bool hasItemAsGuiElement(Tremulant *trem);
 	void removeItemFromPanel(Tremulant *trem);
 	bool hasItemAsGuiElement(Enclosure *enclosure);
@@ -110,6 +116,8 @@ private:
 	bool m_isGuiElementFirstRemoval;
 	std::list<GUIManual*> m_manuals;
 	std::list<GUIEnclosure*> m_enclosures;
+	long m_revision;
+	static std::atomic<long> s_lastRevision;
 
 };
 
@@ -24,6 +24,7 @@
 #include "GoImage.h"
 #include <wx/statline.h>
 #include <wx/msgdlg.h>
+#include <wx/filedlg.h>
 #include "GUIElements.h"
 #include "GUIManual.h"
 #include "GUIStop.h"
@@ -36,6 +37,7 @@
 #include "GUIDivisionalCoupler.h"
 #include "GUIGeneral.h"
 #include "GUILabel.h"
+#include "PanelRenderer.h"
 
 // Event table
 BEGIN_EVENT_TABLE(GoPanelPanel, wxPanel)
@@ -50,6 +52,7 @@ BEGIN_EVENT_TABLE(GoPanelPanel, wxPanel)
 	EVT_BUTTON(ID_PANEL_LABEL_ELEMENT_BTN, GoPanelPanel::OnLabelBtn)
 	EVT_BUTTON(ID_PANEL_REMOVE_BTN, GoPanelPanel::OnRemovePanelBtn)
 	EVT_BUTTON(ID_PANEL_SHOW_PANEL_BTN, GoPanelPanel::OnShowPanelBtn)
+	EVT_BUTTON(ID_PANEL_EXPORT_PNG_BTN, GoPanelPanel::OnExportPngBtn)
 END_EVENT_TABLE()
 
 GoPanelPanel::GoPanelPanel(wxWindow *parent) : wxPanel(parent) {
@@ -127,6 +130,12 @@ GoPanelPanel::GoPanelPanel(wxWindow *parent) : wxPanel(parent) {
 		wxT("Show panel layout")
 	);
 	secondRow->Add(m_showPanelBtn, 0, wxALIGN_CENTER|wxALL, 5);
+	m_exportPngBtn = new wxButton(
+		this,
+		ID_PANEL_EXPORT_PNG_BTN,
+		wxT("Export as PNG...")
+	);
+	secondRow->Add(m_exportPngBtn, 0, wxALIGN_CENTER|wxALL, 5);
 	panelSizer->Add(secondRow, 0, wxGROW);
 
 	wxBoxSizer *choiceRow = new wxBoxSizer(wxHORIZONTAL);
@@ -627,6 +636,26 @@ void GoPanelPanel::OnShowPanelBtn(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void GoPanelPanel::OnExportPngBtn(wxCommandEvent& WXUNUSED(event)) {
+	wxFileDialog fileDialog(
+		this,
+		wxT("Export panel rendering as PNG"),
+		::wxGetApp().m_frame->m_organ->getOdfRoot(),
+		m_panel->getName() + wxT(".png"),
+		"PNG files (*.png)|*.png",
+		wxFD_SAVE|wxFD_OVERWRITE_PROMPT
+	);
+
+	if (fileDialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	PanelRenderer renderer(m_panel);
+	if (!renderer.ExportToPng(fileDialog.GetPath())) {
+		wxLogError("Could not export panel '%s' to %s", m_panel->getName(), fileDialog.GetPath());
+		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+	}
+}
+
 void GoPanelPanel::ShouldCombinationControlsBeEnabled() {
 	if (m_setterElementsChoice->GetSelection() != wxNOT_FOUND) {
 		// A setter element was selected
@@ -673,6 +702,7 @@ void GoPanelPanel::setTooltipsEnabled(bool isEnabled) {
 		m_labelElementBtn->SetToolTip(wxT("Label elements can be added to the panel as GUI Elements."));
 		m_manualChoice->SetToolTip(wxT("For the setter divisionals the manual they affect is chosen here."));
 		m_combinationNumberSpin->SetToolTip(wxT("For the setter generals and divisionals the combination number should be set here. NOTE: The divisionals are numbered starting with zero indexing, thus divisional 1 is actually entered as 0, divisional 2 is entered as 1 etc."));
+		m_exportPngBtn->SetToolTip(wxT("The panel is rendered offscreen at its full size and saved as a PNG image."));
 		m_showPanelBtn->SetToolTip(wxT("A graphical rendering of the panel will be shown where adjustments of positioning of elements can be done (which will change the layout method used to absolute positioning for adjusted elements)."));
 	} else {
 		m_groupField->SetToolTip(wxEmptyString);
@@ -686,6 +716,7 @@ void GoPanelPanel::setTooltipsEnabled(bool isEnabled) {
 		m_manualChoice->SetToolTip(wxEmptyString);
 		m_combinationNumberSpin->SetToolTip(wxEmptyString);
 		m_showPanelBtn->SetToolTip(wxEmptyString);
+		m_exportPngBtn->SetToolTip(wxEmptyString);
 	}
 }
 
@@ -53,6 +53,7 @@ private:
 	wxChoice *m_manualChoice;
 	wxSpinCtrl *m_combinationNumberSpin;
 	wxButton *m_showPanelBtn;
+	wxButton *m_exportPngBtn;
 	GUIPanelRepresentation *m_guiRepresentation;
 
 	GoPanel *m_panel;
@@ -71,6 +72,7 @@ private:
 	void OnElementChoiceBtn(wxCommandEvent& event);
 	void OnLabelBtn(wxCommandEvent& event);
 	void OnShowPanelBtn(wxCommandEvent& event);
+	void OnExportPngBtn(wxCommandEvent& event);
 	void ShouldCombinationControlsBeEnabled();
 
 };
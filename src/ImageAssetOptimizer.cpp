@@ -0,0 +1,349 @@
+/*
+ * ImageAssetOptimizer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ImageAssetOptimizer.h"
+#include "ParallelTaskRunner.h"
+#include "GUIButton.h"
+#include "GUIEnclosure.h"
+#include "GUILabel.h"
+#include "GUIManual.h"
+#include "TraceRecorder.h"
+#include <wx/filename.h>
+#include <cstring>
+#include <algorithm>
+
+ImageAssetOptimizer::ImageAssetOptimizer(Organ *organ, unsigned nbrOfThreads) {
+	m_organ = organ;
+	m_nbrOfThreads = nbrOfThreads;
+	m_bytesSavedByReencoding = 0;
+
+	collectImageReferences(m_organ, [this](const wxString &fullPath, const wxString &description, std::function<void(const wxString&)> setPath, GUIManual *manual) {
+		addUsage(fullPath, description, setPath, manual);
+	});
+}
+
+ImageAssetOptimizer::~ImageAssetOptimizer() {
+
+}
+
+void ImageAssetOptimizer::collectImageReferences(Organ *organ, IMAGE_REFERENCE_VISITOR visit) {
+	auto visitGoImage = [](IMAGE_REFERENCE_VISITOR &visit, GoImage *image, const wxString &description, GUIManual *manual) {
+		visit(image->getImage(), description, [image](const wxString &path) { image->setImage(path); }, manual);
+		visit(image->getMask(), description + wxT(" mask"), [image](const wxString &path) { image->setMask(path); }, manual);
+	};
+
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+		GoPanel *panel = organ->getOrganPanelAt(i);
+		wxString panelName = wxT("Panel '") + panel->getName() + wxT("' ");
+		for (unsigned j = 0; j < panel->getNumberOfImages(); j++)
+			visitGoImage(visit, panel->getImageAt(j), panelName + wxString::Format(wxT("Image%0.3d"), j + 1), NULL);
+
+		for (unsigned j = 0; j < panel->getNumberOfGuiElements(); j++) {
+			GUIElement *element = panel->getGuiElementAt(j);
+			wxString elementName = panelName + element->getDisplayName();
+			if (GUIButton *btn = dynamic_cast<GUIButton*>(element)) {
+				visit(btn->getImageOn(), elementName + wxT(" ImageOn"), [btn](const wxString &path) { btn->setImageOn(path); }, NULL);
+				visit(btn->getImageOff(), elementName + wxT(" ImageOff"), [btn](const wxString &path) { btn->setImageOff(path); }, NULL);
+				visit(btn->getMaskOn(), elementName + wxT(" MaskOn"), [btn](const wxString &path) { btn->setMaskOn(path); }, NULL);
+				visit(btn->getMaskOff(), elementName + wxT(" MaskOff"), [btn](const wxString &path) { btn->setMaskOff(path); }, NULL);
+			} else if (GUIEnclosure *enc = dynamic_cast<GUIEnclosure*>(element)) {
+				for (unsigned k = 0; k < enc->getNumberOfBitmaps(); k++)
+					visitGoImage(visit, enc->getBitmapAtIndex(k), elementName + wxString::Format(wxT(" Bitmap%0.3d"), k + 1), NULL);
+			} else if (GUILabel *label = dynamic_cast<GUILabel*>(element)) {
+				visitGoImage(visit, label->getImage(), elementName + wxT(" Image"), NULL);
+			} else if (GUIManual *manual = dynamic_cast<GUIManual*>(element)) {
+				for (unsigned k = 0; k < manual->getNumberOfKeytypes(); k++) {
+					KEYTYPE *key = manual->getKeytypeAt(k);
+					wxString keyName = elementName + wxT(" ") + key->KeytypeIdentifier;
+					visitGoImage(visit, &key->ImageOn, keyName + wxT(" ImageOn"), manual);
+					visitGoImage(visit, &key->ImageOff, keyName + wxT(" ImageOff"), manual);
+				}
+			}
+		}
+	}
+}
+
+bool ImageAssetOptimizer::scan(wxProgressDialog *progress) {
+	ParallelTaskRunner runner(m_nbrOfThreads);
+
+	if (!runner.run(m_files.size(), [this](unsigned i) { probeFile(m_files[i]); }, progress, wxT("Decoding images...")))
+		return false;
+
+	// equal hashes are confirmed by comparing the pixels against the first file with that hash
+	std::map<uint64_t, std::vector<unsigned>> hashBuckets;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		if (m_files[i].isReadable)
+			hashBuckets[m_files[i].hash].push_back(i);
+	}
+	std::vector<std::pair<unsigned, unsigned>> comparisons;
+	for (auto &bucket : hashBuckets) {
+		for (unsigned i = 1; i < bucket.second.size(); i++)
+			comparisons.push_back(std::make_pair(bucket.second.front(), bucket.second[i]));
+	}
+	std::vector<char> isSame(comparisons.size(), 0);
+	if (!runner.run(comparisons.size(), [this, &comparisons, &isSame](unsigned i) {
+		isSame[i] = hasSamePixels(m_files[comparisons[i].first].fullPath, m_files[comparisons[i].second].fullPath) ? 1 : 0;
+	}, progress, wxT("Comparing duplicate candidates...")))
+		return false;
+
+	std::map<unsigned, std::vector<unsigned>> groupsByFirst;
+	for (unsigned i = 0; i < comparisons.size(); i++) {
+		if (!isSame[i])
+			continue;
+		std::vector<unsigned> &group = groupsByFirst[comparisons[i].first];
+		if (group.empty())
+			group.push_back(comparisons[i].first);
+		group.push_back(comparisons[i].second);
+	}
+	for (auto &group : groupsByFirst) {
+		// a png is kept rather than a bmp so that less has to be written again
+		std::vector<unsigned> files = group.second;
+		std::stable_partition(files.begin(), files.end(), [this](unsigned idx) { return m_files[idx].type == wxBITMAP_TYPE_PNG; });
+		m_groups.push_back(files);
+	}
+	return true;
+}
+
+unsigned ImageAssetOptimizer::getNumberOfFiles() {
+	return m_files.size();
+}
+
+IMAGE_FILE* ImageAssetOptimizer::getFileAt(unsigned index) {
+	return &m_files[index];
+}
+
+wxString ImageAssetOptimizer::getUsageDescription(unsigned usageIndex) {
+	return m_usages[usageIndex].description;
+}
+
+unsigned ImageAssetOptimizer::getNumberOfGroups() {
+	return m_groups.size();
+}
+
+const std::vector<unsigned>& ImageAssetOptimizer::getGroupAt(unsigned index) {
+	return m_groups[index];
+}
+
+unsigned ImageAssetOptimizer::getNumberOfDuplicateFiles() {
+	unsigned nbr = 0;
+	for (std::vector<unsigned> &group : m_groups)
+		nbr += group.size() - 1;
+	return nbr;
+}
+
+wxULongLong ImageAssetOptimizer::getRedundantBytes() {
+	wxULongLong bytes = 0;
+	for (std::vector<unsigned> &group : m_groups) {
+		for (unsigned i = 1; i < group.size(); i++)
+			bytes += m_files[group[i]].fileSize;
+	}
+	return bytes;
+}
+
+unsigned ImageAssetOptimizer::getNumberOfReencodableFiles() {
+	unsigned nbr = 0;
+	for (IMAGE_FILE &file : m_files) {
+		if (isReencodable(file))
+			nbr++;
+	}
+	return nbr;
+}
+
+wxULongLong ImageAssetOptimizer::getBytesSavedByReencoding() {
+	return m_bytesSavedByReencoding;
+}
+
+unsigned ImageAssetOptimizer::makePathsShared() {
+	unsigned nbrChanged = 0;
+	std::vector<GUIManual*> changedManuals;
+	for (std::vector<unsigned> &group : m_groups) {
+		IMAGE_FILE &kept = m_files[group.front()];
+		for (unsigned i = 1; i < group.size(); i++) {
+			IMAGE_FILE &duplicate = m_files[group[i]];
+			nbrChanged += duplicate.usages.size();
+			redirectUsages(duplicate, kept.fullPath, changedManuals);
+			// the usages now belong to the kept file in case it's written again as png
+			for (unsigned usageIdx : duplicate.usages)
+				m_usages[usageIdx].fileIndex = group.front();
+			kept.usages.insert(kept.usages.end(), duplicate.usages.begin(), duplicate.usages.end());
+			duplicate.usages.clear();
+		}
+	}
+	m_groups.clear();
+	for (GUIManual *manual : changedManuals)
+		manual->invalidateKeyInfo();
+	return nbrChanged;
+}
+
+unsigned ImageAssetOptimizer::reencodeToPng(wxProgressDialog *progress) {
+	// the new names are chosen first so that no two files get the same one
+	std::vector<unsigned> candidates;
+	std::vector<wxString> targets;
+	std::set<wxString> reserved;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		if (!isReencodable(m_files[i]))
+			continue;
+		wxString target = getUnusedPngPath(m_files[i].fullPath, reserved);
+		reserved.insert(target);
+		candidates.push_back(i);
+		targets.push_back(target);
+	}
+
+	std::vector<char> isWritten(candidates.size(), 0);
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	runner.run(candidates.size(), [this, &candidates, &targets, &isWritten](unsigned i) {
+		TraceScope trace("ImageAssetOptimizer::writePng", targets[i]);
+		wxLogNull logNo;
+		wxImage img;
+		if (!img.LoadFile(m_files[candidates[i]].fullPath))
+			return;
+		img.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL, 9);
+		if (!img.SaveFile(targets[i], wxBITMAP_TYPE_PNG))
+			return;
+		// a png that isn't smaller than the original isn't worth switching to
+		if (wxFileName::GetSize(targets[i]) >= m_files[candidates[i]].fileSize) {
+			wxRemoveFile(targets[i]);
+			return;
+		}
+		isWritten[i] = 1;
+	}, progress, wxT("Writing png files..."));
+
+	unsigned nbrChanged = 0;
+	std::vector<GUIManual*> changedManuals;
+	for (unsigned i = 0; i < candidates.size(); i++) {
+		if (!isWritten[i])
+			continue;
+		IMAGE_FILE &file = m_files[candidates[i]];
+		wxULongLong pngSize = wxFileName::GetSize(targets[i]);
+		m_bytesSavedByReencoding += file.fileSize - pngSize;
+		nbrChanged += file.usages.size();
+		redirectUsages(file, targets[i], changedManuals);
+		file.fullPath = targets[i];
+		file.type = wxBITMAP_TYPE_PNG;
+		file.fileSize = pngSize;
+	}
+	for (GUIManual *manual : changedManuals)
+		manual->invalidateKeyInfo();
+	return nbrChanged;
+}
+
+void ImageAssetOptimizer::addUsage(const wxString &fullPath, const wxString &description, std::function<void(const wxString&)> setPath, GUIManual *manual) {
+	if (fullPath.IsEmpty())
+		return;
+
+	unsigned fileIndex;
+	std::map<wxString, unsigned>::iterator existing = m_fileIndexByPath.find(fullPath);
+	if (existing != m_fileIndexByPath.end()) {
+		fileIndex = existing->second;
+	} else {
+		fileIndex = m_files.size();
+		m_fileIndexByPath[fullPath] = fileIndex;
+		IMAGE_FILE file;
+		file.fullPath = fullPath;
+		file.isReadable = false;
+		file.type = wxBITMAP_TYPE_INVALID;
+		file.fileSize = 0;
+		file.hash = 0;
+		m_files.push_back(file);
+	}
+	IMAGE_USAGE usage;
+	usage.description = description;
+	usage.setPath = setPath;
+	usage.manual = manual;
+	usage.fileIndex = fileIndex;
+	m_files[fileIndex].usages.push_back(m_usages.size());
+	m_usages.push_back(usage);
+}
+
+void ImageAssetOptimizer::probeFile(IMAGE_FILE &file) {
+	TraceScope trace("ImageAssetOptimizer::probeFile", file.fullPath);
+	// missing files are simply not candidates, don't flood the log from the worker threads
+	wxLogNull logNo;
+	wxImage img;
+	if (!img.LoadFile(file.fullPath))
+		return;
+	file.type = img.GetType();
+	file.fileSize = wxFileName::GetSize(file.fullPath);
+	file.hash = hashPixels(img);
+	file.isReadable = true;
+}
+
+bool ImageAssetOptimizer::isReencodable(IMAGE_FILE &file) {
+	return file.isReadable && !file.usages.empty() && file.type == wxBITMAP_TYPE_BMP;
+}
+
+void ImageAssetOptimizer::redirectUsages(IMAGE_FILE &file, const wxString &fullPath, std::vector<GUIManual*> &changedManuals) {
+	for (unsigned usageIdx : file.usages) {
+		IMAGE_USAGE &usage = m_usages[usageIdx];
+		usage.setPath(fullPath);
+		if (usage.manual && std::find(changedManuals.begin(), changedManuals.end(), usage.manual) == changedManuals.end())
+			changedManuals.push_back(usage.manual);
+	}
+}
+
+uint64_t ImageAssetOptimizer::hashPixels(const wxImage &image) {
+	// 64 bit FNV-1a of the size, the pixels and whatever makes them transparent
+	uint64_t hash = 14695981039346656037ULL;
+	auto addBytes = [&hash](const unsigned char *data, size_t length) {
+		for (size_t i = 0; i < length; i++) {
+			hash ^= data[i];
+			hash *= 1099511628211ULL;
+		}
+	};
+	int size[2] = { image.GetWidth(), image.GetHeight() };
+	addBytes((const unsigned char*) size, sizeof(size));
+	size_t nbrOfPixels = (size_t) image.GetWidth() * image.GetHeight();
+	addBytes(image.GetData(), nbrOfPixels * 3);
+	if (image.HasAlpha())
+		addBytes(image.GetAlpha(), nbrOfPixels);
+	if (image.HasMask()) {
+		unsigned char mask[3] = { image.GetMaskRed(), image.GetMaskGreen(), image.GetMaskBlue() };
+		addBytes(mask, sizeof(mask));
+	}
+	return hash;
+}
+
+bool ImageAssetOptimizer::hasSamePixels(const wxString &pathA, const wxString &pathB) {
+	wxLogNull logNo;
+	wxImage a;
+	wxImage b;
+	if (!a.LoadFile(pathA) || !b.LoadFile(pathB))
+		return false;
+	if (a.GetSize() != b.GetSize() || a.HasAlpha() != b.HasAlpha() || a.HasMask() != b.HasMask())
+		return false;
+	if (a.HasMask() && (a.GetMaskRed() != b.GetMaskRed() || a.GetMaskGreen() != b.GetMaskGreen() || a.GetMaskBlue() != b.GetMaskBlue()))
+		return false;
+	size_t nbrOfPixels = (size_t) a.GetWidth() * a.GetHeight();
+	if (std::memcmp(a.GetData(), b.GetData(), nbrOfPixels * 3) != 0)
+		return false;
+	if (a.HasAlpha() && std::memcmp(a.GetAlpha(), b.GetAlpha(), nbrOfPixels) != 0)
+		return false;
+	return true;
+}
+
+wxString ImageAssetOptimizer::getUnusedPngPath(const wxString &fullPath, const std::set<wxString> &reserved) {
+	wxFileName target(fullPath);
+	wxString name = target.GetName();
+	target.SetExt(wxT("png"));
+	int suffix = 1;
+	while (target.FileExists() || reserved.count(target.GetFullPath()))
+		target.SetName(name + wxString::Format(wxT("_%d"), suffix++));
+	return target.GetFullPath();
+}
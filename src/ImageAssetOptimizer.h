@@ -0,0 +1,107 @@
+/*
+ * ImageAssetOptimizer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef IMAGEASSETOPTIMIZER_H
+#define IMAGEASSETOPTIMIZER_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <functional>
+#include <cstdint>
+#include "Organ.h"
+
+class GUIManual;
+
+struct IMAGE_USAGE {
+	wxString description;
+	std::function<void(const wxString&)> setPath;
+	GUIManual *manual; // only set for key images that the manual caches
+	unsigned fileIndex;
+};
+
+// called for every image or mask reference with the function that changes it
+typedef std::function<void(const wxString &fullPath, const wxString &description, std::function<void(const wxString&)> setPath, GUIManual *manual)> IMAGE_REFERENCE_VISITOR;
+
+struct IMAGE_FILE {
+	wxString fullPath;
+	std::vector<unsigned> usages;
+	bool isReadable;
+	wxBitmapType type;
+	wxULongLong fileSize;
+	uint64_t hash;
+};
+
+// Finds the image and mask files used on the panels of an organ (panel
+// images, button, enclosure, label and manual key images) that decode to
+// identical pixels even though they are different files. All files are
+// decoded and hashed in parallel and equal hashes are confirmed by comparing
+// the pixels. The references to duplicates can then be pointed to one file,
+// and BMP files can be written again as compressed PNG files next to them.
+class ImageAssetOptimizer {
+
+public:
+	ImageAssetOptimizer(Organ *organ, unsigned nbrOfThreads = 0);
+	~ImageAssetOptimizer();
+
+	// visits the image references of all panels, also the empty ones
+	static void collectImageReferences(Organ *organ, IMAGE_REFERENCE_VISITOR visit);
+
+	// returns false if aborted from the progress dialog
+	bool scan(wxProgressDialog *progress = NULL);
+
+	unsigned getNumberOfFiles();
+	IMAGE_FILE* getFileAt(unsigned index);
+	wxString getUsageDescription(unsigned usageIndex);
+	unsigned getNumberOfGroups();
+	// file indices where the first one is the file to keep
+	const std::vector<unsigned>& getGroupAt(unsigned index);
+	unsigned getNumberOfDuplicateFiles();
+	wxULongLong getRedundantBytes();
+	// used files that would be written again as png
+	unsigned getNumberOfReencodableFiles();
+	wxULongLong getBytesSavedByReencoding();
+
+	// both return the number of changed references, the original files are
+	// left as they are
+	unsigned makePathsShared();
+	unsigned reencodeToPng(wxProgressDialog *progress = NULL);
+
+private:
+	Organ *m_organ;
+	unsigned m_nbrOfThreads;
+	std::vector<IMAGE_USAGE> m_usages;
+	std::vector<IMAGE_FILE> m_files;
+	std::map<wxString, unsigned> m_fileIndexByPath;
+	std::vector<std::vector<unsigned>> m_groups;
+	wxULongLong m_bytesSavedByReencoding;
+
+	void addUsage(const wxString &fullPath, const wxString &description, std::function<void(const wxString&)> setPath, GUIManual *manual = NULL);
+	void probeFile(IMAGE_FILE &file);
+	bool isReencodable(IMAGE_FILE &file);
+	void redirectUsages(IMAGE_FILE &file, const wxString &fullPath, std::vector<GUIManual*> &changedManuals);
+	static uint64_t hashPixels(const wxImage &image);
+	static bool hasSamePixels(const wxString &pathA, const wxString &pathB);
+	static wxString getUnusedPngPath(const wxString &fullPath, const std::set<wxString> &reserved);
+};
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * ImageAssetsDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ImageAssetsDialog.h"
+#include "GOODFDef.h"
+#include "GOODFFunctions.h"
+#include <wx/statline.h>
+#include <wx/progdlg.h>
+#include <wx/filename.h>
+
+IMPLEMENT_CLASS(ImageAssetsDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(ImageAssetsDialog, wxDialog)
+	EVT_CHECKBOX(ID_IMAGE_ASSETS_SHARE_CHECK, ImageAssetsDialog::OnRewriteSelection)
+	EVT_CHECKBOX(ID_IMAGE_ASSETS_PNG_CHECK, ImageAssetsDialog::OnRewriteSelection)
+END_EVENT_TABLE()
+
+ImageAssetsDialog::ImageAssetsDialog(Organ *organ) {
+	Init(organ);
+}
+
+ImageAssetsDialog::ImageAssetsDialog(
+	Organ *organ,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(organ);
+	Create(parent, id, caption, pos, size, style);
+}
+
+ImageAssetsDialog::~ImageAssetsDialog() {
+	if (m_optimizer)
+		delete m_optimizer;
+}
+
+void ImageAssetsDialog::Init(Organ *organ) {
+	m_organ = organ;
+	m_optimizer = NULL;
+	m_scanComplete = false;
+	m_duplicatesList = NULL;
+	m_sharePathsCheck = NULL;
+	m_reencodeCheck = NULL;
+}
+
+bool ImageAssetsDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	m_optimizer = new ImageAssetOptimizer(m_organ);
+	wxProgressDialog progress(
+		wxT("Searching for duplicate images"),
+		wxEmptyString,
+		100,
+		parent,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	m_scanComplete = m_optimizer->scan(&progress);
+	progress.Hide();
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void ImageAssetsDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxString summary;
+	if (!m_scanComplete) {
+		summary = wxT("The search was cancelled.");
+	} else {
+		summary = wxString::Format(
+			wxT("%u of the %u image and mask files used on the panels have identical pixels as another file (%s of redundant files).\n%u used files are BMP images that could be written as compressed PNG files instead."),
+			m_optimizer->getNumberOfDuplicateFiles(),
+			m_optimizer->getNumberOfFiles(),
+			wxFileName::GetHumanReadableSize(m_optimizer->getRedundantBytes()),
+			m_optimizer->getNumberOfReencodableFiles()
+		);
+	}
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		summary
+	);
+	firstRow->Add(summaryText, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxVERTICAL);
+	m_duplicatesList = new wxListCtrl(
+		this,
+		ID_IMAGE_ASSETS_LIST,
+		wxDefaultPosition,
+		wxSize(800, 360),
+		wxLC_REPORT|wxLC_SINGLE_SEL|wxLC_HRULES|wxLC_VRULES
+	);
+	m_duplicatesList->AppendColumn(wxT("Duplicate file"), wxLIST_FORMAT_LEFT, 280);
+	m_duplicatesList->AppendColumn(wxT("Identical to"), wxLIST_FORMAT_LEFT, 280);
+	m_duplicatesList->AppendColumn(wxT("Used by"), wxLIST_FORMAT_LEFT, 240);
+	if (m_scanComplete) {
+		long row = 0;
+		for (unsigned i = 0; i < m_optimizer->getNumberOfGroups(); i++) {
+			const std::vector<unsigned> &group = m_optimizer->getGroupAt(i);
+			IMAGE_FILE *kept = m_optimizer->getFileAt(group.front());
+			for (unsigned j = 1; j < group.size(); j++) {
+				IMAGE_FILE *duplicate = m_optimizer->getFileAt(group[j]);
+				wxString usedBy = m_optimizer->getUsageDescription(duplicate->usages.front());
+				if (duplicate->usages.size() > 1)
+					usedBy += wxString::Format(wxT(" (+%u more)"), (unsigned) duplicate->usages.size() - 1);
+				long idx = m_duplicatesList->InsertItem(row++, GOODF_functions::removeBaseOdfPath(duplicate->fullPath));
+				m_duplicatesList->SetItem(idx, 1, GOODF_functions::removeBaseOdfPath(kept->fullPath));
+				m_duplicatesList->SetItem(idx, 2, usedBy);
+			}
+		}
+	}
+	secondRow->Add(m_duplicatesList, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(secondRow, 1, wxGROW|wxALL, 5);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxVERTICAL);
+	m_sharePathsCheck = new wxCheckBox(
+		this,
+		ID_IMAGE_ASSETS_SHARE_CHECK,
+		wxT("Point all users of a duplicate to the one file kept")
+	);
+	m_sharePathsCheck->SetValue(true);
+	thirdRow->Add(m_sharePathsCheck, 0, wxALL, 5);
+	m_reencodeCheck = new wxCheckBox(
+		this,
+		ID_IMAGE_ASSETS_PNG_CHECK,
+		wxT("Write used BMP images as compressed PNG files next to them and use those instead (the BMP files are not removed)")
+	);
+	thirdRow->Add(m_reencodeCheck, 0, wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Rewrite")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+
+	if (m_scanComplete && m_optimizer->getNumberOfGroups() == 0 && m_optimizer->getNumberOfReencodableFiles() > 0)
+		m_reencodeCheck->SetValue(true);
+	UpdateOkButton();
+}
+
+bool ImageAssetsDialog::IsScanComplete() {
+	return m_scanComplete;
+}
+
+unsigned ImageAssetsDialog::ApplyRewrite() {
+	if (!m_scanComplete)
+		return 0;
+
+	unsigned nbrChanged = 0;
+	if (m_sharePathsCheck->GetValue())
+		nbrChanged += m_optimizer->makePathsShared();
+	if (m_reencodeCheck->GetValue()) {
+		wxProgressDialog progress(
+			wxT("Writing PNG images"),
+			wxEmptyString,
+			100,
+			GetParent(),
+			wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_ELAPSED_TIME
+		);
+		nbrChanged += m_optimizer->reencodeToPng(&progress);
+	}
+
+	// the references have changed so the scan result isn't valid any longer
+	m_scanComplete = false;
+	return nbrChanged;
+}
+
+void ImageAssetsDialog::UpdateOkButton() {
+	bool canShare = m_scanComplete && m_optimizer->getNumberOfGroups() > 0;
+	bool canReencode = m_scanComplete && m_optimizer->getNumberOfReencodableFiles() > 0;
+	m_sharePathsCheck->Enable(canShare);
+	m_reencodeCheck->Enable(canReencode);
+
+	wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
+	if (okBtn)
+		okBtn->Enable((canShare && m_sharePathsCheck->GetValue()) || (canReencode && m_reencodeCheck->GetValue()));
+}
+
+void ImageAssetsDialog::OnRewriteSelection(wxCommandEvent& WXUNUSED(event)) {
+	UpdateOkButton();
+}
@@ -0,0 +1,84 @@
+/*
+ * ImageAssetsDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef IMAGEASSETSDIALOG_H
+#define IMAGEASSETSDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "Organ.h"
+#include "ImageAssetOptimizer.h"
+
+class ImageAssetsDialog : public wxDialog {
+	DECLARE_CLASS(ImageAssetsDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	ImageAssetsDialog(Organ *organ);
+	ImageAssetsDialog(
+		Organ *organ,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Optimize panel images"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~ImageAssetsDialog();
+
+	// Initialize our variables
+	void Init(Organ *organ);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Optimize panel images"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	bool IsScanComplete();
+	// Performs the selected rewrites, returns number of changed image references
+	unsigned ApplyRewrite();
+
+private:
+	Organ *m_organ;
+	ImageAssetOptimizer *m_optimizer;
+	bool m_scanComplete;
+
+	wxListCtrl *m_duplicatesList;
+	wxCheckBox *m_sharePathsCheck;
+	wxCheckBox *m_reencodeCheck;
+
+	void UpdateOkButton();
+
+	// Event methods
+	void OnRewriteSelection(wxCommandEvent& event);
+
+};
+
+#endif
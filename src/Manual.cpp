@@ -21,6 +21,7 @@
 #include "Manual.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "ReferenceIndex.h"
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -110,7 +111,7 @@ void Manual::write(wxTextFile *outFile) {
 	}
 }
 
-void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan) {
+void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan, bool onlyCatalogue) {
 	m_name = cfg->Read("Name", wxEmptyString);
 	int logicalKeys = static_cast<int>(cfg->ReadLong("NumberOfLogicalKeys", 1));
 	if (logicalKeys > 0 && logicalKeys < 193) {
@@ -175,7 +176,7 @@ void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Org
 			if (cfg->HasGroup(stopGroup)) {
 				cfg->SetPath(wxT("/") + stopGroup);
 				Stop s;
-				s.read(cfg, useOldPanelFormat, this, readOrgan);
+				s.read(cfg, useOldPanelFormat, this, readOrgan, onlyCatalogue);
 				readOrgan->addStop(s, true);
 				addStop(readOrgan->getOrganStopAt(readOrgan->getNumberOfStops() - 1));
 				if (s.isUsingInternalRank()) {
@@ -192,7 +193,7 @@ void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Org
 						}
 					}
 				}
-				if (s.isDisplayed()) {
+				if (s.isDisplayed() && !onlyCatalogue) {
 					// we must also create a GUI element for that stop from this group information
 					int lastStopIdx = m_stops.size() - 1;
 					GUIElement *guiStop = new GUIStop(getStopAt(lastStopIdx));
@@ -494,6 +495,7 @@ Tremulant* Manual::getTremulantAt(unsigned index) {
 
 void Manual::addTremulant(Tremulant* tremulant) {
 	m_tremulants.push_back(tremulant);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Manual::removeTremulant(Tremulant* tremulant) {
@@ -504,6 +506,7 @@ void Manual::removeTremulant(Tremulant* tremulant) {
 			d->removeTremulant(tremulant);
 		}
 	}
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Manual::removeTremulantAt(unsigned index) {
@@ -516,6 +519,7 @@ void Manual::removeTremulantAt(unsigned index) {
 		}
 	}
 	m_tremulants.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 int Manual::getIndexOfTremulant(Tremulant *tremulant) {
@@ -551,6 +555,7 @@ GoSwitch* Manual::getGoSwitchAt(unsigned index) {
 
 void Manual::addGoSwitch(GoSwitch* sw) {
 	m_switches.push_back(sw);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Manual::removeGoSwitch(GoSwitch* sw) {
@@ -572,6 +577,7 @@ void Manual::removeGoSwitch(GoSwitch* sw) {
 		}
 	}
 	m_switches.remove(sw);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 void Manual::removeGoSwitchAt(unsigned index) {
@@ -595,6 +601,7 @@ void Manual::removeGoSwitchAt(unsigned index) {
 		}
 	}
 	m_switches.erase(it);
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 int Manual::getIndexOfGoSwitch(GoSwitch *sw) {
@@ -40,7 +40,7 @@ public:
 	~Manual();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan);
+	void read(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan, bool onlyCatalogue = false);
 	void readCouplers(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan);
 	void readDivisionals(wxFileConfig *cfg, bool useOldPanelFormat, wxString manId, Organ *readOrgan);
 
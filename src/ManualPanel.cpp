@@ -820,6 +820,7 @@ void ManualPanel::UpdateAnyGuiVersion() {
 			if (guiMan->isReferencing(m_manual)) {
 				guiMan->setNumberOfDisplayKeys(m_manual->getNumberOfAccessibleKeys());
 				guiMan->setDisplayFirstNote(m_manual->getFirstAccessibleKeyMIDINoteNumber());
+				guiMan->markChanged();
 			}
 		}
 	}
@@ -0,0 +1,310 @@
+/*
+ * MemoryFootprintDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "MemoryFootprintDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <wx/progdlg.h>
+#include <wx/filename.h>
+#include <algorithm>
+#include <functional>
+
+IMPLEMENT_CLASS(MemoryFootprintDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(MemoryFootprintDialog, wxDialog)
+	EVT_CHOICE(ID_MEMORY_SUBJECT_CHOICE, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHOICE(ID_MEMORY_BITS_CHOICE, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHOICE(ID_MEMORY_CHANNELS_CHOICE, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHOICE(ID_MEMORY_LOOPS_CHOICE, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHECKBOX(ID_MEMORY_COMPRESS_CHECK, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHECKBOX(ID_MEMORY_FIRST_ATTACK_CHECK, MemoryFootprintDialog::OnOptionChanged)
+	EVT_CHECKBOX(ID_MEMORY_FIRST_RELEASE_CHECK, MemoryFootprintDialog::OnOptionChanged)
+	EVT_LIST_COL_CLICK(ID_MEMORY_FOOTPRINT_LIST, MemoryFootprintDialog::OnColumnClick)
+END_EVENT_TABLE()
+
+static const unsigned BIT_DEPTHS[] = { 8, 12, 16, 20, 24 };
+
+MemoryFootprintDialog::MemoryFootprintDialog(Organ *organ, MemoryFootprintEstimator *estimator) {
+	Init(organ, estimator);
+}
+
+MemoryFootprintDialog::MemoryFootprintDialog(
+	Organ *organ,
+	MemoryFootprintEstimator *estimator,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(organ, estimator);
+	Create(parent, id, caption, pos, size, style);
+}
+
+MemoryFootprintDialog::~MemoryFootprintDialog() {
+
+}
+
+void MemoryFootprintDialog::Init(Organ *organ, MemoryFootprintEstimator *estimator) {
+	m_organ = organ;
+	m_estimator = estimator;
+	m_scanComplete = false;
+	m_options = MemoryFootprintEstimator::getDefaultOptions();
+	m_kind = FOOTPRINT_STOP;
+	m_sortColumn = 3;
+	m_sortAscending = false;
+	m_summaryText = NULL;
+	m_subjectChoice = NULL;
+	m_bitsChoice = NULL;
+	m_channelsChoice = NULL;
+	m_loopsChoice = NULL;
+	m_compressCheck = NULL;
+	m_firstAttackCheck = NULL;
+	m_firstReleaseCheck = NULL;
+	m_footprintList = NULL;
+}
+
+bool MemoryFootprintDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	// sample headers already read for an earlier estimate are reused
+	wxProgressDialog progress(
+		wxT("Estimating memory footprint"),
+		wxEmptyString,
+		100,
+		parent,
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+	m_scanComplete = m_estimator->scan(m_organ, &progress);
+	progress.Hide();
+
+	CreateControls();
+	UpdateEstimate();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void MemoryFootprintDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxFlexGridSizer *optionsGrid = new wxFlexGridSizer(4, 5, 5);
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Show: ")), 0, wxALIGN_CENTER_VERTICAL);
+	wxArrayString subjects;
+	subjects.Add(wxT("Stops"));
+	subjects.Add(wxT("Ranks"));
+	subjects.Add(wxT("Windchests"));
+	m_subjectChoice = new wxChoice(this, ID_MEMORY_SUBJECT_CHOICE, wxDefaultPosition, wxDefaultSize, subjects);
+	m_subjectChoice->SetSelection(0);
+	optionsGrid->Add(m_subjectChoice, 0, wxGROW);
+
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Sample size: ")), 0, wxALIGN_CENTER_VERTICAL);
+	wxArrayString bits;
+	for (unsigned depth : BIT_DEPTHS)
+		bits.Add(wxString::Format(wxT("%u bits"), depth));
+	m_bitsChoice = new wxChoice(this, ID_MEMORY_BITS_CHOICE, wxDefaultPosition, wxDefaultSize, bits);
+	m_bitsChoice->SetSelection(4);
+	optionsGrid->Add(m_bitsChoice, 0, wxGROW);
+
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Channels: ")), 0, wxALIGN_CENTER_VERTICAL);
+	wxArrayString channels;
+	channels.Add(wxT("Stereo"));
+	channels.Add(wxT("Mono"));
+	m_channelsChoice = new wxChoice(this, ID_MEMORY_CHANNELS_CHOICE, wxDefaultPosition, wxDefaultSize, channels);
+	m_channelsChoice->SetSelection(0);
+	optionsGrid->Add(m_channelsChoice, 0, wxGROW);
+
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Loop loading: ")), 0, wxALIGN_CENTER_VERTICAL);
+	wxArrayString loops;
+	loops.Add(wxT("First loop only"));
+	loops.Add(wxT("Longest loop only"));
+	loops.Add(wxT("All loops"));
+	m_loopsChoice = new wxChoice(this, ID_MEMORY_LOOPS_CHOICE, wxDefaultPosition, wxDefaultSize, loops);
+	m_loopsChoice->SetSelection(2);
+	optionsGrid->Add(m_loopsChoice, 0, wxGROW);
+	mainSizer->Add(optionsGrid, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *checkRow = new wxBoxSizer(wxHORIZONTAL);
+	m_compressCheck = new wxCheckBox(this, ID_MEMORY_COMPRESS_CHECK, wxT("Compressed"));
+	checkRow->Add(m_compressCheck, 0, wxALL, 5);
+	m_firstAttackCheck = new wxCheckBox(this, ID_MEMORY_FIRST_ATTACK_CHECK, wxT("Load only the first attack"));
+	checkRow->Add(m_firstAttackCheck, 0, wxALL, 5);
+	m_firstReleaseCheck = new wxCheckBox(this, ID_MEMORY_FIRST_RELEASE_CHECK, wxT("Load only the first release"));
+	checkRow->Add(m_firstReleaseCheck, 0, wxALL, 5);
+	mainSizer->Add(checkRow, 0, wxGROW|wxALL, 5);
+
+	m_summaryText = new wxStaticText(this, wxID_STATIC, wxEmptyString);
+	mainSizer->Add(m_summaryText, 0, wxGROW|wxALL, 10);
+
+	m_footprintList = new wxListCtrl(
+		this,
+		ID_MEMORY_FOOTPRINT_LIST,
+		wxDefaultPosition,
+		wxSize(760, 360),
+		wxLC_REPORT|wxLC_SINGLE_SEL|wxLC_HRULES|wxLC_VRULES
+	);
+	m_footprintList->AppendColumn(wxT("Name"), wxLIST_FORMAT_LEFT, 300);
+	m_footprintList->AppendColumn(wxT("Pipes"), wxLIST_FORMAT_RIGHT, 70);
+	m_footprintList->AppendColumn(wxT("Samples"), wxLIST_FORMAT_RIGHT, 80);
+	m_footprintList->AppendColumn(wxT("Memory"), wxLIST_FORMAT_RIGHT, 110);
+	m_footprintList->AppendColumn(wxT("Share"), wxLIST_FORMAT_RIGHT, 90);
+	m_footprintList->AppendColumn(wxT("Cumulative"), wxLIST_FORMAT_RIGHT, 100);
+	mainSizer->Add(m_footprintList, 1, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCloseButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Close")
+	);
+	bottomRow->Add(theCloseButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void MemoryFootprintDialog::UpdateEstimate() {
+	if (m_scanComplete)
+		m_estimator->estimate(m_organ, m_options);
+	UpdateList();
+}
+
+void MemoryFootprintDialog::UpdateList() {
+	m_footprintList->DeleteAllItems();
+	if (!m_scanComplete) {
+		m_summaryText->SetLabel(wxT("Reading the sample files was cancelled."));
+		return;
+	}
+
+	std::vector<MEMORY_FOOTPRINT*> rows;
+	uint64_t listedBytes = 0;
+	for (unsigned i = 0; i < m_estimator->getNumberOfFootprints(m_kind); i++) {
+		rows.push_back(m_estimator->getFootprintAt(m_kind, i));
+		listedBytes += rows.back()->bytes;
+	}
+
+	int column = m_sortColumn;
+	bool ascending = m_sortAscending;
+	std::stable_sort(rows.begin(), rows.end(), [column, ascending](MEMORY_FOOTPRINT *a, MEMORY_FOOTPRINT *b) {
+		if (!ascending)
+			std::swap(a, b);
+		switch (column) {
+			case 0:
+				return a->name.CmpNoCase(b->name) < 0;
+			case 1:
+				return a->nbrOfPipes < b->nbrOfPipes;
+			case 2:
+				return a->nbrOfSamples < b->nbrOfSamples;
+			default:
+				return a->bytes < b->bytes;
+		}
+	});
+
+	uint64_t cumulative = 0;
+	for (unsigned i = 0; i < rows.size(); i++) {
+		cumulative += rows[i]->bytes;
+		long idx = m_footprintList->InsertItem(i, rows[i]->name);
+		m_footprintList->SetItem(idx, 1, wxString::Format(wxT("%u"), rows[i]->nbrOfPipes));
+		m_footprintList->SetItem(idx, 2, wxString::Format(wxT("%u"), rows[i]->nbrOfSamples));
+		m_footprintList->SetItem(idx, 3, wxFileName::GetHumanReadableSize(wxULongLong(rows[i]->bytes)));
+		if (listedBytes > 0) {
+			m_footprintList->SetItem(idx, 4, wxString::Format(wxT("%.1f %%"), 100.0 * rows[i]->bytes / listedBytes));
+			m_footprintList->SetItem(idx, 5, wxString::Format(wxT("%.1f %%"), 100.0 * cumulative / listedBytes));
+		}
+	}
+
+	MEMORY_FOOTPRINT *organ = m_estimator->getOrganFootprint();
+	wxString summary = wxString::Format(
+		wxT("Estimated sample memory of the organ: %s for %u pipes and %u samples (%s)."),
+		wxFileName::GetHumanReadableSize(wxULongLong(organ->bytes)),
+		organ->nbrOfPipes,
+		organ->nbrOfSamples,
+		MemoryFootprintEstimator::getOptionsDescription(m_options)
+	);
+	if (m_options.compress)
+		summary += wxT("\nThe compressed size assumes that GrandOrgue saves 40 % on average.");
+
+	// how much the largest tenth of the elements accounts for shows where to look first
+	std::vector<uint64_t> sizes;
+	for (MEMORY_FOOTPRINT *row : rows)
+		sizes.push_back(row->bytes);
+	std::sort(sizes.begin(), sizes.end(), std::greater<uint64_t>());
+	unsigned top = (sizes.size() + 9) / 10;
+	if (listedBytes > 0 && sizes.size() > 1) {
+		uint64_t topBytes = 0;
+		for (unsigned i = 0; i < top; i++)
+			topBytes += sizes[i];
+		summary += wxString::Format(
+			wxT("\nThe largest %u of the %u %s use %.1f %% of their memory."),
+			top,
+			(unsigned) sizes.size(),
+			m_subjectChoice->GetStringSelection().Lower(),
+			100.0 * topBytes / listedBytes
+		);
+	}
+	if (m_kind == FOOTPRINT_STOP)
+		summary += wxT("\nRanks used by several stops are counted for each of them.");
+	if (organ->nbrOfUnreadable > 0)
+		summary += wxString::Format(wxT("\n%u sample files are missing or can't be read and aren't counted."), organ->nbrOfUnreadable);
+	m_summaryText->SetLabel(summary);
+	Layout();
+}
+
+void MemoryFootprintDialog::OnOptionChanged(wxCommandEvent& WXUNUSED(event)) {
+	m_kind = (FOOTPRINT_SUBJECT_KIND) m_subjectChoice->GetSelection();
+	m_options.bitsPerSample = BIT_DEPTHS[m_bitsChoice->GetSelection()];
+	m_options.stereo = m_channelsChoice->GetSelection() == 0;
+	m_options.loopLoading = (LOOP_LOADING) m_loopsChoice->GetSelection();
+	m_options.compress = m_compressCheck->GetValue();
+	m_options.firstAttackOnly = m_firstAttackCheck->GetValue();
+	m_options.firstReleaseOnly = m_firstReleaseCheck->GetValue();
+	UpdateEstimate();
+}
+
+void MemoryFootprintDialog::OnColumnClick(wxListEvent& event) {
+	int column = event.GetColumn();
+	if (column < 0)
+		return;
+	// the share columns follow the memory column
+	if (column > 3)
+		column = 3;
+	if (column == m_sortColumn)
+		m_sortAscending = !m_sortAscending;
+	else {
+		m_sortColumn = column;
+		m_sortAscending = column == 0;
+	}
+	UpdateList();
+}
@@ -0,0 +1,93 @@
+/*
+ * MemoryFootprintDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef MEMORYFOOTPRINTDIALOG_H
+#define MEMORYFOOTPRINTDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "Organ.h"
+#include "MemoryFootprintEstimator.h"
+
+class MemoryFootprintDialog : public wxDialog {
+	DECLARE_CLASS(MemoryFootprintDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	MemoryFootprintDialog(Organ *organ, MemoryFootprintEstimator *estimator);
+	MemoryFootprintDialog(
+		Organ *organ,
+		MemoryFootprintEstimator *estimator,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Memory footprint"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~MemoryFootprintDialog();
+
+	// Initialize our variables
+	void Init(Organ *organ, MemoryFootprintEstimator *estimator);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Memory footprint"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	Organ *m_organ;
+	MemoryFootprintEstimator *m_estimator;
+	bool m_scanComplete;
+	GO_LOADING_OPTIONS m_options;
+	FOOTPRINT_SUBJECT_KIND m_kind;
+	int m_sortColumn;
+	bool m_sortAscending;
+
+	wxStaticText *m_summaryText;
+	wxChoice *m_subjectChoice;
+	wxChoice *m_bitsChoice;
+	wxChoice *m_channelsChoice;
+	wxChoice *m_loopsChoice;
+	wxCheckBox *m_compressCheck;
+	wxCheckBox *m_firstAttackCheck;
+	wxCheckBox *m_firstReleaseCheck;
+	wxListCtrl *m_footprintList;
+
+	void UpdateEstimate();
+	void UpdateList();
+
+	// Event methods
+	void OnOptionChanged(wxCommandEvent& event);
+	void OnColumnClick(wxListEvent& event);
+
+};
+
+#endif
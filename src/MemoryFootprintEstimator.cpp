@@ -0,0 +1,366 @@
+/*
+ * MemoryFootprintEstimator.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "MemoryFootprintEstimator.h"
+#include "ParallelTaskRunner.h"
+#include "WAVfileParser.h"
+#include "TraceRecorder.h"
+#include <wx/filename.h>
+#include <algorithm>
+
+// the lossless sample compression of GrandOrgue typically saves 30-50 %
+// depending on the material, the estimate assumes 40 %
+static const double COMPRESSED_SIZE_RATIO = 0.6;
+
+static bool isSamplePath(const wxString &path) {
+	return path != wxEmptyString && !path.IsSameAs(wxT("DUMMY"), false) && !path.StartsWith(wxT("REF"));
+}
+
+MemoryFootprintEstimator::MemoryFootprintEstimator(unsigned nbrOfThreads) {
+	m_nbrOfThreads = nbrOfThreads;
+	initFootprint(m_organ, wxT("Organ"));
+}
+
+MemoryFootprintEstimator::~MemoryFootprintEstimator() {
+
+}
+
+GO_LOADING_OPTIONS MemoryFootprintEstimator::getDefaultOptions() {
+	GO_LOADING_OPTIONS options;
+	options.bitsPerSample = 24;
+	options.compress = false;
+	options.stereo = true;
+	options.firstAttackOnly = false;
+	options.firstReleaseOnly = false;
+	options.loopLoading = LOAD_ALL_LOOPS;
+	return options;
+}
+
+wxString MemoryFootprintEstimator::getOptionsDescription(const GO_LOADING_OPTIONS &options) {
+	wxString description = wxString::Format(wxT("%u bit"), options.bitsPerSample);
+	description += options.compress ? wxT(", compressed") : wxT(", uncompressed");
+	description += options.stereo ? wxT(", stereo") : wxT(", mono");
+	if (options.loopLoading == LOAD_FIRST_LOOP)
+		description += wxT(", first loop");
+	else if (options.loopLoading == LOAD_LONGEST_LOOP)
+		description += wxT(", longest loop");
+	else
+		description += wxT(", all loops");
+	if (options.firstAttackOnly)
+		description += wxT(", first attack only");
+	if (options.firstReleaseOnly)
+		description += wxT(", first release only");
+	return description;
+}
+
+bool MemoryFootprintEstimator::scan(Organ *organ, wxProgressDialog *progress) {
+	TraceScope trace("MemoryFootprintEstimator::scan");
+	std::vector<wxString> paths;
+	for (unsigned i = 0; i < organ->getNumberOfRanks(); i++)
+		collectPaths(organ->getOrganRankAt(i), paths);
+	for (unsigned i = 0; i < organ->getNumberOfStops(); i++) {
+		Stop *stop = organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank())
+			collectPaths(stop->getInternalRank(), paths);
+	}
+	std::sort(paths.begin(), paths.end());
+	paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+	// only files that are new or have been modified since they were read need parsing
+	std::vector<wxString> toRead;
+	for (wxString &path : paths) {
+		std::map<wxString, SAMPLE_METADATA>::iterator it = m_metadata.find(path);
+		if (it == m_metadata.end() || !it->second.modificationTime.IsValid())
+			toRead.push_back(path);
+		else {
+			wxFileName fileName(path);
+			if (!fileName.FileExists() || fileName.GetModificationTime() != it->second.modificationTime)
+				toRead.push_back(path);
+		}
+	}
+
+	std::vector<SAMPLE_METADATA> results(toRead.size());
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	if (!runner.run(toRead.size(), [this, &toRead, &results](unsigned i) { readMetadata(toRead[i], results[i]); }, progress, wxT("Reading sample headers...")))
+		return false;
+	for (unsigned i = 0; i < toRead.size(); i++)
+		m_metadata[toRead[i]] = results[i];
+	return true;
+}
+
+void MemoryFootprintEstimator::estimate(Organ *organ, const GO_LOADING_OPTIONS &options) {
+	TraceScope trace("MemoryFootprintEstimator::estimate");
+	m_stops.clear();
+	m_ranks.clear();
+	m_windchests.clear();
+	initFootprint(m_organ, wxT("Organ"));
+
+	for (unsigned i = 0; i < organ->getNumberOfWindchestgroups(); i++) {
+		MEMORY_FOOTPRINT windchest;
+		initFootprint(windchest, organ->getOrganWindchestgroupAt(i)->getName());
+		m_windchests.push_back(windchest);
+	}
+
+	std::vector<std::pair<Rank*, wxString>> ranks;
+	for (unsigned i = 0; i < organ->getNumberOfRanks(); i++)
+		ranks.push_back(std::make_pair(organ->getOrganRankAt(i), organ->getOrganRankAt(i)->getName()));
+	for (unsigned i = 0; i < organ->getNumberOfStops(); i++) {
+		Stop *stop = organ->getOrganStopAt(i);
+		MEMORY_FOOTPRINT stopFootprint;
+		initFootprint(stopFootprint, stop->getName() + wxT(" (") + stop->getOwningManual()->getName() + wxT(")"));
+		if (stop->isUsingInternalRank()) {
+			Rank *internal = stop->getInternalRank();
+			addRank(internal, 1, internal->m_pipes.size(), options, stopFootprint);
+			ranks.push_back(std::make_pair(internal, stopFootprint.name + wxT(" internal rank")));
+		} else {
+			for (unsigned j = 0; j < stop->getNumberOfRanks(); j++) {
+				RankReference *ref = stop->getRankReferenceAt(j);
+				if (ref->m_rankReference && ref->m_pipeCount > 0)
+					addRank(ref->m_rankReference, ref->m_firstPipeNumber, ref->m_pipeCount, options, stopFootprint);
+			}
+		}
+		m_stops.push_back(stopFootprint);
+	}
+
+	for (auto &rank : ranks) {
+		MEMORY_FOOTPRINT rankFootprint;
+		initFootprint(rankFootprint, rank.second);
+		addRank(rank.first, 1, rank.first->m_pipes.size(), options, rankFootprint);
+		m_ranks.push_back(rankFootprint);
+		addFootprint(m_organ, rankFootprint);
+		if (rank.first->getWindchest()) {
+			int windchestIndex = organ->getIndexOfOrganWindchest(rank.first->getWindchest()) - 1;
+			if (windchestIndex >= 0 && windchestIndex < (int) m_windchests.size())
+				addFootprint(m_windchests[windchestIndex], rankFootprint);
+		}
+	}
+}
+
+void MemoryFootprintEstimator::clear() {
+	m_metadata.clear();
+	m_stops.clear();
+	m_ranks.clear();
+	m_windchests.clear();
+	initFootprint(m_organ, wxT("Organ"));
+}
+
+unsigned MemoryFootprintEstimator::getNumberOfFootprints(FOOTPRINT_SUBJECT_KIND kind) {
+	switch (kind) {
+		case FOOTPRINT_STOP:
+			return m_stops.size();
+		case FOOTPRINT_RANK:
+			return m_ranks.size();
+		case FOOTPRINT_WINDCHEST:
+			return m_windchests.size();
+	}
+	return 0;
+}
+
+MEMORY_FOOTPRINT* MemoryFootprintEstimator::getFootprintAt(FOOTPRINT_SUBJECT_KIND kind, unsigned index) {
+	if (index >= getNumberOfFootprints(kind))
+		return NULL;
+	switch (kind) {
+		case FOOTPRINT_STOP:
+			return &m_stops[index];
+		case FOOTPRINT_RANK:
+			return &m_ranks[index];
+		case FOOTPRINT_WINDCHEST:
+			return &m_windchests[index];
+	}
+	return NULL;
+}
+
+MEMORY_FOOTPRINT* MemoryFootprintEstimator::getOrganFootprint() {
+	return &m_organ;
+}
+
+uint64_t MemoryFootprintEstimator::estimatePipe(Pipe &pipe, const GO_LOADING_OPTIONS &options, unsigned *nbrOfSamples, unsigned *nbrOfUnreadable, uint64_t *frames) {
+	uint64_t bytes = 0;
+	if (pipe.m_attacks.empty() || pipe.isFirstAttackRefPath())
+		return bytes;
+
+	// every part of a sample is stored with the depth of the file if that is below the chosen one
+	auto addSample = [&](const SAMPLE_METADATA &metadata, uint64_t sampleFrames) {
+		unsigned bits = std::min(metadata.bitsPerSample, options.bitsPerSample);
+		unsigned bytesPerSample = bits <= 8 ? 1 : (bits <= 16 ? 2 : 3);
+		unsigned channels = options.stereo ? metadata.numberOfChannels : 1;
+		double sampleBytes = (double) sampleFrames * channels * bytesPerSample;
+		if (options.compress)
+			sampleBytes *= COMPRESSED_SIZE_RATIO;
+		bytes += (uint64_t) sampleBytes;
+		if (nbrOfSamples)
+			(*nbrOfSamples)++;
+		if (frames)
+			*frames += sampleFrames;
+	};
+
+	for (Attack &atk : pipe.m_attacks) {
+		if (isSamplePath(atk.fullPath)) {
+			const SAMPLE_METADATA *metadata = getMetadata(atk.fullPath);
+			if (metadata && metadata->isReadable)
+				addSample(*metadata, getAttackFrames(atk, *metadata, options));
+			else if (nbrOfUnreadable)
+				(*nbrOfUnreadable)++;
+		}
+		if (options.firstAttackOnly)
+			break;
+	}
+	for (Release &rel : pipe.m_releases) {
+		if (isSamplePath(rel.fullPath)) {
+			const SAMPLE_METADATA *metadata = getMetadata(rel.fullPath);
+			if (metadata && metadata->isReadable)
+				addSample(*metadata, getReleaseFrames(rel.cuePoint, rel.releaseEnd, *metadata));
+			else if (nbrOfUnreadable)
+				(*nbrOfUnreadable)++;
+		}
+		if (options.firstReleaseOnly)
+			break;
+	}
+	return bytes;
+}
+
+void MemoryFootprintEstimator::collectPaths(Rank *rank, std::vector<wxString> &paths) {
+	for (Pipe &pipe : rank->m_pipes) {
+		if (pipe.m_attacks.empty() || pipe.isFirstAttackRefPath())
+			continue;
+		for (Attack &atk : pipe.m_attacks) {
+			if (isSamplePath(atk.fullPath))
+				paths.push_back(atk.fullPath);
+		}
+		for (Release &rel : pipe.m_releases) {
+			if (isSamplePath(rel.fullPath))
+				paths.push_back(rel.fullPath);
+		}
+	}
+}
+
+void MemoryFootprintEstimator::readMetadata(const wxString &fullPath, SAMPLE_METADATA &metadata) {
+	metadata.isReadable = false;
+	metadata.numberOfFrames = 0;
+	metadata.numberOfChannels = 0;
+	metadata.bitsPerSample = 0;
+	metadata.firstCue = -1;
+	wxFileName fileName(fullPath);
+	if (!fileName.FileExists())
+		return;
+	metadata.modificationTime = fileName.GetModificationTime();
+
+	WAVfileParser wav(fullPath);
+	if (!wav.isWavOk())
+		return;
+	metadata.isReadable = true;
+	metadata.numberOfFrames = wav.getNumberOfFrames();
+	metadata.numberOfChannels = wav.getNumberOfChannels();
+	metadata.bitsPerSample = wav.getBitsPerSample();
+	if (wav.getNumberOfCues() > 0)
+		metadata.firstCue = wav.getCuepointAtIndex(0).dwSampleOffset;
+	for (unsigned i = 0; i < wav.getNumberOfLoops(); i++) {
+		LOOP loop = wav.getLoopAtIndex(i);
+		metadata.loops.push_back(std::make_pair(loop.dwStart, loop.dwEnd));
+	}
+}
+
+const SAMPLE_METADATA* MemoryFootprintEstimator::getMetadata(const wxString &fullPath) {
+	std::map<wxString, SAMPLE_METADATA>::iterator it = m_metadata.find(fullPath);
+	if (it == m_metadata.end())
+		return NULL;
+	return &it->second;
+}
+
+uint64_t MemoryFootprintEstimator::getAttackFrames(Attack &attack, const SAMPLE_METADATA &metadata, const GO_LOADING_OPTIONS &options) {
+	uint64_t total = metadata.numberOfFrames;
+	uint64_t start = attack.attackStart > 0 ? std::min<uint64_t>(attack.attackStart, total) : 0;
+
+	// loops in the odf override the ones embedded in the file
+	std::vector<std::pair<unsigned, unsigned>> loops;
+	if (!attack.m_loops.empty()) {
+		for (Loop &loop : attack.m_loops) {
+			if (loop.end > loop.start && loop.start >= 0)
+				loops.push_back(std::make_pair(loop.start, loop.end));
+		}
+	} else {
+		loops = metadata.loops;
+	}
+	if (loops.empty())
+		return total - start;
+
+	// the attack is only kept up to the end of the loaded loop(s)
+	uint64_t loopEnd = 0;
+	if (options.loopLoading == LOAD_FIRST_LOOP) {
+		loopEnd = loops.front().second;
+	} else if (options.loopLoading == LOAD_LONGEST_LOOP) {
+		unsigned longest = 0;
+		for (auto &loop : loops) {
+			if (loop.second - loop.first > longest) {
+				longest = loop.second - loop.first;
+				loopEnd = loop.second;
+			}
+		}
+	} else {
+		for (auto &loop : loops)
+			loopEnd = std::max<uint64_t>(loopEnd, loop.second);
+	}
+	loopEnd = std::min(loopEnd + 1, total);
+	uint64_t frames = loopEnd > start ? loopEnd - start : 0;
+
+	// a release contained in the attack file is stored separately from the cue point on
+	if (attack.loadRelease) {
+		int cue = attack.cuePoint >= 0 ? attack.cuePoint : metadata.firstCue;
+		if (cue >= 0)
+			frames += getReleaseFrames(cue, attack.releaseEnd, metadata);
+	}
+	return frames;
+}
+
+uint64_t MemoryFootprintEstimator::getReleaseFrames(int cuePoint, int releaseEnd, const SAMPLE_METADATA &metadata) {
+	uint64_t total = metadata.numberOfFrames;
+	uint64_t end = releaseEnd > 0 ? std::min<uint64_t>(releaseEnd, total) : total;
+	uint64_t start = cuePoint > 0 ? std::min<uint64_t>(cuePoint, end) : 0;
+	return end - start;
+}
+
+void MemoryFootprintEstimator::addRank(Rank *rank, unsigned firstPipe, unsigned pipeCount, const GO_LOADING_OPTIONS &options, MEMORY_FOOTPRINT &footprint) {
+	unsigned pipeNbr = 1;
+	for (Pipe &pipe : rank->m_pipes) {
+		if (pipeNbr >= firstPipe + pipeCount)
+			break;
+		if (pipeNbr++ < firstPipe)
+			continue;
+		footprint.bytes += estimatePipe(pipe, options, &footprint.nbrOfSamples, &footprint.nbrOfUnreadable, &footprint.frames);
+		footprint.nbrOfPipes++;
+	}
+}
+
+void MemoryFootprintEstimator::initFootprint(MEMORY_FOOTPRINT &footprint, const wxString &name) {
+	footprint.name = name;
+	footprint.nbrOfPipes = 0;
+	footprint.nbrOfSamples = 0;
+	footprint.nbrOfUnreadable = 0;
+	footprint.frames = 0;
+	footprint.bytes = 0;
+}
+
+void MemoryFootprintEstimator::addFootprint(MEMORY_FOOTPRINT &target, const MEMORY_FOOTPRINT &source) {
+	target.nbrOfPipes += source.nbrOfPipes;
+	target.nbrOfSamples += source.nbrOfSamples;
+	target.nbrOfUnreadable += source.nbrOfUnreadable;
+	target.frames += source.frames;
+	target.bytes += source.bytes;
+}
@@ -0,0 +1,118 @@
+/*
+ * MemoryFootprintEstimator.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef MEMORYFOOTPRINTESTIMATOR_H
+#define MEMORYFOOTPRINTESTIMATOR_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "Organ.h"
+
+enum LOOP_LOADING {
+	LOAD_FIRST_LOOP,
+	LOAD_LONGEST_LOOP,
+	LOAD_ALL_LOOPS
+};
+
+// the GrandOrgue loading settings an estimate is made for
+struct GO_LOADING_OPTIONS {
+	unsigned bitsPerSample; // 8, 12, 16, 20 or 24
+	bool compress;
+	bool stereo;
+	bool firstAttackOnly;
+	bool firstReleaseOnly;
+	LOOP_LOADING loopLoading;
+};
+
+struct SAMPLE_METADATA {
+	bool isReadable;
+	wxDateTime modificationTime;
+	unsigned numberOfFrames;
+	unsigned numberOfChannels;
+	unsigned bitsPerSample;
+	int firstCue; // -1 if the file has no cue point
+	std::vector<std::pair<unsigned, unsigned>> loops;
+};
+
+enum FOOTPRINT_SUBJECT_KIND {
+	FOOTPRINT_STOP,
+	FOOTPRINT_RANK,
+	FOOTPRINT_WINDCHEST
+};
+
+struct MEMORY_FOOTPRINT {
+	wxString name;
+	unsigned nbrOfPipes;
+	unsigned nbrOfSamples;
+	unsigned nbrOfUnreadable;
+	uint64_t frames;
+	uint64_t bytes;
+};
+
+// Estimates how much memory GrandOrgue needs for the samples of an organ under
+// different loading settings. The headers of all sample files are read once
+// (in parallel) and kept until the files change, so estimates for other
+// settings only redo the arithmetic. Sample memory is counted per pipe and
+// summed per rank, stop (the pipe range it uses of each rank), windchest and
+// for the whole organ, where every rank is counted only once.
+class MemoryFootprintEstimator {
+
+public:
+	MemoryFootprintEstimator(unsigned nbrOfThreads = 0);
+	~MemoryFootprintEstimator();
+
+	static GO_LOADING_OPTIONS getDefaultOptions();
+	static wxString getOptionsDescription(const GO_LOADING_OPTIONS &options);
+
+	// reads the headers of new or changed sample files of the organ, returns
+	// false if aborted from the progress dialog
+	bool scan(Organ *organ, wxProgressDialog *progress = NULL);
+	void estimate(Organ *organ, const GO_LOADING_OPTIONS &options);
+	void clear();
+
+	unsigned getNumberOfFootprints(FOOTPRINT_SUBJECT_KIND kind);
+	MEMORY_FOOTPRINT* getFootprintAt(FOOTPRINT_SUBJECT_KIND kind, unsigned index);
+	MEMORY_FOOTPRINT* getOrganFootprint();
+
+	// only valid for files that have been scanned
+	uint64_t estimatePipe(Pipe &pipe, const GO_LOADING_OPTIONS &options, unsigned *nbrOfSamples = NULL, unsigned *nbrOfUnreadable = NULL, uint64_t *frames = NULL);
+
+private:
+	unsigned m_nbrOfThreads;
+	std::map<wxString, SAMPLE_METADATA> m_metadata;
+	std::vector<MEMORY_FOOTPRINT> m_stops;
+	std::vector<MEMORY_FOOTPRINT> m_ranks;
+	std::vector<MEMORY_FOOTPRINT> m_windchests;
+	MEMORY_FOOTPRINT m_organ;
+
+	void collectPaths(Rank *rank, std::vector<wxString> &paths);
+	void readMetadata(const wxString &fullPath, SAMPLE_METADATA &metadata);
+	const SAMPLE_METADATA* getMetadata(const wxString &fullPath);
+	uint64_t getAttackFrames(Attack &attack, const SAMPLE_METADATA &metadata, const GO_LOADING_OPTIONS &options);
+	uint64_t getReleaseFrames(int cuePoint, int releaseEnd, const SAMPLE_METADATA &metadata);
+	void addRank(Rank *rank, unsigned firstPipe, unsigned pipeCount, const GO_LOADING_OPTIONS &options, MEMORY_FOOTPRINT &footprint);
+	static void initFootprint(MEMORY_FOOTPRINT &footprint, const wxString &name);
+	static void addFootprint(MEMORY_FOOTPRINT &target, const MEMORY_FOOTPRINT &source);
+};
+
+#endif
@@ -0,0 +1,497 @@
+/* 
+ * OdfBatchTool.cpp is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#include "OdfBatchTool.h"
+#include "GOODF.h"
+#include "OrganFileParser.h"
+#include "OdfWriter.h"
+#include "CmbParser.h"
+#include "CmbVoicing.h"
+#include "ParallelTaskRunner.h"
+#include "OrganValidator.h"
+#include "PanelRenderer.h"
+#include "ImageAssetOptimizer.h"
+#include "MemoryFootprintEstimator.h"
+#include "SampleTranscoder.h"
+#include "OrganPackager.h"
+#include <wx/cmdline.h>
+#include <mutex>
+
+// goodf-cli is the windowless app running the batch tool
+int GOODF::OnRun() {
+	OdfBatchTool tool;
+	return tool.run(argc, argv);
+}
+
+// collects what is logged while one file is processed
+class BatchFileLog : public wxLog {
+public:
+	BatchFileLog(CLI_FILE_RESULT &result) : m_result(result) {}
+
+protected:
+	virtual void DoLogRecord(wxLogLevel level, const wxString &msg, const wxLogRecordInfo &WXUNUSED(info)) {
+		if (level <= wxLOG_Error) {
+			m_result.messages.Add(wxT("Error: ") + msg);
+		} else if (level == wxLOG_Warning) {
+			m_result.messages.Add(wxT("Warning: ") + msg);
+			m_result.nbrOfWarnings++;
+		} else if (level <= wxLOG_Info) {
+			m_result.messages.Add(msg);
+		}
+	}
+
+private:
+	CLI_FILE_RESULT &m_result;
+};
+
+static const wxCmdLineEntryDesc CLI_COMMAND_LINE[] = {
+	{ wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+	{ wxCMD_LINE_OPTION, "j", "jobs", "number of files processed at the same time (default is one per cpu core)", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, "s", "suffix", "rewrite/import-cmb/optimize-images/transcode: appended to the name of the written file (default is -goodf)", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_SWITCH, NULL, "in-place", "rewrite/import-cmb/optimize-images/transcode: overwrite the given organ files" },
+	{ wxCMD_LINE_OPTION, "c", "cmb", "import-cmb: the .cmb file to import", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_SWITCH, NULL, "clamp", "import-cmb: set out of bounds pitch values to the allowed limit instead of skipping them" },
+	{ wxCMD_LINE_SWITCH, NULL, "strict", "validate: also fail files that logged warnings" },
+	{ wxCMD_LINE_SWITCH, NULL, "png", "optimize-images: also write used BMP images as PNG files next to them and use those, the organ files are then processed one at a time" },
+	{ wxCMD_LINE_OPTION, "o", "output", "export-panels/transcode/package: folder the images/samples/package are written to (default is next to the organ file or its transcoded subfolder)", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_OPTION, NULL, "bits", "transcode: reduce the samples to 8, 16 or 24 bits", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_SWITCH, NULL, "mono", "transcode: fold stereo samples to mono" },
+	{ wxCMD_LINE_SWITCH, NULL, "trim", "transcode: cut the samples before AttackStart and after ReleaseEnd" },
+	{ wxCMD_LINE_SWITCH, NULL, "hardlinks", "package: hard link files on the same file system instead of copying them (the package then shares them with the original)" },
+	{ wxCMD_LINE_PARAM, NULL, NULL, "validate|rewrite|import-cmb|stats|optimize-images|export-panels|transcode|package", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_PARAM, NULL, NULL, "organ files", wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+	wxCMD_LINE_DESC_END
+};
+
+OdfBatchTool::OdfBatchTool() {
+	m_clamp = false;
+	m_strict = false;
+	m_png = false;
+	m_bits = 0;
+	m_mono = false;
+	m_trim = false;
+	m_hardLinks = false;
+	m_isProcessingInParallel = false;
+}
+
+OdfBatchTool::~OdfBatchTool() {
+
+}
+
+int OdfBatchTool::run(int argc, const wxCmdLineArgsArray &argv) {
+	wxCmdLineParser parser(CLI_COMMAND_LINE, argc, argv);
+	parser.SetLogo(::wxGetApp().m_fullAppName + wxT(" command line tool"));
+	if (parser.Parse() != 0)
+		return 2;
+
+	m_command = parser.GetParam(0);
+	if (m_command != wxT("validate") && m_command != wxT("rewrite") && m_command != wxT("import-cmb") && m_command != wxT("stats") && m_command != wxT("optimize-images") && m_command != wxT("export-panels") && m_command != wxT("transcode") && m_command != wxT("package")) {
+		wxFprintf(stderr, wxT("Unknown command %s\n"), m_command);
+		parser.Usage();
+		return 2;
+	}
+	// the original is only overwritten when explicitly asked for
+	bool inPlace = parser.Found(wxT("in-place"));
+	bool hasSuffix = parser.Found(wxT("s"), &m_suffix);
+	if (inPlace && hasSuffix) {
+		wxFprintf(stderr, wxT("--suffix and --in-place can't be used together\n"));
+		return 2;
+	}
+	if (hasSuffix && m_suffix.IsEmpty()) {
+		wxFprintf(stderr, wxT("--suffix can't be empty, use --in-place to overwrite the organ files\n"));
+		return 2;
+	}
+	if (!inPlace && !hasSuffix)
+		m_suffix = wxT("-goodf");
+	if (parser.Found(wxT("o"), &m_outputDir)) {
+		wxFileName outputDir = wxFileName::DirName(m_outputDir);
+		outputDir.MakeAbsolute();
+		if (!outputDir.DirExists() && !outputDir.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+			wxFprintf(stderr, wxT("The output folder %s could not be created\n"), outputDir.GetFullPath());
+			return 2;
+		}
+		m_outputDir = outputDir.GetFullPath();
+	}
+	m_clamp = parser.Found(wxT("clamp"));
+	m_strict = parser.Found(wxT("strict"));
+	m_png = parser.Found(wxT("png"));
+	m_mono = parser.Found(wxT("mono"));
+	m_trim = parser.Found(wxT("trim"));
+	m_hardLinks = parser.Found(wxT("hardlinks"));
+	if (m_command == wxT("export-panels") && !::wxGetApp().HasDisplay()) {
+		wxFprintf(stderr, wxT("export-panels draws the panels with the gui toolkit and needs a display, set DISPLAY or run it with xvfb-run\n"));
+		return 2;
+	}
+	if (m_command == wxT("package") && m_outputDir.IsEmpty()) {
+		wxFprintf(stderr, wxT("package needs the folder of the package given with --output\n"));
+		return 2;
+	}
+	long bits = 0;
+	if (parser.Found(wxT("bits"), &bits) && bits != 8 && bits != 16 && bits != 24) {
+		wxFprintf(stderr, wxT("--bits must be 8, 16 or 24\n"));
+		return 2;
+	}
+	m_bits = bits;
+	if (m_command == wxT("transcode") && !m_bits && !m_mono && !m_trim) {
+		wxFprintf(stderr, wxT("transcode needs at least one of --bits, --mono and --trim\n"));
+		return 2;
+	}
+	long nbrOfJobs = 0;
+	parser.Found(wxT("j"), &nbrOfJobs);
+
+	if (m_command == wxT("import-cmb")) {
+		wxString cmbPath;
+		if (!parser.Found(wxT("c"), &cmbPath)) {
+			wxFprintf(stderr, wxT("import-cmb needs the .cmb file given with --cmb\n"));
+			return 2;
+		}
+		CmbParser cmbParser(cmbPath, &m_cmbOrgan);
+		if (!cmbParser.IsParsedOk()) {
+			wxFprintf(stderr, wxT("%s could not be read: %s\n"), cmbPath, cmbParser.GetErrorText());
+			return 1;
+		}
+	}
+
+	wxArrayString files;
+	for (size_t i = 1; i < parser.GetParamCount(); i++) {
+		wxFileName fn(parser.GetParam(i));
+		fn.MakeAbsolute();
+		files.Add(fn.GetFullPath());
+	}
+
+	// the results are printed in the order the files were given, as soon as
+	// every file before them is done too
+	std::vector<CLI_FILE_RESULT> results(files.GetCount());
+	for (CLI_FILE_RESULT &r : results) {
+		r.isDone = false;
+		r.success = false;
+		r.nbrOfWarnings = 0;
+	}
+	std::mutex printMutex;
+	size_t nextToPrint = 0;
+	auto processAndPrint = [&](unsigned index) {
+		// files processed serially run on the main thread, which only uses the
+		// global log target, messages that threads of the tools logged meanwhile
+		// are passed on to it before it's restored
+		BatchFileLog log(results[index]);
+		bool isMainThread = wxThread::IsMain();
+		wxLog *previousLog = isMainThread ? wxLog::SetActiveTarget(&log) : wxLog::SetThreadActiveTarget(&log);
+		processFile(files[index], results[index]);
+		if (isMainThread) {
+			wxLog::FlushActive();
+			wxLog::SetActiveTarget(previousLog);
+		} else {
+			wxLog::SetThreadActiveTarget(previousLog);
+		}
+
+		std::lock_guard<std::mutex> lock(printMutex);
+		results[index].isDone = true;
+		while (nextToPrint < results.size() && results[nextToPrint].isDone) {
+			printResult(files[nextToPrint], results[nextToPrint]);
+			nextToPrint++;
+		}
+	};
+	// the names of new png files are chosen by what exists on disk, so organs
+	// that share images must not pick them at the same time
+	bool isSerial = m_command == wxT("export-panels") || (m_command == wxT("optimize-images") && m_png);
+	m_isProcessingInParallel = !isSerial && files.GetCount() > 1 && nbrOfJobs != 1;
+	if (!m_isProcessingInParallel) {
+		for (unsigned i = 0; i < files.GetCount(); i++)
+			processAndPrint(i);
+	} else {
+		ParallelTaskRunner runner(nbrOfJobs > 0 ? nbrOfJobs : 0);
+		runner.run(files.GetCount(), processAndPrint);
+	}
+
+	int exitCode = 0;
+	for (const CLI_FILE_RESULT &r : results) {
+		if (!r.success)
+			exitCode = 1;
+	}
+	return exitCode;
+}
+
+void OdfBatchTool::processFile(const wxString &filePath, CLI_FILE_RESULT &result) {
+	Organ *organ = new Organ();
+	::wxGetApp().m_frame->m_organ = organ;
+	{
+		OrganFileParser parser(filePath, organ);
+		result.success = parser.isOrganReady();
+	}
+	if (!result.success) {
+		result.messages.Add(wxT("Error: the file could not be parsed as an organ"));
+	} else if (m_command == wxT("validate")) {
+		OrganValidator validator(getNumberOfThreadsPerFile());
+		validator.validate(organ);
+		for (const VALIDATION_DIAGNOSTIC &diag : validator.getDiagnostics()) {
+			wxString subject = OrganValidator::getSubjectName(organ, diag.kind, diag.subjectIndex);
+			if (diag.severity == VALIDATION_ERROR) {
+				result.messages.Add(wxT("Error: ") + subject + wxT(": ") + diag.message);
+			} else {
+				result.messages.Add(wxT("Warning: ") + subject + wxT(": ") + diag.message);
+				result.nbrOfWarnings++;
+			}
+		}
+		if (validator.getNumberOfErrors() > 0)
+			result.success = false;
+		if (m_strict && result.nbrOfWarnings > 0)
+			result.success = false;
+	} else if (m_command == wxT("rewrite")) {
+		result.success = rewriteOrgan(organ, filePath, result);
+	} else if (m_command == wxT("import-cmb")) {
+		importCmb(organ, result);
+		result.success = rewriteOrgan(organ, filePath, result);
+	} else if (m_command == wxT("stats")) {
+		collectStatistics(organ, result);
+	} else if (m_command == wxT("optimize-images")) {
+		optimizeImages(organ, result);
+		result.success = rewriteOrgan(organ, filePath, result);
+	} else if (m_command == wxT("export-panels")) {
+		result.success = exportPanels(organ, filePath, result);
+	} else if (m_command == wxT("transcode")) {
+		result.success = transcodeSamples(organ, filePath, result) && rewriteOrgan(organ, filePath, result);
+	} else if (m_command == wxT("package")) {
+		result.success = packageOrgan(organ, filePath, result);
+	}
+	::wxGetApp().m_frame->m_organ = NULL;
+	delete organ;
+}
+
+bool OdfBatchTool::rewriteOrgan(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result) {
+	// written next to the original so that the relative sample paths stay valid
+	wxFileName target(filePath);
+	target.SetName(target.GetName() + m_suffix);
+	wxString targetPath = target.GetFullPath();
+
+	organ->fixTrailingSpacesInStrings();
+	ODF_WRITE_JOB *job = OdfWriter::createJob(organ, targetPath, wxID_ANY, true);
+	bool success = OdfWriter::writeJob(job);
+	OdfWriter::deleteJob(job);
+	if (!success) {
+		result.messages.Add(wxT("Error: ") + targetPath + wxT(" could not be written"));
+		return false;
+	}
+	organ->setModified(false);
+	result.output = wxT("Written to ") + targetPath;
+	return true;
+}
+
+void OdfBatchTool::importCmb(Organ *organ, CLI_FILE_RESULT &result) {
+	if (!CmbVoicing::countsMatch(&m_cmbOrgan, organ))
+		result.messages.Add(wxT("Warning: the number of windchests/ranks/stops in the cmb doesn't match the organ, only what is possible is imported"));
+
+	CMB_IMPORT_OPTIONS options;
+	options.amplitude = true;
+	options.gain = true;
+	options.pitchTuning = true;
+	options.pitchCorrection = true;
+	options.trackerDelay = true;
+	bool clamp = m_clamp;
+	CmbVoicing::apply(&m_cmbOrgan, organ, options, [&result, clamp](const wxString &attribute) {
+		result.messages.Add(wxT("Warning: a ") + attribute + wxT(" value would be out of bounds and was ") + (clamp ? wxT("set to the limit") : wxT("skipped")));
+		return clamp;
+	});
+}
+
+void OdfBatchTool::optimizeImages(Organ *organ, CLI_FILE_RESULT &result) {
+	ImageAssetOptimizer optimizer(organ, getNumberOfThreadsPerFile());
+	optimizer.scan();
+	unsigned nbrOfDuplicates = optimizer.getNumberOfDuplicateFiles();
+	wxULongLong redundantBytes = optimizer.getRedundantBytes();
+	unsigned nbrChanged = optimizer.makePathsShared();
+	result.messages.Add(wxString::Format(wxT("%u duplicate images (%s) replaced in %u references"), nbrOfDuplicates, wxFileName::GetHumanReadableSize(redundantBytes), nbrChanged));
+	if (m_png) {
+		nbrChanged = optimizer.reencodeToPng();
+		result.messages.Add(wxString::Format(wxT("%u references changed to PNG files (%s smaller)"), nbrChanged, wxFileName::GetHumanReadableSize(optimizer.getBytesSavedByReencoding())));
+	}
+}
+
+bool OdfBatchTool::transcodeSamples(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result) {
+	TRANSCODE_OPTIONS options;
+	options.bitsPerSample = m_bits;
+	options.foldToMono = m_mono;
+	options.trim = m_trim;
+	options.outputFolder = m_outputDir;
+	if (options.outputFolder.IsEmpty())
+		options.outputFolder = wxFileName(filePath).GetPath() + wxFILE_SEP_PATH + wxT("transcoded");
+
+	std::vector<Rank*> ranks;
+	for (Rank &r : *organ->getOrganRanks())
+		ranks.push_back(&r);
+	for (Stop &s : *organ->getOrganStops()) {
+		if (s.isUsingInternalRank())
+			ranks.push_back(s.getInternalRank());
+	}
+
+	SampleTranscoder transcoder(organ, ranks, options, getNumberOfThreadsPerFile(), m_isProcessingInParallel ? 1 : SampleTranscoder::DEFAULT_CONCURRENT_IO);
+	transcoder.prepare();
+	transcoder.transcode();
+	unsigned nbrChanged = transcoder.applyToOrgan();
+	bool success = true;
+	for (unsigned i = 0; i < transcoder.getNumberOfJobs(); i++) {
+		TRANSCODE_JOB *job = transcoder.getJobAt(i);
+		if (!job->isWritten) {
+			result.messages.Add(wxT("Error: ") + job->sourcePath + wxT(" ") + job->error);
+			success = false;
+		}
+	}
+	for (const wxString &skipped : transcoder.getSkippedFiles()) {
+		result.messages.Add(wxT("Warning: ") + skipped + wxT(" isn't an uncompressed pcm wav file and was left as it is"));
+		result.nbrOfWarnings++;
+	}
+	result.messages.Add(wxString::Format(
+		wxT("%u sample files transcoded (%s instead of %s), %u attacks/releases changed"),
+		transcoder.getNumberOfWrittenFiles(),
+		wxFileName::GetHumanReadableSize(transcoder.getTargetBytes()),
+		wxFileName::GetHumanReadableSize(transcoder.getSourceBytes()),
+		nbrChanged
+	));
+	return success;
+}
+
+bool OdfBatchTool::packageOrgan(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result) {
+	wxString odfName = wxFileName(filePath).GetName();
+	if (wxFileName::DirName(m_outputDir).SameAs(wxFileName::DirName(organ->getOdfRoot()))) {
+		result.messages.Add(wxT("Error: the package must be written to another folder than the one of the organ"));
+		return false;
+	}
+
+	OrganPackager packager(organ, getNumberOfThreadsPerFile(), m_isProcessingInParallel ? 1 : OrganPackager::DEFAULT_CONCURRENT_IO);
+	packager.copyFiles(m_outputDir, m_hardLinks);
+	bool success = true;
+	for (unsigned i = 0; i < packager.getNumberOfFiles(); i++) {
+		PACKAGE_FILE *file = packager.getFileAt(i);
+		if (!file->exists) {
+			result.messages.Add(wxT("Warning: ") + file->sourcePath + wxT(" is used by the organ but doesn't exist"));
+			result.nbrOfWarnings++;
+		} else if (!file->isCopied) {
+			result.messages.Add(wxT("Error: ") + file->sourcePath + wxT(" ") + file->error);
+			success = false;
+		}
+	}
+	if (!packager.writeManifest(m_outputDir, odfName + wxT(".sha256"))) {
+		result.messages.Add(wxT("Error: the checksum manifest couldn't be written"));
+		success = false;
+	}
+	if (!packager.writeOrgan(m_outputDir, odfName)) {
+		result.messages.Add(wxT("Error: the odf couldn't be written to the package"));
+		return false;
+	}
+	result.output = wxString::Format(
+		wxT("Packaged to %s with %u files (%s), %u of them linked"),
+		m_outputDir,
+		packager.getNumberOfCopiedFiles(),
+		wxFileName::GetHumanReadableSize(packager.getTotalBytes()),
+		packager.getNumberOfLinkedFiles()
+	);
+	return success;
+}
+
+void OdfBatchTool::collectStatistics(Organ *organ, CLI_FILE_RESULT &result) {
+	unsigned nbrOfInternalRanks = 0;
+	unsigned nbrOfPipes = 0;
+	unsigned nbrOfAttacks = 0;
+	unsigned nbrOfReleases = 0;
+	auto countPipes = [&](Rank *rank) {
+		for (Pipe &p : rank->m_pipes) {
+			nbrOfPipes++;
+			nbrOfAttacks += p.m_attacks.size();
+			nbrOfReleases += p.m_releases.size();
+		}
+	};
+	for (Rank &r : *organ->getOrganRanks())
+		countPipes(&r);
+	for (Stop &s : *organ->getOrganStops()) {
+		if (s.isUsingInternalRank()) {
+			nbrOfInternalRanks++;
+			countPipes(s.getInternalRank());
+		}
+	}
+	unsigned nbrOfGuiElements = 0;
+	unsigned nbrOfImages = 0;
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+		nbrOfGuiElements += organ->getOrganPanelAt(i)->getNumberOfGuiElements();
+		nbrOfImages += organ->getOrganPanelAt(i)->getNumberOfImages();
+	}
+
+	result.output = wxString::Format(
+		wxT("Enclosures: %u\nTremulants: %u\nWindchestgroups: %u\nSwitches: %u\nRanks: %u\nStops: %u (%u with internal ranks)\n")
+		wxT("Manuals: %u\nCouplers: %u\nDivisionals: %u\nDivisional couplers: %u\nGenerals: %u\nReversible pistons: %u\n")
+		wxT("Panels: %u\nGUI elements: %u\nImages: %u\nPipes: %u\nAttacks: %u\nReleases: %u"),
+		organ->getNumberOfEnclosures(), organ->getNumberOfTremulants(), organ->getNumberOfWindchestgroups(),
+		organ->getNumberOfSwitches(), organ->getNumberOfRanks(), organ->getNumberOfStops(), nbrOfInternalRanks,
+		organ->getNumberOfManuals(), organ->getNumberOfCouplers(), organ->getNumberOfDivisionals(),
+		organ->getNumberOfOrganDivisionalCouplers(), organ->getNumberOfGenerals(), organ->getNumberOfReversiblePistons(),
+		organ->getNumberOfPanels(), nbrOfGuiElements, nbrOfImages, nbrOfPipes, nbrOfAttacks, nbrOfReleases
+	);
+
+	// the sample memory is estimated for the default loading settings of GrandOrgue
+	MemoryFootprintEstimator estimator(getNumberOfThreadsPerFile());
+	GO_LOADING_OPTIONS options = MemoryFootprintEstimator::getDefaultOptions();
+	estimator.scan(organ);
+	estimator.estimate(organ, options);
+	result.output += wxString::Format(
+		wxT("\nEstimated sample memory (%s): %s"),
+		MemoryFootprintEstimator::getOptionsDescription(options),
+		wxFileName::GetHumanReadableSize(wxULongLong(estimator.getOrganFootprint()->bytes))
+	);
+}
+
+bool OdfBatchTool::exportPanels(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result) {
+	wxFileName target(filePath);
+	if (!m_outputDir.IsEmpty())
+		target.SetPath(m_outputDir);
+	wxString baseName = target.GetName();
+	target.SetExt(wxT("png"));
+
+	bool success = true;
+	unsigned nbrOfExported = 0;
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+		target.SetName(baseName + wxString::Format(wxT("-panel%03u"), i));
+		PanelRenderer renderer(organ->getOrganPanelAt(i));
+		if (renderer.ExportToPng(target.GetFullPath())) {
+			nbrOfExported++;
+		} else {
+			result.messages.Add(wxT("Error: ") + target.GetFullPath() + wxT(" could not be written"));
+			success = false;
+		}
+	}
+	result.output = wxString::Format(wxT("Exported %u of %u panels to "), nbrOfExported, organ->getNumberOfPanels()) + target.GetPath();
+	return success;
+}
+
+unsigned OdfBatchTool::getNumberOfThreadsPerFile() {
+	// files that are processed in parallel already keep every core busy, so
+	// each of them uses one thread, a file processed alone uses the default
+	// number of threads of the tool (0)
+	return m_isProcessingInParallel ? 1 : 0;
+}
+
+void OdfBatchTool::printResult(const wxString &filePath, const CLI_FILE_RESULT &result) {
+	wxPrintf(wxT("%s: %s\n"), filePath, result.success ? wxT("OK") : wxT("FAILED"));
+	for (const wxString &msg : result.messages)
+		wxPrintf(wxT("  %s\n"), msg);
+	if (!result.output.IsEmpty()) {
+		wxString output = result.output;
+		output.Replace(wxT("\n"), wxT("\n  "));
+		wxPrintf(wxT("  %s\n"), output);
+	}
+	fflush(stdout);
+}
@@ -0,0 +1,78 @@
+/* 
+ * OdfBatchTool.h is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#ifndef ODFBATCHTOOL_H
+#define ODFBATCHTOOL_H
+
+#include <wx/wx.h>
+#include <wx/cmdargs.h>
+#include "Organ.h"
+#include "CmbOrgan.h"
+
+struct CLI_FILE_RESULT {
+	bool isDone;
+	bool success;
+	wxArrayString messages;
+	unsigned nbrOfWarnings;
+	wxString output;
+};
+
+// The commands of goodf-cli: validate, rewrite, import-cmb, stats,
+// optimize-images, export-panels, transcode and package. Every organ file is parsed into an organ of its own so that
+// several files can be processed in parallel, and the results are printed in
+// the order given. Panels are drawn with wxDC which must stay on the main
+// thread, so export-panels processes the files one after another, as does
+// optimize-images --png so that organs sharing a BMP image don't pick the
+// same name for its PNG file at the same time.
+class OdfBatchTool {
+public:
+	OdfBatchTool();
+	~OdfBatchTool();
+
+	// returns the exit code, 0 if all files succeeded, 1 if any failed and 2 for usage errors
+	int run(int argc, const wxCmdLineArgsArray &argv);
+
+private:
+	wxString m_command;
+	wxString m_suffix;
+	wxString m_outputDir;
+	bool m_clamp;
+	bool m_strict;
+	bool m_png;
+	unsigned m_bits;
+	bool m_mono;
+	bool m_trim;
+	bool m_hardLinks;
+	bool m_isProcessingInParallel;
+	CMB_ORGAN m_cmbOrgan;
+
+	void processFile(const wxString &filePath, CLI_FILE_RESULT &result);
+	bool rewriteOrgan(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result);
+	void importCmb(Organ *organ, CLI_FILE_RESULT &result);
+	void optimizeImages(Organ *organ, CLI_FILE_RESULT &result);
+	bool transcodeSamples(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result);
+	bool packageOrgan(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result);
+	void collectStatistics(Organ *organ, CLI_FILE_RESULT &result);
+	bool exportPanels(Organ *organ, const wxString &filePath, CLI_FILE_RESULT &result);
+	unsigned getNumberOfThreadsPerFile();
+	void printResult(const wxString &filePath, const CLI_FILE_RESULT &result);
+};
+
+#endif
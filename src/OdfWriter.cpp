@@ -0,0 +1,197 @@
+/*
+ * OdfWriter.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OdfWriter.h"
+#include "Organ.h"
+#include "OrganSnapshot.h"
+#include "PathRebaser.h"
+#include "FileExistenceCache.h"
+#include "TraceRecorder.h"
+
+thread_local ODF_WRITE_JOB *OdfWriter::m_creatingJob = NULL;
+
+OdfWriter::OdfWriter(wxEvtHandler *owner) {
+	m_owner = owner;
+	m_isWriting = false;
+	m_stop = false;
+	m_worker = std::thread(&OdfWriter::processJobs, this);
+}
+
+OdfWriter::~OdfWriter() {
+	waitUntilDone();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_all();
+	m_worker.join();
+}
+
+ODF_WRITE_JOB* OdfWriter::createJob(Organ *organ, wxString filePath, int eventId, bool writeSnapshot) {
+	TraceScope trace("OdfWriter::createJob", filePath);
+	ODF_WRITE_JOB *job = new ODF_WRITE_JOB();
+	// the file is not opened or created here, it's only used as a line buffer
+	job->lines = new wxTextFile(filePath);
+	job->filePath = filePath;
+	job->odfRoot = organ->getOdfRoot();
+	job->eventId = eventId;
+	job->modificationCount = organ->getModificationCount();
+	job->writeSnapshot = writeSnapshot;
+	m_creatingJob = job;
+	organ->writeOrgan(job->lines);
+	m_creatingJob = NULL;
+	return job;
+}
+
+bool OdfWriter::writeJob(ODF_WRITE_JOB *job) {
+	TraceScope trace("OdfWriter::writeJob");
+	// samples that don't exist keep their full path, as removeBaseOdfPath does
+	PathRebaser rebaser(job->odfRoot);
+	FileExistenceCache existence;
+	listSampleFolders(job, rebaser, existence);
+	PathRebaser *previousRebaser = PathRebaser::getActive();
+	FileExistenceCache *previousCache = FileExistenceCache::getActive();
+	PathRebaser::setActive(&rebaser);
+	FileExistenceCache::setActive(&existence);
+
+	insertPipeLines(job);
+	// wxTextFile writes to a temporary file that replaces the target when complete
+	bool success = job->lines->Write(wxTextFileType_Dos, wxCSConv("ISO-8859-1"));
+	if (success && job->writeSnapshot) {
+		// lets the next opening of this file skip reading all the pipes again
+		OrganSnapshot snapshot;
+		snapshot.write(job->filePath, job);
+	}
+
+	PathRebaser::setActive(previousRebaser);
+	FileExistenceCache::setActive(previousCache);
+	return success;
+}
+
+void OdfWriter::deleteJob(ODF_WRITE_JOB *job) {
+	for (ODF_PIPE_BLOCK &block : job->pipeBlocks)
+		delete block.rank;
+	delete job->lines;
+	delete job;
+}
+
+bool OdfWriter::deferPipes(wxTextFile *outFile, Rank *rank, const std::vector<int> &windchestRefs) {
+	ODF_WRITE_JOB *job = m_creatingJob;
+	if (!job || job->lines != outFile)
+		return false;
+	ODF_PIPE_BLOCK block;
+	block.lineIndex = outFile->GetLineCount();
+	// the section header is written just before the keys of the rank
+	for (size_t i = block.lineIndex; i > 0; i--) {
+		const wxString &line = outFile->GetLine(i - 1);
+		if (line.StartsWith(wxT("["))) {
+			block.sectionName = line.Mid(1).BeforeFirst(wxT(']'));
+			break;
+		}
+	}
+	block.rank = new Rank(*rank);
+	block.windchestRefs = windchestRefs;
+	job->pipeBlocks.push_back(block);
+	return true;
+}
+
+void OdfWriter::listSampleFolders(ODF_WRITE_JOB *job, PathRebaser &rebaser, FileExistenceCache &existence) {
+	for (ODF_PIPE_BLOCK &block : job->pipeBlocks) {
+		for (Pipe &p : block.rank->m_pipes) {
+			for (Attack &a : p.m_attacks)
+				rebaser.addFile(a.fullPath);
+			for (Release &r : p.m_releases)
+				rebaser.addFile(r.fullPath);
+		}
+	}
+	existence.prefetchDirectories(rebaser.getDirectories());
+}
+
+void OdfWriter::insertPipeLines(ODF_WRITE_JOB *job) {
+	if (job->pipeBlocks.empty())
+		return;
+	TraceScope trace("OdfWriter::insertPipeLines");
+	wxTextFile *lines = new wxTextFile(job->filePath);
+	size_t nextLine = 0;
+	for (ODF_PIPE_BLOCK &block : job->pipeBlocks) {
+		for (; nextLine < block.lineIndex; nextLine++)
+			lines->AddLine(job->lines->GetLine(nextLine));
+		block.rank->writePipes(lines, block.windchestRefs);
+	}
+	for (; nextLine < job->lines->GetLineCount(); nextLine++)
+		lines->AddLine(job->lines->GetLine(nextLine));
+	delete job->lines;
+	job->lines = lines;
+}
+
+void OdfWriter::write(ODF_WRITE_JOB *job) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+			if ((*it)->filePath.IsSameAs(job->filePath)) {
+				deleteJob(*it);
+				m_jobs.erase(it);
+				break;
+			}
+		}
+		m_jobs.push_back(job);
+	}
+	m_condition.notify_all();
+}
+
+bool OdfWriter::isBusy() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isWriting || !m_jobs.empty();
+}
+
+void OdfWriter::waitUntilDone() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]{ return !m_isWriting && m_jobs.empty(); });
+}
+
+void OdfWriter::processJobs() {
+	while (true) {
+		ODF_WRITE_JOB *job = NULL;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+			if (m_jobs.empty())
+				return;
+			job = m_jobs.front();
+			m_jobs.pop_front();
+			m_isWriting = true;
+		}
+
+		bool success = writeJob(job);
+
+		wxThreadEvent *evt = new wxThreadEvent(wxEVT_THREAD, job->eventId);
+		evt->SetString(job->filePath);
+		evt->SetInt(success ? 1 : 0);
+		evt->SetExtraLong(job->modificationCount);
+		wxQueueEvent(m_owner, evt);
+
+		deleteJob(job);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isWriting = false;
+		}
+		m_doneCondition.notify_all();
+	}
+}
@@ -0,0 +1,99 @@
+/*
+ * OdfWriter.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ODFWRITER_H
+#define ODFWRITER_H
+
+#include <wx/wx.h>
+#include <wx/textfile.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <vector>
+
+class Organ;
+class Rank;
+class PathRebaser;
+class FileExistenceCache;
+
+// A copy of the pipes of a rank or internal rank with the windchests already
+// resolved, so that their lines can be made without touching the organ.
+struct ODF_PIPE_BLOCK {
+	size_t lineIndex; // the pipe lines go in before this line of the job
+	wxString sectionName;
+	Rank *rank; // owned copy
+	std::vector<int> windchestRefs;
+};
+
+// The lines of the organ except the pipes are created on the gui thread, the
+// pipes are only copied. The pipe lines, with sample paths made relative from
+// one listing per folder, the encoding, writing and the optional snapshot are
+// then done on a worker thread so that the gui stays responsive. When a write
+// is done a wxThreadEvent with the given id is queued to the owner where the
+// string is the file path, the int is 1 on success and the extra long is the
+// modification count of the organ when the lines were created.
+struct ODF_WRITE_JOB {
+	wxTextFile *lines;
+	std::list<ODF_PIPE_BLOCK> pipeBlocks;
+	wxString filePath;
+	wxString odfRoot;
+	int eventId;
+	long modificationCount;
+	bool writeSnapshot;
+};
+
+class OdfWriter {
+public:
+	OdfWriter(wxEvtHandler *owner);
+	~OdfWriter();
+
+	// the returned job can be given to write()
+	static ODF_WRITE_JOB* createJob(Organ *organ, wxString filePath, int eventId, bool writeSnapshot = false);
+	// makes the pipe lines, encodes and writes the job on the calling thread
+	static bool writeJob(ODF_WRITE_JOB *job);
+	static void deleteJob(ODF_WRITE_JOB *job);
+	// called by Rank when it writes its pipes, true if they were copied into the job being created
+	static bool deferPipes(wxTextFile *outFile, Rank *rank, const std::vector<int> &windchestRefs);
+	// lists the folders of all samples in the pipe blocks once
+	static void listSampleFolders(ODF_WRITE_JOB *job, PathRebaser &rebaser, FileExistenceCache &existence);
+	// takes over the job, a job for the same file that hasn't started yet is replaced
+	void write(ODF_WRITE_JOB *job);
+	bool isBusy();
+	void waitUntilDone();
+
+private:
+	wxEvtHandler *m_owner;
+	std::thread m_worker;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::condition_variable m_doneCondition;
+	std::deque<ODF_WRITE_JOB*> m_jobs;
+	bool m_isWriting;
+	bool m_stop;
+
+	static thread_local ODF_WRITE_JOB *m_creatingJob;
+
+	void processJobs();
+	static void insertPipeLines(ODF_WRITE_JOB *job);
+};
+
+#endif
@@ -21,12 +21,20 @@
 #include "Organ.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "UndoHistory.h"
+#include "TraceRecorder.h"
+#include "PathRebaser.h"
+#include "FileExistenceCache.h"
 #include <algorithm>
+#include <unordered_set>
+
+std::atomic<long> Organ::s_lastModificationCount(0);
 
 Organ::Organ() {
 	// Initialize a new blank organ
 	m_odfRoot = wxEmptyString;
 	m_isModified = false;
+	m_modificationCount = ++s_lastModificationCount;
 	m_churchName = wxEmptyString;
 	m_churchAddress = wxEmptyString;
 	m_organBuilder = wxEmptyString;
@@ -521,6 +529,7 @@ unsigned Organ::getIndexOfOrganTremulant(Tremulant *tremulant) {
 
 void Organ::addTremulant(Tremulant tremulant, bool isParsing) {
 	m_Tremulants.push_back(tremulant);
+	m_referenceIndex.addReferrer(REFERRER_TREMULANT, static_cast<Drawstop*>(&m_Tremulants.back()));
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -528,13 +537,34 @@ void Organ::addTremulant(Tremulant tremulant, bool isParsing) {
 void Organ::removeTremulantAt(unsigned index) {
 	std::list<Tremulant>::iterator it = m_Tremulants.begin();
 	std::advance(it, index);
-	// the tremulant can be referenced in a reversible piston so we just reset it
-	for (ReversiblePiston& rp : m_ReversiblePistons) {
-		if (rp.getTremulant() == &(*it)) {
-			rp.setTremulant(NULL);
-			rp.setName(wxT("Empty reversible piston"));
+	Tremulant *tremulantToRemove = &(*it);
+	// the referrers are copied as the index changes while the references are removed
+	std::vector<ELEMENT_REFERRER> referrers = getReferrersOf(tremulantToRemove);
+	for (ELEMENT_REFERRER &referrer : referrers) {
+		switch (referrer.type) {
+			case REFERRER_MANUAL:
+				// the manual also removes it from its divisionals
+				static_cast<Manual*>(referrer.element)->removeTremulant(tremulantToRemove);
+				break;
+			case REFERRER_DIVISIONAL:
+				static_cast<Divisional*>(referrer.element)->removeTremulant(tremulantToRemove);
+				break;
+			case REFERRER_GENERAL:
+				static_cast<General*>(referrer.element)->removeTremulant(tremulantToRemove);
+				break;
+			case REFERRER_REVERSIBLE_PISTON: {
+				// the tremulant can be referenced in a reversible piston so we just reset it
+				ReversiblePiston *rp = static_cast<ReversiblePiston*>(referrer.element);
+				rp->setTremulant(NULL);
+				rp->setName(wxT("Empty reversible piston"));
+				break;
+			}
+			default:
+				break;
 		}
 	}
+	m_referenceIndex.removeReferenced(tremulantToRemove);
+	m_referenceIndex.removeReferrer(static_cast<Drawstop*>(tremulantToRemove));
 	m_Tremulants.erase(it);
 	updateOrganElements();
 }
@@ -544,6 +574,10 @@ Windchestgroup* Organ::getOrganWindchestgroupAt(unsigned index) {
 	return &(*iterator);
 }
 
+std::list<Windchestgroup>* Organ::getOrganWindchestgroups() {
+	return &m_Windchestgroups;
+}
+
 unsigned Organ::getNumberOfWindchestgroups() {
 	return m_Windchestgroups.size();
 }
@@ -619,6 +653,7 @@ unsigned Organ::getNumberOfSwitches() {
 
 void Organ::addSwitch(GoSwitch theSwitch, bool isParsing) {
 	m_Switches.push_back(theSwitch);
+	m_referenceIndex.addReferrer(REFERRER_SWITCH, static_cast<Drawstop*>(&m_Switches.back()));
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -644,31 +679,31 @@ void Organ::removeSwitchAt(unsigned index) {
 		return;
 
 	GoSwitch *switchToRemove = getOrganSwitchAt(index);
-	// now that we have the switch reference we should make sure to remove it from any manual that have it
-	for (unsigned i = 0; i < m_Manuals.size(); i++) {
-		if (getOrganManualAt(i)->hasGoSwitchReference(switchToRemove)) {
-			// the manual will also remove the switch reference from any divisional, coupler or stop
-			getOrganManualAt(i)->removeGoSwitch(switchToRemove);
-		} else {
-			// even if the switch is not referenced in the manual itself,
-			// it's still possible that a divisional, coupler or stop might reference it
-			// so we manually check the divisionals in the manual
-			for (unsigned j = 0; j < getOrganManualAt(i)->getNumberOfDivisionals(); j++) {
-				if (getOrganManualAt(i)->getDivisionalAt(j)->hasSwitch(switchToRemove))
-					getOrganManualAt(i)->getDivisionalAt(j)->removeSwitch(switchToRemove);
-			}
-			// and the couplers
-			for (unsigned j = 0; j < getOrganManualAt(i)->getNumberOfCouplers(); j++) {
-				if (getOrganManualAt(i)->getCouplerAt(j)->hasSwitchReference(switchToRemove)) {
-					getOrganManualAt(i)->getCouplerAt(j)->removeSwitchReference(switchToRemove);
-				}
-			}
-			// as well as any stop for references to the switch
-			for (unsigned j = 0; j < getOrganManualAt(i)->getNumberOfStops(); j++) {
-				if (getOrganManualAt(i)->getStopAt(j)->hasSwitchReference(switchToRemove)) {
-					getOrganManualAt(i)->getStopAt(j)->removeSwitchReference(switchToRemove);
-				}
+	// the referrers are copied as the index changes while the references are removed
+	std::vector<ELEMENT_REFERRER> referrers = getReferrersOf(switchToRemove);
+	for (ELEMENT_REFERRER &referrer : referrers) {
+		switch (referrer.type) {
+			case REFERRER_MANUAL:
+				// the manual will also remove the switch reference from any divisional, coupler or stop in it
+				static_cast<Manual*>(referrer.element)->removeGoSwitch(switchToRemove);
+				break;
+			case REFERRER_DIVISIONAL:
+				static_cast<Divisional*>(referrer.element)->removeSwitch(switchToRemove);
+				break;
+			case REFERRER_GENERAL:
+				static_cast<General*>(referrer.element)->removeSwitch(switchToRemove);
+				break;
+			case REFERRER_REVERSIBLE_PISTON: {
+				// the switch can be referenced in a reversible piston so we just reset it
+				ReversiblePiston *rp = static_cast<ReversiblePiston*>(referrer.element);
+				rp->setSwitch(NULL);
+				rp->setName(wxT("Empty reversible piston"));
+				break;
 			}
+			default:
+				// any drawstop related item, including other switches
+				static_cast<Drawstop*>(referrer.element)->removeSwitchReference(switchToRemove);
+				break;
 		}
 	}
 
@@ -679,32 +714,8 @@ void Organ::removeSwitchAt(unsigned index) {
 			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 		}
 	}
-
-	// and any general that reference it
-	for (General& g : m_Generals) {
-		if (g.hasSwitch(switchToRemove)) {
-			g.removeSwitch(switchToRemove);
-		}
-	}
-
-	// the switch can be referenced in a reversible piston so we just reset it
-	for (ReversiblePiston& rp : m_ReversiblePistons) {
-		if (rp.getSwitch() == switchToRemove) {
-			rp.setSwitch(NULL);
-			rp.setName(wxT("Empty reversible piston"));
-		}
-	}
-	// a switch can be referenced in any drawstop related item, including other switches, so they must be removed from them too
-	for (GoSwitch& sw : m_Switches) {
-		if (sw.hasSwitchReference(switchToRemove)) {
-			sw.removeSwitchReference(switchToRemove);
-		}
-	}
-	for (DivisionalCoupler& cplr : m_DivisionalCouplers) {
-		if (cplr.hasSwitchReference(switchToRemove)) {
-			cplr.removeSwitchReference(switchToRemove);
-		}
-	}
+	m_referenceIndex.removeReferenced(switchToRemove);
+	m_referenceIndex.removeReferrer(static_cast<Drawstop*>(switchToRemove));
 	std::list<GoSwitch>::iterator it = m_Switches.begin();
 	std::advance(it, index);
 	m_Switches.erase(it);
@@ -723,23 +734,29 @@ void Organ::moveSwitch(int sourceIndex, int toBeforeIndex) {
 
 	m_Switches.splice(it, m_Switches, theOneToMove);
 
-	// Now that the move is made we should evaluate and validate all switches for their references
-	unsigned currentIdx = 0;
+	// A switch can only reference switches before it. Only the order of the moved switch
+	// relative to the others has changed so only its references and referrers are validated
+	GoSwitch *movedSwitch = &(*theOneToMove);
+	std::unordered_set<Drawstop*> referringSwitches;
+	for (const ELEMENT_REFERRER &referrer : getReferrersOf(movedSwitch)) {
+		if (referrer.type == REFERRER_SWITCH)
+			referringSwitches.insert(static_cast<Drawstop*>(referrer.element));
+	}
+	std::vector<GoSwitch*> invalidReferences;
+	bool isAfterMovedSwitch = false;
 	for (GoSwitch& sw : m_Switches) {
-		if (sw.getFunction() != wxT("Input")) {
-			unsigned compIdx = 0;
-			for (GoSwitch& compSw : m_Switches) {
-				if (compIdx == currentIdx) {
-					compIdx++;
-					continue;
-				}
-				if (sw.hasSwitchReference(&compSw) && compIdx > currentIdx) {
-					sw.removeSwitchReference(&compSw);
-				}
-				compIdx++;
-			}
+		if (&sw == movedSwitch) {
+			isAfterMovedSwitch = true;
+		} else if (isAfterMovedSwitch) {
+			if (movedSwitch->hasSwitchReference(&sw))
+				invalidReferences.push_back(&sw);
+		} else if (referringSwitches.count(&sw) && sw.getFunction() != wxT("Input")) {
+			sw.removeSwitchReference(movedSwitch);
 		}
-		currentIdx++;
+	}
+	if (movedSwitch->getFunction() != wxT("Input")) {
+		for (GoSwitch *sw : invalidReferences)
+			movedSwitch->removeSwitchReference(sw);
 	}
 
 	updateOrganElements();
@@ -750,6 +767,10 @@ Rank* Organ::getOrganRankAt(unsigned index) {
 	return &(*iterator);
 }
 
+std::list<Rank>* Organ::getOrganRanks() {
+	return &m_Ranks;
+}
+
 unsigned Organ::getNumberOfRanks() {
 	return m_Ranks.size();
 }
@@ -798,6 +819,10 @@ Stop* Organ::getOrganStopAt(unsigned index) {
 	return &(*iterator);
 }
 
+std::list<Stop>* Organ::getOrganStops() {
+	return &m_Stops;
+}
+
 unsigned Organ::getNumberOfStops() {
 	return m_Stops.size();
 }
@@ -820,6 +845,7 @@ unsigned Organ::getIndexOfOrganStop(Stop *stop) {
 
 void Organ::addStop(Stop stop, bool isParsing) {
 	m_Stops.push_back(stop);
+	m_referenceIndex.addReferrer(REFERRER_STOP, static_cast<Drawstop*>(&m_Stops.back()));
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -857,6 +883,7 @@ void Organ::removeStopAt(unsigned index) {
 			rp.setName(wxT("Empty reversible piston"));
 		}
 	}
+	m_referenceIndex.removeReferrer(static_cast<Drawstop*>(&(*it)));
 	m_Stops.erase(it);
 	updateOrganElements();
 }
@@ -1205,6 +1232,7 @@ unsigned Organ::getIndexOfOrganManual(Manual *manual) {
 
 void Organ::addManual(Manual manual, bool isParsing) {
 	m_Manuals.push_back(manual);
+	m_referenceIndex.addReferrer(REFERRER_MANUAL, &m_Manuals.back());
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1218,6 +1246,7 @@ void Organ::removeManualAt(unsigned index) {
 			cplr.removeManualReference(&(*it));
 		}
 	}
+	m_referenceIndex.removeReferrer(&(*it));
 	m_Manuals.erase(it);
 	updateOrganElements();
 }
@@ -1281,6 +1310,7 @@ unsigned Organ::getIndexOfOrganCoupler(Coupler *coupler) {
 
 void Organ::addCoupler(Coupler coupler, bool isParsing) {
 	m_Couplers.push_back(coupler);
+	m_referenceIndex.addReferrer(REFERRER_COUPLER, static_cast<Drawstop*>(&m_Couplers.back()));
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1295,6 +1325,7 @@ void Organ::removeCouplerAt(unsigned index) {
 			rp.setName(wxT("Empty reversible piston"));
 		}
 	}
+	m_referenceIndex.removeReferrer(static_cast<Drawstop*>(&(*it)));
 	m_Couplers.erase(it);
 	updateOrganElements();
 }
@@ -1351,6 +1382,7 @@ unsigned Organ::getIndexOfOrganDivisional(Divisional *divisional) {
 
 void Organ::addDivisional(Divisional divisional, bool isParsing) {
 	m_Divisionals.push_back(divisional);
+	m_referenceIndex.addReferrer(REFERRER_DIVISIONAL, &m_Divisionals.back());
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1358,6 +1390,7 @@ void Organ::addDivisional(Divisional divisional, bool isParsing) {
 void Organ::removeDivisionalAt(unsigned index) {
 	std::list<Divisional>::iterator it = m_Divisionals.begin();
 	std::advance(it, index);
+	m_referenceIndex.removeReferrer(&(*it));
 	m_Divisionals.erase(it);
 	updateOrganElements();
 }
@@ -1408,6 +1441,7 @@ unsigned Organ::getIndexOfOrganDivisionalCoupler(DivisionalCoupler *divCplr) {
 
 void Organ::addDivisionalCoupler(DivisionalCoupler divCplr, bool isParsing) {
 	m_DivisionalCouplers.push_back(divCplr);
+	m_referenceIndex.addReferrer(REFERRER_DIVISIONAL_COUPLER, static_cast<Drawstop*>(&m_DivisionalCouplers.back()));
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1428,6 +1462,7 @@ void Organ::removeDivisionalCouplerAt(unsigned index) {
 			g.removeDivisionalCoupler(&(*it));
 		}
 	}
+	m_referenceIndex.removeReferrer(static_cast<Drawstop*>(&(*it)));
 	m_DivisionalCouplers.erase(it);
 	updateOrganElements();
 }
@@ -1442,6 +1477,7 @@ void Organ::removeDivisionalCoupler(DivisionalCoupler *divCplr) {
 					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 				}
 			}
+			m_referenceIndex.removeReferrer(static_cast<Drawstop*>(&(*it)));
 			it = m_DivisionalCouplers.erase(it);
 		} else {
 			++it;
@@ -1477,6 +1513,7 @@ unsigned Organ::getIndexOfOrganGeneral(General *general) {
 
 void Organ::addGeneral(General general, bool isParsing) {
 	m_Generals.push_back(general);
+	m_referenceIndex.addReferrer(REFERRER_GENERAL, &m_Generals.back());
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1491,6 +1528,7 @@ void Organ::removeGeneralAt(unsigned index) {
 			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 		}
 	}
+	m_referenceIndex.removeReferrer(&(*it));
 	m_Generals.erase(it);
 	updateOrganElements();
 }
@@ -1505,6 +1543,7 @@ void Organ::removeGeneral(General *general) {
 					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 				}
 			}
+			m_referenceIndex.removeReferrer(&(*it));
 			it = m_Generals.erase(it);
 		} else {
 			++it;
@@ -1540,6 +1579,7 @@ unsigned Organ::getIndexOfReversiblePiston(ReversiblePiston *piston) {
 
 void Organ::addReversiblePiston(ReversiblePiston piston, bool isParsing) {
 	m_ReversiblePistons.push_back(piston);
+	m_referenceIndex.addReferrer(REFERRER_REVERSIBLE_PISTON, &m_ReversiblePistons.back());
 	if (!isParsing)
 		updateOrganElements();
 }
@@ -1554,6 +1594,7 @@ void Organ::removeReversiblePistonAt(unsigned index) {
 			::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 		}
 	}
+	m_referenceIndex.removeReferrer(&(*it));
 	m_ReversiblePistons.erase(it);
 	updateOrganElements();
 }
@@ -1568,6 +1609,7 @@ void Organ::removeReversiblePiston(ReversiblePiston *piston) {
 					::wxGetApp().m_frame->RebuildPanelGuiElementsInTree(i);
 				}
 			}
+			m_referenceIndex.removeReferrer(&(*it));
 			it = m_ReversiblePistons.erase(it);
 		} else {
 			++it;
@@ -1766,6 +1808,7 @@ void Organ::populateSetterElements() {
 }
 
 void Organ::updateOrganElements() {
+	TraceScope trace("Organ::updateOrganElements");
 	if (!m_organElements.IsEmpty())
 		m_organElements.Empty();
 
@@ -1912,167 +1955,122 @@ void Organ::organElementHasChanged(bool isParsing) {
 	}
 }
 
-void Organ::updateRelativePipePaths() {
+void Organ::updateRelativePipePaths(bool checkExistence) {
+	TraceScope trace("Organ::updateRelativePipePaths");
+	std::vector<Rank*> ranks;
 	for (Stop& s : m_Stops) {
-		s.getInternalRank()->updatePipeRelativePaths();
+		ranks.push_back(s.getInternalRank());
 	}
 	for (Rank& r : m_Ranks) {
-		r.updatePipeRelativePaths();
+		ranks.push_back(&r);
+	}
+	PathRebaser rebaser(getOdfRoot());
+	if (!checkExistence) {
+		for (Rank *r : ranks)
+			r->updatePipeRelativePaths(rebaser);
+		return;
 	}
+
+	// list all sample directories at once before the paths are rebased so
+	// that missing files can keep their full paths
+	for (Rank *r : ranks) {
+		for (Pipe &p : r->m_pipes) {
+			for (Attack &a : p.m_attacks)
+				rebaser.addFile(a.fullPath);
+			for (Release &rel : p.m_releases)
+				rebaser.addFile(rel.fullPath);
+		}
+	}
+	FileExistenceCache existence;
+	existence.prefetchDirectories(rebaser.getDirectories());
+	for (Rank *r : ranks)
+		r->updatePipeRelativePaths(rebaser, &existence);
 }
 
 bool Organ::isModified() {
 	return m_isModified;
 }
 
+long Organ::getModificationCount() {
+	return m_modificationCount;
+}
+
 void Organ::setModified(bool modified) {
 	m_isModified = modified;
+	if (modified)
+		m_modificationCount = ++s_lastModificationCount;
 	::wxGetApp().m_frame->UpdateFrameTitle();
 }
 
-void Organ::doInheritLegacyXfades() {
+void Organ::doInheritLegacyXfades(UndoStep *undoStep) {
 	for (Rank& r : m_Ranks) {
-		for (Pipe& p : r.m_pipes) {
-			if (!p.m_attacks.front().fileName.StartsWith(wxT("REF:"))) {
-				int loopXfadeValue = p.m_attacks.front().loopCrossfadeLength;
-				int releaseXfadeValue = p.m_attacks.front().releaseCrossfadeLength;
-
-				// any additional attacks should inherit x-fade values if they are not set already
-				if (p.m_attacks.size() > 1) {
-					bool isFirst = true;
-					for (Attack& a : p.m_attacks) {
-						if (!isFirst) {
-							if (a.loopCrossfadeLength == 0)
-								a.loopCrossfadeLength = loopXfadeValue;
-							if (a.releaseCrossfadeLength == 0)
-								a.releaseCrossfadeLength = releaseXfadeValue;
-						}
-						isFirst = false;
-					}
-				}
-
-				// any separate releases should inherit release x-fade value if it's not set already
-				if (p.m_releases.size()) {
-					for (Release& r : p.m_releases) {
-						if (r.releaseCrossfadeLength == 0)
-							r.releaseCrossfadeLength = releaseXfadeValue;
-					}
-				}
-			}
-		}
+		inheritLegacyXfades(&r, undoStep);
 	}
 	for (Stop& s : m_Stops) {
-		if (s.isUsingInternalRank()) {
-			for (Pipe& p : s.getInternalRank()->m_pipes) {
-				if (!p.m_attacks.front().fileName.StartsWith(wxT("REF:"))) {
-					int loopXfadeValue = p.m_attacks.front().loopCrossfadeLength;
-					int releaseXfadeValue = p.m_attacks.front().releaseCrossfadeLength;
-
-					// any additional attacks should inherit x-fade values if they are not set already
-					if (p.m_attacks.size() > 1) {
-						bool isFirst = true;
-						for (Attack& a : p.m_attacks) {
-							if (!isFirst) {
-								if (a.loopCrossfadeLength == 0)
-									a.loopCrossfadeLength = loopXfadeValue;
-								if (a.releaseCrossfadeLength == 0)
-									a.releaseCrossfadeLength = releaseXfadeValue;
-							}
-							isFirst = false;
-						}
-					}
-
-					// any separate releases should inherit release x-fade value if it's not set already
-					if (p.m_releases.size()) {
-						for (Release& r : p.m_releases) {
-							if (r.releaseCrossfadeLength == 0)
-								r.releaseCrossfadeLength = releaseXfadeValue;
-						}
-					}
-				}
-			}
-		}
+		if (s.isUsingInternalRank())
+			inheritLegacyXfades(s.getInternalRank(), undoStep);
 	}
 }
 
 bool Organ::isElementReferenced(GoSwitch *sw) {
-	bool isReferenced = false;
-
-	for (Stop &st : m_Stops) {
-		if (st.hasSwitchReference(sw)) {
-			isReferenced = true;
-			break;
-		}
-	}
-
-	if (!isReferenced) {
-		for (GoSwitch &gs : m_Switches) {
-			if (!gs.getFunction().IsSameAs(wxT("Input"))) {
-				if (gs.hasSwitchReference(sw)) {
-					isReferenced = true;
-					break;
-				}
-			}
-		}
-	}
-
-	if (!isReferenced) {
-		for (Tremulant &trem : m_Tremulants) {
-			if (!trem.getFunction().IsSameAs(wxT("Input"))) {
-				if (trem.hasSwitchReference(sw)) {
-					isReferenced = true;
-					break;
-				}
-			}
-		}
-	}
-
-	if (!isReferenced) {
-		for (Coupler &c : m_Couplers) {
-			if (c.hasSwitchReference(sw)) {
-				isReferenced = true;
+	for (const ELEMENT_REFERRER &referrer : getReferrersOf(sw)) {
+		switch (referrer.type) {
+			case REFERRER_MANUAL:
+				// a manual only makes the switch available there
 				break;
-			}
-		}
-	}
-
-	if (!isReferenced) {
-		for (Divisional &d : m_Divisionals) {
-			if (d.hasSwitch(sw)) {
-				isReferenced = true;
+			case REFERRER_SWITCH:
+			case REFERRER_TREMULANT:
+				if (!static_cast<Drawstop*>(referrer.element)->getFunction().IsSameAs(wxT("Input")))
+					return true;
 				break;
-			}
+			default:
+				return true;
 		}
 	}
+	return false;
+}
 
-	if (!isReferenced) {
-		for (DivisionalCoupler &divC : m_DivisionalCouplers) {
-			if (divC.hasSwitchReference(sw)) {
-				isReferenced = true;
-				break;
-			}
-		}
-	}
+const std::vector<ELEMENT_REFERRER>& Organ::getReferrersOf(GoSwitch *sw) {
+	updateReferenceIndex();
+	return m_referenceIndex.getReferrers(sw);
+}
 
-	if (!isReferenced) {
-		for (General &g : m_Generals) {
-			if (g.hasSwitch(sw)) {
-				isReferenced = true;
-				break;
-			}
-		}
-	}
+const std::vector<ELEMENT_REFERRER>& Organ::getReferrersOf(Tremulant *tremulant) {
+	updateReferenceIndex();
+	return m_referenceIndex.getReferrers(tremulant);
+}
 
-	if (!isReferenced) {
-		for (ReversiblePiston &r : m_ReversiblePistons) {
-			if (r.getSwitch() == sw) {
-				isReferenced = true;
-				break;
-			}
-		}
-	}
+ReferenceIndex* Organ::getReferenceIndex() {
+	return &m_referenceIndex;
+}
+
+SampleTreeClassifier* Organ::getSampleTree(wxString rootPath) {
+	return &m_sampleTrees[rootPath];
+}
 
-	return isReferenced;
+void Organ::updateReferenceIndex() {
+	if (m_referenceIndex.isValid())
+		return;
+	TraceScope trace("Organ::updateReferenceIndex");
+	m_referenceIndex.clear();
+	for (Stop &st : m_Stops)
+		m_referenceIndex.addReferrer(REFERRER_STOP, static_cast<Drawstop*>(&st));
+	for (GoSwitch &gs : m_Switches)
+		m_referenceIndex.addReferrer(REFERRER_SWITCH, static_cast<Drawstop*>(&gs));
+	for (Tremulant &trem : m_Tremulants)
+		m_referenceIndex.addReferrer(REFERRER_TREMULANT, static_cast<Drawstop*>(&trem));
+	for (Coupler &c : m_Couplers)
+		m_referenceIndex.addReferrer(REFERRER_COUPLER, static_cast<Drawstop*>(&c));
+	for (DivisionalCoupler &divC : m_DivisionalCouplers)
+		m_referenceIndex.addReferrer(REFERRER_DIVISIONAL_COUPLER, static_cast<Drawstop*>(&divC));
+	for (Divisional &d : m_Divisionals)
+		m_referenceIndex.addReferrer(REFERRER_DIVISIONAL, &d);
+	for (General &g : m_Generals)
+		m_referenceIndex.addReferrer(REFERRER_GENERAL, &g);
+	for (ReversiblePiston &r : m_ReversiblePistons)
+		m_referenceIndex.addReferrer(REFERRER_REVERSIBLE_PISTON, &r);
+	for (Manual &m : m_Manuals)
+		m_referenceIndex.addReferrer(REFERRER_MANUAL, &m);
 }
 
 void Organ::fixTrailingSpacesInStrings() {
@@ -2191,3 +2189,50 @@ void Organ::fixTrailingSpacesInStrings() {
 
 	updateOrganElements();
 }
+
+void Organ::inheritLegacyXfades(Rank *rank, UndoStep *undoStep) {
+	for (Pipe& p : rank->m_pipes) {
+		if (p.m_attacks.front().fileName.StartsWith(wxT("REF:")))
+			continue;
+
+		int loopXfadeValue = p.m_attacks.front().loopCrossfadeLength;
+		int releaseXfadeValue = p.m_attacks.front().releaseCrossfadeLength;
+
+		// only pipes that will actually change need to be remembered for undo
+		if (undoStep) {
+			bool willChange = false;
+			for (auto a = std::next(p.m_attacks.begin()); a != p.m_attacks.end(); ++a) {
+				if ((a->loopCrossfadeLength == 0 && loopXfadeValue != 0) || (a->releaseCrossfadeLength == 0 && releaseXfadeValue != 0))
+					willChange = true;
+			}
+			for (Release& r : p.m_releases) {
+				if (r.releaseCrossfadeLength == 0 && releaseXfadeValue != 0)
+					willChange = true;
+			}
+			if (willChange)
+				undoStep->recordPipe(rank, &p);
+		}
+
+		// any additional attacks should inherit x-fade values if they are not set already
+		if (p.m_attacks.size() > 1) {
+			bool isFirst = true;
+			for (Attack& a : p.m_attacks) {
+				if (!isFirst) {
+					if (a.loopCrossfadeLength == 0)
+						a.loopCrossfadeLength = loopXfadeValue;
+					if (a.releaseCrossfadeLength == 0)
+						a.releaseCrossfadeLength = releaseXfadeValue;
+				}
+				isFirst = false;
+			}
+		}
+
+		// any separate releases should inherit release x-fade value if it's not set already
+		if (p.m_releases.size()) {
+			for (Release& r : p.m_releases) {
+				if (r.releaseCrossfadeLength == 0)
+					r.releaseCrossfadeLength = releaseXfadeValue;
+			}
+		}
+	}
+}
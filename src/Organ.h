@@ -24,6 +24,8 @@
 #include <wx/wx.h>
 #include <wx/textfile.h>
 #include <list>
+#include <map>
+#include <atomic>
 #include "Enclosure.h"
 #include "Tremulant.h"
 #include "Windchestgroup.h"
@@ -37,6 +39,10 @@
 #include "General.h"
 #include "ReversiblePiston.h"
 #include "GoPanel.h"
+#include "ReferenceIndex.h"
+#include "SampleTreeClassifier.h"
+
+class UndoStep;
 
 class Organ {
 public:
@@ -97,6 +103,7 @@ public:
 	void addTremulant(Tremulant tremulant, bool isParsing = false);
 	void removeTremulantAt(unsigned index);
 	Windchestgroup* getOrganWindchestgroupAt(unsigned index);
+	std::list<Windchestgroup>* getOrganWindchestgroups();
 	unsigned getNumberOfWindchestgroups();
 	unsigned getIndexOfOrganWindchest(Windchestgroup *windchest);
 	void addWindchestgroup(Windchestgroup windchest);
@@ -109,12 +116,14 @@ public:
 	void removeSwitchAt(unsigned index);
 	void moveSwitch(int sourceIndex, int toBeforeIndex);
 	Rank* getOrganRankAt(unsigned index);
+	std::list<Rank>* getOrganRanks();
 	unsigned getNumberOfRanks();
 	unsigned getIndexOfOrganRank(Rank *rank);
 	void addRank(Rank rank);
 	void removeRankAt(unsigned index);
 	void moveRank(int sourceIndex, int toBeforeIndex);
 	Stop* getOrganStopAt(unsigned index);
+	std::list<Stop>* getOrganStops();
 	unsigned getNumberOfStops();
 	unsigned getIndexOfOrganStop(Stop *stop);
 	void addStop(Stop stop, bool isParsing = false);
@@ -181,16 +190,28 @@ public:
 	const wxArrayString& getOrganElements() const;
 	std::pair<wxString, int> getTypeAndIndexOfElement(int index);
 	void organElementHasChanged(bool isParsing = false);
-	void updateRelativePipePaths();
+	// rebases the displayed sample paths on the current odf root, the optional
+	// existence check lists each sample directory once instead of a stat per file
+	void updateRelativePipePaths(bool checkExistence = false);
 	bool isModified();
 	void setModified(bool modified);
-	void doInheritLegacyXfades();
+	// increases with every change of any organ, used to tell if saved data is outdated
+	long getModificationCount();
+	void doInheritLegacyXfades(UndoStep *undoStep = NULL);
 	bool isElementReferenced(GoSwitch *sw);
+	const std::vector<ELEMENT_REFERRER>& getReferrersOf(GoSwitch *sw);
+	const std::vector<ELEMENT_REFERRER>& getReferrersOf(Tremulant *tremulant);
+	ReferenceIndex* getReferenceIndex();
+	// one sample tree per root folder, kept so that ranks loaded from the same
+	// folders with the same patterns don't walk them again
+	SampleTreeClassifier* getSampleTree(wxString rootPath);
 	void fixTrailingSpacesInStrings();
 
 private:
 	wxString m_odfRoot;
 	bool m_isModified;
+	long m_modificationCount;
+	static std::atomic<long> s_lastModificationCount;
 	// Organ properties
 	wxString m_churchName;
 	wxString m_churchAddress;
@@ -229,9 +250,13 @@ private:
 	std::list<ReversiblePiston> m_ReversiblePistons;
 	std::list<GoPanel> m_Panels;
 	wxArrayString m_organElements;
+	ReferenceIndex m_referenceIndex;
+	std::map<wxString, SampleTreeClassifier> m_sampleTrees;
 
 	void populateSetterElements();
 	void updateOrganElements();
+	void updateReferenceIndex();
+	void inheritLegacyXfades(Rank *rank, UndoStep *undoStep);
 
 };
 
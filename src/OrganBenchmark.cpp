@@ -0,0 +1,258 @@
+/* 
+ * OrganBenchmark.cpp is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#include "OrganBenchmark.h"
+#include "GOODF.h"
+#include "OrganFileParser.h"
+#include "OrganSnapshot.h"
+#include "OdfWriter.h"
+#include "WAVfileParser.h"
+#include "SampleTreeClassifier.h"
+#include "PanelRenderer.h"
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/file.h>
+#include <algorithm>
+#include <thread>
+
+// goodf-bench is the windowless app running the benchmarks
+int GOODF::OnRun() {
+	OrganBenchmark bench;
+	return bench.run(argc, argv);
+}
+
+static const wxCmdLineEntryDesc BENCH_COMMAND_LINE[] = {
+	{ wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+	{ wxCMD_LINE_OPTION, "n", "iterations", "number of times each benchmark is run (default 5)", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, "o", "output", "file to write the json results to (default is standard output)", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_OPTION, "w", "workdir", "folder where the synthetic organ is created (default is in the temp folder)", wxCMD_LINE_VAL_STRING },
+	{ wxCMD_LINE_SWITCH, NULL, "keep", "don't remove the synthetic organ when done" },
+	{ wxCMD_LINE_OPTION, NULL, "manuals", "number of manuals", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "stops", "number of stops per manual", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "ranks", "number of ranks", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "pipes", "number of pipes per rank", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "attacks", "number of attacks per pipe", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "releases", "number of releases per pipe", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "panels", "number of panels", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "elements", "number of gui elements per panel", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "images", "number of images per panel", wxCMD_LINE_VAL_NUMBER },
+	{ wxCMD_LINE_OPTION, NULL, "frames", "number of frames in each attack sample", wxCMD_LINE_VAL_NUMBER },
+	wxCMD_LINE_DESC_END
+};
+
+static void readSizeOption(wxCmdLineParser &parser, const wxString &name, unsigned &value) {
+	long option;
+	if (parser.Found(name, &option) && option >= 0)
+		value = option;
+}
+
+OrganBenchmark::OrganBenchmark() {
+	m_size = SyntheticOrganGenerator::getDefaultSize();
+	m_iterations = 5;
+}
+
+OrganBenchmark::~OrganBenchmark() {
+
+}
+
+int OrganBenchmark::run(int argc, const wxCmdLineArgsArray &argv) {
+	wxCmdLineParser parser(BENCH_COMMAND_LINE, argc, argv);
+	parser.SetLogo(::wxGetApp().m_fullAppName + wxT(" benchmarks"));
+	if (parser.Parse() != 0)
+		return 2;
+
+	long iterations;
+	if (parser.Found(wxT("n"), &iterations) && iterations > 0)
+		m_iterations = iterations;
+	readSizeOption(parser, wxT("manuals"), m_size.manuals);
+	readSizeOption(parser, wxT("stops"), m_size.stopsPerManual);
+	readSizeOption(parser, wxT("ranks"), m_size.ranks);
+	readSizeOption(parser, wxT("pipes"), m_size.pipesPerRank);
+	readSizeOption(parser, wxT("attacks"), m_size.attacksPerPipe);
+	readSizeOption(parser, wxT("releases"), m_size.releasesPerPipe);
+	readSizeOption(parser, wxT("panels"), m_size.panels);
+	readSizeOption(parser, wxT("elements"), m_size.guiElementsPerPanel);
+	readSizeOption(parser, wxT("images"), m_size.imagesPerPanel);
+	readSizeOption(parser, wxT("frames"), m_size.sampleFrames);
+
+	wxString workDir;
+	if (!parser.Found(wxT("w"), &workDir))
+		workDir = wxFileName::GetTempDir() + wxFILE_SEP_PATH + wxString::Format(wxT("goodf-bench-%lu"), wxGetProcessId());
+
+	SyntheticOrganGenerator generator(workDir, m_size);
+	if (!generator.createFiles()) {
+		wxFprintf(stderr, wxT("The synthetic organ could not be created in %s\n"), workDir);
+		generator.removeFiles();
+		return 1;
+	}
+
+	Organ *organ = new Organ();
+	::wxGetApp().m_frame->m_organ = organ;
+	generator.populateOrgan(organ);
+	wxString odfPath = generator.getOdfPath();
+	ODF_WRITE_JOB *job = OdfWriter::createJob(organ, odfPath, wxID_ANY);
+	bool written = OdfWriter::writeJob(job);
+	OdfWriter::deleteJob(job);
+	if (!written) {
+		wxFprintf(stderr, wxT("%s could not be written\n"), odfPath);
+		::wxGetApp().m_frame->m_organ = NULL;
+		delete organ;
+		generator.removeFiles();
+		return 1;
+	}
+
+	measure(wxT("organ_write_lines"), [&]() {
+		wxTextFile lines(odfPath);
+		organ->writeOrgan(&lines);
+	});
+
+	measure(wxT("odf_write_file"), [&]() {
+		ODF_WRITE_JOB *writeJob = OdfWriter::createJob(organ, odfPath, wxID_ANY);
+		OdfWriter::writeJob(writeJob);
+		OdfWriter::deleteJob(writeJob);
+	});
+
+	measure(wxT("update_organ_elements"), [&]() {
+		organ->organElementHasChanged(true);
+	});
+
+	if (::wxGetApp().HasDisplay()) {
+		measure(wxT("panel_render"), [&]() {
+			for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+				PanelRenderer renderer(organ->getOrganPanelAt(i));
+				renderer.RenderToBitmap();
+			}
+		});
+	} else {
+		wxFprintf(stderr, wxT("panel_render is skipped, it needs a display\n"));
+	}
+
+	measure(wxT("rank_read_pipes"), [&]() {
+		// the sample tree is classified again each time just as when a user reads pipes
+		SampleTreeClassifier sampleTree(wxEmptyString, wxT("rel"), wxEmptyString);
+		Rank rank;
+		rank.setNumberOfLogicalPipes(m_size.pipesPerRank);
+		rank.createDummyPipes();
+		rank.setPipesRootPath(generator.getRankSamplePath(0));
+		rank.readPipes(sampleTree, false, false, false, false, 0, rank.getFirstMidiNoteNumber(), m_size.pipesPerRank);
+	});
+
+	const wxArrayString &sampleFiles = generator.getSampleFiles();
+	measure(wxT("wav_scan"), [&]() {
+		for (const wxString &file : sampleFiles) {
+			WAVfileParser wav(file);
+			wav.isWavOk();
+		}
+	});
+
+	// opened without and then with the pipe snapshot that saving writes
+	auto openOrgan = [&]() {
+		Organ *opened = new Organ();
+		::wxGetApp().m_frame->m_organ = opened;
+		{
+			OrganFileParser odfParser(odfPath, opened);
+		}
+		::wxGetApp().m_frame->m_organ = organ;
+		delete opened;
+	};
+	wxRemoveFile(OrganSnapshot::getSnapshotPath(odfPath));
+	measure(wxT("odf_parse"), openOrgan);
+	OrganSnapshot snapshot;
+	snapshot.write(odfPath, organ);
+	measure(wxT("odf_parse_snapshot"), openOrgan);
+
+	wxString json = createJson(organ, sampleFiles.GetCount());
+	::wxGetApp().m_frame->m_organ = NULL;
+	delete organ;
+	if (!parser.Found(wxT("keep")))
+		generator.removeFiles();
+
+	wxString outputPath;
+	if (parser.Found(wxT("o"), &outputPath)) {
+		wxFile output(outputPath, wxFile::write);
+		if (!output.IsOpened() || !output.Write(json)) {
+			wxFprintf(stderr, wxT("%s could not be written\n"), outputPath);
+			return 1;
+		}
+	} else {
+		wxPrintf(wxT("%s"), json);
+	}
+	return 0;
+}
+
+void OrganBenchmark::measure(const wxString &name, std::function<void()> task) {
+	BENCHMARK_RESULT result;
+	result.name = name;
+	for (unsigned i = 0; i < m_iterations; i++) {
+		wxLongLong start = wxGetUTCTimeUSec();
+		task();
+		result.microseconds.push_back(wxGetUTCTimeUSec() - start);
+	}
+	m_results.push_back(result);
+	wxFprintf(stderr, wxT("%s done\n"), name);
+}
+
+wxString OrganBenchmark::createJson(Organ *organ, unsigned nbrOfSampleFiles) {
+	unsigned nbrOfGuiElements = 0;
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++)
+		nbrOfGuiElements += organ->getOrganPanelAt(i)->getNumberOfGuiElements();
+
+	wxString json = wxT("{\n");
+	json += wxT("  \"program\": \"") + ::wxGetApp().m_fullAppName + wxT("\",\n");
+	json += wxT("  \"date\": \"") + wxDateTime::Now().FormatISOCombined() + wxT("\",\n");
+	json += wxString::Format(wxT("  \"hardware_threads\": %u,\n"), std::thread::hardware_concurrency());
+	json += wxString::Format(wxT("  \"iterations\": %u,\n"), m_iterations);
+	json += wxT("  \"size\": {\n");
+	json += wxString::Format(wxT("    \"manuals\": %u,\n"), m_size.manuals);
+	json += wxString::Format(wxT("    \"stops_per_manual\": %u,\n"), m_size.stopsPerManual);
+	json += wxString::Format(wxT("    \"ranks\": %u,\n"), m_size.ranks);
+	json += wxString::Format(wxT("    \"pipes_per_rank\": %u,\n"), m_size.pipesPerRank);
+	json += wxString::Format(wxT("    \"attacks_per_pipe\": %u,\n"), m_size.attacksPerPipe);
+	json += wxString::Format(wxT("    \"releases_per_pipe\": %u,\n"), m_size.releasesPerPipe);
+	json += wxString::Format(wxT("    \"panels\": %u,\n"), m_size.panels);
+	json += wxString::Format(wxT("    \"gui_elements_per_panel\": %u,\n"), m_size.guiElementsPerPanel);
+	json += wxString::Format(wxT("    \"images_per_panel\": %u,\n"), m_size.imagesPerPanel);
+	json += wxString::Format(wxT("    \"sample_frames\": %u\n"), m_size.sampleFrames);
+	json += wxT("  },\n");
+	json += wxT("  \"totals\": {\n");
+	json += wxString::Format(wxT("    \"stops\": %u,\n"), organ->getNumberOfStops());
+	json += wxString::Format(wxT("    \"ranks\": %u,\n"), organ->getNumberOfRanks());
+	json += wxString::Format(wxT("    \"sample_files\": %u,\n"), nbrOfSampleFiles);
+	json += wxString::Format(wxT("    \"gui_elements\": %u\n"), nbrOfGuiElements);
+	json += wxT("  },\n");
+	json += wxT("  \"benchmarks\": [\n");
+	for (unsigned i = 0; i < m_results.size(); i++) {
+		std::vector<wxLongLong> times = m_results[i].microseconds;
+		std::sort(times.begin(), times.end());
+		wxLongLong total = 0;
+		for (wxLongLong t : times)
+			total += t;
+		wxLongLong mean = total / (long) times.size();
+		json += wxT("    {\"name\": \"") + m_results[i].name + wxT("\"");
+		json += wxT(", \"min_us\": ") + times.front().ToString();
+		json += wxT(", \"median_us\": ") + times[times.size() / 2].ToString();
+		json += wxT(", \"mean_us\": ") + mean.ToString();
+		json += wxT(", \"max_us\": ") + times.back().ToString();
+		json += (i + 1 < m_results.size()) ? wxT("},\n") : wxT("}\n");
+	}
+	json += wxT("  ]\n");
+	json += wxT("}\n");
+	return json;
+}
@@ -0,0 +1,55 @@
+/* 
+ * OrganBenchmark.h is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#ifndef ORGANBENCHMARK_H
+#define ORGANBENCHMARK_H
+
+#include <wx/wx.h>
+#include <wx/cmdargs.h>
+#include <vector>
+#include <functional>
+#include "SyntheticOrganGenerator.h"
+
+struct BENCHMARK_RESULT {
+	wxString name;
+	std::vector<wxLongLong> microseconds; // one per iteration
+};
+
+// The benchmarks of goodf-bench. A synthetic organ is generated in a work
+// folder and the hot paths of opening, writing and reading pipes are timed
+// on it. The results are written as json so that they can be compared
+// between releases.
+class OrganBenchmark {
+public:
+	OrganBenchmark();
+	~OrganBenchmark();
+
+	int run(int argc, const wxCmdLineArgsArray &argv);
+
+private:
+	SYNTHETIC_ORGAN_SIZE m_size;
+	unsigned m_iterations;
+	std::vector<BENCHMARK_RESULT> m_results;
+
+	void measure(const wxString &name, std::function<void()> task);
+	wxString createJson(Organ *organ, unsigned nbrOfSampleFiles);
+};
+
+#endif
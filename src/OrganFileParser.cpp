@@ -21,8 +21,10 @@
 #include "OrganFileParser.h"
 #include <wx/filename.h>
 #include <wx/image.h>
+#include <wx/file.h>
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "TraceRecorder.h"
 #include "GUITremulant.h"
 #include "GUISwitch.h"
 #include "GUIReversiblePiston.h"
@@ -32,9 +34,11 @@
 #include "GUICoupler.h"
 #include "GUIStop.h"
 
-OrganFileParser::OrganFileParser(wxString filePath, Organ *organ) {
+OrganFileParser::OrganFileParser(wxString filePath, Organ *organ, bool onlyCatalogue) {
 	m_filePath = filePath;
 	m_organ = organ;
+	m_progressDlg = NULL;
+	m_onlyCatalogue = onlyCatalogue;
 	m_fileIsOk = false;
 	m_organIsReady = false;
 	m_isUsingOldPanelFormat = false;
@@ -42,10 +46,13 @@ OrganFileParser::OrganFileParser(wxString filePath, Organ *organ) {
 
 	readIniFile();
 	if (m_fileIsOk) {
-		m_progressDlg = new wxProgressDialog(
-			wxT("Parsing ") + m_filePath,
-			wxEmptyString
-		);
+		// a headless run has no top level window to show progress on
+		if (wxTheApp && wxTheApp->IsGUI()) {
+			m_progressDlg = new wxProgressDialog(
+				wxT("Parsing ") + m_filePath,
+				wxEmptyString
+			);
+		}
 		parseOrgan();
 	}
 }
@@ -58,19 +65,85 @@ OrganFileParser::~OrganFileParser() {
 }
 
 void OrganFileParser::parseOrgan() {
+	TraceScope trace("OrganFileParser::parseOrgan", m_filePath);
 	wxFileName odf = wxFileName(m_filePath);
 	m_organ->setOdfRoot(odf.GetPath());
-	parseOrganSection();
+	{
+		ActiveFileExistenceCache activeCache(&m_fileCache);
+		if (m_onlyCatalogue) {
+			parseOrganCatalogue();
+		} else {
+			if (m_snapshot.isLoaded())
+				OrganSnapshot::setActive(&m_snapshot);
+			prefetchReferencedDirectories();
+			parseOrganSection();
+			OrganSnapshot::setActive(NULL);
+		}
+	}
+	m_fileCache.reportMissingFiles(m_filePath);
 	if (m_errorMessage == wxEmptyString)
 		m_organIsReady = true;
 }
 
+void OrganFileParser::updateProgress(int value, wxString message) {
+	if (m_progressDlg)
+		m_progressDlg->Update(value, message);
+}
+
 bool OrganFileParser::isOrganReady() {
 	return m_organIsReady;
 }
 
+bool OrganFileParser::isOnlyCatalogue() {
+	return m_onlyCatalogue;
+}
+
+bool OrganFileParser::loadRank(unsigned index) {
+	if (!m_onlyCatalogue)
+		return true;
+	if (index >= m_rankGroups.GetCount() || index >= m_organ->getNumberOfRanks())
+		return false;
+	if (!m_rankIsLoaded[index]) {
+		{
+			ActiveFileExistenceCache activeCache(&m_fileCache);
+			m_organFile->SetPath(wxT("/") + m_rankGroups[index]);
+			TraceScope trace("parse rank", m_rankGroups[index]);
+			m_organ->getOrganRankAt(index)->read(m_organFile, m_organ);
+		}
+		m_fileCache.reportMissingFiles(m_rankGroups[index]);
+		m_rankIsLoaded[index] = true;
+	}
+	return true;
+}
+
+bool OrganFileParser::loadStop(unsigned index) {
+	if (!m_onlyCatalogue)
+		return true;
+	if (index >= m_stopGroups.GetCount() || index >= m_organ->getNumberOfStops())
+		return false;
+	if (!m_stopIsLoaded[index]) {
+		Stop *s = m_organ->getOrganStopAt(index);
+		if (s->isUsingInternalRank()) {
+			{
+				ActiveFileExistenceCache activeCache(&m_fileCache);
+				m_organFile->SetPath(wxT("/") + m_stopGroups[index]);
+				s->getInternalRank()->read(m_organFile, m_organ);
+				s->getInternalRank()->setFirstMidiNoteNumber(s->getOwningManual()->getFirstAccessibleKeyMIDINoteNumber());
+			}
+			m_fileCache.reportMissingFiles(m_stopGroups[index]);
+		}
+		m_stopIsLoaded[index] = true;
+	}
+	return true;
+}
+
 void OrganFileParser::readIniFile() {
-	m_organFile = new wxFileConfig(wxEmptyString, wxEmptyString, m_filePath, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+	TraceScope trace("OrganFileParser::readIniFile");
+	m_organFile = NULL;
+	if (!m_onlyCatalogue)
+		m_organFile = readConfigWithoutSnapshotPipes();
+	if (!m_organFile)
+		m_organFile = new wxFileConfig(wxEmptyString, wxEmptyString, m_filePath, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
 	if (m_organFile->HasGroup(wxT("Organ"))) {
 		m_fileIsOk = true;
 		if (m_organFile->HasGroup(wxT("Panel000"))) {
@@ -85,7 +158,69 @@ void OrganFileParser::readIniFile() {
 	}
 }
 
+wxFileConfig* OrganFileParser::readConfigWithoutSnapshotPipes() {
+	// With a valid snapshot all the pipe keys of the ranks and internal ranks it
+	// holds are skipped while the file is read, so the config never holds them.
+	wxFile odf(m_filePath);
+	if (!odf.IsOpened())
+		return NULL;
+	wxFileOffset odfLength = odf.Length();
+	if (odfLength <= 0)
+		return NULL;
+	wxMemoryBuffer content;
+	if (odf.Read(content.GetWriteBuf(odfLength), odfLength) != odfLength)
+		return NULL;
+	content.UngetWriteBuf(odfLength);
+	odf.Close();
+	if (!m_snapshot.load(m_filePath, content))
+		return NULL;
+
+	// same decoding as wxFileConfig uses when it reads the file itself
+	wxString text(static_cast<const char*>(content.GetData()), wxConvAuto(), content.GetDataLen());
+	if (text.IsEmpty() && content.GetDataLen()) {
+		m_snapshot.clear();
+		return NULL;
+	}
+
+	// no local or global file, the entries are only kept in memory
+	wxFileConfig *config = new wxFileConfig(wxEmptyString, wxEmptyString, wxEmptyString, wxEmptyString, wxCONFIG_USE_NO_ESCAPE_CHARACTERS);
+	config->DisableAutoSave();
+	bool inSnapshotSection = false;
+	size_t lineStart = 0;
+	size_t length = text.length();
+	while (lineStart < length) {
+		size_t lineEnd = text.find(wxT('\n'), lineStart);
+		if (lineEnd == wxString::npos)
+			lineEnd = length;
+		wxString line = text.Mid(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+
+		line.Trim(false);
+		line.Trim(true);
+		if (line.IsEmpty() || line[0] == wxT(';') || line[0] == wxT('#'))
+			continue;
+		if (line[0] == wxT('[')) {
+			wxString sectionName = line.Mid(1).BeforeFirst(wxT(']'));
+			config->SetPath(wxT("/") + sectionName);
+			inSnapshotSection = m_snapshot.hasSection(sectionName);
+			continue;
+		}
+		int separator = line.Find(wxT('='));
+		if (separator == wxNOT_FOUND)
+			continue;
+		wxString key = line.Mid(0, separator).Trim(true);
+		if (key.IsEmpty())
+			continue;
+		if (inSnapshotSection && key.length() > 4 && key.StartsWith(wxT("Pipe")) && wxIsdigit(key[4]))
+			continue;
+		config->Write(key, line.Mid(separator + 1).Trim(false));
+	}
+	config->SetPath(wxT("/"));
+	return config;
+}
+
 void OrganFileParser::trimKeyValues() {
+	TraceScope trace("OrganFileParser::trimKeyValues");
 	wxString group;
 	long group_index;
 
@@ -130,10 +265,52 @@ void OrganFileParser::trimKeyValues() {
 	}
 }
 
+void OrganFileParser::prefetchReferencedDirectories() {
+	TraceScope trace("OrganFileParser::prefetchReferencedDirectories");
+	// every folder that a sample or image file refers to is listed once, in parallel
+	updateProgress(0, wxT("Listing folders referenced by the .organ file"));
+	wxString odfRoot = m_organ->getOdfRoot();
+	wxArrayString directories;
+	wxString group;
+	long group_index;
+
+	m_organFile->SetPath("/");
+	bool has_group = m_organFile->GetFirstGroup(group, group_index);
+	while (has_group) {
+		m_organFile->SetPath(group);
+
+		wxString entry;
+		long entry_index;
+
+		bool has_entry = m_organFile->GetFirstEntry(entry, entry_index);
+		while (has_entry) {
+			wxString value = m_organFile->Read(entry, wxEmptyString);
+			wxString ext = value.AfterLast('.').Lower();
+			if (value.Contains(wxT(".")) && (ext.IsSameAs(wxT("wav")) || ext.IsSameAs(wxT("wv")) || ext.IsSameAs(wxT("bmp")) || ext.IsSameAs(wxT("png")) || ext.IsSameAs(wxT("gif")) || ext.IsSameAs(wxT("jpg")) || ext.IsSameAs(wxT("jpeg")) || ext.IsSameAs(wxT("html")) || ext.IsSameAs(wxT("htm")))) {
+				if (value.StartsWith(wxT("./")) || value.StartsWith(wxT(".\\")))
+					value.erase(0, 2);
+				wxFileName referenced = wxFileName(odfRoot + wxFILE_SEP_PATH + value, wxPATH_DOS);
+				directories.Add(referenced.GetPath());
+			}
+			has_entry = m_organFile->GetNextEntry(entry, entry_index);
+		}
+
+		m_organFile->SetPath("/");
+		has_group = m_organFile->GetNextGroup(group, group_index);
+	}
+	// the pipes restored from a snapshot are checked against the same listings
+	if (m_snapshot.isLoaded()) {
+		wxArrayString sampleDirectories = m_snapshot.getSampleDirectories(odfRoot);
+		WX_APPEND_ARRAY(directories, sampleDirectories);
+	}
+	m_fileCache.prefetchDirectories(directories);
+}
+
 void OrganFileParser::parseOrganSection() {
 	m_organFile->SetPath("/Organ");
+	TraceScope section("parse organ section");
 
-	m_progressDlg->Update(0, wxT("Parsing [Organ] section"));
+	updateProgress(0, wxT("Parsing [Organ] section"));
 	m_organ->setChurchName(m_organFile->Read("ChurchName", wxEmptyString));
 	m_organ->setChurchAddress(m_organFile->Read("ChurchAddress", wxEmptyString));
 	m_organ->setOrganBuilder(m_organFile->Read("OrganBuilder", wxEmptyString));
@@ -191,7 +368,7 @@ void OrganFileParser::parseOrganSection() {
 				m_organFile->SetPath("/");
 				wxString imgGroupName = wxT("Image") + GOODF_functions::number_format(i + 1);
 				if (m_organFile->HasGroup(imgGroupName)) {
-					m_progressDlg->Update(5, wxT("Parsing old style [") + imgGroupName + wxT("] section"));
+					updateProgress(5, wxT("Parsing old style [") + imgGroupName + wxT("] section"));
 					m_organFile->SetPath(wxT("/") + imgGroupName);
 					GoImage img;
 					img.setOwningPanelWidth(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
@@ -214,7 +391,7 @@ void OrganFileParser::parseOrganSection() {
 			for (int i = 0; i < nbrLabels; i++) {
 				m_organFile->SetPath("/");
 				wxString labelGroupName = wxT("Label") + GOODF_functions::number_format(i + 1);
-				m_progressDlg->Update(10, wxT("Parsing old style [") + labelGroupName + wxT("] section"));
+				updateProgress(10, wxT("Parsing old style [") + labelGroupName + wxT("] section"));
 				if (m_organFile->HasGroup(labelGroupName)) {
 					m_organFile->SetPath(wxT("/") + labelGroupName);
 					createGUILabel(m_organ->getOrganPanelAt(0));
@@ -231,17 +408,18 @@ void OrganFileParser::parseOrganSection() {
 		// so that will be done at a later point in the parsing.
 		m_organFile->SetPath(wxT("/Panel000"));
 		m_organ->getOrganPanelAt(0)->read(m_organFile, wxT("Panel000"), m_organ);
-		m_progressDlg->Update(12, wxT("Parsing [Panel000] base section"));
+		updateProgress(12, wxT("Parsing [Panel000] base section"));
 		m_organFile->SetPath("/Organ");
 	}
 
 	// parse enclosures
+	section.next("parse enclosures");
 	int nbrEnclosures = static_cast<int>(m_organFile->ReadLong("NumberOfEnclosures", 0));
 	if (nbrEnclosures > 0 && nbrEnclosures < 1000) {
 		for (int i = 0; i < nbrEnclosures; i++) {
 			m_organFile->SetPath("/");
 			wxString enclosureGroupName = wxT("Enclosure") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(15, wxT("Parsing [") + enclosureGroupName + wxT("] section"));
+			updateProgress(15, wxT("Parsing [") + enclosureGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(enclosureGroupName)) {
 				m_organFile->SetPath(wxT("/") + enclosureGroupName);
 				Enclosure enc;
@@ -260,12 +438,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse switches
+	section.next("parse switches");
 	int nbrSwitches = static_cast<int>(m_organFile->ReadLong("NumberOfSwitches", 0));
 	if (nbrSwitches > 0 && nbrSwitches < 1000) {
 		for (int i = 0; i < nbrSwitches; i++) {
 			m_organFile->SetPath("/");
 			wxString switchGroupName = wxT("Switch") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(20, wxT("Parsing [") + switchGroupName + wxT("] section"));
+			updateProgress(20, wxT("Parsing [") + switchGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(switchGroupName)) {
 				m_organFile->SetPath(wxT("/") + switchGroupName);
 				GoSwitch sw;
@@ -284,12 +463,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse tremulants
+	section.next("parse tremulants");
 	int nbrTrems = static_cast<int>(m_organFile->ReadLong("NumberOfTremulants", 0));
 	if (nbrTrems > 0 && nbrTrems < 1000) {
 		for (int i = 0; i < nbrTrems; i++) {
 			m_organFile->SetPath("/");
 			wxString tremGroupName = wxT("Tremulant") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(25, wxT("Parsing [") + tremGroupName + wxT("] section"));
+			updateProgress(25, wxT("Parsing [") + tremGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(tremGroupName)) {
 				m_organFile->SetPath(wxT("/") + tremGroupName);
 				Tremulant trem;
@@ -308,12 +488,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse windchests
+	section.next("parse windchests");
 	int nbrWindchests = static_cast<int>(m_organFile->ReadLong("NumberOfWindchestGroups", 0));
 	if (nbrWindchests > 0 && nbrWindchests < 1000) {
 		for (int i = 0; i < nbrWindchests; i++) {
 			m_organFile->SetPath("/");
 			wxString windchestGroupName = wxT("WindchestGroup") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(30, wxT("Parsing [") + windchestGroupName + wxT("] section"));
+			updateProgress(30, wxT("Parsing [") + windchestGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(windchestGroupName)) {
 				m_organFile->SetPath(wxT("/") + windchestGroupName);
 				Windchestgroup windchest;
@@ -332,12 +513,14 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse ranks
+	section.next("parse ranks");
 	int nbrRanks = static_cast<int>(m_organFile->ReadLong("NumberOfRanks", 0));
 	if (nbrRanks > 0 && nbrRanks < 1000) {
 		for (int i = 0; i < nbrRanks; i++) {
 			m_organFile->SetPath("/");
 			wxString rankGroupName = wxT("Rank") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(35, wxT("Parsing [") + rankGroupName + wxT("] section"));
+			updateProgress(35, wxT("Parsing [") + rankGroupName + wxT("] section"));
+			TraceScope rankTrace("parse rank", rankGroupName);
 			if (m_organFile->HasGroup(rankGroupName)) {
 				m_organFile->SetPath(wxT("/") + rankGroupName);
 				Rank r;
@@ -364,6 +547,7 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse manuals which contain the stops, couplers and divisionals
+	section.next("parse manuals");
 	// also they can have tremulant and switch references, but the couplers
 	// needs to be parsed after all manuals have been added to the organ
 	// and then the divisionals need to be added after the couplers
@@ -378,7 +562,8 @@ void OrganFileParser::parseOrganSection() {
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
 			int dlgValue = 40 + (24 / nbrManuals) * i;
-			m_progressDlg->Update(dlgValue, wxT("Parsing [") + manGroupName + wxT("] section"));
+			updateProgress(dlgValue, wxT("Parsing [") + manGroupName + wxT("] section"));
+			TraceScope manualTrace("parse manual", manGroupName);
 			if (m_organFile->HasGroup(manGroupName)) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual m;
@@ -404,7 +589,7 @@ void OrganFileParser::parseOrganSection() {
 			if (!m_organ->doesHavePedals())
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
-			m_progressDlg->Update(65, wxT("Parsing couplers for [") + manGroupName + wxT("]"));
+			updateProgress(65, wxT("Parsing couplers for [") + manGroupName + wxT("]"));
 			if (m_organFile->HasGroup(manGroupName) && i < (int) m_organ->getNumberOfManuals()) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual *man = m_organ->getOrganManualAt(i);
@@ -418,7 +603,7 @@ void OrganFileParser::parseOrganSection() {
 			if (!m_organ->doesHavePedals())
 				manIdxNbr += 1;
 			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
-			m_progressDlg->Update(66, wxT("Parsing divisionals for [") + manGroupName + wxT("]"));
+			updateProgress(66, wxT("Parsing divisionals for [") + manGroupName + wxT("]"));
 			if (m_organFile->HasGroup(manGroupName) && i < (int) m_organ->getNumberOfManuals()) {
 				m_organFile->SetPath(wxT("/") + manGroupName);
 				Manual *man = m_organ->getOrganManualAt(i);
@@ -429,12 +614,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse reversible pistons
+	section.next("parse reversible pistons");
 	int nbrPistons = static_cast<int>(m_organFile->ReadLong("NumberOfReversiblePistons", 0));
 	if (nbrPistons > 0 && nbrPistons < 33) {
 		for (int i = 0; i < nbrPistons; i++) {
 			m_organFile->SetPath("/");
 			wxString pistonGroupName = wxT("ReversiblePiston") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(68, wxT("Parsing [") + pistonGroupName + wxT("] section"));
+			updateProgress(68, wxT("Parsing [") + pistonGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(pistonGroupName)) {
 				m_organFile->SetPath(wxT("/") + pistonGroupName);
 				ReversiblePiston p;
@@ -453,12 +639,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse divisional couplers
+	section.next("parse divisional couplers");
 	int nbrDivCplrs = static_cast<int>(m_organFile->ReadLong("NumberOfDivisionalCouplers", 0));
 	if (nbrDivCplrs > 0 && nbrDivCplrs < 9) {
 		for (int i = 0; i < nbrDivCplrs; i++) {
 			m_organFile->SetPath("/");
 			wxString divCplrGroupName = wxT("DivisionalCoupler") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(70, wxT("Parsing [") + divCplrGroupName + wxT("] section"));
+			updateProgress(70, wxT("Parsing [") + divCplrGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(divCplrGroupName)) {
 				m_organFile->SetPath(wxT("/") + divCplrGroupName);
 				DivisionalCoupler divCplr;
@@ -477,12 +664,13 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse generals
+	section.next("parse generals");
 	int nbrGenerals = static_cast<int>(m_organFile->ReadLong("NumberOfGenerals", 0));
 	if (nbrGenerals > 0 && nbrGenerals < 100) {
 		for (int i = 0; i < nbrGenerals; i++) {
 			m_organFile->SetPath("/");
 			wxString generalGroupName = wxT("General") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(75, wxT("Parsing [") + generalGroupName + wxT("] section"));
+			updateProgress(75, wxT("Parsing [") + generalGroupName + wxT("] section"));
 			if (m_organFile->HasGroup(generalGroupName)) {
 				m_organFile->SetPath(wxT("/") + generalGroupName);
 				General g;
@@ -501,6 +689,7 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse setter elements from old style (if present)
+	section.next("parse setter elements");
 	// they will all be converted into the new GUI Element style depending on their type
 	if (m_isUsingOldPanelFormat) {
 		int nbrSetters = static_cast<int>(m_organFile->ReadLong("NumberOfSetterElements", 0));
@@ -508,7 +697,7 @@ void OrganFileParser::parseOrganSection() {
 			for (int i = 0; i < nbrSetters; i++) {
 				m_organFile->SetPath("/");
 				wxString setterGroupName = wxT("SetterElement") + GOODF_functions::number_format(i + 1);
-				m_progressDlg->Update(80, wxT("Parsing old style [") + setterGroupName + wxT("] section"));
+				updateProgress(80, wxT("Parsing old style [") + setterGroupName + wxT("] section"));
 				if (m_organFile->HasGroup(setterGroupName)) {
 					m_organFile->SetPath(wxT("/") + setterGroupName);
 					wxString elementType = m_organFile->Read("Type", wxEmptyString);
@@ -525,13 +714,14 @@ void OrganFileParser::parseOrganSection() {
 	}
 
 	// parse panels that has images and gui elements but can also exist in old style version
+	section.next("parse panels");
 	int nbrPanels = static_cast<int>(m_organFile->ReadLong("NumberOfPanels", 0));
 	if (!m_isUsingOldPanelFormat) {
 		// For the new format there exist a [Panel000] as main panel that can have GUI elements that must be read.
 		// That panel is already created with the organ and it won't be included in the count of number of panels either.
 		// The check if that section exist in the .organ file has already been done.
 		m_organFile->SetPath(wxT("/Panel000"));
-		m_progressDlg->Update(85, wxT("Parsing [Panel000] GUI elements"));
+		updateProgress(85, wxT("Parsing [Panel000] GUI elements"));
 		parsePanelElements(m_organ->getOrganPanelAt(0), wxT("Panel000"));
 		m_organFile->SetPath("/Organ");
 	}
@@ -539,7 +729,8 @@ void OrganFileParser::parseOrganSection() {
 		for (int i = 0; i < nbrPanels; i++) {
 			m_organFile->SetPath("/");
 			wxString panelGroupName = wxT("Panel") + GOODF_functions::number_format(i + 1);
-			m_progressDlg->Update(90, wxT("Parsing [") + panelGroupName + wxT("] section"));
+			updateProgress(90, wxT("Parsing [") + panelGroupName + wxT("] section"));
+			TraceScope panelTrace("parse panel", panelGroupName);
 			if (m_organFile->HasGroup(panelGroupName)) {
 				m_organFile->SetPath(wxT("/") + panelGroupName);
 				GoPanel p;
@@ -553,7 +744,113 @@ void OrganFileParser::parseOrganSection() {
 		}
 		m_organFile->SetPath("/Organ");
 	}
-	m_progressDlg->Update(100, wxT("Whole .organ file has been parsed!"));
+	updateProgress(100, wxT("Whole .organ file has been parsed!"));
+}
+
+void OrganFileParser::parseOrganCatalogue() {
+	// Only what the import dialog needs is read here: the manuals with their stops
+	// and the ranks with names and pipe counts. Switches and windchests are cheap
+	// and needed to resolve references. No panels, images or sample files are touched.
+	m_organFile->SetPath("/Organ");
+	updateProgress(0, wxT("Reading catalogue of [Organ] section"));
+	m_organ->setChurchName(m_organFile->Read("ChurchName", wxEmptyString));
+	wxString cfgBoolValue = m_organFile->Read("HasPedals", wxEmptyString);
+	m_organ->setHasPedals(GOODF_functions::parseBoolean(cfgBoolValue, false), true);
+
+	int nbrSwitches = static_cast<int>(m_organFile->ReadLong("NumberOfSwitches", 0));
+	if (nbrSwitches > 0 && nbrSwitches < 1000) {
+		for (int i = 0; i < nbrSwitches; i++) {
+			m_organFile->SetPath("/");
+			wxString switchGroupName = wxT("Switch") + GOODF_functions::number_format(i + 1);
+			if (m_organFile->HasGroup(switchGroupName)) {
+				m_organFile->SetPath(wxT("/") + switchGroupName);
+				GoSwitch sw;
+				sw.read(m_organFile, m_isUsingOldPanelFormat, m_organ);
+				m_organ->addSwitch(sw, true);
+			}
+		}
+		m_organFile->SetPath("/Organ");
+	}
+
+	int nbrWindchests = static_cast<int>(m_organFile->ReadLong("NumberOfWindchestGroups", 0));
+	if (nbrWindchests > 0 && nbrWindchests < 1000) {
+		for (int i = 0; i < nbrWindchests; i++) {
+			m_organFile->SetPath("/");
+			wxString windchestGroupName = wxT("WindchestGroup") + GOODF_functions::number_format(i + 1);
+			if (m_organFile->HasGroup(windchestGroupName)) {
+				m_organFile->SetPath(wxT("/") + windchestGroupName);
+				Windchestgroup windchest;
+				windchest.read(m_organFile, m_organ);
+				m_organ->addWindchestgroup(windchest);
+			}
+		}
+		m_organFile->SetPath("/Organ");
+	}
+
+	int nbrRanks = static_cast<int>(m_organFile->ReadLong("NumberOfRanks", 0));
+	if (nbrRanks > 0 && nbrRanks < 1000) {
+		for (int i = 0; i < nbrRanks; i++) {
+			m_organFile->SetPath("/");
+			wxString rankGroupName = wxT("Rank") + GOODF_functions::number_format(i + 1);
+			updateProgress(10 + (40 * i) / nbrRanks, wxT("Reading catalogue of [") + rankGroupName + wxT("]"));
+			if (m_organFile->HasGroup(rankGroupName)) {
+				m_organFile->SetPath(wxT("/") + rankGroupName);
+				Rank r;
+				r.readCatalogue(m_organFile);
+				m_organ->addRank(r);
+				m_rankGroups.Add(rankGroupName);
+			} else {
+				wxLogWarning("%s couldn't be found!", rankGroupName);
+				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			}
+		}
+		m_organFile->SetPath("/Organ");
+	}
+
+	int nbrManuals = static_cast<int>(m_organFile->ReadLong("NumberOfManuals", 0));
+	if ((nbrManuals > 0 && nbrManuals < 17) || (nbrManuals == 0 && m_organ->doesHavePedals())) {
+		if (m_organ->doesHavePedals())
+			nbrManuals += 1;
+		for (int i = 0; i < nbrManuals; i++) {
+			m_organFile->SetPath("/");
+			int manIdxNbr = i;
+			if (!m_organ->doesHavePedals())
+				manIdxNbr += 1;
+			wxString manGroupName = wxT("Manual") + GOODF_functions::number_format(manIdxNbr);
+			updateProgress(50 + (50 * i) / nbrManuals, wxT("Reading catalogue of [") + manGroupName + wxT("]"));
+			if (m_organFile->HasGroup(manGroupName)) {
+				m_organFile->SetPath(wxT("/") + manGroupName);
+				Manual m;
+				if (manIdxNbr == 0)
+					m.setIsPedal(true, true);
+				m_organ->addManual(m, true);
+				Manual *man = m_organ->getOrganManualAt(m_organ->getNumberOfManuals() - 1);
+				man->read(m_organFile, m_isUsingOldPanelFormat, manGroupName, m_organ, true);
+
+				// remember the stop sections in the same order as Manual::read added them
+				int nbrStops = static_cast<int>(m_organFile->ReadLong("NumberOfStops", 0));
+				if (nbrStops > 0 && nbrStops < 1000) {
+					for (int j = 0; j < nbrStops; j++) {
+						m_organFile->SetPath(wxT("/") + manGroupName);
+						wxString stopNbr = wxT("Stop") + GOODF_functions::number_format(j + 1);
+						int stopIdx = static_cast<int>(m_organFile->ReadLong(stopNbr, 0));
+						wxString stopGroup = wxT("Stop") + GOODF_functions::number_format(stopIdx);
+						m_organFile->SetPath("/");
+						if (m_organFile->HasGroup(stopGroup))
+							m_stopGroups.Add(stopGroup);
+					}
+				}
+			} else {
+				wxLogWarning("%s couldn't be found!", manGroupName);
+				::wxGetApp().m_frame->GetLogWindow()->Show(true);
+			}
+		}
+		m_organFile->SetPath("/Organ");
+	}
+
+	m_rankIsLoaded.assign(m_rankGroups.GetCount(), false);
+	m_stopIsLoaded.assign(m_stopGroups.GetCount(), false);
+	updateProgress(100, wxT("Catalogue of .organ file has been read!"));
 }
 
 void OrganFileParser::createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure) {
@@ -24,15 +24,23 @@
 #include <wx/wx.h>
 #include <wx/fileconf.h>
 #include <wx/progdlg.h>
+#include <vector>
 #include "Organ.h"
+#include "FileExistenceCache.h"
+#include "OrganSnapshot.h"
 
 class OrganFileParser {
 public:
-	OrganFileParser(wxString filePath, Organ *organ);
+	OrganFileParser(wxString filePath, Organ *organ, bool onlyCatalogue = false);
 	~OrganFileParser();
 
 	bool isOrganReady();
 
+	// in catalogue mode the ranks and internal ranks only hold shell pipes until loaded
+	bool isOnlyCatalogue();
+	bool loadRank(unsigned index);
+	bool loadStop(unsigned index);
+
 private:
 
 	Organ *m_organ;
@@ -43,6 +51,13 @@ private:
 	bool m_isUsingOldPanelFormat;
 	wxString m_errorMessage;
 	wxProgressDialog *m_progressDlg;
+	bool m_onlyCatalogue;
+	wxArrayString m_rankGroups;
+	wxArrayString m_stopGroups;
+	std::vector<bool> m_rankIsLoaded;
+	std::vector<bool> m_stopIsLoaded;
+	FileExistenceCache m_fileCache;
+	OrganSnapshot m_snapshot;
 
 	int m_enclosuresToParse;
 	int m_tremulantsToParse;
@@ -61,10 +76,14 @@ private:
 	int m_setterElementsToParse;
 
 	void readIniFile();
+	wxFileConfig* readConfigWithoutSnapshotPipes();
 	void trimKeyValues();
+	void prefetchReferencedDirectories();
 	void parseOrgan();
+	void updateProgress(int value, wxString message);
 
 	void parseOrganSection();
+	void parseOrganCatalogue();
 
 	void createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure);
 	void createGUITremulant(GoPanel *targetPanel, Tremulant *tremulant);
@@ -0,0 +1,438 @@
+/*
+ * OrganPackager.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganPackager.h"
+#include "ParallelTaskRunner.h"
+#include "ImageAssetOptimizer.h"
+#include "OdfWriter.h"
+#include "TraceRecorder.h"
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <set>
+#include <cstdint>
+#include <cstring>
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+
+// bytes read and written at a time when copying
+static const size_t COPY_BLOCK_SIZE = 1 << 20;
+
+// sha-256 as in FIPS 180-4, fed with the data in pieces
+class Sha256 {
+public:
+	Sha256() {
+		static const uint32_t INITIAL[8] = {
+			0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+		};
+		memcpy(m_state, INITIAL, sizeof(m_state));
+		m_length = 0;
+		m_bufferUsed = 0;
+	}
+
+	void update(const unsigned char *data, size_t length) {
+		m_length += length;
+		while (length > 0) {
+			size_t part = std::min(length, (size_t) 64 - m_bufferUsed);
+			memcpy(m_buffer + m_bufferUsed, data, part);
+			m_bufferUsed += part;
+			data += part;
+			length -= part;
+			if (m_bufferUsed == 64) {
+				processBlock(m_buffer);
+				m_bufferUsed = 0;
+			}
+		}
+	}
+
+	wxString finish() {
+		uint64_t bitLength = m_length * 8;
+		unsigned char padding[72] = { 0x80 };
+		size_t paddingLength = (m_bufferUsed < 56 ? 56 : 120) - m_bufferUsed;
+		for (int i = 0; i < 8; i++)
+			padding[paddingLength + i] = (unsigned char) (bitLength >> (56 - 8 * i));
+		update(padding, paddingLength + 8);
+		wxString hex;
+		for (int i = 0; i < 8; i++)
+			hex += wxString::Format(wxT("%08x"), m_state[i]);
+		return hex;
+	}
+
+private:
+	uint32_t m_state[8];
+	uint64_t m_length;
+	unsigned char m_buffer[64];
+	size_t m_bufferUsed;
+
+	static uint32_t rotateRight(uint32_t value, unsigned bits) {
+		return (value >> bits) | (value << (32 - bits));
+	}
+
+	void processBlock(const unsigned char *block) {
+		static const uint32_t K[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+		uint32_t w[64];
+		for (int i = 0; i < 16; i++)
+			w[i] = ((uint32_t) block[4 * i] << 24) | ((uint32_t) block[4 * i + 1] << 16) | ((uint32_t) block[4 * i + 2] << 8) | block[4 * i + 3];
+		for (int i = 16; i < 64; i++) {
+			uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+		uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+		uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+		for (int i = 0; i < 64; i++) {
+			uint32_t S1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+			uint32_t ch = (e & f) ^ (~e & g);
+			uint32_t temp1 = h + S1 + ch + K[i] + w[i];
+			uint32_t S0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+			uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t temp2 = S0 + maj;
+			h = g;
+			g = f;
+			f = e;
+			e = d + temp1;
+			d = c;
+			c = b;
+			b = a;
+			a = temp1 + temp2;
+		}
+		m_state[0] += a;
+		m_state[1] += b;
+		m_state[2] += c;
+		m_state[3] += d;
+		m_state[4] += e;
+		m_state[5] += f;
+		m_state[6] += g;
+		m_state[7] += h;
+	}
+};
+
+static bool isSamplePath(const wxString &path) {
+	return path != wxEmptyString && !path.IsSameAs(wxT("DUMMY"), false) && !path.StartsWith(wxT("REF"));
+}
+
+OrganPackager::OrganPackager(Organ *organ, unsigned nbrOfThreads, unsigned maxConcurrentIo) {
+	m_organ = organ;
+	m_nbrOfThreads = nbrOfThreads;
+	m_maxConcurrentIo = maxConcurrentIo;
+
+	auto collectRank = [this](Rank *rank) {
+		for (Pipe &pipe : rank->m_pipes) {
+			if (pipe.m_attacks.empty() || pipe.isFirstAttackRefPath())
+				continue;
+			for (Attack &atk : pipe.m_attacks) {
+				if (isSamplePath(atk.fullPath))
+					addReference(atk.fullPath, [&atk](const wxString &path) { atk.fullPath = path; });
+			}
+			for (Release &rel : pipe.m_releases) {
+				if (isSamplePath(rel.fullPath))
+					addReference(rel.fullPath, [&rel](const wxString &path) { rel.fullPath = path; });
+			}
+		}
+	};
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++)
+		collectRank(m_organ->getOrganRankAt(i));
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank())
+			collectRank(stop->getInternalRank());
+	}
+	ImageAssetOptimizer::collectImageReferences(m_organ, [this](const wxString &fullPath, const wxString &WXUNUSED(description), std::function<void(const wxString&)> setPath, GUIManual *WXUNUSED(manual)) {
+		addReference(fullPath, setPath);
+	});
+	Organ *theOrgan = m_organ;
+	addReference(m_organ->getInfoFilename(), [theOrgan](const wxString &path) { theOrgan->setInfoFilename(path); });
+
+	for (PACKAGE_FILE &file : m_files) {
+		file.exists = wxFileName::FileExists(file.sourcePath);
+		file.size = file.exists ? wxFileName::GetSize(file.sourcePath) : wxULongLong(0);
+	}
+	assignRelativePaths();
+}
+
+OrganPackager::~OrganPackager() {
+
+}
+
+unsigned OrganPackager::getNumberOfFiles() {
+	return m_files.size();
+}
+
+PACKAGE_FILE* OrganPackager::getFileAt(unsigned index) {
+	if (index < m_files.size())
+		return &m_files[index];
+	return NULL;
+}
+
+unsigned OrganPackager::getNumberOfMissingFiles() {
+	unsigned nbrMissing = 0;
+	for (PACKAGE_FILE &file : m_files) {
+		if (!file.exists)
+			nbrMissing++;
+	}
+	return nbrMissing;
+}
+
+unsigned OrganPackager::getNumberOfCopiedFiles() {
+	unsigned nbrCopied = 0;
+	for (PACKAGE_FILE &file : m_files) {
+		if (file.isCopied)
+			nbrCopied++;
+	}
+	return nbrCopied;
+}
+
+unsigned OrganPackager::getNumberOfLinkedFiles() {
+	unsigned nbrLinked = 0;
+	for (PACKAGE_FILE &file : m_files) {
+		if (file.isCopied && file.isLinked)
+			nbrLinked++;
+	}
+	return nbrLinked;
+}
+
+wxULongLong OrganPackager::getTotalBytes() {
+	wxULongLong total = 0;
+	for (PACKAGE_FILE &file : m_files) {
+		if (file.exists)
+			total += file.size;
+	}
+	return total;
+}
+
+bool OrganPackager::copyFiles(const wxString &targetRoot, bool allowHardLinks, wxProgressDialog *progress) {
+	TraceScope trace("OrganPackager::copyFiles", targetRoot);
+	// the folders are created here as many files share the same one
+	std::set<wxString> folders;
+	for (PACKAGE_FILE &file : m_files) {
+		if (file.exists)
+			folders.insert(wxFileName(targetRoot + wxFILE_SEP_PATH + file.relativePath).GetPath());
+	}
+	for (const wxString &folder : folders) {
+		if (!wxFileName::DirExists(folder))
+			wxFileName::Mkdir(folder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+	}
+
+	IoThrottle throttle(m_maxConcurrentIo);
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	return runner.run(m_files.size(), [this, &targetRoot, allowHardLinks, &throttle](unsigned i) {
+		PACKAGE_FILE &file = m_files[i];
+		if (!file.exists || file.isCopied)
+			return;
+		TraceScope trace("OrganPackager::copyFile", file.relativePath);
+		wxLogNull logNo;
+		wxString target = targetRoot + wxFILE_SEP_PATH + file.relativePath;
+		if (wxFileName(target).SameAs(wxFileName(file.sourcePath))) {
+			file.error = wxT("is already in the package folder");
+			return;
+		}
+		if (wxFileName::FileExists(target))
+			wxRemoveFile(target);
+
+		// a linked file is only read for the checksum, otherwise the checksum
+		// is calculated from the data while it's copied
+		std::vector<unsigned char> buffer(COPY_BLOCK_SIZE);
+		Sha256 sha;
+		wxFFile in(file.sourcePath, wxT("rb"));
+		if (!in.IsOpened()) {
+			file.error = wxT("couldn't be opened");
+			return;
+		}
+		file.isLinked = linkFile(file.sourcePath, target, allowHardLinks);
+		wxFFile out;
+		if (!file.isLinked && !out.Open(target, wxT("wb"))) {
+			file.error = wxT("couldn't be created in the package");
+			return;
+		}
+		bool ok = true;
+		while (ok) {
+			size_t nbrRead;
+			{
+				IoSlot slot(throttle);
+				nbrRead = in.Read(buffer.data(), buffer.size());
+				if (nbrRead > 0 && !file.isLinked && out.Write(buffer.data(), nbrRead) != nbrRead)
+					ok = false;
+			}
+			if (nbrRead == 0)
+				break;
+			sha.update(buffer.data(), nbrRead);
+		}
+		ok = !in.Error() && ok;
+		if (!file.isLinked)
+			ok = out.Close() && ok;
+		if (!ok) {
+			file.error = wxT("couldn't be copied");
+			wxRemoveFile(target);
+			return;
+		}
+		if (!file.isLinked) {
+			// the copy keeps the modification time of the original
+			wxDateTime accessTime, modificationTime;
+			if (wxFileName(file.sourcePath).GetTimes(&accessTime, &modificationTime, NULL))
+				wxFileName(target).SetTimes(&accessTime, &modificationTime, NULL);
+		}
+		file.checksum = sha.finish();
+		file.isCopied = true;
+	}, progress, wxT("Copying files..."));
+}
+
+bool OrganPackager::writeManifest(const wxString &targetRoot, const wxString &manifestName) {
+	wxTextFile manifest(targetRoot + wxFILE_SEP_PATH + manifestName);
+	for (PACKAGE_FILE &file : m_files) {
+		if (!file.isCopied)
+			continue;
+		wxString path = file.relativePath;
+		path.Replace(wxT("\\"), wxT("/"));
+		manifest.AddLine(file.checksum + wxT("  ") + path);
+	}
+	return manifest.Write(wxTextFileType_Unix);
+}
+
+bool OrganPackager::writeOrgan(const wxString &targetRoot, const wxString &odfName) {
+	TraceScope trace("OrganPackager::writeOrgan", odfName);
+	wxString odfPath = targetRoot + wxFILE_SEP_PATH + odfName + wxT(".organ");
+	wxString originalRoot = m_organ->getOdfRoot();
+
+	// the paths are relative to the odf root when written, so the organ is
+	// moved to the package while it's written and then moved back
+	rebaseReferences(targetRoot, true);
+	m_organ->setOdfRoot(targetRoot);
+	m_organ->updateRelativePipePaths();
+	m_organ->fixTrailingSpacesInStrings();
+	ODF_WRITE_JOB *job = OdfWriter::createJob(m_organ, odfPath, wxID_ANY);
+	rebaseReferences(targetRoot, false);
+	m_organ->setOdfRoot(originalRoot);
+	m_organ->updateRelativePipePaths();
+
+	bool success = OdfWriter::writeJob(job);
+	OdfWriter::deleteJob(job);
+	return success;
+}
+
+void OrganPackager::addReference(const wxString &fullPath, std::function<void(const wxString&)> setPath) {
+	if (fullPath.IsEmpty())
+		return;
+
+	unsigned fileIndex;
+	std::map<wxString, unsigned>::iterator existing = m_fileIndexByPath.find(fullPath);
+	if (existing != m_fileIndexByPath.end()) {
+		fileIndex = existing->second;
+	} else {
+		fileIndex = m_files.size();
+		m_fileIndexByPath[fullPath] = fileIndex;
+		PACKAGE_FILE file;
+		file.sourcePath = fullPath;
+		file.exists = false;
+		file.isCopied = false;
+		file.isLinked = false;
+		file.size = 0;
+		m_files.push_back(file);
+	}
+	PACKAGE_REFERENCE reference;
+	reference.setPath = setPath;
+	reference.fileIndex = fileIndex;
+	m_files[fileIndex].references.push_back(m_references.size());
+	m_references.push_back(reference);
+}
+
+void OrganPackager::assignRelativePaths() {
+	wxString root = m_organ->getOdfRoot();
+	std::set<wxString> used;
+	std::vector<unsigned> external;
+	for (unsigned i = 0; i < m_files.size(); i++) {
+		PACKAGE_FILE &file = m_files[i];
+		if (!root.IsEmpty() && file.sourcePath.StartsWith(root + wxFILE_SEP_PATH)) {
+			wxFileName relative(file.sourcePath);
+			relative.MakeRelativeTo(root);
+			file.relativePath = relative.GetFullPath();
+			used.insert(file.relativePath);
+		} else {
+			external.push_back(i);
+		}
+	}
+
+	// files from outside the odf root get unique names in one folder
+	for (unsigned i : external) {
+		wxFileName source(m_files[i].sourcePath);
+		wxFileName relative(wxT("external") + wxString(wxFILE_SEP_PATH) + source.GetFullName());
+		wxString name = relative.GetName();
+		for (unsigned nbr = 2; used.count(relative.GetFullPath()); nbr++)
+			relative.SetName(name + wxString::Format(wxT("-%u"), nbr));
+		m_files[i].relativePath = relative.GetFullPath();
+		used.insert(m_files[i].relativePath);
+	}
+}
+
+void OrganPackager::rebaseReferences(const wxString &targetRoot, bool toPackage) {
+	// files that couldn't be copied keep pointing to the original
+	for (PACKAGE_FILE &file : m_files) {
+		if (!file.isCopied)
+			continue;
+		wxString path = toPackage ? targetRoot + wxFILE_SEP_PATH + file.relativePath : file.sourcePath;
+		for (unsigned referenceIdx : file.references)
+			m_references[referenceIdx].setPath(path);
+	}
+}
+
+bool OrganPackager::linkFile(const wxString &source, const wxString &target, bool allowHardLinks) {
+#ifdef __LINUX__
+	// a copy on write clone is as safe as a copy, it only works on some file systems
+	#ifdef FICLONE
+	int in = open(source.fn_str(), O_RDONLY);
+	if (in >= 0) {
+		int out = open(target.fn_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+		bool cloned = false;
+		if (out >= 0) {
+			cloned = ioctl(out, FICLONE, in) == 0;
+			close(out);
+			if (!cloned)
+				unlink(target.fn_str());
+		}
+		close(in);
+		if (cloned)
+			return true;
+	}
+	#endif
+#endif
+	if (!allowHardLinks)
+		return false;
+#ifdef __WXMSW__
+	return CreateHardLinkW(target.wc_str(), source.wc_str(), NULL) != 0;
+#else
+	return link(source.fn_str(), target.fn_str()) == 0;
+#endif
+}
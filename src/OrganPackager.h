@@ -0,0 +1,94 @@
+/*
+ * OrganPackager.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANPACKAGER_H
+#define ORGANPACKAGER_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <map>
+#include <functional>
+#include "Organ.h"
+
+struct PACKAGE_REFERENCE {
+	std::function<void(const wxString&)> setPath;
+	unsigned fileIndex;
+};
+
+struct PACKAGE_FILE {
+	wxString sourcePath;
+	wxString relativePath; // below the root of the package
+	std::vector<unsigned> references;
+	bool exists;
+	bool isCopied;
+	bool isLinked; // cloned or hard linked instead of copied
+	wxULongLong size;
+	wxString checksum; // sha-256 in hex
+	wxString error;
+};
+
+// Copies an organ and exactly the files it references (samples, images,
+// masks and the info file) into a new folder that becomes the odf root of the
+// copy. Files below the current odf root keep their relative location, other
+// files are put in an "external" folder. The files are copied in parallel
+// with a limited number of them read/written at the same time, and within one
+// file system they are cloned or hard linked if possible. A sha-256 manifest
+// of all files is written next to the odf.
+class OrganPackager {
+
+public:
+	static const unsigned DEFAULT_CONCURRENT_IO = 4;
+
+	OrganPackager(Organ *organ, unsigned nbrOfThreads = 0, unsigned maxConcurrentIo = DEFAULT_CONCURRENT_IO);
+	~OrganPackager();
+
+	unsigned getNumberOfFiles();
+	PACKAGE_FILE* getFileAt(unsigned index);
+	unsigned getNumberOfMissingFiles();
+	unsigned getNumberOfCopiedFiles();
+	unsigned getNumberOfLinkedFiles();
+	wxULongLong getTotalBytes();
+
+	// hard links share the data with the original so changing one changes
+	// both, clones (copy on write) are always tried first. Returns false if
+	// aborted from the progress dialog
+	bool copyFiles(const wxString &targetRoot, bool allowHardLinks, wxProgressDialog *progress = NULL);
+	// written in the format of sha256sum so that it can check the package
+	bool writeManifest(const wxString &targetRoot, const wxString &manifestName);
+	// writes the odf with all references pointing into the package, the
+	// organ itself is left with its original paths
+	bool writeOrgan(const wxString &targetRoot, const wxString &odfName);
+
+private:
+	Organ *m_organ;
+	unsigned m_nbrOfThreads;
+	unsigned m_maxConcurrentIo;
+	std::vector<PACKAGE_REFERENCE> m_references;
+	std::vector<PACKAGE_FILE> m_files;
+	std::map<wxString, unsigned> m_fileIndexByPath;
+
+	void addReference(const wxString &fullPath, std::function<void(const wxString&)> setPath);
+	void assignRelativePaths();
+	void rebaseReferences(const wxString &targetRoot, bool toPackage);
+	static bool linkFile(const wxString &source, const wxString &target, bool allowHardLinks);
+};
+
+#endif
@@ -0,0 +1,476 @@
+/*
+ * OrganSnapshot.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganSnapshot.h"
+#include "Organ.h"
+#include "GOODFFunctions.h"
+#include "FileExistenceCache.h"
+#include "PathRebaser.h"
+#include "OdfWriter.h"
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <vector>
+#include <string>
+#include <cstring>
+
+static const char SNAPSHOT_MAGIC[8] = {'G', 'O', 'O', 'D', 'F', 'S', 'N', 'P'};
+static const wxUint32 SNAPSHOT_VERSION = 1;
+
+thread_local OrganSnapshot *OrganSnapshot::m_activeSnapshot = NULL;
+
+OrganSnapshot::OrganSnapshot() {
+	clear();
+}
+
+OrganSnapshot::~OrganSnapshot() {
+	if (m_activeSnapshot == this)
+		m_activeSnapshot = NULL;
+}
+
+OrganSnapshot* OrganSnapshot::getActive() {
+	return m_activeSnapshot;
+}
+
+void OrganSnapshot::setActive(OrganSnapshot *snapshot) {
+	m_activeSnapshot = snapshot;
+}
+
+wxString OrganSnapshot::getSnapshotPath(const wxString &odfPath) {
+	wxFileName odf = wxFileName(odfPath);
+	return odf.GetPathWithSep() + odf.GetName() + wxT(".goodf-snapshot");
+}
+
+wxUint64 OrganSnapshot::computeHash(const void *data, size_t length) {
+	// 64 bit FNV-1a
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	wxUint64 hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool OrganSnapshot::write(const wxString &odfPath, Organ *organ) {
+	// only the copies of the pipes in the job are used, its lines aren't written
+	ODF_WRITE_JOB *job = OdfWriter::createJob(organ, odfPath, wxID_ANY);
+	bool written = write(odfPath, job);
+	OdfWriter::deleteJob(job);
+	return written;
+}
+
+bool OrganSnapshot::write(const wxString &odfPath, ODF_WRITE_JOB *job) {
+	wxFile odf(odfPath);
+	if (!odf.IsOpened())
+		return false;
+	wxFileOffset odfLength = odf.Length();
+	if (odfLength <= 0)
+		return false;
+	wxMemoryBuffer odfContent;
+	if (odf.Read(odfContent.GetWriteBuf(odfLength), odfLength) != odfLength)
+		return false;
+	odfContent.UngetWriteBuf(odfLength);
+	odf.Close();
+
+	std::vector<SNAPSHOT_SECTION> sections;
+	std::vector<SNAPSHOT_PIPE> pipes;
+	std::vector<SNAPSHOT_ATTACK> attacks;
+	std::vector<SNAPSHOT_RELEASE> releases;
+	std::vector<SNAPSHOT_LOOP> loops;
+	std::string strings;
+	std::map<wxString, wxUint32> stringOffsets;
+
+	auto addString = [&](const wxString &str) -> wxUint32 {
+		auto found = stringOffsets.find(str);
+		if (found != stringOffsets.end())
+			return found->second;
+		wxUint32 offset = strings.size();
+		strings.append(str.utf8_str().data());
+		strings.push_back('\0');
+		stringOffsets[str] = offset;
+		return offset;
+	};
+
+	// Only what a new parse of the written file would give is stored, so sample
+	// files that don't exist are left out just like Pipe::read would do. When
+	// called from the writer its sample folder listings are used.
+	FileExistenceCache ownCache;
+	PathRebaser ownRebaser(job->odfRoot);
+	FileExistenceCache *fileCache = FileExistenceCache::getActive();
+	PathRebaser *rebaser = PathRebaser::getActive();
+	if (!fileCache || !rebaser) {
+		OdfWriter::listSampleFolders(job, ownRebaser, ownCache);
+		fileCache = &ownCache;
+		rebaser = &ownRebaser;
+	}
+
+	auto isSpecialPath = [](const wxString &path) {
+		return path.StartsWith(wxT("REF")) || path.IsSameAs(wxT("DUMMY"), false);
+	};
+
+	auto addRank = [&](const wxString &sectionName, Rank *rank, const std::vector<int> &windchestRefs) {
+		SNAPSHOT_SECTION section;
+		section.name = addString(sectionName);
+		section.firstPipe = pipes.size();
+		section.nbrPipes = rank->m_pipes.size();
+		unsigned pipeIndex = 0;
+		for (Pipe &p : rank->m_pipes) {
+			SNAPSHOT_PIPE sp;
+			memset(&sp, 0, sizeof(sp));
+			sp.amplitudeLevel = p.amplitudeLevel;
+			sp.gain = p.gain;
+			sp.pitchTuning = p.pitchTuning;
+			sp.midiPitchFraction = p.midiPitchFraction;
+			sp.pitchCorrection = p.pitchCorrection;
+			sp.minVelocityVolume = p.minVelocityVolume;
+			sp.maxVelocityVolume = p.maxVelocityVolume;
+			sp.trackerDelay = p.trackerDelay;
+			sp.harmonicNumber = p.harmonicNumber;
+			sp.midiKeyNumber = p.midiKeyNumber;
+			if (pipeIndex < windchestRefs.size() && windchestRefs[pipeIndex] > -1)
+				sp.windchest = windchestRefs[pipeIndex];
+			pipeIndex++;
+			sp.isPercussive = p.isPercussive ? 1 : 0;
+			sp.hasIndependentRelease = p.hasIndependentRelease ? 1 : 0;
+			sp.acceptsRetuning = p.acceptsRetuning ? 1 : 0;
+			sp.firstAttack = attacks.size();
+			for (Attack &a : p.m_attacks) {
+				wxString fileName = a.fullPath;
+				if (!isSpecialPath(a.fullPath)) {
+					if (!fileCache->fileExists(a.fullPath))
+						continue;
+					fileName = rebaser->makeRelative(a.fullPath);
+				}
+				SNAPSHOT_ATTACK sa;
+				memset(&sa, 0, sizeof(sa));
+				sa.fileName = addString(fileName);
+				sa.attackVelocity = a.attackVelocity;
+				sa.maxTimeSinceLastRelease = a.maxTimeSinceLastRelease;
+				sa.isTremulant = a.isTremulant;
+				sa.maxKeyPressTime = a.maxKeyPressTime;
+				sa.attackStart = a.attackStart;
+				sa.loadRelease = a.loadRelease ? 1 : 0;
+				sa.firstLoop = loops.size();
+				if (p.isPercussive) {
+					sa.cuePoint = -1;
+					sa.releaseEnd = -1;
+				} else {
+					sa.cuePoint = a.cuePoint;
+					sa.releaseEnd = a.releaseEnd;
+					sa.loopCrossfadeLength = a.loopCrossfadeLength;
+					sa.releaseCrossfadeLength = a.releaseCrossfadeLength;
+					for (Loop &l : a.m_loops) {
+						SNAPSHOT_LOOP sl;
+						sl.start = l.start;
+						sl.end = l.end;
+						loops.push_back(sl);
+					}
+				}
+				sa.nbrLoops = loops.size() - sa.firstLoop;
+				attacks.push_back(sa);
+			}
+			sp.nbrAttacks = attacks.size() - sp.firstAttack;
+			sp.firstRelease = releases.size();
+			if (!p.isPercussive || p.hasIndependentRelease) {
+				for (Release &r : p.m_releases) {
+					if (!fileCache->fileExists(r.fullPath))
+						continue;
+					SNAPSHOT_RELEASE sr;
+					sr.fileName = addString(rebaser->makeRelative(r.fullPath));
+					sr.isTremulant = r.isTremulant;
+					sr.maxKeyPressTime = r.maxKeyPressTime;
+					sr.cuePoint = r.cuePoint;
+					sr.releaseEnd = r.releaseEnd;
+					sr.releaseCrossfadeLength = r.releaseCrossfadeLength;
+					releases.push_back(sr);
+				}
+			}
+			sp.nbrReleases = releases.size() - sp.firstRelease;
+			pipes.push_back(sp);
+		}
+		sections.push_back(section);
+	};
+
+	for (ODF_PIPE_BLOCK &block : job->pipeBlocks)
+		addRank(block.sectionName, block.rank, block.windchestRefs);
+
+	SNAPSHOT_HEADER header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.nbrSections = sections.size();
+	header.odfSize = odfContent.GetDataLen();
+	header.odfHash = computeHash(odfContent.GetData(), odfContent.GetDataLen());
+	header.nbrPipes = pipes.size();
+	header.nbrAttacks = attacks.size();
+	header.nbrReleases = releases.size();
+	header.nbrLoops = loops.size();
+	// keep the total size a multiple of four
+	while (strings.size() % 4)
+		strings.push_back('\0');
+	header.stringTableSize = strings.size();
+
+	// written to a temporary file first so that a failed write never leaves a broken snapshot
+	wxString snapshotPath = getSnapshotPath(odfPath);
+	wxString tempPath = snapshotPath + wxT(".tmp");
+	wxFile out;
+	if (!out.Create(tempPath, true))
+		return false;
+	bool writtenOk = out.Write(&header, sizeof(header)) == sizeof(header);
+	if (writtenOk && !sections.empty())
+		writtenOk = out.Write(sections.data(), sections.size() * sizeof(SNAPSHOT_SECTION)) == sections.size() * sizeof(SNAPSHOT_SECTION);
+	if (writtenOk && !pipes.empty())
+		writtenOk = out.Write(pipes.data(), pipes.size() * sizeof(SNAPSHOT_PIPE)) == pipes.size() * sizeof(SNAPSHOT_PIPE);
+	if (writtenOk && !attacks.empty())
+		writtenOk = out.Write(attacks.data(), attacks.size() * sizeof(SNAPSHOT_ATTACK)) == attacks.size() * sizeof(SNAPSHOT_ATTACK);
+	if (writtenOk && !releases.empty())
+		writtenOk = out.Write(releases.data(), releases.size() * sizeof(SNAPSHOT_RELEASE)) == releases.size() * sizeof(SNAPSHOT_RELEASE);
+	if (writtenOk && !loops.empty())
+		writtenOk = out.Write(loops.data(), loops.size() * sizeof(SNAPSHOT_LOOP)) == loops.size() * sizeof(SNAPSHOT_LOOP);
+	if (writtenOk && !strings.empty())
+		writtenOk = out.Write(strings.data(), strings.size()) == strings.size();
+	out.Close();
+	if (!writtenOk || !wxRenameFile(tempPath, snapshotPath, true)) {
+		wxRemoveFile(tempPath);
+		return false;
+	}
+	return true;
+}
+
+bool OrganSnapshot::load(const wxString &odfPath, const wxMemoryBuffer &odfContent) {
+	clear();
+	wxString snapshotPath = getSnapshotPath(odfPath);
+	if (!wxFileExists(snapshotPath))
+		return false;
+	wxFile file(snapshotPath);
+	if (!file.IsOpened())
+		return false;
+	wxFileOffset length = file.Length();
+	if (length < (wxFileOffset) sizeof(SNAPSHOT_HEADER))
+		return false;
+	if (file.Read(m_buffer.GetWriteBuf(length), length) != length) {
+		clear();
+		return false;
+	}
+	m_buffer.UngetWriteBuf(length);
+
+	const char *data = static_cast<const char*>(m_buffer.GetData());
+	const SNAPSHOT_HEADER *header = reinterpret_cast<const SNAPSHOT_HEADER*>(data);
+	if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->version != SNAPSHOT_VERSION) {
+		clear();
+		return false;
+	}
+	size_t expectedLength = sizeof(SNAPSHOT_HEADER) +
+		(size_t) header->nbrSections * sizeof(SNAPSHOT_SECTION) +
+		(size_t) header->nbrPipes * sizeof(SNAPSHOT_PIPE) +
+		(size_t) header->nbrAttacks * sizeof(SNAPSHOT_ATTACK) +
+		(size_t) header->nbrReleases * sizeof(SNAPSHOT_RELEASE) +
+		(size_t) header->nbrLoops * sizeof(SNAPSHOT_LOOP) +
+		(size_t) header->stringTableSize;
+	if (expectedLength != (size_t) length) {
+		clear();
+		return false;
+	}
+	// a stale snapshot is simply ignored and the .organ file parsed as usual
+	if (header->odfSize != (wxUint64) odfContent.GetDataLen() || header->odfHash != computeHash(odfContent.GetData(), odfContent.GetDataLen())) {
+		clear();
+		return false;
+	}
+
+	size_t offset = sizeof(SNAPSHOT_HEADER);
+	m_sectionTable = reinterpret_cast<const SNAPSHOT_SECTION*>(data + offset);
+	offset += header->nbrSections * sizeof(SNAPSHOT_SECTION);
+	m_pipeTable = reinterpret_cast<const SNAPSHOT_PIPE*>(data + offset);
+	offset += header->nbrPipes * sizeof(SNAPSHOT_PIPE);
+	m_attackTable = reinterpret_cast<const SNAPSHOT_ATTACK*>(data + offset);
+	offset += header->nbrAttacks * sizeof(SNAPSHOT_ATTACK);
+	m_releaseTable = reinterpret_cast<const SNAPSHOT_RELEASE*>(data + offset);
+	offset += header->nbrReleases * sizeof(SNAPSHOT_RELEASE);
+	m_loopTable = reinterpret_cast<const SNAPSHOT_LOOP*>(data + offset);
+	offset += header->nbrLoops * sizeof(SNAPSHOT_LOOP);
+	m_stringTable = data + offset;
+	m_header = header;
+
+	// make sure that all references stay inside the tables before anything is used
+	bool isConsistent = header->stringTableSize == 0 || m_stringTable[header->stringTableSize - 1] == '\0';
+	for (wxUint32 i = 0; i < header->nbrSections && isConsistent; i++) {
+		const SNAPSHOT_SECTION &s = m_sectionTable[i];
+		isConsistent = s.name < header->stringTableSize && s.firstPipe <= header->nbrPipes && s.nbrPipes <= header->nbrPipes - s.firstPipe;
+	}
+	for (wxUint32 i = 0; i < header->nbrPipes && isConsistent; i++) {
+		const SNAPSHOT_PIPE &p = m_pipeTable[i];
+		isConsistent = p.firstAttack <= header->nbrAttacks && p.nbrAttacks <= header->nbrAttacks - p.firstAttack &&
+			p.firstRelease <= header->nbrReleases && p.nbrReleases <= header->nbrReleases - p.firstRelease;
+	}
+	for (wxUint32 i = 0; i < header->nbrAttacks && isConsistent; i++) {
+		const SNAPSHOT_ATTACK &a = m_attackTable[i];
+		isConsistent = a.fileName < header->stringTableSize && a.firstLoop <= header->nbrLoops && a.nbrLoops <= header->nbrLoops - a.firstLoop;
+	}
+	for (wxUint32 i = 0; i < header->nbrReleases && isConsistent; i++)
+		isConsistent = m_releaseTable[i].fileName < header->stringTableSize;
+	if (!isConsistent) {
+		clear();
+		return false;
+	}
+
+	for (wxUint32 i = 0; i < header->nbrSections; i++)
+		m_sections[getString(m_sectionTable[i].name)] = i;
+	return true;
+}
+
+void OrganSnapshot::clear() {
+	m_buffer.SetDataLen(0);
+	m_sections.clear();
+	m_header = NULL;
+	m_sectionTable = NULL;
+	m_pipeTable = NULL;
+	m_attackTable = NULL;
+	m_releaseTable = NULL;
+	m_loopTable = NULL;
+	m_stringTable = NULL;
+}
+
+bool OrganSnapshot::isLoaded() {
+	return m_header != NULL;
+}
+
+bool OrganSnapshot::hasSection(const wxString &sectionName) {
+	return m_sections.count(sectionName) > 0;
+}
+
+wxArrayString OrganSnapshot::getSampleDirectories(const wxString &odfRoot) {
+	wxArrayString directories;
+	if (!m_header)
+		return directories;
+	// file names are stored once in the string table, so each is only looked at once
+	std::set<wxUint32> seenNames;
+	std::set<wxString> seenDirectories;
+	auto addFileName = [&](wxUint32 offset) {
+		if (!seenNames.insert(offset).second)
+			return;
+		wxString fileName = getString(offset);
+		if (fileName.StartsWith(wxT("REF")) || fileName.IsSameAs(wxT("DUMMY"), false))
+			return;
+		if (fileName.StartsWith(wxT("./")) || fileName.StartsWith(wxT(".\\")))
+			fileName.erase(0, 2);
+		wxString dir = wxFileName(odfRoot + wxFILE_SEP_PATH + fileName, wxPATH_DOS).GetPath();
+		if (seenDirectories.insert(dir).second)
+			directories.Add(dir);
+	};
+	for (wxUint32 i = 0; i < m_header->nbrAttacks; i++)
+		addFileName(m_attackTable[i].fileName);
+	for (wxUint32 i = 0; i < m_header->nbrReleases; i++)
+		addFileName(m_releaseTable[i].fileName);
+	return directories;
+}
+
+bool OrganSnapshot::restorePipes(const wxString &sectionName, Rank *rank, Organ *readOrgan) {
+	auto found = m_sections.find(sectionName);
+	if (found == m_sections.end())
+		return false;
+	const SNAPSHOT_SECTION &section = m_sectionTable[found->second];
+
+	rank->m_pipes.clear();
+	rank->markChanged();
+	for (wxUint32 i = 0; i < section.nbrPipes; i++) {
+		const SNAPSHOT_PIPE &sp = m_pipeTable[section.firstPipe + i];
+		Pipe p;
+		p.isPercussive = sp.isPercussive != 0;
+		p.hasIndependentRelease = sp.hasIndependentRelease != 0;
+		p.amplitudeLevel = sp.amplitudeLevel;
+		p.gain = sp.gain;
+		p.pitchTuning = sp.pitchTuning;
+		p.trackerDelay = sp.trackerDelay;
+		p.harmonicNumber = sp.harmonicNumber;
+		p.midiKeyNumber = sp.midiKeyNumber;
+		p.midiPitchFraction = sp.midiPitchFraction;
+		p.pitchCorrection = sp.pitchCorrection;
+		p.acceptsRetuning = sp.acceptsRetuning != 0;
+		p.minVelocityVolume = sp.minVelocityVolume;
+		p.maxVelocityVolume = sp.maxVelocityVolume;
+		if (sp.windchest > 0 && sp.windchest <= readOrgan->getNumberOfWindchestgroups())
+			p.windchest = readOrgan->getOrganWindchestgroupAt(sp.windchest - 1);
+		else
+			p.windchest = rank->getWindchest();
+
+		for (wxUint32 j = 0; j < sp.nbrAttacks; j++) {
+			const SNAPSHOT_ATTACK &sa = m_attackTable[sp.firstAttack + j];
+			Attack a;
+			a.fileName = getString(sa.fileName);
+			a.fullPath = getFullPath(a.fileName, readOrgan);
+			// the sample may have been removed since the snapshot was written
+			if (a.fullPath == wxEmptyString)
+				continue;
+			a.loadRelease = sa.loadRelease != 0;
+			a.attackVelocity = sa.attackVelocity;
+			a.maxTimeSinceLastRelease = sa.maxTimeSinceLastRelease;
+			a.isTremulant = sa.isTremulant;
+			a.maxKeyPressTime = sa.maxKeyPressTime;
+			a.attackStart = sa.attackStart;
+			a.cuePoint = sa.cuePoint;
+			a.releaseEnd = sa.releaseEnd;
+			a.loopCrossfadeLength = sa.loopCrossfadeLength;
+			a.releaseCrossfadeLength = sa.releaseCrossfadeLength;
+			for (wxUint32 k = 0; k < sa.nbrLoops; k++) {
+				Loop l;
+				l.start = m_loopTable[sa.firstLoop + k].start;
+				l.end = m_loopTable[sa.firstLoop + k].end;
+				a.addNewLoop(l);
+			}
+			p.m_attacks.push_back(a);
+		}
+		for (wxUint32 j = 0; j < sp.nbrReleases; j++) {
+			const SNAPSHOT_RELEASE &sr = m_releaseTable[sp.firstRelease + j];
+			Release r;
+			r.fileName = getString(sr.fileName);
+			r.fullPath = getFullPath(r.fileName, readOrgan);
+			if (r.fullPath == wxEmptyString)
+				continue;
+			r.isTremulant = sr.isTremulant;
+			r.maxKeyPressTime = sr.maxKeyPressTime;
+			r.cuePoint = sr.cuePoint;
+			r.releaseEnd = sr.releaseEnd;
+			r.releaseCrossfadeLength = sr.releaseCrossfadeLength;
+			p.m_releases.push_back(r);
+		}
+
+		// same as at the end of Pipe::read
+		if (p.m_attacks.empty()) {
+			Attack a;
+			p.m_attacks.push_back(a);
+		} else {
+			wxFileName fileName = p.m_attacks.front().fullPath;
+			rank->setPipesRootPath(fileName.GetPath());
+		}
+		rank->m_pipes.push_back(p);
+	}
+	return true;
+}
+
+wxString OrganSnapshot::getString(wxUint32 offset) {
+	return wxString::FromUTF8(m_stringTable + offset);
+}
+
+wxString OrganSnapshot::getFullPath(const wxString &fileName, Organ *readOrgan) {
+	if (fileName.StartsWith(wxT("REF")) || fileName.IsSameAs(wxT("DUMMY"), false))
+		return fileName;
+	// like Pipe::read a missing file gives an empty path and is reported by the cache
+	return GOODF_functions::checkIfFileExist(fileName, readOrgan);
+}
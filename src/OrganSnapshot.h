@@ -0,0 +1,156 @@
+/*
+ * OrganSnapshot.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANSNAPSHOT_H
+#define ORGANSNAPSHOT_H
+
+#include <wx/wx.h>
+#include <wx/buffer.h>
+#include <map>
+#include <set>
+
+class Organ;
+class Rank;
+struct ODF_WRITE_JOB;
+
+// All records are fixed size, made of 4 byte fields, so that the tables can be
+// used directly from the loaded file buffer. Strings are offsets into a table
+// of nul terminated UTF-8 strings at the end of the file.
+struct SNAPSHOT_HEADER {
+	char magic[8];
+	wxUint32 version;
+	wxUint32 nbrSections;
+	wxUint64 odfSize;
+	wxUint64 odfHash;
+	wxUint32 nbrPipes;
+	wxUint32 nbrAttacks;
+	wxUint32 nbrReleases;
+	wxUint32 nbrLoops;
+	wxUint32 stringTableSize;
+	wxUint32 reserved;
+};
+
+struct SNAPSHOT_SECTION {
+	wxUint32 name;
+	wxUint32 firstPipe;
+	wxUint32 nbrPipes;
+};
+
+struct SNAPSHOT_PIPE {
+	float amplitudeLevel;
+	float gain;
+	float pitchTuning;
+	float midiPitchFraction;
+	float pitchCorrection;
+	float minVelocityVolume;
+	float maxVelocityVolume;
+	wxInt32 trackerDelay;
+	wxInt32 harmonicNumber;
+	wxInt32 midiKeyNumber;
+	wxUint32 windchest; // one based, 0 means the windchest of the rank
+	wxUint8 isPercussive;
+	wxUint8 hasIndependentRelease;
+	wxUint8 acceptsRetuning;
+	wxUint8 padding;
+	wxUint32 firstAttack;
+	wxUint32 nbrAttacks;
+	wxUint32 firstRelease;
+	wxUint32 nbrReleases;
+};
+
+struct SNAPSHOT_ATTACK {
+	wxUint32 fileName;
+	wxInt32 attackVelocity;
+	wxInt32 maxTimeSinceLastRelease;
+	wxInt32 isTremulant;
+	wxInt32 maxKeyPressTime;
+	wxInt32 attackStart;
+	wxInt32 cuePoint;
+	wxInt32 releaseEnd;
+	wxInt32 loopCrossfadeLength;
+	wxInt32 releaseCrossfadeLength;
+	wxUint32 firstLoop;
+	wxUint32 nbrLoops;
+	wxUint8 loadRelease;
+	wxUint8 padding[3];
+};
+
+struct SNAPSHOT_RELEASE {
+	wxUint32 fileName;
+	wxInt32 isTremulant;
+	wxInt32 maxKeyPressTime;
+	wxInt32 cuePoint;
+	wxInt32 releaseEnd;
+	wxInt32 releaseCrossfadeLength;
+};
+
+struct SNAPSHOT_LOOP {
+	wxInt32 start;
+	wxInt32 end;
+};
+
+// A binary copy of the pipes of all ranks and internal ranks, written next to
+// the .organ file when it's saved. It's only valid for an .organ file with the
+// same size and content hash, which OrganFileParser checks before it skips the
+// pipe keys and lets Rank::read restore the pipes from here instead.
+class OrganSnapshot {
+
+public:
+	OrganSnapshot();
+	~OrganSnapshot();
+
+	static OrganSnapshot* getActive();
+	static void setActive(OrganSnapshot *snapshot);
+
+	static wxString getSnapshotPath(const wxString &odfPath);
+	static wxUint64 computeHash(const void *data, size_t length);
+
+	// the .organ file must just have been written from the organ or the job
+	bool write(const wxString &odfPath, Organ *organ);
+	bool write(const wxString &odfPath, ODF_WRITE_JOB *job);
+	// odfContent is the current content of the .organ file
+	bool load(const wxString &odfPath, const wxMemoryBuffer &odfContent);
+	void clear();
+
+	bool isLoaded();
+	bool hasSection(const wxString &sectionName);
+	// restored sample files are checked through the active FileExistenceCache,
+	// so these folders should be prefetched into it first
+	wxArrayString getSampleDirectories(const wxString &odfRoot);
+	bool restorePipes(const wxString &sectionName, Rank *rank, Organ *readOrgan);
+
+private:
+	wxMemoryBuffer m_buffer;
+	std::map<wxString, unsigned> m_sections;
+	const SNAPSHOT_HEADER *m_header;
+	const SNAPSHOT_SECTION *m_sectionTable;
+	const SNAPSHOT_PIPE *m_pipeTable;
+	const SNAPSHOT_ATTACK *m_attackTable;
+	const SNAPSHOT_RELEASE *m_releaseTable;
+	const SNAPSHOT_LOOP *m_loopTable;
+	const char *m_stringTable;
+
+	static thread_local OrganSnapshot *m_activeSnapshot;
+
+	wxString getString(wxUint32 offset);
+	wxString getFullPath(const wxString &fileName, Organ *readOrgan);
+};
+
+#endif
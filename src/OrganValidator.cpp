@@ -0,0 +1,509 @@
+/*
+ * OrganValidator.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganValidator.h"
+#include "Organ.h"
+#include "GUIButton.h"
+#include "GUIEnclosure.h"
+#include "GUILabel.h"
+#include "WAVfileParser.h"
+#include "ParallelTaskRunner.h"
+#include "TraceRecorder.h"
+#include <wx/filename.h>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <string>
+
+static void hashValue(size_t &hash, size_t value) {
+	hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+static void hashString(size_t &hash, const wxString &text) {
+	hashValue(hash, std::hash<std::wstring>()(text.ToStdWstring()));
+}
+
+static void addDiagnostic(
+	std::vector<VALIDATION_DIAGNOSTIC> &diagnostics,
+	VALIDATION_SEVERITY severity,
+	const wxString &ruleId,
+	VALIDATION_SUBJECT_KIND kind,
+	unsigned index,
+	int detailIndex,
+	const wxString &message
+) {
+	VALIDATION_DIAGNOSTIC d;
+	d.severity = severity;
+	d.ruleId = ruleId;
+	d.kind = kind;
+	d.subjectIndex = index;
+	d.detailIndex = detailIndex;
+	d.message = message;
+	diagnostics.push_back(d);
+}
+
+// the rank of a rank subject or the internal rank of a stop subject
+static Rank* getPipeOwner(Organ *organ, VALIDATION_SUBJECT_KIND kind, unsigned index) {
+	if (kind == VALIDATE_RANK)
+		return organ->getOrganRankAt(index);
+	Stop *stop = organ->getOrganStopAt(index);
+	if (stop->isUsingInternalRank())
+		return stop->getInternalRank();
+	return NULL;
+}
+
+static bool isSamplePath(const wxString &path) {
+	return path != wxEmptyString && !path.IsSameAs(wxT("DUMMY"), false) && !path.StartsWith(wxT("REF"));
+}
+
+// sample files must exist and the positions in them must be within the audio data
+class PipeSampleRule : public ValidationRule {
+public:
+	PipeSampleRule(VALIDATION_SUBJECT_KIND kind) : m_kind(kind) {}
+
+	wxString getId() { return wxT("pipe-sample"); }
+	VALIDATION_SUBJECT_KIND getSubjectKind() { return m_kind; }
+
+	void check(Organ *organ, unsigned index, OrganValidator *validator, std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		Rank *rank = getPipeOwner(organ, m_kind, index);
+		if (!rank)
+			return;
+		int pipeIndex = 0;
+		for (Pipe &pipe : rank->m_pipes) {
+			wxString pipeId = wxString::Format(wxT("Pipe %03d: "), pipeIndex + 1);
+			for (Attack &atk : pipe.m_attacks) {
+				if (!isSamplePath(atk.fullPath))
+					continue;
+				SAMPLE_FILE_FACTS facts = validator->getSampleFileFacts(atk.fullPath);
+				if (!checkFile(facts, atk.fileName, pipeId, index, pipeIndex, diagnostics))
+					continue;
+				if (atk.attackStart > 0 && (unsigned) atk.attackStart >= facts.numberOfFrames)
+					addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, pipeId + wxString::Format(wxT("AttackStart %d is beyond the %u frames of %s"), atk.attackStart, facts.numberOfFrames, atk.fileName));
+				unsigned loopNbr = 1;
+				for (Loop &loop : atk.m_loops) {
+					if ((unsigned) loop.end >= facts.numberOfFrames)
+						addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, pipeId + wxString::Format(wxT("loop %u ends at %d which is beyond the %u frames of %s"), loopNbr, loop.end, facts.numberOfFrames, atk.fileName));
+					else if (loop.start >= loop.end)
+						addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, pipeId + wxString::Format(wxT("loop %u of %s doesn't end after its start"), loopNbr, atk.fileName));
+					loopNbr++;
+				}
+				checkCueAndEnd(atk.cuePoint, atk.releaseEnd, facts, atk.fileName, pipeId, index, pipeIndex, diagnostics);
+			}
+			for (Release &rel : pipe.m_releases) {
+				if (!isSamplePath(rel.fullPath))
+					continue;
+				SAMPLE_FILE_FACTS facts = validator->getSampleFileFacts(rel.fullPath);
+				if (checkFile(facts, rel.fileName, pipeId, index, pipeIndex, diagnostics))
+					checkCueAndEnd(rel.cuePoint, rel.releaseEnd, facts, rel.fileName, pipeId, index, pipeIndex, diagnostics);
+			}
+			pipeIndex++;
+		}
+	}
+
+private:
+	VALIDATION_SUBJECT_KIND m_kind;
+
+	bool checkFile(const SAMPLE_FILE_FACTS &facts, const wxString &fileName, const wxString &pipeId, unsigned index, int pipeIndex, std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		if (!facts.exists) {
+			addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, pipeId + fileName + wxT(" doesn't exist"));
+			return false;
+		}
+		if (!facts.isWavOk) {
+			addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, pipeId + fileName + wxT(" can't be read as a wav or wavpack file"));
+			return false;
+		}
+		return true;
+	}
+
+	void checkCueAndEnd(int cuePoint, int releaseEnd, const SAMPLE_FILE_FACTS &facts, const wxString &fileName, const wxString &pipeId, unsigned index, int pipeIndex, std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		if (cuePoint > 0 && (unsigned) cuePoint > facts.numberOfFrames)
+			addDiagnostic(diagnostics, VALIDATION_WARNING, getId(), m_kind, index, pipeIndex, pipeId + wxString::Format(wxT("CuePoint %d is beyond the %u frames of %s"), cuePoint, facts.numberOfFrames, fileName));
+		if (releaseEnd > 0 && (unsigned) releaseEnd > facts.numberOfFrames)
+			addDiagnostic(diagnostics, VALIDATION_WARNING, getId(), m_kind, index, pipeIndex, pipeId + wxString::Format(wxT("ReleaseEnd %d is beyond the %u frames of %s"), releaseEnd, facts.numberOfFrames, fileName));
+	}
+};
+
+// REF:mmm:sss:ppp must point to an existing pipe of a stop with its own pipes
+class PipeReferenceRule : public ValidationRule {
+public:
+	PipeReferenceRule(VALIDATION_SUBJECT_KIND kind) : m_kind(kind) {}
+
+	wxString getId() { return wxT("pipe-reference"); }
+	VALIDATION_SUBJECT_KIND getSubjectKind() { return m_kind; }
+
+	void check(Organ *organ, unsigned index, OrganValidator *WXUNUSED(validator), std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		Rank *rank = getPipeOwner(organ, m_kind, index);
+		if (!rank)
+			return;
+		int pipeIndex = 0;
+		for (Pipe &pipe : rank->m_pipes) {
+			const wxString &ref = pipe.m_attacks.front().fileName;
+			if (ref.StartsWith(wxT("REF:"))) {
+				wxString problem = findProblem(organ, ref, rank, pipeIndex);
+				if (problem != wxEmptyString)
+					addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), m_kind, index, pipeIndex, wxString::Format(wxT("Pipe %03d: %s "), pipeIndex + 1, ref) + problem);
+			}
+			pipeIndex++;
+		}
+	}
+
+private:
+	VALIDATION_SUBJECT_KIND m_kind;
+
+	wxString findProblem(Organ *organ, const wxString &ref, Rank *owner, int pipeIndex) {
+		long manualNbr, stopNbr, pipeNbr;
+		if (ref.length() != 15 || !ref.Mid(4, 3).ToLong(&manualNbr) || !ref.Mid(8, 3).ToLong(&stopNbr) || !ref.Mid(12, 3).ToLong(&pipeNbr))
+			return wxT("is not of the form REF:mmm:sss:ppp");
+		long manualIndex = organ->doesHavePedals() ? manualNbr : manualNbr - 1;
+		if (manualIndex < 0 || manualIndex >= (long) organ->getNumberOfManuals())
+			return wxT("references a manual that doesn't exist");
+		Manual *manual = organ->getOrganManualAt(manualIndex);
+		if (stopNbr < 1 || stopNbr > (long) manual->getNumberOfStops())
+			return wxT("references a stop that doesn't exist on ") + manual->getName();
+		Stop *target = manual->getStopAt(stopNbr - 1);
+		if (!target->isUsingInternalRank())
+			return wxT("references stop ") + target->getName() + wxT(" that has no pipes of its own");
+		Rank *targetRank = target->getInternalRank();
+		if (pipeNbr < 1 || pipeNbr > (long) targetRank->m_pipes.size())
+			return wxString::Format(wxT("references pipe %ld but stop %s only has %u pipes"), pipeNbr, target->getName(), (unsigned) targetRank->m_pipes.size());
+		if (targetRank == owner && pipeNbr - 1 == pipeIndex)
+			return wxT("references itself");
+		return wxEmptyString;
+	}
+};
+
+// GrandOrgue requires a switch to only reference switches defined before it
+class SwitchOrderRule : public ValidationRule {
+public:
+	wxString getId() { return wxT("switch-order"); }
+	VALIDATION_SUBJECT_KIND getSubjectKind() { return VALIDATE_SWITCH; }
+
+	void check(Organ *organ, unsigned index, OrganValidator *WXUNUSED(validator), std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		GoSwitch *sw = organ->getOrganSwitchAt(index);
+		for (unsigned i = 0; i < sw->getNumberOfSwitches(); i++) {
+			GoSwitch *referenced = sw->getSwitchAtIndex(i);
+			unsigned referencedNbr = organ->getIndexOfOrganSwitch(referenced);
+			if (referencedNbr == 0 || referencedNbr > index)
+				addDiagnostic(diagnostics, VALIDATION_ERROR, getId(), VALIDATE_SWITCH, index, -1, wxString::Format(wxT("references Switch%03u %s which is not defined before it"), referencedNbr, referenced->getName()));
+		}
+	}
+};
+
+// explicitly positioned gui elements and images must be within the panel
+class PanelBoundsRule : public ValidationRule {
+public:
+	wxString getId() { return wxT("panel-bounds"); }
+	VALIDATION_SUBJECT_KIND getSubjectKind() { return VALIDATE_PANEL; }
+
+	void check(Organ *organ, unsigned index, OrganValidator *WXUNUSED(validator), std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) {
+		GoPanel *panel = organ->getOrganPanelAt(index);
+		int panelWidth = panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue();
+		int panelHeight = panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue();
+		for (int i = 0; i < panel->getNumberOfGuiElements(); i++) {
+			GUIElement *element = panel->getGuiElementAt(i);
+			int x = element->getPosX();
+			int y = element->getPosY();
+			int width = 0;
+			int height = 0;
+			getElementSize(element, width, height);
+			if ((x >= 0 && x + width > panelWidth) || (y >= 0 && y + height > panelHeight))
+				addDiagnostic(diagnostics, VALIDATION_WARNING, getId(), VALIDATE_PANEL, index, i, wxString::Format(wxT("%s at %d, %d (%d x %d) is outside the %d x %d panel"), element->getDisplayName(), x, y, width, height, panelWidth, panelHeight));
+		}
+		for (unsigned i = 0; i < panel->getNumberOfImages(); i++) {
+			GoImage *image = panel->getImageAt(i);
+			if (image->getPositionX() + image->getWidth() > panelWidth || image->getPositionY() + image->getHeight() > panelHeight)
+				addDiagnostic(diagnostics, VALIDATION_WARNING, getId(), VALIDATE_PANEL, index, -1, wxString::Format(wxT("Image %s at %d, %d (%d x %d) is outside the %d x %d panel"), image->getImageNameOnly(), image->getPositionX(), image->getPositionY(), image->getWidth(), image->getHeight(), panelWidth, panelHeight));
+		}
+	}
+
+	static void getElementSize(GUIElement *element, int &width, int &height) {
+		if (GUIButton *button = dynamic_cast<GUIButton*>(element)) {
+			width = button->getWidth();
+			height = button->getHeight();
+		} else if (GUIEnclosure *enclosure = dynamic_cast<GUIEnclosure*>(element)) {
+			width = enclosure->getWidth();
+			height = enclosure->getHeight();
+		} else if (GUILabel *label = dynamic_cast<GUILabel*>(element)) {
+			width = label->getWidth();
+			height = label->getHeight();
+		}
+	}
+};
+
+OrganValidator::OrganValidator(unsigned nbrOfThreads) {
+	m_nbrOfThreads = nbrOfThreads;
+	m_organ = NULL;
+	m_nbrOfCheckedSubjects = 0;
+	addRule(new PipeSampleRule(VALIDATE_RANK));
+	addRule(new PipeSampleRule(VALIDATE_STOP));
+	addRule(new PipeReferenceRule(VALIDATE_RANK));
+	addRule(new PipeReferenceRule(VALIDATE_STOP));
+	addRule(new SwitchOrderRule());
+	addRule(new PanelBoundsRule());
+}
+
+OrganValidator::~OrganValidator() {
+	for (ValidationRule *rule : m_rules)
+		delete rule;
+}
+
+void OrganValidator::addRule(ValidationRule *rule) {
+	m_rules.push_back(rule);
+	markDirty(rule->getSubjectKind(), UINT_MAX);
+}
+
+bool OrganValidator::validate(Organ *organ, wxProgressDialog *progress) {
+	TraceScope trace("OrganValidator::validate");
+	if (organ != m_organ) {
+		clear();
+		m_organ = organ;
+	}
+
+	// a structural change (elements added, removed or moved) can change the
+	// meaning of any reference so then everything is checked again
+	size_t structure = getStructureFingerprint(organ);
+	std::vector<std::pair<VALIDATION_SUBJECT_KIND, unsigned>> dirty;
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++) {
+		VALIDATION_SUBJECT_KIND kind = (VALIDATION_SUBJECT_KIND) k;
+		std::vector<size_t> fingerprints = getFingerprints(organ, kind, structure);
+		m_subjects[k].resize(fingerprints.size());
+		for (unsigned i = 0; i < fingerprints.size(); i++) {
+			VALIDATION_SUBJECT_STATE &state = m_subjects[k][i];
+			if (!state.isChecked || state.fingerprint != fingerprints[i]) {
+				state.fingerprint = fingerprints[i];
+				state.isChecked = false;
+				dirty.push_back(std::make_pair(kind, i));
+			}
+		}
+	}
+
+	std::atomic<unsigned> nbrChecked(0);
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	bool completed = runner.run(dirty.size(), [&](unsigned task) {
+		VALIDATION_SUBJECT_KIND kind = dirty[task].first;
+		unsigned index = dirty[task].second;
+		std::vector<VALIDATION_DIAGNOSTIC> found;
+		for (ValidationRule *rule : m_rules) {
+			if (rule->getSubjectKind() == kind)
+				rule->check(organ, index, this, found);
+		}
+		VALIDATION_SUBJECT_STATE &state = m_subjects[kind][index];
+		state.diagnostics.swap(found);
+		state.isChecked = true;
+		nbrChecked++;
+	}, progress, wxT("Validating the organ"));
+	m_nbrOfCheckedSubjects = nbrChecked;
+	return completed;
+}
+
+void OrganValidator::markDirty(VALIDATION_SUBJECT_KIND kind, unsigned index) {
+	// UINT_MAX marks all elements of the kind
+	for (unsigned i = 0; i < m_subjects[kind].size(); i++) {
+		if (index == UINT_MAX || i == index)
+			m_subjects[kind][i].isChecked = false;
+	}
+}
+
+void OrganValidator::markAllDirty() {
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++)
+		markDirty((VALIDATION_SUBJECT_KIND) k, UINT_MAX);
+	std::lock_guard<std::mutex> lock(m_sampleFileMutex);
+	m_sampleFiles.clear();
+}
+
+void OrganValidator::clear() {
+	m_organ = NULL;
+	m_nbrOfCheckedSubjects = 0;
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++)
+		m_subjects[k].clear();
+	std::lock_guard<std::mutex> lock(m_sampleFileMutex);
+	m_sampleFiles.clear();
+}
+
+bool OrganValidator::hasResultsFor(Organ *organ) {
+	return m_organ != NULL && m_organ == organ;
+}
+
+std::vector<VALIDATION_DIAGNOSTIC> OrganValidator::getDiagnostics() {
+	std::vector<VALIDATION_DIAGNOSTIC> diagnostics;
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++) {
+		for (const VALIDATION_SUBJECT_STATE &state : m_subjects[k])
+			diagnostics.insert(diagnostics.end(), state.diagnostics.begin(), state.diagnostics.end());
+	}
+	return diagnostics;
+}
+
+unsigned OrganValidator::getNumberOfErrors() {
+	unsigned count = 0;
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++) {
+		for (const VALIDATION_SUBJECT_STATE &state : m_subjects[k]) {
+			for (const VALIDATION_DIAGNOSTIC &d : state.diagnostics) {
+				if (d.severity == VALIDATION_ERROR)
+					count++;
+			}
+		}
+	}
+	return count;
+}
+
+unsigned OrganValidator::getNumberOfWarnings() {
+	unsigned count = 0;
+	for (int k = 0; k < NBR_OF_VALIDATION_SUBJECT_KINDS; k++) {
+		for (const VALIDATION_SUBJECT_STATE &state : m_subjects[k]) {
+			for (const VALIDATION_DIAGNOSTIC &d : state.diagnostics) {
+				if (d.severity == VALIDATION_WARNING)
+					count++;
+			}
+		}
+	}
+	return count;
+}
+
+unsigned OrganValidator::getNumberOfCheckedSubjects() {
+	return m_nbrOfCheckedSubjects;
+}
+
+SAMPLE_FILE_FACTS OrganValidator::getSampleFileFacts(const wxString &fullPath) {
+	SAMPLE_FILE_FACTS facts;
+	facts.exists = false;
+	facts.isWavOk = false;
+	facts.numberOfFrames = 0;
+	wxFileName fileName(fullPath);
+	if (!fileName.FileExists())
+		return facts;
+	facts.exists = true;
+	facts.modificationTime = fileName.GetModificationTime();
+
+	// the file is only parsed again if it has changed since it was last read
+	if (facts.modificationTime.IsValid()) {
+		std::lock_guard<std::mutex> lock(m_sampleFileMutex);
+		std::map<wxString, SAMPLE_FILE_FACTS>::iterator it = m_sampleFiles.find(fullPath);
+		if (it != m_sampleFiles.end() && it->second.modificationTime.IsValid() && it->second.modificationTime == facts.modificationTime)
+			return it->second;
+	}
+
+	WAVfileParser wav(fullPath);
+	facts.isWavOk = wav.isWavOk();
+	if (facts.isWavOk)
+		facts.numberOfFrames = wav.getNumberOfFrames();
+	if (facts.modificationTime.IsValid()) {
+		std::lock_guard<std::mutex> lock(m_sampleFileMutex);
+		m_sampleFiles[fullPath] = facts;
+	}
+	return facts;
+}
+
+wxString OrganValidator::getSubjectName(Organ *organ, VALIDATION_SUBJECT_KIND kind, unsigned index) {
+	if (index >= getNumberOfSubjects(organ, kind))
+		return wxEmptyString;
+	switch (kind) {
+		case VALIDATE_RANK:
+			return wxT("Rank ") + organ->getOrganRankAt(index)->getName();
+		case VALIDATE_STOP:
+			return wxT("Stop ") + organ->getOrganStopAt(index)->getName() + wxT(" (") + organ->getOrganStopAt(index)->getOwningManual()->getName() + wxT(")");
+		case VALIDATE_SWITCH:
+			return wxT("Switch ") + organ->getOrganSwitchAt(index)->getName();
+		case VALIDATE_PANEL:
+			return wxT("Panel ") + organ->getOrganPanelAt(index)->getName();
+		default:
+			return wxEmptyString;
+	}
+}
+
+unsigned OrganValidator::getNumberOfSubjects(Organ *organ, VALIDATION_SUBJECT_KIND kind) {
+	switch (kind) {
+		case VALIDATE_RANK:
+			return organ->getNumberOfRanks();
+		case VALIDATE_STOP:
+			return organ->getNumberOfStops();
+		case VALIDATE_SWITCH:
+			return organ->getNumberOfSwitches();
+		case VALIDATE_PANEL:
+			return organ->getNumberOfPanels();
+		default:
+			return 0;
+	}
+}
+
+size_t OrganValidator::getStructureFingerprint(Organ *organ) {
+	size_t hash = 0;
+	hashValue(hash, organ->doesHavePedals());
+	hashValue(hash, organ->getNumberOfRanks());
+	hashValue(hash, organ->getNumberOfStops());
+	hashValue(hash, organ->getNumberOfPanels());
+	for (unsigned i = 0; i < organ->getNumberOfManuals(); i++) {
+		Manual *manual = organ->getOrganManualAt(i);
+		hashString(hash, manual->getName());
+		hashValue(hash, manual->getNumberOfStops());
+		for (unsigned j = 0; j < manual->getNumberOfStops(); j++) {
+			Stop *stop = manual->getStopAt(j);
+			hashValue(hash, (size_t) stop);
+			hashValue(hash, stop->isUsingInternalRank());
+			if (stop->isUsingInternalRank())
+				hashValue(hash, stop->getInternalRank()->m_pipes.size());
+		}
+	}
+	for (unsigned i = 0; i < organ->getNumberOfSwitches(); i++)
+		hashValue(hash, (size_t) organ->getOrganSwitchAt(i));
+	return hash;
+}
+
+std::vector<size_t> OrganValidator::getFingerprints(Organ *organ, VALIDATION_SUBJECT_KIND kind, size_t structure) {
+	TraceScope trace("OrganValidator::getFingerprints");
+	// ranks and panels count their own changes so their pipes and gui
+	// elements don't need to be looked at here
+	std::vector<size_t> fingerprints;
+	fingerprints.reserve(getNumberOfSubjects(organ, kind));
+	if (kind == VALIDATE_RANK) {
+		for (Rank &rank : *organ->getOrganRanks()) {
+			size_t hash = structure;
+			hashValue(hash, rank.getRevision());
+			fingerprints.push_back(hash);
+		}
+	} else if (kind == VALIDATE_STOP) {
+		for (Stop &stop : *organ->getOrganStops()) {
+			size_t hash = structure;
+			hashString(hash, stop.getName());
+			hashString(hash, stop.getOwningManual()->getName());
+			hashValue(hash, stop.isUsingInternalRank());
+			if (stop.isUsingInternalRank())
+				hashValue(hash, stop.getInternalRank()->getRevision());
+			fingerprints.push_back(hash);
+		}
+	} else if (kind == VALIDATE_SWITCH) {
+		for (unsigned i = 0; i < organ->getNumberOfSwitches(); i++) {
+			GoSwitch *sw = organ->getOrganSwitchAt(i);
+			size_t hash = structure;
+			hashString(hash, sw->getName());
+			for (unsigned j = 0; j < sw->getNumberOfSwitches(); j++) {
+				hashValue(hash, (size_t) sw->getSwitchAtIndex(j));
+				hashString(hash, sw->getSwitchAtIndex(j)->getName());
+			}
+			fingerprints.push_back(hash);
+		}
+	} else if (kind == VALIDATE_PANEL) {
+		for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+			size_t hash = structure;
+			hashValue(hash, organ->getOrganPanelAt(i)->getRevision());
+			fingerprints.push_back(hash);
+		}
+	}
+	return fingerprints;
+}
@@ -0,0 +1,128 @@
+/*
+ * OrganValidator.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANVALIDATOR_H
+#define ORGANVALIDATOR_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <map>
+#include <mutex>
+
+class Organ;
+class OrganValidator;
+
+// the organ elements that are validated one by one, indexes are the ones
+// of the organ lists (ranks, stops, switches and panels)
+enum VALIDATION_SUBJECT_KIND {
+	VALIDATE_RANK,
+	VALIDATE_STOP,
+	VALIDATE_SWITCH,
+	VALIDATE_PANEL,
+	NBR_OF_VALIDATION_SUBJECT_KINDS
+};
+
+enum VALIDATION_SEVERITY {
+	VALIDATION_WARNING,
+	VALIDATION_ERROR
+};
+
+struct VALIDATION_DIAGNOSTIC {
+	VALIDATION_SEVERITY severity;
+	wxString ruleId;
+	VALIDATION_SUBJECT_KIND kind;
+	unsigned subjectIndex;
+	int detailIndex; // pipe, gui element or image index, -1 if it concerns the whole element
+	wxString message;
+};
+
+struct SAMPLE_FILE_FACTS {
+	bool exists;
+	bool isWavOk;
+	unsigned numberOfFrames;
+	wxDateTime modificationTime;
+};
+
+// A check of one kind of organ element. Rules are run on worker threads and
+// must only read the organ, the sample files are looked at through the
+// validator that caches what it has read of them.
+class ValidationRule {
+public:
+	virtual ~ValidationRule() {}
+	virtual wxString getId() = 0;
+	virtual VALIDATION_SUBJECT_KIND getSubjectKind() = 0;
+	virtual void check(Organ *organ, unsigned index, OrganValidator *validator, std::vector<VALIDATION_DIAGNOSTIC> &diagnostics) = 0;
+};
+
+// Runs the registered rules on all elements of an organ. The first run checks
+// everything in parallel, after that only the elements whose fingerprint (the
+// revision of a rank or panel, or the few values the other rules depend on)
+// has changed, or that are marked dirty, are checked again so that it can be
+// run after every edit.
+class OrganValidator {
+
+public:
+	OrganValidator(unsigned nbrOfThreads = 0);
+	~OrganValidator();
+
+	// the validator takes ownership of the rule
+	void addRule(ValidationRule *rule);
+
+	// returns false if aborted from the progress dialog
+	bool validate(Organ *organ, wxProgressDialog *progress = NULL);
+	void markDirty(VALIDATION_SUBJECT_KIND kind, unsigned index);
+	// also forgets what is known about the sample files
+	void markAllDirty();
+	// must be called when another organ is opened
+	void clear();
+	bool hasResultsFor(Organ *organ);
+
+	std::vector<VALIDATION_DIAGNOSTIC> getDiagnostics();
+	unsigned getNumberOfErrors();
+	unsigned getNumberOfWarnings();
+	// how many elements the last validation actually checked
+	unsigned getNumberOfCheckedSubjects();
+
+	SAMPLE_FILE_FACTS getSampleFileFacts(const wxString &fullPath);
+
+	static wxString getSubjectName(Organ *organ, VALIDATION_SUBJECT_KIND kind, unsigned index);
+
+private:
+	struct VALIDATION_SUBJECT_STATE {
+		size_t fingerprint = 0;
+		bool isChecked = false;
+		std::vector<VALIDATION_DIAGNOSTIC> diagnostics;
+	};
+
+	unsigned m_nbrOfThreads;
+	std::vector<ValidationRule*> m_rules;
+	Organ *m_organ;
+	std::vector<VALIDATION_SUBJECT_STATE> m_subjects[NBR_OF_VALIDATION_SUBJECT_KINDS];
+	unsigned m_nbrOfCheckedSubjects;
+	std::map<wxString, SAMPLE_FILE_FACTS> m_sampleFiles;
+	std::mutex m_sampleFileMutex;
+
+	static unsigned getNumberOfSubjects(Organ *organ, VALIDATION_SUBJECT_KIND kind);
+	static size_t getStructureFingerprint(Organ *organ);
+	static std::vector<size_t> getFingerprints(Organ *organ, VALIDATION_SUBJECT_KIND kind, size_t structure);
+};
+
+#endif
@@ -0,0 +1,873 @@
+/*
+ * PanelRenderer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PanelRenderer.h"
+#include "GUIButton.h"
+#include "GUILabel.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+PanelRenderer::PanelRenderer(GoPanel *panel) : m_panel(panel) {
+	m_HackY = 0;
+	m_EnclosureY = 0;
+	m_CenterY = 0;
+	m_CenterWidth = 0;
+	m_FontScale = 1.0;
+	InitFont();
+	UpdateLayout();
+}
+
+PanelRenderer::~PanelRenderer() {
+
+}
+
+GoPanel* PanelRenderer::GetPanel() {
+	return m_panel;
+}
+
+int PanelRenderer::GetPanelWidth() {
+	return m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue();
+}
+
+int PanelRenderer::GetPanelHeight() {
+	return m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue();
+}
+
+void PanelRenderer::Render(wxDC& dc, std::vector<GUI_OBJECT> *guiObjects) {
+	TraceScope phase("render backgrounds");
+	// First draw the basic background of left jamb
+	wxRect rect = wxRect(0, 0, GetCenterX(), m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+	wxBitmap stopBg = m_panel->getDisplayMetrics()->getDrawstopBg();
+	TileBitmap(rect, dc, stopBg, 0, 0);
+
+	// Right jamb
+	rect = wxRect((GetCenterX() + GetCenterWidth()), 0, m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - (GetCenterX() + GetCenterWidth()), m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+	TileBitmap(rect, dc, stopBg, 0, 0);
+
+	// Console, middle part
+	rect = wxRect(GetCenterX(), 0, GetCenterWidth(), m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+	wxBitmap consoleBg = m_panel->getDisplayMetrics()->getConsoleBg();
+	TileBitmap(rect, dc, consoleBg, 0, 0);
+
+	// Inset for paired drawstops
+	if (m_panel->getDisplayMetrics()->m_dispPairDrawstopCols) {
+		for (int i = 0; i < (m_panel->getDisplayMetrics()->m_dispDrawstopCols >> 2); i++) {
+			rect = wxRect(i * (2 * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 18) + GetJambLeftX() - 5, GetJambLeftRightY(), 2 * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 10, GetJambLeftRightHeight());
+			wxBitmap insetBg = m_panel->getDisplayMetrics()->getInsetBg();
+			TileBitmap(rect, dc, insetBg, 0, 0);
+
+			rect = wxRect(i * (2 * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 18) + GetJambRightX() - 5, GetJambLeftRightY(), 2 * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 10, GetJambLeftRightHeight());
+			TileBitmap(rect, dc, insetBg, 0, 0);
+		}
+	}
+
+	// Trim above extra rows
+	if (m_panel->getDisplayMetrics()->m_dispTrimAboveExtraRows) {
+		rect = wxRect(GetCenterX(), GetCenterY(), GetCenterWidth(), 8);
+		wxBitmap keyVert = m_panel->getDisplayMetrics()->getKeyVertBg();
+		TileBitmap(rect, dc, keyVert, 0, 0);
+	}
+
+	if (GetJambTopHeight() + GetPistonTopHeight()) {
+		rect = wxRect(GetCenterX(), GetJambTopY(), GetCenterWidth(), GetJambTopHeight() + GetPistonTopHeight());
+		wxBitmap keyHoriz = m_panel->getDisplayMetrics()->getKeyHorizBg();
+		TileBitmap(rect, dc, keyHoriz, 0, 0);
+	}
+
+	// Manual backgrounds
+	for (unsigned i = 0; i < m_panel->getNumberOfManuals(); i++) {
+		GUIManual *currentMan = m_panel->getGuiManualAt(i);
+		wxRect vRect = wxRect(GetCenterX(), currentMan->m_renderInfo.y, GetCenterWidth(), currentMan->m_renderInfo.height);
+		wxBitmap keyVert = m_panel->getDisplayMetrics()->getKeyVertBg();
+		TileBitmap(vRect, dc, keyVert, 0, 0);
+
+		wxRect hRect = wxRect(GetCenterX(), currentMan->m_renderInfo.piston_y, GetCenterWidth(), (!i && m_panel->getDisplayMetrics()->m_dispExtraPedalButtonRow) ? 2 * m_panel->getDisplayMetrics()->m_dispPistonHeight : m_panel->getDisplayMetrics()->m_dispPistonHeight);
+		wxBitmap keyHoriz = m_panel->getDisplayMetrics()->getKeyHorizBg();
+		TileBitmap(hRect, dc, keyHoriz, 0, 0);
+	}
+
+	phase.next("render images");
+	if (m_panel->getNumberOfImages() > 0) {
+		for (unsigned i = 0; i < m_panel->getNumberOfImages(); i++) {
+			// if the image is empty it should just be skipped
+			wxBitmap theBmp = m_panel->getImageAt(i)->getBitmap();
+			if (!theBmp.IsOk())
+				continue;
+			int imgX = m_panel->getImageAt(i)->getPositionX();
+			int imgY = m_panel->getImageAt(i)->getPositionY();
+			int imgWidth = m_panel->getImageAt(i)->getWidth();
+			int imgHeight = m_panel->getImageAt(i)->getHeight();
+			if (m_panel->getImageAt(i)->getWidth() > m_panel->getImageAt(i)->getOriginalWidth() || m_panel->getImageAt(i)->getHeight() > m_panel->getImageAt(i)->getOriginalHeight()) {
+				wxRect imgRect(
+					imgX,
+					imgY,
+					imgWidth,
+					imgHeight
+				);
+				TileBitmap(imgRect, dc, theBmp, m_panel->getImageAt(i)->getTileOffsetX(), m_panel->getImageAt(i)->getTileOffsetY());
+			} else {
+				dc.DrawBitmap(theBmp, imgX, imgY, true);
+			}
+			if (guiObjects && imgWidth < m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() / 2 && imgHeight < m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() / 2) {
+				GUI_OBJECT theImage;
+				theImage.element = NULL;
+				theImage.img = m_panel->getImageAt(i);
+				theImage.boundingRect = wxRect(imgX, imgY, imgWidth, imgHeight);
+				theImage.isSelected = false;
+				guiObjects->push_back(theImage);
+			}
+		}
+	}
+
+	// Manual keys drawn after images!
+	phase.next("render manuals");
+	for (unsigned i = 0; i < m_panel->getNumberOfManuals(); i++) {
+		GUIManual *currentMan = m_panel->getGuiManualAt(i);
+		int manXpos = currentMan->m_renderInfo.x;
+		int manYpos = currentMan->m_renderInfo.keys_y;
+		if (currentMan->getPosX() >= 0)
+			manXpos = currentMan->getPosX();
+		if (currentMan->getPosY() >= 0) {
+			manYpos = currentMan->getPosY();
+		}
+		for (int j = 0; j < currentMan->getNumberOfDisplayKeys(); j++) {
+			KEY_INFO *currentKey = currentMan->getKeyInfoAt(j);
+			wxBitmap theKey = currentKey->KeyImage;
+			dc.DrawBitmap(theKey, manXpos + currentKey->Xpos, manYpos + currentKey->Ypos, true);
+		}
+		if (guiObjects) {
+			GUI_OBJECT theManual;
+			theManual.element = currentMan;
+			theManual.img = NULL;
+			theManual.boundingRect = wxRect(manXpos, manYpos, currentMan->m_renderInfo.width, currentMan->m_renderInfo.height);
+			theManual.isSelected = false;
+			guiObjects->push_back(theManual);
+		}
+	}
+
+	phase.next("render gui elements");
+	if (m_panel->getNumberOfGuiElements() > 0) {
+		for (unsigned i = 0; i < (unsigned) m_panel->getNumberOfGuiElements(); i++) {
+			GUIElement *guiElement = m_panel->getGuiElementAt(i);
+			wxBitmap theBmp = guiElement->getBitmap();
+			// Test if it's a button type
+			GUIButton *btnElement = dynamic_cast<GUIButton*>(guiElement);
+			if (btnElement) {
+				wxPoint thePos;
+				if (btnElement->isDisplayAsPiston()) {
+					thePos = GetPushbuttonPosition(btnElement->getDispButtonRow(), btnElement->getDispButtonCol());
+				} else {
+					thePos = GetDrawstopPosition(btnElement->getDispDrawstopRow(), btnElement->getDispDrawstopCol());
+				}
+				if (btnElement->getPosX() != -1) {
+					thePos.x = btnElement->getPosX();
+				}
+				if (btnElement->getPosY() != -1) {
+					thePos.y = btnElement->getPosY();
+				}
+
+				if (theBmp.IsOk()) {
+					wxRect imgRect(thePos.x, thePos.y, btnElement->getWidth(), btnElement->getHeight());
+					TileBitmap(imgRect, dc, theBmp, btnElement->getTileOffsetX(), btnElement->getTileOffsetY());
+				}
+
+				if (btnElement->getTextBreakWidth()) {
+					dc.SetFont(btnElement->getDispLabelFont());
+					dc.SetBackgroundMode(wxTRANSPARENT);
+					dc.SetTextForeground(btnElement->getDispLabelColour()->getColor());
+					wxRect textRect(
+						thePos.x + btnElement->getTextRectLeft(),
+						thePos.y + btnElement->getTextRectTop(),
+						btnElement->getTextRectWidth(),
+						btnElement->getTextRectHeight()
+					);
+					wxString textToDisplay;
+					if (btnElement->getDispLabelText() != wxEmptyString)
+						textToDisplay = btnElement->getDispLabelText();
+					else
+						textToDisplay = btnElement->getElementName();
+					if (btnElement->getDispLabelText() == wxEmptyString) {
+						if (textToDisplay.Contains(wxT("Setter")) && textToDisplay.Contains(wxT("Divisional")) && textToDisplay.Len() == 22) {
+							wxString combinationNbr = textToDisplay.Mid(19);
+							long theNbr;
+							if (combinationNbr.ToLong(&theNbr)) {
+								theNbr += 1;
+								textToDisplay = wxString::Format(wxT("%ld"), theNbr);
+							}
+						} else if (textToDisplay.Contains(wxT("General")) && textToDisplay.Len() == 9) {
+							wxString combinationNbr = textToDisplay.Mid(7);
+							long theNbr;
+							if (combinationNbr.ToLong(&theNbr)) {
+								textToDisplay = wxString::Format(wxT("%ld"), theNbr);
+							}
+						} else if (textToDisplay.IsSameAs(wxT("SetterXXXDivisionalPrevBank"))) {
+							textToDisplay = wxT("-");
+						} else if (textToDisplay.IsSameAs(wxT("SetterXXXDivisionalNextBank"))) {
+							textToDisplay = wxT("+");
+						} else if (textToDisplay.IsSameAs(wxT("GeneralPrev"))) {
+							textToDisplay = wxT("Prev");
+						} else if (textToDisplay.IsSameAs(wxT("GeneralNext"))) {
+							textToDisplay = wxT("Next");
+						} else if (textToDisplay.IsSameAs(wxT("Home"))) {
+							textToDisplay = wxT("000");
+						} else if (textToDisplay.IsSameAs(wxT("LoadFile"))) {
+							textToDisplay = wxT("Load File");
+						} else if (textToDisplay.IsSameAs(wxT("PrevFile"))) {
+							textToDisplay = wxT("Prev File");
+						} else if (textToDisplay.IsSameAs(wxT("NextFile"))) {
+							textToDisplay = wxT("Next File");
+						} else if (textToDisplay.IsSameAs(wxT("SaveFile"))) {
+							textToDisplay = wxT("Save File");
+						} else if (textToDisplay.IsSameAs(wxT("RefreshFiles"))) {
+							textToDisplay = wxT("Refresh Files");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoA"))) {
+							textToDisplay = wxT("A");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoB"))) {
+							textToDisplay = wxT("B");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoC"))) {
+							textToDisplay = wxT("C");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoD"))) {
+							textToDisplay = wxT("D");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoPrev"))) {
+							textToDisplay = wxT("<");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoNext"))) {
+							textToDisplay = wxT(">");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoCurrent"))) {
+							textToDisplay = wxT("Current");
+						} else if (textToDisplay.IsSameAs(wxT("CrescendoOverride"))) {
+							textToDisplay = wxT("Override");
+						} else if (textToDisplay.IsSameAs(wxT("GC"))) {
+							textToDisplay = wxT("G.C.");
+						} else if (textToDisplay.IsSameAs(wxT("P1"))) {
+							textToDisplay = wxT("+1");
+						} else if (textToDisplay.IsSameAs(wxT("M1"))) {
+							textToDisplay = wxT("-1");
+						} else if (textToDisplay.IsSameAs(wxT("P10"))) {
+							textToDisplay = wxT("+10");
+						} else if (textToDisplay.IsSameAs(wxT("M10"))) {
+							textToDisplay = wxT("-10");
+						} else if (textToDisplay.IsSameAs(wxT("P100"))) {
+							textToDisplay = wxT("+100");
+						} else if (textToDisplay.IsSameAs(wxT("M100"))) {
+							textToDisplay = wxT("-100");
+						} else if (textToDisplay.IsSameAs(wxT("PitchP1"))) {
+							textToDisplay = wxT("+1");
+						} else if (textToDisplay.IsSameAs(wxT("PitchP10"))) {
+							textToDisplay = wxT("+10");
+						} else if (textToDisplay.IsSameAs(wxT("PitchP100"))) {
+							textToDisplay = wxT("+100");
+						} else if (textToDisplay.IsSameAs(wxT("PitchM1"))) {
+							textToDisplay = wxT("-1");
+						} else if (textToDisplay.IsSameAs(wxT("PitchM10"))) {
+							textToDisplay = wxT("-10");
+						} else if (textToDisplay.IsSameAs(wxT("PitchM100"))) {
+							textToDisplay = wxT("-100");
+						} else if (textToDisplay.IsSameAs(wxT("TemperamentPrev"))) {
+							textToDisplay = wxT("<");
+						} else if (textToDisplay.IsSameAs(wxT("TemperamentNext"))) {
+							textToDisplay = wxT(">");
+						} else if (textToDisplay.IsSameAs(wxT("TransposeUp"))) {
+							textToDisplay = wxT("+");
+						} else if (textToDisplay.IsSameAs(wxT("TransposeDown"))) {
+							textToDisplay = wxT("-");
+						} else if (textToDisplay.IsSameAs(wxT("L0"))) {
+							textToDisplay = wxT("__0");
+						} else if (textToDisplay.IsSameAs(wxT("L1"))) {
+							textToDisplay = wxT("__1");
+						} else if (textToDisplay.IsSameAs(wxT("L2"))) {
+							textToDisplay = wxT("__2");
+						} else if (textToDisplay.IsSameAs(wxT("L3"))) {
+							textToDisplay = wxT("__3");
+						} else if (textToDisplay.IsSameAs(wxT("L4"))) {
+							textToDisplay = wxT("__4");
+						} else if (textToDisplay.IsSameAs(wxT("L5"))) {
+							textToDisplay = wxT("__5");
+						} else if (textToDisplay.IsSameAs(wxT("L6"))) {
+							textToDisplay = wxT("__6");
+						} else if (textToDisplay.IsSameAs(wxT("L7"))) {
+							textToDisplay = wxT("__7");
+						} else if (textToDisplay.IsSameAs(wxT("L8"))) {
+							textToDisplay = wxT("__8");
+						} else if (textToDisplay.IsSameAs(wxT("L9"))) {
+							textToDisplay = wxT("__9");
+						}
+					}
+					dc.DrawLabel(BreakTextLine(textToDisplay, btnElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_VERTICAL | wxALIGN_CENTER_HORIZONTAL);
+				}
+				if (guiObjects) {
+					GUI_OBJECT theButton;
+					theButton.element = btnElement;
+					theButton.img = NULL;
+					theButton.boundingRect = wxRect(thePos.x, thePos.y, btnElement->getWidth(), btnElement->getHeight());
+					theButton.isSelected = false;
+					guiObjects->push_back(theButton);
+				}
+				continue;
+			}
+			GUIEnclosure *encElement = dynamic_cast<GUIEnclosure*>(guiElement);
+			if (encElement) {
+				wxPoint thePos(0, 0);
+
+				int enclosureNumberOnPanel = -1;
+				for (unsigned j = 0; j < m_panel->getNumberOfEnclosures(); j++) {
+					if (encElement == m_panel->getGuiEnclosureAt(j)) {
+						enclosureNumberOnPanel = j;
+						break;
+					}
+				}
+				if (enclosureNumberOnPanel != -1) {
+					enclosureNumberOnPanel += 1;
+					thePos.x = GetEnclosureX(enclosureNumberOnPanel);
+				}
+				thePos.y = GetEnclosureY();
+
+				if (encElement->getPosX() != -1) {
+					thePos.x = encElement->getPosX();
+				}
+				if (encElement->getPosY() != -1) {
+					thePos.y = encElement->getPosY();
+				}
+
+				wxRect imgRect(thePos.x, thePos.y, encElement->getWidth(), encElement->getHeight());
+				TileBitmap(imgRect, dc, theBmp, encElement->getTileOffsetX(), encElement->getTileOffsetY());
+
+				if (encElement->getTextBreakWidth()) {
+					wxFont theFont = encElement->getDispLabelFont();
+					int pointSize = theFont.GetPointSize();
+					pointSize *= m_FontScale;
+					theFont.SetPointSize(pointSize);
+					dc.SetFont(theFont);
+					dc.SetBackgroundMode(wxTRANSPARENT);
+					dc.SetTextForeground(encElement->getDispLabelColour()->getColor());
+					wxRect textRect(
+						thePos.x + encElement->getTextRectLeft(),
+						thePos.y + encElement->getTextRectTop(),
+						encElement->getTextRectWidth(),
+						encElement->getTextRectHeight()
+					);
+					wxString textToDisplay;
+					if (encElement->getDispLabelText() != wxEmptyString)
+						textToDisplay = encElement->getDispLabelText();
+					else
+						textToDisplay = encElement->getElementName();
+					if (encElement->getDispLabelText() == wxEmptyString) {
+						if (textToDisplay.IsSameAs(wxT("Swell")))
+							textToDisplay = wxT("Crescendo");
+					}
+					dc.DrawLabel(BreakTextLine(textToDisplay, encElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_HORIZONTAL);
+				}
+				if (guiObjects) {
+					GUI_OBJECT theEnclosure;
+					theEnclosure.element = encElement;
+					theEnclosure.img = NULL;
+					theEnclosure.boundingRect = wxRect(thePos.x, thePos.y, encElement->getWidth(), encElement->getHeight());
+					theEnclosure.isSelected = false;
+					guiObjects->push_back(theEnclosure);
+				}
+
+				continue;
+			}
+			GUILabel *labelElement = dynamic_cast<GUILabel*>(guiElement);
+			if (labelElement) {
+				int xPosToUse = 0;
+				if (labelElement->isFreeXPlacement()) {
+					// the label uses absolute x positioning either via m_dispXpos or m_positionX
+					if (labelElement->getPosX() >= 0)
+						xPosToUse = labelElement->getPosX();
+					else
+						xPosToUse = labelElement->getDispXpos();
+				} else {
+					// the label uses the default layout model for x positioning
+					int drawstopsPerJamb = m_panel->getDisplayMetrics()->m_dispDrawstopCols / 2;
+					if (labelElement->isDispSpanDrawstopColToRight())
+						xPosToUse = 39;
+					if (labelElement->getDispDrawstopCol() <= drawstopsPerJamb)
+						xPosToUse = xPosToUse + (labelElement->getDispDrawstopCol() - 1) * 78 + 1;
+					else
+						xPosToUse = -(xPosToUse + (labelElement->getDispDrawstopCol() - 1 - drawstopsPerJamb) * 78 + 1);
+
+					if (xPosToUse >= 0)
+						xPosToUse = GetJambLeftX() + xPosToUse;
+					else
+						xPosToUse = GetJambRightX() - xPosToUse;
+				}
+
+				int yPosToUse = 0;
+				if (labelElement->isFreeYPlacement()) {
+					// the label uses absolute y positioning either via m_dispYpos or m_positionY
+					if (labelElement->getPosY() >= 0)
+						yPosToUse = labelElement->getPosY();
+					else
+						yPosToUse = labelElement->getDispYpos();
+				} else {
+					// the label uses default layout model for y positioning
+					yPosToUse = 1;
+					if (!labelElement->isDispAtTopOfDrawstopCol())
+						yPosToUse += -32;
+
+					if (yPosToUse >= 0)
+						yPosToUse = GetJambLeftRightY() + 1;
+					else
+						yPosToUse = GetJambLeftRightY() + 1 + GetJambLeftRightHeight() - 32;
+				}
+
+				if (theBmp.IsOk()) { // @suppress("Method cannot be resolved")
+					wxRect imgRect(xPosToUse, yPosToUse, labelElement->getWidth(), labelElement->getHeight());
+					TileBitmap(imgRect, dc, theBmp, labelElement->getTileOffsetX(), labelElement->getTileOffsetY());
+				}
+
+				if (labelElement->getTextBreakWidth() && labelElement->getName() != wxEmptyString) {
+					wxFont theFont = labelElement->getDispLabelFont();
+					int pointSize = theFont.GetPointSize();
+					pointSize *= m_FontScale;
+					theFont.SetPointSize(pointSize);
+					dc.SetFont(theFont);
+					dc.SetBackgroundMode(wxTRANSPARENT);
+					dc.SetTextForeground(labelElement->getDispLabelColour()->getColor());
+					wxRect textRect(
+						xPosToUse + labelElement->getTextRectLeft(),
+						yPosToUse + labelElement->getTextRectTop(),
+						labelElement->getTextRectWidth(),
+						labelElement->getTextRectHeight()
+					);
+					dc.DrawLabel(BreakTextLine(labelElement->getName(), labelElement->getTextBreakWidth(), dc), textRect, wxALIGN_CENTER_VERTICAL | wxALIGN_CENTER_HORIZONTAL);
+				}
+				if (guiObjects) {
+					GUI_OBJECT theLabel;
+					theLabel.element = labelElement;
+					theLabel.img = NULL;
+					theLabel.boundingRect = wxRect(xPosToUse, yPosToUse, labelElement->getWidth(), labelElement->getHeight());
+					theLabel.isSelected = false;
+					guiObjects->push_back(theLabel);
+				}
+			}
+		}
+	}
+}
+
+void PanelRenderer::GetImageFiles(std::vector<std::pair<wxString, wxString>> &files) {
+	for (unsigned i = 0; i < m_panel->getNumberOfImages(); i++) {
+		GoImage *img = m_panel->getImageAt(i);
+		files.push_back(std::make_pair(img->getImage(), img->getMask()));
+	}
+	for (unsigned i = 0; i < m_panel->getNumberOfManuals(); i++) {
+		GUIManual *manual = m_panel->getGuiManualAt(i);
+		for (unsigned j = 0; j < manual->getNumberOfKeytypes(); j++) {
+			KEYTYPE *key = manual->getKeytypeAt(j);
+			files.push_back(std::make_pair(key->ImageOff.getImage(), key->ImageOff.getMask()));
+		}
+	}
+	for (unsigned i = 0; i < (unsigned) m_panel->getNumberOfGuiElements(); i++) {
+		GUIElement *guiElement = m_panel->getGuiElementAt(i);
+		GUIButton *btnElement = dynamic_cast<GUIButton*>(guiElement);
+		GUIEnclosure *encElement = dynamic_cast<GUIEnclosure*>(guiElement);
+		GUILabel *labelElement = dynamic_cast<GUILabel*>(guiElement);
+		if (btnElement) {
+			files.push_back(std::make_pair(btnElement->getImageOff(), wxString(wxEmptyString)));
+		} else if (encElement && encElement->getNumberOfBitmaps() > 0) {
+			GoImage *img = encElement->getBitmapAtIndex(0);
+			files.push_back(std::make_pair(img->getImage(), img->getMask()));
+		} else if (labelElement) {
+			files.push_back(std::make_pair(labelElement->getImage()->getImage(), labelElement->getImage()->getMask()));
+		}
+	}
+}
+
+void PanelRenderer::TileBitmap(wxRect rect, wxDC& dc, wxBitmap& bitmap, int tileOffsetX, int tileOffsetY) {
+	TraceScope trace("TileBitmap");
+	wxImage bmp = bitmap.ConvertToImage();
+	// a scaled down rendering (the thumbnails) scales the tile once and tiles
+	// at the device size instead of tiling the full size and scaling that
+	double scaleX = 1.0;
+	double scaleY = 1.0;
+	dc.GetUserScale(&scaleX, &scaleY);
+	bool isScaled = (scaleX < 1.0 || scaleY < 1.0) && bmp.IsOk();
+	if (isScaled) {
+		bmp = bmp.Scale(std::max(1, (int) (bmp.GetWidth() * scaleX)), std::max(1, (int) (bmp.GetHeight() * scaleY)));
+		tileOffsetX = (int) (tileOffsetX * scaleX);
+		tileOffsetY = (int) (tileOffsetY * scaleY);
+		rect = wxRect(
+			dc.LogicalToDeviceX(rect.x),
+			dc.LogicalToDeviceY(rect.y),
+			std::max(1, (int) (rect.width * scaleX)),
+			std::max(1, (int) (rect.height * scaleY))
+		);
+	}
+	int w = bmp.GetWidth();
+	int h = bmp.GetHeight();
+
+	wxImage wholeImg(rect.width, rect.height);
+	for (int i = -tileOffsetX; i < rect.width; i += w) {
+		for (int j = -tileOffsetY; j < rect.height; j += h) {
+			wholeImg.Paste(bmp, i, j);
+		}
+	}
+	if (!wholeImg.IsOk())
+		return;
+
+	wxBitmap fullBmp = wxBitmap(wholeImg);
+
+	if (isScaled) {
+		dc.SetUserScale(1.0, 1.0);
+		dc.DrawBitmap(fullBmp, dc.DeviceToLogicalX(rect.x), dc.DeviceToLogicalY(rect.y), true);
+		dc.SetUserScale(scaleX, scaleY);
+	} else {
+		dc.DrawBitmap(fullBmp, rect.x, rect.y, true);
+	}
+}
+
+wxPoint PanelRenderer::GetDrawstopPosition(int row, int col) {
+	wxPoint position;
+	int i;
+	if (row > 99) {
+		position.x = GetJambTopX() + (col - 1) * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
+		if (m_panel->getDisplayMetrics()->m_dispExtraDrawstopRowsAboveExtraButtonRows) {
+			position.y = GetJambTopDrawstop() + (row - 100) * m_panel->getDisplayMetrics()->m_dispDrawstopHeight + 2;
+		} else {
+			position.y = GetJambTopDrawstop() + (row - 100) * m_panel->getDisplayMetrics()->m_dispDrawstopHeight + (m_panel->getDisplayMetrics()->m_dispExtraButtonRows * m_panel->getDisplayMetrics()->m_dispPistonHeight) + 2;
+		}
+	} else {
+		i = m_panel->getDisplayMetrics()->m_dispDrawstopCols >> 1;
+		if (col <= i) {
+			position.x = GetJambLeftX() + (col - 1) * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
+			position.y = GetJambLeftRightY() + (row - 1) * m_panel->getDisplayMetrics()->m_dispDrawstopHeight + 32;
+		} else {
+			position.x = GetJambRightX() + (col - 1 - i) * m_panel->getDisplayMetrics()->m_dispDrawstopWidth + 6;
+			position.y = GetJambLeftRightY() + (row - 1) * m_panel->getDisplayMetrics()->m_dispDrawstopHeight + 32;
+		}
+		if (m_panel->getDisplayMetrics()->m_dispPairDrawstopCols)
+			position.x += (((col - 1) % i) >> 1) * (m_panel->getDisplayMetrics()->m_dispDrawstopWidth / 4);
+
+		if (col <= i)
+			i = col;
+		else
+			i = m_panel->getDisplayMetrics()->m_dispDrawstopCols - col + 1;
+		if (m_panel->getDisplayMetrics()->m_dispDrawstopColsOffset && ((i & 1) ^ m_panel->getDisplayMetrics()->m_dispDrawstopOuterColOffsetUp))
+			position.y += m_panel->getDisplayMetrics()->m_dispDrawstopHeight / 2;
+	}
+	return position;
+}
+
+wxPoint PanelRenderer::GetPushbuttonPosition(int row, int col) {
+	wxPoint position;
+	position.x = GetPistonX() + (col - 1) * m_panel->getDisplayMetrics()->m_dispPistonWidth + 6;
+	if (row > 99) {
+		if (m_panel->getDisplayMetrics()->m_dispExtraDrawstopRowsAboveExtraButtonRows) {
+			position.y = GetJambTopPiston() + (row - 100) * m_panel->getDisplayMetrics()->m_dispPistonHeight + (m_panel->getDisplayMetrics()->m_dispExtraDrawstopRows * m_panel->getDisplayMetrics()->m_dispDrawstopHeight) + 5;
+		} else {
+			position.y = GetJambTopPiston() + (row - 100) * m_panel->getDisplayMetrics()->m_dispPistonHeight + 5;
+		}
+	} else {
+		int i = row;
+		if (i == 99)
+			i = 0;
+
+		if (i > (int) m_panel->getNumberOfManuals())
+			position.y = GetHackY() - (i + 1 - (int) m_panel->getNumberOfManuals()) * (m_panel->getDisplayMetrics()->m_dispManualHeight + m_panel->getDisplayMetrics()->m_dispPistonHeight) + m_panel->getDisplayMetrics()->m_dispManualHeight + 5;
+		else {
+			if (!m_panel->getHasPedals() && i > 0)
+				position.y = m_panel->getGuiManualAt(i - 1)->m_renderInfo.piston_y + 5;
+			else
+				position.y = m_panel->getGuiManualAt(i)->m_renderInfo.piston_y + 5;
+		}
+
+		if (m_panel->getDisplayMetrics()->m_dispExtraPedalButtonRow && !row)
+			position.y += m_panel->getDisplayMetrics()->m_dispPistonHeight;
+		if (m_panel->getDisplayMetrics()->m_dispExtraPedalButtonRowOffset && row == 99)
+			position.x -= m_panel->getDisplayMetrics()->m_dispPistonWidth / 2 + 2;
+	}
+	return position;
+}
+
+unsigned PanelRenderer::GetEnclosuresWidth() {
+	return m_panel->getDisplayMetrics()->m_dispEnclosureWidth * m_panel->getNumberOfEnclosures();
+}
+
+int PanelRenderer::GetEnclosureY() {
+	return m_EnclosureY;
+}
+
+int PanelRenderer::GetEnclosureX(int enclosureNbr) {
+	int enclosure_x = (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetEnclosuresWidth() + 6) >> 1;
+	enclosure_x += m_panel->getDisplayMetrics()->m_dispEnclosureWidth * (enclosureNbr - 1);
+
+	return enclosure_x;
+}
+
+int PanelRenderer::GetJambLeftRightWidth() {
+	int jamblrw = m_panel->getDisplayMetrics()->m_dispDrawstopCols * m_panel->getDisplayMetrics()->m_dispDrawstopWidth / 2;
+	if (m_panel->getDisplayMetrics()->m_dispPairDrawstopCols)
+		jamblrw += ((m_panel->getDisplayMetrics()->m_dispDrawstopCols >> 2) * (m_panel->getDisplayMetrics()->m_dispDrawstopWidth / 4)) - 8;
+	return jamblrw;
+}
+
+unsigned PanelRenderer::GetJambLeftRightHeight() {
+	return (m_panel->getDisplayMetrics()->m_dispDrawstopRows + 1) * m_panel->getDisplayMetrics()->m_dispDrawstopHeight;
+}
+
+int PanelRenderer::GetJambLeftRightY() {
+	return ((int)(m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() - GetJambLeftRightHeight() - (m_panel->getDisplayMetrics()->m_dispDrawstopColsOffset ? (m_panel->getDisplayMetrics()->m_dispDrawstopHeight / 2) : 0))) / 2;
+}
+
+int PanelRenderer::GetJambLeftX() {
+	int jamblx = (GetCenterX() - GetJambLeftRightWidth()) >> 1;
+	if (m_panel->getDisplayMetrics()->m_dispPairDrawstopCols)
+		jamblx += 5;
+	return jamblx;
+}
+
+int PanelRenderer::GetJambRightX() {
+	int jambrx = GetJambLeftX() + GetCenterX() + GetCenterWidth();
+	if (m_panel->getDisplayMetrics()->m_dispPairDrawstopCols)
+		jambrx += 5;
+	return jambrx;
+}
+
+int PanelRenderer::GetJambTopDrawstop() {
+	if (m_panel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
+		return GetCenterY() + 8;
+	return GetCenterY();
+}
+
+int PanelRenderer::GetJambTopPiston() {
+	if (m_panel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
+		return GetCenterY() + 8;
+	return GetCenterY();
+}
+
+unsigned PanelRenderer::GetJambTopHeight() {
+	return m_panel->getDisplayMetrics()->m_dispExtraDrawstopRows * m_panel->getDisplayMetrics()->m_dispDrawstopHeight;
+}
+
+unsigned PanelRenderer::GetJambTopWidth() {
+	return m_panel->getDisplayMetrics()->m_dispExtraDrawstopCols * m_panel->getDisplayMetrics()->m_dispDrawstopWidth;
+}
+
+int PanelRenderer::GetJambTopX() {
+	return (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetJambTopWidth()) >> 1;
+}
+
+int PanelRenderer::GetJambTopY() {
+	if (m_panel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
+		return GetCenterY() + 8;
+	return GetCenterY();
+}
+
+unsigned PanelRenderer::GetPistonTopHeight() {
+	return m_panel->getDisplayMetrics()->m_dispExtraButtonRows * m_panel->getDisplayMetrics()->m_dispPistonHeight;
+}
+
+unsigned PanelRenderer::GetPistonWidth() {
+	return m_panel->getDisplayMetrics()->m_dispButtonCols * m_panel->getDisplayMetrics()->m_dispPistonWidth;
+}
+
+int PanelRenderer::GetPistonX() {
+	return (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetPistonWidth()) >> 1;
+}
+
+int PanelRenderer::GetCenterWidth() {
+	return m_CenterWidth;
+}
+
+int PanelRenderer::GetCenterY() {
+	return m_CenterY;
+}
+
+int PanelRenderer::GetCenterX() {
+	return (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - GetCenterWidth()) >> 1;
+}
+
+int PanelRenderer::GetHackY() {
+	return m_HackY;
+}
+
+void PanelRenderer::UpdateLayout() {
+	m_CenterY = m_panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue() - m_panel->getDisplayMetrics()->m_dispPedalHeight;
+	m_CenterWidth = std::max(GetJambTopWidth(), GetPistonWidth());
+
+	unsigned nbrManuals = m_panel->getNumberOfManuals();
+	if (!nbrManuals)
+		nbrManuals = 1;
+	for (unsigned i = 0; i < nbrManuals; i++) {
+		GUIManual *theManual = m_panel->getGuiManualAt(i);
+		if (!i && theManual && m_panel->getHasPedals()) {
+			// this is the first manual (and a real one) on the panel and it should be a pedal
+			theManual->m_renderInfo.height = m_panel->getDisplayMetrics()->m_dispPedalHeight;
+			theManual->m_renderInfo.keys_y = theManual->m_renderInfo.y = m_CenterY;
+			m_CenterY -= m_panel->getDisplayMetrics()->m_dispPedalHeight;
+			if (m_panel->getDisplayMetrics()->m_dispExtraPedalButtonRow)
+				m_CenterY -= m_panel->getDisplayMetrics()->m_dispPistonHeight;
+			theManual->m_renderInfo.piston_y = m_CenterY;
+			m_CenterWidth = std::max(m_CenterWidth, (int)GetEnclosuresWidth());
+			m_CenterY -= 12;
+			m_CenterY -= m_panel->getDisplayMetrics()->m_dispEnclosureHeight;
+			m_EnclosureY = m_CenterY;
+			m_CenterY -= 12;
+		}
+		if (!i && !m_panel->getHasPedals() && m_panel->getNumberOfEnclosures()) {
+			// this is if there's no pedal on the panel but there are enclosures
+			m_CenterY -= 12;
+			m_CenterY -= m_panel->getDisplayMetrics()->m_dispEnclosureHeight;
+			m_EnclosureY = m_CenterY;
+			m_CenterY -= 12;
+		}
+
+		if (!theManual)
+			continue;
+
+		if (i || (i == 0 && !m_panel->getHasPedals())) {
+			if (!m_panel->getDisplayMetrics()->m_dispButtonsAboveManuals) {
+				m_CenterY -= m_panel->getDisplayMetrics()->m_dispPistonHeight;
+				theManual->m_renderInfo.piston_y = m_CenterY;
+			}
+			theManual->m_renderInfo.height = m_panel->getDisplayMetrics()->m_dispManualHeight;
+			if (m_panel->getDisplayMetrics()->m_dispTrimBelowManuals && (i == 1 || (i == 0 && !m_panel->getHasPedals()))) {
+				theManual->m_renderInfo.height += 8;
+				m_CenterY -= 8;
+			}
+			m_CenterY -= m_panel->getDisplayMetrics()->m_dispManualHeight;
+			theManual->m_renderInfo.keys_y = m_CenterY;
+			if (m_panel->getDisplayMetrics()->m_dispTrimAboveManuals && i + 1 == m_panel->getNumberOfManuals()) {
+				m_CenterY -= 8;
+				theManual->m_renderInfo.height += 8;
+			}
+			if (m_panel->getDisplayMetrics()->m_dispButtonsAboveManuals) {
+				m_CenterY -= m_panel->getDisplayMetrics()->m_dispPistonHeight;
+				theManual->m_renderInfo.piston_y = m_CenterY;
+			}
+			theManual->m_renderInfo.y = m_CenterY;
+		}
+
+		theManual->m_renderInfo.width = 1;
+		if (i || (i == 0 && !m_panel->getHasPedals())) {
+			// this calculates the total width of a manual keyboard by adding the natural widths
+			int startingMidiNbr = theManual->getDisplayFirstNote();
+			for (int j = 0; j < theManual->getNumberOfDisplayKeys(); j++) {
+				int key_nbr = startingMidiNbr + j;
+				if (((key_nbr % 12) < 5 && !(key_nbr & 1)) || ((key_nbr % 12) >= 5 && (key_nbr & 1))) {
+					theManual->m_renderInfo.width += m_panel->getDisplayMetrics()->m_dispManualKeyWidth;
+				}
+			}
+		} else {
+			// this calculates the total width of a pedal
+			int startingMidiNbr = theManual->getDisplayFirstNote();
+			for (int j = 0; j < theManual->getNumberOfDisplayKeys(); j++) {
+				int key_nbr = startingMidiNbr + j;
+				theManual->m_renderInfo.width += m_panel->getDisplayMetrics()->m_dispPedalKeyWidth;
+				if (j && (key_nbr % 12 == 4 || key_nbr % 12 == 11))
+					theManual->m_renderInfo.width += m_panel->getDisplayMetrics()->m_dispPedalKeyWidth;
+			}
+		}
+		theManual->m_renderInfo.x = (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - theManual->m_renderInfo.width) >> 1;
+		theManual->m_renderInfo.width += 16;
+		if ((int)theManual->m_renderInfo.width > m_CenterWidth)
+			m_CenterWidth = theManual->m_renderInfo.width;
+	}
+
+	m_HackY = m_CenterY;
+
+	if (m_CenterWidth + GetJambLeftRightWidth() * 2 < m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue())
+		m_CenterWidth += (m_panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue() - m_CenterWidth - GetJambLeftRightWidth() * 2) / 3;
+
+	m_CenterY -= GetPistonTopHeight();
+	m_CenterY -= GetJambTopHeight();
+	if (m_panel->getDisplayMetrics()->m_dispTrimAboveExtraRows)
+		m_CenterY -= 8;
+}
+
+wxString PanelRenderer::BreakTextLine(wxString text, int textBreakWidth, wxDC& dc) {
+	wxString string = text;
+	wxString str, line, work;
+	wxCoord cx, cy;
+
+	/* text.Length() + 1 iterations */
+	for (unsigned i = 0; i <= string.Length(); i++) {
+		bool maybreak = false;
+		if (string[i] == wxT(' ') || string[i] == wxT('\n')) {
+			if (work.length() < 2)
+				maybreak = false;
+			else
+				maybreak = true;
+		}
+		if (maybreak || i == string.Length()) {
+			if (!work.Length())
+				continue;
+			dc.GetTextExtent(line + wxT(' ') + work, &cx, &cy);
+			if (cx > textBreakWidth) {
+				if (!str.Length())
+					str = line;
+				else
+					str = str + wxT('\n') + line;
+				line = wxT("");
+			}
+
+			if (!line.Length())
+				line = work;
+			else
+				line = line + wxT(' ') + work;
+
+			work = wxT("");
+		} else {
+			if (string[i] == wxT(' ') || string[i] == wxT('\n')) {
+				if (work.Length() && work[work.Length() - 1] != wxT(' '))
+					work += wxT(' ');
+			} else
+				work += string[i];
+		}
+	}
+
+	if (!str.Length())
+		str = line;
+	else
+		str = str + wxT('\n') + line;
+	return str;
+}
+
+void PanelRenderer::InitFont() {
+	// an explicit face as in DisplayMetrics, the system font isn't available
+	// in goodf-cli that doesn't set up the gui toolkit
+	wxMemoryDC dc;
+	wxFont font = wxFont(wxFontInfo(39).FaceName(wxT("Arial")));
+	wxCoord cx, cy;
+	dc.SetFont(font);
+	dc.GetTextExtent(wxT("M"), &cx, &cy);
+	m_FontScale = 62.0 / cy;
+}
+
+wxBitmap PanelRenderer::RenderToBitmap(const wxColour &background, double scale) {
+	TraceScope trace("PanelRenderer::RenderToBitmap", m_panel->getName());
+	wxBitmap bmp(std::max(1, (int) (GetPanelWidth() * scale)), std::max(1, (int) (GetPanelHeight() * scale)));
+	if (!bmp.IsOk())
+		return wxNullBitmap;
+	wxMemoryDC dc(bmp);
+	dc.SetBackground(wxBrush(background));
+	dc.Clear();
+	dc.SetUserScale(scale, scale);
+	Render(dc);
+	dc.SelectObject(wxNullBitmap);
+	return bmp;
+}
+
+bool PanelRenderer::ExportToPng(const wxString &filePath) {
+	wxBitmap bmp = RenderToBitmap();
+	if (!bmp.IsOk())
+		return false;
+	return bmp.ConvertToImage().SaveFile(filePath, wxBITMAP_TYPE_PNG);
+}
@@ -0,0 +1,95 @@
+/*
+ * PanelRenderer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PANELRENDERER_H
+#define PANELRENDERER_H
+
+#include <wx/wx.h>
+#include "GoPanel.h"
+#include <vector>
+#include <utility>
+
+struct GUI_OBJECT {
+	GUIElement *element;
+	GoImage *img;
+	wxRect boundingRect;
+	bool isSelected;
+};
+
+// Lays out a panel the way GrandOrgue does and draws it at full size onto any
+// wxDC, so that the same drawing is used by the panel representation window
+// and for exporting panels to image files without any window. Drawing with a
+// wxDC must be done on the main thread.
+class PanelRenderer {
+public:
+	PanelRenderer(GoPanel *panel);
+	~PanelRenderer();
+
+	GoPanel* GetPanel();
+	int GetPanelWidth();
+	int GetPanelHeight();
+	// must be called when the display metrics or the manuals of the panel change
+	void UpdateLayout();
+	// if guiObjects is given the elements that can be selected are added to it
+	void Render(wxDC& dc, std::vector<GUI_OBJECT> *guiObjects = NULL);
+	// a scale below 1 draws the panel directly at the smaller size
+	wxBitmap RenderToBitmap(const wxColour &background = *wxBLACK, double scale = 1.0);
+	bool ExportToPng(const wxString &filePath);
+	// the image and mask files the panel is drawn with, empty names included
+	void GetImageFiles(std::vector<std::pair<wxString, wxString>> &files);
+
+private:
+	GoPanel *m_panel;
+	int m_HackY;
+	int m_EnclosureY;
+	int m_CenterY;
+	int m_CenterWidth;
+	double m_FontScale;
+
+	wxPoint GetDrawstopPosition(int row, int col);
+	wxPoint GetPushbuttonPosition(int row, int col);
+	unsigned GetEnclosuresWidth();
+	int GetEnclosureY();
+	int GetEnclosureX(int enclosureNbr);
+	int GetJambLeftRightWidth();
+	unsigned GetJambLeftRightHeight();
+	int GetJambLeftRightY();
+	int GetJambLeftX();
+	int GetJambRightX();
+	int GetJambTopDrawstop();
+	int GetJambTopPiston();
+	unsigned GetJambTopHeight();
+	unsigned GetJambTopWidth();
+	int GetJambTopX();
+	int GetJambTopY();
+	unsigned GetPistonTopHeight();
+	unsigned GetPistonWidth();
+	int GetPistonX();
+	int GetCenterWidth();
+	int GetCenterY();
+	int GetCenterX();
+	int GetHackY();
+
+	void TileBitmap(wxRect rect, wxDC& dc, wxBitmap& bitmap, int tileOffsetX, int tileOffsetY);
+	wxString BreakTextLine(wxString text, int textBreakWidth, wxDC& dc);
+	void InitFont();
+};
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * PanelThumbnailCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PanelThumbnailCache.h"
+#include "GOODF.h"
+#include "PanelRenderer.h"
+#include "DecodedImageCache.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cstring>
+
+// the pause between rendering two panels lets the editor handle its events
+static const int RENDER_INTERVAL = 20;
+
+PanelThumbnailCache::PanelThumbnailCache(wxEvtHandler *owner, int eventId, int renderTimerId, int listenerEventId) {
+	m_owner = owner;
+	m_eventId = eventId;
+	m_listenerEventId = listenerEventId;
+	m_renderTimer = new wxTimer(owner, renderTimerId);
+	m_generation = 0;
+	m_stop = false;
+	m_worker = std::thread(&PanelThumbnailCache::processJobs, this);
+}
+
+PanelThumbnailCache::~PanelThumbnailCache() {
+	m_renderTimer->Stop();
+	delete m_renderTimer;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		m_jobs.clear();
+	}
+	m_condition.notify_all();
+	m_worker.join();
+}
+
+wxBitmap PanelThumbnailCache::fitToSize(const wxBitmap &thumbnail, const wxSize &size) {
+	wxImage fitted(size.GetWidth(), size.GetHeight());
+	fitted.InitAlpha();
+	memset(fitted.GetAlpha(), 0, (size_t) size.GetWidth() * size.GetHeight());
+	if (thumbnail.IsOk()) {
+		double scale = std::min((double) size.GetWidth() / thumbnail.GetWidth(), (double) size.GetHeight() / thumbnail.GetHeight());
+		int width = std::max(1, (int) (thumbnail.GetWidth() * scale));
+		int height = std::max(1, (int) (thumbnail.GetHeight() * scale));
+		wxImage scaled = thumbnail.ConvertToImage().Scale(width, height, wxIMAGE_QUALITY_HIGH);
+		fitted.Paste(scaled, (size.GetWidth() - width) / 2, (size.GetHeight() - height) / 2);
+	}
+	return wxBitmap(fitted);
+}
+
+bool PanelThumbnailCache::getThumbnail(GoPanel *panel, wxBitmap &bmp) {
+	auto found = m_thumbnails.find(panel);
+	bool isUpToDate = false;
+	if (found != m_thumbnails.end()) {
+		bmp = found->second.bitmap;
+		isUpToDate = found->second.revision == panel->getRevision();
+	}
+	if (!isUpToDate && m_queuedPanels.find(panel) == m_queuedPanels.end()) {
+		m_queuedPanels.insert(panel);
+		m_renderQueue.push_back(panel);
+		startRenderTimer();
+	}
+	return found != m_thumbnails.end();
+}
+
+void PanelThumbnailCache::renderNext() {
+	// panels whose images are decoded are drawn first
+	if (!m_decodedPanels.empty()) {
+		GoPanel *panel = m_decodedPanels.front();
+		m_decodedPanels.pop_front();
+		drawPanel(panel);
+	} else if (!m_renderQueue.empty()) {
+		// the most recently asked for panels are the ones the user is looking for
+		GoPanel *panel = m_renderQueue.back();
+		m_renderQueue.pop_back();
+		decodeImages(panel);
+	}
+
+	if (!m_renderQueue.empty() || !m_decodedPanels.empty())
+		m_renderTimer->Start(RENDER_INTERVAL, wxTIMER_ONE_SHOT);
+}
+
+void PanelThumbnailCache::collectFinished() {
+	std::deque<THUMBNAIL_JOB> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		finished.swap(m_finished);
+	}
+	bool isAnyUpdated = false;
+	for (THUMBNAIL_JOB &job : finished) {
+		// results of cancelled requests or of panels removed meanwhile are dropped
+		if (job.generation != m_generation)
+			continue;
+		if (!isPanelInOrgan(job.panel)) {
+			m_queuedPanels.erase(job.panel);
+			m_thumbnails.erase(job.panel);
+			continue;
+		}
+		if (job.isDecoding) {
+			m_decodedPanels.push_back(job.panel);
+			startRenderTimer();
+			continue;
+		}
+		m_queuedPanels.erase(job.panel);
+		if (job.scaled.IsOk()) {
+			PANEL_THUMBNAIL thumbnail;
+			thumbnail.bitmap = wxBitmap(job.scaled);
+			thumbnail.revision = job.revision;
+			m_thumbnails[job.panel] = thumbnail;
+			isAnyUpdated = true;
+		}
+	}
+	if (!isAnyUpdated)
+		return;
+	for (wxEvtHandler *listener : m_listeners)
+		wxQueueEvent(listener, new wxThreadEvent(wxEVT_THREAD, m_listenerEventId));
+}
+
+void PanelThumbnailCache::cancel() {
+	m_renderTimer->Stop();
+	m_generation++;
+	m_renderQueue.clear();
+	m_decodedPanels.clear();
+	m_queuedPanels.clear();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs.clear();
+}
+
+void PanelThumbnailCache::clear() {
+	cancel();
+	m_thumbnails.clear();
+}
+
+void PanelThumbnailCache::addListener(wxEvtHandler *listener) {
+	m_listeners.push_back(listener);
+}
+
+void PanelThumbnailCache::removeListener(wxEvtHandler *listener) {
+	m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+}
+
+bool PanelThumbnailCache::isPanelInOrgan(GoPanel *panel) {
+	Organ *organ = ::wxGetApp().m_frame->m_organ;
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+		if (organ->getOrganPanelAt(i) == panel)
+			return true;
+	}
+	return false;
+}
+
+void PanelThumbnailCache::decodeImages(GoPanel *panel) {
+	if (!isPanelInOrgan(panel)) {
+		// the panel has been removed since it was asked for
+		m_queuedPanels.erase(panel);
+		m_thumbnails.erase(panel);
+		return;
+	}
+	THUMBNAIL_JOB job;
+	job.panel = panel;
+	job.revision = panel->getRevision();
+	job.generation = m_generation;
+	job.isDecoding = true;
+	PanelRenderer renderer(panel);
+	renderer.GetImageFiles(job.imageFiles);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+	}
+	m_condition.notify_all();
+}
+
+void PanelThumbnailCache::drawPanel(GoPanel *panel) {
+	if (!isPanelInOrgan(panel)) {
+		m_queuedPanels.erase(panel);
+		m_thumbnails.erase(panel);
+		return;
+	}
+	// the images come from the decoded image cache, so this only draws
+	TraceScope trace("PanelThumbnailCache::renderPanel", panel->getName());
+	THUMBNAIL_JOB job;
+	job.panel = panel;
+	job.revision = panel->getRevision();
+	job.generation = m_generation;
+	job.isDecoding = false;
+	PanelRenderer renderer(panel);
+	double scale = std::min(
+		std::min((double) THUMBNAIL_WIDTH * 2 / renderer.GetPanelWidth(), (double) THUMBNAIL_HEIGHT * 2 / renderer.GetPanelHeight()),
+		1.0
+	);
+	job.source = renderer.RenderToBitmap(*wxBLACK, scale).ConvertToImage();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+		job.source = wxNullImage;
+	}
+	m_condition.notify_all();
+}
+
+void PanelThumbnailCache::startRenderTimer() {
+	if (!m_renderTimer->IsRunning())
+		m_renderTimer->Start(RENDER_INTERVAL, wxTIMER_ONE_SHOT);
+}
+
+void PanelThumbnailCache::processJobs() {
+	while (true) {
+		THUMBNAIL_JOB job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+			if (m_stop)
+				return;
+			job = m_jobs.back();
+			m_jobs.pop_back();
+		}
+
+		if (job.isDecoding) {
+			TraceScope trace("PanelThumbnailCache::decodeImages");
+			for (const std::pair<wxString, wxString> &file : job.imageFiles)
+				DecodedImageCache::prefetch(file.first, file.second);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_finished.push_back(job);
+			}
+			wxQueueEvent(m_owner, new wxThreadEvent(wxEVT_THREAD, m_eventId));
+			continue;
+		}
+
+		wxImage scaled;
+		if (job.source.IsOk()) {
+			TraceScope trace("PanelThumbnailCache::scaleThumbnail");
+			double scale = std::min(
+				std::min((double) THUMBNAIL_WIDTH / job.source.GetWidth(), (double) THUMBNAIL_HEIGHT / job.source.GetHeight()),
+				1.0
+			);
+			int width = std::max(1, (int) (job.source.GetWidth() * scale));
+			int height = std::max(1, (int) (job.source.GetHeight() * scale));
+			scaled = job.source.Scale(width, height, wxIMAGE_QUALITY_HIGH);
+		}
+		job.source = wxNullImage;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			// the image is handed over and not touched by this thread anymore
+			job.scaled = scaled;
+			scaled = wxNullImage;
+			m_finished.push_back(job);
+			job.scaled = wxNullImage;
+		}
+		wxThreadEvent *evt = new wxThreadEvent(wxEVT_THREAD, m_eventId);
+		wxQueueEvent(m_owner, evt);
+	}
+}
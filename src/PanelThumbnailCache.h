@@ -0,0 +1,112 @@
+/*
+ * PanelThumbnailCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PANELTHUMBNAILCACHE_H
+#define PANELTHUMBNAILCACHE_H
+
+#include <wx/wx.h>
+#include <wx/timer.h>
+#include "GoPanel.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+#include <utility>
+
+struct THUMBNAIL_JOB {
+	GoPanel *panel;
+	long revision;
+	unsigned generation;
+	bool isDecoding; // only the image files are decoded, nothing is scaled
+	std::vector<std::pair<wxString, wxString>> imageFiles; // image and mask
+	wxImage source; // rendered at twice the thumbnail size, owned by the job
+	wxImage scaled;
+};
+
+struct PANEL_THUMBNAIL {
+	wxBitmap bitmap;
+	long revision;
+};
+
+// Small previews of the panels of the current organ for the organ tree and
+// the panel pickers. The image files of a panel are first decoded on a worker
+// thread into the DecodedImageCache. Drawing must be done on the gui thread,
+// so the panel is then rendered there from the decoded images, one at a time
+// and at twice the thumbnail size, when the render timer of the owner fires
+// and that is scaled down on the worker thread. Asking for a thumbnail that is
+// missing, or made before the revision of the panel last changed, queues the
+// panel again and until the new one is done getThumbnail() gives the old one
+// if there is one. When a job of the worker is done a wxThreadEvent with the
+// given id is queued to the owner which should then call collectFinished(),
+// that in turn tells the listeners about new thumbnails with a wxThreadEvent
+// of the listener event id.
+class PanelThumbnailCache {
+public:
+	PanelThumbnailCache(wxEvtHandler *owner, int eventId, int renderTimerId, int listenerEventId);
+	~PanelThumbnailCache();
+
+	static const int THUMBNAIL_WIDTH = 240;
+	static const int THUMBNAIL_HEIGHT = 180;
+	// the thumbnail scaled to fit and centered in a bitmap of the given size
+	static wxBitmap fitToSize(const wxBitmap &thumbnail, const wxSize &size);
+
+	// returns false if there is no thumbnail of the panel yet
+	bool getThumbnail(GoPanel *panel, wxBitmap &bmp);
+	// renders the next panel whose images are decoded or queues the decoding
+	// of the next one, called by the owner when the render timer fires
+	void renderNext();
+	void collectFinished();
+	// drops everything queued, what is being rendered is discarded when done
+	void cancel();
+	// must be called when another organ is opened
+	void clear();
+	void addListener(wxEvtHandler *listener);
+	void removeListener(wxEvtHandler *listener);
+
+private:
+	wxEvtHandler *m_owner;
+	int m_eventId;
+	int m_listenerEventId;
+	wxTimer *m_renderTimer;
+	std::map<GoPanel*, PANEL_THUMBNAIL> m_thumbnails;
+	std::deque<GoPanel*> m_renderQueue;
+	std::deque<GoPanel*> m_decodedPanels; // ready to be drawn
+	std::set<GoPanel*> m_queuedPanels;
+	std::vector<wxEvtHandler*> m_listeners;
+	unsigned m_generation;
+
+	std::thread m_worker;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<THUMBNAIL_JOB> m_jobs;
+	std::deque<THUMBNAIL_JOB> m_finished;
+	bool m_stop;
+
+	bool isPanelInOrgan(GoPanel *panel);
+	void decodeImages(GoPanel *panel);
+	void drawPanel(GoPanel *panel);
+	void startRenderTimer();
+	void processJobs();
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * PanelThumbnailPopup.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PanelThumbnailPopup.h"
+#include <wx/display.h>
+#include <algorithm>
+
+static const int POPUP_BORDER = 4;
+
+// Event table
+BEGIN_EVENT_TABLE(PanelThumbnailPopup, wxPopupWindow)
+	EVT_PAINT(PanelThumbnailPopup::OnPaint)
+END_EVENT_TABLE()
+
+PanelThumbnailPopup::PanelThumbnailPopup(wxWindow *parent) : wxPopupWindow(parent, wxBORDER_SIMPLE) {
+	SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_INFOBK));
+}
+
+PanelThumbnailPopup::~PanelThumbnailPopup() {
+
+}
+
+void PanelThumbnailPopup::ShowThumbnail(const wxBitmap &thumbnail, const wxString &title, const wxPoint &screenPos) {
+	m_thumbnail = thumbnail;
+	m_title = title;
+	wxClientDC dc(this);
+	dc.SetFont(GetFont());
+	wxSize textSize = dc.GetTextExtent(m_title);
+	wxSize size(
+		std::max(m_thumbnail.GetWidth(), textSize.GetWidth()) + 2 * POPUP_BORDER,
+		m_thumbnail.GetHeight() + textSize.GetHeight() + 3 * POPUP_BORDER
+	);
+	SetClientSize(size);
+
+	// placed below and to the right of the mouse, but kept on the display
+	wxPoint pos = screenPos + wxPoint(16, 16);
+	int displayIndex = wxDisplay::GetFromPoint(screenPos);
+	if (displayIndex != wxNOT_FOUND) {
+		wxRect area = wxDisplay(displayIndex).GetClientArea();
+		wxSize windowSize = GetSize();
+		if (pos.x + windowSize.GetWidth() > area.GetRight())
+			pos.x = screenPos.x - windowSize.GetWidth() - 4;
+		if (pos.y + windowSize.GetHeight() > area.GetBottom())
+			pos.y = screenPos.y - windowSize.GetHeight() - 4;
+	}
+	Move(pos);
+	if (!IsShown())
+		Show();
+	Refresh();
+}
+
+void PanelThumbnailPopup::OnPaint(wxPaintEvent& WXUNUSED(event)) {
+	wxPaintDC dc(this);
+	dc.SetFont(GetFont());
+	dc.SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_INFOTEXT));
+	dc.DrawText(m_title, POPUP_BORDER, POPUP_BORDER);
+	if (m_thumbnail.IsOk())
+		dc.DrawBitmap(m_thumbnail, POPUP_BORDER, dc.GetTextExtent(m_title).GetHeight() + 2 * POPUP_BORDER, true);
+}
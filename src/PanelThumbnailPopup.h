@@ -0,0 +1,45 @@
+/*
+ * PanelThumbnailPopup.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PANELTHUMBNAILPOPUP_H
+#define PANELTHUMBNAILPOPUP_H
+
+#include <wx/wx.h>
+#include <wx/popupwin.h>
+
+// A borderless window showing the thumbnail of a panel next to the mouse
+// while it hovers a panel in the organ tree.
+class PanelThumbnailPopup : public wxPopupWindow {
+public:
+	PanelThumbnailPopup(wxWindow *parent);
+	~PanelThumbnailPopup();
+
+	void ShowThumbnail(const wxBitmap &thumbnail, const wxString &title, const wxPoint &screenPos);
+
+private:
+	DECLARE_EVENT_TABLE()
+
+	wxBitmap m_thumbnail;
+	wxString m_title;
+
+	void OnPaint(wxPaintEvent& event);
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * ParallelTaskRunner.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ParallelTaskRunner.h"
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+ParallelTaskRunner::ParallelTaskRunner(unsigned nbrOfThreads) {
+	if (nbrOfThreads == 0)
+		nbrOfThreads = std::thread::hardware_concurrency();
+	m_nbrOfThreads = std::max(1u, nbrOfThreads);
+}
+
+ParallelTaskRunner::~ParallelTaskRunner() {
+
+}
+
+unsigned ParallelTaskRunner::getNumberOfThreads() {
+	return m_nbrOfThreads;
+}
+
+bool ParallelTaskRunner::run(unsigned nbrOfTasks, std::function<void(unsigned)> task, wxProgressDialog *progress, const wxString &message) {
+	if (nbrOfTasks == 0)
+		return true;
+
+	std::atomic<unsigned> nextTask(0);
+	std::atomic<unsigned> tasksDone(0);
+	std::atomic<bool> aborted(false);
+
+	auto worker = [&]() {
+		while (!aborted) {
+			unsigned index = nextTask++;
+			if (index >= nbrOfTasks)
+				break;
+			task(index);
+			tasksDone++;
+		}
+	};
+
+	unsigned nbrOfWorkers = std::min(m_nbrOfThreads, nbrOfTasks);
+	std::vector<std::thread> workers;
+	workers.reserve(nbrOfWorkers);
+	for (unsigned i = 0; i < nbrOfWorkers; i++)
+		workers.emplace_back(worker);
+
+	if (progress) {
+		progress->SetRange(nbrOfTasks);
+		while (tasksDone < nbrOfTasks && !aborted) {
+			if (!progress->Update(tasksDone, message))
+				aborted = true;
+			else
+				wxMilliSleep(50);
+		}
+	}
+
+	for (std::thread &t : workers)
+		t.join();
+
+	return !aborted;
+}
+
+IoThrottle::IoThrottle(unsigned maxConcurrent) {
+	m_free = std::max(1u, maxConcurrent);
+}
+
+IoThrottle::~IoThrottle() {
+
+}
+
+void IoThrottle::acquire() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this] { return m_free > 0; });
+	m_free--;
+}
+
+void IoThrottle::release() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_free++;
+	}
+	m_condition.notify_one();
+}
+
+IoSlot::IoSlot(IoThrottle &throttle) : m_throttle(throttle) {
+	m_throttle.acquire();
+}
+
+IoSlot::~IoSlot() {
+	m_throttle.release();
+}
@@ -0,0 +1,77 @@
+/*
+ * ParallelTaskRunner.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PARALLELTASKRUNNER_H
+#define PARALLELTASKRUNNER_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+// Runs a number of independent tasks (indexed 0 to nbrOfTasks - 1) on worker
+// threads. The tasks must not touch any GUI objects. The calling thread waits
+// and keeps the optional progress dialog updated, which also allows aborting.
+class ParallelTaskRunner {
+
+public:
+	ParallelTaskRunner(unsigned nbrOfThreads = 0);
+	~ParallelTaskRunner();
+
+	unsigned getNumberOfThreads();
+
+	// returns false if the run was aborted from the progress dialog
+	bool run(unsigned nbrOfTasks, std::function<void(unsigned)> task, wxProgressDialog *progress = NULL, const wxString &message = wxEmptyString);
+
+private:
+	unsigned m_nbrOfThreads;
+};
+
+// Limits how many tasks do file reads or writes at the same time so that many
+// threads don't compete for the same disk, the rest of the work of the tasks
+// runs unthrottled. IoSlot holds one of the slots for its lifetime.
+class IoThrottle {
+
+public:
+	IoThrottle(unsigned maxConcurrent);
+	~IoThrottle();
+
+	void acquire();
+	void release();
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	unsigned m_free;
+};
+
+class IoSlot {
+
+public:
+	IoSlot(IoThrottle &throttle);
+	~IoSlot();
+
+private:
+	IoThrottle &m_throttle;
+};
+
+#endif
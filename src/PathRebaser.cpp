@@ -0,0 +1,109 @@
+/*
+ * PathRebaser.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PathRebaser.h"
+#include <wx/filename.h>
+
+thread_local PathRebaser *PathRebaser::m_activeRebaser = NULL;
+
+PathRebaser::PathRebaser(const wxString &odfRoot) : m_odfRoot(odfRoot) {
+
+}
+
+PathRebaser::~PathRebaser() {
+	if (m_activeRebaser == this)
+		m_activeRebaser = NULL;
+}
+
+PathRebaser* PathRebaser::getActive() {
+	return m_activeRebaser;
+}
+
+void PathRebaser::setActive(PathRebaser *rebaser) {
+	m_activeRebaser = rebaser;
+}
+
+wxString PathRebaser::makeRelative(const wxString &fullPath) {
+	wxString dir;
+	size_t sepPos;
+	if (!splitPath(fullPath, dir, sepPos))
+		return fullPath;
+
+	// pipes of a rank mostly come from the same folder
+	if (dir != m_lastDir) {
+		m_lastPrefix = getRelativePrefix(dir);
+		m_lastDir = dir;
+	}
+	return m_lastPrefix + fullPath.Mid(sepPos + 1);
+}
+
+void PathRebaser::addFile(const wxString &fullPath) {
+	wxString dir;
+	size_t sepPos;
+	if (!splitPath(fullPath, dir, sepPos) || dir == m_lastAddedDir)
+		return;
+	m_directories.insert(dir);
+	m_lastAddedDir = dir;
+}
+
+wxArrayString PathRebaser::getDirectories() {
+	wxArrayString dirs;
+	for (const wxString &dir : m_directories)
+		dirs.Add(dir);
+	return dirs;
+}
+
+bool PathRebaser::isSpecialName(const wxString &path) {
+	return path.IsSameAs(wxT("DUMMY")) || path.StartsWith(wxT("REF:"));
+}
+
+bool PathRebaser::splitPath(const wxString &fullPath, wxString &dir, size_t &sepPos) {
+	if (fullPath == wxEmptyString || isSpecialName(fullPath))
+		return false;
+	sepPos = fullPath.find_last_of(wxFileName::GetPathSeparators());
+	if (sepPos == wxString::npos)
+		return false;
+	dir = fullPath.Mid(0, sepPos);
+	if (dir == wxEmptyString)
+		dir = fullPath.Mid(0, 1);
+	return true;
+}
+
+wxString PathRebaser::getRelativePrefix(const wxString &dir) {
+	auto existing = m_relativeDirs.find(dir);
+	if (existing != m_relativeDirs.end())
+		return existing->second;
+
+	wxFileName dirName = wxFileName::DirName(dir);
+	dirName.MakeRelativeTo(m_odfRoot);
+	wxString prefix = dirName.GetPath();
+	if (prefix.StartsWith(wxFILE_SEP_PATH))
+		prefix.erase(0, 1);
+	else if (prefix.StartsWith(wxT("./")) || prefix.StartsWith(wxT(".\\")))
+		prefix.erase(0, 2);
+	if (prefix == wxT("."))
+		prefix = wxEmptyString;
+	if (prefix != wxEmptyString)
+		prefix += wxFILE_SEP_PATH;
+
+	m_relativeDirs[dir] = prefix;
+	m_directories.insert(dir);
+	return prefix;
+}
@@ -0,0 +1,64 @@
+/*
+ * PathRebaser.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PATHREBASER_H
+#define PATHREBASER_H
+
+#include <wx/wx.h>
+#include <map>
+#include <set>
+
+// Turns full sample paths into paths relative to an .organ file root. Each
+// distinct directory is made relative once and its prefix is reused for every
+// file in it, so moving the root of a large organ doesn't touch the disk.
+// Special "DUMMY" and "REF:" names are returned unchanged. While a rebaser is
+// active GOODF_functions::removeBaseOdfPath uses it.
+class PathRebaser {
+
+public:
+	PathRebaser(const wxString &odfRoot);
+	~PathRebaser();
+
+	static PathRebaser* getActive();
+	static void setActive(PathRebaser *rebaser);
+
+	wxString makeRelative(const wxString &fullPath);
+	// only notes the directory of the file, so that all of them can be listed at once
+	void addFile(const wxString &fullPath);
+	// the distinct directories of the files added or made relative so far
+	wxArrayString getDirectories();
+
+	static bool isSpecialName(const wxString &path);
+
+private:
+	wxString m_odfRoot;
+	std::map<wxString, wxString> m_relativeDirs; // directory -> relative prefix ending with a separator
+	std::set<wxString> m_directories;
+	wxString m_lastDir;
+	wxString m_lastPrefix;
+	wxString m_lastAddedDir;
+
+	static thread_local PathRebaser *m_activeRebaser;
+
+	static bool splitPath(const wxString &fullPath, wxString &dir, size_t &sepPos);
+	wxString getRelativePrefix(const wxString &dir);
+};
+
+#endif
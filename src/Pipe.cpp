@@ -20,6 +20,9 @@
 
 #include "Pipe.h"
 #include "GOODFFunctions.h"
+#include "TraceRecorder.h"
+#include "PathRebaser.h"
+#include "FileExistenceCache.h"
 
 Pipe::Pipe() {
 	isPercussive = false;
@@ -67,7 +70,7 @@ Pipe::~Pipe() {
 
 }
 
-void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
+void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent, int windchestRef) {
 	if (!isFirstAttackRefPath()) {
 		// remove organ base path from output line path
 		wxString relativeFileName = GOODF_functions::removeBaseOdfPath(m_attacks.front().fullPath);
@@ -124,10 +127,8 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 			else
 				outFile->AddLine(pipeNr + wxT("AcceptsRetuning=N"));
 		}
-		if (windchest != parent->getWindchest()) {
-			wxString wcRef = wxString::Format(wxT("%u"), ::wxGetApp().m_frame->m_organ->getIndexOfOrganWindchest(windchest));
-			outFile->AddLine(pipeNr + wxT("WindchestGroup=") + wcRef);
-		}
+		if (windchestRef > -1)
+			outFile->AddLine(pipeNr + wxT("WindchestGroup=") + wxString::Format(wxT("%i"), windchestRef));
 
 		writeAdditionalAttacks(outFile, pipeNr);
 		writeAdditionalReleases(outFile, pipeNr);
@@ -138,6 +139,7 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 }
 
 void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrgan) {
+	TraceScope trace("Pipe::read");
 	wxString cfgBoolValue = cfg->Read(pipeNr + wxT("Percussive"), wxEmptyString);
 	isPercussive = GOODF_functions::parseBoolean(cfgBoolValue, parent->isPercussive());
 	cfgBoolValue = cfg->Read(pipeNr + wxT("HasIndependentRelease"), wxEmptyString);
@@ -473,12 +475,18 @@ void Pipe::writeReleaseXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk)
 		outFile->AddLine(pipeNr + wxT("ReleaseCrossfadeLength=") + wxString::Format(wxT("%i"), atk.releaseCrossfadeLength));
 }
 
-void Pipe::updateRelativePaths() {
+void Pipe::updateRelativePaths(PathRebaser &rebaser, FileExistenceCache *existence) {
 	for (Attack& a : m_attacks) {
-		a.fileName = GOODF_functions::removeBaseOdfPath(a.fullPath);
+		if (existence && !PathRebaser::isSpecialName(a.fullPath) && !existence->fileExists(a.fullPath))
+			a.fileName = a.fullPath;
+		else
+			a.fileName = rebaser.makeRelative(a.fullPath);
 	}
 	for (Release& r : m_releases) {
-		r.fileName = GOODF_functions::removeBaseOdfPath(r.fullPath);
+		if (existence && !PathRebaser::isSpecialName(r.fullPath) && !existence->fileExists(r.fullPath))
+			r.fileName = r.fullPath;
+		else
+			r.fileName = rebaser.makeRelative(r.fullPath);
 	}
 }
 
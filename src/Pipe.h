@@ -30,6 +30,8 @@
 
 class Rank;
 class Organ;
+class PathRebaser;
+class FileExistenceCache;
 
 class Pipe {
 public:
@@ -37,7 +39,8 @@ public:
 	Pipe(const Pipe& p);
 	~Pipe();
 
-	void write(wxTextFile *outFile, wxString pipeNr, Rank *parent);
+	// windchestRef is the one based index of the windchest, or -1 when it is the one of the rank
+	void write(wxTextFile *outFile, wxString pipeNr, Rank *parent, int windchestRef);
 	void read(wxFileConfig *cfg, wxString pipeNr, Rank *parent, Organ *readOrgan);
 	void readAttack(wxFileConfig *cfg, wxString pipeStr, Organ *readOrgan);
 
@@ -56,7 +59,8 @@ public:
 	void writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk);
 	void writeLoopXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk);
 	void writeReleaseXfade(wxTextFile *outFile, wxString pipeNr, Attack &atk);
-	void updateRelativePaths();
+	// with an existence cache files that are missing keep their full path
+	void updateRelativePaths(PathRebaser &rebaser, FileExistenceCache *existence = NULL);
 	void updateRefString();
 	bool isIndependentRelease();
 	void setIndependentRelease(bool independent);
@@ -39,6 +39,7 @@ BEGIN_EVENT_TABLE(PipeLoadingDialog, wxDialog)
 	EVT_CHECKBOX(ID_EXTRACT_KEY_PRESS_TIME_CHECK, PipeLoadingDialog::OnExtractKeyPressTimeCheck)
 	EVT_TEXT(ID_TREMULANT_SUBDIRECTORY_PREFIX_TEXT, PipeLoadingDialog::OnTremSubDirectoryText)
 	EVT_CHECKBOX(ID_LOAD_PIPES_AS_TREMULANT_OFF_CHECK, PipeLoadingDialog::OnLoadPipesTremOffCheck)
+	EVT_TEXT(ID_VELOCITY_SUBDIRECTORY_PREFIX_TEXT, PipeLoadingDialog::OnVelocitySubDirectoryText)
 END_EVENT_TABLE()
 
 PipeLoadingDialog::PipeLoadingDialog(
@@ -52,7 +53,8 @@ PipeLoadingDialog::PipeLoadingDialog(
 	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
 	wxString tremulantFolderPrefix,
-	bool loadPipesTremOff) {
+	bool loadPipesTremOff,
+	wxString velocityFolderPrefix) {
 	Init(
 		nbrOfPipes,
 		startPipe,
@@ -64,7 +66,8 @@ PipeLoadingDialog::PipeLoadingDialog(
 		releaseFolderPrefix,
 		extractKeyPressTime ,
 		tremulantFolderPrefix,
-		loadPipesTremOff
+		loadPipesTremOff,
+		velocityFolderPrefix
 	);
 }
 
@@ -81,6 +84,7 @@ PipeLoadingDialog::PipeLoadingDialog(
 	bool extractKeyPressTime ,
 	wxString tremulantFolderPrefix,
 	bool loadPipesTremOff,
+	wxString velocityFolderPrefix,
 	wxWindowID id,
 	const wxString& caption,
 	const wxPoint& pos,
@@ -97,7 +101,8 @@ PipeLoadingDialog::PipeLoadingDialog(
 		releaseFolderPrefix,
 		extractKeyPressTime ,
 		tremulantFolderPrefix,
-		loadPipesTremOff
+		loadPipesTremOff,
+		velocityFolderPrefix
 	);
 	Create(parent, id, caption, pos, size, style);
 }
@@ -117,7 +122,8 @@ void PipeLoadingDialog::Init(
 	wxString releaseFolderPrefix,
 	bool extractKeyPressTime ,
 	wxString tremulantFolderPrefix,
-	bool loadPipesTremOff) {
+	bool loadPipesTremOff,
+	wxString velocityFolderPrefix) {
 	m_nbrPipesInRank = nbrOfPipes;
 	if (startPipe > 0)
 		m_startingPipe = startPipe;
@@ -154,6 +160,7 @@ void PipeLoadingDialog::Init(
 	m_pipeLoadingStrategies.Add(wxT("Add release samples to pipe(s)"));
 	m_loadingStrategy = 0;
 	m_loadPipesTremOff = loadPipesTremOff;
+	m_velocityFolderPrefix = velocityFolderPrefix;
 }
 
 bool PipeLoadingDialog::Create(
@@ -394,6 +401,25 @@ void PipeLoadingDialog::CreateControls() {
 	ninthRow->Add(m_loadPipesTremulantOffCheck, 0, wxALL, 5);
 	mainSizer->Add(ninthRow, 0, wxGROW);
 
+	wxBoxSizer *tenthRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *velocityFolderText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Velocity layer sub-directory prefix: ")
+	);
+	tenthRow->Add(velocityFolderText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_velocityPrefixField = new wxTextCtrl(
+		this,
+		ID_VELOCITY_SUBDIRECTORY_PREFIX_TEXT,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_velocityPrefixField->SetToolTip(wxT("Folders like 'vel 64' are loaded as attacks with AttackVelocity 64, leave empty to not load velocity layers"));
+	tenthRow->Add(m_velocityPrefixField, 1, wxEXPAND|wxALL, 5);
+	m_velocityPrefixField->ChangeValue(m_velocityFolderPrefix);
+	mainSizer->Add(tenthRow, 0, wxGROW);
+
 	wxStaticLine *bottomDivider = new wxStaticLine(this);
 	mainSizer->Add(bottomDivider, 0, wxEXPAND);
 
@@ -467,6 +493,10 @@ bool PipeLoadingDialog::GetLoadPipesTremOff() {
 	return m_loadPipesTremOff;
 }
 
+wxString PipeLoadingDialog::GetVelocityFolderPrefix() {
+	return m_velocityFolderPrefix;
+}
+
 void PipeLoadingDialog::OnBrowseForPathBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxDirDialog basePathDialog(
 		this,
@@ -536,6 +566,10 @@ void PipeLoadingDialog::OnLoadPipesTremOffCheck(wxCommandEvent& WXUNUSED(event))
 	m_loadPipesTremOff = m_loadPipesTremulantOffCheck->IsChecked();
 }
 
+void PipeLoadingDialog::OnVelocitySubDirectoryText(wxCommandEvent& WXUNUSED(event)) {
+	m_velocityFolderPrefix = m_velocityPrefixField->GetValue();
+}
+
 void PipeLoadingDialog::DecideStateOfOkButton() {
 	if (m_baseDirectory != wxEmptyString) {
 		wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
@@ -41,7 +41,8 @@ public:
 		wxString releaseFolderPrefix = wxT("rel"),
 		bool extractKeyPressTime = true,
 		wxString tremulantFolderPrefix = wxT("trem"),
-		bool loadPipesTremOff = false
+		bool loadPipesTremOff = false,
+		wxString velocityFolderPrefix = wxEmptyString
 	);
 	PipeLoadingDialog(
 		wxWindow* parent,
@@ -56,6 +57,7 @@ public:
 		bool extractKeyPressTime = true,
 		wxString tremulantFolderPrefix = wxT("trem"),
 		bool loadPipesTremOff = false,
+		wxString velocityFolderPrefix = wxEmptyString,
 		wxWindowID id = wxID_ANY,
 		const wxString& caption = wxT("Flexible Pipe Loading Options"),
 		const wxPoint& pos = wxDefaultPosition,
@@ -77,7 +79,8 @@ public:
 		wxString releaseFolderPrefix,
 		bool extractKeyPressTime ,
 		wxString tremulantFolderPrefix,
-		bool loadPipesTremOff
+		bool loadPipesTremOff,
+		wxString velocityFolderPrefix
 	);
 
 	// Creation
@@ -106,6 +109,7 @@ public:
 	bool GetExtractKeyPressTime();
 	int GetSelectedStrategy();
 	bool GetLoadPipesTremOff();
+	wxString GetVelocityFolderPrefix();
 
 private:
 	int m_nbrPipesInRank;
@@ -122,6 +126,7 @@ private:
 	wxArrayString m_pipeLoadingStrategies;
 	int m_loadingStrategy;
 	bool m_loadPipesTremOff;
+	wxString m_velocityFolderPrefix;
 
 	wxTextCtrl *m_basePathField;
 	wxButton *m_browseForPathBtn;
@@ -131,6 +136,7 @@ private:
 	wxTextCtrl *m_subfolderField;
 	wxTextCtrl *m_releasePrefixField;
 	wxTextCtrl *m_tremulantPrefixField;
+	wxTextCtrl *m_velocityPrefixField;
 	wxCheckBox *m_addOnlyOneAttack;
 	wxCheckBox *m_addReleaseInAttack;
 	wxCheckBox *m_tryForKeyPressTime;
@@ -150,6 +156,7 @@ private:
 	void OnTremSubDirectoryText(wxCommandEvent& event);
 	void OnLoadingStrategyChoice(wxCommandEvent& event);
 	void OnLoadPipesTremOffCheck(wxCommandEvent& event);
+	void OnVelocitySubDirectoryText(wxCommandEvent& event);
 
 	void DecideStateOfOkButton();
 };
@@ -0,0 +1,540 @@
+/*
+ * PreviewRenderer.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PreviewRenderer.h"
+#include "WAVsampleReader.h"
+#include <wx/ffile.h>
+#include <wx/tokenzr.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+PreviewRenderer::PreviewRenderer(Organ *organ, unsigned sampleRate) {
+	m_organ = organ;
+	m_sampleRate = sampleRate;
+	m_errorMessage = wxEmptyString;
+	m_block.resize(2048 * 2);
+	m_xfadeBlock.resize(m_block.size());
+}
+
+PreviewRenderer::~PreviewRenderer() {
+
+}
+
+bool PreviewRenderer::renderRank(Rank *rank, const std::vector<PREVIEW_NOTE> &notes, wxString outputFile) {
+	reset();
+	for (const PREVIEW_NOTE &note : notes) {
+		int pipeIndex = note.midiNote - rank->getFirstMidiNoteNumber();
+		if (pipeIndex < 0 || pipeIndex >= (int) rank->m_pipes.size()) {
+			m_warnings.Add(wxString::Format(wxT("MIDI note %d has no pipe in rank %s."), note.midiNote, rank->getName()));
+			continue;
+		}
+		renderNote(rank, pipeIndex, note);
+	}
+	return writeWav(outputFile);
+}
+
+bool PreviewRenderer::renderStop(Stop *stop, const std::vector<PREVIEW_NOTE> &notes, wxString outputFile) {
+	reset();
+	Manual *manual = stop->getOwningManual();
+	if (!manual) {
+		m_errorMessage = wxT("The stop doesn't belong to any manual.");
+		return false;
+	}
+
+	for (const PREVIEW_NOTE &note : notes) {
+		// MIDI note -> manual key -> stop pipe -> rank pipe, all numbers are 1 based like in the odf
+		int key = note.midiNote - manual->getFirstAccessibleKeyMIDINoteNumber() + manual->getFirstAccessibleKeyLogicalKeyNumber();
+		int stopPipe = key - stop->getFirstPipeLogicalKeyNbr() + 1;
+		if (stopPipe < 1 || stopPipe > stop->getNumberOfAccessiblePipes()) {
+			m_warnings.Add(wxString::Format(wxT("MIDI note %d has no pipe in stop %s."), note.midiNote, stop->getName()));
+			continue;
+		}
+
+		if (stop->isUsingInternalRank()) {
+			Rank *rank = stop->getInternalRank();
+			int rankPipe = stopPipe + stop->getFirstPipeLogicalPipeNbr() - 1;
+			if (rankPipe >= 1 && rankPipe <= (int) rank->m_pipes.size())
+				renderNote(rank, rankPipe - 1, note);
+		} else {
+			for (unsigned i = 0; i < stop->getNumberOfRanks(); i++) {
+				RankReference *ref = stop->getRankReferenceAt(i);
+				if (stopPipe < ref->m_firstAccessibleKeyNumber || stopPipe >= ref->m_firstAccessibleKeyNumber + ref->m_pipeCount)
+					continue;
+				int rankPipe = ref->m_firstPipeNumber + stopPipe - ref->m_firstAccessibleKeyNumber;
+				if (rankPipe >= 1 && rankPipe <= (int) ref->m_rankReference->m_pipes.size())
+					renderNote(ref->m_rankReference, rankPipe - 1, note);
+			}
+		}
+	}
+	return writeWav(outputFile);
+}
+
+wxString PreviewRenderer::getErrorMessage() {
+	return m_errorMessage;
+}
+
+const wxArrayString& PreviewRenderer::getWarnings() {
+	return m_warnings;
+}
+
+double PreviewRenderer::getLength() {
+	return (double) (m_mix.size() / 2) / m_sampleRate;
+}
+
+float PreviewRenderer::getPeakLevel() {
+	float peak = 0;
+	for (float value : m_mix)
+		peak = std::max(peak, std::fabs(value));
+	return peak;
+}
+
+bool PreviewRenderer::parseNoteList(wxString noteList, double noteLength, double gap, std::vector<PREVIEW_NOTE> &notes) {
+	notes.clear();
+	double time = 0;
+	wxStringTokenizer tokenizer(noteList, wxT(" ,;\t\n"), wxTOKEN_STRTOK);
+	while (tokenizer.HasMoreTokens()) {
+		wxString token = tokenizer.GetNextToken();
+		std::vector<int> chord;
+		std::vector<int> sequence;
+		if (token.Contains(wxT("+"))) {
+			wxStringTokenizer chordTokenizer(token, wxT("+"), wxTOKEN_STRTOK);
+			while (chordTokenizer.HasMoreTokens()) {
+				long value;
+				if (!chordTokenizer.GetNextToken().ToLong(&value))
+					return false;
+				chord.push_back(value);
+			}
+		} else if (token.Find(wxT('-')) > 0) {
+			long first, last;
+			if (!token.BeforeFirst(wxT('-')).ToLong(&first) || !token.AfterFirst(wxT('-')).ToLong(&last))
+				return false;
+			int direction = first <= last ? 1 : -1;
+			for (long n = first; n != last + direction; n += direction)
+				sequence.push_back(n);
+		} else {
+			long value;
+			if (!token.ToLong(&value))
+				return false;
+			sequence.push_back(value);
+		}
+
+		for (int n : chord) {
+			if (n < 0 || n > 127)
+				return false;
+			notes.push_back(PREVIEW_NOTE{n, time, noteLength});
+		}
+		if (!chord.empty())
+			time += noteLength + gap;
+		for (int n : sequence) {
+			if (n < 0 || n > 127)
+				return false;
+			notes.push_back(PREVIEW_NOTE{n, time, noteLength});
+			time += noteLength + gap;
+		}
+	}
+	return !notes.empty();
+}
+
+void PreviewRenderer::reset() {
+	m_errorMessage = wxEmptyString;
+	m_warnings.Empty();
+	m_mix.clear();
+}
+
+void PreviewRenderer::renderNote(Rank *rank, unsigned pipeIndex, const PREVIEW_NOTE &note) {
+	Pipe *pipe = rank->getPipeAt(pipeIndex);
+	if (pipe->m_attacks.empty() || pipe->m_attacks.front().fullPath.IsSameAs(wxT("DUMMY")))
+		return;
+
+	if (pipe->isFirstAttackRefPath()) {
+		// a borrowed pipe sounds like the pipe it references
+		wxString ref = pipe->m_attacks.front().fileName;
+		Stop *referencedStop = m_organ->getStopFromRefString(ref);
+		long pipeNbr;
+		if (referencedStop && referencedStop->isUsingInternalRank() && ref.Mid(12, 3).ToLong(&pipeNbr) &&
+			pipeNbr >= 1 && pipeNbr <= (long) referencedStop->getInternalRank()->m_pipes.size()) {
+			Pipe *referencedPipe = referencedStop->getInternalRank()->getPipeAt(pipeNbr - 1);
+			if (!referencedPipe->isFirstAttackRefPath())
+				renderPipe(referencedStop->getInternalRank(), referencedPipe, note);
+		} else {
+			wxString warning = wxT("Borrowed pipe ") + ref + wxT(" can't be previewed.");
+			if (m_warnings.Index(warning) == wxNOT_FOUND)
+				m_warnings.Add(warning);
+		}
+		return;
+	}
+
+	renderPipe(rank, pipe, note);
+}
+
+void PreviewRenderer::renderPipe(Rank *rank, Pipe *pipe, const PREVIEW_NOTE &note) {
+	// the tremulant off attack for normal velocity and key press
+	Attack *attack = &pipe->m_attacks.front();
+	for (Attack &atk : pipe->m_attacks) {
+		if (atk.isTremulant != 1 && atk.attackVelocity == 0 && atk.maxTimeSinceLastRelease == -1) {
+			attack = &atk;
+			break;
+		}
+	}
+	DECODED_SAMPLE *attackSample = getSample(attack->fullPath);
+	if (!attackSample)
+		return;
+
+	float amplitude = m_organ->getAmplitudeLevel() / 100.0f * rank->getAmplitudeLevel() / 100.0f * pipe->amplitudeLevel / 100.0f;
+	float gainDb = m_organ->getGain() + rank->getGain() + pipe->gain;
+	float gain = amplitude * std::pow(10.0f, gainDb / 20.0f);
+	double cents = m_organ->getPitchTuning() + rank->getPitchTuning() + pipe->pitchTuning;
+	cents += m_organ->getPitchCorrection() + rank->getPitchCorrection() + pipe->pitchCorrection;
+	double pitchRatio = std::pow(2.0, cents / 1200.0);
+
+	unsigned startFrame = (unsigned) (note.start * m_sampleRate);
+	unsigned heldFrames = (unsigned) (note.length * m_sampleRate);
+	unsigned releaseFrame = startFrame + heldFrames;
+
+	PLAYBACK attackPlayback;
+	attackPlayback.sample = attackSample;
+	attackPlayback.position = std::min((unsigned) std::max(attack->attackStart, 0), attackSample->nbrOfFrames - 1);
+	attackPlayback.step = pitchRatio * attackSample->sampleRate / m_sampleRate;
+	attackPlayback.loopStart = -1;
+	attackPlayback.loopEnd = -1;
+	attackPlayback.loopXfade = 0;
+	attackPlayback.endFrame = attackSample->nbrOfFrames;
+	if (attack->releaseEnd > -1 && !pipe->isPercussive)
+		attackPlayback.endFrame = std::min((unsigned) attack->releaseEnd + 1, attackSample->nbrOfFrames);
+	if (!pipe->isPercussive) {
+		if (!attack->m_loops.empty()) {
+			attackPlayback.loopStart = attack->m_loops.front().start;
+			attackPlayback.loopEnd = attack->m_loops.front().end;
+		} else if (attackSample->loopStart > -1) {
+			attackPlayback.loopStart = attackSample->loopStart;
+			attackPlayback.loopEnd = attackSample->loopEnd;
+		}
+		if (attackPlayback.loopStart < 0 || attackPlayback.loopEnd <= attackPlayback.loopStart || attackPlayback.loopEnd >= (int) attackSample->nbrOfFrames) {
+			attackPlayback.loopStart = -1;
+			attackPlayback.loopEnd = -1;
+		} else {
+			unsigned loopLength = attackPlayback.loopEnd - attackPlayback.loopStart + 1;
+			unsigned xfade = (unsigned) ((double) attack->loopCrossfadeLength * attackSample->sampleRate / 1000.0);
+			attackPlayback.loopXfade = std::min(xfade, std::min(loopLength, (unsigned) attackPlayback.loopStart));
+		}
+	}
+
+	if (pipe->isPercussive) {
+		// percussive pipes play to the end regardless of the key
+		playInto(attackPlayback, startFrame, UINT_MAX, gain, 0, 0);
+		if (!pipe->hasIndependentRelease)
+			return;
+	}
+
+	// pick the release, either a separate one or the release part of the attack after the cue point
+	int cue = attack->cuePoint > -1 ? attack->cuePoint : attackSample->cuePoint;
+	int heldMs = (int) (note.length * 1000);
+	Release *release = NULL;
+	for (Release &rel : pipe->m_releases) {
+		if (rel.isTremulant == 1)
+			continue;
+		if (rel.maxKeyPressTime > -1 && rel.maxKeyPressTime >= heldMs) {
+			if (!release || release->maxKeyPressTime == -1 || rel.maxKeyPressTime < release->maxKeyPressTime)
+				release = &rel;
+		} else if (rel.maxKeyPressTime == -1 && !release) {
+			release = &rel;
+		}
+	}
+
+	PLAYBACK releasePlayback;
+	bool hasRelease = false;
+	unsigned releaseXfadeMs = 0;
+	if (release) {
+		DECODED_SAMPLE *releaseSample = getSample(release->fullPath);
+		if (releaseSample) {
+			int releaseCue = release->cuePoint > -1 ? release->cuePoint : 0;
+			releasePlayback.sample = releaseSample;
+			releasePlayback.position = std::min((unsigned) releaseCue, releaseSample->nbrOfFrames - 1);
+			releasePlayback.step = pitchRatio * releaseSample->sampleRate / m_sampleRate;
+			releasePlayback.endFrame = releaseSample->nbrOfFrames;
+			if (release->releaseEnd > releaseCue)
+				releasePlayback.endFrame = std::min((unsigned) release->releaseEnd + 1, releaseSample->nbrOfFrames);
+			releaseXfadeMs = release->releaseCrossfadeLength;
+			hasRelease = true;
+		}
+	} else if (attack->loadRelease && cue > -1 && cue < (int) attackSample->nbrOfFrames) {
+		releasePlayback = attackPlayback;
+		releasePlayback.position = cue;
+		releasePlayback.endFrame = attackSample->nbrOfFrames;
+		if (attack->releaseEnd > cue)
+			releasePlayback.endFrame = std::min((unsigned) attack->releaseEnd + 1, attackSample->nbrOfFrames);
+		releaseXfadeMs = attack->releaseCrossfadeLength;
+		hasRelease = true;
+	}
+	if (hasRelease) {
+		releasePlayback.loopStart = -1;
+		releasePlayback.loopEnd = -1;
+		releasePlayback.loopXfade = 0;
+	}
+
+	// without any crossfade set a short fade still avoids clicks
+	if (releaseXfadeMs == 0)
+		releaseXfadeMs = 10;
+	unsigned xfadeFrames = std::max(1u, releaseXfadeMs * m_sampleRate / 1000);
+
+	if (!pipe->isPercussive) {
+		unsigned played = playInto(attackPlayback, startFrame, heldFrames, gain, 0, 0);
+		if (played == heldFrames)
+			playInto(attackPlayback, releaseFrame, xfadeFrames, gain, 0, xfadeFrames);
+	}
+	if (hasRelease) {
+		playInto(releasePlayback, releaseFrame, UINT_MAX, gain, xfadeFrames, 0);
+	}
+}
+
+PreviewRenderer::DECODED_SAMPLE* PreviewRenderer::getSample(wxString fullPath) {
+	std::map<wxString, DECODED_SAMPLE>::iterator cached = m_sampleCache.find(fullPath);
+	if (cached != m_sampleCache.end())
+		return cached->second.nbrOfFrames ? &cached->second : NULL;
+
+	DECODED_SAMPLE &sample = m_sampleCache[fullPath];
+	sample.nbrOfFrames = 0;
+	sample.sampleRate = 0;
+	sample.loopStart = -1;
+	sample.loopEnd = -1;
+	sample.cuePoint = -1;
+
+	WAVsampleReader reader(fullPath);
+	if (!reader.isOk() || reader.getNumberOfFrames() == 0) {
+		m_warnings.Add(fullPath + wxT(": ") + reader.getErrorMessage().Trim());
+		return NULL;
+	}
+
+	unsigned channels = reader.getNumberOfChannels();
+	sample.sampleRate = reader.getSampleRate();
+	sample.frames.reserve((size_t) reader.getNumberOfFrames() * 2);
+	std::vector<float> block;
+	while (reader.readFrames(block, 65536) > 0) {
+		unsigned framesRead = block.size() / channels;
+		for (unsigned i = 0; i < framesRead; i++) {
+			sample.frames.push_back(block[(size_t) i * channels]);
+			sample.frames.push_back(block[(size_t) i * channels + (channels > 1 ? 1 : 0)]);
+		}
+	}
+	sample.nbrOfFrames = sample.frames.size() / 2;
+
+	WAVfileParser *parser = reader.getParser();
+	if (parser->getNumberOfLoops() > 0) {
+		sample.loopStart = parser->getLoopAtIndex(0).dwStart;
+		sample.loopEnd = parser->getLoopAtIndex(0).dwEnd;
+	}
+	if (parser->getNumberOfCues() > 0)
+		sample.cuePoint = parser->getCuepointAtIndex(0).dwSampleOffset;
+
+	return sample.nbrOfFrames ? &sample : NULL;
+}
+
+// 4 point Catmull-Rom interpolation of both channels between frames i1 and i2
+static inline void interpolateFrame(const float *data, int i0, int i1, int i2, int i3, float f, float *out) {
+	float c0 = ((-0.5f * f + 1.0f) * f - 0.5f) * f;
+	float c1 = (1.5f * f - 2.5f) * f * f + 1.0f;
+	float c2 = ((-1.5f * f + 2.0f) * f + 0.5f) * f;
+	float c3 = (0.5f * f - 0.5f) * f * f;
+	out[0] = c0 * data[i0 * 2] + c1 * data[i1 * 2] + c2 * data[i2 * 2] + c3 * data[i3 * 2];
+	out[1] = c0 * data[i0 * 2 + 1] + c1 * data[i1 * 2 + 1] + c2 * data[i2 * 2 + 1] + c3 * data[i3 * 2 + 1];
+}
+
+void PreviewRenderer::interpolateSpan(const DECODED_SAMPLE *sample, double position, double step, unsigned nbrOfFrames, float *out) {
+	// the span has no loop jumps or crossfades, so each frame only depends on
+	// its own position and the loop can be vectorized, the indices only need
+	// clamping when the span reaches the first or the last frames
+	const float *data = sample->frames.data();
+	int lastFrame = (int) sample->nbrOfFrames - 1;
+	int firstIndex = (int) position;
+	int lastIndex = (int) (position + step * (nbrOfFrames - 1));
+	if (firstIndex >= 1 && lastIndex + 2 <= lastFrame) {
+		for (unsigned k = 0; k < nbrOfFrames; k++) {
+			double pos = position + step * k;
+			int i = (int) pos;
+			interpolateFrame(data, i - 1, i, i + 1, i + 2, (float) (pos - i), out + k * 2);
+		}
+	} else {
+		for (unsigned k = 0; k < nbrOfFrames; k++) {
+			double pos = position + step * k;
+			int i = (int) pos;
+			interpolateFrame(
+				data,
+				std::max(i - 1, 0),
+				std::min(i, lastFrame),
+				std::min(i + 1, lastFrame),
+				std::min(i + 2, lastFrame),
+				(float) (pos - i),
+				out + k * 2
+			);
+		}
+	}
+}
+
+unsigned PreviewRenderer::readPlayback(PLAYBACK &playback, float *out, unsigned nbrOfFrames) {
+	bool looping = playback.loopStart > -1;
+	double loopLength = looping ? playback.loopEnd - playback.loopStart + 1 : 0;
+	double xfadeStart = looping ? playback.loopEnd + 1 - (double) playback.loopXfade : 0;
+
+	// the output is produced in spans that end at the next loop jump, the
+	// start of the loop crossfade or the end of the playback
+	unsigned i = 0;
+	while (i < nbrOfFrames) {
+		if (looping) {
+			while (playback.position >= playback.loopEnd + 1)
+				playback.position -= loopLength;
+		} else if (playback.position >= playback.endFrame) {
+			break;
+		}
+
+		bool isInXfade = looping && playback.loopXfade > 0 && playback.position >= xfadeStart;
+		double boundary = playback.endFrame;
+		if (looping)
+			boundary = playback.loopXfade > 0 && !isInXfade ? xfadeStart : playback.loopEnd + 1;
+		double framesToBoundary = std::ceil((boundary - playback.position) / playback.step);
+		unsigned spanFrames = nbrOfFrames - i;
+		if (framesToBoundary < spanFrames)
+			spanFrames = std::max(1u, (unsigned) framesToBoundary);
+
+		float *span = out + (size_t) i * 2;
+		interpolateSpan(playback.sample, playback.position, playback.step, spanFrames, span);
+		if (isInXfade) {
+			// fade towards the audio just before the loop start so the jump back is seamless
+			float *before = m_xfadeBlock.data();
+			interpolateSpan(playback.sample, playback.position - loopLength, playback.step, spanFrames, before);
+			double tStart = (playback.position - xfadeStart) / playback.loopXfade;
+			double tStep = playback.step / playback.loopXfade;
+			for (unsigned k = 0; k < spanFrames; k++) {
+				float t = (float) (tStart + tStep * k);
+				span[k * 2] += (before[k * 2] - span[k * 2]) * t;
+				span[k * 2 + 1] += (before[k * 2 + 1] - span[k * 2 + 1]) * t;
+			}
+		}
+		playback.position += playback.step * spanFrames;
+		i += spanFrames;
+	}
+	return i;
+}
+
+unsigned PreviewRenderer::playInto(PLAYBACK &playback, unsigned outFrame, unsigned nbrOfFrames, float gain, unsigned fadeInFrames, unsigned fadeOutFrames) {
+	unsigned blockSize = m_block.size() / 2;
+	unsigned done = 0;
+	while (done < nbrOfFrames) {
+		unsigned toRead = std::min(blockSize, nbrOfFrames - done);
+		unsigned got = readPlayback(playback, m_block.data(), toRead);
+		if (got == 0)
+			break;
+
+		// fade in over the first and fade out over the last frames of the span
+		float gainStart = gain;
+		float gainEnd = gain;
+		if (done < fadeInFrames) {
+			gainStart = gain * done / fadeInFrames;
+			gainEnd = gain * std::min(1.0f, (float) (done + got) / fadeInFrames);
+		} else if (fadeOutFrames > 0 && nbrOfFrames != UINT_MAX) {
+			gainStart = gain * (float) (nbrOfFrames - done) / fadeOutFrames;
+			gainEnd = gain * (float) (nbrOfFrames - done - got) / fadeOutFrames;
+			gainStart = std::min(gain, gainStart);
+			gainEnd = std::min(gain, gainEnd);
+		}
+		mixBlock(m_block.data(), got, outFrame + done, gainStart, gainEnd);
+
+		done += got;
+		if (got < toRead)
+			break;
+	}
+	return done;
+}
+
+void PreviewRenderer::mixBlock(const float *block, unsigned nbrOfFrames, unsigned outFrame, float gainStart, float gainEnd) {
+	size_t needed = ((size_t) outFrame + nbrOfFrames) * 2;
+	if (m_mix.size() < needed)
+		m_mix.resize(needed, 0.0f);
+
+	// kept as simple loops over contiguous data so that the compiler can vectorize them
+	float *mix = m_mix.data() + (size_t) outFrame * 2;
+	unsigned nbrOfValues = nbrOfFrames * 2;
+	if (gainStart == gainEnd) {
+		for (unsigned i = 0; i < nbrOfValues; i++)
+			mix[i] += block[i] * gainStart;
+	} else {
+		float gainStep = (gainEnd - gainStart) / nbrOfFrames;
+		for (unsigned i = 0; i < nbrOfValues; i++)
+			mix[i] += block[i] * (gainStart + gainStep * (i >> 1));
+	}
+}
+
+bool PreviewRenderer::writeWav(wxString outputFile) {
+	if (m_mix.empty()) {
+		m_errorMessage = wxT("Nothing was rendered, no playable pipes for the notes.");
+		return false;
+	}
+
+	wxFFile wavFile(outputFile, wxT("wb"));
+	if (!wavFile.IsOpened()) {
+		m_errorMessage = wxT("Couldn't open ") + outputFile + wxT(" for writing.");
+		return false;
+	}
+
+	unsigned nbrOfFrames = m_mix.size() / 2;
+	unsigned dataSize = m_mix.size() * 4;
+	std::vector<unsigned char> header;
+	auto putFourCC = [&header](const char *id) { header.insert(header.end(), id, id + 4); };
+	auto putUint = [&header](uint32_t value, unsigned bytes) {
+		for (unsigned i = 0; i < bytes; i++)
+			header.push_back((value >> (8 * i)) & 0xFF);
+	};
+
+	putFourCC("RIFF");
+	putUint(4 + 26 + 12 + 8 + dataSize, 4);
+	putFourCC("WAVE");
+	putFourCC("fmt ");
+	putUint(18, 4);
+	putUint(3, 2); // WAVE_FORMAT_IEEE_FLOAT
+	putUint(2, 2);
+	putUint(m_sampleRate, 4);
+	putUint(m_sampleRate * 8, 4);
+	putUint(8, 2);
+	putUint(32, 2);
+	putUint(0, 2);
+	putFourCC("fact");
+	putUint(4, 4);
+	putUint(nbrOfFrames, 4);
+	putFourCC("data");
+	putUint(dataSize, 4);
+
+	std::vector<unsigned char> data(dataSize);
+	for (size_t i = 0; i < m_mix.size(); i++) {
+		uint32_t bits;
+		std::memcpy(&bits, &m_mix[i], 4);
+		data[i * 4] = bits & 0xFF;
+		data[i * 4 + 1] = (bits >> 8) & 0xFF;
+		data[i * 4 + 2] = (bits >> 16) & 0xFF;
+		data[i * 4 + 3] = (bits >> 24) & 0xFF;
+	}
+
+	if (wavFile.Write(header.data(), header.size()) != header.size() || wavFile.Write(data.data(), data.size()) != data.size()) {
+		m_errorMessage = wxT("Writing ") + outputFile + wxT(" failed.");
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,98 @@
+/*
+ * PreviewRenderer.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PREVIEWRENDERER_H
+#define PREVIEWRENDERER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <map>
+#include "Organ.h"
+
+struct PREVIEW_NOTE {
+	int midiNote;
+	double start; // seconds from beginning of the render
+	double length; // seconds the key is held
+};
+
+// Renders how a rank or stop would sound for a list of notes into a stereo
+// 32 bit float .wav file without any audio hardware. Attacks are resampled
+// (cubic interpolation) according to pitch tuning/correction, looped with
+// their crossfades while the key is held and then crossfaded into the
+// release selected by key press time. Tremulants, windchests, enclosures and
+// temperaments are not taken into account.
+class PreviewRenderer {
+
+public:
+	PreviewRenderer(Organ *organ, unsigned sampleRate = 48000);
+	~PreviewRenderer();
+
+	bool renderRank(Rank *rank, const std::vector<PREVIEW_NOTE> &notes, wxString outputFile);
+	bool renderStop(Stop *stop, const std::vector<PREVIEW_NOTE> &notes, wxString outputFile);
+	wxString getErrorMessage();
+	const wxArrayString& getWarnings();
+	double getLength();
+	float getPeakLevel();
+
+	// parses notes like "36 48 60-72 60+64+67" (range is chromatic, + plays a chord) into a sequence
+	static bool parseNoteList(wxString noteList, double noteLength, double gap, std::vector<PREVIEW_NOTE> &notes);
+
+private:
+	struct DECODED_SAMPLE {
+		std::vector<float> frames; // interleaved stereo
+		unsigned nbrOfFrames;
+		unsigned sampleRate;
+		int loopStart; // first embedded loop, -1 if none
+		int loopEnd;
+		int cuePoint; // first embedded cue, -1 if none
+	};
+
+	struct PLAYBACK {
+		DECODED_SAMPLE *sample;
+		double position;
+		double step;
+		int loopStart; // -1 if not looping
+		int loopEnd;
+		unsigned loopXfade; // in sample frames
+		unsigned endFrame; // exclusive
+	};
+
+	Organ *m_organ;
+	unsigned m_sampleRate;
+	wxString m_errorMessage;
+	wxArrayString m_warnings;
+	std::map<wxString, DECODED_SAMPLE> m_sampleCache;
+	std::vector<float> m_mix; // interleaved stereo
+	std::vector<float> m_block;
+	std::vector<float> m_xfadeBlock; // the audio before the loop start while crossfading
+
+	void reset();
+	void renderNote(Rank *rank, unsigned pipeIndex, const PREVIEW_NOTE &note);
+	void renderPipe(Rank *rank, Pipe *pipe, const PREVIEW_NOTE &note);
+	DECODED_SAMPLE* getSample(wxString fullPath);
+	unsigned readPlayback(PLAYBACK &playback, float *out, unsigned nbrOfFrames);
+	static void interpolateSpan(const DECODED_SAMPLE *sample, double position, double step, unsigned nbrOfFrames, float *out);
+	// plays nbrOfFrames (or until the playback ends) into the mix, returns the number of frames played
+	unsigned playInto(PLAYBACK &playback, unsigned outFrame, unsigned nbrOfFrames, float gain, unsigned fadeInFrames, unsigned fadeOutFrames);
+	void mixBlock(const float *block, unsigned nbrOfFrames, unsigned outFrame, float gainStart, float gainEnd);
+	bool writeWav(wxString outputFile);
+};
+
+#endif
@@ -21,15 +21,25 @@
 #include "Rank.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "OrganSnapshot.h"
+#include "TraceRecorder.h"
+#include "OdfWriter.h"
 #include <wx/unichar.h>
 
+#ifdef GOODF_CLI
+#define TREMULANT_MESSAGE wxLogWarning(wxT("Warning: A mix of tremulant and non-tremulant pipes in a rank."))
+#else
 #define TREMULANT_MESSAGE do { \
 		wxMessageDialog msg(::wxGetApp().m_frame, wxT("Warning: A mix of tremulant and non-tremulant pipes in a rank."), wxT("Pipe Tremulants Warning"), wxOK|wxCENTRE|wxICON_EXCLAMATION); \
                 msg.ShowModal(); \
 		} while(0)
+#endif
 #define MIXED_TREMULANTS(a, b) (((a) && (b) == -1) || (!(a) && (b) != -1))
 
+std::atomic<long> Rank::s_lastRevision(0);
+
 Rank::Rank() {
+	markChanged();
 	name = wxT("New Rank");
 	firstMidiNoteNumber = 36;
 	numberOfLogicalPipes = 1;
@@ -51,6 +61,7 @@ Rank::Rank() {
 }
 
 Rank::Rank(const Rank& r) {
+	markChanged();
 	name = r.name;
 	firstMidiNoteNumber = r.firstMidiNoteNumber;
 	numberOfLogicalPipes = r.numberOfLogicalPipes;
@@ -122,14 +133,10 @@ void Rank::write(wxTextFile *outFile) {
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
-	// pipes of the rank
-	unsigned pipeCounter = 0;
-	for (Pipe &p : m_pipes) {
-		pipeCounter++;
-		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter);
-
-		p.write(outFile, formattedPipe, this);
-	}
+	// pipes of the rank, only copied here when an .organ file job is created
+	std::vector<int> windchestRefs = getPipeWindchestRefs(::wxGetApp().m_frame->m_organ);
+	if (!OdfWriter::deferPipes(outFile, this, windchestRefs))
+		writePipes(outFile, windchestRefs);
 }
 
 void Rank::writeFromStop(wxTextFile *outFile) {
@@ -170,17 +177,36 @@ void Rank::writeFromStop(wxTextFile *outFile) {
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
-	// pipes of the rank
+	// pipes of the rank, only copied here when an .organ file job is created
+	std::vector<int> windchestRefs = getPipeWindchestRefs(::wxGetApp().m_frame->m_organ);
+	if (!OdfWriter::deferPipes(outFile, this, windchestRefs))
+		writePipes(outFile, windchestRefs);
+}
+
+void Rank::writePipes(wxTextFile *outFile, const std::vector<int> &windchestRefs) {
 	unsigned pipeCounter = 0;
 	for (Pipe &p : m_pipes) {
+		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter + 1);
+
+		p.write(outFile, formattedPipe, this, pipeCounter < windchestRefs.size() ? windchestRefs[pipeCounter] : -1);
 		pipeCounter++;
-		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter);
+	}
+}
 
-		p.write(outFile, formattedPipe, this);
+std::vector<int> Rank::getPipeWindchestRefs(Organ *organ) {
+	std::vector<int> refs;
+	refs.reserve(m_pipes.size());
+	for (Pipe &p : m_pipes) {
+		if (p.windchest != windchest)
+			refs.push_back(organ->getIndexOfOrganWindchest(p.windchest));
+		else
+			refs.push_back(-1);
 	}
+	return refs;
 }
 
 void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
+	markChanged();
 	name = cfg->Read("Name", wxEmptyString);
 	int firstMIDInote = static_cast<int>(cfg->ReadLong("FirstMidiNoteNumber", 36));
 	if (firstMIDInote > -1 && firstMIDInote < 257) {
@@ -239,6 +265,10 @@ void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
 	setAcceptsRetuning(GOODF_functions::parseBoolean(retuningStr, true));
 	if (!m_pipes.empty())
 		m_pipes.clear();
+	// a matching snapshot of the .organ file already holds the pipes of this section
+	OrganSnapshot *snapshot = OrganSnapshot::getActive();
+	if (snapshot && snapshot->restorePipes(cfg->GetPath().AfterLast('/'), this, readOrgan))
+		return;
 	for (int i = 0; i < numberOfLogicalPipes; i++) {
 		Pipe p;
 		wxString pipeNbr = wxT("Pipe") + GOODF_functions::number_format(i + 1);
@@ -247,6 +277,33 @@ void Rank::read(wxFileConfig *cfg, Organ *readOrgan) {
 	}
 }
 
+void Rank::readCatalogue(wxFileConfig *cfg) {
+	// only enough to list the rank and find its REF: dependencies, no sample files are checked
+	name = cfg->Read("Name", wxEmptyString);
+	int firstMIDInote = static_cast<int>(cfg->ReadLong("FirstMidiNoteNumber", 36));
+	if (firstMIDInote > -1 && firstMIDInote < 257) {
+		setFirstMidiNoteNumber(firstMIDInote);
+	}
+	int nbrPipes = static_cast<int>(cfg->ReadLong("NumberOfLogicalPipes", 1));
+	if (nbrPipes > 0 && nbrPipes < 193) {
+		setNumberOfLogicalPipes(nbrPipes);
+	}
+	if (!m_pipes.empty())
+		m_pipes.clear();
+	for (int i = 0; i < numberOfLogicalPipes; i++) {
+		Pipe p;
+		setupPipeProperties(p);
+		Attack a;
+		wxString attackStr = cfg->Read(wxT("Pipe") + GOODF_functions::number_format(i + 1), wxEmptyString);
+		if (attackStr.StartsWith(wxT("REF"))) {
+			a.fileName = attackStr;
+			a.fullPath = attackStr;
+		}
+		p.m_attacks.push_back(a);
+		m_pipes.push_back(p);
+	}
+}
+
 bool Rank::doesAcceptsRetuning() const {
 	return acceptsRetuning;
 }
@@ -324,6 +381,7 @@ const wxString& Rank::getName() const {
 }
 
 void Rank::setName(const wxString &name) {
+	markChanged();
 	this->name = name;
 }
 
@@ -399,311 +457,63 @@ void Rank::setPipesRootPath(wxString path) {
 }
 
 void Rank::readPipes(
-	wxString extraAttackFolder,
+	SampleTreeClassifier &sampleTree,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
-	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
-	wxString tremulantFolderPrefix,
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
 	int totalNbrOfPipes
 ) {
+	markChanged();
+	TraceScope trace("Rank::readPipes", getName());
 	bool organRootPathIsSet = false;
 
 	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
-
-	if (!pipeRoot.IsOpened())
+	// the sample tree is walked only once, each pipe then just picks its files from it
+	if (!sampleTree.classify(m_latestPipesRootPath))
 		return;
 
+	int isTremulant = -1;
+	if (sampleTree.hasTremulantFolders() || loadPipesAsTremOff)
+		isTremulant = 0;
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		emptyPipeAt(i);
 		Pipe *p = getPipeAt(i);
 		setupPipeProperties(*p);
+		int midiNumber = count + firstMatchingNumber;
 
 		wxArrayString pipeAttacks;
-		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
-		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString tremulantFolders;
-		wxArrayString allFolders;
-
-		bool hasTremulantFolders = false;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-			cont = pipeRoot.GetNext(&folder);
-		}
-
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
-
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				} else if (allFolders.Item(j).Lower().Find(tremulantFolderPrefix.Lower()) != wxNOT_FOUND && tremulantFolderPrefix != wxEmptyString) {
-					tremulantFolders.Add(allFolders.Item(j));
-					hasTremulantFolders = true;
-				}
+		getClassifiedAttacks(sampleTree, midiNumber, pipeAttacks);
+		addAttacksToPipe(p, pipeAttacks, loadRelease, isTremulant, -1, loadOnlyOneAttack, organRootPathIsSet, NULL);
+
+		for (unsigned j = 0; j < sampleTree.getNumberOfFolders(); j++) {
+			SAMPLE_FOLDER *folder = sampleTree.getFolderAt(j);
+			const wxArrayString &files = sampleTree.getFilesMatching(j, midiNumber);
+
+			if (folder->type == SAMPLE_FOLDER_ATTACK && folder->attackVelocity > -1) {
+				if (!loadOnlyOneAttack || p->m_attacks.empty())
+					addAttacksToPipe(p, files, loadRelease, isTremulant, folder->attackVelocity, loadOnlyOneAttack, organRootPathIsSet, NULL);
+			} else if (folder->type == SAMPLE_FOLDER_RELEASE) {
+				addReleasesToPipe(p, files, isTremulant, extractKeyPressTime ? folder->maxKeyPressTime : -1, organRootPathIsSet, NULL);
 			}
 		}
 
-		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
-		);
-
-		// then from possible extra attack folder
-		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
-			);
-		}
-
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
-		// if there are any matching attacks we add them
-		if (!pipeAttacksToAdd.IsEmpty()) {
-			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
-
-				// create and add the attack to the pipe
-				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
-				a.loadRelease = loadRelease;
-				if (hasTremulantFolders || loadPipesAsTremOff)
-					a.isTremulant = 0;
+		// also add possible tremulant samples
+		if (!loadOnlyOneAttack) {
+			for (unsigned j = 0; j < sampleTree.getNumberOfFolders(); j++) {
+				SAMPLE_FOLDER *folder = sampleTree.getFolderAt(j);
+				const wxArrayString &files = sampleTree.getFilesMatching(j, midiNumber);
 
-				p->m_attacks.push_back(a);
-
-				if (loadOnlyOneAttack)
-					break;
-			}
-		}
-
-		pipeAttacks.Empty();
-		pipeAttacksToAdd.Empty();
-
-		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
-
-			releaseFolders.Sort();
-
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
-				);
-
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-				// if there are any matching releases we add them
-				if (!pipeReleasesToAdd.IsEmpty()) {
-
-					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
-						// create and add the release to the pipe
-						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
-						if (hasTremulantFolders || loadPipesAsTremOff)
-							rel.isTremulant = 0;
-
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
-								
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
-
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p->m_releases.push_back(rel);
-
-					}
-				}
-
-				pipeReleases.Empty();
-				pipeReleasesToAdd.Empty();
-			}
-		}
-
-		// also scan possible tremulant folders
-		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
-			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
-				fillArrayStringWithFiles(
-					pipeRoot,
-					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					count,
-					firstMatchingNumber
-				);
-
-				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
-				// if there are any matching attacks we add them
-				if (!pipeAttacksToAdd.IsEmpty()) {
-					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
-						else
-							relativeFileName = pipeAttacksToAdd.Item(k);
-
-						// create and add the attack to the pipe
-						Attack a;
-						a.fileName = relativeFileName;
-						a.fullPath = pipeAttacksToAdd.Item(k);
-						a.loadRelease = loadRelease;
-						a.isTremulant = 1;
-
-						p->m_attacks.push_back(a);
-
-					}
-				}
-
-				// also take care of possible tremulant releases
-				wxArrayString foldersInTremulantFolder;
-				wxArrayString tremReleaseFolders;
-				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j);
-				wxDir tremRoot(currentTremRootPath);
-
-				if (tremRoot.IsOpened()) {
-					// first store all folders existing in root
-					wxString folderName;
-					bool keepLooking = tremRoot.GetFirst(&folderName, wxT("*"), wxDIR_DIRS);
-					do {
-						foldersInTremulantFolder.Add(folderName);
-						keepLooking = tremRoot.GetNext(&folderName);
-					} while (keepLooking);
-
-					// then get only those with release prefix in them
-					if (!foldersInTremulantFolder.IsEmpty()) {
-						for (unsigned k = 0; k < foldersInTremulantFolder.GetCount(); k++) {
-							if (foldersInTremulantFolder.Item(k).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString)
-								tremReleaseFolders.Add(foldersInTremulantFolder.Item(k));
-						}
-					}
-
-					if (!tremReleaseFolders.IsEmpty()) {
-						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
-							fillArrayStringWithFiles(
-								tremRoot,
-								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								count,
-								firstMatchingNumber
-							);
-						}
-					}
-
-					pipeReleases.Sort();
-					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-					// make sure to exactly match the MIDI number
-					exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-					// if there are any matching releases we add them
-					if (!pipeReleasesToAdd.IsEmpty()) {
-						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-							wxString relativeFileName;
-							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-							else
-								relativeFileName = pipeReleasesToAdd.Item(k);
-
-							// create and add the release to the pipe
-							Release rel;
-							rel.fileName = relativeFileName;
-							rel.fullPath = pipeReleasesToAdd.Item(k);
-							rel.isTremulant = 1;
-
-							if (extractKeyPressTime) {
-								// we try to get a number that have at least 2 digits from the folder name
-								wxString relFolderName = (pipeReleasesToAdd.Item(k).BeforeLast(wxFILE_SEP_PATH)).AfterLast(wxFILE_SEP_PATH);
-								int firstNumberIndex = -1;
-								long keyPressTime = -1;
-								for (unsigned l = 0; l < relFolderName.Length(); l++) {
-									if (wxIsdigit(relFolderName.GetChar(l))) {
-										firstNumberIndex = l;
-										break;
-									}
-								}
-
-								if (firstNumberIndex > -1) {
-									wxString numberPart = relFolderName.Mid(firstNumberIndex);
-									if (!numberPart.ToLong(&keyPressTime)) {
-										// the number part didn't contain only numbers!
-									}
-
-									if (keyPressTime > 9 && keyPressTime < 99999)
-										rel.maxKeyPressTime = keyPressTime;
-								}
-							}
-
-							p->m_releases.push_back(rel);
-						}
-					}
-
-				}
+				if (folder->type == SAMPLE_FOLDER_TREMULANT_ATTACK)
+					addAttacksToPipe(p, files, loadRelease, 1, -1, false, organRootPathIsSet, NULL);
+				else if (folder->type == SAMPLE_FOLDER_TREMULANT_RELEASE)
+					addReleasesToPipe(p, files, 1, extractKeyPressTime ? folder->maxKeyPressTime : -1, organRootPathIsSet, NULL);
 			}
 		}
 
@@ -713,367 +523,92 @@ void Rank::readPipes(
 			p->m_attacks.push_back(a);
 		}
 
-		//m_pipes.push_back(p);
 		count++;
 	}
 }
 
 void Rank::addToPipes(
-	wxString extraAttackFolder,
+	SampleTreeClassifier &sampleTree,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
-	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
-	wxString tremulantFolderPrefix,
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
 	int totalNbrOfPipes
 ) {
+	markChanged();
 	bool organRootPathIsSet = false;
 	bool hadIgnoreTremulant = false;
 
 	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
-
-	if (!pipeRoot.IsOpened())
+	if (!sampleTree.classify(m_latestPipesRootPath))
 		return;
 
+	int isTremulant = -1;
+	if (sampleTree.hasTremulantFolders() || loadPipesAsTremOff)
+		isTremulant = 0;
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		Pipe *p = getPipeAt(i);
+		int midiNumber = count + firstMatchingNumber;
+		bool attackAdded = false;
 
 		wxArrayString pipeAttacks;
-		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
-		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString tremulantFolders;
-		wxArrayString allFolders;
-
-		bool hasTremulantFolders = false;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-		    cont = pipeRoot.GetNext(&folder);
+		getClassifiedAttacks(sampleTree, midiNumber, pipeAttacks);
+		if (!pipeAttacks.IsEmpty()) {
+			addAttacksToPipe(p, pipeAttacks, loadRelease, isTremulant, -1, loadOnlyOneAttack, organRootPathIsSet, &hadIgnoreTremulant);
+			attackAdded = true;
 		}
 
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
+		for (unsigned j = 0; j < sampleTree.getNumberOfFolders(); j++) {
+			SAMPLE_FOLDER *folder = sampleTree.getFolderAt(j);
+			const wxArrayString &files = sampleTree.getFilesMatching(j, midiNumber);
 
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				} else if (allFolders.Item(j).Lower().Find(tremulantFolderPrefix.Lower()) != wxNOT_FOUND && tremulantFolderPrefix != wxEmptyString) {
-					tremulantFolders.Add(allFolders.Item(j));
-					hasTremulantFolders = true;
+			if (folder->type == SAMPLE_FOLDER_ATTACK && folder->attackVelocity > -1) {
+				if (!loadOnlyOneAttack || !attackAdded) {
+					addAttacksToPipe(p, files, loadRelease, isTremulant, folder->attackVelocity, loadOnlyOneAttack, organRootPathIsSet, &hadIgnoreTremulant);
+					attackAdded = attackAdded || !files.IsEmpty();
 				}
+			} else if (folder->type == SAMPLE_FOLDER_RELEASE) {
+				addReleasesToPipe(p, files, isTremulant, extractKeyPressTime ? folder->maxKeyPressTime : -1, organRootPathIsSet, &hadIgnoreTremulant);
 			}
 		}
 
-		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
-		);
-
-		// then from possible extra attack folder
-		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
-			);
-		}
-
-		pipeAttacks.Sort();
+		// also add possible tremulant samples
+		if (!loadOnlyOneAttack) {
+			for (unsigned j = 0; j < sampleTree.getNumberOfFolders(); j++) {
+				SAMPLE_FOLDER *folder = sampleTree.getFolderAt(j);
+				const wxArrayString &files = sampleTree.getFilesMatching(j, midiNumber);
 
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
-		// if there are any matching attacks we add them
-		if (!pipeAttacksToAdd.IsEmpty()) {
-
-			// set the warning flag if any previous attack is different than (hasTremulantFolders || loadPipesAsTremOff)
-			if (p->m_attacks.size() > 0) {
-				for (std::list<Attack>::iterator attack = p->m_attacks.begin(); attack != p->m_attacks.end(); attack++) {
-					if (MIXED_TREMULANTS(hasTremulantFolders || loadPipesAsTremOff, attack->isTremulant)) {
-						hadIgnoreTremulant = true;
-						break;
-					}
-				}
-			}
-
-			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
-
-				// create and add the attack to the pipe
-				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
-				a.loadRelease = loadRelease;
-				if (hasTremulantFolders || loadPipesAsTremOff)
-					a.isTremulant = 0;
-
-				p->m_attacks.push_back(a);
-
-				if (loadOnlyOneAttack)
-					break;
+				if (folder->type == SAMPLE_FOLDER_TREMULANT_ATTACK)
+					addAttacksToPipe(p, files, loadRelease, 1, -1, false, organRootPathIsSet, NULL);
+				else if (folder->type == SAMPLE_FOLDER_TREMULANT_RELEASE)
+					addReleasesToPipe(p, files, 1, extractKeyPressTime ? folder->maxKeyPressTime : -1, organRootPathIsSet, &hadIgnoreTremulant);
 			}
 		}
 
-		pipeAttacks.Empty();
-		pipeAttacksToAdd.Empty();
-
-		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
-
-			releaseFolders.Sort();
-
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
-				);
-
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-				// if there are any matching releases we add them
-				if (!pipeReleasesToAdd.IsEmpty()) {
-
-					// set the warning flag if any previous release is different than (hasTremulantFolders || loadPipesAsTremOff)
-					if (p->m_releases.size() > 0) {
-						for (std::list<Release>::iterator release = p->m_releases.begin(); release != p->m_releases.end(); release++) {
-							if (MIXED_TREMULANTS(hasTremulantFolders || loadPipesAsTremOff, release->isTremulant)) {
-								hadIgnoreTremulant = true;
-								break;
-							}
-						}
-					}
-
-					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
-						// create and add the release to the pipe
-						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
-						if (hasTremulantFolders || loadPipesAsTremOff)
-							rel.isTremulant = 0;
-
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
-
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
-
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p->m_releases.push_back(rel);
-
-					}
-				}
-
-				pipeReleases.Empty();
-				pipeReleasesToAdd.Empty();
-			}
-		}
-
-		// also scan possible tremulant folders
-		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
-			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
-				fillArrayStringWithFiles(
-					pipeRoot,
-					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					count,
-					firstMatchingNumber
-				);
-
-				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
-				// if there are any matching attacks we add them
-				if (!pipeAttacksToAdd.IsEmpty()) {
-					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
-						else
-							relativeFileName = pipeAttacksToAdd.Item(k);
-
-						// create and add the attack to the pipe
-						Attack a;
-						a.fileName = relativeFileName;
-						a.fullPath = pipeAttacksToAdd.Item(k);
-						a.loadRelease = loadRelease;
-						a.isTremulant = 1;
-
-						p->m_attacks.push_back(a);
-
-					}
-				}
-
-				// also take care of possible tremulant releases
-				wxArrayString foldersInTremulantFolder;
-				wxArrayString tremReleaseFolders;
-				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j);
-				wxDir tremRoot(currentTremRootPath);
-
-				if (tremRoot.IsOpened()) {
-					// first store all folders existing in root
-					wxString folderName;
-					bool keepLooking = tremRoot.GetFirst(&folderName, wxT("*"), wxDIR_DIRS);
-					while (keepLooking) {
-						foldersInTremulantFolder.Add(folderName);
-					    keepLooking = tremRoot.GetNext(&folderName);
-					}
-
-					// then get only those with release prefix in them
-					if (!foldersInTremulantFolder.IsEmpty()) {
-						for (unsigned k = 0; k < foldersInTremulantFolder.GetCount(); k++) {
-							if (foldersInTremulantFolder.Item(k).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString)
-								tremReleaseFolders.Add(foldersInTremulantFolder.Item(k));
-						}
-					}
-
-					if (!tremReleaseFolders.IsEmpty()) {
-						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
-							fillArrayStringWithFiles(
-								tremRoot,
-								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								count,
-								firstMatchingNumber
-							);
-						}
-					}
-
-					pipeReleases.Sort();
-					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-					// make sure to exactly match the MIDI number
-					exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-					// if there are any matching releases we add them
-					if (!pipeReleasesToAdd.IsEmpty()) {
-
-						// set the warning flag if any previous release is different than (hasTremulantFolders || loadPipesAsTremOff)
-						if (p->m_releases.size() > 0) {
-							for (std::list<Release>::iterator release = p->m_releases.begin(); release != p->m_releases.end(); release++) {
-								if (MIXED_TREMULANTS(true, release->isTremulant)) {
-									hadIgnoreTremulant = true;
-									break;
-								}
-							}
-						}
-
-						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-							wxString relativeFileName;
-							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-							else
-								relativeFileName = pipeReleasesToAdd.Item(k);
-
-							// create and add the release to the pipe
-							Release rel;
-							rel.fileName = relativeFileName;
-							rel.fullPath = pipeReleasesToAdd.Item(k);
-							rel.isTremulant = 1;
-
-							if (extractKeyPressTime) {
-								// we try to get a number that have at least 2 digits from the folder name
-								wxString relFolderName = (pipeReleasesToAdd.Item(k).BeforeLast(wxFILE_SEP_PATH)).AfterFirst(wxFILE_SEP_PATH);
-								int firstNumberIndex = -1;
-								long keyPressTime = -1;
-								for (unsigned l = 0; l < relFolderName.Length(); l++) {
-									if (wxIsdigit(relFolderName.GetChar(l))) {
-										firstNumberIndex = l;
-										break;
-									}
-								}
-
-								if (firstNumberIndex > -1) {
-									wxString numberPart = relFolderName.Mid(firstNumberIndex);
-									if (!numberPart.ToLong(&keyPressTime)) {
-										// the number part didn't contain only numbers!
-									}
-
-									if (keyPressTime > 9 && keyPressTime < 99999)
-										rel.maxKeyPressTime = keyPressTime;
-								}
-							}
-
-							p->m_releases.push_back(rel);
-						}
-					}
-
-				}
-			}
-		}
 		count++;
 	}
+
 	if (hadIgnoreTremulant) {
 		TREMULANT_MESSAGE;
 	}
 }
 
 void Rank::addTremulantToPipes(
-	wxString extraAttackFolder,
+	SampleTreeClassifier &sampleTree,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
-	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
 	int startPipeIdx,
 	int firstMatchingNumber,
 	int totalNbrOfPipes
 ) {
+	markChanged();
 	// This method is for adding additional attacks/releases as (wave) tremulants only
 	bool organRootPathIsSet = false;
 	bool hadIgnoreTremulant = false;
@@ -1081,198 +616,52 @@ void Rank::addTremulantToPipes(
 	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
-
-	if (!pipeRoot.IsOpened())
+	if (!sampleTree.classify(m_latestPipesRootPath))
 		return;
 
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
 		Pipe *p = getPipeAt(i);
+		int midiNumber = count + firstMatchingNumber;
+		bool attackAdded = false;
 
 		wxArrayString pipeAttacks;
-		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
-		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString allFolders;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-			cont = pipeRoot.GetNext(&folder);
-		}
-
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
-
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				}
-			}
-		}
-
-		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
-		);
-
-		// then from possible extra attack folder
-		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-				wxDIR_FILES
-			);
+		getClassifiedAttacks(sampleTree, midiNumber, pipeAttacks);
+		if (!pipeAttacks.IsEmpty()) {
+			addAttacksToPipe(p, pipeAttacks, loadRelease, 1, -1, loadOnlyOneAttack, organRootPathIsSet, &hadIgnoreTremulant);
+			attackAdded = true;
 		}
 
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeAttacksToAdd, count + firstMatchingNumber);
-
-		// if there are any matching attacks we add them
-		if (!pipeAttacksToAdd.IsEmpty()) {
+		for (unsigned j = 0; j < sampleTree.getNumberOfFolders(); j++) {
+			SAMPLE_FOLDER *folder = sampleTree.getFolderAt(j);
+			const wxArrayString &files = sampleTree.getFilesMatching(j, midiNumber);
 
-			// set the warning flag if any previous attack ignores wave tremulant
-			if (p->m_attacks.size() > 0) {
-				for (std::list<Attack>::iterator attack = p->m_attacks.begin(); attack != p->m_attacks.end(); attack++) {
-					if (MIXED_TREMULANTS(true, attack->isTremulant)) {
-						hadIgnoreTremulant = true;
-						break;
-					}
+			if (folder->type == SAMPLE_FOLDER_ATTACK && folder->attackVelocity > -1) {
+				if (!loadOnlyOneAttack || !attackAdded) {
+					addAttacksToPipe(p, files, loadRelease, 1, folder->attackVelocity, loadOnlyOneAttack, organRootPathIsSet, &hadIgnoreTremulant);
+					attackAdded = attackAdded || !files.IsEmpty();
 				}
-			}
-
-			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
-
-				// create and add the attack to the pipe
-				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
-				a.loadRelease = loadRelease;
-				a.isTremulant = 1;
-
-				p->m_attacks.push_back(a);
-
-				if (loadOnlyOneAttack)
-					break;
+			} else if (folder->type == SAMPLE_FOLDER_RELEASE) {
+				addReleasesToPipe(p, files, 1, extractKeyPressTime ? folder->maxKeyPressTime : -1, organRootPathIsSet, &hadIgnoreTremulant);
 			}
 		}
 
-		pipeAttacks.Empty();
-		pipeAttacksToAdd.Empty();
-
-		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
-
-			releaseFolders.Sort();
-
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-					wxDIR_FILES
-				);
-
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// make sure to exactly match the MIDI number
-				exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-				// if there are any matching releases we add them
-				if (!pipeReleasesToAdd.IsEmpty()) {
-
-					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
-						// set the warning flag if any previous release ignores wave tremulant
-						if (p->m_releases.size() > 0) {
-							for (std::list<Release>::iterator release = p->m_releases.begin(); release != p->m_releases.end(); release++) {
-								if (MIXED_TREMULANTS(true, release->isTremulant)) {
-									hadIgnoreTremulant = true;
-									break;
-								}
-							}
-						}
-
-						// create and add the release to the pipe
-						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
-						rel.isTremulant = 1;
-
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
-
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
-
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p->m_releases.push_back(rel);
-
-					}
-				}
-
-				pipeReleases.Empty();
-				pipeReleasesToAdd.Empty();
-			}
-		}
 		count++;
 	}
-	
+
 	if (hadIgnoreTremulant) {
 		TREMULANT_MESSAGE;
 	}
 }
 
 void Rank::addReleasesToPipes(
+	SampleTreeClassifier &sampleTree,
 	bool loadPipesAsTremOff,
 	int startPipeIdx,
 	int firstMatchingNumber,
 	int totalNbrOfPipes
 ) {
+	markChanged();
 	// This method is for adding releases only from a single folder
 	bool organRootPathIsSet = false;
 	bool hadIgnoreTremulant = false;
@@ -1280,76 +669,27 @@ void Rank::addReleasesToPipes(
 	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
 		organRootPathIsSet = true;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
-
-	if (!pipeRoot.IsOpened())
+	if (!sampleTree.classify(m_latestPipesRootPath))
 		return;
 
+	int isTremulant = -1;
+	if (loadPipesAsTremOff)
+		isTremulant = 0;
+
 	int count = 0;
 	for (int i = startPipeIdx; i < startPipeIdx + totalNbrOfPipes; i++) {
-		Pipe *p = getPipeAt(i);
-
-		wxArrayString pipeReleases;
-		wxArrayString pipeReleasesToAdd;
-
-		// get files from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeReleases,
-			wxString::Format(wxT("*%i*.*"), (count + firstMatchingNumber)),
-			wxDIR_FILES
-		);
-
-		pipeReleases.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-		// make sure to exactly match the MIDI number
-		exactlyMatchMidiNumber(pipeReleasesToAdd, count + firstMatchingNumber);
-
-		// if there are any matching attacks we add them
-		if (!pipeReleasesToAdd.IsEmpty()) {
-
-			// set the warning flag if any previous release is different than loadPipeAsTremOff
-			if (p->m_releases.size() > 0) {
-				for (std::list<Release>::iterator release = p->m_releases.begin(); release != p->m_releases.end(); release++) {
-					if (MIXED_TREMULANTS(loadPipesAsTremOff, release->isTremulant)) {
-						hadIgnoreTremulant = true;
-						break;
-					}
-				}
-			}
-
-			for (unsigned j = 0; j < pipeReleasesToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(j));
-				else
-					relativeFileName = pipeReleasesToAdd.Item(j);
-
-				// create and add the release to the pipe
-				Release r;
-				r.fileName = relativeFileName;
-				r.fullPath = pipeReleasesToAdd.Item(j);
-				if (loadPipesAsTremOff)
-					r.isTremulant = 0;
-
-				p->m_releases.push_back(r);
-
-			}
-		}
-
-		pipeReleases.Empty();
-		pipeReleasesToAdd.Empty();
+		// the first classified folder is always the root itself
+		addReleasesToPipe(getPipeAt(i), sampleTree.getFilesMatching(0, count + firstMatchingNumber), isTremulant, -1, organRootPathIsSet, &hadIgnoreTremulant);
 		count++;
 	}
+
 	if (hadIgnoreTremulant) {
 		TREMULANT_MESSAGE;
 	}
 }
 
 void Rank::clearAllPipes() {
+	markChanged();
 	for (Pipe p : m_pipes) {
 		p.m_attacks.clear();
 		p.m_releases.clear();
@@ -1359,6 +699,7 @@ void Rank::clearAllPipes() {
 }
 
 void Rank::createDummyPipes() {
+	markChanged();
 	if (!m_pipes.empty())
 		clearAllPipes();
 
@@ -1374,6 +715,7 @@ void Rank::createDummyPipes() {
 }
 
 void Rank::addDummyPipeFront() {
+	markChanged();
 	Pipe p;
 	setupPipeProperties(p);
 
@@ -1384,6 +726,7 @@ void Rank::addDummyPipeFront() {
 }
 
 void Rank::addDummyPipeBack() {
+	markChanged();
 	Pipe p;
 	setupPipeProperties(p);
 
@@ -1404,14 +747,17 @@ bool Rank::hasOnlyDummyPipes() {
 }
 
 void Rank::removePipeFront() {
+	markChanged();
 	m_pipes.pop_front();
 }
 
 void Rank::removePipeBack() {
+	markChanged();
 	m_pipes.pop_back();
 }
 
 void Rank::clearPipeAt(unsigned index) {
+	markChanged();
 	auto iterator = std::next(m_pipes.begin(), index);
 	(*iterator).m_attacks.clear();
 	(*iterator).m_releases.clear();
@@ -1422,12 +768,14 @@ void Rank::clearPipeAt(unsigned index) {
 }
 
 void Rank::emptyPipeAt(unsigned index) {
+	markChanged();
 	auto iterator = std::next(m_pipes.begin(), index);
 	(*iterator).m_attacks.clear();
 	(*iterator).m_releases.clear();
 }
 
 void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease) {
+	markChanged();
 	auto iterator = std::next(m_pipes.begin(), index);
 
 	bool organRootPathIsSet = false;
@@ -1456,6 +804,7 @@ void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRel
 }
 
 void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime) {
+	markChanged();
 	auto iterator = std::next(m_pipes.begin(), index);
 
 	bool organRootPathIsSet = false;
@@ -1476,33 +825,15 @@ void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extrac
 
 	if (extractKeyPressTime) {
 		// we try to get a number that have at least 2 digits from the folder name
-		wxString folderPath = filePath.BeforeLast(wxFILE_SEP_PATH);
-		wxString relFolderName = folderPath.AfterLast(wxFILE_SEP_PATH);
-		int firstNumberIndex = -1;
-		long keyPressTime = -1;
-
-		for (unsigned l = 0; l < relFolderName.Length(); l++) {
-			if (wxIsdigit(relFolderName.GetChar(l))) {
-				firstNumberIndex = l;
-				break;
-			}
-		}
-
-		if (firstNumberIndex > -1) {
-			wxString numberPart = relFolderName.Mid(firstNumberIndex);
-			if (!numberPart.ToLong(&keyPressTime)) {
-				// the number part didn't contain only numbers!
-			}
-
-			if (keyPressTime > 9 && keyPressTime < 99999)
-				rel.maxKeyPressTime = keyPressTime;
-		}
+		wxString relFolderName = filePath.BeforeLast(wxFILE_SEP_PATH).AfterLast(wxFILE_SEP_PATH);
+		rel.maxKeyPressTime = SampleTreeClassifier::extractKeyPressTime(relFolderName);
 	}
 
 	(*iterator).m_releases.push_back(rel);
 }
 
 bool Rank::deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex) {
+	markChanged();
 	auto pipeIt = std::next(m_pipes.begin(), pipeIndex);
 	auto atkIt = std::next((*pipeIt).m_attacks.begin(), attackIndex);
 
@@ -1515,6 +846,7 @@ bool Rank::deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex) {
 }
 
 void Rank::deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex) {
+	markChanged();
 	auto pipeIt = std::next(m_pipes.begin(), pipeIndex);
 	auto relIt = std::next((*pipeIt).m_releases.begin(), releaseIndex);
 
@@ -1526,25 +858,86 @@ Pipe* Rank::getPipeAt(unsigned index) {
 	return &(*iterator);
 }
 
-void Rank::fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int theCount, int firstMatchingNbr) {
-	root.GetAllFiles(
-		path,
-		&list,
-		wxString::Format(wxT("*%i*.*"), (theCount + firstMatchingNbr)),
-		wxDIR_FILES
-	);
+long Rank::getRevision() const {
+	return m_revision;
+}
+
+void Rank::markChanged() {
+	m_revision = ++s_lastRevision;
+}
+
+void Rank::getClassifiedAttacks(SampleTreeClassifier &sampleTree, int midiNumber, wxArrayString &files) {
+	// attacks from the root and a possible extra attack folder are sorted together
+	for (unsigned i = 0; i < sampleTree.getNumberOfFolders(); i++) {
+		SAMPLE_FOLDER *folder = sampleTree.getFolderAt(i);
+		if (folder->type == SAMPLE_FOLDER_ATTACK && folder->attackVelocity < 0)
+			WX_APPEND_ARRAY(files, sampleTree.getFilesMatching(i, midiNumber));
+	}
+	files.Sort();
 }
 
-void Rank::onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection) {
-	if (!source.IsEmpty()) {
-		for (unsigned n = 0; n < source.GetCount(); n++) {
-			wxString suffix = source.Item(n).AfterLast('.');
-			if (suffix.CmpNoCase(wxT("wav")) == 0 || suffix.CmpNoCase(wxT("wv")) == 0)
-				selection.Add(source.Item(n));
+void Rank::addAttacksToPipe(Pipe *p, const wxArrayString &files, bool loadRelease, int isTremulant, int attackVelocity, bool loadOnlyOneAttack, bool organRootPathIsSet, bool *hadIgnoreTremulant) {
+	if (files.IsEmpty())
+		return;
+
+	// set the warning flag if any previous attack is different in tremulant usage
+	if (hadIgnoreTremulant) {
+		for (std::list<Attack>::iterator attack = p->m_attacks.begin(); attack != p->m_attacks.end(); attack++) {
+			if (MIXED_TREMULANTS(isTremulant != -1, attack->isTremulant)) {
+				*hadIgnoreTremulant = true;
+				break;
+			}
 		}
 	}
+
+	for (unsigned j = 0; j < files.GetCount(); j++) {
+		// create and add the attack to the pipe
+		Attack a;
+		if (organRootPathIsSet)
+			a.fileName = getOnlyFileName(files.Item(j));
+		else
+			a.fileName = files.Item(j);
+		a.fullPath = files.Item(j);
+		a.loadRelease = loadRelease;
+		a.isTremulant = isTremulant;
+		if (attackVelocity > -1)
+			a.attackVelocity = attackVelocity;
+
+		p->m_attacks.push_back(a);
+
+		if (loadOnlyOneAttack)
+			break;
+	}
 }
 
+void Rank::addReleasesToPipe(Pipe *p, const wxArrayString &files, int isTremulant, int maxKeyPressTime, bool organRootPathIsSet, bool *hadIgnoreTremulant) {
+	if (files.IsEmpty())
+		return;
+
+	// set the warning flag if any previous release is different in tremulant usage
+	if (hadIgnoreTremulant) {
+		for (std::list<Release>::iterator release = p->m_releases.begin(); release != p->m_releases.end(); release++) {
+			if (MIXED_TREMULANTS(isTremulant != -1, release->isTremulant)) {
+				*hadIgnoreTremulant = true;
+				break;
+			}
+		}
+	}
+
+	for (unsigned j = 0; j < files.GetCount(); j++) {
+		// create and add the release to the pipe
+		Release rel;
+		if (organRootPathIsSet)
+			rel.fileName = getOnlyFileName(files.Item(j));
+		else
+			rel.fileName = files.Item(j);
+		rel.fullPath = files.Item(j);
+		rel.isTremulant = isTremulant;
+		rel.maxKeyPressTime = maxKeyPressTime;
+
+		p->m_releases.push_back(rel);
+	}
+}
 wxString Rank::getOnlyFileName(wxString path) {
 	return GOODF_functions::removeBaseOdfPath(path);
 }
@@ -1559,56 +952,8 @@ void Rank::setupPipeProperties(Pipe &pipe) {
 	pipe.maxVelocityVolume = this->maxVelocityVolume;
 }
 
-void Rank::exactlyMatchMidiNumber(wxArrayString &fileList, int midiNbr) {
-	// incoming fileList contains full paths to candidate files
-	// but in this function we're interested only in the file name
-	// we get it by converting path to wxFileName and then extracting the name part
-	if (!fileList.IsEmpty()) {
-		for (int i = fileList.size() - 1; i >= 0; i--) {
-			wxFileName whole_path(fileList[i]);
-			wxString file_name = whole_path.GetFullName();
-			bool isAnExactMatch = true;
-			wxString nbrStr = wxString::Format(wxT("%i"), midiNbr);
-			int matching_position = file_name.Find(nbrStr);
-
-			if (matching_position > 0) {
-				// the number is not in the beginning, the only valid number occuring before this is a 0
-				for (int currentIndex = matching_position - 1; currentIndex >= 0; currentIndex--) {
-					wxUniChar currentChar = file_name.GetChar(currentIndex);
-					if (currentChar == '0' || wxIsalpha(currentChar)) {
-						continue;
-					} else {
-						isAnExactMatch = false;
-					}
-				}
-			} else if (matching_position != 0) {
-				// if matching position is negative (wxNOT_FOUND) then this file is not a match
-				isAnExactMatch = false;
-			}
-
-			if (isAnExactMatch && matching_position + nbrStr.Len() < file_name.Len() - 1) {
-				int posAfterMatch = matching_position + nbrStr.Len();
-				// we need to check what is after this matching number too
-				for (int currentIndex = posAfterMatch; currentIndex < (int) file_name.Len(); currentIndex++) {
-					wxUniChar currentChar = file_name.GetChar(currentIndex);
-					if (currentChar == '-' || currentChar == '_' || currentChar == '.') {
-						break;
-					}
-					if (wxIsdigit(currentChar)) {
-						isAnExactMatch = false;
-					}
-				}
-			}
-
-			if (!isAnExactMatch) {
-				fileList.RemoveAt(i);
-			}
-		}
-	}
-}
-
-void Rank::updatePipeRelativePaths() {
+void Rank::updatePipeRelativePaths(PathRebaser &rebaser, FileExistenceCache *existence) {
 	for (Pipe& p : m_pipes) {
-		p.updateRelativePaths();
+		p.updateRelativePaths(rebaser, existence);
 	}
 }
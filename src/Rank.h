@@ -23,7 +23,10 @@
 
 #include "Pipe.h"
 #include "Windchestgroup.h"
+#include "SampleTreeClassifier.h"
 #include <list>
+#include <vector>
+#include <atomic>
 #include <wx/textfile.h>
 #include <wx/dir.h>
 #include <wx/fileconf.h>
@@ -38,7 +41,11 @@ public:
 
 	void write(wxTextFile *outFile);
 	void writeFromStop(wxTextFile *outFile);
+	void writePipes(wxTextFile *outFile, const std::vector<int> &windchestRefs);
+	// for each pipe the index of its windchest, or -1 if it's the one of the rank
+	std::vector<int> getPipeWindchestRefs(Organ *organ);
 	void read(wxFileConfig *cfg, Organ *readOrgan);
+	void readCatalogue(wxFileConfig *cfg);
 
 	bool doesAcceptsRetuning() const;
 	void setAcceptsRetuning(bool acceptsRetuning);
@@ -74,40 +81,36 @@ public:
 	wxString getPipesRootPath();
 	void setPipesRootPath(wxString path);
 	void readPipes(
-		wxString extraAttackFolder,
+		SampleTreeClassifier &sampleTree,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
-		wxString releaseFolderPrefix,
 		bool extractKeyPressTime,
-		wxString tremulantFolderPrefix,
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
 		int totalNbrOfPipes
 	);
 	void addToPipes(
-		wxString extraAttackFolder,
+		SampleTreeClassifier &sampleTree,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
-		wxString releaseFolderPrefix,
 		bool extractKeyPressTime,
-		wxString tremulantFolderPrefix,
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
 		int totalNbrOfPipes
 	);
 	void addTremulantToPipes(
-		wxString extraAttackFolder,
+		SampleTreeClassifier &sampleTree,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
-		wxString releaseFolderPrefix,
 		bool extractKeyPressTime,
 		int startPipeIdx,
 		int firstMatchingNumber,
 		int totalNbrOfPipes
 	);
 	void addReleasesToPipes(
+		SampleTreeClassifier &sampleTree,
 		bool loadPipesAsTremOff,
 		int startPipeIdx,
 		int firstMatchingNumber,
@@ -127,7 +130,11 @@ public:
 	bool deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex);
 	void deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex);
 	Pipe* getPipeAt(unsigned index);
-	void updatePipeRelativePaths();
+	void updatePipeRelativePaths(PathRebaser &rebaser, FileExistenceCache *existence = NULL);
+	// a new value whenever the name or the pipes are changed, code that changes
+	// m_pipes directly must call markChanged() itself
+	long getRevision() const;
+	void markChanged();
 
 	std::list<Pipe> m_pipes;
 
@@ -148,12 +155,14 @@ protected:
 	float maxVelocityVolume;
 	bool acceptsRetuning;
 	wxString m_latestPipesRootPath;
+	long m_revision;
+	static std::atomic<long> s_lastRevision;
 
-	void fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int theCount, int firstMatchingNbr);
-	void onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection);
+	void getClassifiedAttacks(SampleTreeClassifier &sampleTree, int midiNumber, wxArrayString &files);
+	void addAttacksToPipe(Pipe *p, const wxArrayString &files, bool loadRelease, int isTremulant, int attackVelocity, bool loadOnlyOneAttack, bool organRootPathIsSet, bool *hadIgnoreTremulant);
+	void addReleasesToPipe(Pipe *p, const wxArrayString &files, int isTremulant, int maxKeyPressTime, bool organRootPathIsSet, bool *hadIgnoreTremulant);
 	wxString getOnlyFileName(wxString path);
 	void setupPipeProperties(Pipe &pipe);
-	void exactlyMatchMidiNumber(wxArrayString &fileList, int midiNbr);
 };
 
 #endif
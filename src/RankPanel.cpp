@@ -36,6 +36,8 @@
 #include <algorithm>
 #include "WAVfileParser.h"
 #include "SampleFileInfoDialog.h"
+#include "SampleTrimDialog.h"
+#include "RenderPreviewDialog.h"
 #include "DoubleEntryDialog.h"
 #include <cmath>
 
@@ -59,6 +61,8 @@ BEGIN_EVENT_TABLE(RankPanel, wxPanel)
 	EVT_BUTTON(ID_RANK_READ_PIPES_BTN, RankPanel::OnReadPipesBtn)
 	EVT_BUTTON(ID_RANK_REMOVE_BTN, RankPanel::OnRemoveRankBtn)
 	EVT_BUTTON(ID_RANK_CLEAR_PIPES, RankPanel::OnClearPipesBtn)
+	EVT_BUTTON(ID_RANK_AUTO_TRIM_SAMPLES_BTN, RankPanel::OnAutoTrimSamplesBtn)
+	EVT_BUTTON(ID_RANK_RENDER_PREVIEW_BTN, RankPanel::OnRenderPreviewBtn)
 	EVT_TREE_ITEM_RIGHT_CLICK(ID_RANK_PIPE_TREE, RankPanel::OnPipeTreeItemRightClick)
 	EVT_SPINCTRLDOUBLE(ID_RANK_AMP_LVL_SPIN, RankPanel::OnAmplitudeLevelSpin)
 	EVT_SPINCTRLDOUBLE(ID_RANK_GAIN_SPIN, RankPanel::OnGainSpin)
@@ -456,6 +460,18 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 	);
 	actionButtons->Add(readPipesFromFolderBtn, 0, wxALL, 5);
 	actionButtons->AddStretchSpacer();
+	m_renderPreviewBtn = new wxButton(
+		this,
+		ID_RANK_RENDER_PREVIEW_BTN,
+		wxT("Render preview...")
+	);
+	actionButtons->Add(m_renderPreviewBtn, 0, wxALL, 5);
+	m_autoTrimSamplesBtn = new wxButton(
+		this,
+		ID_RANK_AUTO_TRIM_SAMPLES_BTN,
+		wxT("Auto trim samples...")
+	);
+	actionButtons->Add(m_autoTrimSamplesBtn, 0, wxALL, 5);
 	wxButton *clearPipesBtn = new wxButton(
 		this,
 		ID_RANK_CLEAR_PIPES,
@@ -603,6 +619,7 @@ RankPanel::~RankPanel() {
 
 void RankPanel::setRank(Rank *rank) {
 	m_rank = rank;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_rank);
 	m_lastReferencedManual = -1;
 	m_lastReferencedStop = -1;
 
@@ -707,6 +724,8 @@ void RankPanel::setTooltipsEnabled(bool isEnabled) {
 		m_addTremulantPipesBtn->SetToolTip(wxT("Use this button to add separate tremulant samples to the rank. Especially useful if the tremulant samples for the rank is not a sub directory to the other samples."));
 		m_addReleaseSamplesBtn->SetToolTip(wxT("Use this button to add separate releases to the rank, it doesn't remove existing samples. This can be useful if the release samples are placed somewhere else than the other samples."));
 		m_flexiblePipeLoadingBtn->SetToolTip(wxT("Use this button to auto load samples for the rank with more fexibility than the other buttons allow."));
+		m_renderPreviewBtn->SetToolTip(wxT("Render how the rank sounds for some notes to a .wav file, using the current pipe settings, loops and releases."));
+		m_autoTrimSamplesBtn->SetToolTip(wxT("Analyze all samples of the rank and get AttackStart/ReleaseEnd proposals that skip leading silence and tails sunk into the noise floor. Less audio data then needs to be loaded."));
 		m_pipeTreeCtrl->SetToolTip(wxT("The pipe tree pipe(s), attacks and releases can be right clicked to bring up a pop-up menu."));
 	} else {
 		m_nameField->SetToolTip(wxEmptyString);
@@ -739,6 +758,8 @@ void RankPanel::setTooltipsEnabled(bool isEnabled) {
 		m_addTremulantPipesBtn->SetToolTip(wxEmptyString);
 		m_addReleaseSamplesBtn->SetToolTip(wxEmptyString);
 		m_flexiblePipeLoadingBtn->SetToolTip(wxEmptyString);
+		m_renderPreviewBtn->SetToolTip(wxEmptyString);
+		m_autoTrimSamplesBtn->SetToolTip(wxEmptyString);
 		m_pipeTreeCtrl->SetToolTip(wxEmptyString);
 	}
 }
@@ -803,6 +824,8 @@ void RankPanel::OnNameChange(wxCommandEvent& WXUNUSED(event)) {
 	m_rank->setName(m_nameField->GetValue());
 	wxString updatedLabel = m_nameField->GetValue();
 	::wxGetApp().m_frame->OrganTreeChildItemLabelChanged(updatedLabel);
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -852,6 +875,9 @@ void RankPanel::OnWindchestChoice(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 
+		m_rank->markChanged();
+
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -892,6 +918,8 @@ void RankPanel::OnMidiNoteSpin(wxSpinEvent& WXUNUSED(event)) {
 			UpdatePipeTree();
 		}
 	}
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -925,6 +953,9 @@ void RankPanel::OnLogicalPipeSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_numberOfLogicalPipesSpin->SetValue(pipesAlreadyInRank);
 		}
 	}
+	m_rank->markChanged();
+	// the rank is recorded before the stop it belongs to is changed
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	// try to notify parent if it's a StopPanel
 	StopPanel *theParent = wxDynamicCast(this->GetGrandParent(), StopPanel);
 	if (theParent) {
@@ -937,6 +968,8 @@ void RankPanel::OnHarmonicNbrSpin(wxSpinEvent& WXUNUSED(event)) {
 	int harmonicNbr = m_harmonicNumberSpin->GetValue();
 	m_rank->setHarmonicNumber(harmonicNbr);
 	m_calculatedLength->SetLabelText(GOODF_functions::getFootLengthSize(harmonicNbr));
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -986,6 +1019,8 @@ void RankPanel::OnSetHarmonicNbrBtn(wxCommandEvent& WXUNUSED(event)) {
 		if (foundFirstHarmonicNbr) {
 			m_harmonicNumberSpin->SetValue(m_rank->getHarmonicNumber());
 			m_calculatedLength->SetLabelText(GOODF_functions::getFootLengthSize(m_rank->getHarmonicNumber()));
+			m_rank->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		}
 	}
@@ -993,6 +1028,8 @@ void RankPanel::OnSetHarmonicNbrBtn(wxCommandEvent& WXUNUSED(event)) {
 
 void RankPanel::OnPitchCorrectionSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setPitchCorrection((float) m_pitchCorrectionSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1044,6 +1081,8 @@ void RankPanel::OnPercussiveSelection(wxCommandEvent& event) {
 	}
 	RebuildPipeTree();
 	UpdatePipeTree();
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1076,16 +1115,22 @@ void RankPanel::OnIndependentReleaseSelection(wxCommandEvent& event) {
 	}
 	RebuildPipeTree();
 	UpdatePipeTree();
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void RankPanel::OnMinVelocitySpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setMinVelocityVolume((float) m_minVelocityVolumeSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void RankPanel::OnMaxVelocitySpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setMaxVelocityVolume((float) m_maxVelocityVolumeSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1097,6 +1142,8 @@ void RankPanel::OnRetuningSelection(wxCommandEvent& event) {
 		m_acceptsRetuningNo->SetValue(true);
 		m_rank->setAcceptsRetuning(false);
 	}
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1123,21 +1170,21 @@ void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
-		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
+		SampleTreeClassifier *sampleTree = GetSampleTree(
+			m_optionsAttackField->GetValue(),
+			m_optionsReleaseField->GetValue(),
+			m_optionsTremulantField->GetValue()
+		);
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
 		bool loadRelease = m_optionsLoadReleaseInAttack->GetValue();
-		wxString releaseFolderPrefix = m_optionsReleaseField->GetValue();
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
-		wxString tremulantFolderPrefix = m_optionsTremulantField->GetValue();
 		bool loadPipesTremOff = m_loadPipesAsTremOffCheck->GetValue();
 
 		m_rank->readPipes(
-			extraAttackFolderPrefix,
+			*sampleTree,
 			loadOnlyOneAttack,
 			loadRelease,
-			releaseFolderPrefix,
 			extractKeyPressTime,
-			tremulantFolderPrefix,
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
@@ -1147,6 +1194,8 @@ void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		RebuildPipeTree();
 		UpdatePipeTree();
 	}
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1179,10 +1228,48 @@ void RankPanel::OnClearPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		m_rank->createDummyPipes();
 		RebuildPipeTree();
 		UpdatePipeTree();
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
 
+void RankPanel::OnAutoTrimSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (m_rank->hasOnlyDummyPipes())
+		return;
+
+	SampleTrimDialog dlg(m_rank, this);
+	if (dlg.ShowModal() == wxID_OK) {
+		if (dlg.ApplyProposals() > 0) {
+			RebuildPipeTree();
+			UpdatePipeTree();
+			m_rank->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
+			::wxGetApp().m_frame->m_organ->setModified(true);
+		}
+	}
+}
+
+void RankPanel::OnRenderPreviewBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (m_rank->hasOnlyDummyPipes())
+		return;
+
+	RenderPreviewDialog dlg(RenderPreviewDialog::GetDefaultOutputPath(m_rank->getName()), this);
+	if (dlg.ShowModal() == wxID_OK) {
+		std::vector<PREVIEW_NOTE> notes;
+		if (!dlg.GetNotes(notes))
+			return;
+
+		PreviewRenderer renderer(::wxGetApp().m_frame->m_organ);
+		bool renderOk;
+		{
+			wxBusyCursor busy;
+			renderOk = renderer.renderRank(m_rank, notes, dlg.GetOutputPath());
+		}
+		RenderPreviewDialog::ShowRenderResult(this, renderer, renderOk, dlg.GetOutputPath());
+	}
+}
+
 void RankPanel::OnPipeTreeItemRightClick(wxTreeEvent &evt) {
 	wxTreeItemId selectedItem = evt.GetItem();
 	if (m_pipeTreeCtrl->GetSelection() != selectedItem)
@@ -1414,6 +1501,8 @@ void RankPanel::OnAddNewAttack() {
 	}
 
 	m_rank->setPipesRootPath(fileDialog.GetDirectory());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1463,6 +1552,8 @@ void RankPanel::OnAddNewRelease() {
 	}
 
 	m_rank->setPipesRootPath(fileDialog.GetDirectory());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1481,6 +1572,8 @@ void RankPanel::OnClearPipe() {
 		m_pipeTreeCtrl->SelectItem(toSelect);
 		m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 	}
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1491,7 +1584,12 @@ void RankPanel::OnEditPipe() {
 		isItemExpanded = true;
 
 	PipeDialog dlg(m_rank->m_pipes, (unsigned) GetSelectedItemIndexRelativeParent(), this);
+	long modificationCount = ::wxGetApp().m_frame->m_organ->getModificationCount();
 	dlg.ShowModal();
+	// the pipe, attack and release dialogs change the pipes directly
+	m_rank->markChanged();
+	if (::wxGetApp().m_frame->m_organ->getModificationCount() != modificationCount)
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 
 	RebuildPipeTree();
 	UpdatePipeTree();
@@ -1552,6 +1650,8 @@ void RankPanel::OnCreateReference() {
 
 			RebuildPipeTree();
 			UpdatePipeTree();
+			m_rank->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		}
 	}
@@ -1563,7 +1663,12 @@ void RankPanel::OnEditAttack() {
 	Pipe *currentPipe = m_rank->getPipeAt(selectedPipeIndex);
 	AttackDialog atk_dlg(currentPipe->m_attacks, (unsigned) GetSelectedItemIndexRelativeParent(), this);
 
-	if (atk_dlg.ShowModal() == wxID_OK) {
+	long modificationCount = ::wxGetApp().m_frame->m_organ->getModificationCount();
+	int result = atk_dlg.ShowModal();
+	m_rank->markChanged();
+	if (::wxGetApp().m_frame->m_organ->getModificationCount() != modificationCount)
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
+	if (result == wxID_OK) {
 		// the user wants to copy properties of the selected attack to other
 		// attacks in the same directory
 		auto sourceAttack = std::next(atk_dlg.m_attacklist.begin(), atk_dlg.m_selectedAttackIndex);
@@ -1601,6 +1706,8 @@ void RankPanel::OnEditAttack() {
 				}
 			}
 		}
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1627,7 +1734,12 @@ void RankPanel::OnEditRelease() {
 	Pipe *currentPipe = m_rank->getPipeAt(selectedPipeIndex);
 	ReleaseDialog dlg(currentPipe->m_releases, (unsigned) GetSelectedItemIndexRelativeParent(), this);
 
-	if (dlg.ShowModal() == wxID_OK) {
+	long modificationCount = ::wxGetApp().m_frame->m_organ->getModificationCount();
+	int result = dlg.ShowModal();
+	m_rank->markChanged();
+	if (::wxGetApp().m_frame->m_organ->getModificationCount() != modificationCount)
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
+	if (result == wxID_OK) {
 		// the user wants to copy properties of the selected release to other
 		// releases from the same directory
 		Release *sourceRelease = dlg.GetCurrentRelease();
@@ -1643,6 +1755,8 @@ void RankPanel::OnEditRelease() {
 				}
 			}
 		}
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1685,6 +1799,8 @@ void RankPanel::OnRemoveSelectedAttack() {
 				m_pipeTreeCtrl->SelectItem(toSelect);
 				m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 			}
+			m_rank->markChanged();
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		}
 	}
@@ -1708,6 +1824,8 @@ void RankPanel::OnRemoveSelectedRelease() {
 		m_pipeTreeCtrl->SelectItem(toSelect);
 		m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 	}
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1721,11 +1839,13 @@ void RankPanel::OnCopyPipeOffset() {
 		wxArrayInt targetPipes;
 		if (copyDlg.GetSelectedIndices(targetPipes)) {
 			Pipe *source = m_rank->getPipeAt(selectedPipeIndex);
+			UndoStep *undoStep = ::wxGetApp().m_frame->m_undoHistory->beginStep(::wxGetApp().m_frame->m_organ, wxT("Copy pipe with offset"));
 			// there are valid target pipes to copy to with offset
 			for (unsigned i = 0; i < targetPipes.size(); i++) {
 				int targetIdx = targetPipes[i];
 				int offset = targetIdx - selectedPipeIndex;
 				Pipe *target = m_rank->getPipeAt(targetIdx);
+				undoStep->recordPipe(m_rank, target);
 
 				target->isPercussive = source->isPercussive;
 				target->hasIndependentRelease = source->hasIndependentRelease;
@@ -1757,6 +1877,7 @@ void RankPanel::OnCopyPipeOffset() {
 					target->m_releases.push_back(rel);
 				}
 			}
+			::wxGetApp().m_frame->m_undoHistory->commitStep(undoStep);
 
 			RebuildPipeTree();
 			UpdatePipeTree();
@@ -1766,6 +1887,7 @@ void RankPanel::OnCopyPipeOffset() {
 				m_pipeTreeCtrl->SelectItem(toSelect);
 				m_pipeTreeCtrl->ExpandAllChildren(toSelect);
 			}
+			m_rank->markChanged();
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		}
 	}
@@ -1776,6 +1898,16 @@ void RankPanel::ViewSampleDetails(wxString fullPathToSample) {
 	infoDialog.ShowModal();
 }
 
+SampleTreeClassifier* RankPanel::GetSampleTree(wxString extraAttackFolder, wxString releasePattern, wxString tremulantPattern, wxString velocityPattern) {
+	// the organ keeps the classified tree of each root folder for other ranks
+	SampleTreeClassifier *sampleTree = ::wxGetApp().m_frame->m_organ->getSampleTree(m_rank->getPipesRootPath());
+	sampleTree->setExtraAttackFolder(extraAttackFolder);
+	sampleTree->setReleasePattern(releasePattern);
+	sampleTree->setTremulantPattern(tremulantPattern);
+	sampleTree->setVelocityPattern(velocityPattern);
+	return sampleTree;
+}
+
 wxTreeItemId RankPanel::GetPipeTreeItemAt(int index) {
 	int pipesInTree = m_pipeTreeCtrl->GetChildrenCount(m_tree_rank_root, false);
 	wxTreeItemIdValue cookie;
@@ -1811,21 +1943,29 @@ wxTreeItemId RankPanel::GetPipeOfSelection() {
 
 void RankPanel::OnAmplitudeLevelSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setAmplitudeLevel(m_amplitudeLevelSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void RankPanel::OnGainSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setGain(m_gainSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void RankPanel::OnPitchTuningSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
 	m_rank->setPitchTuning(m_pitchTuningSpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void RankPanel::OnTrackerDelaySpin(wxSpinEvent& WXUNUSED(event)) {
 	m_rank->setTrackerDelay(m_trackerDelaySpin->GetValue());
+	m_rank->markChanged();
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -1852,21 +1992,21 @@ void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
-		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
+		SampleTreeClassifier *sampleTree = GetSampleTree(
+			m_optionsAttackField->GetValue(),
+			m_optionsReleaseField->GetValue(),
+			m_optionsTremulantField->GetValue()
+		);
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
 		bool loadRelease = m_optionsLoadReleaseInAttack->GetValue();
-		wxString releaseFolderPrefix = m_optionsReleaseField->GetValue();
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
-		wxString tremulantFolderPrefix = m_optionsTremulantField->GetValue();
 		bool loadPipesTremOff = m_loadPipesAsTremOffCheck->GetValue();
 
 		m_rank->addToPipes(
-			extraAttackFolderPrefix,
+			*sampleTree,
 			loadOnlyOneAttack,
 			loadRelease,
-			releaseFolderPrefix,
 			extractKeyPressTime,
-			tremulantFolderPrefix,
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
@@ -1875,6 +2015,8 @@ void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 		RebuildPipeTree();
 		UpdatePipeTree();
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1902,17 +2044,19 @@ void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
-		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
+		SampleTreeClassifier *sampleTree = GetSampleTree(
+			m_optionsAttackField->GetValue(),
+			m_optionsReleaseField->GetValue(),
+			wxEmptyString
+		);
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
 		bool loadRelease = m_optionsLoadReleaseInAttack->GetValue();
-		wxString releaseFolderPrefix = m_optionsReleaseField->GetValue();
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
 
 		m_rank->addTremulantToPipes(
-			extraAttackFolderPrefix,
+			*sampleTree,
 			loadOnlyOneAttack,
 			loadRelease,
-			releaseFolderPrefix,
 			extractKeyPressTime,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
@@ -1921,6 +2065,8 @@ void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 		RebuildPipeTree();
 		UpdatePipeTree();
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1956,8 +2102,10 @@ void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
 		bool loadPipesTremOff = m_loadPipesAsTremOffCheck->GetValue();
+		SampleTreeClassifier *sampleTree = GetSampleTree(wxEmptyString, wxEmptyString, wxEmptyString);
 
 		m_rank->addReleasesToPipes(
+			*sampleTree,
 			loadPipesTremOff,
 			0,
 			m_rank->getFirstMidiNoteNumber(),
@@ -1966,6 +2114,8 @@ void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
 
 		RebuildPipeTree();
 		UpdatePipeTree();
+		m_rank->markChanged();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1994,16 +2144,22 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 
 	if (loadingDialog.ShowModal() == wxID_OK) {
 		m_rank->setPipesRootPath(loadingDialog.GetBaseDirectory());
-		switch (loadingDialog.GetSelectedStrategy()) {
+		// tremulant folders are only told apart when attacks are added as well
+		int strategy = loadingDialog.GetSelectedStrategy();
+		SampleTreeClassifier *sampleTree = GetSampleTree(
+			loadingDialog.GetSubDirectory(),
+			loadingDialog.GetReleaseFolderPrefix(),
+			strategy < 2 ? loadingDialog.GetTremFolderPrefix() : wxString(wxEmptyString),
+			loadingDialog.GetVelocityFolderPrefix()
+		);
+		switch (strategy) {
 			case 0:
 				// Create new pipe(s) by number matching
 				m_rank->readPipes(
-					loadingDialog.GetSubDirectory(),
+					*sampleTree,
 					loadingDialog.GetLoadOnlyOneAttack(),
 					loadingDialog.GetLoadReleaseInAttack(),
-					loadingDialog.GetReleaseFolderPrefix(),
 					loadingDialog.GetExtractKeyPressTime(),
-					loadingDialog.GetTremFolderPrefix(),
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
@@ -2013,12 +2169,10 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 			case 1:
 				// Add more samples to pipe(s)
 				m_rank->addToPipes(
-					loadingDialog.GetSubDirectory(),
+					*sampleTree,
 					loadingDialog.GetLoadOnlyOneAttack(),
 					loadingDialog.GetLoadReleaseInAttack(),
-					loadingDialog.GetReleaseFolderPrefix(),
 					loadingDialog.GetExtractKeyPressTime(),
-					loadingDialog.GetTremFolderPrefix(),
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
@@ -2028,10 +2182,9 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 			case 2:
 				// Add tremulant samples to pipe(s)
 				m_rank->addTremulantToPipes(
-					loadingDialog.GetSubDirectory(),
+					*sampleTree,
 					loadingDialog.GetLoadOnlyOneAttack(),
 					loadingDialog.GetLoadReleaseInAttack(),
-					loadingDialog.GetReleaseFolderPrefix(),
 					loadingDialog.GetExtractKeyPressTime(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
@@ -2041,6 +2194,7 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 			case 3:
 				// Add release samples to pipe(s)
 				m_rank->addReleasesToPipes(
+					*sampleTree,
 					loadingDialog.GetLoadPipesTremOff(),
 					loadingDialog.GetStartingPipeNumber() - 1,
 					loadingDialog.GetFirstMidiMatchingNbr(),
@@ -2063,6 +2217,9 @@ void RankPanel::OnFlexiblePipeLoadingBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 
+		m_rank->markChanged();
+
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_rank);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -86,6 +86,8 @@ private:
 	wxButton *m_expandTreeBtn;
 	wxButton *m_addReleaseSamplesBtn;
 	wxButton *m_flexiblePipeLoadingBtn;
+	wxButton *m_autoTrimSamplesBtn;
+	wxButton *m_renderPreviewBtn;
 
 	wxButton *removeRankBtn;
 
@@ -119,6 +121,8 @@ private:
 	void OnRemoveRankBtn(wxCommandEvent& event);
 	void DoRemoveRank();
 	void OnClearPipesBtn(wxCommandEvent& event);
+	void OnAutoTrimSamplesBtn(wxCommandEvent& event);
+	void OnRenderPreviewBtn(wxCommandEvent& event);
 	void OnPipeTreeItemRightClick(wxTreeEvent &evt);
 	void OnPopupMenuClick(wxCommandEvent &evt);
 	void OnAmplitudeLevelSpin(wxSpinDoubleEvent& event);
@@ -160,6 +164,7 @@ private:
 	wxTreeItemId GetPipeTreeItemAt(int index);
 	wxTreeItemId GetPipeOfSelection();
 	void OnPipeReadingOptionsChanged();
+	SampleTreeClassifier* GetSampleTree(wxString extraAttackFolder, wxString releasePattern, wxString tremulantPattern, wxString velocityPattern = wxEmptyString);
 
 };
 
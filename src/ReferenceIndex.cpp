@@ -0,0 +1,175 @@
+/*
+ * ReferenceIndex.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ReferenceIndex.h"
+#include "GOODF.h"
+#include "Organ.h"
+#include <algorithm>
+
+ReferenceIndex::ReferenceIndex() {
+	m_isValid = false;
+}
+
+ReferenceIndex::~ReferenceIndex() {
+
+}
+
+bool ReferenceIndex::isValid() {
+	return m_isValid;
+}
+
+void ReferenceIndex::invalidate() {
+	m_isValid = false;
+	m_referrerTypes.clear();
+	m_referencesOf.clear();
+	m_referrersOf.clear();
+}
+
+void ReferenceIndex::clear() {
+	invalidate();
+	m_isValid = true;
+}
+
+void ReferenceIndex::addReferrer(ELEMENT_REFERRER_TYPE type, void *element) {
+	if (!m_isValid)
+		return;
+	if (m_referrerTypes.count(element))
+		unregisterReferences(element);
+	m_referrerTypes[element] = type;
+	registerReferences(type, element);
+}
+
+void ReferenceIndex::removeReferrer(void *element) {
+	if (!m_isValid)
+		return;
+	unregisterReferences(element);
+	m_referrerTypes.erase(element);
+}
+
+void ReferenceIndex::removeReferenced(const void *referenced) {
+	if (!m_isValid)
+		return;
+	auto found = m_referrersOf.find(referenced);
+	if (found == m_referrersOf.end())
+		return;
+	for (ELEMENT_REFERRER &referrer : found->second) {
+		std::vector<const void*> &references = m_referencesOf[referrer.element];
+		references.erase(std::remove(references.begin(), references.end(), referenced), references.end());
+	}
+	m_referrersOf.erase(found);
+}
+
+void ReferenceIndex::updateReferrer(void *element) {
+	if (!m_isValid)
+		return;
+	auto found = m_referrerTypes.find(element);
+	if (found == m_referrerTypes.end())
+		return;
+	unregisterReferences(element);
+	registerReferences(found->second, element);
+}
+
+const std::vector<ELEMENT_REFERRER>& ReferenceIndex::getReferrers(const void *referenced) {
+	auto found = m_referrersOf.find(referenced);
+	if (found == m_referrersOf.end())
+		return m_noReferrers;
+	return found->second;
+}
+
+void ReferenceIndex::referrerHasChanged(void *element) {
+	Organ *organ = ::wxGetApp().m_frame->m_organ;
+	if (organ)
+		organ->getReferenceIndex()->updateReferrer(element);
+}
+
+void ReferenceIndex::registerReferences(ELEMENT_REFERRER_TYPE type, void *element) {
+	std::vector<const void*> &references = m_referencesOf[element];
+	getReferencesOf(type, element, references);
+	ELEMENT_REFERRER referrer;
+	referrer.type = type;
+	referrer.element = element;
+	for (const void *referenced : references)
+		m_referrersOf[referenced].push_back(referrer);
+}
+
+void ReferenceIndex::unregisterReferences(void *element) {
+	auto found = m_referencesOf.find(element);
+	if (found == m_referencesOf.end())
+		return;
+	for (const void *referenced : found->second) {
+		auto referrers = m_referrersOf.find(referenced);
+		if (referrers == m_referrersOf.end())
+			continue;
+		referrers->second.erase(
+			std::remove_if(referrers->second.begin(), referrers->second.end(), [element](const ELEMENT_REFERRER &r) { return r.element == element; }),
+			referrers->second.end()
+		);
+		if (referrers->second.empty())
+			m_referrersOf.erase(referrers);
+	}
+	m_referencesOf.erase(found);
+}
+
+void ReferenceIndex::getReferencesOf(ELEMENT_REFERRER_TYPE type, void *element, std::vector<const void*> &references) {
+	references.clear();
+	switch (type) {
+		case REFERRER_DIVISIONAL: {
+			Divisional *divisional = static_cast<Divisional*>(element);
+			for (unsigned i = 0; i < divisional->getNumberOfSwitches(); i++)
+				references.push_back(divisional->getSwitchPairAt(i)->first);
+			for (unsigned i = 0; i < divisional->getNumberOfTremulants(); i++)
+				references.push_back(divisional->getTremulantPairAt(i)->first);
+			break;
+		}
+		case REFERRER_GENERAL: {
+			General *general = static_cast<General*>(element);
+			for (unsigned i = 0; i < general->getNumberOfSwitches(); i++)
+				references.push_back(general->getSwitchPairAt(i)->first);
+			for (unsigned i = 0; i < general->getNumberOfTremulants(); i++)
+				references.push_back(general->getTremulantPairAt(i)->first);
+			break;
+		}
+		case REFERRER_REVERSIBLE_PISTON: {
+			ReversiblePiston *piston = static_cast<ReversiblePiston*>(element);
+			if (piston->getSwitch())
+				references.push_back(piston->getSwitch());
+			if (piston->getTremulant())
+				references.push_back(piston->getTremulant());
+			break;
+		}
+		case REFERRER_MANUAL: {
+			Manual *manual = static_cast<Manual*>(element);
+			for (unsigned i = 0; i < manual->getNumberOfGoSwitches(); i++)
+				references.push_back(manual->getGoSwitchAt(i));
+			for (unsigned i = 0; i < manual->getNumberOfTremulants(); i++)
+				references.push_back(manual->getTremulantAt(i));
+			break;
+		}
+		default: {
+			Drawstop *drawstop = static_cast<Drawstop*>(element);
+			for (unsigned i = 0; i < drawstop->getNumberOfSwitches(); i++)
+				references.push_back(drawstop->getSwitchAtIndex(i));
+			break;
+		}
+	}
+	// an element referencing the same switch twice is still only one referrer
+	std::sort(references.begin(), references.end());
+	references.erase(std::unique(references.begin(), references.end()), references.end());
+}
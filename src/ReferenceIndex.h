@@ -0,0 +1,89 @@
+/*
+ * ReferenceIndex.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef REFERENCEINDEX_H
+#define REFERENCEINDEX_H
+
+#include <unordered_map>
+#include <vector>
+
+class GoSwitch;
+class Tremulant;
+
+typedef enum {
+	REFERRER_STOP,
+	REFERRER_SWITCH,
+	REFERRER_TREMULANT,
+	REFERRER_COUPLER,
+	REFERRER_DIVISIONAL_COUPLER,
+	REFERRER_DIVISIONAL,
+	REFERRER_GENERAL,
+	REFERRER_REVERSIBLE_PISTON,
+	REFERRER_MANUAL
+} ELEMENT_REFERRER_TYPE;
+
+// The element is a Drawstop* for stops, switches, tremulants, couplers and
+// divisional couplers, otherwise a pointer to the type itself.
+struct ELEMENT_REFERRER {
+	ELEMENT_REFERRER_TYPE type;
+	void *element;
+};
+
+// Keeps track of which organ elements reference each switch and tremulant so
+// that checks and removal cascades don't have to scan the whole organ. The
+// organ registers its elements when they're added or removed and the elements
+// report changes of their references through referrerHasChanged. Changes of
+// elements that aren't (yet) part of the organ are ignored, they are picked up
+// when the element is added.
+class ReferenceIndex {
+
+public:
+	ReferenceIndex();
+	~ReferenceIndex();
+
+	bool isValid();
+	// the index is built again from the organ the next time it's needed
+	void invalidate();
+	// empties a valid index that the organ then adds all its elements to
+	void clear();
+
+	void addReferrer(ELEMENT_REFERRER_TYPE type, void *element);
+	void removeReferrer(void *element);
+	// the element is removed as a target of references
+	void removeReferenced(const void *referenced);
+	void updateReferrer(void *element);
+	const std::vector<ELEMENT_REFERRER>& getReferrers(const void *referenced);
+
+	// called by the elements after their switch or tremulant references changed
+	static void referrerHasChanged(void *element);
+
+private:
+	bool m_isValid;
+	std::unordered_map<void*, ELEMENT_REFERRER_TYPE> m_referrerTypes;
+	std::unordered_map<void*, std::vector<const void*> > m_referencesOf;
+	std::unordered_map<const void*, std::vector<ELEMENT_REFERRER> > m_referrersOf;
+	std::vector<ELEMENT_REFERRER> m_noReferrers;
+
+	void registerReferences(ELEMENT_REFERRER_TYPE type, void *element);
+	void unregisterReferences(void *element);
+	static void getReferencesOf(ELEMENT_REFERRER_TYPE type, void *element, std::vector<const void*> &references);
+};
+
+#endif
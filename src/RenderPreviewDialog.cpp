@@ -0,0 +1,279 @@
+/*
+ * RenderPreviewDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "RenderPreviewDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/msgdlg.h>
+#include <cmath>
+#include "GOODF.h"
+
+// remembered between uses during the session
+static wxString s_lastNoteList = wxT("36 48 60 72 84");
+static double s_lastNoteLength = 2.0;
+static double s_lastGap = 0.5;
+
+IMPLEMENT_CLASS(RenderPreviewDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(RenderPreviewDialog, wxDialog)
+	EVT_BUTTON(ID_RENDER_PREVIEW_BROWSE_BTN, RenderPreviewDialog::OnBrowseBtn)
+	EVT_TEXT(ID_RENDER_PREVIEW_NOTES_TEXT, RenderPreviewDialog::OnNotesText)
+END_EVENT_TABLE()
+
+RenderPreviewDialog::RenderPreviewDialog(wxString outputPath) {
+	Init(outputPath);
+}
+
+RenderPreviewDialog::RenderPreviewDialog(
+	wxString outputPath,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(outputPath);
+	Create(parent, id, caption, pos, size, style);
+}
+
+RenderPreviewDialog::~RenderPreviewDialog() {
+
+}
+
+void RenderPreviewDialog::Init(wxString outputPath) {
+	m_outputPath = outputPath;
+	m_notesField = NULL;
+	m_noteLengthSpin = NULL;
+	m_gapSpin = NULL;
+	m_outputPathField = NULL;
+}
+
+bool RenderPreviewDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void RenderPreviewDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *notesText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("MIDI notes: ")
+	);
+	firstRow->Add(notesText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_notesField = new wxTextCtrl(
+		this,
+		ID_RENDER_PREVIEW_NOTES_TEXT,
+		s_lastNoteList,
+		wxDefaultPosition,
+		wxSize(320, -1)
+	);
+	m_notesField->SetToolTip(wxT("Notes are played one after another, 60-72 plays a chromatic range and 60+64+67 plays a chord."));
+	firstRow->Add(m_notesField, 1, wxEXPAND|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *lengthText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Key held (s): ")
+	);
+	secondRow->Add(lengthText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_noteLengthSpin = new wxSpinCtrlDouble(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0.05,
+		60,
+		s_lastNoteLength,
+		0.05
+	);
+	m_noteLengthSpin->SetDigits(2);
+	secondRow->Add(m_noteLengthSpin, 0, wxEXPAND|wxALL, 5);
+	secondRow->AddStretchSpacer();
+	wxStaticText *gapText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Gap between notes (s): ")
+	);
+	secondRow->Add(gapText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_gapSpin = new wxSpinCtrlDouble(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0,
+		60,
+		s_lastGap,
+		0.05
+	);
+	m_gapSpin->SetDigits(2);
+	secondRow->Add(m_gapSpin, 0, wxEXPAND|wxALL, 5);
+	mainSizer->Add(secondRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *outputText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Output file: ")
+	);
+	thirdRow->Add(outputText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_outputPathField = new wxTextCtrl(
+		this,
+		wxID_ANY,
+		m_outputPath,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxTE_READONLY
+	);
+	thirdRow->Add(m_outputPathField, 1, wxEXPAND|wxALL, 5);
+	wxButton *browseBtn = new wxButton(
+		this,
+		ID_RENDER_PREVIEW_BROWSE_BTN,
+		wxT("Browse..."),
+		wxDefaultPosition,
+		wxDefaultSize,
+		0
+	);
+	thirdRow->Add(browseBtn, 0, wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Render")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+
+	UpdateOkButton();
+}
+
+bool RenderPreviewDialog::GetNotes(std::vector<PREVIEW_NOTE> &notes) {
+	s_lastNoteList = m_notesField->GetValue();
+	s_lastNoteLength = m_noteLengthSpin->GetValue();
+	s_lastGap = m_gapSpin->GetValue();
+	return PreviewRenderer::parseNoteList(s_lastNoteList, s_lastNoteLength, s_lastGap, notes);
+}
+
+wxString RenderPreviewDialog::GetOutputPath() {
+	return m_outputPath;
+}
+
+void RenderPreviewDialog::UpdateOkButton() {
+	std::vector<PREVIEW_NOTE> notes;
+	bool notesOk = PreviewRenderer::parseNoteList(m_notesField->GetValue(), 1, 0, notes);
+	wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
+	if (okBtn)
+		okBtn->Enable(notesOk && m_outputPath != wxEmptyString);
+}
+
+void RenderPreviewDialog::OnBrowseBtn(wxCommandEvent& WXUNUSED(event)) {
+	wxFileName current(m_outputPath);
+	wxFileDialog fileDialog(
+		this,
+		wxT("Save preview as"),
+		current.GetPath(),
+		current.GetFullName(),
+		"WAVE files (*.wav)|*.wav",
+		wxFD_SAVE|wxFD_OVERWRITE_PROMPT
+	);
+
+	if (fileDialog.ShowModal() == wxID_OK) {
+		m_outputPath = fileDialog.GetPath();
+		m_outputPathField->ChangeValue(m_outputPath);
+		UpdateOkButton();
+	}
+}
+
+void RenderPreviewDialog::OnNotesText(wxCommandEvent& WXUNUSED(event)) {
+	if (m_notesField)
+		UpdateOkButton();
+}
+
+wxString RenderPreviewDialog::GetDefaultOutputPath(wxString elementName) {
+	wxString defaultPath = ::wxGetApp().m_frame->m_organ->getOdfRoot();
+	if (defaultPath == wxEmptyString)
+		defaultPath = wxStandardPaths::Get().GetDocumentsDir();
+
+	wxString fileName = elementName + wxT("_preview.wav");
+	wxString forbidden = wxFileName::GetForbiddenChars();
+	for (unsigned i = 0; i < forbidden.length(); i++)
+		fileName.Replace(wxString(forbidden[i]), wxT("_"));
+
+	return defaultPath + wxFILE_SEP_PATH + fileName;
+}
+
+void RenderPreviewDialog::ShowRenderResult(wxWindow *parent, PreviewRenderer &renderer, bool renderOk, wxString outputPath) {
+	const wxArrayString &warnings = renderer.getWarnings();
+	if (!warnings.IsEmpty()) {
+		for (unsigned i = 0; i < warnings.GetCount(); i++)
+			wxLogWarning(wxT("%s"), warnings[i]);
+		::wxGetApp().m_frame->GetLogWindow()->Show(true);
+	}
+
+	if (renderOk) {
+		float peak = renderer.getPeakLevel();
+		wxString peakStr = peak > 0 ? wxString::Format(wxT("%.1f dBFS"), 20 * std::log10(peak)) : wxString(wxT("silence"));
+		wxMessageDialog msg(parent, wxString::Format(wxT("Rendered %.1f seconds (peak %s) to %s"), renderer.getLength(), peakStr, outputPath), wxT("Preview rendered"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+	} else {
+		wxMessageDialog msg(parent, renderer.getErrorMessage(), wxT("Preview couldn't be rendered"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
+	}
+}
@@ -0,0 +1,88 @@
+/*
+ * RenderPreviewDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RENDERPREVIEWDIALOG_H
+#define RENDERPREVIEWDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/spinctrl.h>
+#include <vector>
+#include "PreviewRenderer.h"
+
+class RenderPreviewDialog : public wxDialog {
+	DECLARE_CLASS(RenderPreviewDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	RenderPreviewDialog(wxString outputPath);
+	RenderPreviewDialog(
+		wxString outputPath,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Render preview to .wav"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~RenderPreviewDialog();
+
+	// Initialize our variables
+	void Init(wxString outputPath);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Render preview to .wav"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	bool GetNotes(std::vector<PREVIEW_NOTE> &notes);
+	wxString GetOutputPath();
+
+	// Helpers for the panels that render previews
+	static wxString GetDefaultOutputPath(wxString elementName);
+	static void ShowRenderResult(wxWindow *parent, PreviewRenderer &renderer, bool renderOk, wxString outputPath);
+
+private:
+	wxString m_outputPath;
+
+	wxTextCtrl *m_notesField;
+	wxSpinCtrlDouble *m_noteLengthSpin;
+	wxSpinCtrlDouble *m_gapSpin;
+	wxTextCtrl *m_outputPathField;
+
+	void UpdateOkButton();
+
+	// Event methods
+	void OnBrowseBtn(wxCommandEvent& event);
+	void OnNotesText(wxCommandEvent& event);
+
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include "ReversiblePiston.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "ReferenceIndex.h"
 
 ReversiblePiston::ReversiblePiston() : Button() {
 	m_stop = NULL;
@@ -107,6 +108,7 @@ void ReversiblePiston::setStop(Stop* stop) {
 		m_switch = NULL;
 	if (m_tremulant)
 		m_tremulant = NULL;
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 Coupler* ReversiblePiston::getCoupler() {
@@ -121,6 +123,7 @@ void ReversiblePiston::setCoupler(Coupler* coupler) {
 		m_switch = NULL;
 	if (m_tremulant)
 		m_tremulant = NULL;
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 GoSwitch* ReversiblePiston::getSwitch() {
@@ -135,6 +138,7 @@ void ReversiblePiston::setSwitch(GoSwitch* sw) {
 		m_coupler = NULL;
 	if (m_tremulant)
 		m_tremulant = NULL;
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 Tremulant* ReversiblePiston::getTremulant() {
@@ -149,6 +153,7 @@ void ReversiblePiston::setTremulant(Tremulant* tremulant) {
 		m_coupler = NULL;
 	if (m_switch)
 		m_switch = NULL;
+	ReferenceIndex::referrerHasChanged(this);
 }
 
 wxString ReversiblePiston::getObjecType() {
@@ -0,0 +1,158 @@
+/*
+ * SampleEnvelope.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleEnvelope.h"
+#include <algorithm>
+#include <cmath>
+
+SampleEnvelope::SampleEnvelope(WAVsampleReader &reader, unsigned windowSize) {
+	m_errorMessage = wxEmptyString;
+	m_windowSize = windowSize > 0 ? windowSize : 256;
+	m_numberOfFrames = 0;
+	m_sampleRate = 0;
+	m_noiseFloor = -200;
+	m_peakLevel = -200;
+
+	m_isOk = analyze(reader);
+}
+
+SampleEnvelope::~SampleEnvelope() {
+
+}
+
+bool SampleEnvelope::isOk() {
+	return m_isOk;
+}
+
+wxString SampleEnvelope::getErrorMessage() {
+	return m_errorMessage;
+}
+
+unsigned SampleEnvelope::getNumberOfFrames() {
+	return m_numberOfFrames;
+}
+
+unsigned SampleEnvelope::getSampleRate() {
+	return m_sampleRate;
+}
+
+unsigned SampleEnvelope::getWindowSize() {
+	return m_windowSize;
+}
+
+double SampleEnvelope::getNoiseFloor() {
+	return m_noiseFloor;
+}
+
+double SampleEnvelope::getPeakLevel() {
+	return m_peakLevel;
+}
+
+int SampleEnvelope::findOnset(double marginDb) {
+	if (!m_isOk)
+		return -1;
+
+	double threshold = m_noiseFloor + marginDb;
+	if (threshold >= m_peakLevel)
+		return -1;
+
+	for (unsigned i = 0; i < m_levels.size(); i++) {
+		if (m_levels[i] >= threshold) {
+			if (i < 2)
+				return 0;
+			return (int) ((i - 1) * m_windowSize);
+		}
+	}
+	return -1;
+}
+
+int SampleEnvelope::findTailEnd(double marginDb) {
+	if (!m_isOk || m_levels.empty())
+		return -1;
+
+	double threshold = m_noiseFloor + marginDb;
+	if (threshold >= m_peakLevel)
+		return -1;
+
+	for (unsigned i = m_levels.size(); i > 0; i--) {
+		if (m_levels[i - 1] >= threshold) {
+			unsigned long endFrame = (unsigned long) (i + 1) * m_windowSize - 1;
+			if (endFrame >= m_numberOfFrames - 1)
+				return (int) m_numberOfFrames - 1;
+			return (int) endFrame;
+		}
+	}
+	return -1;
+}
+
+bool SampleEnvelope::analyze(WAVsampleReader &reader) {
+	if (!reader.isOk()) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+
+	m_numberOfFrames = reader.getNumberOfFrames();
+	m_sampleRate = reader.getSampleRate();
+	unsigned channels = reader.getNumberOfChannels();
+	if (m_numberOfFrames < m_windowSize * 4) {
+		m_errorMessage = wxT("Sample is too short to analyze.\n");
+		return false;
+	}
+
+	m_levels.reserve(m_numberOfFrames / m_windowSize + 1);
+	reader.seekToFrame(0);
+	std::vector<float> block;
+	// decode many windows at a time to keep the number of reads down
+	unsigned framesPerRead = m_windowSize * 64;
+	while (reader.readFrames(block, framesPerRead) > 0) {
+		unsigned framesInBlock = block.size() / channels;
+		for (unsigned start = 0; start < framesInBlock; start += m_windowSize) {
+			unsigned end = std::min(start + m_windowSize, framesInBlock);
+			double sumOfSquares = 0;
+			for (size_t s = (size_t) start * channels; s < (size_t) end * channels; s++)
+				sumOfSquares += (double) block[s] * block[s];
+			double meanSquare = sumOfSquares / ((end - start) * channels);
+			double level = meanSquare > 1e-20 ? 10 * std::log10(meanSquare) : -200;
+			m_levels.push_back((float) level);
+			if (level > m_peakLevel)
+				m_peakLevel = level;
+		}
+	}
+
+	if (m_levels.empty()) {
+		m_errorMessage = wxT("No audio data could be read.\n");
+		return false;
+	}
+
+	// the noise is best estimated at the edges of the sample where silence (if any) lives, about 20 ms worth
+	unsigned edgeWindows = std::max(1u, (unsigned) (m_sampleRate * 0.02 / m_windowSize));
+	edgeWindows = std::min(edgeWindows, (unsigned) m_levels.size());
+	double leadingLevel = medianLevel(0, edgeWindows);
+	double trailingLevel = medianLevel(m_levels.size() - edgeWindows, edgeWindows);
+	m_noiseFloor = std::min(leadingLevel, trailingLevel);
+
+	return true;
+}
+
+double SampleEnvelope::medianLevel(unsigned first, unsigned count) {
+	std::vector<float> part(m_levels.begin() + first, m_levels.begin() + first + count);
+	std::nth_element(part.begin(), part.begin() + part.size() / 2, part.end());
+	return part[part.size() / 2];
+}
@@ -0,0 +1,64 @@
+/*
+ * SampleEnvelope.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEENVELOPE_H
+#define SAMPLEENVELOPE_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "WAVsampleReader.h"
+
+// Follows the level envelope (RMS in dB over fixed windows, all channels)
+// of a sample so that the noise floor, the onset after leading silence and
+// the point where the tail sinks back into the noise can be found.
+class SampleEnvelope {
+
+public:
+	SampleEnvelope(WAVsampleReader &reader, unsigned windowSize = 256);
+	~SampleEnvelope();
+
+	bool isOk();
+	wxString getErrorMessage();
+	unsigned getNumberOfFrames();
+	unsigned getSampleRate();
+	unsigned getWindowSize();
+	double getNoiseFloor();
+	double getPeakLevel();
+
+	// first frame (with one window of pre-roll) where level rises marginDb above the noise floor, -1 if none
+	int findOnset(double marginDb);
+	// last frame (with one window of post-roll) where level is still marginDb above the noise floor, -1 if none
+	int findTailEnd(double marginDb);
+
+private:
+	bool m_isOk;
+	wxString m_errorMessage;
+	unsigned m_windowSize;
+	unsigned m_numberOfFrames;
+	unsigned m_sampleRate;
+	double m_noiseFloor;
+	double m_peakLevel;
+	std::vector<float> m_levels;
+
+	bool analyze(WAVsampleReader &reader);
+	double medianLevel(unsigned first, unsigned count);
+};
+
+#endif
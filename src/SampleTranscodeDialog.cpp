@@ -0,0 +1,221 @@
+/*
+ * SampleTranscodeDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleTranscodeDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <wx/filename.h>
+
+IMPLEMENT_CLASS(SampleTranscodeDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(SampleTranscodeDialog, wxDialog)
+	EVT_CHECKLISTBOX(ID_TRANSCODE_RANK_LIST, SampleTranscodeDialog::OnSelectionChanged)
+	EVT_CHOICE(ID_TRANSCODE_BITS_CHOICE, SampleTranscodeDialog::OnSelectionChanged)
+	EVT_CHECKBOX(ID_TRANSCODE_MONO_CHECK, SampleTranscodeDialog::OnSelectionChanged)
+	EVT_CHECKBOX(ID_TRANSCODE_TRIM_CHECK, SampleTranscodeDialog::OnSelectionChanged)
+	EVT_TEXT(ID_TRANSCODE_FOLDER_TEXT, SampleTranscodeDialog::OnSelectionChanged)
+	EVT_BUTTON(ID_TRANSCODE_SELECT_ALL_BTN, SampleTranscodeDialog::OnSelectAllRanks)
+END_EVENT_TABLE()
+
+SampleTranscodeDialog::SampleTranscodeDialog(Organ *organ) {
+	Init(organ);
+}
+
+SampleTranscodeDialog::SampleTranscodeDialog(
+	Organ *organ,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(organ);
+	Create(parent, id, caption, pos, size, style);
+}
+
+SampleTranscodeDialog::~SampleTranscodeDialog() {
+
+}
+
+void SampleTranscodeDialog::Init(Organ *organ) {
+	m_organ = organ;
+	m_rankList = NULL;
+	m_bitsChoice = NULL;
+	m_monoCheck = NULL;
+	m_trimCheck = NULL;
+	m_folderText = NULL;
+}
+
+bool SampleTranscodeDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void SampleTranscodeDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxArrayString rankNames;
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++) {
+		m_ranks.push_back(m_organ->getOrganRankAt(i));
+		rankNames.Add(m_organ->getOrganRankAt(i)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfStops(); i++) {
+		Stop *stop = m_organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank()) {
+			m_ranks.push_back(stop->getInternalRank());
+			rankNames.Add(stop->getName() + wxT(" (") + stop->getOwningManual()->getName() + wxT(") internal rank"));
+		}
+	}
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *rankText = new wxStaticText(
+		this,
+		wxID_STATIC,
+		wxT("Ranks to transcode:")
+	);
+	firstRow->Add(rankText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxButton *selectAllBtn = new wxButton(
+		this,
+		ID_TRANSCODE_SELECT_ALL_BTN,
+		wxT("Select all")
+	);
+	firstRow->Add(selectAllBtn, 0, wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	m_rankList = new wxCheckListBox(
+		this,
+		ID_TRANSCODE_RANK_LIST,
+		wxDefaultPosition,
+		wxSize(460, 260),
+		rankNames
+	);
+	mainSizer->Add(m_rankList, 1, wxGROW|wxALL, 5);
+
+	wxFlexGridSizer *optionsGrid = new wxFlexGridSizer(2, 5, 5);
+	optionsGrid->AddGrowableCol(1);
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Sample size: ")), 0, wxALIGN_CENTER_VERTICAL);
+	wxArrayString bits;
+	bits.Add(wxT("Keep"));
+	bits.Add(wxT("8 bits"));
+	bits.Add(wxT("16 bits"));
+	bits.Add(wxT("24 bits"));
+	m_bitsChoice = new wxChoice(this, ID_TRANSCODE_BITS_CHOICE, wxDefaultPosition, wxDefaultSize, bits);
+	m_bitsChoice->SetSelection(0);
+	optionsGrid->Add(m_bitsChoice, 0);
+	optionsGrid->Add(new wxStaticText(this, wxID_STATIC, wxT("Output folder: ")), 0, wxALIGN_CENTER_VERTICAL);
+	m_folderText = new wxTextCtrl(this, ID_TRANSCODE_FOLDER_TEXT, wxT("transcoded"));
+	m_folderText->SetToolTip(wxT("Folder relative to the organ file where the sample folders are recreated with the new files"));
+	optionsGrid->Add(m_folderText, 1, wxGROW);
+	mainSizer->Add(optionsGrid, 0, wxGROW|wxALL, 5);
+
+	m_monoCheck = new wxCheckBox(this, ID_TRANSCODE_MONO_CHECK, wxT("Fold stereo samples to mono"));
+	mainSizer->Add(m_monoCheck, 0, wxALL, 5);
+	m_trimCheck = new wxCheckBox(this, ID_TRANSCODE_TRIM_CHECK, wxT("Trim samples before AttackStart and after ReleaseEnd"));
+	mainSizer->Add(m_trimCheck, 0, wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Transcode")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+	UpdateOkButton();
+}
+
+std::vector<Rank*> SampleTranscodeDialog::GetSelectedRanks() {
+	std::vector<Rank*> selected;
+	for (unsigned i = 0; i < m_ranks.size(); i++) {
+		if (m_rankList->IsChecked(i))
+			selected.push_back(m_ranks[i]);
+	}
+	return selected;
+}
+
+TRANSCODE_OPTIONS SampleTranscodeDialog::GetOptions() {
+	static const unsigned BIT_DEPTHS[] = { 0, 8, 16, 24 };
+	TRANSCODE_OPTIONS options;
+	options.bitsPerSample = BIT_DEPTHS[m_bitsChoice->GetSelection()];
+	options.foldToMono = m_monoCheck->GetValue();
+	options.trim = m_trimCheck->GetValue();
+	wxFileName folder = wxFileName::DirName(m_folderText->GetValue().Trim().Trim(false));
+	folder.MakeAbsolute(m_organ->getOdfRoot());
+	options.outputFolder = folder.GetPath();
+	return options;
+}
+
+void SampleTranscodeDialog::UpdateOkButton() {
+	// text events can arrive while the controls are still being created
+	if (!m_trimCheck)
+		return;
+	bool anyRank = false;
+	for (unsigned i = 0; i < m_ranks.size(); i++) {
+		if (m_rankList->IsChecked(i)) {
+			anyRank = true;
+			break;
+		}
+	}
+	bool anyChange = m_bitsChoice->GetSelection() > 0 || m_monoCheck->GetValue() || m_trimCheck->GetValue();
+	// the originals must never be overwritten so an output folder is required
+	bool hasFolder = !m_folderText->GetValue().Trim().Trim(false).IsEmpty();
+
+	wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
+	if (okBtn)
+		okBtn->Enable(anyRank && anyChange && hasFolder);
+}
+
+void SampleTranscodeDialog::OnSelectionChanged(wxCommandEvent& WXUNUSED(event)) {
+	UpdateOkButton();
+}
+
+void SampleTranscodeDialog::OnSelectAllRanks(wxCommandEvent& WXUNUSED(event)) {
+	for (unsigned i = 0; i < m_ranks.size(); i++)
+		m_rankList->Check(i, true);
+	UpdateOkButton();
+}
@@ -0,0 +1,85 @@
+/*
+ * SampleTranscodeDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLETRANSCODEDIALOG_H
+#define SAMPLETRANSCODEDIALOG_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Organ.h"
+#include "SampleTranscoder.h"
+
+class SampleTranscodeDialog : public wxDialog {
+	DECLARE_CLASS(SampleTranscodeDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	SampleTranscodeDialog(Organ *organ);
+	SampleTranscodeDialog(
+		Organ *organ,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Transcode samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~SampleTranscodeDialog();
+
+	// Initialize our variables
+	void Init(Organ *organ);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Transcode samples"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	std::vector<Rank*> GetSelectedRanks();
+	TRANSCODE_OPTIONS GetOptions();
+
+private:
+	Organ *m_organ;
+	std::vector<Rank*> m_ranks;
+
+	wxCheckListBox *m_rankList;
+	wxChoice *m_bitsChoice;
+	wxCheckBox *m_monoCheck;
+	wxCheckBox *m_trimCheck;
+	wxTextCtrl *m_folderText;
+
+	void UpdateOkButton();
+
+	// Event methods
+	void OnSelectionChanged(wxCommandEvent& event);
+	void OnSelectAllRanks(wxCommandEvent& event);
+
+};
+
+#endif
@@ -0,0 +1,644 @@
+/*
+ * SampleTranscoder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleTranscoder.h"
+#include "ParallelTaskRunner.h"
+#include "WAVfileParser.h"
+#include "TraceRecorder.h"
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <cstdint>
+
+// number of frames converted at a time
+static const unsigned BLOCK_FRAMES = 32768;
+
+struct SOURCE_INFO {
+	bool isSupported;
+	unsigned numberOfFrames;
+	unsigned numberOfChannels;
+	unsigned bytesPerSample;
+	std::vector<std::pair<unsigned, unsigned>> loops;
+	std::vector<unsigned> cues;
+};
+
+static bool isSamplePath(const wxString &path) {
+	return path != wxEmptyString && !path.IsSameAs(wxT("DUMMY"), false) && !path.StartsWith(wxT("REF"));
+}
+
+static uint32_t readUint32(const unsigned char *p) {
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void writeUint32(unsigned char *p, uint32_t value) {
+	p[0] = value & 0xFF;
+	p[1] = (value >> 8) & 0xFF;
+	p[2] = (value >> 16) & 0xFF;
+	p[3] = (value >> 24) & 0xFF;
+}
+
+static uint16_t readUint16(const unsigned char *p) {
+	return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static void writeUint16(unsigned char *p, uint16_t value) {
+	p[0] = value & 0xFF;
+	p[1] = (value >> 8) & 0xFF;
+}
+
+// the sample kernels work on whole blocks of left justified 32 bit values so
+// that the loops stay simple enough for the compiler to vectorize
+static void decodeSamples(const unsigned char *in, int32_t *out, size_t count, unsigned bytesPerSample) {
+	switch (bytesPerSample) {
+		case 1:
+			for (size_t i = 0; i < count; i++)
+				out[i] = (int32_t) ((uint32_t) (in[i] - 128) << 24);
+			break;
+		case 2:
+			for (size_t i = 0; i < count; i++)
+				out[i] = (int32_t) (((uint32_t) in[2 * i] << 16) | ((uint32_t) in[2 * i + 1] << 24));
+			break;
+		case 3:
+			for (size_t i = 0; i < count; i++)
+				out[i] = (int32_t) (((uint32_t) in[3 * i] << 8) | ((uint32_t) in[3 * i + 1] << 16) | ((uint32_t) in[3 * i + 2] << 24));
+			break;
+		default:
+			for (size_t i = 0; i < count; i++)
+				out[i] = (int32_t) readUint32(in + 4 * i);
+			break;
+	}
+}
+
+static void foldToMono(int32_t *samples, size_t frames, unsigned channels) {
+	for (size_t i = 0; i < frames; i++) {
+		int64_t sum = 0;
+		for (unsigned c = 0; c < channels; c++)
+			sum += samples[i * channels + c];
+		samples[i] = (int32_t) (sum / (int64_t) channels);
+	}
+}
+
+// rounds to the new depth, values that would round above the maximum are clipped
+static void reduceDepth(int32_t *samples, size_t count, unsigned bytesPerSample) {
+	if (bytesPerSample >= 4)
+		return;
+	int64_t half = (int64_t) 1 << (31 - 8 * bytesPerSample);
+	for (size_t i = 0; i < count; i++)
+		samples[i] = (int32_t) std::min<int64_t>((int64_t) samples[i] + half, INT32_MAX);
+}
+
+static void encodeSamples(const int32_t *in, unsigned char *out, size_t count, unsigned bytesPerSample) {
+	switch (bytesPerSample) {
+		case 1:
+			for (size_t i = 0; i < count; i++)
+				out[i] = (unsigned char) ((in[i] >> 24) + 128);
+			break;
+		case 2:
+			for (size_t i = 0; i < count; i++) {
+				out[2 * i] = (in[i] >> 16) & 0xFF;
+				out[2 * i + 1] = (in[i] >> 24) & 0xFF;
+			}
+			break;
+		case 3:
+			for (size_t i = 0; i < count; i++) {
+				out[3 * i] = (in[i] >> 8) & 0xFF;
+				out[3 * i + 1] = (in[i] >> 16) & 0xFF;
+				out[3 * i + 2] = (in[i] >> 24) & 0xFF;
+			}
+			break;
+		default:
+			for (size_t i = 0; i < count; i++)
+				writeUint32(out + 4 * i, (uint32_t) in[i]);
+			break;
+	}
+}
+
+// moves the loops of a smpl chunk to the trimmed start and drops the ones outside
+static void adjustSmplChunk(std::vector<unsigned char> &chunk, unsigned startFrame, unsigned endFrame) {
+	if (chunk.size() < 36)
+		return;
+	unsigned nbrOfLoops = readUint32(&chunk[28]);
+	size_t loopsEnd = 36 + (size_t) nbrOfLoops * 24;
+	if (loopsEnd > chunk.size())
+		return;
+	std::vector<unsigned char> adjusted(chunk.begin(), chunk.begin() + 36);
+	unsigned nbrKept = 0;
+	for (unsigned i = 0; i < nbrOfLoops; i++) {
+		const unsigned char *loop = &chunk[36 + i * 24];
+		unsigned start = readUint32(loop + 8);
+		unsigned end = readUint32(loop + 12);
+		if (start < startFrame || end >= endFrame)
+			continue;
+		size_t pos = adjusted.size();
+		adjusted.insert(adjusted.end(), loop, loop + 24);
+		writeUint32(&adjusted[pos + 8], start - startFrame);
+		writeUint32(&adjusted[pos + 12], end - startFrame);
+		nbrKept++;
+	}
+	adjusted.insert(adjusted.end(), chunk.begin() + loopsEnd, chunk.end());
+	writeUint32(&adjusted[28], nbrKept);
+	chunk.swap(adjusted);
+}
+
+static void adjustCueChunk(std::vector<unsigned char> &chunk, unsigned startFrame, unsigned endFrame) {
+	if (chunk.size() < 4)
+		return;
+	unsigned nbrOfCues = readUint32(&chunk[0]);
+	if (4 + (size_t) nbrOfCues * 24 > chunk.size())
+		return;
+	std::vector<unsigned char> adjusted(chunk.begin(), chunk.begin() + 4);
+	unsigned nbrKept = 0;
+	for (unsigned i = 0; i < nbrOfCues; i++) {
+		const unsigned char *cue = &chunk[4 + i * 24];
+		unsigned position = readUint32(cue + 4);
+		unsigned offset = readUint32(cue + 20);
+		if (offset < startFrame || offset >= endFrame)
+			continue;
+		size_t pos = adjusted.size();
+		adjusted.insert(adjusted.end(), cue, cue + 24);
+		writeUint32(&adjusted[pos + 4], position >= startFrame ? position - startFrame : 0);
+		writeUint32(&adjusted[pos + 20], offset - startFrame);
+		nbrKept++;
+	}
+	writeUint32(&adjusted[0], nbrKept);
+	chunk.swap(adjusted);
+}
+
+SampleTranscoder::SampleTranscoder(Organ *organ, const std::vector<Rank*> &ranks, const TRANSCODE_OPTIONS &options, unsigned nbrOfThreads, unsigned maxConcurrentIo) {
+	m_organ = organ;
+	m_ranks = ranks;
+	m_options = options;
+	m_nbrOfThreads = nbrOfThreads;
+	m_maxConcurrentIo = maxConcurrentIo;
+}
+
+SampleTranscoder::~SampleTranscoder() {
+
+}
+
+bool SampleTranscoder::prepare(wxProgressDialog *progress) {
+	TraceScope trace("SampleTranscoder::prepare");
+	m_usages.clear();
+	m_jobs.clear();
+	m_skippedFiles.Clear();
+
+	std::vector<wxString> paths;
+	for (Rank *rank : m_ranks) {
+		for (Pipe &pipe : rank->m_pipes) {
+			if (pipe.m_attacks.empty() || pipe.isFirstAttackRefPath())
+				continue;
+			for (Attack &atk : pipe.m_attacks) {
+				if (isSamplePath(atk.fullPath)) {
+					m_usages.push_back(TRANSCODE_USAGE{&atk, NULL, 0});
+					paths.push_back(atk.fullPath);
+				}
+			}
+			for (Release &rel : pipe.m_releases) {
+				if (isSamplePath(rel.fullPath)) {
+					m_usages.push_back(TRANSCODE_USAGE{NULL, &rel, 0});
+					paths.push_back(rel.fullPath);
+				}
+			}
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+	paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+	std::vector<SOURCE_INFO> infos(paths.size());
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	bool completed = runner.run(paths.size(), [&paths, &infos](unsigned i) {
+		SOURCE_INFO &info = infos[i];
+		info.isSupported = false;
+		WAVfileParser wav(paths[i]);
+		if (!wav.isWavOk() || wav.isWavPacked() || wav.getSubFormat() != 1 || wav.getNumberOfChannels() == 0)
+			return;
+		info.numberOfChannels = wav.getNumberOfChannels();
+		info.bytesPerSample = wav.getBlockAlign() / info.numberOfChannels;
+		if (info.bytesPerSample < 1 || info.bytesPerSample > 4)
+			return;
+		info.isSupported = true;
+		info.numberOfFrames = wav.getNumberOfFrames();
+		for (unsigned j = 0; j < wav.getNumberOfLoops(); j++)
+			info.loops.push_back(std::make_pair(wav.getLoopAtIndex(j).dwStart, wav.getLoopAtIndex(j).dwEnd));
+		for (unsigned j = 0; j < wav.getNumberOfCues(); j++)
+			info.cues.push_back(wav.getCuepointAtIndex(j).dwSampleOffset);
+	}, progress, wxT("Reading sample headers..."));
+	if (!completed)
+		return false;
+
+	std::map<wxString, unsigned> infoIndex;
+	for (unsigned i = 0; i < paths.size(); i++) {
+		infoIndex[paths[i]] = i;
+		if (!infos[i].isSupported)
+			m_skippedFiles.Add(paths[i]);
+	}
+
+	// every source file gets one job for each different part of it that is used
+	std::map<std::pair<wxString, std::pair<unsigned, unsigned>>, unsigned> jobIndex;
+	std::set<wxString> usedTargets;
+	std::vector<TRANSCODE_USAGE> changedUsages;
+	for (TRANSCODE_USAGE &usage : m_usages) {
+		wxString path = usage.attack ? usage.attack->fullPath : usage.release->fullPath;
+		SOURCE_INFO &info = infos[infoIndex[path]];
+		if (!info.isSupported)
+			continue;
+		unsigned start = 0;
+		unsigned end = info.numberOfFrames;
+		if (m_options.trim) {
+			// the part kept must still contain all loops and cue points used
+			unsigned firstNeeded = info.numberOfFrames;
+			unsigned lastNeeded = 0;
+			int releaseEnd;
+			if (usage.attack) {
+				Attack *atk = usage.attack;
+				if (atk->attackStart > 0)
+					start = atk->attackStart;
+				if (!atk->m_loops.empty()) {
+					for (Loop &loop : atk->m_loops) {
+						firstNeeded = std::min<unsigned>(firstNeeded, std::max(loop.start, 0));
+						lastNeeded = std::max<unsigned>(lastNeeded, std::max(loop.end, 0));
+					}
+				} else {
+					for (auto &loop : info.loops) {
+						firstNeeded = std::min(firstNeeded, loop.first);
+						lastNeeded = std::max(lastNeeded, loop.second);
+					}
+				}
+				if (atk->cuePoint >= 0) {
+					firstNeeded = std::min<unsigned>(firstNeeded, atk->cuePoint);
+					lastNeeded = std::max<unsigned>(lastNeeded, atk->cuePoint);
+				}
+				releaseEnd = atk->releaseEnd;
+			} else {
+				if (usage.release->cuePoint >= 0)
+					lastNeeded = std::max<unsigned>(lastNeeded, usage.release->cuePoint);
+				releaseEnd = usage.release->releaseEnd;
+			}
+			for (unsigned cue : info.cues) {
+				firstNeeded = std::min(firstNeeded, cue);
+				lastNeeded = std::max(lastNeeded, cue);
+			}
+			start = std::min(start, firstNeeded);
+			if (releaseEnd > 0 && (unsigned) releaseEnd < end)
+				end = std::max<unsigned>(releaseEnd, lastNeeded + 1);
+			end = std::min(end, info.numberOfFrames);
+			if (start >= end) {
+				start = 0;
+				end = info.numberOfFrames;
+			}
+		}
+		bool changesDepth = m_options.bitsPerSample > 0 && m_options.bitsPerSample / 8 < info.bytesPerSample;
+		bool changesChannels = m_options.foldToMono && info.numberOfChannels > 1;
+		if (start == 0 && end == info.numberOfFrames && !changesDepth && !changesChannels)
+			continue;
+
+		std::pair<wxString, std::pair<unsigned, unsigned>> key = std::make_pair(path, std::make_pair(start, end));
+		std::map<std::pair<wxString, std::pair<unsigned, unsigned>>, unsigned>::iterator it = jobIndex.find(key);
+		if (it == jobIndex.end()) {
+			TRANSCODE_JOB job;
+			job.sourcePath = path;
+			job.targetPath = getTargetPath(path, usedTargets);
+			job.numberOfFrames = info.numberOfFrames;
+			job.startFrame = start;
+			job.endFrame = end;
+			job.isWritten = false;
+			job.sourceSize = wxFileName::GetSize(path);
+			job.targetSize = 0;
+			it = jobIndex.insert(std::make_pair(key, (unsigned) m_jobs.size())).first;
+			m_jobs.push_back(job);
+		}
+		usage.jobIndex = it->second;
+		m_jobs[it->second].usages.push_back(changedUsages.size());
+		changedUsages.push_back(usage);
+	}
+	m_usages.swap(changedUsages);
+	return true;
+}
+
+bool SampleTranscoder::transcode(wxProgressDialog *progress) {
+	TraceScope trace("SampleTranscoder::transcode");
+	// the folders are created here as several jobs may need the same one
+	std::set<wxString> folders;
+	for (TRANSCODE_JOB &job : m_jobs)
+		folders.insert(wxFileName(job.targetPath).GetPath());
+	for (const wxString &folder : folders) {
+		if (!wxFileName::DirExists(folder))
+			wxFileName::Mkdir(folder, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+	}
+
+	IoThrottle throttle(m_maxConcurrentIo);
+	ParallelTaskRunner runner(m_nbrOfThreads);
+	return runner.run(m_jobs.size(), [this, &throttle](unsigned i) {
+		TraceScope trace("SampleTranscoder::writeJob", m_jobs[i].targetPath);
+		TRANSCODE_JOB &job = m_jobs[i];
+		if (job.targetPath.IsSameAs(job.sourcePath)) {
+			job.error = wxT("would overwrite the original file");
+			return;
+		}
+		job.isWritten = writeJob(job, throttle);
+		if (job.isWritten) {
+			job.targetSize = wxFileName::GetSize(job.targetPath);
+		} else if (wxFileName::FileExists(job.targetPath)) {
+			wxLogNull logNo;
+			wxRemoveFile(job.targetPath);
+		}
+	}, progress, wxT("Transcoding samples..."));
+}
+
+unsigned SampleTranscoder::applyToOrgan() {
+	unsigned nbrChanged = 0;
+	for (TRANSCODE_USAGE &usage : m_usages) {
+		TRANSCODE_JOB &job = m_jobs[usage.jobIndex];
+		if (!job.isWritten)
+			continue;
+		adjustUsage(usage, job);
+		nbrChanged++;
+	}
+	if (nbrChanged > 0) {
+		for (Rank *rank : m_ranks)
+			rank->markChanged();
+	}
+	return nbrChanged;
+}
+
+unsigned SampleTranscoder::getNumberOfJobs() {
+	return m_jobs.size();
+}
+
+TRANSCODE_JOB* SampleTranscoder::getJobAt(unsigned index) {
+	if (index < m_jobs.size())
+		return &m_jobs[index];
+	return NULL;
+}
+
+unsigned SampleTranscoder::getNumberOfWrittenFiles() {
+	unsigned nbrWritten = 0;
+	for (TRANSCODE_JOB &job : m_jobs) {
+		if (job.isWritten)
+			nbrWritten++;
+	}
+	return nbrWritten;
+}
+
+const wxArrayString& SampleTranscoder::getSkippedFiles() {
+	return m_skippedFiles;
+}
+
+wxULongLong SampleTranscoder::getSourceBytes() {
+	wxULongLong total = 0;
+	for (TRANSCODE_JOB &job : m_jobs) {
+		if (job.isWritten)
+			total += job.sourceSize;
+	}
+	return total;
+}
+
+wxULongLong SampleTranscoder::getTargetBytes() {
+	wxULongLong total = 0;
+	for (TRANSCODE_JOB &job : m_jobs) {
+		if (job.isWritten)
+			total += job.targetSize;
+	}
+	return total;
+}
+
+wxString SampleTranscoder::getTargetPath(const wxString &sourcePath, std::set<wxString> &usedTargets) {
+	// files from outside the odf root are collected in one folder, every
+	// further job with the same target (other parts of the same file or
+	// external files with the same name) gets a numbered name
+	wxFileName source(sourcePath);
+	wxString root = m_organ->getOdfRoot();
+	if (!root.IsEmpty() && sourcePath.StartsWith(root + wxFILE_SEP_PATH))
+		source.MakeRelativeTo(root);
+	else
+		source = wxFileName(wxT("external") + wxString(wxFILE_SEP_PATH) + source.GetFullName());
+	wxFileName target(m_options.outputFolder + wxFILE_SEP_PATH + source.GetFullPath());
+	target.SetExt(wxT("wav"));
+	wxString name = target.GetName();
+	for (unsigned nbr = 2; usedTargets.count(target.GetFullPath()); nbr++)
+		target.SetName(name + wxString::Format(wxT("-%u"), nbr));
+	usedTargets.insert(target.GetFullPath());
+	return target.GetFullPath();
+}
+
+bool SampleTranscoder::writeJob(TRANSCODE_JOB &job, IoThrottle &throttle) {
+	wxLogNull logNo;
+	wxFFile in(job.sourcePath, wxT("rb"));
+	if (!in.IsOpened()) {
+		job.error = wxT("couldn't be opened");
+		return false;
+	}
+
+	struct CHUNK {
+		wxString id;
+		wxFileOffset offset;
+		unsigned size;
+	};
+	std::vector<CHUNK> chunks;
+	unsigned char header[12];
+	{
+		IoSlot slot(throttle);
+		if (in.Read(header, 12) != 12 || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+			job.error = wxT("isn't a wav file");
+			return false;
+		}
+		unsigned char chunkHeader[8];
+		while (in.Read(chunkHeader, 8) == 8) {
+			CHUNK chunk;
+			chunk.id = wxString::FromAscii((const char*) chunkHeader, 4);
+			chunk.offset = in.Tell();
+			chunk.size = readUint32(chunkHeader + 4);
+			chunks.push_back(chunk);
+			if (!in.Seek(chunk.offset + chunk.size + (chunk.size & 1)))
+				break;
+		}
+	}
+
+	auto readChunk = [&](const CHUNK &chunk, std::vector<unsigned char> &data) {
+		IoSlot slot(throttle);
+		data.resize(chunk.size);
+		return in.Seek(chunk.offset) && in.Read(data.data(), chunk.size) == chunk.size;
+	};
+
+	// the format of the source
+	std::vector<unsigned char> fmt;
+	const CHUNK *dataChunk = NULL;
+	for (const CHUNK &chunk : chunks) {
+		if (chunk.id == wxT("fmt ") && !readChunk(chunk, fmt))
+			fmt.clear();
+		else if (chunk.id == wxT("data") && !dataChunk)
+			dataChunk = &chunk;
+	}
+	if (fmt.size() < 16 || !dataChunk) {
+		job.error = wxT("has no fmt or data chunk");
+		return false;
+	}
+	unsigned channels = readUint16(&fmt[2]);
+	unsigned sampleRate = readUint32(&fmt[4]);
+	unsigned blockAlign = readUint16(&fmt[12]);
+	unsigned bytesPerSample = channels ? blockAlign / channels : 0;
+	if (channels == 0 || bytesPerSample < 1 || bytesPerSample > 4) {
+		job.error = wxT("has an unsupported format");
+		return false;
+	}
+	unsigned outChannels = m_options.foldToMono ? 1 : channels;
+	unsigned outBytesPerSample = bytesPerSample;
+	if (m_options.bitsPerSample > 0 && m_options.bitsPerSample / 8 < bytesPerSample)
+		outBytesPerSample = m_options.bitsPerSample / 8;
+	unsigned outBlockAlign = outChannels * outBytesPerSample;
+	unsigned endFrame = std::min(job.endFrame, dataChunk->size / blockAlign);
+	unsigned outFrames = endFrame > job.startFrame ? endFrame - job.startFrame : 0;
+
+	wxFFile out(job.targetPath, wxT("wb"));
+	if (!out.IsOpened()) {
+		job.error = wxT("couldn't be created");
+		return false;
+	}
+	bool ok = true;
+	auto write = [&](const void *data, size_t size) {
+		IoSlot slot(throttle);
+		if (ok && out.Write(data, size) != size)
+			ok = false;
+	};
+	auto writeChunkHeader = [&](const char *id, unsigned size) {
+		unsigned char chunkHeader[8];
+		memcpy(chunkHeader, id, 4);
+		writeUint32(chunkHeader + 4, size);
+		write(chunkHeader, 8);
+	};
+	const unsigned char padByte = 0;
+
+	write(header, 12);
+	for (const CHUNK &chunk : chunks) {
+		if (!ok)
+			break;
+		if (chunk.id == wxT("fmt ")) {
+			// plain pcm is written, the extensible format isn't needed for the result
+			unsigned char newFmt[16];
+			writeUint16(newFmt, 1);
+			writeUint16(newFmt + 2, outChannels);
+			writeUint32(newFmt + 4, sampleRate);
+			writeUint32(newFmt + 8, sampleRate * outBlockAlign);
+			writeUint16(newFmt + 12, outBlockAlign);
+			writeUint16(newFmt + 14, outBytesPerSample * 8);
+			writeChunkHeader("fmt ", 16);
+			write(newFmt, 16);
+		} else if (&chunk == dataChunk) {
+			unsigned dataSize = outFrames * outBlockAlign;
+			writeChunkHeader("data", dataSize);
+			std::vector<unsigned char> inBuffer((size_t) BLOCK_FRAMES * blockAlign);
+			std::vector<int32_t> samples((size_t) BLOCK_FRAMES * channels);
+			std::vector<unsigned char> outBuffer((size_t) BLOCK_FRAMES * outBlockAlign);
+			{
+				IoSlot slot(throttle);
+				ok = in.Seek(chunk.offset + (wxFileOffset) job.startFrame * blockAlign);
+			}
+			unsigned remaining = outFrames;
+			while (ok && remaining > 0) {
+				unsigned frames = std::min(remaining, BLOCK_FRAMES);
+				{
+					IoSlot slot(throttle);
+					if (in.Read(inBuffer.data(), (size_t) frames * blockAlign) != (size_t) frames * blockAlign)
+						ok = false;
+				}
+				if (!ok)
+					break;
+				decodeSamples(inBuffer.data(), samples.data(), (size_t) frames * channels, bytesPerSample);
+				if (outChannels != channels)
+					foldToMono(samples.data(), frames, channels);
+				if (outBytesPerSample < bytesPerSample)
+					reduceDepth(samples.data(), (size_t) frames * outChannels, outBytesPerSample);
+				encodeSamples(samples.data(), outBuffer.data(), (size_t) frames * outChannels, outBytesPerSample);
+				write(outBuffer.data(), (size_t) frames * outBlockAlign);
+				remaining -= frames;
+			}
+			if (dataSize & 1)
+				write(&padByte, 1);
+		} else if (chunk.id == wxT("fact") || chunk.id == wxT("data")) {
+			// fact only belongs to compressed formats and only the first data chunk is used
+			continue;
+		} else {
+			std::vector<unsigned char> data;
+			if (!readChunk(chunk, data)) {
+				ok = false;
+				break;
+			}
+			if (chunk.id == wxT("smpl"))
+				adjustSmplChunk(data, job.startFrame, endFrame);
+			else if (chunk.id == wxT("cue "))
+				adjustCueChunk(data, job.startFrame, endFrame);
+			writeChunkHeader(chunk.id.ToAscii(), data.size());
+			write(data.data(), data.size());
+			if (data.size() & 1)
+				write(&padByte, 1);
+		}
+	}
+
+	if (ok) {
+		// the riff size can only be set once everything has been written
+		unsigned char riffSize[4];
+		writeUint32(riffSize, out.Tell() - 8);
+		ok = out.Seek(4) && out.Write(riffSize, 4) == 4;
+	}
+	ok = out.Close() && ok;
+	if (!ok)
+		job.error = wxT("couldn't be written");
+	return ok;
+}
+
+void SampleTranscoder::adjustUsage(TRANSCODE_USAGE &usage, const TRANSCODE_JOB &job) {
+	wxFileName relative(job.targetPath);
+	relative.MakeRelativeTo(m_organ->getOdfRoot());
+	int shift = job.startFrame;
+	int newLength = job.endFrame - job.startFrame;
+
+	// offsets past the new end are the end of the file now
+	auto adjustReleaseEnd = [shift, newLength](int releaseEnd) {
+		if (releaseEnd <= 0)
+			return releaseEnd;
+		return releaseEnd - shift >= newLength ? -1 : releaseEnd - shift;
+	};
+
+	if (usage.attack) {
+		Attack *atk = usage.attack;
+		atk->fullPath = job.targetPath;
+		atk->fileName = relative.GetFullPath();
+		if (atk->attackStart > 0)
+			atk->attackStart = std::max(atk->attackStart - shift, 0);
+		if (atk->cuePoint >= 0)
+			atk->cuePoint -= shift;
+		atk->releaseEnd = adjustReleaseEnd(atk->releaseEnd);
+		for (Loop &loop : atk->m_loops) {
+			loop.start -= shift;
+			loop.end -= shift;
+		}
+	} else {
+		Release *rel = usage.release;
+		rel->fullPath = job.targetPath;
+		rel->fileName = relative.GetFullPath();
+		if (rel->cuePoint >= 0)
+			rel->cuePoint = std::max(rel->cuePoint - shift, 0);
+		rel->releaseEnd = adjustReleaseEnd(rel->releaseEnd);
+	}
+}
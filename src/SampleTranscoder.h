@@ -0,0 +1,103 @@
+/*
+ * SampleTranscoder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLETRANSCODER_H
+#define SAMPLETRANSCODER_H
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+#include <vector>
+#include <set>
+#include "Organ.h"
+
+class IoThrottle;
+
+struct TRANSCODE_OPTIONS {
+	unsigned bitsPerSample; // 0 keeps the depth of each file, otherwise 8, 16 or 24
+	bool foldToMono;
+	bool trim; // cut the audio before AttackStart and after ReleaseEnd
+	wxString outputFolder; // the sample folders are recreated below it, files from outside the odf root go to external
+};
+
+struct TRANSCODE_USAGE {
+	Attack *attack; // either attack or release is set
+	Release *release;
+	unsigned jobIndex;
+};
+
+struct TRANSCODE_JOB {
+	wxString sourcePath;
+	wxString targetPath;
+	unsigned numberOfFrames;
+	unsigned startFrame;
+	unsigned endFrame; // exclusive
+	std::vector<unsigned> usages;
+	bool isWritten;
+	wxULongLong sourceSize;
+	wxULongLong targetSize;
+	wxString error;
+};
+
+// Writes new versions of the (uncompressed pcm) sample files of the chosen
+// ranks with a lower bit depth, folded to mono and/or trimmed to the part
+// that is actually played. The audio data is streamed in blocks and loops and
+// cue points of the smpl and cue chunks are moved along with a trimmed start.
+// Files are converted in parallel while the number of threads reading or
+// writing at the same time is limited. Attacks and releases are only pointed
+// to the new files (with adjusted offsets) once the files have been written.
+class SampleTranscoder {
+
+public:
+	static const unsigned DEFAULT_CONCURRENT_IO = 2;
+
+	SampleTranscoder(Organ *organ, const std::vector<Rank*> &ranks, const TRANSCODE_OPTIONS &options, unsigned nbrOfThreads = 0, unsigned maxConcurrentIo = DEFAULT_CONCURRENT_IO);
+	~SampleTranscoder();
+
+	// reads the sample headers and decides which files need a new version,
+	// returns false if aborted from the progress dialog
+	bool prepare(wxProgressDialog *progress = NULL);
+	// returns false if aborted from the progress dialog, the jobs done are kept
+	bool transcode(wxProgressDialog *progress = NULL);
+	// points the attacks and releases to the written files, returns the number changed
+	unsigned applyToOrgan();
+
+	unsigned getNumberOfJobs();
+	TRANSCODE_JOB* getJobAt(unsigned index);
+	unsigned getNumberOfWrittenFiles();
+	const wxArrayString& getSkippedFiles();
+	wxULongLong getSourceBytes();
+	wxULongLong getTargetBytes();
+
+private:
+	Organ *m_organ;
+	std::vector<Rank*> m_ranks;
+	TRANSCODE_OPTIONS m_options;
+	unsigned m_nbrOfThreads;
+	unsigned m_maxConcurrentIo;
+	std::vector<TRANSCODE_USAGE> m_usages;
+	std::vector<TRANSCODE_JOB> m_jobs;
+	wxArrayString m_skippedFiles;
+
+	wxString getTargetPath(const wxString &sourcePath, std::set<wxString> &usedTargets);
+	bool writeJob(TRANSCODE_JOB &job, IoThrottle &throttle);
+	void adjustUsage(TRANSCODE_USAGE &usage, const TRANSCODE_JOB &job);
+};
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * SampleTreeClassifier.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleTreeClassifier.h"
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+SampleTreeClassifier::SampleTreeClassifier(wxString extraAttackFolder, wxString releasePattern, wxString tremulantPattern) {
+	m_extraAttackFolder = extraAttackFolder;
+	m_releasePattern = releasePattern;
+	m_tremulantPattern = tremulantPattern;
+	m_velocityPattern = wxEmptyString;
+	m_rootPath = wxEmptyString;
+	m_isClassified = false;
+	m_hasTremulantFolders = false;
+}
+
+SampleTreeClassifier::~SampleTreeClassifier() {
+
+}
+
+void SampleTreeClassifier::setExtraAttackFolder(wxString folder) {
+	if (folder != m_extraAttackFolder) {
+		m_extraAttackFolder = folder;
+		invalidate();
+	}
+}
+
+void SampleTreeClassifier::setReleasePattern(wxString pattern) {
+	if (pattern != m_releasePattern) {
+		m_releasePattern = pattern;
+		invalidate();
+	}
+}
+
+void SampleTreeClassifier::setTremulantPattern(wxString pattern) {
+	if (pattern != m_tremulantPattern) {
+		m_tremulantPattern = pattern;
+		invalidate();
+	}
+}
+
+void SampleTreeClassifier::setVelocityPattern(wxString pattern) {
+	if (pattern != m_velocityPattern) {
+		m_velocityPattern = pattern;
+		invalidate();
+	}
+}
+
+bool SampleTreeClassifier::classify(wxString rootPath) {
+	if (m_isClassified && rootPath == m_rootPath && !isModifiedOnDisk())
+		return true;
+
+	invalidate();
+	m_rootPath = rootPath;
+
+	if (!wxDir::Exists(m_rootPath))
+		return false;
+
+	// attacks are read from the root itself and from a possible extra attack folder
+	addFolder(wxEmptyString, SAMPLE_FOLDER_ATTACK, -1, -1);
+	if (m_extraAttackFolder != wxEmptyString)
+		addFolder(m_extraAttackFolder, SAMPLE_FOLDER_ATTACK, -1, -1);
+
+	wxArrayString rootFolders;
+	listSubFolders(m_rootPath, rootFolders);
+	rootFolders.Sort();
+
+	for (unsigned i = 0; i < rootFolders.GetCount(); i++) {
+		wxString folder = rootFolders.Item(i);
+
+		if (matchesPattern(folder, m_releasePattern)) {
+			addFolder(folder, SAMPLE_FOLDER_RELEASE, -1, -1);
+		} else if (matchesPattern(folder, m_tremulantPattern)) {
+			m_hasTremulantFolders = true;
+			int tremIndex = m_folders.size();
+			addFolder(folder, SAMPLE_FOLDER_TREMULANT_ATTACK, -1, -1);
+
+			// releases for the tremulant samples are in sub folders of the tremulant folder
+			wxArrayString tremFolders;
+			listSubFolders(m_rootPath + wxFILE_SEP_PATH + folder, tremFolders);
+			tremFolders.Sort();
+			for (unsigned j = 0; j < tremFolders.GetCount(); j++) {
+				if (matchesPattern(tremFolders.Item(j), m_releasePattern))
+					addFolder(folder + wxFILE_SEP_PATH + tremFolders.Item(j), SAMPLE_FOLDER_TREMULANT_RELEASE, tremIndex, -1);
+			}
+		} else if (m_velocityPattern != wxEmptyString && folder != m_extraAttackFolder) {
+			int velocity = extractVelocity(folder, m_velocityPattern);
+			if (velocity > -1)
+				addFolder(folder, SAMPLE_FOLDER_ATTACK, -1, velocity);
+		}
+	}
+
+	m_isClassified = true;
+	return true;
+}
+
+wxString SampleTreeClassifier::getRootPath() {
+	return m_rootPath;
+}
+
+bool SampleTreeClassifier::hasTremulantFolders() {
+	return m_hasTremulantFolders;
+}
+
+unsigned SampleTreeClassifier::getNumberOfFolders() {
+	return m_folders.size();
+}
+
+SAMPLE_FOLDER* SampleTreeClassifier::getFolderAt(unsigned index) {
+	return &m_folders[index];
+}
+
+const wxArrayString& SampleTreeClassifier::getFilesMatching(unsigned folderIndex, int midiNumber) {
+	std::map<int, wxArrayString>::iterator it = m_folders[folderIndex].filesByMidiNumber.find(midiNumber);
+	if (it == m_folders[folderIndex].filesByMidiNumber.end())
+		return m_noFiles;
+	return it->second;
+}
+
+bool SampleTreeClassifier::matchesPattern(wxString folderName, wxString pattern) {
+	if (pattern == wxEmptyString)
+		return false;
+
+	if (pattern.Find(wxT('*')) != wxNOT_FOUND || pattern.Find(wxT('?')) != wxNOT_FOUND)
+		return wxMatchWild(pattern.Lower(), folderName.Lower());
+
+	return folderName.Lower().Find(pattern.Lower()) != wxNOT_FOUND;
+}
+
+bool SampleTreeClassifier::isWaveFile(wxString fileName) {
+	wxString suffix = fileName.AfterLast('.');
+	return suffix.CmpNoCase(wxT("wav")) == 0 || suffix.CmpNoCase(wxT("wv")) == 0;
+}
+
+int SampleTreeClassifier::extractKeyPressTime(wxString folderName) {
+	// the first number in the folder name should have at least 2 digits
+	unsigned start = 0;
+	while (start < folderName.Len() && !wxIsdigit(folderName.GetChar(start)))
+		start++;
+
+	unsigned end = start;
+	while (end < folderName.Len() && wxIsdigit(folderName.GetChar(end)))
+		end++;
+
+	long keyPressTime = -1;
+	if (end == start || !folderName.Mid(start, end - start).ToLong(&keyPressTime))
+		return -1;
+
+	if (keyPressTime > 9 && keyPressTime < 99999)
+		return keyPressTime;
+	return -1;
+}
+
+int SampleTreeClassifier::extractVelocity(wxString folderName, wxString pattern) {
+	// the velocity is the number following the pattern, like "vel 64" or "Velocity_100"
+	if (pattern == wxEmptyString)
+		return -1;
+
+	int position = folderName.Lower().Find(pattern.Lower());
+	if (position == wxNOT_FOUND)
+		return -1;
+
+	unsigned start = position + pattern.Len();
+	while (start < folderName.Len() && (folderName.GetChar(start) == ' ' || folderName.GetChar(start) == '_' || folderName.GetChar(start) == '-'))
+		start++;
+
+	unsigned end = start;
+	while (end < folderName.Len() && wxIsdigit(folderName.GetChar(end)))
+		end++;
+
+	long velocity = -1;
+	if (end == start || !folderName.Mid(start, end - start).ToLong(&velocity))
+		return -1;
+
+	if (velocity >= 0 && velocity < 128)
+		return velocity;
+	return -1;
+}
+
+int SampleTreeClassifier::extractMidiNumber(wxString fileName) {
+	// only letters and zeros may come before the number, so there is at most one candidate
+	unsigned start = 0;
+	while (start < fileName.Len() && (fileName.GetChar(start) == '0' || wxIsalpha(fileName.GetChar(start))))
+		start++;
+
+	unsigned end = start;
+	while (end < fileName.Len() && wxIsdigit(fileName.GetChar(end)))
+		end++;
+
+	long number = 0;
+	if (end > start && !fileName.Mid(start, end - start).ToLong(&number))
+		return -1;
+
+	if (number > 99999 || !isExactMidiMatch(fileName, number))
+		return -1;
+
+	return number;
+}
+
+bool SampleTreeClassifier::isExactMidiMatch(wxString fileName, int midiNumber) {
+	bool isAnExactMatch = true;
+	wxString nbrStr = wxString::Format(wxT("%i"), midiNumber);
+	int matchingPosition = fileName.Find(nbrStr);
+
+	if (matchingPosition > 0) {
+		// the number is not in the beginning, the only valid number occuring before this is a 0
+		for (int currentIndex = matchingPosition - 1; currentIndex >= 0; currentIndex--) {
+			wxUniChar currentChar = fileName.GetChar(currentIndex);
+			if (currentChar == '0' || wxIsalpha(currentChar)) {
+				continue;
+			} else {
+				isAnExactMatch = false;
+			}
+		}
+	} else if (matchingPosition != 0) {
+		// if matching position is negative (wxNOT_FOUND) then this file is not a match
+		isAnExactMatch = false;
+	}
+
+	if (isAnExactMatch && matchingPosition + nbrStr.Len() < fileName.Len() - 1) {
+		int posAfterMatch = matchingPosition + nbrStr.Len();
+		// we need to check what is after this matching number too
+		for (int currentIndex = posAfterMatch; currentIndex < (int) fileName.Len(); currentIndex++) {
+			wxUniChar currentChar = fileName.GetChar(currentIndex);
+			if (currentChar == '-' || currentChar == '_' || currentChar == '.') {
+				break;
+			}
+			if (wxIsdigit(currentChar)) {
+				isAnExactMatch = false;
+			}
+		}
+	}
+
+	// the number must also be followed by a file suffix somewhere
+	if (isAnExactMatch && fileName.Find(wxT('.'), true) < matchingPosition + (int) nbrStr.Len())
+		isAnExactMatch = false;
+
+	return isAnExactMatch;
+}
+
+void SampleTreeClassifier::invalidate() {
+	m_isClassified = false;
+	m_hasTremulantFolders = false;
+	m_folders.clear();
+	m_folderTimes.clear();
+}
+
+bool SampleTreeClassifier::isModifiedOnDisk() {
+	// added or removed files and sub folders change the time of the folder they're in
+	for (std::map<wxString, time_t>::iterator it = m_folderTimes.begin(); it != m_folderTimes.end(); ++it) {
+		if (getFolderTime(it->first) != it->second)
+			return true;
+	}
+	return false;
+}
+
+time_t SampleTreeClassifier::getFolderTime(wxString path) {
+	// a missing folder is noted too, so that its creation is noticed
+	if (!wxDir::Exists(path))
+		return 0;
+	return wxFileModificationTime(path);
+}
+
+void SampleTreeClassifier::addFolder(wxString relativePath, int type, int parent, int velocity) {
+	SAMPLE_FOLDER folder;
+	folder.relativePath = relativePath;
+	folder.type = type;
+	folder.parent = parent;
+	folder.maxKeyPressTime = extractKeyPressTime(relativePath.AfterLast(wxFILE_SEP_PATH));
+	folder.attackVelocity = velocity;
+
+	wxString path = m_rootPath;
+	if (relativePath != wxEmptyString)
+		path += wxFILE_SEP_PATH + relativePath;
+
+	m_folderTimes[path] = getFolderTime(path);
+	wxDir dir(path);
+	if (dir.IsOpened()) {
+		wxString fileName;
+		bool cont = dir.GetFirst(&fileName, wxT("*"), wxDIR_FILES);
+		while (cont) {
+			if (isWaveFile(fileName)) {
+				int midiNumber = extractMidiNumber(fileName);
+				if (midiNumber > -1)
+					folder.filesByMidiNumber[midiNumber].Add(path + wxFILE_SEP_PATH + fileName);
+			}
+			cont = dir.GetNext(&fileName);
+		}
+	}
+
+	for (std::map<int, wxArrayString>::iterator it = folder.filesByMidiNumber.begin(); it != folder.filesByMidiNumber.end(); ++it)
+		it->second.Sort();
+
+	m_folders.push_back(folder);
+}
+
+void SampleTreeClassifier::listSubFolders(wxString path, wxArrayString &folders) {
+	wxDir dir(path);
+	if (!dir.IsOpened())
+		return;
+
+	wxString folder;
+	bool cont = dir.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
+	while (cont) {
+		folders.Add(folder);
+		cont = dir.GetNext(&folder);
+	}
+}
@@ -0,0 +1,100 @@
+/*
+ * SampleTreeClassifier.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLETREECLASSIFIER_H
+#define SAMPLETREECLASSIFIER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <map>
+
+enum SAMPLE_FOLDER_TYPE {
+	SAMPLE_FOLDER_ATTACK,
+	SAMPLE_FOLDER_RELEASE,
+	SAMPLE_FOLDER_TREMULANT_ATTACK,
+	SAMPLE_FOLDER_TREMULANT_RELEASE
+};
+
+struct SAMPLE_FOLDER {
+	wxString relativePath; // empty for the root folder itself
+	int type;
+	int parent; // index of the tremulant folder a tremulant release folder is in, otherwise -1
+	int maxKeyPressTime; // -1 if no usable number was found in the folder name
+	int attackVelocity; // -1 if the folder isn't a velocity layer
+	std::map<int, wxArrayString> filesByMidiNumber; // sorted full paths
+};
+
+// Builds a typed model of a sample folder tree with a single walk: attack,
+// release and tremulant folders are classified by (case insensitive) patterns,
+// key press times and velocity layers are parsed from the folder names and all
+// wave files are indexed by the MIDI number in their name. A pattern without
+// wildcards matches if the folder name contains it, otherwise wxMatchWild is used.
+// Velocity layers are other root folders where the velocity pattern is followed
+// by a number, like "vel 64".
+// The same classifier can be passed to several ranks reading from the same tree,
+// it's only classified again if the patterns or any of its folders changed.
+class SampleTreeClassifier {
+
+public:
+	SampleTreeClassifier(wxString extraAttackFolder = wxEmptyString, wxString releasePattern = wxEmptyString, wxString tremulantPattern = wxEmptyString);
+	~SampleTreeClassifier();
+
+	void setExtraAttackFolder(wxString folder);
+	void setReleasePattern(wxString pattern);
+	void setTremulantPattern(wxString pattern);
+	void setVelocityPattern(wxString pattern);
+
+	// nothing is read again if the same root has already been classified with the
+	// current patterns and none of the classified folders was modified since
+	bool classify(wxString rootPath);
+	wxString getRootPath();
+	bool hasTremulantFolders();
+	unsigned getNumberOfFolders();
+	SAMPLE_FOLDER* getFolderAt(unsigned index);
+	const wxArrayString& getFilesMatching(unsigned folderIndex, int midiNumber);
+
+	static bool matchesPattern(wxString folderName, wxString pattern);
+	static bool isWaveFile(wxString fileName);
+	static int extractKeyPressTime(wxString folderName);
+	static int extractVelocity(wxString folderName, wxString pattern);
+	// returns the only MIDI number the file name can exactly match or -1
+	static int extractMidiNumber(wxString fileName);
+	static bool isExactMidiMatch(wxString fileName, int midiNumber);
+
+private:
+	wxString m_rootPath;
+	wxString m_extraAttackFolder;
+	wxString m_releasePattern;
+	wxString m_tremulantPattern;
+	wxString m_velocityPattern;
+	bool m_isClassified;
+	bool m_hasTremulantFolders;
+	std::vector<SAMPLE_FOLDER> m_folders;
+	std::map<wxString, time_t> m_folderTimes; // modification time of every folder read
+	wxArrayString m_noFiles;
+
+	void invalidate();
+	bool isModifiedOnDisk();
+	void addFolder(wxString relativePath, int type, int parent, int velocity);
+	void listSubFolders(wxString path, wxArrayString &folders);
+	static time_t getFolderTime(wxString path);
+};
+
+#endif
@@ -0,0 +1,471 @@
+/*
+ * SampleTrimDialog.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleTrimDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <wx/progdlg.h>
+#include <algorithm>
+
+IMPLEMENT_CLASS(SampleTrimDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(SampleTrimDialog, wxDialog)
+	EVT_SPINCTRLDOUBLE(ID_SAMPLE_TRIM_ONSET_MARGIN_SPIN, SampleTrimDialog::OnOnsetMarginSpin)
+	EVT_SPINCTRLDOUBLE(ID_SAMPLE_TRIM_TAIL_MARGIN_SPIN, SampleTrimDialog::OnTailMarginSpin)
+	EVT_CHECKBOX(ID_SAMPLE_TRIM_APPLY_START_CHECK, SampleTrimDialog::OnApplyStartCheck)
+	EVT_CHECKBOX(ID_SAMPLE_TRIM_APPLY_END_CHECK, SampleTrimDialog::OnApplyEndCheck)
+END_EVENT_TABLE()
+
+SampleTrimDialog::SampleTrimDialog(Rank *rank) {
+	Init(rank);
+}
+
+SampleTrimDialog::SampleTrimDialog(
+	Rank *rank,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(rank);
+	Create(parent, id, caption, pos, size, style);
+}
+
+SampleTrimDialog::~SampleTrimDialog() {
+
+}
+
+void SampleTrimDialog::Init(Rank *rank) {
+	m_rank = rank;
+	m_onsetMargin = 12;
+	m_tailMargin = 6;
+	m_applyStart = true;
+	m_applyEnd = true;
+	m_onsetMarginSpin = NULL;
+	m_tailMarginSpin = NULL;
+	m_applyStartCheck = NULL;
+	m_applyEndCheck = NULL;
+	m_previewList = NULL;
+	m_summaryText = NULL;
+
+	unsigned pipeIndex = 0;
+	for (Pipe &p : m_rank->m_pipes) {
+		for (Attack &atk : p.m_attacks) {
+			if (atk.fullPath.IsSameAs(wxT("DUMMY")) || atk.fullPath.StartsWith(wxT("REF:")))
+				continue;
+			SAMPLE_TRIM_ITEM item;
+			item.pipeIndex = pipeIndex;
+			item.attack = &atk;
+			item.release = NULL;
+			item.isPercussive = p.isPercussive;
+			m_items.push_back(item);
+		}
+		for (Release &rel : p.m_releases) {
+			if (rel.fullPath.IsSameAs(wxT("DUMMY")) || rel.fullPath.StartsWith(wxT("REF:")))
+				continue;
+			SAMPLE_TRIM_ITEM item;
+			item.pipeIndex = pipeIndex;
+			item.attack = NULL;
+			item.release = &rel;
+			item.isPercussive = p.isPercussive;
+			m_items.push_back(item);
+		}
+		pipeIndex++;
+	}
+	for (SAMPLE_TRIM_ITEM &item : m_items) {
+		item.envelopeIndex = -1;
+		item.errorMessage = wxEmptyString;
+		item.numberOfFrames = 0;
+		item.sampleRate = 0;
+		item.firstLoopStart = -1;
+		item.lastLoopEnd = -1;
+		item.cuePoint = -1;
+		item.proposedStart = item.attack ? item.attack->attackStart : 0;
+		item.proposedEnd = item.attack ? item.attack->releaseEnd : item.release->releaseEnd;
+	}
+}
+
+bool SampleTrimDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	AnalyzeSamples();
+
+	CreateControls();
+
+	UpdateProposals();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void SampleTrimDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *infoText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("AttackStart is proposed where the level first rises above the noise floor and ReleaseEnd where the tail sinks back under it.\nLoops and cue points are never trimmed away. Review the proposals before applying them.")
+	);
+	firstRow->Add(infoText, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
+	m_applyStartCheck = new wxCheckBox(
+		this,
+		ID_SAMPLE_TRIM_APPLY_START_CHECK,
+		wxT("Propose AttackStart"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_applyStartCheck->SetValue(m_applyStart);
+	secondRow->Add(m_applyStartCheck, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *onsetText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Onset above noise floor (dB): ")
+	);
+	secondRow->Add(onsetText, 0, wxALIGN_CENTER_VERTICAL|wxLEFT, 15);
+	m_onsetMarginSpin = new wxSpinCtrlDouble(
+		this,
+		ID_SAMPLE_TRIM_ONSET_MARGIN_SPIN,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		1,
+		60,
+		m_onsetMargin,
+		0.5
+	);
+	m_onsetMarginSpin->SetDigits(1);
+	secondRow->Add(m_onsetMarginSpin, 0, wxEXPAND|wxALL, 5);
+	mainSizer->Add(secondRow, 0, wxGROW|wxLEFT|wxRIGHT, 5);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxHORIZONTAL);
+	m_applyEndCheck = new wxCheckBox(
+		this,
+		ID_SAMPLE_TRIM_APPLY_END_CHECK,
+		wxT("Propose ReleaseEnd"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_applyEndCheck->SetValue(m_applyEnd);
+	thirdRow->Add(m_applyEndCheck, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxStaticText *tailText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Tail above noise floor (dB): ")
+	);
+	thirdRow->Add(tailText, 0, wxALIGN_CENTER_VERTICAL|wxLEFT, 15);
+	m_tailMarginSpin = new wxSpinCtrlDouble(
+		this,
+		ID_SAMPLE_TRIM_TAIL_MARGIN_SPIN,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		1,
+		60,
+		m_tailMargin,
+		0.5
+	);
+	m_tailMarginSpin->SetDigits(1);
+	thirdRow->Add(m_tailMarginSpin, 0, wxEXPAND|wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW|wxLEFT|wxRIGHT, 5);
+
+	wxBoxSizer *fourthRow = new wxBoxSizer(wxVERTICAL);
+	m_previewList = new wxListCtrl(
+		this,
+		ID_SAMPLE_TRIM_PREVIEW_LIST,
+		wxDefaultPosition,
+		wxSize(720, 360),
+		wxLC_REPORT|wxLC_SINGLE_SEL|wxLC_HRULES|wxLC_VRULES
+	);
+	m_previewList->AppendColumn(wxT("Pipe"), wxLIST_FORMAT_LEFT, 70);
+	m_previewList->AppendColumn(wxT("Sample"), wxLIST_FORMAT_LEFT, 270);
+	m_previewList->AppendColumn(wxT("Noise floor"), wxLIST_FORMAT_RIGHT, 100);
+	m_previewList->AppendColumn(wxT("AttackStart"), wxLIST_FORMAT_RIGHT, 130);
+	m_previewList->AppendColumn(wxT("ReleaseEnd"), wxLIST_FORMAT_RIGHT, 130);
+	for (unsigned i = 0; i < m_items.size(); i++) {
+		SAMPLE_TRIM_ITEM &item = m_items[i];
+		long idx = m_previewList->InsertItem(i, wxString::Format(wxT("Pipe%0.3d"), item.pipeIndex + 1));
+		m_previewList->SetItem(idx, 1, item.attack ? item.attack->fileName : item.release->fileName);
+		if (item.envelopeIndex < 0) {
+			m_previewList->SetItem(idx, 2, item.errorMessage.Trim());
+		} else {
+			m_previewList->SetItem(idx, 2, wxString::Format(wxT("%.1f dB"), m_envelopes[item.envelopeIndex].getNoiseFloor()));
+		}
+	}
+	fourthRow->Add(m_previewList, 1, wxGROW|wxALL, 5);
+	m_summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxEmptyString
+	);
+	fourthRow->Add(m_summaryText, 0, wxGROW|wxALL, 5);
+	mainSizer->Add(fourthRow, 1, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Apply proposals")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+unsigned SampleTrimDialog::ApplyProposals() {
+	unsigned nbrChanged = 0;
+	for (SAMPLE_TRIM_ITEM &item : m_items) {
+		if (item.envelopeIndex < 0)
+			continue;
+		if (item.attack) {
+			if (item.attack->attackStart != item.proposedStart || item.attack->releaseEnd != item.proposedEnd) {
+				item.attack->attackStart = item.proposedStart;
+				item.attack->releaseEnd = item.proposedEnd;
+				nbrChanged++;
+			}
+		} else {
+			if (item.release->releaseEnd != item.proposedEnd) {
+				item.release->releaseEnd = item.proposedEnd;
+				nbrChanged++;
+			}
+		}
+	}
+	return nbrChanged;
+}
+
+void SampleTrimDialog::AnalyzeSamples() {
+	if (m_items.empty())
+		return;
+
+	m_envelopes.reserve(m_items.size());
+	wxProgressDialog progress(
+		wxT("Analyzing samples of ") + m_rank->getName(),
+		wxEmptyString,
+		m_items.size(),
+		GetParent(),
+		wxPD_APP_MODAL|wxPD_AUTO_HIDE|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME
+	);
+
+	for (unsigned i = 0; i < m_items.size(); i++) {
+		wxString fullPath = m_items[i].attack ? m_items[i].attack->fullPath : m_items[i].release->fullPath;
+		if (!progress.Update(i, wxT("Analyzing ") + fullPath)) {
+			for (unsigned j = i; j < m_items.size(); j++)
+				m_items[j].errorMessage = wxT("Analysis cancelled");
+			break;
+		}
+		AnalyzeSample(m_items[i], fullPath);
+	}
+}
+
+void SampleTrimDialog::AnalyzeSample(SAMPLE_TRIM_ITEM &item, wxString fullPath) {
+	if (!wxFileExists(fullPath)) {
+		item.errorMessage = wxT("File not found");
+		return;
+	}
+
+	WAVsampleReader reader(fullPath);
+	if (!reader.isOk()) {
+		item.errorMessage = reader.getErrorMessage();
+		return;
+	}
+	SampleEnvelope envelope(reader);
+	if (!envelope.isOk()) {
+		item.errorMessage = envelope.getErrorMessage();
+		return;
+	}
+
+	WAVfileParser *parser = reader.getParser();
+	item.numberOfFrames = envelope.getNumberOfFrames();
+	item.sampleRate = envelope.getSampleRate();
+
+	// odf values take precedence over what's embedded in the file, just like in GrandOrgue
+	if (item.attack && !item.attack->m_loops.empty()) {
+		for (Loop &l : item.attack->m_loops) {
+			if (item.firstLoopStart < 0 || l.start < item.firstLoopStart)
+				item.firstLoopStart = l.start;
+			if (l.end > item.lastLoopEnd)
+				item.lastLoopEnd = l.end;
+		}
+	} else if (item.attack) {
+		for (unsigned i = 0; i < parser->getNumberOfLoops(); i++) {
+			LOOP l = parser->getLoopAtIndex(i);
+			if (item.firstLoopStart < 0 || (int) l.dwStart < item.firstLoopStart)
+				item.firstLoopStart = l.dwStart;
+			if ((int) l.dwEnd > item.lastLoopEnd)
+				item.lastLoopEnd = l.dwEnd;
+		}
+	}
+
+	int odfCue = item.attack ? item.attack->cuePoint : item.release->cuePoint;
+	if (odfCue > -1)
+		item.cuePoint = odfCue;
+	else if (parser->getNumberOfCues() > 0)
+		item.cuePoint = parser->getCuepointAtIndex(0).dwSampleOffset;
+
+	item.envelopeIndex = m_envelopes.size();
+	m_envelopes.push_back(envelope);
+}
+
+void SampleTrimDialog::UpdateProposals() {
+	for (SAMPLE_TRIM_ITEM &item : m_items) {
+		item.proposedStart = item.attack ? item.attack->attackStart : 0;
+		item.proposedEnd = item.attack ? item.attack->releaseEnd : item.release->releaseEnd;
+		if (item.envelopeIndex < 0)
+			continue;
+
+		SampleEnvelope &envelope = m_envelopes[item.envelopeIndex];
+		int lastFrame = (int) item.numberOfFrames - 1;
+
+		if (item.attack && m_applyStart) {
+			// the attack start must stay before any loop, the cue and an already set release end
+			int limit = lastFrame;
+			if (item.firstLoopStart > -1)
+				limit = std::min(limit, item.firstLoopStart);
+			if (item.cuePoint > -1)
+				limit = std::min(limit, item.cuePoint);
+			if (item.attack->releaseEnd > -1)
+				limit = std::min(limit, item.attack->releaseEnd);
+			int onset = envelope.findOnset(m_onsetMargin);
+			if (onset > 0 && onset < limit)
+				item.proposedStart = onset;
+		}
+
+		if (m_applyEnd && (item.release || !item.isPercussive)) {
+			// the release end must be after the cue, all loops and the attack start
+			int lowerLimit = std::max(item.cuePoint, item.lastLoopEnd);
+			lowerLimit = std::max(lowerLimit, item.proposedStart);
+			int tailEnd = envelope.findTailEnd(m_tailMargin);
+			if (tailEnd > lowerLimit && tailEnd < lastFrame)
+				item.proposedEnd = tailEnd;
+		}
+	}
+	UpdatePreview();
+}
+
+void SampleTrimDialog::UpdatePreview() {
+	if (!m_previewList)
+		return;
+
+	unsigned nbrChanged = 0;
+	unsigned nbrFailed = 0;
+	double secondsTrimmed = 0;
+	for (unsigned i = 0; i < m_items.size(); i++) {
+		SAMPLE_TRIM_ITEM &item = m_items[i];
+		if (item.envelopeIndex < 0) {
+			m_previewList->SetItem(i, 3, wxT("-"));
+			m_previewList->SetItem(i, 4, wxT("-"));
+			nbrFailed++;
+			continue;
+		}
+
+		int currentStart = item.attack ? item.attack->attackStart : 0;
+		int currentEnd = item.attack ? item.attack->releaseEnd : item.release->releaseEnd;
+		if (item.attack)
+			m_previewList->SetItem(i, 3, FormatChange(currentStart, item.proposedStart));
+		else
+			m_previewList->SetItem(i, 3, wxT("-"));
+		if (item.attack && item.isPercussive)
+			m_previewList->SetItem(i, 4, wxT("-"));
+		else
+			m_previewList->SetItem(i, 4, FormatChange(currentEnd, item.proposedEnd));
+
+		if (currentStart != item.proposedStart || currentEnd != item.proposedEnd) {
+			nbrChanged++;
+			// -1 means the sample plays to its last frame
+			int lastFrame = (int) item.numberOfFrames - 1;
+			int oldEnd = currentEnd > -1 ? currentEnd : lastFrame;
+			int newEnd = item.proposedEnd > -1 ? item.proposedEnd : lastFrame;
+			int framesTrimmed = (item.proposedStart - currentStart) + (oldEnd - newEnd);
+			if (item.sampleRate > 0)
+				secondsTrimmed += (double) framesTrimmed / item.sampleRate;
+		}
+	}
+
+	wxString summary = wxString::Format(
+		wxT("%u of %u samples will be changed, trimming %.2f seconds of audio in total."),
+		nbrChanged,
+		(unsigned) m_items.size(),
+		secondsTrimmed
+	);
+	if (nbrFailed)
+		summary += wxString::Format(wxT(" %u samples couldn't be analyzed."), nbrFailed);
+	m_summaryText->SetLabel(summary);
+
+	wxButton *okBtn = (wxButton*) FindWindow(wxID_OK);
+	if (okBtn)
+		okBtn->Enable(nbrChanged > 0);
+}
+
+wxString SampleTrimDialog::FormatChange(int current, int proposed) {
+	if (current == proposed)
+		return wxString::Format(wxT("%d"), current);
+	return wxString::Format(wxT("%d -> %d"), current, proposed);
+}
+
+void SampleTrimDialog::OnOnsetMarginSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
+	m_onsetMargin = m_onsetMarginSpin->GetValue();
+	UpdateProposals();
+}
+
+void SampleTrimDialog::OnTailMarginSpin(wxSpinDoubleEvent& WXUNUSED(event)) {
+	m_tailMargin = m_tailMarginSpin->GetValue();
+	UpdateProposals();
+}
+
+void SampleTrimDialog::OnApplyStartCheck(wxCommandEvent& WXUNUSED(event)) {
+	m_applyStart = m_applyStartCheck->IsChecked();
+	m_onsetMarginSpin->Enable(m_applyStart);
+	UpdateProposals();
+}
+
+void SampleTrimDialog::OnApplyEndCheck(wxCommandEvent& WXUNUSED(event)) {
+	m_applyEnd = m_applyEndCheck->IsChecked();
+	m_tailMarginSpin->Enable(m_applyEnd);
+	UpdateProposals();
+}
@@ -0,0 +1,116 @@
+/*
+ * SampleTrimDialog.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLETRIMDIALOG_H
+#define SAMPLETRIMDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/spinctrl.h>
+#include <wx/listctrl.h>
+#include <vector>
+#include "Rank.h"
+#include "SampleEnvelope.h"
+
+struct SAMPLE_TRIM_ITEM {
+	unsigned pipeIndex;
+	Attack *attack; // either attack or release is set
+	Release *release;
+	bool isPercussive;
+	int envelopeIndex; // -1 if the sample couldn't be analyzed
+	wxString errorMessage;
+	unsigned numberOfFrames;
+	unsigned sampleRate;
+	int firstLoopStart; // from odf loops, or from the file if none are set
+	int lastLoopEnd;
+	int cuePoint; // from odf, or from the file if not set
+	int proposedStart;
+	int proposedEnd;
+};
+
+class SampleTrimDialog : public wxDialog {
+	DECLARE_CLASS(SampleTrimDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	SampleTrimDialog(Rank *rank);
+	SampleTrimDialog(
+		Rank *rank,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Automatic sample trimming"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~SampleTrimDialog();
+
+	// Initialize our variables
+	void Init(Rank *rank);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Automatic sample trimming"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Writes the current proposals to the attacks/releases, returns number of changed samples
+	unsigned ApplyProposals();
+
+private:
+	Rank *m_rank;
+	std::vector<SAMPLE_TRIM_ITEM> m_items;
+	double m_onsetMargin;
+	double m_tailMargin;
+	bool m_applyStart;
+	bool m_applyEnd;
+
+	wxSpinCtrlDouble *m_onsetMarginSpin;
+	wxSpinCtrlDouble *m_tailMarginSpin;
+	wxCheckBox *m_applyStartCheck;
+	wxCheckBox *m_applyEndCheck;
+	wxListCtrl *m_previewList;
+	wxStaticText *m_summaryText;
+
+	std::vector<SampleEnvelope> m_envelopes;
+
+	void AnalyzeSamples();
+	void AnalyzeSample(SAMPLE_TRIM_ITEM &item, wxString fullPath);
+	void UpdateProposals();
+	void UpdatePreview();
+	wxString FormatChange(int current, int proposed);
+
+	// Event methods
+	void OnOnsetMarginSpin(wxSpinDoubleEvent& event);
+	void OnTailMarginSpin(wxSpinDoubleEvent& event);
+	void OnApplyStartCheck(wxCommandEvent& event);
+	void OnApplyEndCheck(wxCommandEvent& event);
+
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * ScaledBitmapCache.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ScaledBitmapCache.h"
+#include "TraceRecorder.h"
+#include <cmath>
+#include <cstring>
+
+// scaling each tile with a few extra source pixels around it avoids visible
+// seams where the filter would otherwise hit the tile edges
+static const int TILE_MARGIN = 2;
+
+ScaledBitmapCache::ScaledBitmapCache(wxEvtHandler *owner, int eventId) {
+	m_owner = owner;
+	m_eventId = eventId;
+	m_generation = 0;
+	m_currentZoom = 100;
+	m_stop = false;
+	m_worker = std::thread(&ScaledBitmapCache::processJobs, this);
+}
+
+ScaledBitmapCache::~ScaledBitmapCache() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		m_jobs.clear();
+	}
+	m_condition.notify_all();
+	m_worker.join();
+}
+
+int ScaledBitmapCache::scaleCoordinate(int value, int zoomPercent) {
+	return (int) std::floor(value * (zoomPercent / 100.0));
+}
+
+void ScaledBitmapCache::setSource(const wxImage &source) {
+	TraceScope trace("ScaledBitmapCache::setSource");
+	if (!m_source.IsOk() || m_source.GetSize() != source.GetSize()) {
+		invalidateAll();
+	} else {
+		int nbrOfCols = getNumberOfColumns();
+		int nbrOfRows = getNumberOfRows();
+		for (int row = 0; row < nbrOfRows; row++) {
+			for (int col = 0; col < nbrOfCols; col++) {
+				if (isTileChanged(source, col, row))
+					invalidateTile(col, row);
+			}
+		}
+	}
+	m_source = source;
+}
+
+void ScaledBitmapCache::invalidateAll() {
+	m_generation++;
+	m_tiles.clear();
+	m_queuedTiles.clear();
+	m_tileVersions.clear();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs.clear();
+}
+
+void ScaledBitmapCache::useZoom(int zoomPercent) {
+	if (zoomPercent == m_currentZoom)
+		return;
+	m_currentZoom = zoomPercent;
+	for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+		if (std::get<0>(it->first) != zoomPercent)
+			it = m_tiles.erase(it);
+		else
+			++it;
+	}
+	m_queuedTiles.clear();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs.clear();
+}
+
+int ScaledBitmapCache::getNumberOfColumns() {
+	if (!m_source.IsOk())
+		return 0;
+	return (m_source.GetWidth() + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+int ScaledBitmapCache::getNumberOfRows() {
+	if (!m_source.IsOk())
+		return 0;
+	return (m_source.GetHeight() + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+wxRect ScaledBitmapCache::getTileRect(int col, int row) {
+	wxRect tile(col * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+	if (m_source.IsOk())
+		tile.Intersect(wxRect(m_source.GetSize()));
+	return tile;
+}
+
+bool ScaledBitmapCache::getTile(int col, int row, int zoomPercent, wxBitmap &bmp) {
+	TILE_KEY key = std::make_tuple(zoomPercent, row, col);
+	auto found = m_tiles.find(key);
+	if (found != m_tiles.end()) {
+		bmp = found->second;
+		return true;
+	}
+	if (!m_source.IsOk() || m_queuedTiles.find(key) != m_queuedTiles.end())
+		return false;
+
+	wxRect tileRect = getTileRect(col, row);
+	if (tileRect.IsEmpty())
+		return false;
+	wxRect sourceRect = wxRect(tileRect).Inflate(TILE_MARGIN).Intersect(wxRect(m_source.GetSize()));
+	int scaledLeft = scaleCoordinate(sourceRect.x, zoomPercent);
+	int scaledTop = scaleCoordinate(sourceRect.y, zoomPercent);
+	int tileLeft = scaleCoordinate(tileRect.x, zoomPercent);
+	int tileTop = scaleCoordinate(tileRect.y, zoomPercent);
+
+	SCALE_JOB job;
+	job.zoomPercent = zoomPercent;
+	job.col = col;
+	job.row = row;
+	job.generation = m_generation;
+	job.version = getTileVersion(col, row);
+	// the sub image is a copy so the worker never shares data with the gui thread
+	job.source = m_source.GetSubImage(sourceRect);
+	job.scaledSize = wxSize(
+		scaleCoordinate(sourceRect.x + sourceRect.width, zoomPercent) - scaledLeft,
+		scaleCoordinate(sourceRect.y + sourceRect.height, zoomPercent) - scaledTop
+	);
+	job.crop = wxRect(
+		tileLeft - scaledLeft,
+		tileTop - scaledTop,
+		scaleCoordinate(tileRect.x + tileRect.width, zoomPercent) - tileLeft,
+		scaleCoordinate(tileRect.y + tileRect.height, zoomPercent) - tileTop
+	);
+	if (job.crop.IsEmpty())
+		return false;
+
+	m_queuedTiles[key] = true;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+		job.source = wxNullImage;
+	}
+	m_condition.notify_all();
+	return false;
+}
+
+void ScaledBitmapCache::collectFinished() {
+	std::deque<SCALE_JOB> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		finished.swap(m_finished);
+	}
+	for (SCALE_JOB &job : finished) {
+		// results for tiles changed or zoom levels left since the job was made are stale
+		if (job.generation != m_generation || job.version != getTileVersion(job.col, job.row) || job.zoomPercent != m_currentZoom)
+			continue;
+		TILE_KEY key = std::make_tuple(job.zoomPercent, job.row, job.col);
+		m_queuedTiles.erase(key);
+		if (job.scaled.IsOk())
+			m_tiles[key] = wxBitmap(job.scaled);
+	}
+}
+
+unsigned ScaledBitmapCache::getTileVersion(int col, int row) {
+	auto found = m_tileVersions.find(std::make_pair(row, col));
+	if (found != m_tileVersions.end())
+		return found->second;
+	return 0;
+}
+
+bool ScaledBitmapCache::isTileChanged(const wxImage &source, int col, int row) {
+	if (m_source.HasAlpha() != source.HasAlpha())
+		return true;
+	wxRect tile = getTileRect(col, row);
+	int imageWidth = source.GetWidth();
+	const unsigned char *oldData = m_source.GetData();
+	const unsigned char *newData = source.GetData();
+	const unsigned char *oldAlpha = m_source.GetAlpha();
+	const unsigned char *newAlpha = source.GetAlpha();
+	for (int y = tile.y; y < tile.y + tile.height; y++) {
+		size_t offset = (size_t) y * imageWidth + tile.x;
+		if (memcmp(oldData + offset * 3, newData + offset * 3, tile.width * 3))
+			return true;
+		if (oldAlpha && newAlpha && memcmp(oldAlpha + offset, newAlpha + offset, tile.width))
+			return true;
+	}
+	return false;
+}
+
+void ScaledBitmapCache::invalidateTile(int col, int row) {
+	// jobs already made for the tile will be discarded when they finish
+	m_tileVersions[std::make_pair(row, col)] += 1;
+	for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+		if (std::get<1>(it->first) == row && std::get<2>(it->first) == col)
+			it = m_tiles.erase(it);
+		else
+			++it;
+	}
+	for (auto it = m_queuedTiles.begin(); it != m_queuedTiles.end();) {
+		if (std::get<1>(it->first) == row && std::get<2>(it->first) == col)
+			it = m_queuedTiles.erase(it);
+		else
+			++it;
+	}
+}
+
+void ScaledBitmapCache::processJobs() {
+	while (true) {
+		SCALE_JOB job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+			if (m_stop)
+				return;
+			// the most recently asked for tiles are the ones currently on screen
+			job = m_jobs.back();
+			m_jobs.pop_back();
+		}
+
+		wxImage scaled;
+		{
+			TraceScope trace("ScaledBitmapCache::scaleTile");
+			scaled = job.source.Scale(job.scaledSize.GetWidth(), job.scaledSize.GetHeight(), wxIMAGE_QUALITY_HIGH).GetSubImage(job.crop);
+		}
+		job.source = wxNullImage;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			// the image is handed over and not touched by this thread anymore
+			job.scaled = scaled;
+			scaled = wxNullImage;
+			m_finished.push_back(job);
+			job.scaled = wxNullImage;
+		}
+		wxThreadEvent *evt = new wxThreadEvent(wxEVT_THREAD, m_eventId);
+		wxQueueEvent(m_owner, evt);
+	}
+}
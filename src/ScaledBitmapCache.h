@@ -0,0 +1,97 @@
+/*
+ * ScaledBitmapCache.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SCALEDBITMAPCACHE_H
+#define SCALEDBITMAPCACHE_H
+
+#include <wx/wx.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <utility>
+
+struct SCALE_JOB {
+	int zoomPercent;
+	int col;
+	int row;
+	unsigned generation;
+	unsigned version;
+	wxImage source; // the tile with a small margin, owned by the job
+	wxSize scaledSize;
+	wxRect crop; // the tile within the scaled source
+	wxImage scaled;
+};
+
+// Keeps scaled copies of a source image for the zoom levels of the panel
+// representation. The source is divided into square tiles that are scaled on
+// a worker thread the first time they are asked for, until then getTile()
+// returns false and the caller must draw something else. When a tile is done
+// a wxThreadEvent with the given id is queued to the owner which should then
+// call collectFinished() and repaint. When the source is replaced only the
+// tiles whose pixels have changed are dropped.
+class ScaledBitmapCache {
+public:
+	ScaledBitmapCache(wxEvtHandler *owner, int eventId);
+	~ScaledBitmapCache();
+
+	static const int TILE_SIZE = 256;
+	// the position of a source coordinate at the zoom, shared by everyone
+	// drawing tiles so that neighbouring tiles line up without gaps
+	static int scaleCoordinate(int value, int zoomPercent);
+
+	void setSource(const wxImage &source);
+	void invalidateAll();
+	// scaled tiles of other zoom levels are dropped
+	void useZoom(int zoomPercent);
+	int getNumberOfColumns();
+	int getNumberOfRows();
+	wxRect getTileRect(int col, int row);
+	bool getTile(int col, int row, int zoomPercent, wxBitmap &bmp);
+	void collectFinished();
+
+private:
+	typedef std::tuple<int, int, int> TILE_KEY; // zoom, row, col
+
+	wxEvtHandler *m_owner;
+	int m_eventId;
+	wxImage m_source;
+	std::map<TILE_KEY, wxBitmap> m_tiles;
+	std::map<TILE_KEY, bool> m_queuedTiles;
+	std::map<std::pair<int, int>, unsigned> m_tileVersions;
+	unsigned m_generation;
+	int m_currentZoom;
+
+	std::thread m_worker;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<SCALE_JOB> m_jobs;
+	std::deque<SCALE_JOB> m_finished;
+	bool m_stop;
+
+	unsigned getTileVersion(int col, int row);
+	bool isTileChanged(const wxImage &source, int col, int row);
+	void invalidateTile(int col, int row);
+	void processJobs();
+};
+
+#endif
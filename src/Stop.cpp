@@ -66,7 +66,7 @@ void Stop::write(wxTextFile *outFile) {
 
 }
 
-void Stop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual, Organ *readOrgan) {
+void Stop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual, Organ *readOrgan, bool onlyCatalogue) {
 	m_owningManual = owning_manual;
 	Drawstop::read(cfg, usingOldPanelFormat, readOrgan);
 	int firstPipeKeyNbr = static_cast<int>(cfg->ReadLong("FirstAccessiblePipeLogicalKeyNumber", 1));
@@ -111,7 +111,10 @@ void Stop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manu
 	} else {
 		// this stop uses an internal rank that must be read
 		m_usingInternalRank = true;
-		m_internalRank.read(cfg, readOrgan);
+		if (onlyCatalogue)
+			m_internalRank.readCatalogue(cfg);
+		else
+			m_internalRank.read(cfg, readOrgan);
 		m_internalRank.setFirstMidiNoteNumber(m_owningManual->getFirstAccessibleKeyMIDINoteNumber());
 	}
 }
@@ -37,7 +37,7 @@ public:
 	~Stop();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual, Organ *readOrgan);
+	void read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual, Organ *readOrgan, bool onlyCatalogue = false);
 
 	Rank* getRankAt(unsigned index);
 	RankReference* getRankReferenceAt(unsigned index);
@@ -25,6 +25,7 @@
 #include <wx/statline.h>
 #include <wx/button.h>
 #include <wx/msgdlg.h>
+#include "RenderPreviewDialog.h"
 
 // Event table
 BEGIN_EVENT_TABLE(StopPanel, wxPanel)
@@ -40,6 +41,7 @@ BEGIN_EVENT_TABLE(StopPanel, wxPanel)
 	EVT_RADIOBUTTON(ID_STOP_DEFAULT_TO_ENGAGED_YES, StopPanel::OnDefaultToEngagedChange)
 	EVT_RADIOBUTTON(ID_STOP_DEFAULT_TO_ENGAGED_NO, StopPanel::OnDefaultToEngagedChange)
 	EVT_BUTTON(ID_STOP_REMOVE_BTN, StopPanel::OnRemoveStopBtn)
+	EVT_BUTTON(ID_STOP_RENDER_PREVIEW_BTN, StopPanel::OnRenderPreviewBtn)
 	EVT_BUTTON(ID_STOP_ADD_SWITCH_BTN, StopPanel::OnAddSwitchReferenceBtn)
 	EVT_BUTTON(ID_STOP_REMOVE_SWITCH_BTN, StopPanel::OnRemoveSwitchReferenceBtn)
 	EVT_LISTBOX(ID_STOP_AVAILABLE_SWITCHES, StopPanel::OnSwitchListboxSelection)
@@ -391,6 +393,13 @@ StopPanel::StopPanel(wxWindow *parent) : wxPanel(parent) {
 
 	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
 	bottomRow->AddStretchSpacer();
+	m_renderPreviewBtn = new wxButton(
+		m_stopPanel,
+		ID_STOP_RENDER_PREVIEW_BTN,
+		wxT("Render preview...")
+	);
+	bottomRow->Add(m_renderPreviewBtn, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
 	removeStopBtn = new wxButton(
 		m_stopPanel,
 		ID_STOP_REMOVE_BTN,
@@ -535,6 +544,7 @@ StopPanel::~StopPanel() {
 
 void StopPanel::setStop(Stop *stop) {
 	m_stop = stop;
+	::wxGetApp().m_frame->m_undoHistory->beginEdit(::wxGetApp().m_frame->m_organ, m_stop);
 	m_internalRankPanel->setRank(m_stop->getInternalRank());
 	m_internalRankPanel->setNameFieldValue(m_stop->getName());
 	m_internalRankPanel->disableNameFieldInput();
@@ -713,6 +723,7 @@ RankPanel* StopPanel::GetInternalRankPanel() {
 void StopPanel::internalRankLogicalPipesChanged(int value) {
 	m_numberOfAccessiblePipesSpin->SetValue(value);
 	m_stop->setNumberOfAccessiblePipes(value);
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 }
 
 void StopPanel::setIsFirstRemoval(bool value) {
@@ -727,6 +738,7 @@ void StopPanel::OnNameChange(wxCommandEvent& WXUNUSED(event)) {
 	m_internalRankPanel->setNameFieldValue(m_nameField->GetValue());
 	wxString updatedLabel = m_nameField->GetValue();
 	::wxGetApp().m_frame->OrganTreeChildItemLabelChanged(updatedLabel);
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->organElementHasChanged();
 }
 
@@ -738,6 +750,7 @@ void StopPanel::OnDisplayInvertedRadio(wxCommandEvent& event) {
 		m_displayInvertedNo->SetValue(true);
 		m_stop->setDisplayInverted(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -776,6 +789,7 @@ void StopPanel::OnFunctionChange(wxCommandEvent& WXUNUSED(event)) {
 		m_defaultToEngagedNo->Enable(false);
 		m_gcStateChoice->Enable(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -787,12 +801,14 @@ void StopPanel::OnDefaultToEngagedChange(wxCommandEvent& event) {
 		m_defaultToEngagedNo->SetValue(true);
 		m_stop->setDefaultToEngaged(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void StopPanel::OnGcStateChange(wxCommandEvent& WXUNUSED(event)) {
 	int gcValue = (int) m_gcStateChoice->GetSelection() - 1;
 	m_stop->setGcState(gcValue);
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -804,6 +820,7 @@ void StopPanel::OnStoreInDivisionalChange(wxCommandEvent& event) {
 		m_storeInDivisionalNo->SetValue(true);
 		m_stop->setStoreInDivisional(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -815,21 +832,25 @@ void StopPanel::OnStoreInGeneralChange(wxCommandEvent& event) {
 		m_storeInGeneralNo->SetValue(true);
 		m_stop->setStoreInGeneral(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void StopPanel::OnFirstAccPipeLogKeyNbrChange(wxSpinEvent& WXUNUSED(event)) {
 	m_stop->setFirstPipeLogicalKeyNbr(m_firstAccessiblePipeLogicalKeyNumberSpin->GetValue());
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void StopPanel::OnNbrOfAccPipesChange(wxSpinEvent& WXUNUSED(event)) {
 	m_stop->setNumberOfAccessiblePipes(m_numberOfAccessiblePipesSpin->GetValue());
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
 void StopPanel::OnFirstAccPipeLogPipeNbrChange(wxSpinEvent& WXUNUSED(event)) {
 	m_stop->setFirstPipeLogicalPipeNbr(m_firstAccessiblePipeLogicalPipeNumberSpin->GetValue());
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -839,6 +860,7 @@ void StopPanel::OnUseInternalRankSelection(wxCommandEvent& event) {
 	} else {
 		m_stop->setUsingInternalRank(false);
 	}
+	::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 	::wxGetApp().m_frame->m_organ->setModified(true);
 }
 
@@ -856,6 +878,23 @@ void StopPanel::OnRemoveStopBtn(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void StopPanel::OnRenderPreviewBtn(wxCommandEvent& WXUNUSED(event)) {
+	RenderPreviewDialog dlg(RenderPreviewDialog::GetDefaultOutputPath(m_stop->getName()), this);
+	if (dlg.ShowModal() == wxID_OK) {
+		std::vector<PREVIEW_NOTE> notes;
+		if (!dlg.GetNotes(notes))
+			return;
+
+		PreviewRenderer renderer(::wxGetApp().m_frame->m_organ);
+		bool renderOk;
+		{
+			wxBusyCursor busy;
+			renderOk = renderer.renderStop(m_stop, notes, dlg.GetOutputPath());
+		}
+		RenderPreviewDialog::ShowRenderResult(this, renderer, renderOk, dlg.GetOutputPath());
+	}
+}
+
 void StopPanel::OnAddSwitchReferenceBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxArrayInt selectedSwitches;
 	m_availableSwitches->GetSelections(selectedSwitches);
@@ -868,6 +907,7 @@ void StopPanel::OnAddSwitchReferenceBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 		UpdateReferencedSwitches();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -884,6 +924,7 @@ void StopPanel::OnRemoveSwitchReferenceBtn(wxCommandEvent& WXUNUSED(event)) {
 			m_stop->removeSwitchReference(sw);
 		}
 		UpdateReferencedSwitches();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -966,6 +1007,7 @@ void StopPanel::OnAddRankReferenceBtn(wxCommandEvent& WXUNUSED(event)) {
 			m_referencedRanks->SetSelection(m_stop->getNumberOfRanks() - 1);
 			wxCommandEvent evt(wxEVT_LISTBOX, ID_STOP_REFERENCED_RANKS);
 			wxPostEvent(this, evt);
+			::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 			::wxGetApp().m_frame->m_organ->setModified(true);
 		}
 	}
@@ -984,6 +1026,7 @@ void StopPanel::OnRemoveRankReferenceBtn(wxCommandEvent& WXUNUSED(event)) {
 		m_firstPipeNumberSpin->Disable();
 		m_pipeCountSpin->Disable();
 		m_firstAccessibleKeyNumberSpin->Disable();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1019,6 +1062,7 @@ void StopPanel::OnRankFirstPipeNumberSpin(wxSpinEvent& WXUNUSED(event)) {
 			m_stop->getRankReferenceAt(selected)->m_pipeCount = maxPipes;
 		m_pipeCountSpin->SetRange(0, maxPipes);
 		m_pipeCountSpin->SetValue(m_stop->getRankReferenceAt(selected)->m_pipeCount);
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1027,6 +1071,7 @@ void StopPanel::OnRankPipeCountSpin(wxSpinEvent& WXUNUSED(event)) {
 	if (m_referencedRanks->GetSelection() != wxNOT_FOUND) {
 		unsigned selected = (unsigned) m_referencedRanks->GetSelection();
 		m_stop->getRankReferenceAt(selected)->m_pipeCount = m_pipeCountSpin->GetValue();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -1035,6 +1080,7 @@ void StopPanel::OnRankFirstKeyNbrSpin(wxSpinEvent& WXUNUSED(event)) {
 	if (m_referencedRanks->GetSelection() != wxNOT_FOUND) {
 		unsigned selected = (unsigned) m_referencedRanks->GetSelection();
 		m_stop->getRankReferenceAt(selected)->m_firstAccessibleKeyNumber = m_firstAccessibleKeyNumberSpin->GetValue();
+		::wxGetApp().m_frame->m_undoHistory->recordEdit(m_stop);
 		::wxGetApp().m_frame->m_organ->setModified(true);
 	}
 }
@@ -64,6 +64,7 @@ private:
 	wxRadioButton *m_useInternalRankYes;
 	wxRadioButton *m_useInternalRankNo;
 	wxButton *removeStopBtn;
+	wxButton *m_renderPreviewBtn;
 	wxListBox *m_availableRanks;
 	wxListBox *m_referencedRanks;
 	wxButton *m_addReferencedRank;
@@ -95,6 +96,7 @@ private:
 	void OnFirstAccPipeLogPipeNbrChange(wxSpinEvent& event);
 	void OnUseInternalRankSelection(wxCommandEvent& event);
 	void OnRemoveStopBtn(wxCommandEvent& event);
+	void OnRenderPreviewBtn(wxCommandEvent& event);
 	void OnAddSwitchReferenceBtn(wxCommandEvent& event);
 	void OnRemoveSwitchReferenceBtn(wxCommandEvent& event);
 	void OnSwitchListboxSelection(wxCommandEvent& event);
@@ -34,13 +34,14 @@ BEGIN_EVENT_TABLE(StopRankImportDialog, wxDialog)
 	EVT_BUTTON(ID_STOP_RANK_IMPORT_BTN, StopRankImportDialog::OnDoImportBtn)
 END_EVENT_TABLE()
 
-StopRankImportDialog::StopRankImportDialog(Organ *source, Organ *target) {
-	Init(source, target);
+StopRankImportDialog::StopRankImportDialog(Organ *source, Organ *target, OrganFileParser *sourceParser) {
+	Init(source, target, sourceParser);
 }
 
 StopRankImportDialog::StopRankImportDialog(
 	Organ *source,
 	Organ *target,
+	OrganFileParser *sourceParser,
 	wxWindow* parent,
 	wxWindowID id,
 	const wxString& caption,
@@ -48,7 +49,7 @@ StopRankImportDialog::StopRankImportDialog(
 	const wxSize& size,
 	long style
 ) {
-	Init(source, target);
+	Init(source, target, sourceParser);
 	Create(parent, id, caption, pos, size, style);
 }
 
@@ -56,9 +57,10 @@ StopRankImportDialog::~StopRankImportDialog() {
 
 }
 
-void StopRankImportDialog::Init(Organ *source, Organ *target) {
+void StopRankImportDialog::Init(Organ *source, Organ *target, OrganFileParser *sourceParser) {
 	m_targetOrgan = target;
 	m_sourceOrgan = source;
+	m_sourceParser = sourceParser;
 
 	for (unsigned i = 0; i < m_targetOrgan->getNumberOfManuals(); i++) {
 		m_targetManualList.Add(m_targetOrgan->getOrganManualAt(i)->getName());
@@ -341,6 +343,14 @@ void StopRankImportDialog::OnDoImportBtn(wxCommandEvent& WXUNUSED(event)) {
 	unsigned nbrRanksBeforeImport = m_targetOrgan->getNumberOfRanks();
 
 	if (nbrStopsBeforeImport + stopCount < 1000 && nbrRanksBeforeImport + rankCount < 1000) {
+		// a catalogue parsed source only gets the selected pipes fully read now
+		if (m_sourceParser) {
+			for (int i = 0; i < stopCount; i++)
+				m_sourceParser->loadStop(selectedStops[i]);
+			for (int i = 0; i < rankCount; i++)
+				m_sourceParser->loadRank(selectedRanks[i]);
+		}
+
 		if (!selectedStops.IsEmpty()) {
 			for (int i = 0; i < stopCount; i++) {
 				Stop *s = m_sourceOrgan->getOrganStopAt(selectedStops[i]);
@@ -378,7 +388,7 @@ void StopRankImportDialog::OnDoImportBtn(wxCommandEvent& WXUNUSED(event)) {
 			}
 		}
 
-		m_targetOrgan->updateRelativePipePaths();
+		m_targetOrgan->updateRelativePipePaths(true);
 
 		// Now any REF type of borrowing needs to be fixed in the imported stops/ranks!
 		if (!selectedStops.IsEmpty()) {
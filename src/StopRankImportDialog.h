@@ -23,6 +23,7 @@
 
 #include <wx/wx.h>
 #include "Organ.h"
+#include "OrganFileParser.h"
 
 class StopRankImportDialog : public wxDialog {
 	DECLARE_CLASS(StopRankImportDialog)
@@ -30,10 +31,11 @@ class StopRankImportDialog : public wxDialog {
 
 public:
 	// Constructors
-	StopRankImportDialog(Organ *source, Organ *target);
+	StopRankImportDialog(Organ *source, Organ *target, OrganFileParser *sourceParser = NULL);
 	StopRankImportDialog(
 		Organ *source,
 		Organ *target,
+		OrganFileParser *sourceParser,
 		wxWindow* parent,
 		wxWindowID id = wxID_ANY,
 		const wxString& caption = wxT("Import stop(s)/rank(s) from .organ file"),
@@ -45,7 +47,7 @@ public:
 	~StopRankImportDialog();
 
 	// Initialize our variables
-	void Init(Organ *source, Organ *target);
+	void Init(Organ *source, Organ *target, OrganFileParser *sourceParser);
 
 	// Creation
 	bool Create(
@@ -63,6 +65,7 @@ public:
 private:
 	Organ *m_targetOrgan;
 	Organ *m_sourceOrgan;
+	OrganFileParser *m_sourceParser;
 	wxArrayString m_targetManualList;
 	wxArrayString m_importStopList;
 	wxArrayString m_importRankList;
@@ -0,0 +1,299 @@
+/* 
+ * SyntheticOrganGenerator.cpp is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#include "SyntheticOrganGenerator.h"
+#include "GOODFFunctions.h"
+#include "GUIManual.h"
+#include "GUIStop.h"
+#include "SampleTreeClassifier.h"
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/dir.h>
+#include <algorithm>
+#include <cmath>
+
+static const int SYNTHETIC_FIRST_MIDI_NOTE = 36;
+static const int SYNTHETIC_IMAGE_SIZE = 64;
+
+static void appendUint32(wxMemoryBuffer &buffer, wxUint32 value) {
+	unsigned char bytes[4] = {
+		(unsigned char) (value & 0xFF),
+		(unsigned char) ((value >> 8) & 0xFF),
+		(unsigned char) ((value >> 16) & 0xFF),
+		(unsigned char) ((value >> 24) & 0xFF)
+	};
+	buffer.AppendData(bytes, 4);
+}
+
+static void appendUint16(wxMemoryBuffer &buffer, wxUint16 value) {
+	unsigned char bytes[2] = {
+		(unsigned char) (value & 0xFF),
+		(unsigned char) ((value >> 8) & 0xFF)
+	};
+	buffer.AppendData(bytes, 2);
+}
+
+SyntheticOrganGenerator::SyntheticOrganGenerator(const wxString &rootPath, const SYNTHETIC_ORGAN_SIZE &size) {
+	m_rootPath = rootPath;
+	m_size = size;
+	// every stop references a rank and every pipe needs an attack
+	m_size.ranks = std::max(1u, m_size.ranks);
+	m_size.pipesPerRank = std::max(1u, std::min(192u, m_size.pipesPerRank));
+	m_size.attacksPerPipe = std::max(1u, m_size.attacksPerPipe);
+	m_size.panels = std::max(1u, m_size.panels);
+	m_size.sampleFrames = std::max(16u, m_size.sampleFrames);
+}
+
+SyntheticOrganGenerator::~SyntheticOrganGenerator() {
+
+}
+
+SYNTHETIC_ORGAN_SIZE SyntheticOrganGenerator::getDefaultSize() {
+	SYNTHETIC_ORGAN_SIZE size;
+	size.manuals = 3;
+	size.stopsPerManual = 12;
+	size.ranks = 36;
+	size.pipesPerRank = 61;
+	size.attacksPerPipe = 1;
+	size.releasesPerPipe = 1;
+	size.panels = 4;
+	size.guiElementsPerPanel = 40;
+	size.imagesPerPanel = 8;
+	size.sampleFrames = 2048;
+	return size;
+}
+
+bool SyntheticOrganGenerator::createFiles() {
+	m_sampleFiles.Empty();
+	m_imageFiles.Empty();
+	if (!wxFileName::Mkdir(m_rootPath, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return false;
+
+	// all files have the same content, only the names matter for the classification
+	wxMemoryBuffer attackWave = createWave(m_size.sampleFrames, true);
+	wxMemoryBuffer releaseWave = createWave(m_size.sampleFrames / 2, false);
+
+	for (unsigned r = 0; r < m_size.ranks; r++) {
+		wxString rankPath = getRankSamplePath(r);
+		wxString releasePath = rankPath + wxFILE_SEP_PATH + wxT("rel");
+		if (!wxFileName::Mkdir(releasePath, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+			return false;
+		for (unsigned p = 0; p < m_size.pipesPerRank; p++) {
+			int midiNumber = SYNTHETIC_FIRST_MIDI_NOTE + p;
+			for (unsigned a = 0; a < m_size.attacksPerPipe; a++) {
+				wxString attackFile = rankPath + wxFILE_SEP_PATH + wxString::Format(wxT("%03d-%u.wav"), midiNumber, a + 1);
+				wxFile file(attackFile, wxFile::write);
+				if (!file.IsOpened() || file.Write(attackWave.GetData(), attackWave.GetDataLen()) != attackWave.GetDataLen())
+					return false;
+				m_sampleFiles.Add(attackFile);
+			}
+			for (unsigned rel = 0; rel < m_size.releasesPerPipe; rel++) {
+				wxString releaseFile = releasePath + wxFILE_SEP_PATH + wxString::Format(wxT("%03d-%u.wav"), midiNumber, rel + 1);
+				wxFile file(releaseFile, wxFile::write);
+				if (!file.IsOpened() || file.Write(releaseWave.GetData(), releaseWave.GetDataLen()) != releaseWave.GetDataLen())
+					return false;
+				m_sampleFiles.Add(releaseFile);
+			}
+		}
+	}
+
+	wxString imageDir = m_rootPath + wxFILE_SEP_PATH + wxT("images");
+	if (m_size.imagesPerPanel > 0 && !wxFileName::Mkdir(imageDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return false;
+	for (unsigned p = 0; p < m_size.panels; p++) {
+		for (unsigned i = 0; i < m_size.imagesPerPanel; i++) {
+			// a different colour for each image so that none of them are identical
+			wxImage img(SYNTHETIC_IMAGE_SIZE, SYNTHETIC_IMAGE_SIZE);
+			img.SetRGB(wxRect(0, 0, SYNTHETIC_IMAGE_SIZE, SYNTHETIC_IMAGE_SIZE), (p * 37) & 0xFF, (i * 53) & 0xFF, ((p + i) * 91) & 0xFF);
+			wxString imageFile = getImagePath(p, i);
+			if (!img.SaveFile(imageFile, wxBITMAP_TYPE_PNG))
+				return false;
+			m_imageFiles.Add(imageFile);
+		}
+	}
+	return true;
+}
+
+void SyntheticOrganGenerator::populateOrgan(Organ *organ) {
+	organ->setOdfRoot(m_rootPath);
+	organ->setChurchName(wxT("Synthetic"));
+
+	Windchestgroup windchest;
+	windchest.setName(wxT("Main windchest"));
+	organ->addWindchestgroup(windchest);
+	Windchestgroup *mainWindchest = organ->getOrganWindchestgroupAt(0);
+
+	SampleTreeClassifier sampleTree(wxEmptyString, wxT("rel"), wxEmptyString);
+	for (unsigned r = 0; r < m_size.ranks; r++) {
+		Rank rank;
+		rank.setName(wxString::Format(wxT("Rank %u"), r + 1));
+		rank.setFirstMidiNoteNumber(SYNTHETIC_FIRST_MIDI_NOTE);
+		rank.setNumberOfLogicalPipes(m_size.pipesPerRank);
+		rank.createDummyPipes();
+		rank.setWindchest(mainWindchest);
+		organ->addRank(rank);
+
+		Rank *added = organ->getOrganRankAt(r);
+		added->setPipesRootPath(getRankSamplePath(r));
+		added->readPipes(sampleTree, false, false, false, false, 0, SYNTHETIC_FIRST_MIDI_NOTE, m_size.pipesPerRank);
+	}
+
+	for (unsigned m = 0; m < m_size.manuals; m++) {
+		Manual manual;
+		manual.setName(wxString::Format(wxT("Manual %u"), m + 1));
+		organ->addManual(manual, true);
+		Manual *addedManual = organ->getOrganManualAt(m);
+
+		for (unsigned s = 0; s < m_size.stopsPerManual; s++) {
+			unsigned stopIndex = m * m_size.stopsPerManual + s;
+			Stop stop;
+			stop.setName(wxString::Format(wxT("Stop %u"), stopIndex + 1));
+			stop.setOwningManual(addedManual);
+			stop.setUsingInternalRank(false);
+			stop.setFirstPipeLogicalKeyNbr(1);
+			stop.setNumberOfAccessiblePipes(std::min((int) m_size.pipesPerRank, addedManual->getNumberOfAccessibleKeys()));
+			stop.addRankReference(organ->getOrganRankAt(stopIndex % m_size.ranks));
+			organ->addStop(stop, true);
+			addedManual->addStop(organ->getOrganStopAt(organ->getNumberOfStops() - 1));
+		}
+	}
+
+	for (unsigned p = 1; p < m_size.panels; p++) {
+		GoPanel panel;
+		panel.setName(wxString::Format(wxT("Panel %u"), p));
+		organ->addPanel(panel);
+	}
+
+	for (unsigned p = 0; p < m_size.panels; p++) {
+		GoPanel *panel = organ->getOrganPanelAt(p);
+		int panelWidth = panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue();
+
+		for (unsigned i = 0; i < m_size.imagesPerPanel; i++) {
+			GoImage image;
+			image.setImage(getImagePath(p, i));
+			image.setOriginalWidth(SYNTHETIC_IMAGE_SIZE);
+			image.setOriginalHeight(SYNTHETIC_IMAGE_SIZE);
+			image.setWidth(SYNTHETIC_IMAGE_SIZE);
+			image.setHeight(SYNTHETIC_IMAGE_SIZE);
+			image.setPositionX((i * SYNTHETIC_IMAGE_SIZE) % std::max(SYNTHETIC_IMAGE_SIZE, panelWidth));
+			image.setPositionY(((i * SYNTHETIC_IMAGE_SIZE) / std::max(SYNTHETIC_IMAGE_SIZE, panelWidth)) * SYNTHETIC_IMAGE_SIZE);
+			panel->addImage(image);
+		}
+
+		// the manuals are only displayed on the main panel
+		if (p == 0) {
+			for (unsigned m = 0; m < organ->getNumberOfManuals(); m++) {
+				GUIElement *manual = new GUIManual(organ->getOrganManualAt(m));
+				manual->setOwningPanel(panel);
+				manual->updateDisplayName();
+				panel->addGuiElement(manual);
+			}
+		}
+
+		if (organ->getNumberOfStops() == 0)
+			continue;
+		int columns = std::max(1, panelWidth / 70);
+		for (unsigned e = 0; e < m_size.guiElementsPerPanel; e++) {
+			GUIElement *stop = new GUIStop(organ->getOrganStopAt(e % organ->getNumberOfStops()));
+			stop->setOwningPanel(panel);
+			stop->updateDisplayName();
+			stop->setDefaultFont(panel->getDisplayMetrics()->m_dispControlLabelFont);
+			stop->setPosX((e % columns) * 70);
+			stop->setPosY((e / columns) * 70);
+			panel->addGuiElement(stop);
+		}
+	}
+
+	organ->organElementHasChanged(true);
+	organ->setModified(false);
+}
+
+void SyntheticOrganGenerator::removeFiles() {
+	wxFileName::Rmdir(m_rootPath, wxPATH_RMDIR_RECURSIVE);
+	m_sampleFiles.Empty();
+	m_imageFiles.Empty();
+}
+
+wxString SyntheticOrganGenerator::getRootPath() {
+	return m_rootPath;
+}
+
+wxString SyntheticOrganGenerator::getOdfPath() {
+	return m_rootPath + wxFILE_SEP_PATH + wxT("Synthetic.organ");
+}
+
+wxString SyntheticOrganGenerator::getRankSamplePath(unsigned rankIndex) {
+	return m_rootPath + wxFILE_SEP_PATH + wxT("samples") + wxFILE_SEP_PATH + wxT("rank") + GOODF_functions::number_format(rankIndex + 1);
+}
+
+const wxArrayString& SyntheticOrganGenerator::getSampleFiles() {
+	return m_sampleFiles;
+}
+
+wxMemoryBuffer SyntheticOrganGenerator::createWave(unsigned frames, bool withLoop) {
+	// 16 bit mono pcm at 44.1 kHz with a smpl chunk when looped
+	wxUint32 dataSize = frames * 2;
+	wxUint32 smplSize = withLoop ? 36 + 24 : 0;
+	wxMemoryBuffer wave;
+	wave.AppendData("RIFF", 4);
+	appendUint32(wave, 4 + (8 + 16) + (withLoop ? 8 + smplSize : 0) + (8 + dataSize));
+	wave.AppendData("WAVE", 4);
+
+	wave.AppendData("fmt ", 4);
+	appendUint32(wave, 16);
+	appendUint16(wave, 1);
+	appendUint16(wave, 1);
+	appendUint32(wave, 44100);
+	appendUint32(wave, 44100 * 2);
+	appendUint16(wave, 2);
+	appendUint16(wave, 16);
+
+	if (withLoop) {
+		wave.AppendData("smpl", 4);
+		appendUint32(wave, smplSize);
+		appendUint32(wave, 0); // manufacturer
+		appendUint32(wave, 0); // product
+		appendUint32(wave, 22675); // sample period in ns
+		appendUint32(wave, 60); // unity note
+		appendUint32(wave, 0); // pitch fraction
+		appendUint32(wave, 0); // smpte format
+		appendUint32(wave, 0); // smpte offset
+		appendUint32(wave, 1); // number of loops
+		appendUint32(wave, 0); // sampler data
+		appendUint32(wave, 0); // loop identifier
+		appendUint32(wave, 0); // loop type
+		appendUint32(wave, frames / 4);
+		appendUint32(wave, frames - 1);
+		appendUint32(wave, 0); // fraction
+		appendUint32(wave, 0); // play count
+	}
+
+	wave.AppendData("data", 4);
+	appendUint32(wave, dataSize);
+	for (unsigned i = 0; i < frames; i++) {
+		wxInt16 value = (wxInt16) (8000 * std::sin(2 * M_PI * 440.0 * i / 44100.0));
+		appendUint16(wave, (wxUint16) value);
+	}
+	return wave;
+}
+
+wxString SyntheticOrganGenerator::getImagePath(unsigned panelIndex, unsigned imageIndex) {
+	return m_rootPath + wxFILE_SEP_PATH + wxT("images") + wxFILE_SEP_PATH + wxT("panel") + GOODF_functions::number_format(panelIndex) + wxT("-") + GOODF_functions::number_format(imageIndex + 1) + wxT(".png");
+}
@@ -0,0 +1,71 @@
+/* 
+ * SyntheticOrganGenerator.h is a part of GOODF software
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo DOT se
+ */
+
+#ifndef SYNTHETICORGANGENERATOR_H
+#define SYNTHETICORGANGENERATOR_H
+
+#include <wx/wx.h>
+#include "Organ.h"
+
+struct SYNTHETIC_ORGAN_SIZE {
+	unsigned manuals;
+	unsigned stopsPerManual;
+	unsigned ranks; // the stops reference these in turn
+	unsigned pipesPerRank;
+	unsigned attacksPerPipe;
+	unsigned releasesPerPipe;
+	unsigned panels;
+	unsigned guiElementsPerPanel;
+	unsigned imagesPerPanel;
+	unsigned sampleFrames;
+};
+
+// Creates an organ of a given size for benchmarking. The files are written
+// below the root path: one sample folder per rank with small looped wave
+// files (releases in a "rel" sub folder) and png images for the panels.
+// The organ model is then built on them the same way the editor would.
+class SyntheticOrganGenerator {
+public:
+	SyntheticOrganGenerator(const wxString &rootPath, const SYNTHETIC_ORGAN_SIZE &size);
+	~SyntheticOrganGenerator();
+
+	static SYNTHETIC_ORGAN_SIZE getDefaultSize();
+
+	bool createFiles();
+	// the organ must be the current organ as the ranks are created in it
+	void populateOrgan(Organ *organ);
+	void removeFiles();
+
+	wxString getRootPath();
+	wxString getOdfPath();
+	wxString getRankSamplePath(unsigned rankIndex);
+	const wxArrayString& getSampleFiles();
+
+private:
+	wxString m_rootPath;
+	SYNTHETIC_ORGAN_SIZE m_size;
+	wxArrayString m_sampleFiles;
+	wxArrayString m_imageFiles;
+
+	wxMemoryBuffer createWave(unsigned frames, bool withLoop);
+	wxString getImagePath(unsigned panelIndex, unsigned imageIndex);
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * TraceRecorder.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "TraceRecorder.h"
+#include <wx/file.h>
+#include <chrono>
+#include <algorithm>
+#include <map>
+
+std::atomic<bool> TraceRecorder::m_enabled(false);
+std::mutex TraceRecorder::m_mutex;
+std::vector<TRACE_EVENT> TraceRecorder::m_events;
+long long TraceRecorder::m_epoch = 0;
+
+static std::atomic<unsigned> s_nextThreadId(1);
+
+static unsigned getTraceThreadId() {
+	// small sequential ids are easier to read in the trace viewer than native ones
+	static thread_local unsigned threadId = s_nextThreadId++;
+	return threadId;
+}
+
+struct TRACE_SUMMARY {
+	unsigned count = 0;
+	long long total = 0;
+	long long max = 0;
+};
+
+void TraceRecorder::setEnabled(bool enable) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (enable) {
+		m_events.clear();
+		m_epoch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	m_enabled = enable;
+}
+
+void TraceRecorder::addEvent(const char *name, const wxString &detail, long long start, long long end) {
+	TRACE_EVENT event;
+	event.name = name;
+	event.detail = detail;
+	event.duration = end - start;
+	event.threadId = getTraceThreadId();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_enabled)
+		return;
+	event.start = start - m_epoch;
+	m_events.push_back(event);
+}
+
+long long TraceRecorder::now() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned TraceRecorder::getNumberOfEvents() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_events.size();
+}
+
+bool TraceRecorder::writeChromeTrace(const wxString &filePath) {
+	wxFile traceFile(filePath, wxFile::write);
+	if (!traceFile.IsOpened())
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	bool ok = traceFile.Write(wxT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"));
+	for (unsigned i = 0; i < m_events.size() && ok; i++) {
+		const TRACE_EVENT &e = m_events[i];
+		wxString line = wxT("{\"name\":\"") + escapeJson(wxString::FromUTF8(e.name)) + wxT("\",\"cat\":\"goodf\",\"ph\":\"X\"");
+		line += wxT(",\"ts\":") + wxString::Format(wxT("%lld"), e.start);
+		line += wxT(",\"dur\":") + wxString::Format(wxT("%lld"), e.duration);
+		line += wxString::Format(wxT(",\"pid\":1,\"tid\":%u"), e.threadId);
+		if (e.detail != wxEmptyString)
+			line += wxT(",\"args\":{\"detail\":\"") + escapeJson(e.detail) + wxT("\"}");
+		line += (i + 1 < m_events.size()) ? wxT("},\n") : wxT("}\n");
+		ok = traceFile.Write(line, wxConvUTF8);
+	}
+	if (ok)
+		ok = traceFile.Write(wxT("]}\n"));
+	return ok;
+}
+
+wxString TraceRecorder::createSummary() {
+	std::map<wxString, TRACE_SUMMARY> summaries;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const TRACE_EVENT &e : m_events) {
+			TRACE_SUMMARY &s = summaries[wxString::FromUTF8(e.name)];
+			s.count++;
+			s.total += e.duration;
+			s.max = std::max(s.max, e.duration);
+		}
+	}
+
+	// the most expensive first
+	std::vector<std::pair<wxString, TRACE_SUMMARY>> sorted(summaries.begin(), summaries.end());
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<wxString, TRACE_SUMMARY> &a, const std::pair<wxString, TRACE_SUMMARY> &b) {
+		return a.second.total > b.second.total;
+	});
+
+	wxString summary = wxString::Format(wxT("%-36s %8s %12s %10s %10s\n"), wxT("Event"), wxT("Count"), wxT("Total ms"), wxT("Mean ms"), wxT("Max ms"));
+	for (const auto &s : sorted) {
+		summary += wxString::Format(
+			wxT("%-36s %8u %12.2f %10.3f %10.3f\n"),
+			s.first,
+			s.second.count,
+			s.second.total / 1000.0,
+			s.second.total / 1000.0 / s.second.count,
+			s.second.max / 1000.0
+		);
+	}
+	return summary;
+}
+
+void TraceRecorder::enableFromEnvironment() {
+	wxString tracePath;
+	if (wxGetEnv(wxT("GOODF_TRACE"), &tracePath) && tracePath != wxEmptyString)
+		setEnabled(true);
+}
+
+void TraceRecorder::finishFromEnvironment() {
+	wxString tracePath;
+	if (!isEnabled() || !wxGetEnv(wxT("GOODF_TRACE"), &tracePath) || tracePath == wxEmptyString)
+		return;
+	setEnabled(false);
+	if (!writeChromeTrace(tracePath))
+		wxLogError(wxT("The trace could not be written to %s"), tracePath);
+}
+
+wxString TraceRecorder::escapeJson(const wxString &text) {
+	wxString escaped;
+	escaped.reserve(text.length());
+	for (wxString::const_iterator it = text.begin(); it != text.end(); ++it) {
+		wxUniChar c = *it;
+		if (c == wxT('"') || c == wxT('\\')) {
+			escaped += wxT('\\');
+			escaped += c;
+		} else if (c.GetValue() < 0x20) {
+			escaped += wxString::Format(wxT("\\u%04x"), (unsigned) c.GetValue());
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+TraceScope::TraceScope(const char *name) {
+	m_isActive = false;
+	if (TraceRecorder::isEnabled())
+		begin(name, wxEmptyString);
+}
+
+TraceScope::TraceScope(const char *name, const wxString &detail) {
+	m_isActive = false;
+	if (TraceRecorder::isEnabled())
+		begin(name, detail);
+}
+
+TraceScope::~TraceScope() {
+	if (m_isActive)
+		end();
+}
+
+void TraceScope::next(const char *name) {
+	if (m_isActive)
+		end();
+	if (TraceRecorder::isEnabled())
+		begin(name, wxEmptyString);
+}
+
+void TraceScope::begin(const char *name, const wxString &detail) {
+	m_name = name;
+	m_detail = detail;
+	m_start = TraceRecorder::now();
+	m_isActive = true;
+}
+
+void TraceScope::end() {
+	TraceRecorder::addEvent(m_name, m_detail, m_start, TraceRecorder::now());
+	m_isActive = false;
+}
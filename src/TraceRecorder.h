@@ -0,0 +1,92 @@
+/*
+ * TraceRecorder.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <wx/wx.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+struct TRACE_EVENT {
+	const char *name; // always a string literal
+	wxString detail;
+	long long start; // microseconds since tracing was enabled
+	long long duration;
+	unsigned threadId;
+};
+
+// Collects timed events from the hot paths (parsing, reading pipes, writing,
+// rendering) when tracing is enabled, either from the tools menu or by setting
+// GOODF_TRACE to the file the trace should be written to when the program exits.
+// The events can be saved in the Chrome trace event format (viewable in
+// chrome://tracing or Perfetto) and summarized per name in the log.
+class TraceRecorder {
+
+public:
+	static bool isEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+	// enabling clears all previously recorded events
+	static void setEnabled(bool enable);
+
+	static void addEvent(const char *name, const wxString &detail, long long start, long long end);
+	static long long now();
+	static unsigned getNumberOfEvents();
+
+	static bool writeChromeTrace(const wxString &filePath);
+	// one line per event name with count, total, mean and max time
+	static wxString createSummary();
+
+	// GOODF_TRACE from the environment is handled by the app at start and exit
+	static void enableFromEnvironment();
+	static void finishFromEnvironment();
+
+private:
+	static std::atomic<bool> m_enabled;
+	static std::mutex m_mutex;
+	static std::vector<TRACE_EVENT> m_events;
+	static long long m_epoch;
+
+	static wxString escapeJson(const wxString &text);
+};
+
+// Records the time from construction until destruction (or until the next
+// call to next()) as one event. When tracing is disabled it costs a flag test.
+class TraceScope {
+
+public:
+	TraceScope(const char *name);
+	TraceScope(const char *name, const wxString &detail);
+	~TraceScope();
+
+	// ends the current event and starts a new one, for sequential sections
+	void next(const char *name);
+
+private:
+	const char *m_name;
+	wxString m_detail;
+	long long m_start;
+	bool m_isActive;
+
+	void begin(const char *name, const wxString &detail);
+	void end();
+};
+
+#endif
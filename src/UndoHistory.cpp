@@ -0,0 +1,676 @@
+/*
+ * UndoHistory.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+#include "UndoHistory.h"
+#include "Organ.h"
+#include "Stop.h"
+#include "ReferenceIndex.h"
+#include "GUIElements.h"
+#include "GUIButton.h"
+#include "GUIStop.h"
+#include "GUICoupler.h"
+#include "GUIDivisional.h"
+#include "GUIDivisionalCoupler.h"
+#include "GUIGeneral.h"
+#include "GUIReversiblePiston.h"
+#include "GUISwitch.h"
+#include "GUITremulant.h"
+#include "GUIEnclosure.h"
+#include "GUILabel.h"
+#include "GUIManual.h"
+#include <typeinfo>
+
+static bool isOrganRank(Organ *organ, Rank *rank) {
+	if (organ->getIndexOfOrganRank(rank))
+		return true;
+	for (Stop &s : *organ->getOrganStops()) {
+		if (s.getInternalRank() == rank)
+			return true;
+	}
+	return false;
+}
+
+static bool isOrganWindchest(Organ *organ, Windchestgroup *windchest) {
+	return windchest == NULL || organ->getIndexOfOrganWindchest(windchest) > 0;
+}
+
+static bool hasOrganWindchests(Organ *organ, Rank *rank) {
+	if (!isOrganWindchest(organ, rank->getWindchest()))
+		return false;
+	for (Pipe &p : rank->m_pipes) {
+		if (!isOrganWindchest(organ, p.windchest))
+			return false;
+	}
+	return true;
+}
+
+static bool hasOrganReferences(Organ *organ, Stop *stop) {
+	if (stop->getOwningManual() && !organ->getIndexOfOrganManual(stop->getOwningManual()))
+		return false;
+	for (unsigned i = 0; i < stop->getNumberOfSwitches(); i++) {
+		if (!organ->getIndexOfOrganSwitch(stop->getSwitchAtIndex(i)))
+			return false;
+	}
+	for (unsigned i = 0; i < stop->getNumberOfRanks(); i++) {
+		if (!organ->getIndexOfOrganRank(stop->getRankAt(i)))
+			return false;
+	}
+	return true;
+}
+
+static GoPanel* getPanelOf(Organ *organ, GUIElement *element) {
+	for (unsigned i = 0; i < organ->getNumberOfPanels(); i++) {
+		GoPanel *panel = organ->getOrganPanelAt(i);
+		if (panel->getIndexOfGuiElement(element))
+			return panel;
+	}
+	return NULL;
+}
+
+template<class T> static bool assignAs(GUIElement *element, GUIElement *state) {
+	if (typeid(*element) != typeid(T) || typeid(*state) != typeid(T))
+		return false;
+	*static_cast<T*>(element) = *static_cast<T*>(state);
+	return true;
+}
+
+// every type of gui element must be listed here to be restored
+static bool assignGuiElement(GUIElement *element, GUIElement *state) {
+	return assignAs<GUIStop>(element, state) ||
+		assignAs<GUICoupler>(element, state) ||
+		assignAs<GUIDivisional>(element, state) ||
+		assignAs<GUIDivisionalCoupler>(element, state) ||
+		assignAs<GUIGeneral>(element, state) ||
+		assignAs<GUIReversiblePiston>(element, state) ||
+		assignAs<GUISwitch>(element, state) ||
+		assignAs<GUITremulant>(element, state) ||
+		assignAs<GUIButton>(element, state) ||
+		assignAs<GUIEnclosure>(element, state) ||
+		assignAs<GUILabel>(element, state) ||
+		assignAs<GUIManual>(element, state);
+}
+
+PipeUndoAction::PipeUndoAction(Rank *rank, unsigned pipeIndex) : m_oldPipe(*rank->getPipeAt(pipeIndex)), m_newPipe(m_oldPipe) {
+	m_rank = rank;
+	m_pipeIndex = pipeIndex;
+	m_numberOfPipes = rank->m_pipes.size();
+}
+
+void PipeUndoAction::storeNewState() {
+	m_newPipe = *m_rank->getPipeAt(m_pipeIndex);
+}
+
+void PipeUndoAction::undo() {
+	restore(m_oldPipe);
+}
+
+void PipeUndoAction::redo() {
+	restore(m_newPipe);
+}
+
+bool PipeUndoAction::isValid(Organ *organ) {
+	if (!isOrganRank(organ, m_rank) || m_rank->m_pipes.size() != m_numberOfPipes)
+		return false;
+	return isOrganWindchest(organ, m_oldPipe.windchest) && isOrganWindchest(organ, m_newPipe.windchest);
+}
+
+void PipeUndoAction::restore(const Pipe &pipe) {
+	*m_rank->getPipeAt(m_pipeIndex) = pipe;
+	m_rank->markChanged();
+}
+
+RankUndoAction::RankUndoAction(Rank *rank) {
+	m_rank = rank;
+	m_oldRank = new Rank(*rank);
+	m_newRank = NULL;
+}
+
+RankUndoAction::~RankUndoAction() {
+	delete m_oldRank;
+	if (m_newRank)
+		delete m_newRank;
+}
+
+void RankUndoAction::storeNewState() {
+	if (m_newRank)
+		*m_newRank = *m_rank;
+	else
+		m_newRank = new Rank(*m_rank);
+}
+
+void RankUndoAction::undo() {
+	restore(m_oldRank);
+}
+
+void RankUndoAction::redo() {
+	if (m_newRank)
+		restore(m_newRank);
+}
+
+bool RankUndoAction::isValid(Organ *organ) {
+	if (!isOrganRank(organ, m_rank) || !hasOrganWindchests(organ, m_oldRank))
+		return false;
+	return !m_newRank || hasOrganWindchests(organ, m_newRank);
+}
+
+void RankUndoAction::restore(Rank *state) {
+	*m_rank = *state;
+	m_rank->markChanged();
+}
+
+StopUndoAction::StopUndoAction(Stop *stop) {
+	m_stop = stop;
+	m_oldStop = copyState();
+	m_newStop = NULL;
+}
+
+StopUndoAction::~StopUndoAction() {
+	delete m_oldStop;
+	if (m_newStop)
+		delete m_newStop;
+}
+
+void StopUndoAction::storeNewState() {
+	if (m_newStop)
+		delete m_newStop;
+	m_newStop = copyState();
+}
+
+void StopUndoAction::undo() {
+	restore(m_oldStop);
+}
+
+void StopUndoAction::redo() {
+	if (m_newStop)
+		restore(m_newStop);
+}
+
+bool StopUndoAction::isValid(Organ *organ) {
+	if (!organ->getIndexOfOrganStop(m_stop) || !hasOrganReferences(organ, m_oldStop))
+		return false;
+	return !m_newStop || hasOrganReferences(organ, m_newStop);
+}
+
+Stop* StopUndoAction::copyState() {
+	// the pipes are moved out of the way instead of being copied
+	std::list<Pipe> pipes;
+	pipes.swap(m_stop->getInternalRank()->m_pipes);
+	Stop *state = new Stop(*m_stop);
+	pipes.swap(m_stop->getInternalRank()->m_pipes);
+	return state;
+}
+
+void StopUndoAction::restore(Stop *state) {
+	Rank *internalRank = m_stop->getInternalRank();
+	std::list<Pipe> pipes;
+	pipes.swap(internalRank->m_pipes);
+	Rank rankState(*internalRank);
+	*m_stop = *state;
+	*internalRank = rankState;
+	internalRank->setName(m_stop->getName());
+	internalRank->m_pipes.swap(pipes);
+	internalRank->markChanged();
+	ReferenceIndex::referrerHasChanged(static_cast<Drawstop*>(m_stop));
+}
+
+GuiElementUndoAction::GuiElementUndoAction(GUIElement *element) {
+	m_element = element;
+	m_oldElement = element->clone();
+	m_newElement = NULL;
+}
+
+GuiElementUndoAction::~GuiElementUndoAction() {
+	if (m_oldElement)
+		delete m_oldElement;
+	if (m_newElement)
+		delete m_newElement;
+}
+
+void GuiElementUndoAction::storeNewState() {
+	if (m_newElement)
+		delete m_newElement;
+	m_newElement = m_element->clone();
+}
+
+void GuiElementUndoAction::undo() {
+	restore(m_oldElement);
+}
+
+void GuiElementUndoAction::redo() {
+	restore(m_newElement);
+}
+
+bool GuiElementUndoAction::isValid(Organ *organ) {
+	return getPanelOf(organ, m_element) != NULL;
+}
+
+void GuiElementUndoAction::restore(GUIElement *state) {
+	if (state && assignGuiElement(m_element, state))
+		m_element->markChanged();
+}
+
+PositionUndoAction::PositionUndoAction(GoPanel *panel, GUIElement *element) {
+	m_panel = panel;
+	m_element = element;
+	m_image = NULL;
+	m_oldPosition = getPosition();
+	m_newPosition = m_oldPosition;
+}
+
+PositionUndoAction::PositionUndoAction(GoPanel *panel, GoImage *image) {
+	m_panel = panel;
+	m_element = NULL;
+	m_image = image;
+	m_oldPosition = getPosition();
+	m_newPosition = m_oldPosition;
+}
+
+void PositionUndoAction::storeNewState() {
+	m_newPosition = getPosition();
+}
+
+void PositionUndoAction::undo() {
+	restore(m_oldPosition);
+}
+
+void PositionUndoAction::redo() {
+	restore(m_newPosition);
+}
+
+bool PositionUndoAction::isValid(Organ *organ) {
+	if (!organ->getIndexOfOrganPanel(m_panel))
+		return false;
+	if (m_image)
+		return m_panel->getIndexOfImage(m_image) > 0;
+	return m_panel->getIndexOfGuiElement(m_element) > 0;
+}
+
+PositionUndoAction::POSITION PositionUndoAction::getPosition() {
+	POSITION position;
+	position.freeX = false;
+	position.freeY = false;
+	if (m_image) {
+		position.posX = m_image->getPositionX();
+		position.posY = m_image->getPositionY();
+	} else {
+		position.posX = m_element->getPosX();
+		position.posY = m_element->getPosY();
+		GUILabel *label = dynamic_cast<GUILabel*>(m_element);
+		if (label) {
+			position.freeX = label->isFreeXPlacement();
+			position.freeY = label->isFreeYPlacement();
+		}
+	}
+	return position;
+}
+
+void PositionUndoAction::restore(const POSITION &position) {
+	if (m_image) {
+		m_image->setPositionX(position.posX);
+		m_image->setPositionY(position.posY);
+	} else {
+		m_element->setPosX(position.posX);
+		m_element->setPosY(position.posY);
+		GUILabel *label = dynamic_cast<GUILabel*>(m_element);
+		if (label) {
+			label->setFreeXPlacement(position.freeX);
+			label->setFreeYPlacement(position.freeY);
+		}
+	}
+	m_panel->markChanged();
+}
+
+UndoStep::UndoStep(Organ *organ, wxString description) {
+	m_organ = organ;
+	m_description = description;
+}
+
+UndoStep::~UndoStep() {
+	for (UndoAction *action : m_actions)
+		delete action;
+}
+
+wxString UndoStep::getDescription() {
+	return m_description;
+}
+
+bool UndoStep::isEmpty() {
+	return m_actions.empty();
+}
+
+void UndoStep::recordPipe(Rank *rank, Pipe *pipe) {
+	unsigned pipeIndex = 0;
+	for (Pipe &p : rank->m_pipes) {
+		if (&p == pipe)
+			break;
+		pipeIndex++;
+	}
+	if (pipeIndex >= rank->m_pipes.size() || isRecorded(pipe))
+		return;
+	m_actions.push_back(new PipeUndoAction(rank, pipeIndex));
+}
+
+void UndoStep::recordGuiElement(GUIElement *element) {
+	if (isRecorded(element))
+		return;
+	m_actions.push_back(new GuiElementUndoAction(element));
+}
+
+void UndoStep::recordGuiElementPosition(GUIElement *element) {
+	GoPanel *panel = getPanelOf(m_organ, element);
+	if (!panel || isRecorded(element))
+		return;
+	m_actions.push_back(new PositionUndoAction(panel, element));
+}
+
+void UndoStep::recordImagePosition(GoPanel *panel, GoImage *image) {
+	if (isRecorded(image))
+		return;
+	m_actions.push_back(new PositionUndoAction(panel, image));
+}
+
+void UndoStep::addAction(UndoAction *action) {
+	m_actions.push_back(action);
+}
+
+void UndoStep::storeNewStates() {
+	for (UndoAction *action : m_actions)
+		action->storeNewState();
+}
+
+void UndoStep::undo() {
+	for (auto it = m_actions.rbegin(); it != m_actions.rend(); ++it) {
+		if ((*it)->isValid(m_organ))
+			(*it)->undo();
+	}
+}
+
+void UndoStep::redo() {
+	for (UndoAction *action : m_actions) {
+		if (action->isValid(m_organ))
+			action->redo();
+	}
+}
+
+void UndoStep::removeInvalidActions() {
+	auto it = m_actions.begin();
+	while (it != m_actions.end()) {
+		if (!(*it)->isValid(m_organ)) {
+			delete *it;
+			it = m_actions.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void UndoStep::removeStopDependentActions() {
+	auto it = m_actions.begin();
+	while (it != m_actions.end()) {
+		if ((*it)->isStopDependent()) {
+			delete *it;
+			it = m_actions.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+bool UndoStep::isRecorded(const void *object) {
+	if (m_recorded.count(object))
+		return true;
+	m_recorded.insert(object);
+	return false;
+}
+
+UndoHistory::UndoHistory(unsigned maxSteps) {
+	m_maxSteps = maxSteps;
+	m_editOrgan = NULL;
+	m_editedStop = NULL;
+	m_editedRank = NULL;
+	m_editedElement = NULL;
+	m_stopEdit = NULL;
+	m_rankEdit = NULL;
+	m_elementEdit = NULL;
+	m_lastEdited = NULL;
+	m_lastEditTime = 0;
+}
+
+UndoHistory::~UndoHistory() {
+	clear();
+}
+
+UndoStep* UndoHistory::beginStep(Organ *organ, wxString description) {
+	return new UndoStep(organ, description);
+}
+
+void UndoHistory::commitStep(UndoStep *step) {
+	step->storeNewStates();
+	if (step->isEmpty()) {
+		delete step;
+		return;
+	}
+	pushStep(step);
+	m_lastEdited = NULL;
+	refreshEdits();
+}
+
+void UndoHistory::beginEdit(Organ *organ, Stop *stop) {
+	m_editOrgan = organ;
+	m_editedStop = stop;
+	// only this copy is taken again, the other edited objects might just
+	// have been removed from the organ
+	if (m_stopEdit)
+		delete m_stopEdit;
+	m_stopEdit = new StopUndoAction(stop);
+}
+
+void UndoHistory::beginEdit(Organ *organ, Rank *rank) {
+	m_editOrgan = organ;
+	m_editedRank = rank;
+	if (m_rankEdit)
+		delete m_rankEdit;
+	m_rankEdit = new RankUndoAction(rank);
+}
+
+void UndoHistory::beginEdit(Organ *organ, GUIElement *element) {
+	m_editOrgan = organ;
+	m_editedElement = element;
+	if (m_elementEdit)
+		delete m_elementEdit;
+	m_elementEdit = new GuiElementUndoAction(element);
+}
+
+void UndoHistory::recordEdit(Stop *stop) {
+	if (!m_stopEdit || stop != m_editedStop)
+		return;
+	commitEdit(m_stopEdit, stop, wxT("Edit ") + stop->getName());
+	m_stopEdit = NULL;
+	refreshEdits();
+}
+
+void UndoHistory::recordEdit(Rank *rank) {
+	if (!m_rankEdit || rank != m_editedRank)
+		return;
+	commitEdit(m_rankEdit, rank, wxT("Edit ") + rank->getName());
+	m_rankEdit = NULL;
+	refreshEdits();
+}
+
+void UndoHistory::recordEdit(GUIElement *element) {
+	if (!m_elementEdit || element != m_editedElement)
+		return;
+	commitEdit(m_elementEdit, element, wxT("Edit ") + element->getDisplayName());
+	m_elementEdit = NULL;
+	refreshEdits();
+}
+
+bool UndoHistory::canUndo() {
+	return !m_undoSteps.empty();
+}
+
+bool UndoHistory::canRedo() {
+	return !m_redoSteps.empty();
+}
+
+wxString UndoHistory::getUndoDescription() {
+	if (m_undoSteps.empty())
+		return wxEmptyString;
+	return m_undoSteps.back()->getDescription();
+}
+
+wxString UndoHistory::getRedoDescription() {
+	if (m_redoSteps.empty())
+		return wxEmptyString;
+	return m_redoSteps.back()->getDescription();
+}
+
+bool UndoHistory::undo() {
+	if (m_undoSteps.empty())
+		return false;
+	UndoStep *step = m_undoSteps.back();
+	m_undoSteps.pop_back();
+	step->undo();
+	m_redoSteps.push_back(step);
+	m_lastEdited = NULL;
+	refreshEdits();
+	return true;
+}
+
+bool UndoHistory::redo() {
+	if (m_redoSteps.empty())
+		return false;
+	UndoStep *step = m_redoSteps.back();
+	m_redoSteps.pop_back();
+	step->redo();
+	m_undoSteps.push_back(step);
+	m_lastEdited = NULL;
+	refreshEdits();
+	return true;
+}
+
+void UndoHistory::clear() {
+	for (UndoStep *step : m_undoSteps)
+		delete step;
+	m_undoSteps.clear();
+	clearRedo();
+	clearEdits();
+}
+
+void UndoHistory::removeInvalidActions() {
+	for (UndoStep *step : m_undoSteps)
+		step->removeInvalidActions();
+	for (UndoStep *step : m_redoSteps)
+		step->removeInvalidActions();
+	removeEmptySteps();
+
+	// the edited objects might be the removed ones
+	if (m_editOrgan) {
+		if (m_editedStop && !m_editOrgan->getIndexOfOrganStop(m_editedStop))
+			m_editedStop = NULL;
+		if (m_editedRank && !isOrganRank(m_editOrgan, m_editedRank))
+			m_editedRank = NULL;
+		if (m_editedElement && !getPanelOf(m_editOrgan, m_editedElement))
+			m_editedElement = NULL;
+	}
+	refreshEdits();
+}
+
+void UndoHistory::removeStopDependentActions() {
+	for (UndoStep *step : m_undoSteps)
+		step->removeStopDependentActions();
+	for (UndoStep *step : m_redoSteps)
+		step->removeStopDependentActions();
+	removeEmptySteps();
+	refreshEdits();
+}
+
+void UndoHistory::pushStep(UndoStep *step) {
+	clearRedo();
+	m_undoSteps.push_back(step);
+	while (m_undoSteps.size() > m_maxSteps) {
+		delete m_undoSteps.front();
+		m_undoSteps.pop_front();
+	}
+}
+
+void UndoHistory::commitEdit(UndoAction *edit, const void *object, wxString description) {
+	wxLongLong now = wxGetLocalTimeMillis();
+	if (object == m_lastEdited && !m_undoSteps.empty() && now - m_lastEditTime < 1000) {
+		// the change is merged into the step of the previous one
+		m_undoSteps.back()->storeNewStates();
+		delete edit;
+	} else {
+		edit->storeNewState();
+		UndoStep *step = new UndoStep(m_editOrgan, description);
+		step->addAction(edit);
+		pushStep(step);
+	}
+	m_lastEdited = object;
+	m_lastEditTime = now;
+}
+
+void UndoHistory::refreshEdits() {
+	// the copies are taken again since the objects may have been changed
+	if (m_stopEdit)
+		delete m_stopEdit;
+	m_stopEdit = m_editedStop ? new StopUndoAction(m_editedStop) : NULL;
+	if (m_rankEdit)
+		delete m_rankEdit;
+	m_rankEdit = m_editedRank ? new RankUndoAction(m_editedRank) : NULL;
+	if (m_elementEdit)
+		delete m_elementEdit;
+	m_elementEdit = m_editedElement ? new GuiElementUndoAction(m_editedElement) : NULL;
+}
+
+void UndoHistory::clearEdits() {
+	m_editedStop = NULL;
+	m_editedRank = NULL;
+	m_editedElement = NULL;
+	refreshEdits();
+	m_editOrgan = NULL;
+	m_lastEdited = NULL;
+}
+
+void UndoHistory::removeEmptySteps() {
+	auto it = m_undoSteps.begin();
+	while (it != m_undoSteps.end()) {
+		if ((*it)->isEmpty()) {
+			delete *it;
+			it = m_undoSteps.erase(it);
+		} else {
+			++it;
+		}
+	}
+	auto redoIt = m_redoSteps.begin();
+	while (redoIt != m_redoSteps.end()) {
+		if ((*redoIt)->isEmpty()) {
+			delete *redoIt;
+			redoIt = m_redoSteps.erase(redoIt);
+		} else {
+			++redoIt;
+		}
+	}
+}
+
+void UndoHistory::clearRedo() {
+	for (UndoStep *step : m_redoSteps)
+		delete step;
+	m_redoSteps.clear();
+}
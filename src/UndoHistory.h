@@ -0,0 +1,251 @@
+/*
+ * UndoHistory.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef UNDOHISTORY_H
+#define UNDOHISTORY_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <deque>
+#include <set>
+#include "Pipe.h"
+
+class Organ;
+class Rank;
+class Stop;
+class GoPanel;
+class GoImage;
+class GUIElement;
+
+// An action keeps the state of one changed object from before and after the
+// change and copies either of them back into the object itself, so panels and
+// tree items showing the object stay valid. Objects are kept by pointer, the
+// organ keeps its elements in lists so they don't move when reordered. An
+// action whose object is no longer part of the organ, or whose state refers to
+// an element that isn't, is dropped.
+class UndoAction {
+public:
+	virtual ~UndoAction() {}
+	// the state after the change is taken when the step is committed
+	virtual void storeNewState() = 0;
+	virtual void undo() = 0;
+	virtual void redo() = 0;
+	virtual bool isValid(Organ *organ) = 0;
+	// the state holds REF: paths of pipes or the manual of a stop, which
+	// change when stops or manuals are moved or removed
+	virtual bool isStopDependent() { return false; }
+};
+
+class PipeUndoAction : public UndoAction {
+public:
+	PipeUndoAction(Rank *rank, unsigned pipeIndex);
+
+	void storeNewState();
+	void undo();
+	void redo();
+	bool isValid(Organ *organ);
+	bool isStopDependent() { return true; }
+
+private:
+	Rank *m_rank;
+	unsigned m_pipeIndex;
+	unsigned m_numberOfPipes; // the rank must still be of the same size
+	Pipe m_oldPipe;
+	Pipe m_newPipe;
+
+	void restore(const Pipe &pipe);
+};
+
+class RankUndoAction : public UndoAction {
+public:
+	RankUndoAction(Rank *rank);
+	~RankUndoAction();
+
+	void storeNewState();
+	void undo();
+	void redo();
+	bool isValid(Organ *organ);
+	bool isStopDependent() { return true; }
+
+private:
+	Rank *m_rank;
+	Rank *m_oldRank;
+	Rank *m_newRank;
+
+	void restore(Rank *state);
+};
+
+// The internal rank is left out, it's recorded as edits of the rank itself.
+// Only its name follows the restored name of the stop.
+class StopUndoAction : public UndoAction {
+public:
+	StopUndoAction(Stop *stop);
+	~StopUndoAction();
+
+	void storeNewState();
+	void undo();
+	void redo();
+	bool isValid(Organ *organ);
+	bool isStopDependent() { return true; }
+
+private:
+	Stop *m_stop;
+	Stop *m_oldStop;
+	Stop *m_newStop;
+
+	Stop* copyState();
+	void restore(Stop *state);
+};
+
+class GuiElementUndoAction : public UndoAction {
+public:
+	GuiElementUndoAction(GUIElement *element);
+	~GuiElementUndoAction();
+
+	void storeNewState();
+	void undo();
+	void redo();
+	bool isValid(Organ *organ);
+
+private:
+	GUIElement *m_element;
+	GUIElement *m_oldElement; // owned clones
+	GUIElement *m_newElement;
+
+	void restore(GUIElement *state);
+};
+
+class PositionUndoAction : public UndoAction {
+public:
+	PositionUndoAction(GoPanel *panel, GUIElement *element);
+	PositionUndoAction(GoPanel *panel, GoImage *image);
+
+	void storeNewState();
+	void undo();
+	void redo();
+	bool isValid(Organ *organ);
+
+private:
+	typedef struct {
+		int posX;
+		int posY;
+		bool freeX; // free placement of labels
+		bool freeY;
+	} POSITION;
+
+	GoPanel *m_panel;
+	GUIElement *m_element;
+	GoImage *m_image;
+	POSITION m_oldPosition;
+	POSITION m_newPosition;
+
+	POSITION getPosition();
+	void restore(const POSITION &position);
+};
+
+// One user operation. State must be recorded before the object is changed,
+// recording the same object again within a step is ignored.
+class UndoStep {
+public:
+	UndoStep(Organ *organ, wxString description);
+	~UndoStep();
+
+	wxString getDescription();
+	bool isEmpty();
+
+	void recordPipe(Rank *rank, Pipe *pipe);
+	void recordGuiElement(GUIElement *element);
+	void recordGuiElementPosition(GUIElement *element);
+	void recordImagePosition(GoPanel *panel, GoImage *image);
+	// takes over an action that already holds the state before the change
+	void addAction(UndoAction *action);
+
+	void storeNewStates();
+	void undo();
+	void redo();
+	void removeInvalidActions();
+	void removeStopDependentActions();
+
+private:
+	Organ *m_organ;
+	wxString m_description;
+	std::vector<UndoAction*> m_actions;
+	std::set<const void*> m_recorded;
+
+	bool isRecorded(const void *object);
+};
+
+// Besides steps for whole operations the history records the changes made in
+// the editor panels. A panel tells which stop, rank or gui element it shows and
+// reports each change of it, the history keeps a copy of the shown objects to
+// know what a change was. Changes of the same object in quick succession, like
+// typing a name, are merged into one step.
+class UndoHistory {
+public:
+	UndoHistory(unsigned maxSteps = 100);
+	~UndoHistory();
+
+	UndoStep* beginStep(Organ *organ, wxString description);
+	// takes over the step, an empty step is just deleted
+	void commitStep(UndoStep *step);
+
+	void beginEdit(Organ *organ, Stop *stop);
+	void beginEdit(Organ *organ, Rank *rank);
+	void beginEdit(Organ *organ, GUIElement *element);
+	void recordEdit(Stop *stop);
+	void recordEdit(Rank *rank);
+	void recordEdit(GUIElement *element);
+
+	bool canUndo();
+	bool canRedo();
+	wxString getUndoDescription();
+	wxString getRedoDescription();
+	bool undo();
+	bool redo();
+	void clear();
+	// after organ elements are removed
+	void removeInvalidActions();
+	// after stops or manuals are moved or removed
+	void removeStopDependentActions();
+
+private:
+	std::deque<UndoStep*> m_undoSteps;
+	std::vector<UndoStep*> m_redoSteps;
+	unsigned m_maxSteps;
+
+	Organ *m_editOrgan;
+	Stop *m_editedStop;
+	Rank *m_editedRank;
+	GUIElement *m_editedElement;
+	StopUndoAction *m_stopEdit;
+	RankUndoAction *m_rankEdit;
+	GuiElementUndoAction *m_elementEdit;
+	const void *m_lastEdited; // object of the last step if it was an edit
+	wxLongLong m_lastEditTime;
+
+	void pushStep(UndoStep *step);
+	void commitEdit(UndoAction *edit, const void *object, wxString description);
+	void refreshEdits();
+	void clearEdits();
+	void removeEmptySteps();
+	void clearRedo();
+};
+
+#endif
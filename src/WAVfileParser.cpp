@@ -19,6 +19,7 @@
  */
 
 #include "WAVfileParser.h"
+#include "TraceRecorder.h"
 #include <climits>
 #include <cstdint>
 
@@ -33,6 +34,7 @@ wxString const WAVE_INFO = wxT("INFO");
 wxString const WVPK_ID = wxT("wvpk");
 
 WAVfileParser::WAVfileParser(wxString file) {
+	TraceScope trace("WAVfileParser", file);
 	m_wavpackUsed = false;
 	m_fileName = file;
 	m_errorMessage = wxEmptyString;
@@ -43,6 +45,8 @@ WAVfileParser::WAVfileParser(wxString file) {
 	m_BlockAlign = 0;
 	m_BitsPerSample = 0;
 	m_dataSize = 0;
+	m_dataOffset = wxInvalidOffset;
+	m_SubFormat = 0;
 	m_numberOfFrames = 0;
 	m_dwMIDIUnityNote = 0;
 	m_dwMIDIPitchFraction = 0;
@@ -112,6 +116,24 @@ unsigned WAVfileParser::getAudioFormat() {
 	return (unsigned) m_AudioFormat;
 }
 
+unsigned WAVfileParser::getSubFormat() {
+	if (m_AudioFormat == 65534)
+		return (unsigned) m_SubFormat;
+	return (unsigned) m_AudioFormat;
+}
+
+unsigned WAVfileParser::getBlockAlign() {
+	return (unsigned) m_BlockAlign;
+}
+
+wxFileOffset WAVfileParser::getDataChunkOffset() {
+	return m_dataOffset;
+}
+
+unsigned WAVfileParser::getDataChunkSize() {
+	return m_dataSize;
+}
+
 unsigned WAVfileParser::getInfoListSize() {
 	return m_infoList.size();
 }
@@ -223,8 +245,11 @@ bool WAVfileParser::tryParsingFile(wxString file) {
 			// get size of chunk so we know how far to skip until next chunk
 			waveFile.Read(&uBuffer, 4);
 			if (waveFile.LastRead() == 4) {
-				if (dataFound && m_dataSize == 0)
+				if (dataFound && m_dataSize == 0) {
 					m_dataSize = uBuffer;
+					// the audio data itself starts directly after the chunk size
+					m_dataOffset = waveFile.TellI();
+				}
 			} else {
 				break;
 			}
@@ -626,10 +651,30 @@ bool WAVfileParser::parseFmtChunk(wxFFileInputStream &wavFile) {
 		return false;
 	}
 
-	if (fmtChunkSize > 16) {
-		unsigned bytesToSkip = fmtChunkSize - 16;
+	unsigned fmtBytesRead = 16;
+	if (m_AudioFormat == 65534 && fmtChunkSize >= 26) {
+		// we're not interested in:
+		// cbSize 2 bytes
+		// wValidBitsPerSample 2 bytes
+		// dwChannelMask 4 bytes
+		wavFile.SeekI(8, wxFromCurrent);
+		fmtBytesRead += 8;
+
+		// but the first two bytes of the SubFormat GUID tells if it's PCM or IEEE_FLOAT
+		wavFile.Read(&uShBuffer, 2);
+		if (wavFile.LastRead() == 2) {
+			m_SubFormat = uShBuffer;
+			fmtBytesRead += 2;
+		} else {
+			m_errorMessage += wxT("Couldn't read sub format.\n");
+			return false;
+		}
+	}
+
+	if (fmtChunkSize > fmtBytesRead) {
+		unsigned bytesToSkip = fmtChunkSize - fmtBytesRead;
 		wavFile.SeekI(bytesToSkip + (bytesToSkip & 1), wxFromCurrent);
-		m_lastChunkSizeParsed = 16 + (bytesToSkip + (bytesToSkip & 1));
+		m_lastChunkSizeParsed = fmtBytesRead + (bytesToSkip + (bytesToSkip & 1));
 		return true;
 	} else {
 		m_lastChunkSizeParsed = fmtChunkSize;
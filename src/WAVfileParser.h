@@ -64,6 +64,10 @@ public:
 	LOOP getLoopAtIndex(unsigned index);
 	unsigned getBitsPerSample();
 	unsigned getAudioFormat();
+	unsigned getSubFormat();
+	unsigned getBlockAlign();
+	wxFileOffset getDataChunkOffset();
+	unsigned getDataChunkSize();
 	unsigned getInfoListSize();
 	std::pair<wxString, wxString> getInfoListContentAtIndex(unsigned index);
 	unsigned getMidiNote();
@@ -83,6 +87,8 @@ private:
 	unsigned short m_BlockAlign;
 	unsigned short m_BitsPerSample;
 	unsigned m_dataSize;
+	wxFileOffset m_dataOffset;
+	unsigned short m_SubFormat; // first two bytes of the SubFormat GUID for WAVE_FORMAT_EXTENSIBLE
 	unsigned m_numberOfFrames;
 	unsigned m_dwMIDIUnityNote;
 	unsigned m_dwMIDIPitchFraction;
@@ -0,0 +1,179 @@
+/*
+ * WAVsampleReader.cpp is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "WAVsampleReader.h"
+#include <cstring>
+#include <cstdint>
+
+WAVsampleReader::WAVsampleReader(wxString file) : m_parser(file) {
+	m_isOk = false;
+	m_isFloat = false;
+	m_errorMessage = wxEmptyString;
+	m_bytesPerSample = 0;
+	m_blockAlign = 0;
+	m_currentFrame = 0;
+
+	if (!m_parser.isWavOk()) {
+		m_errorMessage = m_parser.getErrorMessage();
+		return;
+	}
+
+	if (m_parser.isWavPacked()) {
+		m_errorMessage = wxT("WavPack compressed samples cannot be decoded.\n");
+		return;
+	}
+
+	unsigned format = m_parser.getSubFormat();
+	unsigned bits = m_parser.getBitsPerSample();
+	if (format == 3 && (bits == 32 || bits == 64)) {
+		m_isFloat = true;
+	} else if (format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) {
+		m_isFloat = false;
+	} else {
+		m_errorMessage = wxString::Format(wxT("Unsupported sample format %u with %u bits per sample.\n"), format, bits);
+		return;
+	}
+
+	m_bytesPerSample = bits / 8;
+	m_blockAlign = m_parser.getBlockAlign();
+	if (m_parser.getNumberOfChannels() == 0 || m_blockAlign < m_bytesPerSample * m_parser.getNumberOfChannels()) {
+		m_errorMessage = wxT("Invalid block alignment.\n");
+		return;
+	}
+
+	if (m_parser.getDataChunkOffset() == wxInvalidOffset) {
+		m_errorMessage = wxT("Couldn't locate audio data.\n");
+		return;
+	}
+
+	if (!m_file.Open(file, wxT("rb"))) {
+		m_errorMessage = wxT("Failed to open file.\n");
+		return;
+	}
+
+	m_isOk = seekToFrame(0);
+}
+
+WAVsampleReader::~WAVsampleReader() {
+	if (m_file.IsOpened())
+		m_file.Close();
+}
+
+bool WAVsampleReader::isOk() {
+	return m_isOk;
+}
+
+wxString WAVsampleReader::getErrorMessage() {
+	return m_errorMessage;
+}
+
+unsigned WAVsampleReader::getNumberOfFrames() {
+	return m_parser.getNumberOfFrames();
+}
+
+unsigned WAVsampleReader::getNumberOfChannels() {
+	return m_parser.getNumberOfChannels();
+}
+
+unsigned WAVsampleReader::getSampleRate() {
+	return m_parser.getSampleRate();
+}
+
+unsigned WAVsampleReader::getCurrentFrame() {
+	return m_currentFrame;
+}
+
+WAVfileParser* WAVsampleReader::getParser() {
+	return &m_parser;
+}
+
+bool WAVsampleReader::seekToFrame(unsigned frame) {
+	if (!m_file.IsOpened() || frame > getNumberOfFrames())
+		return false;
+
+	wxFileOffset pos = m_parser.getDataChunkOffset() + (wxFileOffset) frame * m_blockAlign;
+	if (!m_file.Seek(pos)) {
+		m_errorMessage = wxT("Seek in audio data failed.\n");
+		return false;
+	}
+	m_currentFrame = frame;
+	return true;
+}
+
+unsigned WAVsampleReader::readFrames(std::vector<float> &buffer, unsigned nbrOfFrames) {
+	buffer.clear();
+	if (!m_isOk)
+		return 0;
+
+	unsigned framesLeft = getNumberOfFrames() - m_currentFrame;
+	if (nbrOfFrames > framesLeft)
+		nbrOfFrames = framesLeft;
+	if (nbrOfFrames == 0)
+		return 0;
+
+	m_rawBuffer.resize((size_t) nbrOfFrames * m_blockAlign);
+	size_t bytesRead = m_file.Read(m_rawBuffer.data(), m_rawBuffer.size());
+	unsigned framesRead = bytesRead / m_blockAlign;
+
+	unsigned channels = getNumberOfChannels();
+	buffer.resize((size_t) framesRead * channels);
+	for (unsigned i = 0; i < framesRead; i++) {
+		const unsigned char *frameData = m_rawBuffer.data() + (size_t) i * m_blockAlign;
+		for (unsigned ch = 0; ch < channels; ch++) {
+			buffer[(size_t) i * channels + ch] = decodeSample(frameData + ch * m_bytesPerSample);
+		}
+	}
+	m_currentFrame += framesRead;
+
+	return framesRead;
+}
+
+float WAVsampleReader::decodeSample(const unsigned char *data) {
+	// wave data is always little endian
+	if (m_isFloat) {
+		if (m_bytesPerSample == 4) {
+			uint32_t bits = (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		} else {
+			uint64_t bits = 0;
+			for (int i = 7; i >= 0; i--)
+				bits = (bits << 8) | data[i];
+			double value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return (float) value;
+		}
+	}
+
+	switch (m_bytesPerSample) {
+		case 1:
+			// 8 bit is unsigned
+			return ((int) data[0] - 128) / 128.0f;
+		case 2:
+			return (int16_t) ((uint16_t) data[0] | ((uint16_t) data[1] << 8)) / 32768.0f;
+		case 3:
+			return (int32_t) (((uint32_t) data[0] << 8) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 24)) / 2147483648.0f;
+		case 4:
+			return (int32_t) ((uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24)) / 2147483648.0f;
+		default:
+			return 0.0f;
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * WAVsampleReader.h is part of GoOdf.
+ * Copyright (C) 2025 Lars Palo and contributors (see AUTHORS)
+ *
+ * GoOdf is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GoOdf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GoOdf.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef WAVSAMPLEREADER_H
+#define WAVSAMPLEREADER_H
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <vector>
+#include "WAVfileParser.h"
+
+// Decodes the audio data of an uncompressed .wav file block by block into
+// interleaved floats in the range -1.0 to 1.0. 8, 16, 24 and 32 bit PCM as
+// well as 32 and 64 bit IEEE float are supported. WavPack is not.
+class WAVsampleReader {
+
+public:
+	WAVsampleReader(wxString file);
+	~WAVsampleReader();
+
+	bool isOk();
+	wxString getErrorMessage();
+	unsigned getNumberOfFrames();
+	unsigned getNumberOfChannels();
+	unsigned getSampleRate();
+	unsigned getCurrentFrame();
+	WAVfileParser* getParser();
+
+	bool seekToFrame(unsigned frame);
+	// reads at most nbrOfFrames frames from current position, returns number of frames actually read
+	unsigned readFrames(std::vector<float> &buffer, unsigned nbrOfFrames);
+
+private:
+	WAVfileParser m_parser;
+	wxFFile m_file;
+	bool m_isOk;
+	bool m_isFloat;
+	wxString m_errorMessage;
+	unsigned m_bytesPerSample;
+	unsigned m_blockAlign;
+	unsigned m_currentFrame;
+	std::vector<unsigned char> m_rawBuffer;
+
+	float decodeSample(const unsigned char *data);
+};
+
+#endif
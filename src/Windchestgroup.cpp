@@ -317,6 +317,7 @@ void Windchestgroup::applyPercussiveRecursively() {
 					p.hasIndependentRelease = false;
 			}
 		}
+		r->markChanged();
 		if (r->getWindchest() == this) {
 			r->setPercussive(this->getIsPercussive());
 			if (!r->isPercussive())
@@ -341,6 +342,7 @@ void Windchestgroup::applyPercussiveRecursively() {
 						p.hasIndependentRelease = false;
 				}
 			}
+			r->markChanged();
 			if (r->getWindchest() == this) {
 				r->setPercussive(this->getIsPercussive());
 				if (!r->isPercussive())